@@ -53,6 +53,8 @@ SET(OPENFLUID_EXAMPLES_PATH "examples")
 SET(OPENFLUID_PROJECTS_PATH "projects")
 SET(OPENFLUID_NETWORK_PATH "network")
 SET(OPENFLUID_HUBS_CACHE_PATH "${OPENFLUID_NETWORK_PATH}/hubs")
+SET(OPENFLUID_CACHE_PATH "cache")
+SET(OPENFLUID_WARES_CACHE_PATH "${OPENFLUID_CACHE_PATH}/wares")
 
 SET(OPENFLUID_PROJECT_INPUT_PATH "IN")
 SET(OPENFLUID_PROJECT_OUTPUT_PATHPREFIX "OUT")
@@ -220,6 +222,11 @@ SET(OPENFLUID_SCHEDULE_PROFILE_FILE "openfluid-profile-schedule.log")
 SET(OPENFLUID_TIMEINDEX_PROFILE_FILE "openfluid-profile-timeindex.log")
 
 
+################### checkpoints ###################
+
+SET(OPENFLUID_CHECKPOINT_FILE "openfluid-checkpoint.ofcp")
+
+
 ################### return codes ###################
 
 SET(OPENFLUID_RETURN_CODE_DEPENDENCY_ISSUE 100)
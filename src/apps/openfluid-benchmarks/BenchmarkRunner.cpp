@@ -0,0 +1,440 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file BenchmarkRunner.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <chrono>
+#include <memory>
+
+#include <openfluid/base/Environment.hpp>
+#include <openfluid/base/IOListener.hpp>
+#include <openfluid/base/RunContextManager.hpp>
+#include <openfluid/fluidx/FluidXIO.hpp>
+#include <openfluid/machine/Engine.hpp>
+#include <openfluid/machine/Factory.hpp>
+#include <openfluid/machine/MachineListener.hpp>
+#include <openfluid/machine/ModelInstance.hpp>
+#include <openfluid/machine/ModelItemInstance.hpp>
+#include <openfluid/machine/MonitoringInstance.hpp>
+#include <openfluid/machine/ObserverRegistry.hpp>
+#include <openfluid/machine/SimulationBlob.hpp>
+#include <openfluid/tools/Filesystem.hpp>
+#include <openfluid/tools/FilesystemPath.hpp>
+
+#include "BenchmarkRunner.hpp"
+#include "RoutingSimulator.hpp"
+
+
+namespace {
+
+
+typedef std::chrono::steady_clock BenchClock;
+
+
+double getSecondsSince(const BenchClock::time_point& Start)
+{
+  return std::chrono::duration<double>(BenchClock::now()-Start).count();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void setMemoryMeasure(openfluid::thirdparty::json& Obj, const std::string& Key,
+                      const openfluid::machine::ProfilingCounters& Counters,
+                      openfluid::machine::ProfilingCounters::Counter C,
+                      openfluid::machine::ProfilingCounters::Value_t Reference = 0)
+{
+  if (Counters.isAvailable(C))
+  {
+    Obj[Key] = Counters.get(C)-Reference;
+  }
+  else
+  {
+    Obj[Key] = nullptr;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const std::vector<std::string> ComparedCaseMeasures = {"load_time_s"};
+
+const std::vector<std::string> ComparedRunMeasures = {"build_time_s","run_time_s","heap_bytes"};
+
+
+void compareMeasure(openfluid::thirdparty::json& Comparison, const std::string& CaseName, unsigned int ThreadsCount,
+                    const std::string& Measure, const openfluid::thirdparty::json& Current,
+                    const openfluid::thirdparty::json& Reference, double Tolerance)
+{
+  if (!Current.contains(Measure) || !Reference.contains(Measure) ||
+      !Current[Measure].is_number() || !Reference[Measure].is_number())
+  {
+    return;
+  }
+
+  const double CurrentVal = Current[Measure].get<double>();
+  const double ReferenceVal = Reference[Measure].get<double>();
+  const bool IsDuration = (Measure.size() > 2 && Measure.substr(Measure.size()-2) == "_s");
+
+  if (ReferenceVal <= 0.0 || (IsDuration && std::max(CurrentVal,ReferenceVal) < BenchmarkRunner::MinComparedDuration))
+  {
+    return;
+  }
+
+  const double Ratio = CurrentVal/ReferenceVal;
+
+  Comparison["compared"] = Comparison["compared"].get<unsigned int>()+1;
+
+  if (Ratio > 1.0+Tolerance || Ratio < 1.0-Tolerance)
+  {
+    openfluid::thirdparty::json Item = {{"case",CaseName},{"measure",Measure},
+                                        {"baseline",ReferenceVal},{"current",CurrentVal},{"ratio",Ratio}};
+    if (ThreadsCount)
+    {
+      Item["threads"] = ThreadsCount;
+    }
+
+    Comparison[Ratio > 1.0 ? "regressions" : "improvements"].push_back(Item);
+  }
+}
+
+
+} // namespace
+
+
+// =====================================================================
+// =====================================================================
+
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkSettings& Settings, std::ostream& OutStm) :
+  m_Settings(Settings), m_IsCSVObserverAvailable(false), m_OutStm(OutStm)
+{
+  if (m_Settings.WithCSVObserver)
+  {
+    m_IsCSVObserverAvailable = openfluid::machine::ObserverRegistry::instance()->addWare("export.vars.files.csv");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::machine::ProfilingCounters BenchmarkRunner::readMemoryCounters()
+{
+  openfluid::machine::ProfilingCounters Counters;
+
+  if (m_CountersBackend.isAvailable())
+  {
+    m_CountersBackend.read(Counters);
+  }
+
+  return Counters;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::thirdparty::json BenchmarkRunner::runSimulation(const openfluid::fluidx::FluidXDescriptor& FXDesc,
+                                                           unsigned int UnitsCount, const std::string& OutputDir,
+                                                           unsigned int ThreadsCount)
+{
+  typedef openfluid::machine::ProfilingCounters::Counter Counter;
+
+  openfluid::thirdparty::json Measures = {{"threads",ThreadsCount}};
+
+  openfluid::base::RunContextManager::instance()->setWaresMaxNumThreads(ThreadsCount);
+  openfluid::base::RunContextManager::instance()->setOutputDir(OutputDir);
+
+  const auto StartCounters = readMemoryCounters();
+
+  {
+    // the container must outlive the model instance, which only keeps a reference to it
+    const auto RoutingContainer = RoutingSimulator::createContainer();
+    std::unique_ptr<openfluid::machine::MachineListener> MListener =
+      std::make_unique<openfluid::machine::MachineListener>();
+    openfluid::machine::SimulationBlob SimBlob;
+    openfluid::machine::ModelInstance Model(SimBlob,MListener.get());
+    openfluid::machine::MonitoringInstance Monitoring(SimBlob);
+
+    auto Start = BenchClock::now();
+
+    openfluid::machine::Factory::buildSimulationBlobFromDescriptors(FXDesc,SimBlob);
+    openfluid::machine::Factory::buildModelInstanceFromDescriptor(FXDesc.model(),Model);
+
+    auto RoutingItem = new openfluid::machine::ModelItemInstance(RoutingContainer);
+    RoutingItem->Body.reset(new RoutingSimulator());
+    RoutingItem->OriginalPosition = Model.getItemsCount()+1;
+    Model.appendItem(RoutingItem);
+
+    openfluid::machine::Factory::buildMonitoringInstanceFromDescriptor(FXDesc.monitoring(),Monitoring);
+
+    openfluid::machine::Engine Engine(SimBlob,Model,Monitoring,MListener.get());
+
+    Measures["build_time_s"] = getSecondsSince(Start);
+
+
+    Start = BenchClock::now();
+
+    Engine.initialize();
+    Engine.initParams();
+    Engine.prepareData();
+    Engine.checkConsistency();
+
+    Measures["init_time_s"] = getSecondsSince(Start);
+
+
+    Start = BenchClock::now();
+
+    Engine.run();
+
+    const double RunTime = getSecondsSince(Start);
+
+    Measures["run_time_s"] = RunTime;
+    Measures["steps_per_s"] = (RunTime > 0.0 ? m_Settings.StepsCount/RunTime : 0.0);
+    Measures["unitsteps_per_s"] = (RunTime > 0.0 ? double(UnitsCount)*m_Settings.StepsCount/RunTime : 0.0);
+
+    // memory is read while the simulation is still alive
+    const auto EndCounters = readMemoryCounters();
+    setMemoryMeasure(Measures,"heap_bytes",EndCounters,Counter::HEAPBYTES,
+                     StartCounters.isAvailable(Counter::HEAPBYTES) ? StartCounters.get(Counter::HEAPBYTES) : 0);
+    // the peak RSS is the high-water mark of the whole process, only its growth during this run is reported
+    setMemoryMeasure(Measures,"peak_rss_growth_bytes",EndCounters,Counter::PEAKRSS,
+                     StartCounters.isAvailable(Counter::PEAKRSS) ? StartCounters.get(Counter::PEAKRSS) : 0);
+
+    Engine.finalize();
+  }
+
+  return Measures;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::thirdparty::json BenchmarkRunner::runCase(DomainShape Shape, unsigned int UnitsCount)
+{
+  const std::string CaseName = getShapeName(Shape)+"-"+std::to_string(UnitsCount);
+  const std::string CaseDir = openfluid::tools::Filesystem::joinPath({m_Settings.WorkDir,CaseName});
+  const std::string InputDir = openfluid::tools::Filesystem::joinPath({CaseDir,"IN"});
+  const std::string OutputDir = openfluid::tools::Filesystem::joinPath({CaseDir,"OUT"});
+
+  openfluid::thirdparty::json Case = {{"name",CaseName},{"shape",getShapeName(Shape)},{"units",UnitsCount}};
+  openfluid::base::IOListener Listener;
+
+  m_OutStm << "* " << CaseName << std::endl;
+
+  openfluid::tools::FilesystemPath(CaseDir).removeDirectory();
+  if (!openfluid::tools::FilesystemPath(InputDir).makeDirectory())
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "unable to create benchmark directory " + InputDir);
+  }
+
+
+  // --- generation and writing of the dataset
+
+  {
+    DatasetDefinition Def;
+    Def.Shape = Shape;
+    Def.UnitsCount = UnitsCount;
+    Def.StepsCount = m_Settings.StepsCount;
+    Def.WithCSVObserver = m_IsCSVObserverAvailable;
+
+    openfluid::fluidx::FluidXDescriptor FXDesc;
+
+    auto Start = BenchClock::now();
+    buildSyntheticDataset(Def,FXDesc);
+    Case["generation_time_s"] = getSecondsSince(Start);
+
+    Start = BenchClock::now();
+    openfluid::fluidx::FluidXIO(&Listener).writeToManyFiles(FXDesc,InputDir);
+    Case["write_time_s"] = getSecondsSince(Start);
+  }
+
+
+  // --- loading of the dataset
+
+  openfluid::base::RunContextManager::instance()->setInputDir(InputDir);
+
+  auto Start = BenchClock::now();
+  const auto FXDesc = openfluid::fluidx::FluidXIO(&Listener).loadFromDirectory(InputDir);
+  Case["load_time_s"] = getSecondsSince(Start);
+
+  m_OutStm << "    load: " << Case["load_time_s"].get<double>() << "s" << std::endl;
+
+
+  // --- simulations
+
+  Case["runs"] = openfluid::thirdparty::json::array();
+  double ReferenceRunTime = 0.0;
+
+  for (const auto& ThreadsCount : m_Settings.ThreadsCounts)
+  {
+    auto Measures = runSimulation(FXDesc,UnitsCount,OutputDir,ThreadsCount);
+    const double RunTime = Measures["run_time_s"].get<double>();
+
+    if (ReferenceRunTime <= 0.0)
+    {
+      ReferenceRunTime = RunTime;
+    }
+    Measures["speedup"] = (RunTime > 0.0 ? ReferenceRunTime/RunTime : 0.0);
+
+    m_OutStm << "    " << ThreadsCount << " thread(s): run " << RunTime << "s, "
+             << Measures["unitsteps_per_s"].get<double>() << " unit-steps/s, "
+             << "speedup " << Measures["speedup"].get<double>() << std::endl;
+
+    Case["runs"].push_back(Measures);
+  }
+
+  return Case;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::thirdparty::json BenchmarkRunner::run()
+{
+  openfluid::thirdparty::json Results;
+
+  Results["openfluid"] = {{"version",openfluid::base::Environment::getVersionFull()}};
+  Results["system"] = {{"hostname",openfluid::base::Environment::getHostName()},
+                       {"arch",openfluid::base::Environment::getSystemArch()},
+                       {"ideal_threads",openfluid::base::Environment::getIdealThreadCount()}};
+
+  Results["settings"] = {{"steps",m_Settings.StepsCount},{"threads",m_Settings.ThreadsCounts}};
+  if (!m_Settings.WithCSVObserver)
+  {
+    Results["settings"]["csv_observer"] = "disabled";
+  }
+  else
+  {
+    Results["settings"]["csv_observer"] = (m_IsCSVObserverAvailable ? "enabled" : "unavailable");
+  }
+
+  Results["cases"] = openfluid::thirdparty::json::array();
+
+  const auto CurrentThreads = openfluid::base::RunContextManager::instance()->getWaresMaxNumThreads();
+  const auto CurrentInputDir = openfluid::base::RunContextManager::instance()->getInputDir();
+  const auto CurrentOutputDir = openfluid::base::RunContextManager::instance()->getOutputDir();
+
+  for (const auto& Shape : m_Settings.Shapes)
+  {
+    for (const auto& Size : m_Settings.Sizes)
+    {
+      Results["cases"].push_back(runCase(Shape,Size));
+    }
+  }
+
+  // peak RSS of the whole session, which is the only scope where this high-water mark is meaningful
+  Results["session"] = openfluid::thirdparty::json::object();
+  setMemoryMeasure(Results["session"],"peak_rss_bytes",readMemoryCounters(),
+                   openfluid::machine::ProfilingCounters::Counter::PEAKRSS);
+
+  openfluid::base::RunContextManager::instance()->setWaresMaxNumThreads(CurrentThreads);
+  openfluid::base::RunContextManager::instance()->setInputDir(CurrentInputDir);
+  openfluid::base::RunContextManager::instance()->setOutputDir(CurrentOutputDir);
+
+  return Results;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::thirdparty::json BenchmarkRunner::compareWithBaseline(const openfluid::thirdparty::json& Results,
+                                                                 const openfluid::thirdparty::json& Baseline,
+                                                                 double Tolerance)
+{
+  openfluid::thirdparty::json Comparison = {{"tolerance",Tolerance},{"compared",0u},
+                                            {"regressions",openfluid::thirdparty::json::array()},
+                                            {"improvements",openfluid::thirdparty::json::array()}};
+
+  if (!Results.contains("cases") || !Baseline.contains("cases") ||
+      !Results["cases"].is_array() || !Baseline["cases"].is_array())
+  {
+    return Comparison;
+  }
+
+  for (const auto& Case : Results["cases"])
+  {
+    const std::string CaseName = Case.value("name","");
+
+    for (const auto& RefCase : Baseline["cases"])
+    {
+      if (RefCase.value("name","") != CaseName)
+      {
+        continue;
+      }
+
+      for (const auto& Measure : ComparedCaseMeasures)
+      {
+        compareMeasure(Comparison,CaseName,0,Measure,Case,RefCase,Tolerance);
+      }
+
+      if (!Case.contains("runs") || !RefCase.contains("runs"))
+      {
+        continue;
+      }
+
+      for (const auto& Run : Case["runs"])
+      {
+        for (const auto& RefRun : RefCase["runs"])
+        {
+          if (Run.value("threads",0u) == RefRun.value("threads",0u))
+          {
+            for (const auto& Measure : ComparedRunMeasures)
+            {
+              compareMeasure(Comparison,CaseName,Run.value("threads",0u),Measure,Run,RefRun,Tolerance);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return Comparison;
+}
@@ -0,0 +1,139 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file BenchmarkRunner.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_BENCHMARKSAPP_BENCHMARKRUNNER_HPP__
+#define __OPENFLUID_BENCHMARKSAPP_BENCHMARKRUNNER_HPP__
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <openfluid/fluidx/FluidXDescriptor.hpp>
+#include <openfluid/machine/ProfilingCounters.hpp>
+#include <openfluid/thirdparty/JSON.hpp>
+
+#include "SyntheticDomains.hpp"
+
+
+/**
+  Settings of a benchmarks session
+*/
+struct BenchmarkSettings
+{
+  std::vector<DomainShape> Shapes = {DomainShape::GRID,DomainShape::DENDRITIC};
+
+  std::vector<unsigned int> Sizes = {1000,10000,100000,1000000};
+
+  unsigned int StepsCount = 24;
+
+  std::vector<unsigned int> ThreadsCounts = {1};
+
+  std::string WorkDir;
+
+  bool WithCSVObserver = true;
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Runs the benchmark cases (one case per domain shape and size) and gathers the measures as a JSON document.
+  For each case, the synthetic dataset is generated, written and loaded back from disk,
+  then the simulation is built and run once for each threads count.
+  All cases are run in the same process, so the peak resident set size is a process-wide high-water mark:
+  the peak_rss_growth_bytes measure of a run is the growth of this mark during the run, it is zero
+  when a previous case or run already reached a higher peak and must not be read as the peak of the run alone.
+*/
+class BenchmarkRunner
+{
+  private:
+
+    const BenchmarkSettings m_Settings;
+
+    bool m_IsCSVObserverAvailable;
+
+    openfluid::machine::SystemProfilingCountersBackend m_CountersBackend;
+
+    std::ostream& m_OutStm;
+
+    openfluid::machine::ProfilingCounters readMemoryCounters();
+
+    openfluid::thirdparty::json runCase(DomainShape Shape, unsigned int UnitsCount);
+
+    openfluid::thirdparty::json runSimulation(const openfluid::fluidx::FluidXDescriptor& FXDesc,
+                                              unsigned int UnitsCount, const std::string& OutputDir,
+                                              unsigned int ThreadsCount);
+
+
+  public:
+
+    /**
+      Minimum duration (in seconds) of a measure to be compared against a baseline,
+      shorter measures are considered as too noisy
+    */
+    static constexpr double MinComparedDuration = 0.01;
+
+    BenchmarkRunner() = delete;
+
+    BenchmarkRunner(const BenchmarkSettings& Settings, std::ostream& OutStm = std::cout);
+
+    /**
+      Runs all benchmark cases
+      @return the JSON document of measures
+    */
+    openfluid::thirdparty::json run();
+
+    /**
+      Compares measures against baseline measures produced by a previous session.
+      Durations and memory usages of cases and threads counts present in both documents are compared,
+      a measure is reported as a regression if it exceeds the baseline measure by more than the given tolerance.
+      @param[in] Results the current measures
+      @param[in] Baseline the baseline measures
+      @param[in] Tolerance the relative tolerance (e.g. 0.1 for 10%)
+      @return the JSON document of the comparison, including the list of regressions
+    */
+    static openfluid::thirdparty::json compareWithBaseline(const openfluid::thirdparty::json& Results,
+                                                           const openfluid::thirdparty::json& Baseline,
+                                                           double Tolerance);
+};
+
+
+#endif /* __OPENFLUID_BENCHMARKSAPP_BENCHMARKRUNNER_HPP__ */
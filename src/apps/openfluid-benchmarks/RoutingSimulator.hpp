@@ -0,0 +1,213 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file RoutingSimulator.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_BENCHMARKSAPP_ROUTINGSIMULATOR_HPP__
+#define __OPENFLUID_BENCHMARKSAPP_ROUTINGSIMULATOR_HPP__
+
+
+#include <openfluid/ware/PluggableSimulator.hpp>
+#include <openfluid/machine/WareContainer.hpp>
+
+#include "SyntheticDomains.hpp"
+
+
+/**
+  Linear reservoir routing simulator used by benchmarks.
+  Each unit receives the rain on its area and the outflows of its upstream units at the current time step,
+  then releases a fixed fraction of its storage. Units are processed using the graph ordered threaded loop.
+  This simulator is built into the benchmarks program so that measures do not depend on installed plugins.
+*/
+class RoutingSimulator : public openfluid::ware::PluggableSimulator
+{
+  private:
+
+    const double m_ReleaseCoeff = 0.3;
+
+    void initializeUnit(openfluid::core::SpatialUnit* U)
+    {
+      OPENFLUID_InitializeVariable(U,"bench.storage",0.0);
+      OPENFLUID_InitializeVariable(U,"bench.outflow",0.0);
+    }
+
+    void routeUnit(openfluid::core::SpatialUnit* U)
+    {
+      double Rain = 0.0;
+      double Area = 0.0;
+      double Storage = 0.0;
+
+      OPENFLUID_GetVariable(U,"bench.rain",Rain);
+      OPENFLUID_GetAttribute(U,"area",Area);
+      OPENFLUID_GetVariable(U,"bench.storage",OPENFLUID_GetPreviousRunTimeIndex(),Storage);
+
+      Storage += Rain*Area*0.001;
+
+      const openfluid::core::UnitsPtrList_t* UpList = U->fromSpatialUnits(BenchUnitsClass);
+
+      if (UpList)
+      {
+        for (const auto* UpU : *UpList)
+        {
+          double UpOutflow = 0.0;
+          OPENFLUID_GetVariable(UpU,"bench.outflow",UpOutflow);
+          Storage += UpOutflow;
+        }
+      }
+
+      const double Outflow = m_ReleaseCoeff*Storage;
+
+      OPENFLUID_AppendVariable(U,"bench.storage",Storage-Outflow);
+      OPENFLUID_AppendVariable(U,"bench.outflow",Outflow);
+    }
+
+
+  public:
+
+    RoutingSimulator() : PluggableSimulator()
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    ~RoutingSimulator()
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void initParams(const openfluid::ware::WareParams_t& /*Params*/)
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void prepareData()
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void checkConsistency()
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    openfluid::base::SchedulingRequest initializeRun()
+    {
+      openfluid::core::SpatialUnit* U;
+
+      OPENFLUID_UNITS_ORDERED_LOOP(BenchUnitsClass,U)
+      {
+        initializeUnit(U);
+      }
+
+      return DefaultDeltaT();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    openfluid::base::SchedulingRequest runStep()
+    {
+      OPENFLUID_GraphOrderedParallelLoop(BenchUnitsClass,
+                                         [this](openfluid::core::SpatialUnit* U) { routeUnit(U); });
+
+      return DefaultDeltaT();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void finalizeRun()
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Returns a validated container holding the signature of the routing simulator
+    */
+    static openfluid::machine::WareContainer<openfluid::ware::SimulatorSignature> createContainer()
+    {
+      openfluid::machine::WareContainer<openfluid::ware::SimulatorSignature> Cont(
+        openfluid::ware::WareType::SIMULATOR
+      );
+
+      auto Sign = new openfluid::ware::SimulatorSignature();
+      Sign->ID = "bench.routing";
+      Sign->Name = "Linear reservoir routing for benchmarks";
+      Sign->HandledData.RequiredVars.push_back(
+        openfluid::ware::SignatureSpatialDataItem("bench.rain",BenchUnitsClass,"rain height","mm")
+      );
+      Sign->HandledData.RequiredAttribute.push_back(
+        openfluid::ware::SignatureSpatialDataItem("area",BenchUnitsClass,"area of the unit","m2")
+      );
+      Sign->SimulatorHandledData.ProducedVars.push_back(
+        openfluid::ware::SignatureSpatialDataItem("bench.storage",BenchUnitsClass,"stored volume","m3",
+                                                  openfluid::core::Value::DOUBLE)
+      );
+      Sign->SimulatorHandledData.ProducedVars.push_back(
+        openfluid::ware::SignatureSpatialDataItem("bench.outflow",BenchUnitsClass,"outflow volume","m3",
+                                                  openfluid::core::Value::DOUBLE)
+      );
+
+      Cont.setSignature(Sign);
+      Cont.validate();
+
+      return Cont;
+    }
+};
+
+
+#endif /* __OPENFLUID_BENCHMARKSAPP_ROUTINGSIMULATOR_HPP__ */
@@ -0,0 +1,266 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SyntheticDomains.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <set>
+
+#include <openfluid/fluidx/GeneratorDescriptor.hpp>
+#include <openfluid/fluidx/ObserverDescriptor.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+#include "SyntheticDomains.hpp"
+
+
+std::string getShapeName(DomainShape Shape)
+{
+  if (Shape == DomainShape::DENDRITIC)
+  {
+    return "dendritic";
+  }
+
+  return "grid";
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool getShapeFromName(const std::string& Name, DomainShape& Shape)
+{
+  if (Name == "grid")
+  {
+    Shape = DomainShape::GRID;
+    return true;
+  }
+  else if (Name == "dendritic")
+  {
+    Shape = DomainShape::DENDRITIC;
+    return true;
+  }
+
+  return false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<unsigned int> computeDownstreamUnits(DomainShape Shape, unsigned int UnitsCount)
+{
+  std::vector<unsigned int> Downstream(UnitsCount,UnitsCount);
+
+  if (Shape == DomainShape::GRID)
+  {
+    const unsigned int ColsCount = std::max(1u,(unsigned int)std::ceil(std::sqrt((double)UnitsCount)));
+
+    for (unsigned int i = 0; i+1 < UnitsCount; i++)
+    {
+      if (i%ColsCount != ColsCount-1)
+      {
+        Downstream[i] = i+1;
+      }
+      else
+      {
+        // last column, flows to the cell below or to the outlet if the last row is partial
+        Downstream[i] = std::min(i+ColsCount,UnitsCount-1);
+      }
+    }
+  }
+  else
+  {
+    for (unsigned int i = 1; i < UnitsCount; i++)
+    {
+      Downstream[i] = (i-1)/2;
+    }
+  }
+
+  return Downstream;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<openfluid::core::PcsOrd_t> computeProcessOrders(const std::vector<unsigned int>& Downstream)
+{
+  const unsigned int UnitsCount = Downstream.size();
+  std::vector<openfluid::core::PcsOrd_t> Orders(UnitsCount,1);
+  std::vector<unsigned int> UpstreamCount(UnitsCount,0);
+  std::deque<unsigned int> Ready;
+
+  for (unsigned int i = 0; i < UnitsCount; i++)
+  {
+    if (Downstream[i] < UnitsCount)
+    {
+      UpstreamCount[Downstream[i]]++;
+    }
+  }
+
+  for (unsigned int i = 0; i < UnitsCount; i++)
+  {
+    if (!UpstreamCount[i])
+    {
+      Ready.push_back(i);
+    }
+  }
+
+  while (!Ready.empty())
+  {
+    const unsigned int Current = Ready.front();
+    Ready.pop_front();
+
+    const unsigned int Down = Downstream[Current];
+
+    if (Down < UnitsCount)
+    {
+      Orders[Down] = std::max(Orders[Down],Orders[Current]+1);
+
+      if (!(--UpstreamCount[Down]))
+      {
+        Ready.push_back(Down);
+      }
+    }
+  }
+
+  return Orders;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void buildSyntheticDataset(const DatasetDefinition& Def, openfluid::fluidx::FluidXDescriptor& FXDesc)
+{
+  if (!Def.UnitsCount || !Def.StepsCount)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "units and steps counts of benchmark datasets must not be zero");
+  }
+
+
+  // --- run configuration
+
+  openfluid::core::DateTime DT(2020,1,1,0,0,0);
+  FXDesc.runConfiguration().setBeginDate(DT);
+  DT.addSeconds(3600*Def.StepsCount);
+  FXDesc.runConfiguration().setEndDate(DT);
+  FXDesc.runConfiguration().setDeltaT(3600);
+  FXDesc.runConfiguration().setValuesBufferSize(3);
+  FXDesc.runConfiguration().setFilled(true);
+
+
+  // --- spatial domain
+
+  const std::vector<unsigned int> Downstream = computeDownstreamUnits(Def.Shape,Def.UnitsCount);
+  const std::vector<openfluid::core::PcsOrd_t> Orders = computeProcessOrders(Downstream);
+  std::set<openfluid::core::UnitID_t> SampleIDs;
+
+  for (unsigned int i = 0; i < Def.UnitsCount; i++)
+  {
+    openfluid::fluidx::SpatialUnitDescriptor UnitDesc;
+
+    UnitDesc.setUnitsClass(BenchUnitsClass);
+    UnitDesc.setID(i+1);
+    UnitDesc.setProcessOrder(Orders[i]);
+
+    if (Downstream[i] < Def.UnitsCount)
+    {
+      UnitDesc.toSpatialUnits().push_back({BenchUnitsClass,Downstream[i]+1});
+    }
+    else
+    {
+      SampleIDs.insert(i+1);
+    }
+
+    // relations are consistent by construction, checks are skipped as downstream units may not exist yet
+    FXDesc.spatialDomain().addUnit(UnitDesc,false);
+  }
+
+  FXDesc.spatialDomain().addAttribute(BenchUnitsClass,"area","0");
+
+  for (unsigned int i = 0; i < Def.UnitsCount; i++)
+  {
+    // deterministic areas between 100 and 999 m2
+    FXDesc.spatialDomain().setAttribute(BenchUnitsClass,i+1,"area",std::to_string(100+(i*37)%900));
+  }
+
+
+  // --- model, the routing simulator is not a plugin and is appended to the model instance at run time
+
+  auto Gen = new openfluid::fluidx::GeneratorDescriptor({{BenchUnitsClass,"bench.rain"}},
+                                                        openfluid::fluidx::GeneratorDescriptor::GeneratorMethod::RANDOM,
+                                                        openfluid::core::Value::DOUBLE);
+  Gen->setParameter("min","0");
+  Gen->setParameter("max","10");
+  FXDesc.model().appendItem(Gen);
+
+
+  // --- monitoring, variables of outlets and of a sample of units spread over the domain
+
+  if (Def.WithCSVObserver)
+  {
+    const unsigned int SamplesCount = std::min(10u,Def.UnitsCount);
+
+    for (unsigned int i = 0; i < SamplesCount; i++)
+    {
+      SampleIDs.insert(1+(unsigned long long)i*(Def.UnitsCount-1)/std::max(1u,SamplesCount-1));
+    }
+
+    std::string IDsStr;
+    for (const auto& ID : SampleIDs)
+    {
+      IDsStr += (IDsStr.empty() ? "" : ";")+std::to_string(ID);
+    }
+
+    auto Obs = new openfluid::fluidx::ObserverDescriptor("export.vars.files.csv");
+    Obs->setParameter("format.bench.colsep",";");
+    Obs->setParameter("format.bench.date","ISO");
+    Obs->setParameter("format.bench.header","colnames-as-comment");
+    Obs->setParameter("set.bench.format","bench");
+    Obs->setParameter("set.bench.unitsclass",BenchUnitsClass);
+    Obs->setParameter("set.bench.unitsIDs",IDsStr);
+    Obs->setParameter("set.bench.vars","*");
+    FXDesc.monitoring().appendItem(Obs);
+  }
+}
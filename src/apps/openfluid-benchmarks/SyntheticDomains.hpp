@@ -0,0 +1,126 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SyntheticDomains.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_BENCHMARKSAPP_SYNTHETICDOMAINS_HPP__
+#define __OPENFLUID_BENCHMARKSAPP_SYNTHETICDOMAINS_HPP__
+
+
+#include <string>
+#include <vector>
+
+#include <openfluid/fluidx/FluidXDescriptor.hpp>
+
+
+/**
+  Shapes of the synthetic spatial domains used by benchmarks
+*/
+enum class DomainShape { GRID, DENDRITIC };
+
+
+/**
+  Definition of a benchmark dataset
+*/
+struct DatasetDefinition
+{
+  DomainShape Shape = DomainShape::GRID;
+
+  unsigned int UnitsCount = 1000;
+
+  unsigned int StepsCount = 24;
+
+  bool WithCSVObserver = true;
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Units class of the synthetic spatial domains
+*/
+constexpr const char* BenchUnitsClass = "BU";
+
+
+/**
+  Returns the name of the given domain shape ("grid" or "dendritic")
+*/
+std::string getShapeName(DomainShape Shape);
+
+
+/**
+  Gets the domain shape from the given name
+  @param[in] Name the name of the shape
+  @param[out] Shape the corresponding shape
+  @return false if the name is not a known shape
+*/
+bool getShapeFromName(const std::string& Name, DomainShape& Shape);
+
+
+/**
+  Computes the downstream unit of each unit of a synthetic domain, as an index in the [0,UnitsCount) range.
+  Outlets have no downstream unit and are marked using the UnitsCount value.
+  - grid: cells are ordered by rows, each cell flows to its right neighbour,
+    cells of the last column flow to the cell below, the last cell is the outlet
+  - dendritic: a binary tree where unit i flows to unit (i-1)/2, the first unit is the outlet
+  @param[in] Shape the shape of the domain
+  @param[in] UnitsCount the number of units
+  @return the vector of downstream units indexes
+*/
+std::vector<unsigned int> computeDownstreamUnits(DomainShape Shape, unsigned int UnitsCount);
+
+
+/**
+  Computes the process orders of units from their downstream units, as the length of the longest path
+  from the most upstream units (process order 1)
+  @param[in] Downstream the downstream units indexes, as given by computeDownstreamUnits()
+  @return the vector of process orders
+*/
+std::vector<openfluid::core::PcsOrd_t> computeProcessOrders(const std::vector<unsigned int>& Downstream);
+
+
+/**
+  Builds a full benchmark dataset: spatial domain, canonical model (random rain generator, routing simulator
+  added at run time) and a CSV observer exporting variables for a sample of units
+  @param[in] Def the dataset definition
+  @param[out] FXDesc the descriptor to fill
+*/
+void buildSyntheticDataset(const DatasetDefinition& Def, openfluid::fluidx::FluidXDescriptor& FXDesc);
+
+
+#endif /* __OPENFLUID_BENCHMARKSAPP_SYNTHETICDOMAINS_HPP__ */
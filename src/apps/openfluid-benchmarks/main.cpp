@@ -0,0 +1,299 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file main.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <fstream>
+#include <iomanip>
+
+#include <openfluid/base/Init.hpp>
+#include <openfluid/base/ApplicationException.hpp>
+#include <openfluid/base/Environment.hpp>
+#include <openfluid/tools/Filesystem.hpp>
+#include <openfluid/tools/StringHelpers.hpp>
+#include <openfluid/utils/CommandLineParser.hpp>
+
+#include "BenchmarkRunner.hpp"
+
+
+openfluid::base::ExceptionContext getAppContext()
+{
+  return openfluid::base::ApplicationException::computeContext("openfluid-benchmarks",OPENFLUID_CODE_LOCATION);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<unsigned int> getNumbersList(const std::string& Str, const std::string& OptName)
+{
+  std::vector<unsigned int> List;
+
+  for (const auto& Item : openfluid::tools::split(Str,','))
+  {
+    unsigned int Num = 0;
+
+    if (!openfluid::tools::toNumeric(Item,Num) || !Num)
+    {
+      throw openfluid::base::ApplicationException(getAppContext(),
+                                                  "wrong value \"" + Item + "\" for option " + OptName);
+    }
+    List.push_back(Num);
+  }
+
+  if (List.empty())
+  {
+    throw openfluid::base::ApplicationException(getAppContext(),"empty list for option " + OptName);
+  }
+
+  return List;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<unsigned int> getDefaultThreadsCounts()
+{
+  const unsigned int MaxThreads = std::max(1,openfluid::base::Environment::getIdealThreadCount());
+  std::vector<unsigned int> Counts;
+
+  for (unsigned int i = 1; i < MaxThreads; i *= 2)
+  {
+    Counts.push_back(i);
+  }
+  Counts.push_back(MaxThreads);
+
+  return Counts;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::thirdparty::json readJSONFile(const std::string& FilePath)
+{
+  std::ifstream InFile(FilePath);
+
+  if (!InFile.is_open())
+  {
+    throw openfluid::base::ApplicationException(getAppContext(),"unable to open file " + FilePath);
+  }
+
+  try
+  {
+    return openfluid::thirdparty::json::parse(InFile);
+  }
+  catch (openfluid::thirdparty::json::exception&)
+  {
+    throw openfluid::base::ApplicationException(getAppContext(),"wrong JSON format in file " + FilePath);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+int main(int argc, char **argv)
+{
+  INIT_OPENFLUID_APPLICATION();
+
+  try
+  {
+    openfluid::utils::CommandLineParser Parser("openfluid-benchmarks",
+                                               "Runs benchmarks of OpenFLUID simulations on synthetic datasets");
+
+    Parser.addOption({"shapes","s","shapes of spatial domains, comma separated (default is grid,dendritic)",true});
+    Parser.addOption({"sizes","z","numbers of spatial units, comma separated (default is 1000,10000,100000,1000000)",
+                      true});
+    Parser.addOption({"steps","t","number of time steps of simulations (default is 24)",true});
+    Parser.addOption({"threads","j","numbers of threads, comma separated (default is 1 to the ideal threads count)",
+                      true});
+    Parser.addOption({"work-dir","w","directory for generated datasets and outputs "
+                                     "(default is openfluid-benchmarks in the temporary directory)",true});
+    Parser.addOption({"output","o","path of the JSON file for measures (default is openfluid-benchmarks.json)",true});
+    Parser.addOption({"baseline","b","path of a JSON file of baseline measures to compare with",true});
+    Parser.addOption({"tolerance","r","relative tolerance for comparison with baseline (default is 0.1)",true});
+    Parser.addOption({"observers-paths","n","add extra observers search paths",true});
+    Parser.addOption({"no-observer","","do not use the CSV observer in simulations"});
+
+    if (!Parser.parse(argc,argv))
+    {
+      throw openfluid::base::ApplicationException(getAppContext(),Parser.getParsingMessage());
+    }
+
+    if (Parser.isHelpAsked())
+    {
+      Parser.printHelp(std::cout);
+      return 0;
+    }
+
+    const auto& Cmd = Parser.command("");
+    BenchmarkSettings Settings;
+    std::string OutputPath = "openfluid-benchmarks.json";
+    double Tolerance = 0.1;
+
+    Settings.ThreadsCounts = getDefaultThreadsCounts();
+    Settings.WorkDir = openfluid::tools::Filesystem::joinPath({openfluid::base::Environment::getTempDir(),
+                                                               "openfluid-benchmarks"});
+
+    if (Cmd.isOptionActive("shapes"))
+    {
+      Settings.Shapes.clear();
+
+      for (const auto& Name : openfluid::tools::split(Cmd.getOptionValue("shapes"),','))
+      {
+        DomainShape Shape;
+        if (!getShapeFromName(Name,Shape))
+        {
+          throw openfluid::base::ApplicationException(getAppContext(),"unknown domain shape \"" + Name + "\"");
+        }
+        Settings.Shapes.push_back(Shape);
+      }
+    }
+
+    if (Cmd.isOptionActive("sizes"))
+    {
+      Settings.Sizes = getNumbersList(Cmd.getOptionValue("sizes"),"sizes");
+    }
+
+    if (Cmd.isOptionActive("steps"))
+    {
+      Settings.StepsCount = getNumbersList(Cmd.getOptionValue("steps"),"steps").front();
+    }
+
+    if (Cmd.isOptionActive("threads"))
+    {
+      Settings.ThreadsCounts = getNumbersList(Cmd.getOptionValue("threads"),"threads");
+    }
+
+    if (Cmd.isOptionActive("work-dir"))
+    {
+      Settings.WorkDir = Cmd.getOptionValue("work-dir");
+    }
+
+    if (Cmd.isOptionActive("output"))
+    {
+      OutputPath = Cmd.getOptionValue("output");
+    }
+
+    if (Cmd.isOptionActive("tolerance"))
+    {
+      if (!openfluid::tools::toNumeric(Cmd.getOptionValue("tolerance"),Tolerance) || Tolerance < 0.0)
+      {
+        throw openfluid::base::ApplicationException(getAppContext(),"wrong value for option tolerance");
+      }
+    }
+
+    if (Cmd.isOptionActive("observers-paths"))
+    {
+      openfluid::base::Environment::addExtraObserversDirs(Cmd.getOptionValue("observers-paths"));
+    }
+
+    Settings.WithCSVObserver = !Cmd.isOptionActive("no-observer");
+
+
+    // --- run and comparison
+
+    openfluid::thirdparty::json Baseline;
+    if (Cmd.isOptionActive("baseline"))
+    {
+      // baseline is read first to fail early on a wrong file
+      Baseline = readJSONFile(Cmd.getOptionValue("baseline"));
+    }
+
+    auto Results = BenchmarkRunner(Settings).run();
+    unsigned int RegressionsCount = 0;
+
+    if (Cmd.isOptionActive("baseline"))
+    {
+      Results["comparison"] = BenchmarkRunner::compareWithBaseline(Results,Baseline,Tolerance);
+      Results["comparison"]["baseline"] = Cmd.getOptionValue("baseline");
+
+      RegressionsCount = Results["comparison"]["regressions"].size();
+
+      std::cout << std::endl;
+      std::cout << Results["comparison"]["compared"].get<unsigned int>() << " measure(s) compared with baseline, "
+                << RegressionsCount << " regression(s), "
+                << Results["comparison"]["improvements"].size() << " improvement(s)" << std::endl;
+
+      for (const auto& Reg : Results["comparison"]["regressions"])
+      {
+        std::cout << "  - " << Reg["case"].get<std::string>();
+        if (Reg.contains("threads"))
+        {
+          std::cout << " (" << Reg["threads"].get<unsigned int>() << " thread(s))";
+        }
+        std::cout << ", " << Reg["measure"].get<std::string>() << ": " << Reg["baseline"].get<double>()
+                  << " -> " << Reg["current"].get<double>() << std::endl;
+      }
+    }
+
+    std::ofstream OutFile(OutputPath);
+    if (!OutFile.is_open())
+    {
+      throw openfluid::base::ApplicationException(getAppContext(),"unable to write file " + OutputPath);
+    }
+    OutFile << std::setw(2) << Results << std::endl;
+
+    std::cout << std::endl << "Measures written to " << OutputPath << std::endl;
+
+    return (RegressionsCount ? 1 : 0);
+  }
+  catch (openfluid::base::Exception& E)
+  {
+    std::cerr << "ERROR: " + std::string(E.what()) << std::endl;
+  }
+  catch (std::bad_alloc& E)
+  {
+    std::cerr << "MEMORY ALLOCATION ERROR: " +
+                 std::string(E.what()) + ". Possibly not enough memory available" << std::endl;
+  }
+  catch (std::exception& E)
+  {
+    std::cerr << "SYSTEM ERROR: " + std::string(E.what()) << std::endl;
+  }
+  catch (...)
+  {
+    std::cerr << "UNKNOWN ERROR" << std::endl;
+  }
+
+  return 127;
+}
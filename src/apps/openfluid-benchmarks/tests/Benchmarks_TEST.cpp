@@ -0,0 +1,246 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+
+
+/**
+  @file Benchmarks_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_benchmarks
+
+
+#include <fstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/fluidx/FluidXDescriptor.hpp>
+#include <openfluid/tools/Filesystem.hpp>
+
+#include "BenchmarkRunner.hpp"
+#include "SyntheticDomains.hpp"
+#include "tests-config.hpp"
+
+
+// =====================================================================
+// =====================================================================
+
+
+void checkDomain(DomainShape Shape, unsigned int UnitsCount)
+{
+  BOOST_TEST_MESSAGE(getShapeName(Shape) << " domain of " << UnitsCount << " unit(s)");
+
+  DatasetDefinition Def;
+  Def.Shape = Shape;
+  Def.UnitsCount = UnitsCount;
+  Def.StepsCount = 5;
+
+  openfluid::fluidx::FluidXDescriptor FXDesc;
+  buildSyntheticDataset(Def,FXDesc);
+
+  const auto& Domain = FXDesc.spatialDomain();
+
+  BOOST_REQUIRE_EQUAL(Domain.getUnitsCount(),UnitsCount);
+  BOOST_REQUIRE_EQUAL(Domain.getUnitsCount(BenchUnitsClass),UnitsCount);
+  BOOST_REQUIRE_NO_THROW(Domain.checkUnitsRelations());
+
+  unsigned int OutletsCount = 0;
+
+  for (unsigned int ID = 1; ID <= UnitsCount; ID++)
+  {
+    openfluid::core::UnitClassID_t Current = {BenchUnitsClass,ID};
+    unsigned int PathLength = 0;
+
+    // each unit has at most one downstream unit and must reach the outlet in less steps than the units count,
+    // otherwise the path contains a cycle
+    while (!Domain.toSpatialUnits(Current).empty())
+    {
+      const auto& ToUnits = Domain.toSpatialUnits(Current);
+      BOOST_REQUIRE_EQUAL(ToUnits.size(),1);
+
+      const auto& Down = ToUnits.front();
+      BOOST_REQUIRE_GT(Domain.spatialUnit(Down.first,Down.second).getProcessOrder(),
+                       Domain.spatialUnit(Current.first,Current.second).getProcessOrder());
+
+      Current = Down;
+      BOOST_REQUIRE_LT(++PathLength,UnitsCount);
+    }
+
+    if (!PathLength)
+    {
+      OutletsCount++;
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(OutletsCount,1);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_downstream_units)
+{
+  const auto Grid = computeDownstreamUnits(DomainShape::GRID,10);
+  BOOST_REQUIRE_EQUAL(Grid.size(),10);
+  BOOST_REQUIRE_EQUAL(Grid[0],1);
+  BOOST_REQUIRE_EQUAL(Grid[3],7);
+  BOOST_REQUIRE_EQUAL(Grid[8],9);
+  BOOST_REQUIRE_EQUAL(Grid[9],10);
+
+  const auto Dendritic = computeDownstreamUnits(DomainShape::DENDRITIC,7);
+  BOOST_REQUIRE_EQUAL(Dendritic.size(),7);
+  BOOST_REQUIRE_EQUAL(Dendritic[0],7);
+  BOOST_REQUIRE_EQUAL(Dendritic[1],0);
+  BOOST_REQUIRE_EQUAL(Dendritic[2],0);
+  BOOST_REQUIRE_EQUAL(Dendritic[6],2);
+
+  const auto Orders = computeProcessOrders(Dendritic);
+  BOOST_REQUIRE_EQUAL(Orders[0],3);
+  BOOST_REQUIRE_EQUAL(Orders[1],2);
+  BOOST_REQUIRE_EQUAL(Orders[6],1);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_grid_domains)
+{
+  for (const unsigned int Count : {1,2,10,100,101,1000})
+  {
+    checkDomain(DomainShape::GRID,Count);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_dendritic_domains)
+{
+  for (const unsigned int Count : {1,2,10,100,101,1000})
+  {
+    checkDomain(DomainShape::DENDRITIC,Count);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_wrong_dataset)
+{
+  DatasetDefinition Def;
+  Def.UnitsCount = 0;
+
+  openfluid::fluidx::FluidXDescriptor FXDesc;
+  BOOST_REQUIRE_THROW(buildSyntheticDataset(Def,FXDesc),openfluid::base::FrameworkException);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_compare_baseline)
+{
+  const std::string BaselinePath =
+    openfluid::tools::Filesystem::joinPath({CONFIGTESTS_INPUT_DATASETS_DIR,"OPENFLUID.IN.BenchmarksBaseline",
+                                            "baseline.json"});
+  std::ifstream BaselineFile(BaselinePath);
+  BOOST_REQUIRE(BaselineFile.is_open());
+
+  openfluid::thirdparty::json Baseline;
+  BaselineFile >> Baseline;
+  BOOST_REQUIRE(!Baseline["cases"].empty());
+
+
+  // same measures
+
+  auto Comparison = BenchmarkRunner::compareWithBaseline(Baseline,Baseline,0.1);
+  BOOST_REQUIRE_GT(Comparison["compared"].get<unsigned int>(),0);
+  BOOST_REQUIRE(Comparison["regressions"].empty());
+  BOOST_REQUIRE(Comparison["improvements"].empty());
+
+
+  // regression and improvement
+
+  openfluid::thirdparty::json Results = {{"cases",openfluid::thirdparty::json::array()}};
+  Results["cases"].push_back({{"name","grid-1000"},{"load_time_s",1.0},
+                              {"runs",{{{"threads",1},{"run_time_s",2.0},{"heap_bytes",500}}}}});
+  Results["cases"].push_back({{"name","unknown-10"},{"load_time_s",1.0}});
+
+  openfluid::thirdparty::json Reference = {{"cases",openfluid::thirdparty::json::array()}};
+  Reference["cases"].push_back({{"name","grid-1000"},{"load_time_s",2.0},
+                                {"runs",{{{"threads",1},{"run_time_s",1.0},{"heap_bytes",480}},
+                                         {{"threads",2},{"run_time_s",1.0}}}}});
+
+  Comparison = BenchmarkRunner::compareWithBaseline(Results,Reference,0.1);
+  BOOST_REQUIRE_EQUAL(Comparison["compared"].get<unsigned int>(),3);
+  BOOST_REQUIRE_EQUAL(Comparison["regressions"].size(),1);
+  BOOST_REQUIRE_EQUAL(Comparison["regressions"][0]["case"].get<std::string>(),"grid-1000");
+  BOOST_REQUIRE_EQUAL(Comparison["regressions"][0]["measure"].get<std::string>(),"run_time_s");
+  BOOST_REQUIRE_EQUAL(Comparison["regressions"][0]["threads"].get<unsigned int>(),1);
+  BOOST_REQUIRE_CLOSE(Comparison["regressions"][0]["ratio"].get<double>(),2.0,0.001);
+  BOOST_REQUIRE_EQUAL(Comparison["improvements"].size(),1);
+  BOOST_REQUIRE_EQUAL(Comparison["improvements"][0]["measure"].get<std::string>(),"load_time_s");
+  BOOST_REQUIRE(!Comparison["improvements"][0].contains("threads"));
+
+  // a larger tolerance hides both
+  Comparison = BenchmarkRunner::compareWithBaseline(Results,Reference,1.5);
+  BOOST_REQUIRE_EQUAL(Comparison["compared"].get<unsigned int>(),3);
+  BOOST_REQUIRE(Comparison["regressions"].empty());
+  BOOST_REQUIRE(Comparison["improvements"].empty());
+
+
+  // too short durations are not compared
+
+  Results["cases"][0]["runs"][0]["run_time_s"] = BenchmarkRunner::MinComparedDuration/10;
+  Reference["cases"][0]["runs"][0]["run_time_s"] = BenchmarkRunner::MinComparedDuration/20;
+
+  Comparison = BenchmarkRunner::compareWithBaseline(Results,Reference,0.1);
+  BOOST_REQUIRE_EQUAL(Comparison["compared"].get<unsigned int>(),2);
+  BOOST_REQUIRE(Comparison["regressions"].empty());
+
+
+  // documents without cases
+
+  Comparison = BenchmarkRunner::compareWithBaseline(Results,openfluid::thirdparty::json::object(),0.1);
+  BOOST_REQUIRE_EQUAL(Comparison["compared"].get<unsigned int>(),0);
+}
@@ -38,14 +38,18 @@
 
 
 #include <memory>
+#include <vector>
 
 #include <openfluid/base/RunContextManager.hpp>
+#include <openfluid/machine/DomainDecomposition.hpp>
 #include <openfluid/machine/Engine.hpp>
 #include <openfluid/machine/SimulationBlob.hpp>
 #include <openfluid/machine/ModelInstance.hpp>
 #include <openfluid/machine/MonitoringInstance.hpp>
 #include <openfluid/machine/Factory.hpp>
+#include <openfluid/machine/StorageAccuracy.hpp>
 #include <openfluid/fluidx/FluidXIO.hpp>
+#include <openfluid/tools/Filesystem.hpp>
 #include <openfluid/tools/Timer.hpp>
 
 #include "DefaultIOListener.hpp"
@@ -189,6 +193,153 @@ void printEnvInfos()
 // =====================================================================
 
 
+void printlnPartition(const openfluid::machine::DomainPartition& Partition)
+{
+  std::cout << std::endl;
+  std::cout << "Spatial domain partitioned into " << Partition.getPartsCount() << " parts, "
+            << Partition.getEdgeCut() << " relation(s) cut :" << std::endl;
+
+  for (unsigned int Part = 0; Part < Partition.getPartsCount(); Part++)
+  {
+    std::cout << "  - part " << Part << ", " << Partition.units(Part).size() << " units, "
+              << Partition.haloUnits(Part).size() << " halo units" << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Runs the simulation with one worker process per part of the partitioned spatial domain.
+  Each worker writes its outputs in a subdirectory of the output directory named after its part.
+  @return the count of failed workers
+*/
+unsigned int runPartitionedSimulation(openfluid::fluidx::FluidXDescriptor& FXDesc,
+                                      const openfluid::machine::DomainPartition& Partition)
+{
+  const std::string OutputDir = openfluid::base::RunContextManager::instance()->getOutputDir();
+
+  auto Worker = [&FXDesc,&Partition,&OutputDir](openfluid::machine::HaloExchange& Exchange)
+  {
+    const unsigned int Part = Exchange.getPart();
+
+    openfluid::base::RunContextManager::instance()->setOutputDir(
+      openfluid::tools::Filesystem::joinPath({OutputDir,"part"+std::to_string(Part)}));
+
+    // the descriptor of the subdomain replaces the whole domain, which is still needed for halo units
+    openfluid::fluidx::SpatialDomainDescriptor Domain = Partition.extractSubdomain(FXDesc.spatialDomain(),Part);
+    std::swap(Domain,FXDesc.spatialDomain());
+
+    std::unique_ptr<openfluid::machine::MachineListener> MListener =
+      std::make_unique<openfluid::machine::MachineListener>();
+    MListener->setSilentRunSteps();
+
+    openfluid::machine::SimulationBlob SimBlob;
+    openfluid::machine::ModelInstance Model(SimBlob,MListener.get());
+    openfluid::machine::MonitoringInstance Monitoring(SimBlob);
+
+    openfluid::machine::Factory::buildSimulationBlobFromDescriptors(FXDesc,SimBlob);
+    Exchange.attach(SimBlob,Domain);
+    openfluid::machine::Factory::buildModelInstanceFromDescriptor(FXDesc.model(),Model);
+    openfluid::machine::Factory::buildMonitoringInstanceFromDescriptor(FXDesc.monitoring(),Monitoring);
+
+    openfluid::machine::Engine Engine(SimBlob,Model,Monitoring,MListener.get());
+    Engine.setHaloExchange(&Exchange);
+
+    Engine.initialize();
+    Engine.initParams();
+    Engine.prepareData();
+    Engine.checkConsistency();
+    Engine.run();
+    Engine.finalize();
+
+    return 0;
+  };
+
+  return openfluid::machine::DomainDecomposition(Partition).run(Worker);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Replays the simulation with all variables stored at full precision.
+  The replay writes its outputs in the fullprecision subdirectory of the output directory.
+  @return the results of the replay for the given variables
+*/
+openfluid::machine::ResultsStore runFullPrecisionReplay(
+  openfluid::fluidx::FluidXDescriptor& FXDesc,
+  const std::vector<openfluid::machine::ResultsStore::VariableKey_t>& Variables)
+{
+  const std::string OutputDir = openfluid::base::RunContextManager::instance()->getOutputDir();
+  openfluid::base::RunContextManager::instance()->setOutputDir(
+    openfluid::tools::Filesystem::joinPath({OutputDir,"fullprecision"}));
+
+  FXDesc.runConfiguration().clearVariablesStorage();
+
+  std::unique_ptr<openfluid::machine::MachineListener> MListener =
+    std::make_unique<openfluid::machine::MachineListener>();
+  MListener->setSilentRunSteps();
+
+  openfluid::machine::SimulationBlob SimBlob;
+  openfluid::machine::ModelInstance Model(SimBlob,MListener.get());
+  openfluid::machine::MonitoringInstance Monitoring(SimBlob);
+
+  // observers of the dataset are not needed, the results are only compared through the results store
+  for (const auto& Key : Variables)
+  {
+    Monitoring.resultsStore().addVariable(Key.first,Key.second);
+  }
+
+  openfluid::machine::Factory::buildSimulationBlobFromDescriptors(FXDesc,SimBlob);
+  openfluid::machine::Factory::buildModelInstanceFromDescriptor(FXDesc.model(),Model);
+
+  openfluid::machine::Engine Engine(SimBlob,Model,Monitoring,MListener.get());
+
+  Engine.initialize();
+  Engine.initParams();
+  Engine.prepareData();
+  Engine.checkConsistency();
+  Engine.run();
+  Engine.finalize();
+
+  openfluid::base::RunContextManager::instance()->setOutputDir(OutputDir);
+
+  return std::move(Monitoring.resultsStore());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void printlnStorageAccuracy(const std::vector<openfluid::machine::StorageAccuracy::VariableDifference>& Differences)
+{
+  std::cout << "Differences with the simulation replayed at full precision:" << std::endl;
+
+  for (const auto& Diff : Differences)
+  {
+    std::cout << "  - " << Diff.UnitsClass << "#" << Diff.VarName;
+    if (Diff.IsReduced)
+    {
+      std::cout << " (reduced storage)";
+    }
+    std::cout << ", " << Diff.ComparedCount << " values, max. absolute difference: " << Diff.MaxAbsDifference
+              << ", max. relative difference: " << Diff.MaxRelDifference << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 int RunTasks::process() const
 {
   openfluid::base::RunContextManager::instance()->extraProperties().setBoolean("display.verbose",false);
@@ -240,6 +391,39 @@ int RunTasks::process() const
     }
   }
 
+  if (m_Cmd.isOptionActive("checkpoint-period"))
+  {
+    openfluid::core::Duration_t Period = 0;
+
+    if (openfluid::tools::toNumeric(m_Cmd.getOptionValue("checkpoint-period"),Period) && Period > 0)
+    {
+      openfluid::base::RunContextManager::instance()->setCheckpointPeriod(Period);
+    }
+    else
+    {
+      return error("wrong value for checkpoint period");
+    }
+  }
+
+  if (m_Cmd.isOptionActive("restart-from"))
+  {
+    openfluid::base::RunContextManager::instance()->setRestartCheckpointPath(m_Cmd.getOptionValue("restart-from"));
+  }
+
+  if (m_Cmd.isOptionActive("workers"))
+  {
+    unsigned int WorkersCount = 0;
+
+    if (openfluid::tools::toNumeric(m_Cmd.getOptionValue("workers"),WorkersCount) && WorkersCount > 0)
+    {
+      openfluid::base::RunContextManager::instance()->setWorkersCount(WorkersCount);
+    }
+    else
+    {
+      return error("wrong value for workers number");
+    }
+  }
+
   if (m_Cmd.isOptionActive("clean-output-dir"))
   {
     openfluid::base::RunContextManager::instance()->setClearOutputDir(true);
@@ -262,6 +446,12 @@ int RunTasks::process() const
     openfluid::base::RunContextManager::instance()->setProfiling(true);
   }
 
+  if (m_Cmd.isOptionActive("profiling-extended"))
+  {
+    openfluid::base::RunContextManager::instance()->setProfiling(true);
+    openfluid::base::RunContextManager::instance()->setExtendedProfiling(true);
+  }
+
 
   // -----
 
@@ -292,6 +482,7 @@ int RunTasks::process() const
     if (IsQuiet)
     {
       MListener = std::make_unique<openfluid::machine::MachineListener>();
+      MListener->setSilentRunSteps();
     }
     else
     {
@@ -318,6 +509,68 @@ int RunTasks::process() const
     auto FXDesc = FXIO.loadFromDirectory(openfluid::base::RunContextManager::instance()->getInputDir());
 
 
+    const unsigned int WorkersCount = openfluid::base::RunContextManager::instance()->getWorkersCount();
+    const bool CheckStorage = m_Cmd.isOptionActive("check-storage");
+
+    if (CheckStorage)
+    {
+      if (WorkersCount > 1)
+      {
+        return error("storage precision check is not available for simulations run on several workers");
+      }
+
+      if (FXDesc.runConfiguration().getVariablesStorage().empty())
+      {
+        return error("no storage precision set for variables in the run configuration");
+      }
+
+      // the results store must not be empty when the monitoring is initialized,
+      // other variables are selected once they are created
+      for (const auto& VarStorage : FXDesc.runConfiguration().getVariablesStorage())
+      {
+        Monitoring.resultsStore().addVariable(VarStorage.first.first,VarStorage.first.second);
+      }
+    }
+
+    if (WorkersCount > 1)
+    {
+      std::cout << "* Partitioning spatial domain... ";
+      std::cout.flush();
+      const auto Partition = openfluid::machine::DomainPartitioner::partition(FXDesc.spatialDomain(),WorkersCount);
+      openfluid::tools::Console::setOKColor();
+      std::cout << "[OK]";
+      openfluid::tools::Console::resetAttributes();
+      std::cout << std::endl;
+
+      printlnPartition(Partition);
+
+      std::cout << std::endl << "**** Running simulation on " << Partition.getPartsCount() << " workers ****"
+                << std::endl;
+      std::cout.flush();
+
+      EffectiveRunTimer.start();
+      const unsigned int FailedCount = runPartitionedSimulation(FXDesc,Partition);
+      EffectiveRunTimer.stop();
+
+      if (FailedCount)
+      {
+        return error(std::to_string(FailedCount) + " worker(s) failed","OpenFLUID ERROR");
+      }
+
+      std::cout << "**** Simulation completed ****" << std::endl << std::endl;
+      std::cout << std::endl;
+
+      FullTimer.stop();
+
+      std::cout << "Simulation run time: " << EffectiveRunTimer.elapsedAsPrettyString() << std::endl;
+      std::cout << "     Total run time: "
+                << FullTimer.elapsedAsPrettyString() << std::endl;
+      std::cout << std::endl;
+
+      return 0;
+    }
+
+
     std::cout << "* Building spatial domain... ";
     std::cout.flush();
     openfluid::machine::Factory::buildSimulationBlobFromDescriptors(FXDesc,SimBlob);
@@ -352,6 +605,11 @@ int RunTasks::process() const
     Engine->prepareData();
     Engine->checkConsistency();
 
+    if (CheckStorage)
+    {
+      openfluid::machine::StorageAccuracy::selectVariables(SimBlob.spatialGraph(),Monitoring.resultsStore());
+    }
+
     openfluid::core::UnitsListByClassMap_t::const_iterator UnitsIt;
 
     std::cout << std::endl;
@@ -435,6 +693,22 @@ int RunTasks::process() const
     Engine->finalize();
 
     Engine.reset();
+
+    if (CheckStorage)
+    {
+      std::cout << "* Replaying simulation at full precision... ";
+      std::cout.flush();
+      const openfluid::machine::ResultsStore FullPrecisionStore =
+        runFullPrecisionReplay(FXDesc,Monitoring.resultsStore().getVariables());
+      openfluid::tools::Console::setOKColor();
+      std::cout << "[OK]";
+      openfluid::tools::Console::resetAttributes();
+      std::cout << std::endl << std::endl;
+
+      printlnStorageAccuracy(
+        openfluid::machine::StorageAccuracy::compare(Monitoring.resultsStore(),FullPrecisionStore,
+                                                     SimBlob.runConfiguration().getVariablesStorage()));
+    }
   }
   catch (openfluid::base::Exception& E)
   {
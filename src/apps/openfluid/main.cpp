@@ -140,9 +140,18 @@ int main(int argc, char **argv)
                      {"quiet","q","quiet display during simulation"},
                      {"verbose","v","enable verbose mode"},
                      {"profiling","k","enable simulation profiling"},
+                     {"profiling-extended","","enable extended simulation profiling "
+                                               "(memory and hardware counters, implies profiling)"},
                      {"auto-output-dir","a","create automatic output directory"},
                      {"max-threads","t","set maximum number of threads for threaded spatial loops"
-                                        " (default is "+DefaultMaxThreadsStr+")",true}});
+                                        " (default is "+DefaultMaxThreadsStr+")",true},
+                     {"checkpoint-period","","write a checkpoint of the simulation in the output directory "
+                                             "each time the given simulated duration (in seconds) is elapsed",true},
+                     {"restart-from","","restart the simulation from the given checkpoint file",true},
+                     {"check-storage","","replay the simulation at full precision and report the differences "
+                                         "due to the reduced storage precisions of variables"},
+                     {"workers","","run the simulation on the spatial domain partitioned for the given number "
+                                   "of local worker processes (default is 1)",true}});
 
   for (auto& Opt : SearchOptions)
   {
@@ -41,13 +41,17 @@
 #define __KMLOBSERVERBASE_HPP__
 
 
+#include <algorithm>
+#include <fstream>
+
 #include <ogrsf_frmts.h>
+#include <cpl_conv.h>
 
 #include <openfluid/tools/Filesystem.hpp>
 #include <openfluid/tools/FilesystemPath.hpp>
 #include <openfluid/tools/StringHelpers.hpp>
 #include <openfluid/utils/ExternalProgram.hpp>
-#include <openfluid/utils/CMakeProxy.hpp>
+#include <openfluid/utils/Process.hpp>
 #include <openfluid/ware/PluggableObserver.hpp>
 #include <openfluid/utils/GDALCompatibility.hpp>
 
@@ -56,6 +60,198 @@
 // =====================================================================
 
 
+/**
+  Writer for KMZ files, streaming entries directly into the zip archive using the GDAL/CPL zip API.
+  Entries are written one after the other, only one entry can be opened at a time.
+*/
+class KmzFileWriter
+{
+  private:
+
+    void* m_ZipHandle;
+
+    bool m_IsEntryOpen;
+
+
+  public:
+
+    KmzFileWriter() : m_ZipHandle(nullptr), m_IsEntryOpen(false)
+    { }
+
+    KmzFileWriter(const KmzFileWriter&) = delete;
+
+    KmzFileWriter& operator=(const KmzFileWriter&) = delete;
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    ~KmzFileWriter()
+    {
+      close();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool open(const std::string& FilePath)
+    {
+      close();
+
+      m_ZipHandle = CPLCreateZip(FilePath.c_str(),nullptr);
+
+      return (m_ZipHandle != nullptr);
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool isOpen() const
+    {
+      return (m_ZipHandle != nullptr);
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool beginEntry(const std::string& EntryPath)
+    {
+      if (!m_ZipHandle)
+      {
+        return false;
+      }
+
+      endEntry();
+
+      m_IsEntryOpen = (CPLCreateFileInZip(m_ZipHandle,EntryPath.c_str(),nullptr) == CE_None);
+
+      return m_IsEntryOpen;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool write(const char* Data, std::size_t Size)
+    {
+      if (!m_IsEntryOpen)
+      {
+        return false;
+      }
+
+      // written by chunks since the CPL zip API uses int sizes
+      const std::size_t MaxChunkSize = 1 << 30;
+
+      while (Size > 0)
+      {
+        const std::size_t ChunkSize = std::min(Size,MaxChunkSize);
+
+        if (CPLWriteFileInZip(m_ZipHandle,Data,static_cast<int>(ChunkSize)) != CE_None)
+        {
+          return false;
+        }
+
+        Data += ChunkSize;
+        Size -= ChunkSize;
+      }
+
+      return true;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool write(const std::string& Data)
+    {
+      return write(Data.data(),Data.size());
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void endEntry()
+    {
+      if (m_IsEntryOpen)
+      {
+        CPLCloseFileInZip(m_ZipHandle);
+        m_IsEntryOpen = false;
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool addEntry(const std::string& EntryPath, const std::string& Content)
+    {
+      const bool IsOK = beginEntry(EntryPath) && write(Content);
+      endEntry();
+
+      return IsOK;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool addEntryFromFile(const std::string& EntryPath, const std::string& FilePath)
+    {
+      std::ifstream InFile(FilePath,std::ios::in | std::ios::binary);
+
+      if (!InFile.is_open() || !beginEntry(EntryPath))
+      {
+        return false;
+      }
+
+      bool IsOK = true;
+      char Buffer[65536];
+
+      while (IsOK && InFile)
+      {
+        InFile.read(Buffer,sizeof(Buffer));
+        IsOK = write(Buffer,static_cast<std::size_t>(InFile.gcount()));
+      }
+
+      endEntry();
+
+      return IsOK;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void close()
+    {
+      if (m_ZipHandle)
+      {
+        endEntry();
+        CPLCloseZip(m_ZipHandle);
+        m_ZipHandle = nullptr;
+      }
+    }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
 class KmlUnitInfo
 {
   public:
@@ -108,7 +304,6 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
   protected:
 
     std::string m_TmpSubDirRoot;
-    std::string m_KmzSubDir;
     const std::string m_KmzDataSubDir;
 
     std::string m_Title;
@@ -121,6 +316,8 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
 
     bool m_OKToGo;
 
+    KmzFileWriter m_KmzFile;
+
     template<class T>
     bool transformVectorLayerToKmlGeometry(KmlLayerInfo<T>& LayerInfo)
     {
@@ -268,23 +465,28 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
     // =====================================================================
 
 
-    void buildKmzFile()
+    void openKmzFile()
     {
-      std::string InputDir = m_TmpDir + "/" + m_KmzSubDir + "/";
       std::string KmzFilePath = m_OutputDir + "/" + m_OutputFileName;
 
-      openfluid::tools::FilesystemPath(KmzFilePath).removeDirectory();
+      openfluid::tools::FilesystemPath(m_OutputDir).makeDirectory();
+      openfluid::tools::FilesystemPath(KmzFilePath).removeFile();
 
-      std::vector<std::string> FoundFiles = openfluid::tools::Filesystem::findDirectories(InputDir,true);
-      FoundFiles << openfluid::tools::Filesystem::findFiles(InputDir,true);
+      if (!m_KmzFile.open(KmzFilePath))
+      {
+        OPENFLUID_LogWarning("Cannot create kmz file "+KmzFilePath);
+        m_OKToGo = false;
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
 
-      openfluid::utils::Process::Command Cmd = openfluid::utils::CMakeProxy::getTarCompressCommand(InputDir,
-                                                                                                   KmzFilePath,
-                                                                                                   FoundFiles);
 
-      Cmd.Args << "--format=zip";
-      
-      openfluid::utils::Process::execute(Cmd);
+    void closeKmzFile()
+    {
+      m_KmzFile.close();
     }
 
 
@@ -333,33 +535,13 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
         m_OKToGo = false;
         return;
       }
-
-      TmpDirFSP.removeDirectory(m_KmzSubDir);
-      TmpDirFSP.makeDirectory(m_KmzSubDir);
-
-      if (!TmpDirFSP.isDirectory(m_KmzSubDir))
-      {
-        OPENFLUID_LogWarning("Cannot initialize kmz temporary directory");
-        m_OKToGo = false;
-        return;
-      }
-
-
-      TmpDirFSP.makeDirectory(m_KmzSubDir+"/"+m_KmzDataSubDir);
-
-      if (!TmpDirFSP.isDirectory(m_KmzSubDir+"/"+m_KmzDataSubDir))
-      {
-        OPENFLUID_LogWarning("Cannot initialize kmz data temporary directory");
-        m_OKToGo = false;
-        return;
-      }
     }
 
 
   public:
 
     KmlObserverBase() : openfluid::ware::PluggableObserver(),
-      m_KmzSubDir("kmz"),m_KmzDataSubDir("data"),
+      m_KmzDataSubDir("data"),
       m_Title("OpenFLUID simulation with time animation"),
       m_OutputFileName(""),
       m_InputDir(""), m_OutputDir(""), m_TmpDir(""),
@@ -55,6 +55,16 @@ class GeoVectorSerie
 
     typedef std::map<openfluid::core::VariableName_t,std::string> VariablesSet_t;
 
+    /**
+      Geometry of a source feature, cached with the ID of the corresponding spatial unit
+    */
+    struct CachedFeature
+    {
+      openfluid::core::UnitID_t UnitID;
+
+      OGRGeometry* Geometry;
+    };
+
 
     std::string SerieName;
 
@@ -78,6 +88,26 @@ class GeoVectorSerie
 
     int OFLDIDFieldIndex;
 
+    std::vector<CachedFeature> Features;
+
+    OGRwkbGeometryType GeomType;
+
+    bool UseSingleContainer;
+
+    std::string ContainerFilename;
+
+    GDALDataset_COMPAT* Container;
+
+    OGRLayer* ValuesLayer;
+
+    int ValuesIDFieldIndex;
+
+    int ValuesIndexFieldIndex;
+
+    int ValuesDateFieldIndex;
+
+    std::vector<int> ValuesVarsFieldsIndexes;
+
 
     GeoVectorSerie(const std::string& SName,
                    const std::string& SrcFilePath,
@@ -93,7 +123,11 @@ class GeoVectorSerie
       WhenMode(Mode), WhenContinuousDelay(ContModeDelay), LatestContinuousIndex(0),
       GeoSource(nullptr), GeoLayer(nullptr),
       OutfilePattern(SName+"_%s."+OutfileExt),
-      OFLDIDFieldIndex(-1)
+      OFLDIDFieldIndex(-1),
+      GeomType(wkbUnknown), UseSingleContainer(false),
+      ContainerFilename(SName+"."+OutfileExt),
+      Container(nullptr), ValuesLayer(nullptr),
+      ValuesIDFieldIndex(-1), ValuesIndexFieldIndex(-1), ValuesDateFieldIndex(-1)
     {
 
     }
@@ -106,6 +140,7 @@ class GeoVectorSerie
     ~GeoVectorSerie()
     {
       GDALClose_COMPAT(GeoSource);
+      GDALClose_COMPAT(Container);
     }
 
 };
@@ -121,6 +156,8 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
 
     std::string m_GDALFormat;
 
+    bool m_IsSingleLayout;
+
     std::string m_InputPath;
 
     std::string m_OutputPath;
@@ -344,125 +381,341 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
 
       if (OKToWrite)
       {
-        std::string FullFilePath =
-            m_OutputPath + "/" + openfluid::tools::format(Serie.OutfilePattern,IndexStr.c_str());
+        if (Serie.UseSingleContainer)
+        {
+          appendSerieValues(Serie);
+        }
+        else
+        {
+          writeSerieFile(Serie,IndexStr);
+        }
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void cacheSerieFeatures(GeoVectorSerie& Serie)
+    {
+      // geometries and units IDs are read once, the source is not used anymore after that
+
+      Serie.GeomType = Serie.GeoLayer->GetLayerDefn()->GetGeomType();
+
+      const GIntBig FeaturesCount = Serie.GeoLayer->GetFeatureCount();
+      if (FeaturesCount > 0)
+      {
+        Serie.Features.reserve(FeaturesCount);
+      }
 
+      OGRFeature* SourceFeature;
+
+      Serie.GeoLayer->ResetReading();
+      while ((SourceFeature = Serie.GeoLayer->GetNextFeature()) != nullptr)
+      {
+        Serie.Features.push_back({static_cast<openfluid::core::UnitID_t>(
+                                    SourceFeature->GetFieldAsInteger(Serie.OFLDIDFieldIndex)),
+                                  SourceFeature->StealGeometry()});
+        OGRFeature::DestroyFeature(SourceFeature);
+      }
+
+      GDALClose_COMPAT(Serie.GeoSource);
+      Serie.GeoSource = nullptr;
+      Serie.GeoLayer = nullptr;
+    }
 
-        GDALDriver_COMPAT* Driver = GDALGetDriverByName_COMPAT(m_GDALFormat.c_str());
 
-        if (openfluid::tools::FilesystemPath(FullFilePath).isFile())
+    // =====================================================================
+    // =====================================================================
+
+
+    static void createVariablesFields(const GeoVectorSerie& Serie, OGRLayer* Layer, std::vector<int>& FieldsIndexes)
+    {
+      FieldsIndexes.clear();
+
+      for (const auto& Var : Serie.VariablesSet)
+      {
+        std::string FieldName = Var.second;
+
+        if (FieldName.empty())
         {
-          // deletion of an existing file or files set
-          GDALDelete_COMPAT(Driver,FullFilePath.c_str());
+          FieldName = Var.first;
         }
 
-        GDALDataset_COMPAT* CreatedFile = GDALCreate_COMPAT(Driver,FullFilePath.c_str());
+        OGRFieldDefn VarField(FieldName.c_str(),OFTReal);
+        VarField.SetWidth(24);
+        VarField.SetPrecision(15);
 
-        std::string CreatedLayerName = openfluid::tools::Path(FullFilePath).basename();
+        Layer->CreateField(&VarField);
+        FieldsIndexes.push_back(Layer->GetLayerDefn()->GetFieldIndex(FieldName.c_str()));
+      }
+    }
 
-        OGRLayer* CreatedLayer = CreatedFile->CreateLayer(CreatedLayerName.c_str(),nullptr,
-                                                          Serie.GeoLayer->GetLayerDefn()->GetGeomType(),
-                                                          nullptr);
 
-        OGRFieldDefn IDField("OFLD_ID",OFTInteger);
-        CreatedLayer->CreateField(&IDField);
+    // =====================================================================
+    // =====================================================================
 
 
-        GeoVectorSerie::VariablesSet_t::const_iterator itV;
-        GeoVectorSerie::VariablesSet_t::const_iterator itVb = Serie.VariablesSet.begin();
-        GeoVectorSerie::VariablesSet_t::const_iterator itVe = Serie.VariablesSet.end();
+    bool getVariableAsDouble(const openfluid::core::SpatialUnit* UU, const openfluid::core::VariableName_t& VarName,
+                             openfluid::core::DoubleValue& Value)
+    {
+      // latest value is accessed in place, without copy
 
-        for (itV = itVb; itV != itVe; ++itV)
+      const int ValuesCount = UU->variables()->getVariableValuesCount(VarName);
+
+      if (ValuesCount < 0)
+      {
+        auto Msg = openfluid::tools::format("Variable %s does not exist on unit %s#%d",
+                                            VarName.c_str(),UU->getClass().c_str(),UU->getID());
+        OPENFLUID_LogWarning(Msg);
+        return false;
+      }
+
+      if (ValuesCount == 0)
+      {
+        auto Msg = openfluid::tools::format("Variable %s has no value on unit %s#%d",
+                                            VarName.c_str(),UU->getClass().c_str(),UU->getID());
+        OPENFLUID_LogWarning(Msg);
+        return false;
+      }
+
+      const openfluid::core::Value* LatestValue = UU->variables()->currentValue(VarName);
+
+      if (LatestValue->isDoubleValue()) // OpenFLUID value is double
+      {
+        Value = LatestValue->asDoubleValue();
+        return true;
+      }
+      else if (LatestValue->convert(Value)) // OpenFLUID value can be converted to double
+      {
+        return true;
+      }
+
+      auto Msg = openfluid::tools::format("Variable %s on unit %s#%d is not a double or a compatible type",
+                                          VarName.c_str(),UU->getClass().c_str(),UU->getID());
+      OPENFLUID_LogWarning(Msg);
+      return false;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void setVariablesFields(const GeoVectorSerie& Serie, const openfluid::core::SpatialUnit* UU,
+                            const std::vector<int>& FieldsIndexes, OGRFeature* Feature)
+    {
+      auto itIndex = FieldsIndexes.begin();
+
+      for (const auto& Var : Serie.VariablesSet)
+      {
+        openfluid::core::DoubleValue CreatedValue = 0.0;
+
+        // OpenFLUID value is written to GIS file only if it is double or converted to double
+        if (getVariableAsDouble(UU,Var.first,CreatedValue))
         {
-          std::string FieldName = (*itV).second;
+          Feature->SetField(*itIndex,CreatedValue.get());
+        }
+
+        ++itIndex;
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool createSerieContainer(GeoVectorSerie& Serie)
+    {
+      std::string FullFilePath = m_OutputPath + "/" + Serie.ContainerFilename;
+
+      GDALDriver_COMPAT* Driver = GDALGetDriverByName_COMPAT(m_GDALFormat.c_str());
 
-          OGRFieldDefn VarField(FieldName.c_str(),OFTReal);
-          VarField.SetWidth(24);
-          VarField.SetPrecision(15);
+      if (openfluid::tools::FilesystemPath(FullFilePath).isFile())
+      {
+        // deletion of an existing file or files set
+        GDALDelete_COMPAT(Driver,FullFilePath.c_str());
+      }
+
+      Serie.Container = GDALCreate_COMPAT(Driver,FullFilePath.c_str());
 
-          CreatedLayer->CreateField(&VarField);
+      if (!Serie.Container)
+      {
+        return false;
+      }
+
+
+      // geometries layer, written once
+
+      OGRLayer* GeomLayer = Serie.Container->CreateLayer(Serie.SerieName.c_str(),nullptr,Serie.GeomType,nullptr);
+
+      if (GeomLayer)
+      {
+        OGRFieldDefn IDField("OFLD_ID",OFTInteger);
+        GeomLayer->CreateField(&IDField);
+        const int IDFieldIndex = GeomLayer->GetLayerDefn()->GetFieldIndex("OFLD_ID");
+
+        const bool InTransaction = (Serie.Container->StartTransaction() == OGRERR_NONE);
+
+        for (const auto& Feature : Serie.Features)
+        {
+          OGRFeature* CreatedFeature = OGRFeature::CreateFeature(GeomLayer->GetLayerDefn());
+
+          CreatedFeature->SetGeometry(Feature.Geometry);
+          CreatedFeature->SetField(IDFieldIndex,static_cast<int>(Feature.UnitID));
+          GeomLayer->CreateFeature(CreatedFeature);
+
+          OGRFeature::DestroyFeature(CreatedFeature);
         }
 
+        if (InTransaction)
+        {
+          Serie.Container->CommitTransaction();
+        }
+      }
+
+
+      // values layer, appended at each output
+
+      Serie.ValuesLayer = Serie.Container->CreateLayer((Serie.SerieName+"_values").c_str(),nullptr,wkbNone,nullptr);
+
+      if (!GeomLayer || !Serie.ValuesLayer)
+      {
+        // the format does not support multiple layers
+        GDALClose_COMPAT(Serie.Container);
+        Serie.Container = nullptr;
+        Serie.ValuesLayer = nullptr;
+        GDALDelete_COMPAT(Driver,FullFilePath.c_str());
+        return false;
+      }
+
+      OGRFieldDefn IDField("OFLD_ID",OFTInteger);
+      Serie.ValuesLayer->CreateField(&IDField);
+      OGRFieldDefn IndexField("OFLD_TIDX",GDALOFTInteger64_COMPAT);
+      Serie.ValuesLayer->CreateField(&IndexField);
+      OGRFieldDefn DateField("OFLD_DATE",OFTDateTime);
+      Serie.ValuesLayer->CreateField(&DateField);
 
-        OGRFeature* SourceFeature;
-        openfluid::core::SpatialUnit* UU;
+      Serie.ValuesIDFieldIndex = Serie.ValuesLayer->GetLayerDefn()->GetFieldIndex("OFLD_ID");
+      Serie.ValuesIndexFieldIndex = Serie.ValuesLayer->GetLayerDefn()->GetFieldIndex("OFLD_TIDX");
+      Serie.ValuesDateFieldIndex = Serie.ValuesLayer->GetLayerDefn()->GetFieldIndex("OFLD_DATE");
+
+      createVariablesFields(Serie,Serie.ValuesLayer,Serie.ValuesVarsFieldsIndexes);
+
+      return true;
+    }
 
-        Serie.GeoLayer->ResetReading();
-        while ((SourceFeature = Serie.GeoLayer->GetNextFeature()) != nullptr)
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void writeSerieFile(GeoVectorSerie& Serie, const std::string& IndexStr)
+    {
+      std::string FullFilePath =
+          m_OutputPath + "/" + openfluid::tools::format(Serie.OutfilePattern,IndexStr.c_str());
+
+
+      GDALDriver_COMPAT* Driver = GDALGetDriverByName_COMPAT(m_GDALFormat.c_str());
+
+      if (openfluid::tools::FilesystemPath(FullFilePath).isFile())
+      {
+        // deletion of an existing file or files set
+        GDALDelete_COMPAT(Driver,FullFilePath.c_str());
+      }
+
+      GDALDataset_COMPAT* CreatedFile = GDALCreate_COMPAT(Driver,FullFilePath.c_str());
+
+      std::string CreatedLayerName = openfluid::tools::Path(FullFilePath).basename();
+
+      OGRLayer* CreatedLayer = CreatedFile->CreateLayer(CreatedLayerName.c_str(),nullptr,Serie.GeomType,nullptr);
+
+      OGRFieldDefn IDField("OFLD_ID",OFTInteger);
+      CreatedLayer->CreateField(&IDField);
+      const int IDFieldIndex = CreatedLayer->GetLayerDefn()->GetFieldIndex("OFLD_ID");
+
+      std::vector<int> VarsFieldsIndexes;
+      createVariablesFields(Serie,CreatedLayer,VarsFieldsIndexes);
+
+
+      const bool InTransaction = (CreatedFile->StartTransaction() == OGRERR_NONE);
+
+      for (const auto& Feature : Serie.Features)
+      {
+        openfluid::core::SpatialUnit* UU = OPENFLUID_GetUnit(Serie.UnitsClass,Feature.UnitID);
+
+        if (UU)
         {
-          int SourceID = SourceFeature->GetFieldAsInteger(Serie.OFLDIDFieldIndex);
+          OGRFeature* CreatedFeature = OGRFeature::CreateFeature(CreatedLayer->GetLayerDefn());
 
-          UU = OPENFLUID_GetUnit(Serie.UnitsClass,SourceID);
+          CreatedFeature->SetGeometry(Feature.Geometry);
+          CreatedFeature->SetField(IDFieldIndex,static_cast<int>(Feature.UnitID));
 
-          if (UU)
+          setVariablesFields(Serie,UU,VarsFieldsIndexes,CreatedFeature);
+
+          if (CreatedLayer->CreateFeature(CreatedFeature) != OGRERR_NONE)
           {
-            CreatedLayer->GetLayerDefn();
+            auto Msg = openfluid::tools::format("Feature for unit %s#%d cannot be created",
+                                                UU->getClass().c_str(),UU->getID());
+            OPENFLUID_LogWarning(Msg);
+          }
+
+          OGRFeature::DestroyFeature(CreatedFeature);
+        }
+      }
 
-            OGRFeature* CreatedFeature = OGRFeature::CreateFeature(CreatedLayer->GetLayerDefn());
+      if (InTransaction)
+      {
+        CreatedFile->CommitTransaction();
+      }
 
-            CreatedFeature->SetGeometry(SourceFeature->GetGeometryRef()->clone());
-            CreatedFeature->SetField("OFLD_ID",SourceID);
+      GDALClose_COMPAT(CreatedFile);
+    }
 
 
-            for (itV = itVb; itV != itVe; ++itV)
-            {
-              std::string VarName = (*itV).first;
-              std::string FieldName = (*itV).second;
-              openfluid::core::DoubleValue CreatedValue = 0.0;
-              bool IsValueCreated = false;
-
-              if (FieldName.empty())
-              {
-                FieldName = VarName;
-              }
-
-              openfluid::core::IndexedValue VarValue;
-
-              if (OPENFLUID_IsVariableExist(UU,VarName))
-              {
-                OPENFLUID_GetLatestVariable(UU,VarName,VarValue);
-
-                if (VarValue.value()->isDoubleValue()) // OpenFLUID value is double
-                {
-                  CreatedValue = VarValue.value()->asDoubleValue();
-                  IsValueCreated = true;
-                }
-                else if (VarValue.value()->convert(CreatedValue)) // OpenFLUID value can be converted to double
-                {
-                  IsValueCreated = true;
-                }
-                else
-                {
-                  auto Msg = openfluid::tools::format("Variable %s on unit %s#%d is not a double or a compatible type",
-                                                       VarName.c_str(),UU->getClass().c_str(),UU->getID());
-                  OPENFLUID_LogWarning(Msg);
-                }
-              }
-              else
-              {
-                auto Msg = openfluid::tools::format("Variable %s does not exist on unit %s#%d",
-                                                    VarName.c_str(),UU->getClass().c_str(),UU->getID());
-                OPENFLUID_LogWarning(Msg);
-              }
-
-              if (IsValueCreated) // OpenFLUID value is written to GIS file only if it is double or converted to double
-              {
-                CreatedFeature->SetField(FieldName.c_str(),CreatedValue);
-              }
-            }
+    // =====================================================================
+    // =====================================================================
 
-            if (CreatedLayer->CreateFeature(CreatedFeature) != OGRERR_NONE)
-            {
-              auto Msg = openfluid::tools::format("Feature for unit %s#%d cannot be created",
-                                                  UU->getClass().c_str(),UU->getID());
-              OPENFLUID_LogWarning(Msg);
-            }
 
+    void appendSerieValues(GeoVectorSerie& Serie)
+    {
+      const openfluid::core::TimeIndex_t CurrentIndex = OPENFLUID_GetCurrentTimeIndex();
+      const openfluid::core::DateTime CurrentDT = OPENFLUID_GetCurrentDate();
+
+      const bool InTransaction = (Serie.Container->StartTransaction() == OGRERR_NONE);
 
-            OGRFeature::DestroyFeature(CreatedFeature);
+      for (const auto& Feature : Serie.Features)
+      {
+        openfluid::core::SpatialUnit* UU = OPENFLUID_GetUnit(Serie.UnitsClass,Feature.UnitID);
+
+        if (UU)
+        {
+          OGRFeature* CreatedRow = OGRFeature::CreateFeature(Serie.ValuesLayer->GetLayerDefn());
+
+          CreatedRow->SetField(Serie.ValuesIDFieldIndex,static_cast<int>(Feature.UnitID));
+          CreatedRow->SetField(Serie.ValuesIndexFieldIndex,static_cast<GIntBig>(CurrentIndex));
+          CreatedRow->SetField(Serie.ValuesDateFieldIndex,
+                               CurrentDT.getYear(),CurrentDT.getMonth(),CurrentDT.getDay(),
+                               CurrentDT.getHour(),CurrentDT.getMinute(),CurrentDT.getSecond());
+
+          setVariablesFields(Serie,UU,Serie.ValuesVarsFieldsIndexes,CreatedRow);
+
+          if (Serie.ValuesLayer->CreateFeature(CreatedRow) != OGRERR_NONE)
+          {
+            auto Msg = openfluid::tools::format("Values for unit %s#%d cannot be written",
+                                                UU->getClass().c_str(),UU->getID());
+            OPENFLUID_LogWarning(Msg);
           }
+
+          OGRFeature::DestroyFeature(CreatedRow);
         }
-        GDALClose_COMPAT(CreatedFile);
+      }
+
+      if (InTransaction)
+      {
+        Serie.Container->CommitTransaction();
       }
     }
 
@@ -478,6 +731,19 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
         GDALClose_COMPAT(Serie.GeoSource);
         Serie.GeoSource = nullptr;
       }
+
+      if (Serie.Container)
+      {
+        GDALClose_COMPAT(Serie.Container);
+        Serie.Container = nullptr;
+        Serie.ValuesLayer = nullptr;
+      }
+
+      for (auto& Feature : Serie.Features)
+      {
+        OGRGeometryFactory::destroyGeometry(Feature.Geometry);
+      }
+      Serie.Features.clear();
     }
 
 
@@ -487,7 +753,7 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
 
   public:
 
-    GeoVectorFilesObserver() : PluggableObserver()
+    GeoVectorFilesObserver() : PluggableObserver(), m_IsSingleLayout(false)
     {
       GDALAllRegister_COMPAT();
     }
@@ -554,6 +820,20 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
       std::string OutfileExt = ValidVectorDrivers[m_GDALFormat].FilesExts.front();
 
 
+      // process of layout parameter
+      std::string LayoutStr = ParamsTree.root().getChildValue("layout","files");
+
+      if (LayoutStr == "single")
+      {
+        m_IsSingleLayout = true;
+      }
+      else if (LayoutStr != "files")
+      {
+        OPENFLUID_LogWarning("Unsupported layout for output files");
+        return;
+      }
+
+
       // process of parameter for optional output subdirectory
       std::string OutSeriesSubdir = ParamsTree.root().getChildValue("outsubdir","");
 
@@ -688,6 +968,24 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
         updateFieldNamesUsingFormat((*it).VariablesSet);
       }
 
+
+      // caching of geometries and creation of single containers (if any)
+      for (it=m_Series.begin();it!=m_Series.end(); ++it)
+      {
+        cacheSerieFeatures(*it);
+
+        if (m_IsSingleLayout)
+        {
+          (*it).UseSingleContainer = createSerieContainer(*it);
+
+          if (!(*it).UseSingleContainer)
+          {
+            OPENFLUID_LogWarning("Cannot create single output file for serie "+(*it).SerieName+
+                                 ", using one file per output instead");
+          }
+        }
+      }
+
     }
 
 
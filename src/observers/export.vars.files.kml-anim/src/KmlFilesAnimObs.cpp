@@ -108,7 +108,11 @@ class KmlFilesAnimObserver : public KmlObserverBase
 {
   private:
 
-    std::ofstream m_KmlFile;
+    // doc.kml content is written into a temporary file during the simulation,
+    // then streamed into the kmz file at the end, so that its size does not depend on memory
+    std::ofstream m_DocKml;
+
+    std::string m_DocKmlPath;
 
     KmlAnimLayerInfo m_AnimLayerInfo;
 
@@ -131,8 +135,8 @@ class KmlFilesAnimObserver : public KmlObserverBase
       openfluid::core::TimeIndex_t CurrentTI = OPENFLUID_GetCurrentTimeIndex();
       std::string CurrentTIStr = std::to_string(CurrentTI);
 
-      std::ofstream CurrentKmlFile(std::string(m_TmpDir+"/"+m_KmzSubDir+"/"+
-                                               m_KmzDataSubDir+"/t_"+ CurrentTIStr+".kml").c_str());
+      // the frame is built in memory then streamed into the kmz file
+      std::ostringstream CurrentKmlFile;
 
       CurrentKmlFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
       CurrentKmlFile << "<kml xmlns=\"http://www.opengis.net/kml/2.2\" "
@@ -186,8 +190,7 @@ class KmlFilesAnimObserver : public KmlObserverBase
           }
           else
           {
-            openfluid::core::IndexedValue IVal;
-            OPENFLUID_GetLatestVariable(UU,m_AnimLayerInfo.VarName,IVal);
+            const openfluid::core::IndexedValue& IVal = OPENFLUID_GetLatestVariableView(UU,m_AnimLayerInfo.VarName);
             if (IVal.value()->isDoubleValue())
             {
               Val = IVal.value()->asDoubleValue().get();
@@ -260,17 +263,20 @@ class KmlFilesAnimObserver : public KmlObserverBase
       CurrentKmlFile << "</Document>\n";
       CurrentKmlFile << "</kml>\n";
 
-      CurrentKmlFile.close();
+      if (!m_KmzFile.addEntry(m_KmzDataSubDir+"/t_"+CurrentTIStr+".kml",CurrentKmlFile.str()))
+      {
+        OPENFLUID_LogWarning("Cannot write kml data for time index "+CurrentTIStr+" into kmz file");
+      }
 
       openfluid::core::DateTime EndDateTime = OPENFLUID_GetCurrentDate();
 
-      m_KmlFile << "<NetworkLink>\n";
-      m_KmlFile << "  <name>" << m_AnimLayerInfo.UnitsClass << " at " << EndDateTime.getAsString("%Y-%m-%d %H:%M:%S")
+      m_DocKml << "<NetworkLink>\n";
+      m_DocKml << "  <name>" << m_AnimLayerInfo.UnitsClass << " at " << EndDateTime.getAsString("%Y-%m-%d %H:%M:%S")
                 << "</name>\n";
-      m_KmlFile << "  <TimeSpan><begin>" << m_UpdateBeginDate.getAsString("%Y-%m-%dT%H:%M:%SZ") << "</begin><end>"
+      m_DocKml << "  <TimeSpan><begin>" << m_UpdateBeginDate.getAsString("%Y-%m-%dT%H:%M:%SZ") << "</begin><end>"
                 << EndDateTime.getAsString("%Y-%m-%dT%H:%M:%SZ") << "</end></TimeSpan>\n";
-      m_KmlFile << "  <Link><href>" << m_KmzDataSubDir << "/t_" << CurrentTIStr << ".kml</href></Link>\n";
-      m_KmlFile << "</NetworkLink>\n";
+      m_DocKml << "  <Link><href>" << m_KmzDataSubDir << "/t_" << CurrentTIStr << ".kml</href></Link>\n";
+      m_DocKml << "</NetworkLink>\n";
 
       m_UpdateBeginDate = OPENFLUID_GetCurrentDate();
 
@@ -490,8 +496,6 @@ class KmlFilesAnimObserver : public KmlObserverBase
       }
 
       m_OKToGo = true;
-
-      m_KmzSubDir = m_OutputFileName + "_kmz-dir";
     }
 
 
@@ -507,72 +511,89 @@ class KmlFilesAnimObserver : public KmlObserverBase
       }
 
 
+      openKmzFile();
+
+      if (!m_OKToGo)
+      {
+        return;
+      }
+
+
+      // initialize doc.kml content, written into the kmz file at the end of the simulation
       prepareTempDirectory();
 
       if (!m_OKToGo)
       {
+        closeKmzFile();
         return;
       }
 
+      m_DocKmlPath = openfluid::tools::Path({m_TmpDir,"doc.kml"}).toGeneric();
+      m_DocKml.open(m_DocKmlPath,std::ios::out | std::ios::trunc);
 
-      // open and initialize doc.kml file
-      m_KmlFile.open(std::string(m_TmpDir+"/"+m_KmzSubDir+"/doc.kml").c_str());
+      if (!m_DocKml.is_open())
+      {
+        OPENFLUID_LogWarning("Cannot create temporary file "+m_DocKmlPath);
+        closeKmzFile();
+        m_OKToGo = false;
+        return;
+      }
 
-      m_KmlFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-      m_KmlFile << "<kml xmlns=\"http://www.opengis.net/kml/2.2\" "
+      m_DocKml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+      m_DocKml << "<kml xmlns=\"http://www.opengis.net/kml/2.2\" "
                    "xmlns:gx=\"http://www.google.com/kml/ext/2.2\" "
                    "xmlns:kml=\"http://www.opengis.net/kml/2.2\" xmlns:atom=\"http://www.w3.org/2005/Atom\">\n";
 
-      m_KmlFile << "<Document>\n";
-      m_KmlFile << "  <name>" << m_Title << "</name>\n";
+      m_DocKml << "<Document>\n";
+      m_DocKml << "  <name>" << m_Title << "</name>\n";
 
       for (std::list<KmlStaticLayerInfo>::iterator it=m_StaticLayersInfo.begin();it!=m_StaticLayersInfo.end();++it)
       {
 
         std::string TmpStyleID = "static_" + (*it).UnitsClass +"_style";
 
-        m_KmlFile << "    <Style id=\"" << TmpStyleID << "\"><LineStyle><color>"<< (*it).Color
+        m_DocKml << "    <Style id=\"" << TmpStyleID << "\"><LineStyle><color>"<< (*it).Color
                   << "</color><width>" << (*it).LineWidth
                   << "</width></LineStyle><PolyStyle><fill>0</fill></PolyStyle></Style>\n";
 
-        m_KmlFile << "    <Folder>\n";
-        m_KmlFile << "      <name>" << (*it).UnitsClass << "</name>\n";
+        m_DocKml << "    <Folder>\n";
+        m_DocKml << "      <name>" << (*it).UnitsClass << "</name>\n";
 
         for (std::map<openfluid::core::UnitID_t,KmlUnitInfo>::iterator it2=(*it).UnitsInfos.begin();
             it2!=(*it).UnitsInfos.end();
             ++it2)
         {
-          m_KmlFile << "    <Placemark>\n";
+          m_DocKml << "    <Placemark>\n";
 
 
-          m_KmlFile << "      <name>" << (*it).UnitsClass << " " << (*it2).second.UnitID << "</name>\n";
+          m_DocKml << "      <name>" << (*it).UnitsClass << " " << (*it2).second.UnitID << "</name>\n";
 
-          m_KmlFile << "      <description>\n<![CDATA[\n";
-          m_KmlFile << "Unit class: " << (*it).UnitsClass << "<br/>\n";
-          m_KmlFile << "Unit ID: " << (*it2).second.UnitID << "<br/>\n";
-          m_KmlFile << "\n]]>\n      </description>\n";
+          m_DocKml << "      <description>\n<![CDATA[\n";
+          m_DocKml << "Unit class: " << (*it).UnitsClass << "<br/>\n";
+          m_DocKml << "Unit ID: " << (*it2).second.UnitID << "<br/>\n";
+          m_DocKml << "\n]]>\n      </description>\n";
 
 
-          m_KmlFile << "      <styleUrl>#" << TmpStyleID << "</styleUrl>\n";
+          m_DocKml << "      <styleUrl>#" << TmpStyleID << "</styleUrl>\n";
 
 
           if ((*it2).second.GeometryType == wkbPolygon)
           {
-            m_KmlFile << "<Polygon><tessellate>1</tessellate><outerBoundaryIs><LinearRing><coordinates>"
+            m_DocKml << "<Polygon><tessellate>1</tessellate><outerBoundaryIs><LinearRing><coordinates>"
                       << (*it2).second.CoordsStr << "</coordinates></LinearRing></outerBoundaryIs></Polygon>\n";
           }
 
           if ((*it2).second.GeometryType == wkbLineString)
           {
-            m_KmlFile << "<LineString><tessellate>1</tessellate><coordinates>" << (*it2).second.CoordsStr
+            m_DocKml << "<LineString><tessellate>1</tessellate><coordinates>" << (*it2).second.CoordsStr
                       << "</coordinates></LineString>\n";
           }
 
 
-          m_KmlFile << "    </Placemark>\n";
+          m_DocKml << "    </Placemark>\n";
         }
 
-        m_KmlFile << "    </Folder>\n";
+        m_DocKml << "    </Folder>\n";
       }
 
 
@@ -625,12 +646,18 @@ class KmlFilesAnimObserver : public KmlObserverBase
         return;
       }
 
-      m_KmlFile << "</Document>\n";
-      m_KmlFile << "</kml>\n";
+      m_DocKml << "</Document>\n";
+      m_DocKml << "</kml>\n";
+      m_DocKml.close();
+
+      if (m_DocKml.fail() || !m_KmzFile.addEntryFromFile("doc.kml",m_DocKmlPath))
+      {
+        OPENFLUID_LogWarning("Cannot write doc.kml into kmz file");
+      }
 
-      m_KmlFile.close();
+      closeKmzFile();
 
-      buildKmzFile();
+      openfluid::tools::FilesystemPath(m_TmpDir).removeDirectory();
 
       tryOpenGEarth();
 
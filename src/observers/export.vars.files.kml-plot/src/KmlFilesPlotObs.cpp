@@ -112,7 +112,7 @@ class KmlFilesPlotObserver : public KmlObserverBase
     // =====================================================================
 
 
-    void buildGnuplotImages(const std::string& WorkDir, const std::string& DestDir)
+    void buildGnuplotImages(const std::string& WorkDir)
     {
       for (std::list<KmlSerieInfo>::iterator it=m_KmlSeriesInfos.begin();it!=m_KmlSeriesInfos.end();++it)
       {
@@ -126,7 +126,7 @@ class KmlFilesPlotObserver : public KmlObserverBase
             std::string ScriptFilename = WorkDir+"/tmpscript.gp";
             std::string DataFilename = buildFilePath(WorkDir,(*it).UnitsClass,
                                                      (*it2).second.UnitID,"","dat");
-            std::string OutputFilename = buildFilePath(DestDir,(*it).UnitsClass,
+            std::string OutputFilename = buildFilePath(WorkDir,(*it).UnitsClass,
                                                        (*it2).second.UnitID,"","png");
 
             unsigned int Columns = 1;
@@ -172,6 +172,15 @@ class KmlFilesPlotObserver : public KmlObserverBase
             if (m_PlotProgram.isFound())
             {
               openfluid::utils::Process::execute(m_PlotProgram.getFullProgramPath(),{ScriptFilename});
+
+              // the image is streamed into the kmz file then removed
+              if (!m_KmzFile.addEntryFromFile(buildFilePath(m_KmzDataSubDir,(*it).UnitsClass,
+                                                            (*it2).second.UnitID,"","png"),
+                                              OutputFilename))
+              {
+                OPENFLUID_LogWarning("Cannot write plot image "+OutputFilename+" into kmz file");
+              }
+              openfluid::tools::FilesystemPath(OutputFilename).removeFile();
             }
 
           }
@@ -185,9 +194,9 @@ class KmlFilesPlotObserver : public KmlObserverBase
     // =====================================================================
 
 
-    void writeKmlFile(const std::string& DocFilePath)
+    void writeKmlFile()
     {
-      std::ofstream KmlFile(DocFilePath.c_str());
+      std::ostringstream KmlFile;
 
       KmlFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
       KmlFile << "<kml xmlns=\"http://www.opengis.net/kml/2.2\" "
@@ -291,7 +300,11 @@ class KmlFilesPlotObserver : public KmlObserverBase
 
       KmlFile << "</Document>\n";
       KmlFile << "</kml>\n";
-      KmlFile.close();
+
+      if (!m_KmzFile.addEntry("doc.kml",KmlFile.str()))
+      {
+        OPENFLUID_LogWarning("Cannot write doc.kml into kmz file");
+      }
     }
 
 
@@ -428,7 +441,6 @@ class KmlFilesPlotObserver : public KmlObserverBase
 
       m_OKToGo = true;
 
-      m_KmzSubDir = m_OutputFileName + "_kmz-dir";
       m_GNUPlotSubDir = m_OutputFileName + "_gnuplot-dir";
     }
 
@@ -631,12 +643,18 @@ class KmlFilesPlotObserver : public KmlObserverBase
       }
 
 
-      buildGnuplotImages(m_TmpDir+"/"+m_GNUPlotSubDir,m_TmpDir+"/"+m_KmzSubDir+"/"+m_KmzDataSubDir);
+      openKmzFile();
+
+      if (!m_OKToGo)
+      {
+        return;
+      }
 
+      buildGnuplotImages(m_TmpDir+"/"+m_GNUPlotSubDir);
 
-      writeKmlFile(m_TmpDir+"/"+m_KmzSubDir+"/doc.kml");
+      writeKmlFile();
 
-      buildKmzFile();
+      closeKmzFile();
 
       tryOpenGEarth();
 
@@ -64,8 +64,8 @@ const std::vector<std::string> RunContextManager::m_DeprecatedProjectFiles =
 
 RunContextManager::RunContextManager() :
   Environment(),
-  m_IsClearOutputDir(false), m_IsProfiling(false),
-  m_ValuesBufferSize(0),
+  m_IsClearOutputDir(false), m_IsProfiling(false), m_IsExtendedProfiling(false),
+  m_ValuesBufferSize(0), m_CheckpointPeriod(0), m_WorkersCount(1),
   mp_ProjectFile(nullptr),
   m_ProjectIncOutputDir(false), m_ProjectIsOpen(false)
 {
@@ -41,11 +41,13 @@
 #define __OPENFLUID_BASE_RUNCONTEXTMANAGER_HPP__
 
 
+#include <algorithm>
 #include <string>
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/base/Environment.hpp>
 #include <openfluid/core/MapValue.hpp>
+#include <openfluid/core/TypeDefs.hpp>
 #include <openfluid/ware/TypeDefs.hpp>
 #include <openfluid/utils/SingletonMacros.hpp>
 #include <openfluid/tools/MiscHelpers.hpp>
@@ -71,8 +73,16 @@ class OPENFLUID_API RunContextManager : public Environment
 
     bool m_IsProfiling;
 
+    bool m_IsExtendedProfiling;
+
     unsigned int m_ValuesBufferSize;
 
+    openfluid::core::Duration_t m_CheckpointPeriod;
+
+    std::string m_RestartCheckpointPath;
+
+    unsigned int m_WorkersCount;
+
     unsigned int m_WaresMaxNumThreads;
 
     openfluid::core::MapValue m_WaresSharedEnvironment;
@@ -200,6 +210,25 @@ class OPENFLUID_API RunContextManager : public Environment
       m_IsProfiling = Enabled;
     }
 
+    /**
+      Returns the status of extended simulation profiling,
+      measuring resources counters (memory, hardware counters) in addition to durations
+      @return true if enabled, false if disabled
+    */
+    bool isExtendedProfiling() const
+    {
+      return m_IsExtendedProfiling;
+    }
+
+    /**
+      Sets the status of extended simulation profiling. It is effective only if simulation profiling is enabled.
+      @param Enabled set to true to enable
+    */
+    void setExtendedProfiling(bool Enabled)
+    {
+      m_IsExtendedProfiling = Enabled;
+    }
+
     /**
       Returns the size of the buffer set by the user for simulation variables values
       @return the size of the buffer
@@ -235,6 +264,62 @@ class OPENFLUID_API RunContextManager : public Environment
       return (m_ValuesBufferSize > 0);
     }
 
+    /**
+      Returns the period of simulation checkpoints, in simulated seconds
+      @return the period, 0 if checkpoints are disabled
+    */
+    openfluid::core::Duration_t getCheckpointPeriod() const
+    {
+      return m_CheckpointPeriod;
+    }
+
+    /**
+      Sets the period of simulation checkpoints, in simulated seconds.
+      The state of the running simulation is written to the checkpoint file of the output directory
+      each time this period is elapsed.
+      @param[in] Period the period, 0 to disable checkpoints
+    */
+    void setCheckpointPeriod(openfluid::core::Duration_t Period)
+    {
+      m_CheckpointPeriod = Period;
+    }
+
+    /**
+      Returns the path of the checkpoint file used to restart the simulation
+      @return the path, empty if the simulation does not restart from a checkpoint
+    */
+    const std::string& getRestartCheckpointPath() const
+    {
+      return m_RestartCheckpointPath;
+    }
+
+    /**
+      Sets the path of the checkpoint file used to restart the simulation
+      @param[in] Path the path, empty to run the simulation from its beginning
+    */
+    void setRestartCheckpointPath(const std::string& Path)
+    {
+      m_RestartCheckpointPath = Path;
+    }
+
+    /**
+      Returns the number of worker processes running the simulation on the partitioned spatial domain
+      @return the number of workers, 1 if the spatial domain is not partitioned
+    */
+    unsigned int getWorkersCount() const
+    {
+      return m_WorkersCount;
+    }
+
+    /**
+      Sets the number of worker processes running the simulation on the partitioned spatial domain
+      @param[in] Count the number of workers, 1 to run the whole spatial domain in the current process
+    */
+    void setWorkersCount(unsigned int Count)
+    {
+      m_WorkersCount = std::max(1u,Count);
+    }
+
     /**
       Returns the value for maximum threads count to be used in OpenFLUID wares (simulators, observers, ...)
       @return the maximum threads count
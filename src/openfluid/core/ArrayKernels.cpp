@@ -0,0 +1,233 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file ArrayKernels.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <openfluid/core/ArrayKernelsImpl.hpp>
+
+
+namespace openfluid { namespace core { namespace kernels {
+
+
+namespace {
+
+
+/**
+  Returns the kernels used for double precision data, selected once
+*/
+inline const detail::DoubleKernels& activeDoubleKernels()
+{
+  static const detail::DoubleKernels& Kernels = detail::getSupportedDoubleKernels().front();
+  return Kernels;
+}
+
+
+}  // namespace
+
+
+// =====================================================================
+// =====================================================================
+
+
+const char* getInstructionSet()
+{
+  return activeDoubleKernels().ISA;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+namespace detail {
+
+
+const std::vector<DoubleKernels>& getSupportedDoubleKernels()
+{
+  static const std::vector<DoubleKernels> Supported = []()
+  {
+    std::vector<DoubleKernels> Kernels;
+
+#if defined(OPENFLUID_KERNELS_DISPATCH)
+    // instruction sets already enabled by the compiler options are used by the kernels built in this file
+    __builtin_cpu_init();
+
+#if !defined(__AVX512F__)
+    if (__builtin_cpu_supports("avx512f"))
+    {
+      Kernels.push_back(getAVX512DoubleKernels());
+    }
+#endif
+
+#if !defined(__AVX__)
+    if (__builtin_cpu_supports("avx"))
+    {
+      Kernels.push_back(getAVXDoubleKernels());
+    }
+#endif
+#endif
+
+    Kernels.push_back(makeDoubleKernels());
+
+    return Kernels;
+  }();
+
+  return Supported;
+}
+
+// =====================================================================
+// =====================================================================
+
+
+void addDouble(const double* A, const double* B, double* Res, unsigned long Size)
+{
+  activeDoubleKernels().Add(A,B,Res,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+void subtractDouble(const double* A, const double* B, double* Res, unsigned long Size)
+{
+  activeDoubleKernels().Subtract(A,B,Res,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+void multiplyDouble(const double* A, const double* B, double* Res, unsigned long Size)
+{
+  activeDoubleKernels().Multiply(A,B,Res,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+void divideDouble(const double* A, const double* B, double* Res, unsigned long Size)
+{
+  activeDoubleKernels().Divide(A,B,Res,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+void addScalarDouble(const double* A, double Val, double* Res, unsigned long Size)
+{
+  activeDoubleKernels().AddScalar(A,Val,Res,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+void scaleDouble(const double* A, double Factor, double* Res, unsigned long Size)
+{
+  activeDoubleKernels().Scale(A,Factor,Res,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+void axpyDouble(double Alpha, const double* X, double* Y, unsigned long Size)
+{
+  activeDoubleKernels().Axpy(Alpha,X,Y,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+void clampDouble(const double* A, double Low, double High, double* Res, unsigned long Size)
+{
+  activeDoubleKernels().Clamp(A,Low,High,Res,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+double sumDouble(const double* A, unsigned long Size)
+{
+  return activeDoubleKernels().Sum(A,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+double dotDouble(const double* A, const double* B, unsigned long Size)
+{
+  return activeDoubleKernels().Dot(A,B,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+double minElementDouble(const double* A, unsigned long Size)
+{
+  return activeDoubleKernels().MinElement(A,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+double maxElementDouble(const double* A, unsigned long Size)
+{
+  return activeDoubleKernels().MaxElement(A,Size);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+void gemvDouble(const double* M, unsigned long ColsNbr, unsigned long RowsNbr, const double* X, double* Y)
+{
+  activeDoubleKernels().Gemv(M,ColsNbr,RowsNbr,X,Y);
+}
+
+
+}  // namespace detail
+
+
+} } }  // namespaces
@@ -0,0 +1,531 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file ArrayKernels.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_ARRAYKERNELS_HPP__
+#define __OPENFLUID_CORE_ARRAYKERNELS_HPP__
+
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include <openfluid/dllexport.hpp>
+
+
+// Kernels for arrays of values, used by openfluid::core::Vector and openfluid::core::Matrix.
+//
+// Double precision data are processed by the OpenFLUID core library, using packed operations.
+// On x86 processors with GCC or Clang builds, the kernels are built for SSE2, AVX and AVX-512
+// and the best instruction set supported by the running processor is selected at runtime,
+// so that default builds use AVX or AVX-512 when available. Other builds use the instruction set
+// enabled by the compiler options (see getInstructionSet()).
+// Sums and dot products may differ in their last bits between instruction sets, as values are added
+// in a different order.
+// Other data types use the portable scalar implementations below.
+//
+// NaN values are propagated whatever their position in the arrays:
+// element-wise results are NaN for NaN elements, clamp() keeps NaN elements,
+// and minElement() and maxElement() return NaN if any element is NaN.
+
+
+namespace openfluid { namespace core { namespace kernels {
+
+
+namespace detail {
+
+
+/**
+  Kernels for double precision data built for an instruction set
+*/
+struct DoubleKernels
+{
+  const char* ISA;
+
+  void (*Add)(const double*, const double*, double*, unsigned long);
+
+  void (*Subtract)(const double*, const double*, double*, unsigned long);
+
+  void (*Multiply)(const double*, const double*, double*, unsigned long);
+
+  void (*Divide)(const double*, const double*, double*, unsigned long);
+
+  void (*AddScalar)(const double*, double, double*, unsigned long);
+
+  void (*Scale)(const double*, double, double*, unsigned long);
+
+  void (*Axpy)(double, const double*, double*, unsigned long);
+
+  void (*Clamp)(const double*, double, double, double*, unsigned long);
+
+  double (*Sum)(const double*, unsigned long);
+
+  double (*Dot)(const double*, const double*, unsigned long);
+
+  double (*MinElement)(const double*, unsigned long);
+
+  double (*MaxElement)(const double*, unsigned long);
+
+  void (*Gemv)(const double*, unsigned long, unsigned long, const double*, double*);
+};
+
+
+/**
+  Returns the kernels built for the instruction sets supported by the running processor,
+  from the most to the least efficient. The first ones are used for double precision data.
+*/
+OPENFLUID_API const std::vector<DoubleKernels>& getSupportedDoubleKernels();
+
+
+OPENFLUID_API void addDouble(const double* A, const double* B, double* Res, unsigned long Size);
+
+OPENFLUID_API void subtractDouble(const double* A, const double* B, double* Res, unsigned long Size);
+
+OPENFLUID_API void multiplyDouble(const double* A, const double* B, double* Res, unsigned long Size);
+
+OPENFLUID_API void divideDouble(const double* A, const double* B, double* Res, unsigned long Size);
+
+OPENFLUID_API void addScalarDouble(const double* A, double Val, double* Res, unsigned long Size);
+
+OPENFLUID_API void scaleDouble(const double* A, double Factor, double* Res, unsigned long Size);
+
+OPENFLUID_API void axpyDouble(double Alpha, const double* X, double* Y, unsigned long Size);
+
+OPENFLUID_API void clampDouble(const double* A, double Low, double High, double* Res, unsigned long Size);
+
+OPENFLUID_API double sumDouble(const double* A, unsigned long Size);
+
+OPENFLUID_API double dotDouble(const double* A, const double* B, unsigned long Size);
+
+OPENFLUID_API double minElementDouble(const double* A, unsigned long Size);
+
+OPENFLUID_API double maxElementDouble(const double* A, unsigned long Size);
+
+OPENFLUID_API void gemvDouble(const double* M, unsigned long ColsNbr, unsigned long RowsNbr,
+                              const double* X, double* Y);
+
+
+// =====================================================================
+// =====================================================================
+
+
+template<class T>
+constexpr bool isDouble()
+{
+  return std::is_same<T,double>::value;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns true if the value is NaN, always false for types without NaN
+*/
+template<class T>
+inline bool isNaN(const T& Val)
+{
+  return !(Val == Val);
+}
+
+
+}  // namespace detail
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the name of the instruction set used by the kernels for double precision data,
+  selected at the first use of the kernels
+*/
+OPENFLUID_API const char* getInstructionSet();
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes element-wise addition Res = A + B.
+  Res may be the same array as A or B
+*/
+template<class T>
+inline void add(const T* A, const T* B, T* Res, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    detail::addDouble(A,B,Res,Size);
+  }
+  else
+  {
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Res[i] = A[i]+B[i];
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes element-wise subtraction Res = A - B.
+  Res may be the same array as A or B
+*/
+template<class T>
+inline void subtract(const T* A, const T* B, T* Res, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    detail::subtractDouble(A,B,Res,Size);
+  }
+  else
+  {
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Res[i] = A[i]-B[i];
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes element-wise multiplication Res = A * B.
+  Res may be the same array as A or B
+*/
+template<class T>
+inline void multiply(const T* A, const T* B, T* Res, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    detail::multiplyDouble(A,B,Res,Size);
+  }
+  else
+  {
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Res[i] = A[i]*B[i];
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes element-wise division Res = A / B.
+  Res may be the same array as A or B
+*/
+template<class T>
+inline void divide(const T* A, const T* B, T* Res, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    detail::divideDouble(A,B,Res,Size);
+  }
+  else
+  {
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Res[i] = A[i]/B[i];
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Adds a scalar value to each element, Res = A + Val.
+  Res may be the same array as A
+*/
+template<class T>
+inline void addScalar(const T* A, const T& Val, T* Res, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    detail::addScalarDouble(A,Val,Res,Size);
+  }
+  else
+  {
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Res[i] = A[i]+Val;
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Multiplies each element by a scalar value, Res = A * Factor.
+  Res may be the same array as A
+*/
+template<class T>
+inline void scale(const T* A, const T& Factor, T* Res, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    detail::scaleDouble(A,Factor,Res,Size);
+  }
+  else
+  {
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Res[i] = A[i]*Factor;
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes Y = Alpha * X + Y
+*/
+template<class T>
+inline void axpy(const T& Alpha, const T* X, T* Y, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    detail::axpyDouble(Alpha,X,Y,Size);
+  }
+  else
+  {
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Y[i] += Alpha*X[i];
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Clamps each element between Low and High values, Res = min(max(A,Low),High).
+  NaN elements are kept as NaN.
+  Res may be the same array as A
+*/
+template<class T>
+inline void clamp(const T* A, const T& Low, const T& High, T* Res, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    detail::clampDouble(A,Low,High,Res,Size);
+  }
+  else
+  {
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Res[i] = std::min(std::max(A[i],Low),High);
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the sum of the elements, 0 if the array is empty
+*/
+template<class T>
+inline T sum(const T* A, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    return detail::sumDouble(A,Size);
+  }
+  else
+  {
+    T Res = T();
+
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Res += A[i];
+    }
+
+    return Res;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the dot product of two arrays of the same size, 0 if arrays are empty
+*/
+template<class T>
+inline T dot(const T* A, const T* B, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    return detail::dotDouble(A,B,Size);
+  }
+  else
+  {
+    T Res = T();
+
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Res += A[i]*B[i];
+    }
+
+    return Res;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the minimum element, NaN if any element is NaN. The array must not be empty
+*/
+template<class T>
+inline T minElement(const T* A, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    return detail::minElementDouble(A,Size);
+  }
+  else
+  {
+    T Res = A[0];
+
+    for (unsigned long i = 1; i < Size && !detail::isNaN(Res); i++)
+    {
+      if (A[i] < Res || detail::isNaN(A[i]))
+      {
+        Res = A[i];
+      }
+    }
+
+    return Res;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the maximum element, NaN if any element is NaN. The array must not be empty
+*/
+template<class T>
+inline T maxElement(const T* A, unsigned long Size)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    return detail::maxElementDouble(A,Size);
+  }
+  else
+  {
+    T Res = A[0];
+
+    for (unsigned long i = 1; i < Size && !detail::isNaN(Res); i++)
+    {
+      if (Res < A[i] || detail::isNaN(A[i]))
+      {
+        Res = A[i];
+      }
+    }
+
+    return Res;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes the matrix-vector product Y = M * X, for a matrix stored column after column
+  as in openfluid::core::Matrix. X must contain ColsNbr elements and Y must contain RowsNbr elements.
+  Y must not overlap M or X
+*/
+template<class T>
+inline void gemv(const T* M, unsigned long ColsNbr, unsigned long RowsNbr, const T* X, T* Y)
+{
+  if constexpr (detail::isDouble<T>())
+  {
+    detail::gemvDouble(M,ColsNbr,RowsNbr,X,Y);
+  }
+  else
+  {
+    std::fill(Y,Y+RowsNbr,T());
+
+    for (unsigned long c = 0; c < ColsNbr; c++)
+    {
+      axpy(X[c],M+c*RowsNbr,Y,RowsNbr);
+    }
+  }
+}
+
+
+} } }  // namespaces
+
+
+#endif /* __OPENFLUID_CORE_ARRAYKERNELS_HPP__ */
@@ -0,0 +1,693 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file ArrayKernelsImpl.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_ARRAYKERNELSIMPL_HPP__
+#define __OPENFLUID_CORE_ARRAYKERNELSIMPL_HPP__
+
+
+// Implementation of the kernels for double precision data, private to the OpenFLUID core library.
+//
+// This file is included once by each file building the kernels for an instruction set:
+// ArrayKernels.cpp builds them for the instruction set enabled by the compiler options (SSE2 on x86-64 by default),
+// ArrayKernelsAVX.cpp and ArrayKernelsAVX512.cpp build them for AVX and AVX-512 using target attributes,
+// on x86 processors with GCC or Clang only (OPENFLUID_KERNELS_DISPATCH).
+// The kernels of the best instruction set supported by the running processor are then selected at runtime.
+//
+// Everything is defined in an anonymous namespace, and no function template of the standard library is used,
+// so that code built for an instruction set can never be linked in place of the code built for another one.
+
+
+#include <limits>
+
+#include <openfluid/core/ArrayKernels.hpp>
+
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define OPENFLUID_KERNELS_DISPATCH
+#endif
+
+#if !defined(OPENFLUID_KERNELS_DISPATCH) && (defined(OPENFLUID_KERNELS_BUILD_AVX512) || \
+                                            defined(OPENFLUID_KERNELS_BUILD_AVX))
+#define OPENFLUID_KERNELS_SKIP
+#endif
+
+
+#if !defined(OPENFLUID_KERNELS_SKIP)
+
+
+#if defined(__AVX512F__) || defined(__AVX__) || defined(__SSE2__) || defined(_M_X64) || \
+    defined(OPENFLUID_KERNELS_DISPATCH)
+#include <immintrin.h>
+#endif
+
+
+namespace openfluid { namespace core { namespace kernels { namespace detail {
+
+
+DoubleKernels getAVX512DoubleKernels();
+
+DoubleKernels getAVXDoubleKernels();
+
+
+} } } }  // namespaces
+
+
+#if defined(OPENFLUID_KERNELS_BUILD_AVX512)
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+// AVX-512 reduction intrinsics start from undefined values, reported as uninitialized by some GCC versions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#elif defined(OPENFLUID_KERNELS_BUILD_AVX)
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx")
+#endif
+#endif
+
+
+namespace openfluid { namespace core { namespace kernels {
+
+
+namespace {
+
+
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+
+/**
+  Packed operations on double values for the instruction set of the including file.
+  Operands of min and max operations are ordered so that NaN values of the second operand are propagated.
+  NaN masks track NaN values seen by reductions.
+*/
+struct PackedDouble
+{
+#if defined(OPENFLUID_KERNELS_BUILD_AVX512) || (!defined(OPENFLUID_KERNELS_BUILD_AVX) && defined(__AVX512F__))
+
+  static constexpr const char* ISA = "AVX-512";
+
+  typedef __m512d Pack_t;
+
+  typedef __mmask8 NaNMask_t;
+
+  static constexpr unsigned long Width = 8;
+
+  static inline Pack_t load(const double* Ptr) { return _mm512_loadu_pd(Ptr); }
+
+  static inline void store(double* Ptr, Pack_t P) { _mm512_storeu_pd(Ptr,P); }
+
+  static inline Pack_t set(double V) { return _mm512_set1_pd(V); }
+
+  static inline Pack_t add(Pack_t A, Pack_t B) { return _mm512_add_pd(A,B); }
+
+  static inline Pack_t sub(Pack_t A, Pack_t B) { return _mm512_sub_pd(A,B); }
+
+  static inline Pack_t mul(Pack_t A, Pack_t B) { return _mm512_mul_pd(A,B); }
+
+  static inline Pack_t div(Pack_t A, Pack_t B) { return _mm512_div_pd(A,B); }
+
+  static inline Pack_t min(Pack_t A, Pack_t B) { return _mm512_min_pd(A,B); }
+
+  static inline Pack_t max(Pack_t A, Pack_t B) { return _mm512_max_pd(A,B); }
+
+  static inline double reduceAdd(Pack_t P) { return _mm512_reduce_add_pd(P); }
+
+  static inline double reduceMin(Pack_t P) { return _mm512_reduce_min_pd(P); }
+
+  static inline double reduceMax(Pack_t P) { return _mm512_reduce_max_pd(P); }
+
+  static inline NaNMask_t noNaN() { return 0; }
+
+  static inline NaNMask_t addNaN(NaNMask_t M, Pack_t P) { return M | _mm512_cmp_pd_mask(P,P,_CMP_UNORD_Q); }
+
+  static inline bool hasNaN(NaNMask_t M) { return M != 0; }
+
+#elif defined(OPENFLUID_KERNELS_BUILD_AVX) || defined(__AVX__)
+
+  static constexpr const char* ISA = "AVX";
+
+  typedef __m256d Pack_t;
+
+  typedef __m256d NaNMask_t;
+
+  static constexpr unsigned long Width = 4;
+
+  static inline Pack_t load(const double* Ptr) { return _mm256_loadu_pd(Ptr); }
+
+  static inline void store(double* Ptr, Pack_t P) { _mm256_storeu_pd(Ptr,P); }
+
+  static inline Pack_t set(double V) { return _mm256_set1_pd(V); }
+
+  static inline Pack_t add(Pack_t A, Pack_t B) { return _mm256_add_pd(A,B); }
+
+  static inline Pack_t sub(Pack_t A, Pack_t B) { return _mm256_sub_pd(A,B); }
+
+  static inline Pack_t mul(Pack_t A, Pack_t B) { return _mm256_mul_pd(A,B); }
+
+  static inline Pack_t div(Pack_t A, Pack_t B) { return _mm256_div_pd(A,B); }
+
+  static inline Pack_t min(Pack_t A, Pack_t B) { return _mm256_min_pd(A,B); }
+
+  static inline Pack_t max(Pack_t A, Pack_t B) { return _mm256_max_pd(A,B); }
+
+  static inline double reduceAdd(Pack_t P)
+  {
+    __m128d Half = _mm_add_pd(_mm256_castpd256_pd128(P),_mm256_extractf128_pd(P,1));
+    return _mm_cvtsd_f64(_mm_add_sd(Half,_mm_unpackhi_pd(Half,Half)));
+  }
+
+  static inline double reduceMin(Pack_t P)
+  {
+    __m128d Half = _mm_min_pd(_mm256_castpd256_pd128(P),_mm256_extractf128_pd(P,1));
+    return _mm_cvtsd_f64(_mm_min_sd(Half,_mm_unpackhi_pd(Half,Half)));
+  }
+
+  static inline double reduceMax(Pack_t P)
+  {
+    __m128d Half = _mm_max_pd(_mm256_castpd256_pd128(P),_mm256_extractf128_pd(P,1));
+    return _mm_cvtsd_f64(_mm_max_sd(Half,_mm_unpackhi_pd(Half,Half)));
+  }
+
+  static inline NaNMask_t noNaN() { return _mm256_setzero_pd(); }
+
+  static inline NaNMask_t addNaN(NaNMask_t M, Pack_t P) { return _mm256_or_pd(M,_mm256_cmp_pd(P,P,_CMP_UNORD_Q)); }
+
+  static inline bool hasNaN(NaNMask_t M) { return _mm256_movemask_pd(M) != 0; }
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+  static constexpr const char* ISA = "SSE2";
+
+  typedef __m128d Pack_t;
+
+  typedef __m128d NaNMask_t;
+
+  static constexpr unsigned long Width = 2;
+
+  static inline Pack_t load(const double* Ptr) { return _mm_loadu_pd(Ptr); }
+
+  static inline void store(double* Ptr, Pack_t P) { _mm_storeu_pd(Ptr,P); }
+
+  static inline Pack_t set(double V) { return _mm_set1_pd(V); }
+
+  static inline Pack_t add(Pack_t A, Pack_t B) { return _mm_add_pd(A,B); }
+
+  static inline Pack_t sub(Pack_t A, Pack_t B) { return _mm_sub_pd(A,B); }
+
+  static inline Pack_t mul(Pack_t A, Pack_t B) { return _mm_mul_pd(A,B); }
+
+  static inline Pack_t div(Pack_t A, Pack_t B) { return _mm_div_pd(A,B); }
+
+  static inline Pack_t min(Pack_t A, Pack_t B) { return _mm_min_pd(A,B); }
+
+  static inline Pack_t max(Pack_t A, Pack_t B) { return _mm_max_pd(A,B); }
+
+  static inline double reduceAdd(Pack_t P) { return _mm_cvtsd_f64(_mm_add_sd(P,_mm_unpackhi_pd(P,P))); }
+
+  static inline double reduceMin(Pack_t P) { return _mm_cvtsd_f64(_mm_min_sd(P,_mm_unpackhi_pd(P,P))); }
+
+  static inline double reduceMax(Pack_t P) { return _mm_cvtsd_f64(_mm_max_sd(P,_mm_unpackhi_pd(P,P))); }
+
+  static inline NaNMask_t noNaN() { return _mm_setzero_pd(); }
+
+  static inline NaNMask_t addNaN(NaNMask_t M, Pack_t P) { return _mm_or_pd(M,_mm_cmpunord_pd(P,P)); }
+
+  static inline bool hasNaN(NaNMask_t M) { return _mm_movemask_pd(M) != 0; }
+
+#else
+
+  static constexpr const char* ISA = "scalar";
+
+  typedef double Pack_t;
+
+  typedef bool NaNMask_t;
+
+  static constexpr unsigned long Width = 1;
+
+  static inline Pack_t load(const double* Ptr) { return *Ptr; }
+
+  static inline void store(double* Ptr, Pack_t P) { *Ptr = P; }
+
+  static inline Pack_t set(double V) { return V; }
+
+  static inline Pack_t add(Pack_t A, Pack_t B) { return A+B; }
+
+  static inline Pack_t sub(Pack_t A, Pack_t B) { return A-B; }
+
+  static inline Pack_t mul(Pack_t A, Pack_t B) { return A*B; }
+
+  static inline Pack_t div(Pack_t A, Pack_t B) { return A/B; }
+
+  static inline Pack_t min(Pack_t A, Pack_t B) { return (A < B) ? A : B; }
+
+  static inline Pack_t max(Pack_t A, Pack_t B) { return (B < A) ? A : B; }
+
+  static inline double reduceAdd(Pack_t P) { return P; }
+
+  static inline double reduceMin(Pack_t P) { return P; }
+
+  static inline double reduceMax(Pack_t P) { return P; }
+
+  static inline NaNMask_t noNaN() { return false; }
+
+  static inline NaNMask_t addNaN(NaNMask_t M, Pack_t P) { return M || (P != P); }
+
+  static inline bool hasNaN(NaNMask_t M) { return M; }
+
+#endif
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline double scalarMin(double A, double B)
+{
+  return (B < A) ? B : A;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline double scalarMax(double A, double B)
+{
+  return (A < B) ? B : A;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+constexpr unsigned long W = PackedDouble::Width;
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Applies a binary element-wise operation using packed operations for the main part
+  and scalar operations for the remaining tail
+*/
+template<class PackedOp, class ScalarOp>
+inline void binaryOp(const double* A, const double* B, double* Res, unsigned long Size, PackedOp POp, ScalarOp SOp)
+{
+  unsigned long i = 0;
+
+  for (; i+W <= Size; i += W)
+  {
+    PackedDouble::store(Res+i,POp(PackedDouble::load(A+i),PackedDouble::load(B+i)));
+  }
+
+  for (; i < Size; i++)
+  {
+    Res[i] = SOp(A[i],B[i]);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Applies a binary operation between each element and a scalar value
+*/
+template<class PackedOp, class ScalarOp>
+inline void scalarOp(const double* A, double Val, double* Res, unsigned long Size, PackedOp POp, ScalarOp SOp)
+{
+  unsigned long i = 0;
+  const PackedDouble::Pack_t PVal = PackedDouble::set(Val);
+
+  for (; i+W <= Size; i += W)
+  {
+    PackedDouble::store(Res+i,POp(PackedDouble::load(A+i),PVal));
+  }
+
+  for (; i < Size; i++)
+  {
+    Res[i] = SOp(A[i],Val);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the minimum or maximum element, NaN if any element is NaN
+*/
+template<class PackedOp, class ReduceOp, class LessOp>
+inline double extremeElement(const double* A, unsigned long Size, PackedOp POp, ReduceOp ROp, LessOp Less)
+{
+  double Res = A[0];
+  unsigned long i = 1;
+
+  if (Size >= W)
+  {
+    PackedDouble::Pack_t PRes = PackedDouble::load(A);
+    PackedDouble::NaNMask_t NaNs = PackedDouble::addNaN(PackedDouble::noNaN(),PRes);
+
+    for (i = W; i+W <= Size; i += W)
+    {
+      const PackedDouble::Pack_t P = PackedDouble::load(A+i);
+      PRes = POp(PRes,P);
+      NaNs = PackedDouble::addNaN(NaNs,P);
+    }
+
+    if (PackedDouble::hasNaN(NaNs))
+    {
+      return NaN;
+    }
+
+    Res = ROp(PRes);
+  }
+
+  for (; i < Size && Res == Res; i++)
+  {
+    if (Less(A[i],Res) || A[i] != A[i])
+    {
+      Res = A[i];
+    }
+  }
+
+  return Res;
+}
+
+
+inline void addDouble(const double* A, const double* B, double* Res, unsigned long Size)
+{
+  binaryOp(A,B,Res,Size,
+           [](auto X, auto Y){ return PackedDouble::add(X,Y); },
+           [](double X, double Y){ return X+Y; });
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline void subtractDouble(const double* A, const double* B, double* Res, unsigned long Size)
+{
+  binaryOp(A,B,Res,Size,
+           [](auto X, auto Y){ return PackedDouble::sub(X,Y); },
+           [](double X, double Y){ return X-Y; });
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline void multiplyDouble(const double* A, const double* B, double* Res, unsigned long Size)
+{
+  binaryOp(A,B,Res,Size,
+           [](auto X, auto Y){ return PackedDouble::mul(X,Y); },
+           [](double X, double Y){ return X*Y; });
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline void divideDouble(const double* A, const double* B, double* Res, unsigned long Size)
+{
+  binaryOp(A,B,Res,Size,
+           [](auto X, auto Y){ return PackedDouble::div(X,Y); },
+           [](double X, double Y){ return X/Y; });
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline void addScalarDouble(const double* A, double Val, double* Res, unsigned long Size)
+{
+  scalarOp(A,Val,Res,Size,
+           [](auto X, auto Y){ return PackedDouble::add(X,Y); },
+           [](double X, double Y){ return X+Y; });
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline void scaleDouble(const double* A, double Factor, double* Res, unsigned long Size)
+{
+  scalarOp(A,Factor,Res,Size,
+           [](auto X, auto Y){ return PackedDouble::mul(X,Y); },
+           [](double X, double Y){ return X*Y; });
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline void axpyDouble(double Alpha, const double* X, double* Y, unsigned long Size)
+{
+  unsigned long i = 0;
+  const PackedDouble::Pack_t PAlpha = PackedDouble::set(Alpha);
+
+  for (; i+W <= Size; i += W)
+  {
+    PackedDouble::store(Y+i,PackedDouble::add(PackedDouble::mul(PAlpha,PackedDouble::load(X+i)),
+                                              PackedDouble::load(Y+i)));
+  }
+
+  for (; i < Size; i++)
+  {
+    Y[i] += Alpha*X[i];
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline void clampDouble(const double* A, double Low, double High, double* Res, unsigned long Size)
+{
+  unsigned long i = 0;
+  const PackedDouble::Pack_t PLow = PackedDouble::set(Low);
+  const PackedDouble::Pack_t PHigh = PackedDouble::set(High);
+
+  // elements are given as second operands so that NaN elements are kept, as in the scalar tail
+  for (; i+W <= Size; i += W)
+  {
+    PackedDouble::store(Res+i,PackedDouble::min(PHigh,PackedDouble::max(PLow,PackedDouble::load(A+i))));
+  }
+
+  for (; i < Size; i++)
+  {
+    Res[i] = scalarMin(scalarMax(A[i],Low),High);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline double sumDouble(const double* A, unsigned long Size)
+{
+  double Res = 0.0;
+  unsigned long i = 0;
+
+  if (Size >= W)
+  {
+    PackedDouble::Pack_t PSum = PackedDouble::set(0.0);
+
+    for (; i+W <= Size; i += W)
+    {
+      PSum = PackedDouble::add(PSum,PackedDouble::load(A+i));
+    }
+
+    Res = PackedDouble::reduceAdd(PSum);
+  }
+
+  for (; i < Size; i++)
+  {
+    Res += A[i];
+  }
+
+  return Res;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline double dotDouble(const double* A, const double* B, unsigned long Size)
+{
+  double Res = 0.0;
+  unsigned long i = 0;
+
+  if (Size >= W)
+  {
+    PackedDouble::Pack_t PSum = PackedDouble::set(0.0);
+
+    for (; i+W <= Size; i += W)
+    {
+      PSum = PackedDouble::add(PSum,PackedDouble::mul(PackedDouble::load(A+i),PackedDouble::load(B+i)));
+    }
+
+    Res = PackedDouble::reduceAdd(PSum);
+  }
+
+  for (; i < Size; i++)
+  {
+    Res += A[i]*B[i];
+  }
+
+  return Res;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline double minElementDouble(const double* A, unsigned long Size)
+{
+  return extremeElement(A,Size,
+                        [](auto X, auto Y){ return PackedDouble::min(X,Y); },
+                        [](auto P){ return PackedDouble::reduceMin(P); },
+                        [](double X, double Y){ return X < Y; });
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline double maxElementDouble(const double* A, unsigned long Size)
+{
+  return extremeElement(A,Size,
+                        [](auto X, auto Y){ return PackedDouble::max(X,Y); },
+                        [](auto P){ return PackedDouble::reduceMax(P); },
+                        [](double X, double Y){ return Y < X; });
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline void gemvDouble(const double* M, unsigned long ColsNbr, unsigned long RowsNbr, const double* X, double* Y)
+{
+  for (unsigned long r = 0; r < RowsNbr; r++)
+  {
+    Y[r] = 0.0;
+  }
+
+  for (unsigned long c = 0; c < ColsNbr; c++)
+  {
+    axpyDouble(X[c],M+c*RowsNbr,Y,RowsNbr);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the kernels built for the instruction set of the including file
+*/
+inline detail::DoubleKernels makeDoubleKernels()
+{
+  detail::DoubleKernels Kernels;
+
+  Kernels.ISA = PackedDouble::ISA;
+  Kernels.Add = addDouble;
+  Kernels.Subtract = subtractDouble;
+  Kernels.Multiply = multiplyDouble;
+  Kernels.Divide = divideDouble;
+  Kernels.AddScalar = addScalarDouble;
+  Kernels.Scale = scaleDouble;
+  Kernels.Axpy = axpyDouble;
+  Kernels.Clamp = clampDouble;
+  Kernels.Sum = sumDouble;
+  Kernels.Dot = dotDouble;
+  Kernels.MinElement = minElementDouble;
+  Kernels.MaxElement = maxElementDouble;
+  Kernels.Gemv = gemvDouble;
+
+  return Kernels;
+}
+
+
+}  // namespace
+
+
+} } }  // namespaces
+
+
+#if defined(OPENFLUID_KERNELS_BUILD_AVX512) || defined(OPENFLUID_KERNELS_BUILD_AVX)
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#if defined(OPENFLUID_KERNELS_BUILD_AVX512)
+#pragma GCC diagnostic pop
+#endif
+#pragma GCC pop_options
+#endif
+#endif
+
+
+#endif /* !OPENFLUID_KERNELS_SKIP */
+
+
+#endif /* __OPENFLUID_CORE_ARRAYKERNELSIMPL_HPP__ */
@@ -38,6 +38,8 @@
  */
 
 
+#include <algorithm>
+
 #include <openfluid/core/Attributes.hpp>
 #include <openfluid/core/MapValue.hpp>
 #include <openfluid/core/TreeValue.hpp>
@@ -47,16 +49,23 @@
 namespace openfluid { namespace core {
 
 
-bool Attributes::setValue(const AttributeName_t& aName, const Value& aValue)
+Attributes::Attributes(const Attributes& Other)
 {
-  if (isAttributeExist(aName))
+  if (Other.mp_Table)
   {
-    return false;
+    Other.mp_Table->copyRow(Other.m_Row,*table(),m_Row);
   }
+}
 
-  m_Data[aName].reset(aValue.clone());
 
-  return true;
+// =====================================================================
+// =====================================================================
+
+
+Attributes::Attributes(Attributes&& Other) noexcept :
+  mp_Table(std::move(Other.mp_Table)), m_Row(Other.m_Row)
+{
+  Other.mp_Table.reset();
 }
 
 
@@ -64,14 +73,110 @@ bool Attributes::setValue(const AttributeName_t& aName, const Value& aValue)
 // =====================================================================
 
 
-bool Attributes::setValue(const AttributeName_t& aName, const std::string& aValue)
+Attributes& Attributes::operator=(const Attributes& Other)
+{
+  if (this != &Other)
+  {
+    clear();
+
+    if (Other.mp_Table)
+    {
+      Other.mp_Table->copyRow(Other.m_Row,*table(),m_Row);
+    }
+  }
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+Attributes& Attributes::operator=(Attributes&& Other) noexcept
+{
+  if (this != &Other)
+  {
+    if (mp_Table)
+    {
+      mp_Table->removeRow(m_Row);
+    }
+
+    mp_Table = std::move(Other.mp_Table);
+    m_Row = Other.m_Row;
+    Other.mp_Table.reset();
+  }
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+Attributes::~Attributes()
+{
+  if (mp_Table)
+  {
+    mp_Table->removeRow(m_Row);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+AttributesTable* Attributes::table()
+{
+  // standalone attributes get their own table when the first value is set
+  if (!mp_Table)
+  {
+    mp_Table = std::make_shared<AttributesTable>();
+    m_Row = mp_Table->addRow();
+  }
+
+  return mp_Table.get();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void Attributes::bindTable(const std::shared_ptr<AttributesTable>& Table)
+{
+  if (mp_Table == Table)
+  {
+    return;
+  }
+
+  const std::size_t NewRow = Table->addRow();
+
+  if (mp_Table)
+  {
+    mp_Table->copyRow(m_Row,*Table,NewRow);
+    mp_Table->removeRow(m_Row);
+  }
+
+  mp_Table = Table;
+  m_Row = NewRow;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Attributes::setValue(const AttributeName_t& aName, const Value& aValue)
 {
   if (isAttributeExist(aName))
   {
     return false;
   }
 
-  m_Data[aName].reset(new StringValue(aValue));
+  table()->setValue(SymbolsTable::intern(aName),m_Row,aValue);
 
   return true;
 }
@@ -81,6 +186,16 @@ bool Attributes::setValue(const AttributeName_t& aName, const std::string& aValu
 // =====================================================================
 
 
+bool Attributes::setValue(const AttributeName_t& aName, const std::string& aValue)
+{
+  return setValue(aName,StringValue(aValue));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::string& aValue)
 {
   if (isAttributeExist(aName))
@@ -89,6 +204,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
   }
 
   StringValue TmpStrValue(aValue);
+  const SymbolID_t Symbol = SymbolsTable::intern(aName);
 
   switch (TmpStrValue.guessTypeConversion())
   {
@@ -99,7 +215,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       {
         return false;
       }
-      m_Data[aName].reset(new DoubleValue(TmpVal));
+      table()->setValue(Symbol,m_Row,DoubleValue(TmpVal));
       break;
     }
 
@@ -111,7 +227,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       {
         return false;
       }
-      m_Data[aName].reset(new IntegerValue(TmpVal));
+      table()->setValue(Symbol,m_Row,IntegerValue(TmpVal));
       break;
     }
 
@@ -122,13 +238,13 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       {
         return false;
       }
-      m_Data[aName].reset(new BooleanValue(TmpVal));
+      table()->setValue(Symbol,m_Row,BooleanValue(TmpVal));
       break;
     }
 
     case Value::STRING :
     {
-      m_Data[aName].reset(new StringValue(aValue));
+      table()->setValue(Symbol,m_Row,TmpStrValue);
       break;
     }
 
@@ -139,7 +255,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       {
         return false;
       }
-      m_Data[aName].reset(TmpVal.clone());
+      table()->setValue(Symbol,m_Row,TmpVal);
       break;
     }
 
@@ -150,7 +266,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       {
         return false;
       }
-      m_Data[aName].reset(TmpVal.clone());
+      table()->setValue(Symbol,m_Row,TmpVal);
       break;
     }
 
@@ -161,7 +277,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       {
         return false;
       }
-      m_Data[aName].reset(TmpVal.clone());
+      table()->setValue(Symbol,m_Row,TmpVal);
       break;
     }
 
@@ -172,7 +288,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       {
         return false;
       }
-      m_Data[aName].reset(TmpVal.clone());
+      table()->setValue(Symbol,m_Row,TmpVal);
       break;
     }
 
@@ -183,7 +299,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       {
         return false;
       }
-      m_Data[aName].reset(TmpVal.clone());
+      table()->setValue(Symbol,m_Row,TmpVal);
       break;
     }
 
@@ -201,14 +317,11 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
 
 bool Attributes::getValue(const AttributeName_t& aName, openfluid::core::StringValue& aValue) const
 {
-  // Don't use m_data[aName] because [] operator is not const
-
-  AttributesMap_t::const_iterator it = m_Data.find(aName);
+  const Value* Val = value(aName);
 
-  if (it != m_Data.end())
+  if (Val)
   {
-    aValue.set(it->second.get()->toString());
-
+    aValue.set(Val->toString());
     return true;
   }
 
@@ -222,11 +335,20 @@ bool Attributes::getValue(const AttributeName_t& aName, openfluid::core::StringV
 
 const openfluid::core::Value* Attributes::value(const AttributeName_t& aName) const
 {
-  AttributesMap_t::const_iterator it = m_Data.find(aName);
+  // names are not interned on lookup, an unknown name cannot be an attribute
+  return value(SymbolsTable::find(aName));
+}
 
-  if (it != m_Data.end())
+
+// =====================================================================
+// =====================================================================
+
+
+const openfluid::core::Value* Attributes::value(SymbolID_t aSymbol) const
+{
+  if (mp_Table)
   {
-    return it->second.get();
+    return mp_Table->value(aSymbol,m_Row);
   }
 
   return nullptr;
@@ -239,11 +361,11 @@ const openfluid::core::Value* Attributes::value(const AttributeName_t& aName) co
 
 bool Attributes::getValue(const AttributeName_t& aName, std::string& aValue) const
 {
-  AttributesMap_t::const_iterator it = m_Data.find(aName);
+  const Value* Val = value(aName);
 
-  if (it != m_Data.end())
+  if (Val)
   {
-    aValue = it->second.get()->toString();
+    aValue = Val->toString();
     return true;
   }
 
@@ -257,11 +379,11 @@ bool Attributes::getValue(const AttributeName_t& aName, std::string& aValue) con
 
 bool Attributes::getValueAsDouble(const AttributeName_t& aName, double& aValue) const
 {
-  AttributesMap_t::const_iterator it = m_Data.find(aName);
+  const Value* Val = value(aName);
 
-  if (it != m_Data.end() && it->second.get()->isDoubleValue())
+  if (Val && Val->isDoubleValue())
   {
-    aValue = it->second.get()->asDoubleValue();
+    aValue = Val->asDoubleValue();
     return true;
   }
   return false;
@@ -274,11 +396,11 @@ bool Attributes::getValueAsDouble(const AttributeName_t& aName, double& aValue)
 
 bool Attributes::getValueAsLong(const AttributeName_t& aName, long& aValue) const
 {
-  AttributesMap_t::const_iterator it = m_Data.find(aName);
+  const Value* Val = value(aName);
 
-  if (it != m_Data.end() && it->second.get()->isIntegerValue())
+  if (Val && Val->isIntegerValue())
   {
-    aValue = it->second.get()->asIntegerValue();
+    aValue = Val->asIntegerValue();
     return true;
   }
   return false;
@@ -291,7 +413,17 @@ bool Attributes::getValueAsLong(const AttributeName_t& aName, long& aValue) cons
 
 bool Attributes::isAttributeExist(const AttributeName_t& aName) const
 {
-  return m_Data.find(aName) != m_Data.end();
+  return isAttributeExist(SymbolsTable::find(aName));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Attributes::isAttributeExist(SymbolID_t aSymbol) const
+{
+  return (mp_Table && mp_Table->isValueExist(aSymbol,m_Row));
 }
 
 
@@ -303,11 +435,17 @@ std::vector<AttributeName_t> Attributes::getAttributesNames() const
 {
   std::vector<AttributeName_t> Names;
 
-  for (const auto& Attr : m_Data)
+  if (mp_Table)
   {
-    Names.push_back(Attr.first);
+    for (const auto& Symbol : mp_Table->getSymbols(m_Row))
+    {
+      Names.push_back(SymbolsTable::name(Symbol));
+    }
   }
 
+  // attributes are stored by symbol, names are sorted to keep the alphabetical order
+  std::sort(Names.begin(),Names.end());
+
   return Names;
 }
 
@@ -318,9 +456,11 @@ std::vector<AttributeName_t> Attributes::getAttributesNames() const
 
 bool Attributes::replaceValue(const AttributeName_t& aName, const StringValue& aValue)
 {
-  if(isAttributeExist(aName))
+  const SymbolID_t Symbol = SymbolsTable::find(aName);
+
+  if (isAttributeExist(Symbol))
   {
-    m_Data[aName].reset(new StringValue(aValue));
+    mp_Table->setValue(Symbol,m_Row,aValue);
 
     return true;
   }
@@ -335,15 +475,7 @@ bool Attributes::replaceValue(const AttributeName_t& aName, const StringValue& a
 
 bool Attributes::replaceValue(const AttributeName_t& aName, const std::string& aValue)
 {
-  if(isAttributeExist(aName))
-  {
-    m_Data[aName].reset(new StringValue(aValue));
-
-    return true;
-  }
-
-  return false;
-
+  return replaceValue(aName,StringValue(aValue));
 }
 
 
@@ -353,14 +485,7 @@ bool Attributes::replaceValue(const AttributeName_t& aName, const std::string& a
 
 bool Attributes::removeAttribute(const AttributeName_t& aName)
 {
-  if(isAttributeExist(aName))
-  {
-    m_Data.erase(aName);
-
-    return true;
-  }
-
-  return false;
+  return (mp_Table && mp_Table->unsetValue(SymbolsTable::find(aName),m_Row));
 }
 
 
@@ -370,7 +495,10 @@ bool Attributes::removeAttribute(const AttributeName_t& aName)
 
 void Attributes::clear()
 {
-  m_Data.clear();
+  if (mp_Table)
+  {
+    mp_Table->clearRow(m_Row);
+  }
 }
 
 
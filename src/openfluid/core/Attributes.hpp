@@ -45,6 +45,8 @@
 #include <memory>
 
 #include <openfluid/core/TypeDefs.hpp>
+#include <openfluid/core/SymbolsTable.hpp>
+#include <openfluid/core/AttributesTable.hpp>
 #include <openfluid/dllexport.hpp>
 #include <openfluid/core/Value.hpp>
 #include <openfluid/core/StringValue.hpp>
@@ -54,17 +56,46 @@
 namespace openfluid { namespace core {
 
 
+class UnitsCollection;
+
+
+/**
+  Attributes of a spatial unit, stored as a row of an attributes table.
+  Units of a units collection share the columnar table of the collection.
+  Standalone attributes, not belonging to a collection, use their own table.
+*/
 class OPENFLUID_API Attributes
 {
+  friend class UnitsCollection;
+
   private:
 
-    typedef std::map<AttributeName_t,std::shared_ptr<Value>> AttributesMap_t;
+    std::shared_ptr<AttributesTable> mp_Table;
+
+    std::size_t m_Row = 0;
 
-    AttributesMap_t m_Data;
+    AttributesTable* table();
+
+    /**
+      Moves the values of these attributes into a row of the given table, which is then used as storage
+    */
+    void bindTable(const std::shared_ptr<AttributesTable>& Table);
 
 
   public:
 
+    Attributes() = default;
+
+    Attributes(const Attributes& Other);
+
+    Attributes(Attributes&& Other) noexcept;
+
+    Attributes& operator=(const Attributes& Other);
+
+    Attributes& operator=(Attributes&& Other) noexcept;
+
+    ~Attributes();
+
     bool setValue(const AttributeName_t& aName, const Value& aValue);
 
     [[deprecated]] bool setValue(const AttributeName_t& aName, const std::string& aValue);
@@ -77,12 +108,20 @@ class OPENFLUID_API Attributes
 
     const openfluid::core::Value* value(const AttributeName_t& aName) const;
 
+    /**
+      Returns the value of the attribute given by its interned name, avoiding the name lookup
+      @see openfluid::core::SymbolsTable
+    */
+    const openfluid::core::Value* value(SymbolID_t aSymbol) const;
+
     [[deprecated]] bool getValueAsDouble(const AttributeName_t& aName, double& aValue) const;
 
     [[deprecated]] bool getValueAsLong(const AttributeName_t& aName, long& aValue) const;
 
     bool isAttributeExist(const AttributeName_t& aName) const;
 
+    bool isAttributeExist(SymbolID_t aSymbol) const;
+
     std::vector<AttributeName_t> getAttributesNames() const;
 
     bool replaceValue(const AttributeName_t& aName, const StringValue& aValue);
@@ -0,0 +1,405 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file AttributesTable.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <openfluid/core/AttributesTable.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+AttributesTable::Column& AttributesTable::createColumn(SymbolID_t aSymbol, Value::Type aType)
+{
+  Column& TheColumn = m_Columns[aSymbol];
+
+  if (aType == Value::DOUBLE || aType == Value::INTEGER || aType == Value::BOOLEAN)
+  {
+    TheColumn.Type = aType;
+  }
+
+  resizeColumn(TheColumn,m_RowsCount);
+
+  return TheColumn;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void AttributesTable::resizeColumn(Column& aColumn, std::size_t Size)
+{
+  aColumn.States.resize(Size,ABSENT);
+
+  switch (aColumn.Type)
+  {
+    case Value::DOUBLE :
+      aColumn.Doubles.resize(Size);
+      break;
+    case Value::INTEGER :
+      aColumn.Integers.resize(Size);
+      break;
+    case Value::BOOLEAN :
+      aColumn.Booleans.resize(Size);
+      break;
+    default :
+      aColumn.Values.resize(Size);
+      break;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void AttributesTable::unsetCell(Column& aColumn, std::size_t Row)
+{
+  if (aColumn.States[Row] == OTHER)
+  {
+    if (aColumn.Type == Value::NONE)
+    {
+      aColumn.Values[Row].reset();
+    }
+    else
+    {
+      aColumn.Others.erase(Row);
+    }
+  }
+
+  aColumn.States[Row] = ABSENT;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::size_t AttributesTable::addRow()
+{
+  std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+  if (!m_FreeRows.empty())
+  {
+    const std::size_t Row = m_FreeRows.back();
+    m_FreeRows.pop_back();
+    return Row;
+  }
+
+  const std::size_t Row = m_RowsCount;
+  m_RowsCount++;
+
+  for (auto& Col : m_Columns)
+  {
+    resizeColumn(Col.second,m_RowsCount);
+  }
+
+  return Row;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void AttributesTable::removeRow(std::size_t Row)
+{
+  std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+  for (auto& Col : m_Columns)
+  {
+    unsetCell(Col.second,Row);
+  }
+
+  m_FreeRows.push_back(Row);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void AttributesTable::clearRow(std::size_t Row)
+{
+  std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+  for (auto& Col : m_Columns)
+  {
+    unsetCell(Col.second,Row);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void AttributesTable::copyRow(std::size_t Row, AttributesTable& Dest, std::size_t DestRow) const
+{
+  // values are copied first since the destination table may be this table
+  std::vector<std::pair<SymbolID_t,std::unique_ptr<Value>>> RowValues;
+
+  {
+    std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+
+    for (const auto& Col : m_Columns)
+    {
+      const Value* Val = findValue(Col.first,Row);
+
+      if (Val)
+      {
+        RowValues.emplace_back(Col.first,std::unique_ptr<Value>(Val->clone()));
+      }
+    }
+  }
+
+  for (const auto& Val : RowValues)
+  {
+    Dest.setValue(Val.first,DestRow,*Val.second);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void AttributesTable::setValue(SymbolID_t aSymbol, std::size_t Row, const Value& aValue)
+{
+  std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+  auto it = m_Columns.find(aSymbol);
+  Column& TheColumn = (it != m_Columns.end()) ? it->second : createColumn(aSymbol,aValue.getType());
+
+  unsetCell(TheColumn,Row);
+
+  if (TheColumn.Type == Value::NONE)
+  {
+    TheColumn.Values[Row].reset(aValue.clone());
+    TheColumn.States[Row] = OTHER;
+  }
+  else if (TheColumn.Type != aValue.getType())
+  {
+    TheColumn.Others[Row].reset(aValue.clone());
+    TheColumn.States[Row] = OTHER;
+  }
+  else
+  {
+    switch (TheColumn.Type)
+    {
+      case Value::DOUBLE :
+        TheColumn.Doubles[Row].set(aValue.asDoubleValue().get());
+        break;
+      case Value::INTEGER :
+        TheColumn.Integers[Row].set(aValue.asIntegerValue().get());
+        break;
+      default :
+        TheColumn.Booleans[Row].set(aValue.asBooleanValue().get());
+        break;
+    }
+    TheColumn.States[Row] = TYPED;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool AttributesTable::unsetValue(SymbolID_t aSymbol, std::size_t Row)
+{
+  std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+
+  auto it = m_Columns.find(aSymbol);
+
+  if (it == m_Columns.end() || it->second.States[Row] == ABSENT)
+  {
+    return false;
+  }
+
+  unsetCell(it->second,Row);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const Value* AttributesTable::findValue(SymbolID_t aSymbol, std::size_t Row) const
+{
+  auto it = m_Columns.find(aSymbol);
+
+  if (it == m_Columns.end())
+  {
+    return nullptr;
+  }
+
+  const Column& TheColumn = it->second;
+
+  if (TheColumn.States[Row] == TYPED)
+  {
+    switch (TheColumn.Type)
+    {
+      case Value::DOUBLE :
+        return &TheColumn.Doubles[Row];
+      case Value::INTEGER :
+        return &TheColumn.Integers[Row];
+      default :
+        return &TheColumn.Booleans[Row];
+    }
+  }
+  else if (TheColumn.States[Row] == OTHER)
+  {
+    if (TheColumn.Type == Value::NONE)
+    {
+      return TheColumn.Values[Row].get();
+    }
+    return TheColumn.Others.at(Row).get();
+  }
+
+  return nullptr;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const Value* AttributesTable::value(SymbolID_t aSymbol, std::size_t Row) const
+{
+  std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+
+  return findValue(aSymbol,Row);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool AttributesTable::isValueExist(SymbolID_t aSymbol, std::size_t Row) const
+{
+  std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+
+  auto it = m_Columns.find(aSymbol);
+
+  return (it != m_Columns.end() && it->second.States[Row] != ABSENT);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<SymbolID_t> AttributesTable::getSymbols(std::size_t Row) const
+{
+  std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+
+  std::vector<SymbolID_t> Symbols;
+
+  for (const auto& Col : m_Columns)
+  {
+    if (Col.second.States[Row] != ABSENT)
+    {
+      Symbols.push_back(Col.first);
+    }
+  }
+
+  return Symbols;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool AttributesTable::getColumnValues(SymbolID_t aSymbol, const std::vector<std::size_t>& Rows,
+                                      std::vector<double>& Values) const
+{
+  Values.clear();
+
+  std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+
+  auto it = m_Columns.find(aSymbol);
+
+  if (it == m_Columns.end())
+  {
+    return Rows.empty();
+  }
+
+  const Column& TheColumn = it->second;
+  Values.resize(Rows.size());
+
+  for (std::size_t i = 0; i < Rows.size(); i++)
+  {
+    const std::size_t Row = Rows[i];
+
+    if (TheColumn.States[Row] == TYPED && TheColumn.Type == Value::DOUBLE)
+    {
+      Values[i] = TheColumn.Doubles[Row].get();
+    }
+    else if (TheColumn.States[Row] == TYPED && TheColumn.Type == Value::INTEGER)
+    {
+      Values[i] = static_cast<double>(TheColumn.Integers[Row].get());
+    }
+    else
+    {
+      const Value* Val = findValue(aSymbol,Row);
+
+      if (Val && Val->isDoubleValue())
+      {
+        Values[i] = Val->asDoubleValue().get();
+      }
+      else if (Val && Val->isIntegerValue())
+      {
+        Values[i] = static_cast<double>(Val->asIntegerValue().get());
+      }
+      else
+      {
+        Values.clear();
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+
+} } // namespaces
@@ -0,0 +1,214 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file AttributesTable.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_ATTRIBUTESTABLE_HPP__
+#define __OPENFLUID_CORE_ATTRIBUTESTABLE_HPP__
+
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/TypeDefs.hpp>
+#include <openfluid/core/DoubleValue.hpp>
+#include <openfluid/core/IntegerValue.hpp>
+#include <openfluid/core/BooleanValue.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+/**
+  Columnar storage of the attributes of a set of spatial units, usually all the units of a units class.
+  Each unit owns a row of the table, each attribute is stored in a column.
+  Columns of double, integer or boolean values are stored as contiguous typed values.
+  Values of other types, or values which type differs from the type of their column, are stored individually.
+
+  Typed values are stored as Value objects since values are returned as pointers to openfluid::core::Value.
+
+  Reads and modifications are synchronized, so that the units sharing a table can be read and modified
+  from concurrent threads. Pointers to values returned by the table are valid until rows are added
+  to the table, or until the same value is modified or removed.
+*/
+class OPENFLUID_API AttributesTable
+{
+  private:
+
+    enum CellState : std::uint8_t { ABSENT = 0, TYPED, OTHER };
+
+    struct Column
+    {
+      /**
+        Type of the contiguous values (DOUBLE, INTEGER or BOOLEAN), NONE if all values are stored individually
+      */
+      Value::Type Type = Value::NONE;
+
+      std::vector<CellState> States;
+
+      std::vector<DoubleValue> Doubles;
+
+      std::vector<IntegerValue> Integers;
+
+      std::vector<BooleanValue> Booleans;
+
+      /**
+        Individual values of columns without contiguous type, indexed by row
+      */
+      std::vector<std::unique_ptr<Value>> Values;
+
+      /**
+        Individual values of columns with a contiguous type, for values of another type
+      */
+      std::unordered_map<std::size_t,std::unique_ptr<Value>> Others;
+    };
+
+    std::map<SymbolID_t,Column> m_Columns;
+
+    std::size_t m_RowsCount = 0;
+
+    std::vector<std::size_t> m_FreeRows;
+
+    mutable std::shared_mutex m_Mutex;
+
+    Column& createColumn(SymbolID_t aSymbol, Value::Type aType);
+
+    void resizeColumn(Column& aColumn, std::size_t Size);
+
+    static void unsetCell(Column& aColumn, std::size_t Row);
+
+    const Value* findValue(SymbolID_t aSymbol, std::size_t Row) const;
+
+
+  public:
+
+    AttributesTable() = default;
+
+    AttributesTable(const AttributesTable&) = delete;
+
+    AttributesTable& operator=(const AttributesTable&) = delete;
+
+    /**
+      Adds a row to the table, reusing a previously removed row if any
+      @return the index of the row
+    */
+    std::size_t addRow();
+
+    /**
+      Removes all values of the given row and makes the row available for reuse
+      @param[in] Row the index of the row
+    */
+    void removeRow(std::size_t Row);
+
+    /**
+      Removes all values of the given row
+      @param[in] Row the index of the row
+    */
+    void clearRow(std::size_t Row);
+
+    /**
+      Copies all values of a row of this table into a row of another table
+      @param[in] Row the index of the row to copy
+      @param[in] Dest the destination table
+      @param[in] DestRow the index of the row in the destination table
+    */
+    void copyRow(std::size_t Row, AttributesTable& Dest, std::size_t DestRow) const;
+
+    /**
+      Sets the value of an attribute for a row, replacing any existing value
+      @param[in] aSymbol the interned name of the attribute
+      @param[in] Row the index of the row
+      @param[in] aValue the value to set
+    */
+    void setValue(SymbolID_t aSymbol, std::size_t Row, const Value& aValue);
+
+    /**
+      Removes the value of an attribute for a row
+      @return true if a value was removed
+    */
+    bool unsetValue(SymbolID_t aSymbol, std::size_t Row);
+
+    /**
+      Returns the value of an attribute for a row, nullptr if the value does not exist.
+      The returned pointer is invalidated when rows are added to the table
+      and when the value of this attribute for this row is modified or removed.
+    */
+    const Value* value(SymbolID_t aSymbol, std::size_t Row) const;
+
+    bool isValueExist(SymbolID_t aSymbol, std::size_t Row) const;
+
+    /**
+      Returns the interned names of the attributes having a value for the given row
+    */
+    std::vector<SymbolID_t> getSymbols(std::size_t Row) const;
+
+    /**
+      Gathers the values of an attribute for the given rows as doubles.
+      Integer values are converted to doubles.
+      @param[in] aSymbol the interned name of the attribute
+      @param[in] Rows the indexes of the rows to gather, in the expected order
+      @param[out] Values the gathered values, in the same order than the rows
+      @return false if a value does not exist or is not a double or an integer value
+    */
+    bool getColumnValues(SymbolID_t aSymbol, const std::vector<std::size_t>& Rows, std::vector<double>& Values) const;
+
+    /**
+      Returns the number of rows of the table, including removed rows available for reuse
+    */
+    inline std::size_t getRowsCount() const
+    {
+      std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+      return m_RowsCount;
+    }
+
+    inline std::size_t getColumnsCount() const
+    {
+      std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+      return m_Columns.size();
+    }
+
+};
+
+
+} } // namespaces
+
+
+#endif /* __OPENFLUID_CORE_ATTRIBUTESTABLE_HPP__ */
@@ -42,14 +42,37 @@
 #include <iomanip>
 #include <ctime>
 
-#include <boost/date_time/posix_time/posix_time.hpp>
-
 #include <openfluid/core/DateTime.hpp>
 
 
 namespace openfluid { namespace core {
 
 
+namespace {
+
+/**
+  Returns a compiled format for the given format string, kept for the next calls in the same thread
+  as most callers use the same format string repeatedly
+*/
+const DateTimeFormat& cachedFormat(const std::string& FormatStr)
+{
+  thread_local DateTimeFormat Format;
+
+  if (Format.getFormatString() != FormatStr)
+  {
+    Format = DateTimeFormat(FormatStr);
+  }
+
+  return Format;
+}
+
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 DateTime::DateTime()
 {
   set(1900, 1, 1, 0, 0, 0);
@@ -151,16 +174,7 @@ bool DateTime::set(int Year, int Month, int Day, int Hour, int Minute, int Secon
 
 bool DateTime::setFromISOString(const std::string& DateTimeStr)
 {
-  int Year;
-  int Month;
-  int Day;
-  int Hour;
-  int Min;
-  int Sec;
-
-  // scan of the input string to break it down
-  return (sscanf(DateTimeStr.c_str(),"%4d-%2d-%2d %2d:%2d:%2d",&Year,&Month,&Day,&Hour,&Min,&Sec) == 6 &&
-          set(Year, Month, Day, Hour, Min, Sec));
+  return DateTimeFormat::isoFormat().parse(DateTimeStr,*this);
 }
 
 
@@ -170,27 +184,17 @@ bool DateTime::setFromISOString(const std::string& DateTimeStr)
 
 bool DateTime::setFromString(const std::string& DateTimeStr, const std::string& FormatStr)
 {
-  // TODO Should be replaced by C++11 features when available. Example:
-  /*
-  std::tm CTime;
-  std::istringstream StrS(DateTimeStr);
-  StrS.imbue(std::locale(std::locale::classic()));
-  StrS >> std::get_time(&CTime,FormatStr.c_str());
+  return cachedFormat(FormatStr).parse(DateTimeStr,*this);
+}
 
-  return (set(CTime.tm_year+1900, CTime.tm_mon+1,CTime.tm_mday,
-              CTime.tm_hour,CTime.tm_min,CTime.tm_sec));
-  */
 
-  boost::posix_time::time_input_facet* Facet = new  boost::posix_time::time_input_facet(FormatStr);
+// =====================================================================
+// =====================================================================
 
-  std::istringstream StrS(DateTimeStr);
-  StrS.imbue(std::locale(std::locale::classic(),Facet));
-  boost::posix_time::ptime Time(boost::posix_time::not_a_date_time);
-  StrS >> Time;
 
-  return (Time != boost::posix_time::not_a_date_time &&
-          set(Time.date().year(), Time.date().month(),Time.date().day(),Time.time_of_day().hours(),
-              Time.time_of_day().minutes(), Time.time_of_day().seconds()));
+bool DateTime::setFromString(const std::string& DateTimeStr, const DateTimeFormat& Format)
+{
+  return Format.parse(DateTimeStr,*this);
 }
 
 
@@ -306,12 +310,7 @@ RawTime_t DateTime::getRawTime() const
 
 std::string DateTime::getAsISOString() const
 {
-  char pCh[80];
-  std::string Str;
-
-  strftime(pCh,80,"%Y-%m-%d %H:%M:%S",&m_TM);
-
-  return std::string(pCh,strlen(pCh));
+  return DateTimeFormat::isoFormat().format(*this);
 }
 
 
@@ -319,14 +318,19 @@ std::string DateTime::getAsISOString() const
 // =====================================================================
 
 
-std::string  DateTime::getAsString(const std::string& Format) const
+std::string DateTime::getAsString(const std::string& Format) const
 {
-  char pCh[80];
-  std::string Str;
+  return cachedFormat(Format).format(*this);
+}
+
+
+// =====================================================================
+// =====================================================================
 
-  strftime(pCh,80,Format.c_str(),&m_TM);
 
-  return std::string(pCh,strlen(pCh));
+std::string DateTime::getAsString(const DateTimeFormat& Format) const
+{
+  return Format.format(*this);
 }
 
 
@@ -336,12 +340,8 @@ std::string  DateTime::getAsString(const std::string& Format) const
 
 std::string DateTime::getDateAsISOString() const
 {
-  char pCh[80];
-  std::string Str;
-
-  strftime(pCh,80,"%Y-%m-%d",&m_TM);
-
-  return std::string(pCh,strlen(pCh));
+  static const DateTimeFormat Format("%Y-%m-%d");
+  return Format.format(*this);
 }
 
 
@@ -351,13 +351,8 @@ std::string DateTime::getDateAsISOString() const
 
 std::string DateTime::getTimeAsISOString() const
 {
-  char pCh[80];
-  std::string Str;
-
-  strftime(pCh,80,"%H:%M:%S",&m_TM);
-
-  return std::string(pCh,strlen(pCh));
-
+  static const DateTimeFormat Format("%H:%M:%S");
+  return Format.format(*this);
 }
 
 
@@ -47,6 +47,7 @@
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/core/TypeDefs.hpp>
+#include <openfluid/core/DateTimeFormat.hpp>
 
 
 namespace openfluid { namespace core {
@@ -86,6 +87,8 @@ namespace openfluid { namespace core {
 */
 class OPENFLUID_API DateTime
 {
+  friend class DateTimeFormat;
+
   private:
 
     /**
@@ -203,6 +206,14 @@ class OPENFLUID_API DateTime
     */
     bool setFromString(const std::string& DateTimeStr, const std::string& FormatStr);
 
+    /**
+      Sets the date and time from a string using the given compiled format
+      @param[in] DateTimeStr The date and time string
+      @param[in] Format The compiled format
+      @return true if the operation is successful
+    */
+    bool setFromString(const std::string& DateTimeStr, const DateTimeFormat& Format);
+
 
     /**
       Returns Year (4 digits)
@@ -278,6 +289,12 @@ class OPENFLUID_API DateTime
     */
     std::string getAsString(const std::string& Format) const;
 
+    /**
+      Returns date-time as string, using the given compiled format
+      @param[in] Format the compiled format
+    */
+    std::string getAsString(const DateTimeFormat& Format) const;
+
 
     /**
       Returns date as string, using format YYYY-MM-DD
@@ -0,0 +1,537 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file DateTimeFormat.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <cstdio>
+#include <ctime>
+#include <sstream>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <openfluid/core/DateTimeFormat.hpp>
+#include <openfluid/core/DateTime.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+namespace {
+
+enum FieldIndex { YEAR_FIELD = 0, MONTH_FIELD, DAY_FIELD, HOUR_FIELD, MINUTE_FIELD, SECOND_FIELD, FIELDS_COUNT };
+
+
+inline bool isDigit(char C)
+{
+  return (C >= '0' && C <= '9');
+}
+
+
+inline bool isSpace(char C)
+{
+  return (C == ' ' || C == '\t' || C == '\n' || C == '\r' || C == '\v' || C == '\f');
+}
+
+
+inline char* writeTwoDigits(char* Buffer, int Value)
+{
+  Buffer[0] = static_cast<char>('0'+(Value/10)%10);
+  Buffer[1] = static_cast<char>('0'+Value%10);
+  return Buffer+2;
+}
+
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+DateTimeFormat::DateTimeFormat()
+{
+  compile();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+DateTimeFormat::DateTimeFormat(const std::string& FormatStr) :
+  m_FormatStr(FormatStr)
+{
+  compile();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void DateTimeFormat::compile()
+{
+  m_Tokens.clear();
+  m_IsCompiled = true;
+
+  for (std::size_t i = 0; i < m_FormatStr.size() && m_IsCompiled; i++)
+  {
+    const char C = m_FormatStr[i];
+
+    if (C != '%')
+    {
+      if (isSpace(C))
+      {
+        m_Tokens.push_back({TokenType::SPACES,C});
+      }
+      else
+      {
+        m_Tokens.push_back({TokenType::LITERAL,C});
+      }
+    }
+    else if (i+1 < m_FormatStr.size())
+    {
+      i++;
+
+      switch (m_FormatStr[i])
+      {
+        case 'Y' : m_Tokens.push_back({TokenType::YEAR,0}); break;
+        case 'y' : m_Tokens.push_back({TokenType::YEAR2,0}); break;
+        case 'm' : m_Tokens.push_back({TokenType::MONTH,0}); break;
+        case 'd' : m_Tokens.push_back({TokenType::DAY,0}); break;
+        case 'e' : m_Tokens.push_back({TokenType::DAYSPACE,0}); break;
+        case 'H' : m_Tokens.push_back({TokenType::HOUR,0}); break;
+        case 'M' : m_Tokens.push_back({TokenType::MINUTE,0}); break;
+        case 'S' : m_Tokens.push_back({TokenType::SECOND,0}); break;
+        case '%' : m_Tokens.push_back({TokenType::LITERAL,'%'}); break;
+        case 'n' : m_Tokens.push_back({TokenType::SPACES,'\n'}); break;
+        case 't' : m_Tokens.push_back({TokenType::SPACES,'\t'}); break;
+        case 'F' :
+          m_Tokens.insert(m_Tokens.end(),{{TokenType::YEAR,0},{TokenType::LITERAL,'-'},{TokenType::MONTH,0},
+                                          {TokenType::LITERAL,'-'},{TokenType::DAY,0}});
+          break;
+        case 'T' :
+          m_Tokens.insert(m_Tokens.end(),{{TokenType::HOUR,0},{TokenType::LITERAL,':'},{TokenType::MINUTE,0},
+                                          {TokenType::LITERAL,':'},{TokenType::SECOND,0}});
+          break;
+        case 'R' :
+          m_Tokens.insert(m_Tokens.end(),{{TokenType::HOUR,0},{TokenType::LITERAL,':'},{TokenType::MINUTE,0}});
+          break;
+        case 'D' :
+          m_Tokens.insert(m_Tokens.end(),{{TokenType::MONTH,0},{TokenType::LITERAL,'/'},{TokenType::DAY,0},
+                                          {TokenType::LITERAL,'/'},{TokenType::YEAR2,0}});
+          break;
+        default :
+          m_IsCompiled = false;
+      }
+    }
+    else
+    {
+      m_IsCompiled = false;
+    }
+  }
+
+  if (!m_IsCompiled)
+  {
+    m_Tokens.clear();
+  }
+
+
+  // fixed layout: only fixed-width numeric fields, literals and single whitespaces
+  // (variable spacing is handled by the tokens parsing fallback)
+
+  m_IsFixedLayout = m_IsCompiled && !m_Tokens.empty();
+  m_FixedLength = 0;
+
+  for (const auto& T : m_Tokens)
+  {
+    if (T.Type == TokenType::DAYSPACE)
+    {
+      m_IsFixedLayout = false;
+    }
+    else if (T.Type == TokenType::LITERAL || T.Type == TokenType::SPACES)
+    {
+      m_FixedLength += 1;
+    }
+    else if (T.Type == TokenType::YEAR)
+    {
+      m_FixedLength += 4;
+    }
+    else
+    {
+      m_FixedLength += 2;
+    }
+  }
+
+  if (!m_IsFixedLayout)
+  {
+    m_FixedLength = 0;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool DateTimeFormat::parseFixed(const char* Str, std::size_t Length, int* Fields) const
+{
+  if (Length < m_FixedLength)
+  {
+    return false;
+  }
+
+  const char* P = Str;
+
+  for (const auto& T : m_Tokens)
+  {
+    if (T.Type == TokenType::LITERAL || T.Type == TokenType::SPACES)
+    {
+      if (*P != T.Literal)
+      {
+        return false;
+      }
+      P++;
+    }
+    else if (T.Type == TokenType::YEAR)
+    {
+      if (!isDigit(P[0]) || !isDigit(P[1]) || !isDigit(P[2]) || !isDigit(P[3]))
+      {
+        return false;
+      }
+      Fields[YEAR_FIELD] = (P[0]-'0')*1000 + (P[1]-'0')*100 + (P[2]-'0')*10 + (P[3]-'0');
+      P += 4;
+    }
+    else
+    {
+      if (!isDigit(P[0]) || !isDigit(P[1]))
+      {
+        return false;
+      }
+
+      const int Value = (P[0]-'0')*10 + (P[1]-'0');
+      P += 2;
+
+      switch (T.Type)
+      {
+        case TokenType::YEAR2 : Fields[YEAR_FIELD] = (Value < 69 ? 2000 : 1900) + Value; break;
+        case TokenType::MONTH : Fields[MONTH_FIELD] = Value; break;
+        case TokenType::DAY : Fields[DAY_FIELD] = Value; break;
+        case TokenType::HOUR : Fields[HOUR_FIELD] = Value; break;
+        case TokenType::MINUTE : Fields[MINUTE_FIELD] = Value; break;
+        case TokenType::SECOND : Fields[SECOND_FIELD] = Value; break;
+        default : return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool DateTimeFormat::parseTokens(const char* Str, std::size_t Length, int* Fields) const
+{
+  const char* P = Str;
+  const char* End = Str+Length;
+
+  // leading whitespaces are ignored
+  while (P != End && isSpace(*P))
+  {
+    P++;
+  }
+
+  for (const auto& T : m_Tokens)
+  {
+    if (T.Type == TokenType::SPACES)
+    {
+      while (P != End && isSpace(*P))
+      {
+        P++;
+      }
+    }
+    else if (T.Type == TokenType::LITERAL)
+    {
+      if (P == End || *P != T.Literal)
+      {
+        return false;
+      }
+      P++;
+    }
+    else
+    {
+      const int MaxWidth = (T.Type == TokenType::YEAR ? 4 : 2);
+
+      if (T.Type == TokenType::DAYSPACE && P != End && *P == ' ')
+      {
+        P++;
+      }
+
+      int Value = 0;
+      int Width = 0;
+
+      while (P != End && Width < MaxWidth && isDigit(*P))
+      {
+        Value = Value*10 + (*P-'0');
+        P++;
+        Width++;
+      }
+
+      if (Width == 0)
+      {
+        return false;
+      }
+
+      switch (T.Type)
+      {
+        case TokenType::YEAR : Fields[YEAR_FIELD] = Value; break;
+        case TokenType::YEAR2 : Fields[YEAR_FIELD] = (Value < 69 ? 2000 : 1900) + Value; break;
+        case TokenType::MONTH : Fields[MONTH_FIELD] = Value; break;
+        case TokenType::DAY :
+        case TokenType::DAYSPACE : Fields[DAY_FIELD] = Value; break;
+        case TokenType::HOUR : Fields[HOUR_FIELD] = Value; break;
+        case TokenType::MINUTE : Fields[MINUTE_FIELD] = Value; break;
+        case TokenType::SECOND : Fields[SECOND_FIELD] = Value; break;
+        default : return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool DateTimeFormat::parse(const char* Str, std::size_t Length, DateTime& DT) const
+{
+  if (!m_IsCompiled)
+  {
+    // generic processing for formats that are not compiled
+
+    boost::posix_time::time_input_facet* Facet = new boost::posix_time::time_input_facet(m_FormatStr);
+
+    std::istringstream StrS(std::string(Str,Length));
+    StrS.imbue(std::locale(std::locale::classic(),Facet));
+    boost::posix_time::ptime Time(boost::posix_time::not_a_date_time);
+    StrS >> Time;
+
+    return (Time != boost::posix_time::not_a_date_time &&
+            DT.set(Time.date().year(), Time.date().month(),Time.date().day(),Time.time_of_day().hours(),
+                   Time.time_of_day().minutes(), Time.time_of_day().seconds()));
+  }
+
+  // missing fields are set to the default date-time
+  int Fields[FIELDS_COUNT] = {1900,1,1,0,0,0};
+
+  if (!(m_IsFixedLayout && parseFixed(Str,Length,Fields)) && !parseTokens(Str,Length,Fields))
+  {
+    return false;
+  }
+
+  return DT.set(Fields[YEAR_FIELD],Fields[MONTH_FIELD],Fields[DAY_FIELD],
+                Fields[HOUR_FIELD],Fields[MINUTE_FIELD],Fields[SECOND_FIELD]);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::size_t DateTimeFormat::format(const DateTime& DT, char* Buffer, std::size_t Size) const
+{
+  if (Size == 0)
+  {
+    return 0;
+  }
+
+  if (!m_IsCompiled)
+  {
+    // generic processing for formats that are not compiled
+    std::size_t Written = strftime(Buffer,Size,m_FormatStr.c_str(),&DT.m_TM);
+
+    if (Written == 0)
+    {
+      Buffer[0] = '\0';
+    }
+
+    return Written;
+  }
+
+  const int Year = DT.getYear();
+  const bool IsFixedYear = (Year >= 1000 && Year <= 9999);
+
+  char* P = Buffer;
+  char* const End = Buffer+Size-1;  // keeps room for the terminating null character
+
+  for (const auto& T : m_Tokens)
+  {
+    if (T.Type == TokenType::LITERAL || T.Type == TokenType::SPACES)
+    {
+      if (P == End)
+      {
+        Buffer[0] = '\0';
+        return 0;
+      }
+      *P++ = T.Literal;
+    }
+    else if (T.Type == TokenType::YEAR)
+    {
+      if (IsFixedYear && End-P >= 4)
+      {
+        P = writeTwoDigits(P,Year/100);
+        P = writeTwoDigits(P,Year%100);
+      }
+      else
+      {
+        const int Written = std::snprintf(P,End-P+1,"%d",Year);
+
+        if (Written < 0 || Written > End-P)
+        {
+          Buffer[0] = '\0';
+          return 0;
+        }
+        P += Written;
+      }
+    }
+    else
+    {
+      if (End-P < 2)
+      {
+        Buffer[0] = '\0';
+        return 0;
+      }
+
+      switch (T.Type)
+      {
+        case TokenType::YEAR2 : P = writeTwoDigits(P,((Year%100)+100)%100); break;
+        case TokenType::MONTH : P = writeTwoDigits(P,DT.getMonth()); break;
+        case TokenType::DAY : P = writeTwoDigits(P,DT.getDay()); break;
+        case TokenType::DAYSPACE :
+          P = writeTwoDigits(P,DT.getDay());
+          if (DT.getDay() < 10)
+          {
+            *(P-2) = ' ';
+          }
+          break;
+        case TokenType::HOUR : P = writeTwoDigits(P,DT.getHour()); break;
+        case TokenType::MINUTE : P = writeTwoDigits(P,DT.getMinute()); break;
+        case TokenType::SECOND : P = writeTwoDigits(P,DT.getSecond()); break;
+        default : break;
+      }
+    }
+  }
+
+  *P = '\0';
+
+  return static_cast<std::size_t>(P-Buffer);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void DateTimeFormat::format(const DateTime& DT, std::string& Str) const
+{
+  char Buffer[128];
+  std::size_t Written = format(DT,Buffer,sizeof(Buffer));
+
+  if (Written == 0 && !m_FormatStr.empty())
+  {
+    // formatted string is larger than the local buffer
+    std::vector<char> LargeBuffer(m_FormatStr.size()*32+128);
+    Written = format(DT,LargeBuffer.data(),LargeBuffer.size());
+    Str.assign(LargeBuffer.data(),Written);
+  }
+  else
+  {
+    Str.assign(Buffer,Written);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::string DateTimeFormat::format(const DateTime& DT) const
+{
+  std::string Str;
+  format(DT,Str);
+  return Str;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const DateTimeFormat& DateTimeFormat::isoFormat()
+{
+  static const DateTimeFormat Format("%Y-%m-%d %H:%M:%S");
+  return Format;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const DateTimeFormat& DateTimeFormat::iso8601Format()
+{
+  static const DateTimeFormat Format("%Y-%m-%dT%H:%M:%S");
+  return Format;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const DateTimeFormat& DateTimeFormat::compactFormat()
+{
+  static const DateTimeFormat Format("%Y%m%dT%H%M%S");
+  return Format;
+}
+
+
+} }  // namespaces
@@ -0,0 +1,211 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file DateTimeFormat.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_DATETIMEFORMAT_HPP__
+#define __OPENFLUID_CORE_DATETIMEFORMAT_HPP__
+
+
+#include <string>
+#include <vector>
+
+#include <openfluid/dllexport.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+class DateTime;
+
+
+/**
+  Date and time format, compiled once from a strftime()-like format string
+  and used to parse or format many date-times without allocation.
+
+  The following directives are compiled: %Y %m %d %e %H %M %S %y %F %T %R %D %n %t %%.
+  When parsing, numeric fields accept from one digit up to their maximum width,
+  and a whitespace in the format matches any number of whitespaces, including none.
+  Formats made only of fixed-width numeric fields, literals and single whitespaces, such as
+  ISO (%Y-%m-%d %H:%M:%S), ISO 8601 (%Y-%m-%dT%H:%M:%S) or compact (%Y%m%dT%H%M%S) formats,
+  are processed by a fixed layout fast path.
+
+  Format strings containing other directives (such as month or day names) are supported through
+  the generic strftime() and boost::date_time based processing, which is slower.
+
+  @cond OpenFLUID:completion
+  {
+    "contexts" : ["ANYWARE"],
+    "menupath" : ["Types", "Time"],
+    "title" : "Date and time format",
+    "text" : "openfluid::core::DateTimeFormat %%SEL_START%%DTFormat%%SEL_END%%(\"%Y-%m-%d %H:%M:%S\")"
+  }
+  @endcond
+*/
+class OPENFLUID_API DateTimeFormat
+{
+  private:
+
+    enum class TokenType : char { LITERAL, SPACES, YEAR, YEAR2, MONTH, DAY, DAYSPACE, HOUR, MINUTE, SECOND };
+
+    struct Token
+    {
+      TokenType Type;
+
+      char Literal;
+    };
+
+    std::string m_FormatStr;
+
+    std::vector<Token> m_Tokens;
+
+    bool m_IsCompiled = true;
+
+    bool m_IsFixedLayout = false;
+
+    std::size_t m_FixedLength = 0;
+
+    void compile();
+
+    bool parseFixed(const char* Str, std::size_t Length, int* Fields) const;
+
+    bool parseTokens(const char* Str, std::size_t Length, int* Fields) const;
+
+
+  public:
+
+    /**
+      Creates an empty format
+    */
+    DateTimeFormat();
+
+    /**
+      Creates a format from a strftime()-like format string
+      @param[in] FormatStr the format string
+    */
+    DateTimeFormat(const std::string& FormatStr);
+
+    /**
+      Returns the format string
+    */
+    const std::string& getFormatString() const
+    {
+      return m_FormatStr;
+    }
+
+    /**
+      Returns true if the format is fully compiled, false if the generic processing is used
+    */
+    bool isCompiled() const
+    {
+      return m_IsCompiled;
+    }
+
+    /**
+      Returns true if the format is processed using the fixed layout fast path
+    */
+    bool isFixedLayout() const
+    {
+      return m_IsFixedLayout;
+    }
+
+    /**
+      Parses a date-time string
+      @param[in] Str the string to parse
+      @param[in] Length the length of the string
+      @param[out] DT the parsed date-time, unchanged if the parsing failed
+      @return true if the string was successfully parsed into a valid date-time
+    */
+    bool parse(const char* Str, std::size_t Length, DateTime& DT) const;
+
+    /**
+      Parses a date-time string
+      @param[in] Str the string to parse
+      @param[out] DT the parsed date-time, unchanged if the parsing failed
+      @return true if the string was successfully parsed into a valid date-time
+    */
+    bool parse(const std::string& Str, DateTime& DT) const
+    {
+      return parse(Str.data(),Str.size(),DT);
+    }
+
+    /**
+      Formats a date-time into a buffer, followed by a terminating null character
+      @param[in] DT the date-time to format
+      @param[out] Buffer the destination buffer
+      @param[in] Size the size of the buffer
+      @return the number of written characters, not counting the terminating null character,
+      or 0 if the buffer is too small
+    */
+    std::size_t format(const DateTime& DT, char* Buffer, std::size_t Size) const;
+
+    /**
+      Formats a date-time into a string, reusing the string storage
+      @param[in] DT the date-time to format
+      @param[out] Str the formatted date-time
+    */
+    void format(const DateTime& DT, std::string& Str) const;
+
+    /**
+      Formats a date-time
+      @param[in] DT the date-time to format
+      @return the formatted date-time
+    */
+    std::string format(const DateTime& DT) const;
+
+    /**
+      Returns the ISO format (%Y-%m-%d %H:%M:%S) used by DateTime
+    */
+    static const DateTimeFormat& isoFormat();
+
+    /**
+      Returns the ISO 8601 format (%Y-%m-%dT%H:%M:%S)
+    */
+    static const DateTimeFormat& iso8601Format();
+
+    /**
+      Returns the compact format (%Y%m%dT%H%M%S) used by default in observers and generators
+    */
+    static const DateTimeFormat& compactFormat();
+
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_CORE_DATETIMEFORMAT_HPP__ */
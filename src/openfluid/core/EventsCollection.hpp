@@ -113,6 +113,14 @@ class OPENFLUID_API EventsCollection
       return &m_Events;
     };
 
+    /**
+      Returns the event collection as a read-only list
+    */
+    inline const EventsList_t* eventsList() const
+    {
+      return &m_Events;
+    };
+
     /**
       @deprecated Since version 2.1.0. Use openfluid::core::EventsCollection::eventsList() instead
     */
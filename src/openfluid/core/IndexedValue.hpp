@@ -97,6 +97,12 @@ class IndexedValue
     IndexedValue(const TimeIndex_t& Ind, const Value& Val) : m_Index(Ind),m_Value(Val.clone())
     { }
 
+    /**
+      Constructor from a time index and a value, taking ownership of the value without copy
+    */
+    IndexedValue(const TimeIndex_t& Ind, std::unique_ptr<Value>&& Val) : m_Index(Ind),m_Value(std::move(Val))
+    { }
+
     IndexedValue& operator=(IndexedValue&& Other)
     {
       if (this != &Other)
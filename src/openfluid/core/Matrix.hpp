@@ -45,6 +45,8 @@
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/core/Vector.hpp>
+#include <openfluid/core/ArrayKernels.hpp>
 
 
 namespace openfluid { namespace core {
@@ -81,6 +83,11 @@ class OPENFLUID_API Matrix
      */
     Matrix(const Matrix& Other);
 
+    /**
+      Move constructor, takes the data of the other Matrix which is left empty
+    */
+    Matrix(Matrix&& Other) noexcept;
+
     /**
       Constructor, creates a Matrix containing Size elements
     */
@@ -97,9 +104,9 @@ class OPENFLUID_API Matrix
     Matrix<T>& operator=(const Matrix& Other);
 
     /**
-      Move assignment operator
+      Move assignment operator, takes the data of the other Matrix which is left empty
     */
-    Matrix<T>& operator=(Matrix&& Other);
+    Matrix<T>& operator=(Matrix&& Other) noexcept;
 
     /**
       Destructor
@@ -198,6 +205,49 @@ class OPENFLUID_API Matrix
     */
     void clear();
 
+    /**
+      Adds element-wise the elements of another Matrix of the same dimensions
+    */
+    Matrix<T>& operator+=(const Matrix& Other);
+
+    /**
+      Subtracts element-wise the elements of another Matrix of the same dimensions
+    */
+    Matrix<T>& operator-=(const Matrix& Other);
+
+    /**
+      Multiplies all elements by the given factor
+    */
+    Matrix<T>& operator*=(const T& Factor);
+
+    /**
+      Clamps all elements between Low and High values
+    */
+    void clamp(const T& Low, const T& High);
+
+    /**
+      Returns the sum of the elements
+    */
+    T sum() const;
+
+    /**
+      Returns the minimum element of the Matrix, which must not be empty
+    */
+    T minElement() const;
+
+    /**
+      Returns the maximum element of the Matrix, which must not be empty
+    */
+    T maxElement() const;
+
+    /**
+      Computes the product of the Matrix by the vector X (Y = this * X).
+      X must have as many elements as the number of columns, Y is resized to the number of rows if needed
+      @param[in] X the multiplied vector
+      @param[out] Y the resulting vector
+    */
+    void multiply(const Vector<T>& X, Vector<T>& Y) const;
+
 };
 
 
@@ -235,6 +285,19 @@ Matrix<T>::Matrix(const Matrix& Other)
 // =====================================================================
 
 
+template <class T>
+Matrix<T>::Matrix(Matrix&& Other) noexcept :
+  m_Data(std::move(Other.m_Data)), m_ColsNbr(Other.m_ColsNbr), m_RowsNbr(Other.m_RowsNbr)
+{
+  Other.m_ColsNbr = 0;
+  Other.m_RowsNbr = 0;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 template <class T>
 Matrix<T>::Matrix(unsigned long ColsNbr, unsigned long RowsNbr)
 {
@@ -275,11 +338,15 @@ Matrix<T>& Matrix<T>::operator=(const Matrix& Other)
 
   if (this != &Other)
   {
-    clear();
-
-    if (!allocate(Other.m_ColsNbr,Other.m_RowsNbr))
+    // existing storage is reused when dimensions match
+    if (m_ColsNbr != Other.m_ColsNbr || m_RowsNbr != Other.m_RowsNbr || !m_Data)
     {
-      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Cannot allocate memory");
+      clear();
+
+      if (!allocate(Other.m_ColsNbr,Other.m_RowsNbr))
+      {
+        throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Cannot allocate memory");
+      }
     }
 
     std::copy(Other.m_Data.get(), Other.m_Data.get() + (Other.m_ColsNbr*Other.m_RowsNbr), m_Data.get());
@@ -294,13 +361,11 @@ Matrix<T>& Matrix<T>::operator=(const Matrix& Other)
 
 
 template <class T>
-Matrix<T>& Matrix<T>::operator=(Matrix&& Other)
+Matrix<T>& Matrix<T>::operator=(Matrix&& Other) noexcept
 {
 
   if (this != &Other)
   {
-    clear();
-
     m_ColsNbr = Other.m_ColsNbr;
     m_RowsNbr = Other.m_RowsNbr;
     m_Data = std::move(Other.m_Data);
@@ -424,6 +489,136 @@ void Matrix<T>::clear()
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+Matrix<T>& Matrix<T>::operator+=(const Matrix& Other)
+{
+  if (m_ColsNbr != Other.m_ColsNbr || m_RowsNbr != Other.m_RowsNbr)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"matrices dimensions mismatch");
+  }
+
+  kernels::add(m_Data.get(),Other.m_Data.get(),m_Data.get(),getSize());
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+Matrix<T>& Matrix<T>::operator-=(const Matrix& Other)
+{
+  if (m_ColsNbr != Other.m_ColsNbr || m_RowsNbr != Other.m_RowsNbr)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"matrices dimensions mismatch");
+  }
+
+  kernels::subtract(m_Data.get(),Other.m_Data.get(),m_Data.get(),getSize());
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+Matrix<T>& Matrix<T>::operator*=(const T& Factor)
+{
+  kernels::scale(m_Data.get(),Factor,m_Data.get(),getSize());
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Matrix<T>::clamp(const T& Low, const T& High)
+{
+  kernels::clamp(m_Data.get(),Low,High,m_Data.get(),getSize());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Matrix<T>::sum() const
+{
+  return kernels::sum(m_Data.get(),getSize());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Matrix<T>::minElement() const
+{
+  if (!getSize())
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"matrix is empty");
+  }
+
+  return kernels::minElement(m_Data.get(),getSize());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Matrix<T>::maxElement() const
+{
+  if (!getSize())
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"matrix is empty");
+  }
+
+  return kernels::maxElement(m_Data.get(),getSize());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Matrix<T>::multiply(const Vector<T>& X, Vector<T>& Y) const
+{
+  if (X.size() != m_ColsNbr)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"matrix and vector dimensions mismatch");
+  }
+
+  if (&X == &Y)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "resulting vector must differ from multiplied vector");
+  }
+
+  if (Y.size() != m_RowsNbr)
+  {
+    Y = Vector<T>(m_RowsNbr);
+  }
+
+  kernels::gemv(m_Data.get(),m_ColsNbr,m_RowsNbr,X.data(),Y.data());
+}
+
+
 } }
 
 #endif /* __OPENFLUID_CORE_MATRIX_HPP__ */
@@ -102,8 +102,8 @@ class OPENFLUID_API MatrixValue : public CompoundValue, public Matrix<double>
     /**
       Move constructor
     */
-    MatrixValue(MatrixValue&& Val) : CompoundValue(),
-                                     Matrix<double>(std::move(static_cast<Matrix<double>&&>(Val)))
+    MatrixValue(MatrixValue&& Val) noexcept : CompoundValue(),
+                                              Matrix<double>(static_cast<Matrix<double>&&>(Val))
     { }
 
     /**
@@ -65,6 +65,11 @@ bool SpatialGraph::removeUnitFromList(UnitsPtrList_t* UnitsList,
                                         const UnitID_t& UnitID)
 {
 
+  if (UnitsList == nullptr)
+  {
+    return false;
+  }
+
   UnitsPtrList_t::iterator UnitsIt;
   bool Found = false;
 
@@ -91,13 +96,53 @@ bool SpatialGraph::removeUnitFromList(UnitsPtrList_t* UnitsList,
 // =====================================================================
 
 
+void SpatialGraph::appendToGlobalList(SpatialUnit* aUnit)
+{
+  m_PcsOrderedUnitsGlobal.push_back(aUnit);
+
+  auto it = std::prev(m_PcsOrderedUnitsGlobal.end());
+  m_GlobalIndex[aUnit] = it;
+  m_GlobalPcsOrderIndex.notifyAppended(m_PcsOrderedUnitsGlobal,it);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialGraph::forgetMatrixTopology(const UnitsClass_t& UnitsClass)
+{
+  if (!m_MatricesTopologies.empty())
+  {
+    m_MatricesTopologies.erase(UnitsClass);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialGraph::sortGlobalList()
+{
+  m_PcsOrderedUnitsGlobal.sort(SortUnitsPtrByProcessOrder());
+  m_GlobalPcsOrderIndex.rebuild(m_PcsOrderedUnitsGlobal);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 SpatialUnit* SpatialGraph::addUnit(const SpatialUnit& aUnit)
 {
   SpatialUnit* TheUnit = m_PcsOrderedUnitsByClass[aUnit.getClass()].addSpatialUnit(aUnit);
 
   if (TheUnit != nullptr)
   {
-    m_PcsOrderedUnitsGlobal.push_back(TheUnit);
+    appendToGlobalList(TheUnit);
+    forgetMatrixTopology(aUnit.getClass());
+    m_Revision++;
   }
 
   return TheUnit;
@@ -108,107 +153,170 @@ SpatialUnit* SpatialGraph::addUnit(const SpatialUnit& aUnit)
 // =====================================================================
 
 
-bool SpatialGraph::deleteUnit(SpatialUnit* aUnit)
+SpatialUnit* SpatialGraph::insertUnit(const SpatialUnit& aUnit)
 {
+  if (m_InBatch)
+  {
+    return addUnit(aUnit);
+  }
 
-  std::vector<openfluid::core::UnitsClass_t> ClassVector;
+  SpatialUnit* TheUnit = m_PcsOrderedUnitsByClass[aUnit.getClass()].insertSpatialUnit(aUnit);
 
+  if (TheUnit != nullptr)
+  {
+    if (!m_GlobalPcsOrderIndex.isValid())
+    {
+      sortGlobalList();
+    }
+
+    auto it = m_PcsOrderedUnitsGlobal.insert(
+      m_GlobalPcsOrderIndex.insertionPoint(m_PcsOrderedUnitsGlobal,TheUnit->getProcessOrder()),TheUnit);
+    m_GlobalIndex[TheUnit] = it;
+    m_GlobalPcsOrderIndex.notifyInserted(it);
+    forgetMatrixTopology(aUnit.getClass());
+    m_Revision++;
+  }
+
+  return TheUnit;
+}
+
+
+// =====================================================================
+// =====================================================================
 
-  openfluid::core::UnitsListByClassMap_t::const_iterator itUnitsClass;
 
-  for (itUnitsClass=m_PcsOrderedUnitsByClass.begin();itUnitsClass!=m_PcsOrderedUnitsByClass.end();++itUnitsClass)
+bool SpatialGraph::deleteUnit(SpatialUnit* aUnit)
+{
+  if (aUnit == nullptr)
   {
-    ClassVector.push_back((*itUnitsClass).first);
+    return false;
   }
 
+  // remove all connections, only through the classes the unit is connected with
+
+  const UnitsClass_t& UnitClass = aUnit->getClass();
+  const UnitID_t UnitID = aUnit->getID();
 
-  // remove all connections
+  m_Revision++;
 
-  UnitsPtrList_t* UnitsList;
+  for (const auto& ClassUnits : aUnit->m_FromUnits)
+  {
+    forgetMatrixTopology(ClassUnits.first);
+  }
+  for (const auto& ClassUnits : aUnit->m_ToUnits)
+  {
+    forgetMatrixTopology(ClassUnits.first);
+  }
+  forgetMatrixTopology(UnitClass);
 
-  for (unsigned int i = 0; i < ClassVector.size(); i++)
+  for (auto& ClassUnits : aUnit->m_FromUnits)
   {
-    // from
-    UnitsList = aUnit->fromSpatialUnits(ClassVector[i]);
-    while (UnitsList !=nullptr && !UnitsList->empty())
+    for (auto* FromUnit : ClassUnits.second)
     {
-      removeFromToConnection(UnitsList->front(),aUnit);
+      removeUnitFromList(FromUnit->toSpatialUnits(UnitClass),UnitID);
     }
+  }
+  aUnit->m_FromUnits.clear();
 
-    // to
-    UnitsList = aUnit->toSpatialUnits(ClassVector[i]);
-    while (UnitsList !=nullptr && !UnitsList->empty())
+  for (auto& ClassUnits : aUnit->m_ToUnits)
+  {
+    for (auto* ToUnit : ClassUnits.second)
     {
-      removeFromToConnection(aUnit, UnitsList->front());
+      removeUnitFromList(ToUnit->fromSpatialUnits(UnitClass),UnitID);
     }
+  }
+  aUnit->m_ToUnits.clear();
 
-    // children
-    UnitsList = aUnit->childSpatialUnits(ClassVector[i]);
-    while (UnitsList !=nullptr && !UnitsList->empty())
+  for (auto& ClassUnits : aUnit->m_ChildrenUnits)
+  {
+    for (auto* ChildUnit : ClassUnits.second)
     {
-      removeChildParentConnection(UnitsList->front(),aUnit);
+      removeUnitFromList(ChildUnit->parentSpatialUnits(UnitClass),UnitID);
     }
+  }
+  aUnit->m_ChildrenUnits.clear();
 
-    // parent
-    UnitsList = aUnit->parentSpatialUnits(ClassVector[i]);
-    while (UnitsList !=nullptr && !UnitsList->empty())
+  for (auto& ClassUnits : aUnit->m_ParentUnits)
+  {
+    for (auto* ParentUnit : ClassUnits.second)
     {
-      removeChildParentConnection(aUnit, UnitsList->front());
+      removeUnitFromList(ParentUnit->childSpatialUnits(UnitClass),UnitID);
     }
   }
+  aUnit->m_ParentUnits.clear();
 
 
-  // remove unit pointer from the list global list
+  // remove unit pointer from the global list
 
-  UnitsPtrList_t::iterator UnitsIt;
-  bool Found = false;
+  auto GlobalIt = m_GlobalIndex.find(aUnit);
 
-  UnitsIt = m_PcsOrderedUnitsGlobal.begin();
-  while (!Found && UnitsIt!=m_PcsOrderedUnitsGlobal.end())
+  if (GlobalIt != m_GlobalIndex.end())
   {
-    Found = ((*UnitsIt)->getID() == aUnit->getID() && (*UnitsIt)->getClass() == aUnit->getClass());
-
-    if (Found)
-    {
-      m_PcsOrderedUnitsGlobal.erase(UnitsIt);
-    }
-    else
-    {
-      ++UnitsIt;
-    }
+    m_GlobalPcsOrderIndex.notifyErasing(m_PcsOrderedUnitsGlobal,GlobalIt->second);
+    m_PcsOrderedUnitsGlobal.erase(GlobalIt->second);
+    m_GlobalIndex.erase(GlobalIt);
   }
 
 
   // remove unit object from the "by class" list
 
-  UnitsListByClassMap_t::iterator it;
-  Found = false;
+  UnitsListByClassMap_t::iterator it = m_PcsOrderedUnitsByClass.find(UnitClass);
+
+  return (it != m_PcsOrderedUnitsByClass.end() && it->second.removeSpatialUnit(UnitID));
+}
 
-  it = m_PcsOrderedUnitsByClass.find(aUnit->getClass());
 
-  if (it != m_PcsOrderedUnitsByClass.end())
+// =====================================================================
+// =====================================================================
+
+
+bool SpatialGraph::beginBatch()
+{
+  if (m_InBatch)
   {
-    UnitsList_t* UnitsBase = it->second.list();
-    UnitsList_t::iterator UnitsBaseIt;
+    return false;
+  }
 
-    UnitsBaseIt = UnitsBase->begin();
-    while (!Found && UnitsBaseIt!=UnitsBase->end())
-    {
-      Found = ((*UnitsBaseIt).getID() == aUnit->getID() && (*UnitsBaseIt).getClass() == aUnit->getClass());
-
-      if (Found)
-      {
-        UnitsBase->erase(UnitsBaseIt);
-      }
-      else
-      {
-        ++UnitsBaseIt;
-      }
-    }
+  m_InBatch = true;
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool SpatialGraph::endBatch()
+{
+  if (!m_InBatch)
+  {
+    return false;
   }
 
+  m_InBatch = false;
+  return sortUnitsByProcessOrder();
+}
+
 
-  return Found;
+// =====================================================================
+// =====================================================================
+
+
+bool SpatialGraph::addFromToConnection(SpatialUnit* FromUnit,
+                                       SpatialUnit* ToUnit)
+{
+  if (FromUnit != nullptr && ToUnit != nullptr)
+  {
+    forgetMatrixTopology(FromUnit->getClass());
+    forgetMatrixTopology(ToUnit->getClass());
+    m_Revision++;
+
+    return (FromUnit->addToUnit(ToUnit) && ToUnit->addFromUnit(FromUnit));
+  }
+  else
+  {
+    return false;
+  }
 }
 
 
@@ -221,6 +329,10 @@ bool SpatialGraph::removeFromToConnection(SpatialUnit* FromUnit,
 {
   if (FromUnit != nullptr && ToUnit != nullptr)
   {
+    forgetMatrixTopology(FromUnit->getClass());
+    forgetMatrixTopology(ToUnit->getClass());
+    m_Revision++;
+
     return (removeUnitFromList(FromUnit->toSpatialUnits(ToUnit->getClass()),ToUnit->getID()) &&
             removeUnitFromList(ToUnit->fromSpatialUnits(FromUnit->getClass()),FromUnit->getID()));
   }
@@ -240,6 +352,8 @@ bool SpatialGraph::removeChildParentConnection(SpatialUnit* ChildUnit,
 {
   if (ChildUnit != nullptr && ParentUnit != nullptr)
   {
+    m_Revision++;
+
     return (removeUnitFromList(ChildUnit->parentSpatialUnits(ParentUnit->getClass()),ParentUnit->getID()) &&
             removeUnitFromList(ParentUnit->childSpatialUnits(ChildUnit->getClass()),ChildUnit->getID()));
   }
@@ -254,6 +368,118 @@ bool SpatialGraph::removeChildParentConnection(SpatialUnit* ChildUnit,
 // =====================================================================
 
 
+bool SpatialGraph::addUnitsWithConnections(const UnitsClass_t& UnitsClass,
+                                           const std::vector<std::pair<UnitID_t,PcsOrd_t>>& Units,
+                                           const std::vector<std::pair<UnitID_t,UnitID_t>>& FromToConnections)
+{
+  forgetMatrixTopology(UnitsClass);
+
+  UnitsCollection& Collection = m_PcsOrderedUnitsByClass[UnitsClass];
+  Collection.reserve(Collection.size()+Units.size());
+
+  for (const auto& IDOrder : Units)
+  {
+    SpatialUnit* TheUnit = Collection.addSpatialUnit(SpatialUnit(UnitsClass,IDOrder.first,IDOrder.second));
+
+    if (TheUnit == nullptr)
+    {
+      sortUnitsByProcessOrder();
+      return false;
+    }
+
+    appendToGlobalList(TheUnit);
+    m_Revision++;
+  }
+
+  for (const auto& FromTo : FromToConnections)
+  {
+    SpatialUnit* FromUnit = Collection.spatialUnit(FromTo.first);
+    SpatialUnit* ToUnit = Collection.spatialUnit(FromTo.second);
+
+    if (FromUnit == nullptr || ToUnit == nullptr)
+    {
+      sortUnitsByProcessOrder();
+      return false;
+    }
+
+    FromUnit->addToUnit(ToUnit);
+    ToUnit->addFromUnit(FromUnit);
+  }
+
+  sortUnitsByProcessOrder();
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool SpatialGraph::buildUnitsMatrix(const UnitsClass_t& UnitsClass, unsigned int ColsNbr, unsigned int RowsNbr,
+                                    PcsOrd_t PcsOrder, bool StoreConnections)
+{
+  const UnitsCollection* ExistingUnits = spatialUnits(UnitsClass);
+
+  if (ExistingUnits != nullptr && ExistingUnits->size() != 0)
+  {
+    return false;
+  }
+
+  const UnitsMatrixTopology Topology(ColsNbr,RowsNbr);
+
+  std::vector<std::pair<UnitID_t,PcsOrd_t>> Units;
+  Units.reserve(Topology.getUnitsCount());
+
+  for (UnitID_t ID = 1; ID <= Topology.getUnitsCount(); ID++)
+  {
+    Units.emplace_back(ID,PcsOrder);
+  }
+
+  std::vector<std::pair<UnitID_t,UnitID_t>> Connections;
+
+  if (StoreConnections)
+  {
+    Connections.reserve(4*Topology.getUnitsCount());
+
+    for (UnitID_t ID = 1; ID <= Topology.getUnitsCount(); ID++)
+    {
+      Topology.forEachNeighbour(ID,[&Connections,ID](UnitID_t NeighbourID){ Connections.emplace_back(ID,NeighbourID); });
+    }
+  }
+
+  if (!addUnitsWithConnections(UnitsClass,Units,Connections))
+  {
+    return false;
+  }
+
+  m_MatricesTopologies[UnitsClass] = Topology;
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const UnitsMatrixTopology* SpatialGraph::unitsMatrixTopology(const UnitsClass_t& UnitsClass) const
+{
+  auto it = m_MatricesTopologies.find(UnitsClass);
+
+  if (it != m_MatricesTopologies.end())
+  {
+    return &(it->second);
+  }
+
+  return nullptr;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 bool SpatialGraph::isUnitsClassExist(const UnitsClass_t& UnitsClass) const
 {
   return m_PcsOrderedUnitsByClass.find(UnitsClass) != m_PcsOrderedUnitsByClass.end();
@@ -355,7 +581,7 @@ bool SpatialGraph::sortUnitsByProcessOrder()
   }
 
   // sort global units structure
-  m_PcsOrderedUnitsGlobal.sort(SortUnitsPtrByProcessOrder());
+  sortGlobalList();
 
   return true;
 }
@@ -403,6 +629,8 @@ void SpatialGraph::streamContents(std::ostream& OStream)
 
 void SpatialGraph::clearAllVariables()
 {
+  m_Revision++;
+
   for (openfluid::core::SpatialUnit* CurrentUnit : m_PcsOrderedUnitsGlobal)
   {
     CurrentUnit->variables()->clear();
@@ -442,6 +670,8 @@ void SpatialGraph::clearAllEvents()
 
 void SpatialGraph::clearAllData()
 {
+  m_Revision++;
+
   for (openfluid::core::SpatialUnit* CurrentUnit : m_PcsOrderedUnitsGlobal)
   {
     CurrentUnit->variables()->clear();
@@ -463,6 +693,8 @@ void SpatialGraph::clearUnits()
   {
     deleteUnit(*(UnitPtrIt++));
   }
+
+  m_MatricesTopologies.clear();
 }
 
 
@@ -39,7 +39,14 @@
 #define __OPENFLUID_CORE_SPATIALGRAPH_HPP__
 
 
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
 #include <openfluid/core/SpatialUnit.hpp>
+#include <openfluid/core/UnitsMatrixTopology.hpp>
+#include <openfluid/core/UnitsPcsOrderIndex.hpp>
 #include <openfluid/dllexport.hpp>
 
 
@@ -57,23 +64,129 @@ class OPENFLUID_API SpatialGraph
 
     UnitsPtrList_t m_PcsOrderedUnitsGlobal;
 
+    std::unordered_map<const SpatialUnit*,UnitsPtrList_t::iterator> m_GlobalIndex;
+
+    UnitsPcsOrderIndex<UnitsPtrList_t> m_GlobalPcsOrderIndex;
+
+    std::map<UnitsClass_t,UnitsMatrixTopology> m_MatricesTopologies;
+
+    bool m_InBatch = false;
+
+    std::uint64_t m_Revision = 0;
+
     static bool removeUnitFromList(UnitsPtrList_t* UnitsList,
                                    const UnitID_t& UnitID);
 
+    void appendToGlobalList(SpatialUnit* aUnit);
+
+    void forgetMatrixTopology(const UnitsClass_t& UnitsClass);
+
+    void sortGlobalList();
+
   public:
 
     SpatialGraph() = default;
 
+    /**
+      Adds a unit at the end of its class and of the global units list.
+      The spatial graph must be sorted afterwards using sortUnitsByProcessOrder().
+      @param[in] aUnit the unit to add
+      @return a pointer to the added unit, nullptr if the unit already exists
+    */
     SpatialUnit* addUnit(const SpatialUnit& aUnit);
 
+    /**
+      Inserts a unit at its process order position in its class and in the global units list,
+      keeping the spatial graph sorted without a full sort.
+      During a batch of changes, the unit is added at the end and the graph is sorted at the end of the batch.
+      @param[in] aUnit the unit to insert
+      @return a pointer to the inserted unit, nullptr if the unit already exists
+    */
+    SpatialUnit* insertUnit(const SpatialUnit& aUnit);
+
+    /**
+      Deletes a unit and all its connections. The cost depends on the connections of the unit
+      and not on the size of the spatial graph. The order of the remaining units is preserved.
+      @param[in] aUnit the unit to delete
+      @return false if the unit was not found
+    */
     bool deleteUnit(SpatialUnit* aUnit);
 
+    /**
+      Begins a batch of changes on the spatial graph. During the batch, inserted units are not placed
+      at their process order position, the spatial graph is sorted once when the batch ends.
+      @return false if a batch is already in progress
+    */
+    bool beginBatch();
+
+    /**
+      Ends the batch of changes and sorts the spatial graph by process order
+      @return false if no batch is in progress
+    */
+    bool endBatch();
+
+    inline bool isInBatch() const
+    {
+      return m_InBatch;
+    }
+
+    /**
+      Returns the revision of the spatial graph, incremented each time spatial units or connections
+      are added or deleted and each time the variables of all units are cleared.
+      It allows to detect changes of the spatial graph since a previous state.
+    */
+    inline std::uint64_t getRevision() const
+    {
+      return m_Revision;
+    }
+
+    bool addFromToConnection(SpatialUnit* FromUnit,
+                             SpatialUnit* ToUnit);
+
     bool removeFromToConnection(SpatialUnit* FromUnit,
                                 SpatialUnit* ToUnit);
 
     bool removeChildParentConnection(SpatialUnit* ChildUnit,
                                      SpatialUnit* ParentUnit);
 
+    /**
+      Adds a set of units of the same class and the given from-to connections between them,
+      then sorts the spatial graph only once.
+      Connections may involve units already existing in the class.
+      @param[in] UnitsClass the class of the units
+      @param[in] Units the IDs and process orders of the units to add
+      @param[in] FromToConnections the from-to connections as pairs of (from ID, to ID)
+      @return false if a unit already exists or if a connection involves a non-existing unit.
+      In this case, the spatial graph is left partially built.
+    */
+    bool addUnitsWithConnections(const UnitsClass_t& UnitsClass,
+                                 const std::vector<std::pair<UnitID_t,PcsOrd_t>>& Units,
+                                 const std::vector<std::pair<UnitID_t,UnitID_t>>& FromToConnections);
+
+    /**
+      Builds a ColsNbr x RowsNbr matrix of units, numbered row by row starting at 1,
+      then sorts the spatial graph only once. The topology of the matrix is kept and can be queried
+      using unitsMatrixTopology().
+      @param[in] UnitsClass the class of the units
+      @param[in] ColsNbr the number of units on the X axis
+      @param[in] RowsNbr the number of units on the Y axis
+      @param[in] PcsOrder the process order of all units
+      @param[in] StoreConnections if true, bi-directional from-to connections are stored between neighbours
+      (same as addUnitsWithConnections()). If false, no connection is stored and neighbours
+      must be computed from the topology, which greatly reduces memory use and building time for large matrices
+      @return false if the class already contains units
+    */
+    bool buildUnitsMatrix(const UnitsClass_t& UnitsClass, unsigned int ColsNbr, unsigned int RowsNbr,
+                          PcsOrd_t PcsOrder = 1, bool StoreConnections = true);
+
+    /**
+      Returns the topology of a units class built as a matrix.
+      The topology is discarded as soon as units or from-to connections of the class are added or removed.
+      @param[in] UnitsClass the class of the units
+      @return a pointer to the topology, nullptr if the class was not built as a matrix or was modified since
+    */
+    const UnitsMatrixTopology* unitsMatrixTopology(const UnitsClass_t& UnitsClass) const;
+
     bool sortUnitsByProcessOrder();
 
     SpatialUnit* spatialUnit(const UnitsClass_t& UnitsClass, UnitID_t UnitID);
@@ -47,7 +47,7 @@ namespace openfluid { namespace core {
 
 SpatialUnit::SpatialUnit(const UnitsClass_t& aClass, const UnitID_t anID,
                          const PcsOrd_t aPcsOrder) :
-  m_ID(anID), m_Class(aClass), m_PcsOrder(aPcsOrder), m_Geometry(nullptr)
+  m_ID(anID), m_Class(aClass), m_ClassSymbol(SymbolsTable::intern(aClass)), m_PcsOrder(aPcsOrder), m_Geometry(nullptr)
 {
 
 }
@@ -115,7 +115,7 @@ bool SpatialUnit::addChildUnit(SpatialUnit* aUnit)
 
 const UnitsPtrList_t* SpatialUnit::toSpatialUnits(const UnitsClass_t& aClass) const
 {
-  return const_cast<UnitsPtrList_t*>(toSpatialUnits(aClass));
+  return const_cast<SpatialUnit*>(this)->toSpatialUnits(aClass);
 
 }
 
@@ -126,7 +126,7 @@ const UnitsPtrList_t* SpatialUnit::toSpatialUnits(const UnitsClass_t& aClass) co
 
 const UnitsPtrList_t* SpatialUnit::childSpatialUnits(const UnitsClass_t& aClass) const
 {
-  return const_cast<UnitsPtrList_t*>(childSpatialUnits(aClass));
+  return const_cast<SpatialUnit*>(this)->childSpatialUnits(aClass);
 }
 
 
@@ -136,7 +136,7 @@ const UnitsPtrList_t* SpatialUnit::childSpatialUnits(const UnitsClass_t& aClass)
 
 const UnitsPtrList_t* SpatialUnit::parentSpatialUnits(const UnitsClass_t& aClass) const
 {
-  return const_cast<UnitsPtrList_t*>(parentSpatialUnits(aClass));
+  return const_cast<SpatialUnit*>(this)->parentSpatialUnits(aClass);
 
 }
 
@@ -147,7 +147,7 @@ const UnitsPtrList_t* SpatialUnit::parentSpatialUnits(const UnitsClass_t& aClass
 
 const UnitsPtrList_t* SpatialUnit::fromSpatialUnits(const UnitsClass_t& aClass) const
 {
-  return const_cast<UnitsPtrList_t*>(fromSpatialUnits(aClass));
+  return const_cast<SpatialUnit*>(this)->fromSpatialUnits(aClass);
 }
 
 
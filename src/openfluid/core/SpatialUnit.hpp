@@ -107,14 +107,21 @@ typedef std::map<UnitsClass_t,UnitsPtrList_t> LinkedUnitsListByClassMap_t;
   }
   @endcond
 */
+class SpatialGraph;
+
+
 class OPENFLUID_API SpatialUnit
 {
+  friend class SpatialGraph;
+
   private:
 
     UnitID_t m_ID;
 
     UnitsClass_t m_Class;
 
+    SymbolID_t m_ClassSymbol;
+
     openfluid::core::PcsOrd_t m_PcsOrder;
 
     LinkedUnitsListByClassMap_t m_FromUnits;
@@ -170,11 +177,20 @@ class OPENFLUID_API SpatialUnit
     /**
       Returns the class of the unit
     */
-    inline UnitsClass_t getClass() const
+    inline const UnitsClass_t& getClass() const
     {
       return m_Class;
     };
 
+    /**
+      Returns the interned identifier of the class of the unit
+      @see openfluid::core::SymbolsTable
+    */
+    inline SymbolID_t getClassSymbol() const
+    {
+      return m_ClassSymbol;
+    };
+
     bool addToUnit(SpatialUnit* aUnit);
 
     bool addFromUnit(SpatialUnit* aUnit);
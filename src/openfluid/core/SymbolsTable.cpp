@@ -0,0 +1,360 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SymbolsTable.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <string_view>
+
+#include <openfluid/core/SymbolsTable.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+namespace {
+
+
+// Names are stored in chunks of growing sizes which are never moved nor released,
+// so that names of interned symbols can be read without locking.
+// Chunk k stores 2^(k+FirstChunkBits) names.
+constexpr unsigned int FirstChunkBits = 6;
+
+constexpr unsigned int MaxChunksCount = 28;
+
+constexpr std::size_t InitialIndexCapacity = 256;
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Open-addressing index of names, each slot stores the upper bits of the name hash
+  and the identifier of the symbol plus one (0 for an empty slot)
+*/
+struct SymbolsIndex
+{
+  const std::size_t Capacity;
+
+  std::unique_ptr<std::atomic<std::uint64_t>[]> Slots;
+
+  explicit SymbolsIndex(std::size_t Cap) :
+    Capacity(Cap), Slots(new std::atomic<std::uint64_t>[Cap])
+  {
+    for (std::size_t i=0; i<Capacity; i++)
+    {
+      Slots[i].store(0,std::memory_order_relaxed);
+    }
+  }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+struct SymbolsStorage
+{
+  std::atomic<std::string*> Chunks[MaxChunksCount];
+
+  std::atomic<std::size_t> Count;
+
+  std::atomic<SymbolsIndex*> Index;
+
+  // indexes replaced when growing are kept since concurrent lookups may still use them
+  std::vector<std::unique_ptr<SymbolsIndex>> Indexes;
+
+  // serializes interning of new names only, lookups of known names do not lock
+  std::mutex InternMutex;
+
+
+  SymbolsStorage() : Count(0)
+  {
+    for (auto& Chunk : Chunks)
+    {
+      Chunk.store(nullptr,std::memory_order_relaxed);
+    }
+
+    Indexes.emplace_back(new SymbolsIndex(InitialIndexCapacity));
+    Index.store(Indexes.back().get(),std::memory_order_release);
+  }
+
+
+  ~SymbolsStorage()
+  {
+    for (auto& Chunk : Chunks)
+    {
+      delete[] Chunk.load(std::memory_order_relaxed);
+    }
+  }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+SymbolsStorage& storage()
+{
+  static SymbolsStorage Storage;
+  return Storage;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void locateName(SymbolID_t ID, unsigned int& Chunk, std::size_t& Offset)
+{
+  const std::uint64_t Pos = std::uint64_t(ID) + (std::uint64_t(1) << FirstChunkBits);
+
+  unsigned int HighBit = FirstChunkBits;
+  while (Pos >> (HighBit+1))
+  {
+    HighBit++;
+  }
+
+  Chunk = HighBit-FirstChunkBits;
+  Offset = Pos-(std::uint64_t(1) << HighBit);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const std::string& nameAt(const SymbolsStorage& Storage, SymbolID_t ID)
+{
+  unsigned int Chunk;
+  std::size_t Offset;
+
+  locateName(ID,Chunk,Offset);
+
+  return Storage.Chunks[Chunk].load(std::memory_order_acquire)[Offset];
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::uint64_t hashName(std::string_view Name)
+{
+  return std::hash<std::string_view>()(Name);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::uint64_t slotValue(std::uint64_t Hash, SymbolID_t ID)
+{
+  return (Hash & 0xFFFFFFFF00000000ULL) | (std::uint64_t(ID)+1);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+SymbolID_t lookup(const SymbolsStorage& Storage, const SymbolsIndex& Index, std::string_view Name,
+                  std::uint64_t Hash)
+{
+  const std::size_t Mask = Index.Capacity-1;
+
+  for (std::size_t i = Hash & Mask;; i = (i+1) & Mask)
+  {
+    const std::uint64_t Slot = Index.Slots[i].load(std::memory_order_acquire);
+
+    if (!Slot)
+    {
+      return SymbolsTable::InvalidSymbol;
+    }
+
+    if ((Slot & 0xFFFFFFFF00000000ULL) == (Hash & 0xFFFFFFFF00000000ULL))
+    {
+      const SymbolID_t ID = static_cast<SymbolID_t>((Slot & 0xFFFFFFFFULL)-1);
+
+      if (nameAt(Storage,ID) == Name)
+      {
+        return ID;
+      }
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void insert(SymbolsIndex& Index, std::uint64_t Hash, SymbolID_t ID)
+{
+  const std::size_t Mask = Index.Capacity-1;
+
+  std::size_t i = Hash & Mask;
+  while (Index.Slots[i].load(std::memory_order_relaxed))
+  {
+    i = (i+1) & Mask;
+  }
+
+  Index.Slots[i].store(slotValue(Hash,ID),std::memory_order_release);
+}
+
+
+}  // namespace
+
+
+// =====================================================================
+// =====================================================================
+
+
+SymbolID_t SymbolsTable::intern(const std::string& Name)
+{
+  SymbolsStorage& Storage = storage();
+  const std::uint64_t Hash = hashName(Name);
+
+  SymbolID_t ID = lookup(Storage,*Storage.Index.load(std::memory_order_acquire),Name,Hash);
+  if (ID != InvalidSymbol)
+  {
+    return ID;
+  }
+
+  std::lock_guard<std::mutex> Lock(Storage.InternMutex);
+
+  // the name may have been interned by another thread, the current index is up to date under the lock
+  SymbolsIndex* Index = Storage.Index.load(std::memory_order_relaxed);
+  ID = lookup(Storage,*Index,Name,Hash);
+  if (ID != InvalidSymbol)
+  {
+    return ID;
+  }
+
+  const std::size_t Count = Storage.Count.load(std::memory_order_relaxed);
+
+  if (Count >= InvalidSymbol)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Symbols table is full");
+  }
+
+  ID = static_cast<SymbolID_t>(Count);
+
+  // the name is stored before being published through the count and the index
+  unsigned int Chunk;
+  std::size_t Offset;
+  locateName(ID,Chunk,Offset);
+
+  std::string* ChunkNames = Storage.Chunks[Chunk].load(std::memory_order_relaxed);
+  if (!ChunkNames)
+  {
+    ChunkNames = new std::string[std::size_t(1) << (Chunk+FirstChunkBits)];
+    Storage.Chunks[Chunk].store(ChunkNames,std::memory_order_release);
+  }
+  ChunkNames[Offset] = Name;
+
+  Storage.Count.store(Count+1,std::memory_order_release);
+
+  // the index is kept at most half full, a larger index is built and published when needed
+  if ((Count+1)*2 > Index->Capacity)
+  {
+    Storage.Indexes.emplace_back(new SymbolsIndex(Index->Capacity*2));
+    Index = Storage.Indexes.back().get();
+
+    for (SymbolID_t i=0; i<ID; i++)
+    {
+      insert(*Index,hashName(nameAt(Storage,i)),i);
+    }
+    insert(*Index,Hash,ID);
+
+    Storage.Index.store(Index,std::memory_order_release);
+  }
+  else
+  {
+    insert(*Index,Hash,ID);
+  }
+
+  return ID;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+SymbolID_t SymbolsTable::find(const std::string& Name)
+{
+  const SymbolsStorage& Storage = storage();
+
+  return lookup(Storage,*Storage.Index.load(std::memory_order_acquire),Name,hashName(Name));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const std::string& SymbolsTable::name(SymbolID_t ID)
+{
+  const SymbolsStorage& Storage = storage();
+
+  if (ID >= Storage.Count.load(std::memory_order_acquire))
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Unknown symbol "+std::to_string(ID));
+  }
+
+  return nameAt(Storage,ID);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::size_t SymbolsTable::size()
+{
+  return storage().Count.load(std::memory_order_acquire);
+}
+
+
+} } // namespaces
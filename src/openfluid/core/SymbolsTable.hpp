@@ -0,0 +1,104 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SymbolsTable.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_SYMBOLSTABLE_HPP__
+#define __OPENFLUID_CORE_SYMBOLSTABLE_HPP__
+
+
+#include <string>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/TypeDefs.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+/**
+  Process-wide table of interned names, shared by units classes, variables names and attributes names.
+  Each distinct name is given a unique and stable integer identifier, which can be used to access
+  spatial units data without hashing or comparing strings.
+  Identifiers are never released nor reused during the process lifetime.
+  All methods are thread-safe. Looking up names and identifiers of already interned symbols does not lock,
+  only the interning of new names is serialized.
+*/
+class OPENFLUID_API SymbolsTable
+{
+  public:
+
+    /**
+      Value returned by find() methods when the name has never been interned
+    */
+    static constexpr SymbolID_t InvalidSymbol = static_cast<SymbolID_t>(-1);
+
+    SymbolsTable() = delete;
+
+    /**
+      Returns the identifier of the given name, interning the name if it is not already known
+      @param[in] Name the name to intern
+      @return the identifier of the name
+    */
+    static SymbolID_t intern(const std::string& Name);
+
+    /**
+      Returns the identifier of the given name without interning it
+      @param[in] Name the name to look for
+      @return the identifier of the name, or InvalidSymbol if the name has never been interned
+    */
+    static SymbolID_t find(const std::string& Name);
+
+    /**
+      Returns the name corresponding to the given identifier.
+      The returned reference remains valid during the whole process lifetime.
+      @param[in] ID the identifier
+      @throw openfluid::base::FrameworkException if the identifier is unknown
+    */
+    static const std::string& name(SymbolID_t ID);
+
+    /**
+      Returns the number of interned names
+    */
+    static std::size_t size();
+
+};
+
+
+} } // namespaces
+
+
+#endif /* __OPENFLUID_CORE_SYMBOLSTABLE_HPP__ */
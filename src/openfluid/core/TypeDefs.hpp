@@ -130,6 +130,12 @@ typedef std::string AttributeName_t;
 */
 typedef std::string VariableName_t;
 
+/**
+  Type definition for the interned identifier of a units class, a variable name or an attribute name
+  @see openfluid::core::SymbolsTable
+*/
+typedef std::uint32_t SymbolID_t;
+
 /**
   Type definition for a pair containing the unit class and the unit ID
 */
@@ -60,16 +60,77 @@ struct SortByProcessOrder
 // =====================================================================
 
 
+UnitsCollection::UnitsCollection(const UnitsCollection& Other) :
+  m_Data(Other.m_Data)
+{
+  rebuildIndex();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+UnitsCollection& UnitsCollection::operator=(const UnitsCollection& Other)
+{
+  if (this != &Other)
+  {
+    m_Data = Other.m_Data;
+    rebuildIndex();
+  }
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void UnitsCollection::rebuildIndex()
+{
+  m_Index.clear();
+  m_Index.reserve(m_Data.size());
+
+  // copied units do not share the attributes table of the source collection
+  mp_AttributesTable.reset();
+
+  for (auto it=m_Data.begin();it!=m_Data.end();++it)
+  {
+    m_Index[it->getID()] = it;
+    bindAttributes(*it);
+  }
+
+  m_PcsOrderIndex.invalidate();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void UnitsCollection::bindAttributes(SpatialUnit& aUnit)
+{
+  if (!mp_AttributesTable)
+  {
+    mp_AttributesTable = std::make_shared<AttributesTable>();
+  }
+
+  aUnit.attributes()->bindTable(mp_AttributesTable);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 SpatialUnit* UnitsCollection::spatialUnit(UnitID_t aUnitID)
 {
-  UnitsList_t::iterator it;
+  auto it = m_Index.find(aUnitID);
 
-  for (it=m_Data.begin();it!=m_Data.end();++it)
+  if (it != m_Index.end())
   {
-    if (it->getID() == aUnitID)
-    {
-      return &(*it);
-    }
+    return &(*(it->second));
   }
 
   return nullptr;
@@ -82,14 +143,11 @@ SpatialUnit* UnitsCollection::spatialUnit(UnitID_t aUnitID)
 
 const SpatialUnit* UnitsCollection::spatialUnit(UnitID_t aUnitID) const
 {
-  UnitsList_t::const_iterator it;
+  auto it = m_Index.find(aUnitID);
 
-  for (it=m_Data.begin();it!=m_Data.end();++it)
+  if (it != m_Index.end())
   {
-    if (it->getID() == aUnitID)
-    {
-      return &(*it);
-    }
+    return &(*(it->second));
   }
 
   return nullptr;
@@ -102,10 +160,14 @@ const SpatialUnit* UnitsCollection::spatialUnit(UnitID_t aUnitID) const
 
 SpatialUnit* UnitsCollection::addSpatialUnit(const SpatialUnit& aUnit)
 {
-  if (spatialUnit(aUnit.getID()) == nullptr)
+  if (m_Index.find(aUnit.getID()) == m_Index.end())
   {
     m_Data.push_back(aUnit);
-    return &(m_Data.back());
+    auto it = std::prev(m_Data.end());
+    m_Index[aUnit.getID()] = it;
+    bindAttributes(*it);
+    m_PcsOrderIndex.notifyAppended(m_Data,it);
+    return &(*it);
   }
   else
   {
@@ -118,9 +180,91 @@ SpatialUnit* UnitsCollection::addSpatialUnit(const SpatialUnit& aUnit)
 // =====================================================================
 
 
+SpatialUnit* UnitsCollection::insertSpatialUnit(const SpatialUnit& aUnit)
+{
+  if (m_Index.find(aUnit.getID()) != m_Index.end())
+  {
+    return nullptr;
+  }
+
+  if (!m_PcsOrderIndex.isValid())
+  {
+    sortByProcessOrder();
+  }
+
+  auto it = m_Data.insert(m_PcsOrderIndex.insertionPoint(m_Data,aUnit.getProcessOrder()),aUnit);
+  m_Index[aUnit.getID()] = it;
+  bindAttributes(*it);
+  m_PcsOrderIndex.notifyInserted(it);
+
+  return &(*it);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool UnitsCollection::removeSpatialUnit(UnitID_t aUnitID)
+{
+  auto IndexIt = m_Index.find(aUnitID);
+
+  if (IndexIt == m_Index.end())
+  {
+    return false;
+  }
+
+  m_PcsOrderIndex.notifyErasing(m_Data,IndexIt->second);
+  m_Data.erase(IndexIt->second);
+  m_Index.erase(IndexIt);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void UnitsCollection::reserve(std::size_t UnitsCount)
+{
+  m_Index.reserve(UnitsCount);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void UnitsCollection::sortByProcessOrder()
 {
   m_Data.sort(SortByProcessOrder());
+  m_PcsOrderIndex.rebuild(m_Data);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool UnitsCollection::getAttributeColumn(const AttributeName_t& aName, std::vector<double>& Values) const
+{
+  Values.clear();
+
+  if (!mp_AttributesTable)
+  {
+    return true;
+  }
+
+  std::vector<std::size_t> Rows;
+  Rows.reserve(m_Data.size());
+
+  for (const auto& Unit : m_Data)
+  {
+    Rows.push_back(Unit.attributes()->m_Row);
+  }
+
+  return mp_AttributesTable->getColumnValues(SymbolsTable::find(aName),Rows,Values);
 }
 
 
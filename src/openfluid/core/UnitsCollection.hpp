@@ -41,8 +41,13 @@
 #define __OPENFLUID_CORE_UNITSCOLLECTION_HPP__
 
 
+#include <unordered_map>
+#include <memory>
+
 #include <openfluid/dllexport.hpp>
 #include <openfluid/core/TypeDefs.hpp>
+#include <openfluid/core/UnitsPcsOrderIndex.hpp>
+#include <openfluid/core/AttributesTable.hpp>
 
 
 namespace openfluid { namespace core {
@@ -62,22 +67,103 @@ class OPENFLUID_API UnitsCollection
 
     UnitsList_t m_Data;
 
+    /**
+      Index of units by ID, pointing to the elements of m_Data.
+      Iterators of a std::list are never invalidated by sorting, so the index remains valid after sorting.
+    */
+    std::unordered_map<UnitID_t,UnitsList_t::iterator> m_Index;
+
+    UnitsPcsOrderIndex<UnitsList_t> m_PcsOrderIndex;
+
+    /**
+      Columnar storage of the attributes of the units of the collection
+    */
+    std::shared_ptr<AttributesTable> mp_AttributesTable;
+
+    void bindAttributes(SpatialUnit& aUnit);
+
+    void rebuildIndex();
+
 
   public :
 
+    UnitsCollection() = default;
+
+    UnitsCollection(const UnitsCollection& Other);
+
+    UnitsCollection(UnitsCollection&& Other) = default;
+
+    UnitsCollection& operator=(const UnitsCollection& Other);
+
+    UnitsCollection& operator=(UnitsCollection&& Other) = default;
+
     SpatialUnit* spatialUnit(UnitID_t aUnitID);
 
     const SpatialUnit* spatialUnit(UnitID_t aUnitID) const;
 
+    /**
+      Adds a unit at the end of the collection. The collection must be sorted afterwards
+      using sortByProcessOrder() if the unit breaks the process order.
+      @param[in] aUnit the unit to add
+      @return a pointer to the added unit, nullptr if a unit with the same ID already exists
+    */
     SpatialUnit* addSpatialUnit(const SpatialUnit& aUnit);
 
+    /**
+      Inserts a unit at its position according to its process order, without sorting the whole collection.
+      The unit is placed after the existing units of the same process order.
+      @param[in] aUnit the unit to insert
+      @return a pointer to the inserted unit, nullptr if a unit with the same ID already exists
+    */
+    SpatialUnit* insertSpatialUnit(const SpatialUnit& aUnit);
+
+    /**
+      Removes the unit with the given ID from the collection
+      @param[in] aUnitID the ID of the unit to remove
+      @return true if the unit was found and removed
+    */
+    bool removeSpatialUnit(UnitID_t aUnitID);
+
+    /**
+      Reserves storage for the given number of units, used before bulk additions
+      @param[in] UnitsCount the expected number of units in the collection
+    */
+    void reserve(std::size_t UnitsCount);
+
     void sortByProcessOrder();
 
+    /**
+      Returns the columnar storage of the attributes of the units of the collection,
+      nullptr if no unit was added to the collection
+    */
+    inline const AttributesTable* attributesTable() const
+    {
+      return mp_AttributesTable.get();
+    }
+
+    /**
+      Gets the values of an attribute for all units of the collection, in the order of the units list
+      @param[in] aName the name of the attribute
+      @param[out] Values the values of the attribute, as doubles
+      @return false if the attribute does not exist on all units or if a value is not a double or an integer value
+    */
+    bool getAttributeColumn(const AttributeName_t& aName, std::vector<double>& Values) const;
+
+    inline std::size_t size() const
+    {
+      return m_Data.size();
+    }
+
     inline const UnitsList_t* list() const
     {
       return &m_Data;
     };
 
+    /**
+      Gives a mutable access to the units list.
+      Units must not be added, removed or reordered through this list,
+      use addSpatialUnit(), insertSpatialUnit(), removeSpatialUnit() and sortByProcessOrder() instead
+    */
     inline UnitsList_t* list()
     {
       return &m_Data;
@@ -0,0 +1,188 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file UnitsMatrixTopology.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_UNITSMATRIXTOPOLOGY_HPP__
+#define __OPENFLUID_CORE_UNITSMATRIXTOPOLOGY_HPP__
+
+
+#include <vector>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/TypeDefs.hpp>
+
+
+namespace openfluid { namespace core {
+
+/**
+  Topology of a regular matrix of spatial units, where units are numbered row by row starting at 1.
+  Neighbours of a unit are computed from its position in the matrix, in the following order:
+  left, right, up, down (up being the previous row).
+
+  @cond OpenFLUID:completion
+  {
+    "contexts" : ["ANYWARE"],
+    "menupath" : ["Types", "Spatial domain"],
+    "title" : "Topology of a matrix of spatial units",
+    "text" : "openfluid::core::UnitsMatrixTopology %%SEL_START%%Topology%%SEL_END%%"
+  }
+  @endcond
+*/
+class OPENFLUID_API UnitsMatrixTopology
+{
+  private:
+
+    unsigned int m_ColsNbr = 0;
+
+    unsigned int m_RowsNbr = 0;
+
+
+  public:
+
+    UnitsMatrixTopology() = default;
+
+    UnitsMatrixTopology(unsigned int ColsNbr, unsigned int RowsNbr) :
+      m_ColsNbr(ColsNbr), m_RowsNbr(RowsNbr)
+    { }
+
+    inline unsigned int getColsNbr() const
+    {
+      return m_ColsNbr;
+    }
+
+    inline unsigned int getRowsNbr() const
+    {
+      return m_RowsNbr;
+    }
+
+    inline unsigned long getUnitsCount() const
+    {
+      return static_cast<unsigned long>(m_ColsNbr)*m_RowsNbr;
+    }
+
+    /**
+      Returns true if the given ID belongs to the matrix
+    */
+    inline bool isInMatrix(UnitID_t ID) const
+    {
+      return (ID >= 1 && ID <= getUnitsCount());
+    }
+
+    /**
+      Returns the ID of the unit at the given position
+      @param[in] Col the column index, starting at 0
+      @param[in] Row the row index, starting at 0
+    */
+    inline UnitID_t getUnitID(unsigned int Col, unsigned int Row) const
+    {
+      return 1+(static_cast<UnitID_t>(m_ColsNbr)*Row)+Col;
+    }
+
+    /**
+      Gets the position of the unit with the given ID
+      @param[in] ID the ID of the unit
+      @param[out] Col the column index, starting at 0
+      @param[out] Row the row index, starting at 0
+      @return false if the ID does not belong to the matrix
+    */
+    inline bool getPosition(UnitID_t ID, unsigned int& Col, unsigned int& Row) const
+    {
+      if (!isInMatrix(ID))
+      {
+        return false;
+      }
+
+      Col = (ID-1) % m_ColsNbr;
+      Row = (ID-1) / m_ColsNbr;
+      return true;
+    }
+
+    /**
+      Calls the given function for each neighbour of the unit with the given ID, without any allocation.
+      The function receives the ID of the neighbour.
+      @param[in] ID the ID of the unit
+      @param[in] Func the function called for each neighbour
+    */
+    template<typename FuncType>
+    void forEachNeighbour(UnitID_t ID, FuncType&& Func) const
+    {
+      unsigned int Col, Row;
+
+      if (!getPosition(ID,Col,Row))
+      {
+        return;
+      }
+
+      if (Col > 0)
+      {
+        Func(ID-1);
+      }
+      if (Col+1 < m_ColsNbr)
+      {
+        Func(ID+1);
+      }
+      if (Row > 0)
+      {
+        Func(ID-m_ColsNbr);
+      }
+      if (Row+1 < m_RowsNbr)
+      {
+        Func(ID+m_ColsNbr);
+      }
+    }
+
+    /**
+      Returns the IDs of the neighbours of the unit with the given ID
+      @param[in] ID the ID of the unit
+      @return the IDs of the neighbours, empty if the ID does not belong to the matrix
+    */
+    inline std::vector<UnitID_t> getNeighboursIDs(UnitID_t ID) const
+    {
+      std::vector<UnitID_t> IDs;
+      IDs.reserve(4);
+      forEachNeighbour(ID,[&IDs](UnitID_t NeighbourID){ IDs.push_back(NeighbourID); });
+      return IDs;
+    }
+
+};
+
+
+} } // namespaces
+
+
+#endif /* __OPENFLUID_CORE_UNITSMATRIXTOPOLOGY_HPP__ */
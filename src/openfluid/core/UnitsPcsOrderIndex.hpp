@@ -0,0 +1,222 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file UnitsPcsOrderIndex.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_UNITSPCSORDERINDEX_HPP__
+#define __OPENFLUID_CORE_UNITSPCSORDERINDEX_HPP__
+
+
+#include <map>
+#include <iterator>
+
+#include <openfluid/core/TypeDefs.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+/**
+  Functor returning the process order of a spatial unit, given by reference or by pointer
+*/
+struct UnitPcsOrderGetter
+{
+  template<typename UnitType>
+  PcsOrd_t operator()(const UnitType& Unit) const
+  {
+    return Unit.getProcessOrder();
+  }
+
+  template<typename UnitType>
+  PcsOrd_t operator()(UnitType* const& Unit) const
+  {
+    return Unit->getProcessOrder();
+  }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Index of the process order groups of a list of units sorted by process order.
+  It keeps the position of the first unit of each process order, so that a unit can be inserted
+  at its process order position without sorting the whole list.
+  The index is valid only while the list is sorted, it must be rebuilt after a full sort of the list.
+  @tparam ListType the type of the indexed list
+  @tparam GetOrderType the type of the functor returning the process order of a list element
+*/
+template<typename ListType, typename GetOrderType = UnitPcsOrderGetter>
+class UnitsPcsOrderIndex
+{
+  public:
+
+    using Iterator_t = typename ListType::iterator;
+
+
+  private:
+
+    std::map<PcsOrd_t,Iterator_t> m_FirstByOrder;
+
+    bool m_IsValid = true;
+
+    GetOrderType m_GetOrder;
+
+
+  public:
+
+    UnitsPcsOrderIndex() = default;
+
+    /**
+      Returns true if the indexed list is known to be sorted and the index is usable
+    */
+    bool isValid() const
+    {
+      return m_IsValid;
+    }
+
+    void invalidate()
+    {
+      m_IsValid = false;
+      m_FirstByOrder.clear();
+    }
+
+    /**
+      Rebuilds the index from a sorted list
+    */
+    void rebuild(ListType& List)
+    {
+      m_FirstByOrder.clear();
+
+      for (auto it = List.begin(); it != List.end(); ++it)
+      {
+        m_FirstByOrder.emplace(m_GetOrder(*it),it);
+      }
+
+      m_IsValid = true;
+    }
+
+    /**
+      Returns the position where an element of the given process order must be inserted,
+      which is after the last element of the same process order
+    */
+    Iterator_t insertionPoint(ListType& List, PcsOrd_t Order) const
+    {
+      auto it = m_FirstByOrder.upper_bound(Order);
+
+      if (it == m_FirstByOrder.end())
+      {
+        return List.end();
+      }
+
+      return it->second;
+    }
+
+    /**
+      Updates the index after an element was inserted at the position given by insertionPoint()
+    */
+    void notifyInserted(Iterator_t It)
+    {
+      if (m_IsValid)
+      {
+        m_FirstByOrder.emplace(m_GetOrder(*It),It);
+      }
+    }
+
+    /**
+      Updates the index after an element was appended at the end of the list.
+      The index is invalidated if the appended element breaks the process order
+    */
+    void notifyAppended(ListType& List, Iterator_t It)
+    {
+      if (!m_IsValid)
+      {
+        return;
+      }
+
+      if (It != List.begin() && m_GetOrder(*std::prev(It)) > m_GetOrder(*It))
+      {
+        invalidate();
+      }
+      else
+      {
+        m_FirstByOrder.emplace(m_GetOrder(*It),It);
+      }
+    }
+
+    /**
+      Updates the index before an element is erased from the list
+    */
+    void notifyErasing(ListType& List, Iterator_t It)
+    {
+      if (!m_IsValid)
+      {
+        return;
+      }
+
+      const PcsOrd_t Order = m_GetOrder(*It);
+      auto GroupIt = m_FirstByOrder.find(Order);
+
+      if (GroupIt != m_FirstByOrder.end() && GroupIt->second == It)
+      {
+        auto NextIt = std::next(It);
+
+        if (NextIt != List.end() && m_GetOrder(*NextIt) == Order)
+        {
+          GroupIt->second = NextIt;
+        }
+        else
+        {
+          m_FirstByOrder.erase(GroupIt);
+        }
+      }
+    }
+
+    void clear()
+    {
+      m_FirstByOrder.clear();
+      m_IsValid = true;
+    }
+
+};
+
+
+} } // namespaces
+
+
+#endif /* __OPENFLUID_CORE_UNITSPCSORDERINDEX_HPP__ */
@@ -38,6 +38,13 @@
 */
 
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <vector>
+
 #include <boost/circular_buffer.hpp>
 
 #include <openfluid/core/ValuesBuffer.hpp>
@@ -57,6 +64,29 @@ class ValuesBuffer::PrivateImpl
 
     DataContainer_t m_Data;
 
+    StoragePrecision m_Precision = StoragePrecision::FULL;
+
+    double m_Scale = 1.0;
+
+    /**
+      Compact representation of the double values, in lockstep with m_Data when the precision is reduced.
+      A slot of m_Data without value is stored in its compact representation only.
+    */
+    boost::circular_buffer<std::uint32_t> m_Compact;
+
+    /**
+      Time indexes of the values rebuilt or modified since the latest append
+    */
+    std::vector<TimeIndex_t> m_Materialized;
+
+    /**
+      Guards m_Compact, m_Materialized and the slots of m_Data in compact mode, since values may be
+      rebuilt by concurrent readers (e.g. threaded loops on spatial units) while the buffer owner appends
+    */
+    std::mutex m_MaterializeMutex;
+
+    double m_MaxError = 0.0;
+
     DataContainer_t::iterator findAtIndex(const TimeIndex_t& anIndex)
     {
       if (m_Data.empty())
@@ -151,6 +181,200 @@ class ValuesBuffer::PrivateImpl
       return m_Data.end();
 
     }
+
+    /**
+      Assigns the given value to the storage, in place if the stored value has the same type
+    */
+    static void assignValue(std::unique_ptr<Value>& Storage, const Value& aValue)
+    {
+      if (Storage.get() == &aValue)
+      {
+        return;
+      }
+
+      if (Storage && Storage->getType() == aValue.getType())
+      {
+        *Storage = aValue;
+      }
+      else
+      {
+        Storage.reset(aValue.clone());
+      }
+    }
+
+    /**
+      Takes the storage of the oldest value if it will be discarded by the next append
+      and if it holds a value of the given type
+      @return the recycled storage, nullptr if none is available
+    */
+    std::unique_ptr<Value> takeRecyclableStorage(Value::Type aType)
+    {
+      if (!m_Data.empty() && m_Data.full() &&
+          m_Data.front().m_Value && m_Data.front().m_Value->getType() == aType)
+      {
+        return std::move(m_Data.front().m_Value);
+      }
+
+      return nullptr;
+    }
+
+    inline bool isCompact() const
+    {
+      return (m_Precision != StoragePrecision::FULL);
+    }
+
+    double decode(std::uint32_t Raw) const
+    {
+      if (m_Precision == StoragePrecision::FLOAT32)
+      {
+        float Val;
+        std::memcpy(&Val,&Raw,sizeof(Val));
+        return Val;
+      }
+
+      std::int32_t Val;
+      std::memcpy(&Val,&Raw,sizeof(Val));
+      return Val*m_Scale;
+    }
+
+    /**
+      Encodes the given double value into its compact representation
+      @return false if the value cannot be represented with the current precision
+    */
+    bool encode(double Val, std::uint32_t& Raw)
+    {
+      if (m_Precision == StoragePrecision::FLOAT32)
+      {
+        if (std::isfinite(Val) && std::fabs(Val) > std::numeric_limits<float>::max())
+        {
+          return false;
+        }
+
+        const float FVal = static_cast<float>(Val);
+        std::memcpy(&Raw,&FVal,sizeof(Raw));
+      }
+      else
+      {
+        const double Scaled = std::round(Val/m_Scale);
+
+        if (!std::isfinite(Scaled) ||
+            Scaled < std::numeric_limits<std::int32_t>::min() || Scaled > std::numeric_limits<std::int32_t>::max())
+        {
+          return false;
+        }
+
+        const std::int32_t IVal = static_cast<std::int32_t>(Scaled);
+        std::memcpy(&Raw,&IVal,sizeof(Raw));
+      }
+
+      const double Error = std::fabs(decode(Raw)-Val);
+      if (Error > m_MaxError)
+      {
+        m_MaxError = Error;
+      }
+
+      return true;
+    }
+
+    /**
+      Rebuilds the value of the given slot from its compact representation if needed
+      @param[in] It the slot
+      @param[in] Modified true if the value of the slot is about to be modified
+    */
+    IndexedValue& materialize(DataContainer_t::iterator It, bool Modified = false)
+    {
+      if (isCompact())
+      {
+        std::lock_guard<std::mutex> Lock(m_MaterializeMutex);
+
+        if (!(*It).m_Value)
+        {
+          (*It).m_Value = std::make_unique<DoubleValue>(decode(m_Compact[std::distance(m_Data.begin(),It)]));
+          m_Materialized.push_back((*It).m_Index);
+        }
+        else if (Modified)
+        {
+          m_Materialized.push_back((*It).m_Index);
+        }
+      }
+
+      return *It;
+    }
+
+    /**
+      Stores back in their compact representation the values rebuilt or modified since the latest append.
+      m_MaterializeMutex must be locked by the caller
+    */
+    void releaseMaterialized()
+    {
+      for (const auto& Index : m_Materialized)
+      {
+        DataContainer_t::iterator It = findAtIndex(Index);
+
+        if (It != m_Data.end() && (*It).m_Value && (*It).m_Value->getType() == Value::DOUBLE)
+        {
+          std::uint32_t Raw;
+
+          if (encode(static_cast<const DoubleValue&>(*(*It).m_Value).get(),Raw))
+          {
+            m_Compact[std::distance(m_Data.begin(),It)] = Raw;
+            (*It).m_Value.reset();
+          }
+        }
+      }
+
+      m_Materialized.clear();
+    }
+
+    /**
+      Appends the given storage at the given time index, in its compact representation if possible
+    */
+    void append(const TimeIndex_t& anIndex, std::unique_ptr<Value>&& Storage)
+    {
+      if (isCompact())
+      {
+        std::lock_guard<std::mutex> Lock(m_MaterializeMutex);
+
+        releaseMaterialized();
+
+        std::uint32_t Raw = 0;
+
+        if (Storage->getType() == Value::DOUBLE && encode(static_cast<const DoubleValue&>(*Storage).get(),Raw))
+        {
+          Storage.reset();
+        }
+
+        // both containers are pushed under the lock since they must stay in lockstep for readers
+        m_Compact.push_back(Raw);
+        m_Data.push_back(IndexedValue(anIndex,std::move(Storage)));
+      }
+      else
+      {
+        m_Data.push_back(IndexedValue(anIndex,std::move(Storage)));
+      }
+    }
+
+    /**
+      Appends the given double value at the given time index in its compact representation
+      @return false if the value cannot be represented with the current precision
+    */
+    bool appendCompact(const TimeIndex_t& anIndex, double Val)
+    {
+      std::lock_guard<std::mutex> Lock(m_MaterializeMutex);
+
+      std::uint32_t Raw;
+
+      if (!encode(Val,Raw))
+      {
+        return false;
+      }
+
+      releaseMaterialized();
+      m_Compact.push_back(Raw);
+      m_Data.push_back(IndexedValue(anIndex,std::unique_ptr<Value>()));
+
+      return true;
+    }
 };
 
 
@@ -159,7 +383,7 @@ class ValuesBuffer::PrivateImpl
 
 
 ValuesBuffer::ValuesBuffer():
-    m_PImpl(new PrivateImpl)
+    m_PImpl(std::make_shared<PrivateImpl>()), m_ReadOnly(false)
 {
   m_PImpl->m_Data.set_capacity(BufferSize);
 }
@@ -171,7 +395,7 @@ ValuesBuffer::ValuesBuffer():
 
 ValuesBuffer::~ValuesBuffer()
 {
-  delete m_PImpl;
+
 }
 
 
@@ -181,9 +405,9 @@ ValuesBuffer::~ValuesBuffer()
 
 bool ValuesBuffer::getValue(const TimeIndex_t& anIndex, Value* aValue) const
 {
-  PrivateImpl::DataContainer_t::const_iterator It = m_PImpl->findAtIndex(anIndex);
+  PrivateImpl::DataContainer_t::iterator It = m_PImpl->findAtIndex(anIndex);
 
-  if (It != m_PImpl->m_Data.end() && aValue->getType() == (*It).m_Value.get()->getType())
+  if (It != m_PImpl->m_Data.end() && aValue->getType() == m_PImpl->materialize(It).m_Value->getType())
   {
     *aValue = *((*It).m_Value);
 
@@ -200,11 +424,11 @@ bool ValuesBuffer::getValue(const TimeIndex_t& anIndex, Value* aValue) const
 
 Value* ValuesBuffer::value(const TimeIndex_t& anIndex) const
 {
-  PrivateImpl::DataContainer_t::const_iterator It = m_PImpl->findAtIndex(anIndex);
+  PrivateImpl::DataContainer_t::iterator It = m_PImpl->findAtIndex(anIndex);
 
   if (It != m_PImpl->m_Data.end())
   {
-    return (*It).m_Value.get();
+    return m_PImpl->materialize(It).m_Value.get();
   }
 
   return nullptr;
@@ -217,7 +441,7 @@ Value* ValuesBuffer::value(const TimeIndex_t& anIndex) const
 
 Value* ValuesBuffer::currentValue() const
 {
-  return m_PImpl->m_Data.back().m_Value.get();
+  return m_PImpl->materialize(std::prev(m_PImpl->m_Data.end())).m_Value.get();
 }
 
 
@@ -227,9 +451,11 @@ Value* ValuesBuffer::currentValue() const
 
 bool ValuesBuffer::getCurrentValue(Value* aValue) const
 {
-  if(aValue->getType() == m_PImpl->m_Data.back().m_Value->getType())
+  const IndexedValue& Latest = m_PImpl->materialize(std::prev(m_PImpl->m_Data.end()));
+
+  if(aValue->getType() == Latest.m_Value->getType())
   {
-    *aValue = *(m_PImpl->m_Data.back()).m_Value;
+    *aValue = *Latest.m_Value;
 
     return true;
   }
@@ -245,8 +471,10 @@ bool ValuesBuffer::getLatestIndexedValue(IndexedValue& IndValue) const
 {
   if(!m_PImpl->m_Data.empty())
   {
-    IndValue.m_Index = m_PImpl->m_Data.back().m_Index;
-    IndValue.m_Value.reset(m_PImpl->m_Data.back().m_Value->clone());
+    const IndexedValue& Latest = m_PImpl->materialize(std::prev(m_PImpl->m_Data.end()));
+
+    IndValue.m_Index = Latest.m_Index;
+    IndValue.m_Value.reset(Latest.m_Value->clone());
 
     return true;
   }
@@ -264,12 +492,12 @@ bool ValuesBuffer::getLatestIndexedValues(const TimeIndex_t& anIndex, IndexedVal
 
   if(!m_PImpl->m_Data.empty())
   {
-    PrivateImpl::DataContainer_t::const_reverse_iterator rIt = m_PImpl->m_Data.rbegin();
-    PrivateImpl::DataContainer_t::const_reverse_iterator rIte = m_PImpl->m_Data.rend();
+    PrivateImpl::DataContainer_t::reverse_iterator rIt = m_PImpl->m_Data.rbegin();
+    PrivateImpl::DataContainer_t::reverse_iterator rIte = m_PImpl->m_Data.rend();
 
     while (rIt != rIte && (*rIt).getIndex() >= anIndex)
     {
-      IndValueList.push_front(*rIt);
+      IndValueList.push_front(m_PImpl->materialize(std::prev(rIt.base())));
       ++rIt;
     }
 
@@ -290,14 +518,14 @@ bool ValuesBuffer::getIndexedValues(const TimeIndex_t& aBeginIndex, const TimeIn
 
   if(!m_PImpl->m_Data.empty() && aBeginIndex <= anEndIndex)
   {
-    PrivateImpl::DataContainer_t::const_reverse_iterator rIt = m_PImpl->m_Data.rbegin();
-    PrivateImpl::DataContainer_t::const_reverse_iterator rIte = m_PImpl->m_Data.rend();
+    PrivateImpl::DataContainer_t::reverse_iterator rIt = m_PImpl->m_Data.rbegin();
+    PrivateImpl::DataContainer_t::reverse_iterator rIte = m_PImpl->m_Data.rend();
 
     while (rIt != rIte && (*rIt).getIndex() >= aBeginIndex)
     {
       if  ((*rIt).getIndex() <= anEndIndex)
       {
-        IndValueList.push_front(*rIt);
+        IndValueList.push_front(m_PImpl->materialize(std::prev(rIt.base())));
       }
       ++rIt;
     }
@@ -338,11 +566,38 @@ bool ValuesBuffer::isValueExist(const TimeIndex_t& anIndex) const
 
 bool ValuesBuffer::modifyValue(const TimeIndex_t& anIndex, const Value& aValue)
 {
+  if (m_ReadOnly)
+  {
+    return false;
+  }
+
+  PrivateImpl::DataContainer_t::iterator It = m_PImpl->findAtIndex(anIndex);
+
+  if (It != m_PImpl->m_Data.end())
+  {
+    PrivateImpl::assignValue(m_PImpl->materialize(It,true).m_Value,aValue);
+    return true;
+  }
+  return false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBuffer::modifyValue(const TimeIndex_t& anIndex, std::unique_ptr<Value>&& aValue)
+{
+  if (m_ReadOnly || !aValue)
+  {
+    return false;
+  }
+
   PrivateImpl::DataContainer_t::iterator It = m_PImpl->findAtIndex(anIndex);
 
   if (It != m_PImpl->m_Data.end())
   {
-    (*It).m_Value.reset(aValue.clone());
+    m_PImpl->materialize(It,true).m_Value = std::move(aValue);
     return true;
   }
   return false;
@@ -355,14 +610,29 @@ bool ValuesBuffer::modifyValue(const TimeIndex_t& anIndex, const Value& aValue)
 
 bool ValuesBuffer::modifyCurrentValue(const Value& aValue)
 {
-  if (m_PImpl->m_Data.empty())
+  if (m_ReadOnly || m_PImpl->m_Data.empty())
   {
     return false;
   }
 
-  PrivateImpl::DataContainer_t::iterator It = m_PImpl->m_Data.end();
-  --It;
-  (*It).m_Value.reset(aValue.clone());
+  PrivateImpl::assignValue(m_PImpl->materialize(std::prev(m_PImpl->m_Data.end()),true).m_Value,aValue);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBuffer::modifyCurrentValue(std::unique_ptr<Value>&& aValue)
+{
+  if (m_ReadOnly || m_PImpl->m_Data.empty() || !aValue)
+  {
+    return false;
+  }
+
+  m_PImpl->materialize(std::prev(m_PImpl->m_Data.end()),true).m_Value = std::move(aValue);
 
   return true;
 }
@@ -374,12 +644,223 @@ bool ValuesBuffer::modifyCurrentValue(const Value& aValue)
 
 bool ValuesBuffer::appendValue(const TimeIndex_t& anIndex, const openfluid::core::Value& aValue)
 {
-  if (!m_PImpl->m_Data.empty() && anIndex <= m_PImpl->m_Data.back().m_Index)
+  if (m_ReadOnly || (!m_PImpl->m_Data.empty() && anIndex <= m_PImpl->m_Data.back().m_Index))
   {
     return false;
   }
 
-  m_PImpl->m_Data.push_back(IndexedValue(anIndex,aValue));
+  if (m_PImpl->isCompact() && aValue.getType() == Value::DOUBLE &&
+      m_PImpl->appendCompact(anIndex,static_cast<const DoubleValue&>(aValue).get()))
+  {
+    return true;
+  }
+
+  std::unique_ptr<Value> Storage = m_PImpl->takeRecyclableStorage(aValue.getType());
+
+  if (Storage)
+  {
+    *Storage = aValue;
+  }
+  else
+  {
+    Storage.reset(aValue.clone());
+  }
+
+  m_PImpl->append(anIndex,std::move(Storage));
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBuffer::appendValue(const TimeIndex_t& anIndex, std::unique_ptr<Value>&& aValue)
+{
+  if (m_ReadOnly || !aValue || (!m_PImpl->m_Data.empty() && anIndex <= m_PImpl->m_Data.back().m_Index))
+  {
+    return false;
+  }
+
+  m_PImpl->append(anIndex,std::move(aValue));
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const IndexedValue* ValuesBuffer::latestIndexedValue() const
+{
+  if (m_PImpl->m_Data.empty())
+  {
+    return nullptr;
+  }
+
+  return &(m_PImpl->materialize(std::prev(m_PImpl->m_Data.end())));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const IndexedValue& ValuesBuffer::indexedValueAt(unsigned int Position) const
+{
+  return m_PImpl->materialize(m_PImpl->m_Data.begin()+Position);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBuffer::getLatestIndexedValuesView(const TimeIndex_t& anIndex, IndexedValuesView& View) const
+{
+  View = IndexedValuesView();
+
+  if (m_PImpl->m_Data.empty())
+  {
+    return false;
+  }
+
+  // values are ordered by time index in the buffer
+  const auto FirstIt = std::lower_bound(m_PImpl->m_Data.begin(),m_PImpl->m_Data.end(),anIndex,
+                                        [](const IndexedValue& IndValue, const TimeIndex_t& Index)
+                                        {
+                                          return IndValue.getIndex() < Index;
+                                        });
+
+  const unsigned int First = std::distance(m_PImpl->m_Data.begin(),FirstIt);
+  View = IndexedValuesView(this,First,m_PImpl->m_Data.size()-First);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBuffer::getIndexedValuesView(const TimeIndex_t& aBeginIndex, const TimeIndex_t& anEndIndex,
+                                        IndexedValuesView& View) const
+{
+  View = IndexedValuesView();
+
+  if (m_PImpl->m_Data.empty() || aBeginIndex > anEndIndex)
+  {
+    return false;
+  }
+
+  const auto FirstIt = std::lower_bound(m_PImpl->m_Data.begin(),m_PImpl->m_Data.end(),aBeginIndex,
+                                        [](const IndexedValue& IndValue, const TimeIndex_t& Index)
+                                        {
+                                          return IndValue.getIndex() < Index;
+                                        });
+  const auto LastIt = std::upper_bound(FirstIt,m_PImpl->m_Data.end(),anEndIndex,
+                                       [](const TimeIndex_t& Index, const IndexedValue& IndValue)
+                                       {
+                                         return Index < IndValue.getIndex();
+                                       });
+
+  View = IndexedValuesView(this,std::distance(m_PImpl->m_Data.begin(),FirstIt),std::distance(FirstIt,LastIt));
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ValuesBuffer::shareStorage(const ValuesBuffer& Source)
+{
+  if (&Source != this)
+  {
+    m_PImpl = Source.m_PImpl;
+    m_ReadOnly = true;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBuffer::setStoragePrecision(StoragePrecision Precision, double Scale)
+{
+  if (m_ReadOnly || !m_PImpl->m_Data.empty() ||
+      (Precision == StoragePrecision::FIXED && (!std::isfinite(Scale) || Scale <= 0.0)))
+  {
+    return false;
+  }
+
+  m_PImpl->m_Precision = Precision;
+  m_PImpl->m_Scale = (Precision == StoragePrecision::FIXED) ? Scale : 1.0;
+  m_PImpl->m_MaxError = 0.0;
+
+  if (m_PImpl->isCompact())
+  {
+    m_PImpl->m_Compact.set_capacity(m_PImpl->m_Data.capacity());
+  }
+  else
+  {
+    m_PImpl->m_Compact = boost::circular_buffer<std::uint32_t>();
+  }
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+ValuesBuffer::StoragePrecision ValuesBuffer::getStoragePrecision() const
+{
+  return m_PImpl->m_Precision;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+double ValuesBuffer::getStorageScale() const
+{
+  return m_PImpl->m_Scale;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+double ValuesBuffer::getStorageMaxError() const
+{
+  return m_PImpl->m_MaxError;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBuffer::clearValues()
+{
+  if (m_ReadOnly)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> Lock(m_PImpl->m_MaterializeMutex);
+
+  m_PImpl->m_Data.clear();
+  m_PImpl->m_Compact.clear();
+  m_PImpl->m_Materialized.clear();
 
   return true;
 }
@@ -416,13 +897,13 @@ void ValuesBuffer::displayContent(std::ostream& OStream) const
 {
   OStream << "-- ValuesBuffer content --" << std::endl;
 
-  PrivateImpl::DataContainer_t::const_iterator Itb = m_PImpl->m_Data.begin();
-  PrivateImpl::DataContainer_t::const_iterator Ite = m_PImpl->m_Data.end();
-  PrivateImpl::DataContainer_t::const_iterator It = Itb;
+  PrivateImpl::DataContainer_t::iterator Itb = m_PImpl->m_Data.begin();
+  PrivateImpl::DataContainer_t::iterator Ite = m_PImpl->m_Data.end();
+  PrivateImpl::DataContainer_t::iterator It = Itb;
 
   while (It!=Ite)
   {
-    OStream << "[" << (*It).m_Index << "|" << (*It).m_Value.get()->toString() << "]" << std::endl;
+    OStream << "[" << (*It).m_Index << "|" << m_PImpl->materialize(It).m_Value.get()->toString() << "]" << std::endl;
     ++It;
   }
 
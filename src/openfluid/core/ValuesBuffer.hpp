@@ -41,6 +41,9 @@
 #define __OPENFLUID_CORE_VALUESBUFFER_HPP__
 
 
+#include <iterator>
+#include <memory>
+
 #include <openfluid/dllexport.hpp>
 #include <openfluid/core/ValuesBufferProperties.hpp>
 #include <openfluid/core/IndexedValue.hpp>
@@ -49,13 +52,28 @@
 namespace openfluid { namespace core {
 
 
+class IndexedValuesView;
+
+
 class OPENFLUID_API ValuesBuffer: public ValuesBufferProperties
 {
+  public:
+
+    /**
+      Storage precision of the double values held by a values buffer.
+      FULL stores values as double precision,
+      FLOAT32 stores values as single precision floating point numbers,
+      FIXED stores values as 32 bits integers multiplied by a fixed scale.
+    */
+    enum class StoragePrecision { FULL, FLOAT32, FIXED };
+
 
   private:
 
     class PrivateImpl;
-    PrivateImpl* m_PImpl;
+    std::shared_ptr<PrivateImpl> m_PImpl;
+
+    bool m_ReadOnly;
 
 
   public:
@@ -83,12 +101,123 @@ class OPENFLUID_API ValuesBuffer: public ValuesBufferProperties
     bool getIndexedValues(const TimeIndex_t& aBeginIndex, const TimeIndex_t& anEndIndex,
                                 IndexedValueList& IndValueList) const;
 
+    /**
+      Returns a pointer to the latest indexed value stored in the buffer, without copy
+      @return the latest indexed value, nullptr if the buffer is empty
+    */
+    const IndexedValue* latestIndexedValue() const;
+
+    /**
+      Returns the indexed value at the given position in the buffer, from oldest (0) to latest (count-1)
+      @param[in] Position the position in the buffer, must be lower than the values count
+    */
+    const IndexedValue& indexedValueAt(unsigned int Position) const;
+
+    /**
+      Gets a read-only view on the latest indexed values since the given time index, without copy
+      @param[in] anIndex the beginning time index
+      @param[out] View the view on the values
+      @return false if the buffer is empty
+    */
+    bool getLatestIndexedValuesView(const TimeIndex_t& anIndex, IndexedValuesView& View) const;
+
+    /**
+      Gets a read-only view on the indexed values between two time indexes, without copy
+      @param[in] aBeginIndex the beginning time index
+      @param[in] anEndIndex the ending time index
+      @param[out] View the view on the values
+      @return false if the buffer is empty or if the beginning index is greater than the ending index
+    */
+    bool getIndexedValuesView(const TimeIndex_t& aBeginIndex, const TimeIndex_t& anEndIndex,
+                              IndexedValuesView& View) const;
+
+    /**
+      Modifies the value at the given time index.
+      If the stored value has the same type, it is assigned in place, reusing its storage
+    */
     bool modifyValue(const TimeIndex_t& anIndex, const Value& aValue);
 
+    /**
+      Modifies the value at the given time index, taking ownership of the given value without copy
+    */
+    bool modifyValue(const TimeIndex_t& anIndex, std::unique_ptr<Value>&& aValue);
+
+    /**
+      Modifies the current value.
+      If the stored value has the same type, it is assigned in place, reusing its storage
+    */
     bool modifyCurrentValue(const Value& aValue);
 
+    /**
+      Modifies the current value, taking ownership of the given value without copy
+    */
+    bool modifyCurrentValue(std::unique_ptr<Value>&& aValue);
+
+    /**
+      Appends a value at the given time index.
+      When the buffer is full, the storage of the discarded oldest value is recycled
+      if it has the same type than the appended value
+    */
     bool appendValue(const TimeIndex_t& anIndex, const Value& aValue);
 
+    /**
+      Appends a value at the given time index, taking ownership of the given value without copy
+    */
+    bool appendValue(const TimeIndex_t& anIndex, std::unique_ptr<Value>&& aValue);
+
+    /**
+      Makes this buffer a read-only view on the storage of the given source buffer.
+      The values previously stored in this buffer are released, and all further modifications
+      must be made through the source buffer, which shares its values with all its views.
+      @param[in] Source the buffer providing the values storage
+    */
+    void shareStorage(const ValuesBuffer& Source);
+
+    /**
+      Sets the storage precision of the double values held by the buffer.
+      With a reduced precision, double values are converted when appended and rebuilt as double values
+      when accessed, other values types are stored unchanged.
+      In this compact mode, pointers and references to values returned by the buffer (value(), currentValue(),
+      latestIndexedValue(), indexedValueAt()...) are invalidated by the next append, which stores the rebuilt
+      values back in their compact representation.
+      Values may be read concurrently from several threads, but appending or modifying values
+      must not be done concurrently with reads of the same buffer, as for the full precision.
+      @param[in] Precision the storage precision
+      @param[in] Scale the scale of the stored values, used only for the FIXED precision
+      @return false if the buffer already contains values, is a shared storage view or if the scale is not valid
+    */
+    bool setStoragePrecision(StoragePrecision Precision, double Scale = 1.0);
+
+    /**
+      Returns the storage precision of the double values held by the buffer
+    */
+    StoragePrecision getStoragePrecision() const;
+
+    /**
+      Returns the scale of the stored values, used only for the FIXED precision
+    */
+    double getStorageScale() const;
+
+    /**
+      Returns the maximum absolute difference between appended double values and their stored representation,
+      always 0 for the FULL precision
+    */
+    double getStorageMaxError() const;
+
+    /**
+      Returns true if this buffer is a read-only view on the storage of another buffer
+    */
+    inline bool isSharedStorage() const
+    {
+      return m_ReadOnly;
+    }
+
+    /**
+      Removes all values stored in the buffer, keeping its storage precision
+      @return false if the buffer is a shared storage view
+    */
+    bool clearValues();
+
     unsigned int getValuesCount() const;
 
     void displayStatus(std::ostream& OStream) const;
@@ -98,6 +227,180 @@ class OPENFLUID_API ValuesBuffer: public ValuesBufferProperties
 
 };
 
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Read-only view on a range of indexed values stored in a values buffer, ordered from oldest to latest.
+  Values are accessed in place, without copy. A view remains valid as long as the viewed buffer
+  is not modified, which means during the current time step for observers.
+
+  @cond OpenFLUID:completion
+  {
+    "contexts" : ["ANYWARE"],
+    "menupath" : ["Types", "Values"],
+    "title" : "View on IndexedValue",
+    "text" : "openfluid::core::IndexedValuesView %%SEL_START%%IndexedValView%%SEL_END%%"
+  }
+  @endcond
+*/
+class OPENFLUID_API IndexedValuesView
+{
+  private:
+
+    const ValuesBuffer* mp_Buffer;
+
+    unsigned int m_First;
+
+    unsigned int m_Size;
+
+
+  public:
+
+    class const_iterator
+    {
+      private:
+
+        const ValuesBuffer* mp_Buffer;
+
+        unsigned int m_Position;
+
+
+      public:
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = IndexedValue;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const IndexedValue*;
+        using reference = const IndexedValue&;
+
+        const_iterator(const ValuesBuffer* Buffer, unsigned int Position) :
+          mp_Buffer(Buffer), m_Position(Position)
+        { }
+
+        reference operator*() const
+        {
+          return mp_Buffer->indexedValueAt(m_Position);
+        }
+
+        pointer operator->() const
+        {
+          return &(mp_Buffer->indexedValueAt(m_Position));
+        }
+
+        const_iterator& operator++()
+        {
+          ++m_Position;
+          return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+          const_iterator Tmp(*this);
+          ++m_Position;
+          return Tmp;
+        }
+
+        const_iterator& operator--()
+        {
+          --m_Position;
+          return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+          const_iterator Tmp(*this);
+          --m_Position;
+          return Tmp;
+        }
+
+        bool operator==(const const_iterator& Other) const
+        {
+          return (mp_Buffer == Other.mp_Buffer && m_Position == Other.m_Position);
+        }
+
+        bool operator!=(const const_iterator& Other) const
+        {
+          return !(*this == Other);
+        }
+    };
+
+
+    IndexedValuesView() : mp_Buffer(nullptr), m_First(0), m_Size(0)
+    { }
+
+    IndexedValuesView(const ValuesBuffer* Buffer, unsigned int First, unsigned int Size) :
+      mp_Buffer(Buffer), m_First(First), m_Size(Size)
+    { }
+
+    /**
+      Returns the number of values in the view
+    */
+    inline unsigned int size() const
+    {
+      return m_Size;
+    }
+
+    /**
+      Returns true if the view does not contain any value
+    */
+    inline bool empty() const
+    {
+      return (m_Size == 0);
+    }
+
+    /**
+      Returns the indexed value at the given position in the view
+    */
+    inline const IndexedValue& operator[](unsigned int Position) const
+    {
+      return mp_Buffer->indexedValueAt(m_First+Position);
+    }
+
+    /**
+      Returns the oldest indexed value of the view
+    */
+    inline const IndexedValue& front() const
+    {
+      return mp_Buffer->indexedValueAt(m_First);
+    }
+
+    /**
+      Returns the latest indexed value of the view
+    */
+    inline const IndexedValue& back() const
+    {
+      return mp_Buffer->indexedValueAt(m_First+m_Size-1);
+    }
+
+    inline const_iterator begin() const
+    {
+      return const_iterator(mp_Buffer,m_First);
+    }
+
+    inline const_iterator end() const
+    {
+      return const_iterator(mp_Buffer,m_First+m_Size);
+    }
+
+    /**
+      Copies the viewed values into an indexed values list
+      @param[out] IndValueList the list of indexed values
+    */
+    void copyTo(IndexedValueList& IndValueList) const
+    {
+      IndValueList.clear();
+
+      for (const auto& IndValue : *this)
+      {
+        IndValueList.push_back(IndValue);
+      }
+    }
+};
+
+
 }  } // namespaces
 
 
@@ -37,21 +37,66 @@
 */
 
 
+#include <algorithm>
+
 #include <openfluid/core/Variables.hpp>
 
 
 namespace openfluid { namespace core {
 
 
-bool Variables::createVariable(const VariableName_t& aName)
+/**
+  The existing Variable must be untyped (NONE), otherwise the expecting Value must be
+  either a NullValue or the same type than the existing Variable.
+*/
+static bool isCompatibleType(Value::Type VarType, Value::Type ValueType)
+{
+  return (VarType == Value::NONE || ValueType == Value::NULLL || VarType == ValueType);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+Variables::VariablesMap_t::iterator Variables::findVariable(const VariableName_t& aName)
+{
+  // names are not interned on lookup, an unknown name cannot be a variable
+  const SymbolID_t Symbol = SymbolsTable::find(aName);
+
+  if (Symbol == SymbolsTable::InvalidSymbol)
+  {
+    return m_Data.end();
+  }
+
+  return m_Data.find(Symbol);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+Variables::VariablesMap_t::const_iterator Variables::findVariable(const VariableName_t& aName) const
 {
-  if (!isVariableExist(aName))
+  const SymbolID_t Symbol = SymbolsTable::find(aName);
+
+  if (Symbol == SymbolsTable::InvalidSymbol)
   {
-    m_Data[aName].second = Value::NONE;
-    return true;
+    return m_Data.end();
   }
 
-  return false;
+  return m_Data.find(Symbol);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::createVariable(const VariableName_t& aName)
+{
+  return createVariable(aName,Value::NONE);
 }
 
 
@@ -61,13 +106,24 @@ bool Variables::createVariable(const VariableName_t& aName)
 
 bool Variables::createVariable(const VariableName_t& aName, const Value::Type& aType)
 {
-  if (!isVariableExist(aName))
+  return createVariable(SymbolsTable::intern(aName),aType);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::createVariable(SymbolID_t aSymbol, const Value::Type& aType)
+{
+  auto Inserted = m_Data.try_emplace(aSymbol);
+
+  if (Inserted.second)
   {
-    m_Data[aName].second = aType;
-    return true;
+    Inserted.first->second.second = aType;
   }
 
-  return false;
+  return Inserted.second;
 }
 
 
@@ -75,22 +131,34 @@ bool Variables::createVariable(const VariableName_t& aName, const Value::Type& a
 // =====================================================================
 
 
-/**
-  The existing Variable must be untyped (NONE), otherwise the expecting Value must be
-  either a NullValue or the same type than the existing Variable.
-*/
 bool Variables::modifyValue(const VariableName_t& aName, const TimeIndex_t& anIndex,
     const Value& aValue)
 {
-  if (isVariableExist(aName, anIndex)
-      && (m_Data[aName].second == openfluid::core::Value::NONE
-          || aValue.getType() == openfluid::core::Value::NULLL
-          || m_Data[aName].second == aValue.getType()))
+  VariablesMap_t::iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && it->second.first.isValueExist(anIndex) &&
+          isCompatibleType(it->second.second,aValue.getType()) &&
+          it->second.first.modifyValue(anIndex,aValue));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::modifyValue(const VariableName_t& aName, const TimeIndex_t& anIndex,
+    std::unique_ptr<Value>&& aValue)
+{
+  if (!aValue)
   {
-    return m_Data[aName].first.modifyValue(anIndex, aValue);
+    return false;
   }
 
-  return false;
+  VariablesMap_t::iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && it->second.first.isValueExist(anIndex) &&
+          isCompatibleType(it->second.second,aValue->getType()) &&
+          it->second.first.modifyValue(anIndex,std::move(aValue)));
 }
 
 
@@ -98,21 +166,43 @@ bool Variables::modifyValue(const VariableName_t& aName, const TimeIndex_t& anIn
 // =====================================================================
 
 
-/**
-  The existing Variable must be untyped (NONE), otherwise the expecting Value must be
-  either a NullValue or the same type than the existing Variable.
-*/
 bool Variables::modifyCurrentValue(const VariableName_t& aName, const Value& aValue)
 {
-  if (isVariableExist(aName)
-      && (m_Data[aName].second == openfluid::core::Value::NONE
-          || aValue.getType() == openfluid::core::Value::NULLL
-          || m_Data[aName].second == aValue.getType()))
+  VariablesMap_t::iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && isCompatibleType(it->second.second,aValue.getType()) &&
+          it->second.first.modifyCurrentValue(aValue));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::modifyCurrentValue(const VariableName_t& aName, std::unique_ptr<Value>&& aValue)
+{
+  if (!aValue)
   {
-    return m_Data[aName].first.modifyCurrentValue(aValue);
+    return false;
   }
 
-  return false;
+  VariablesMap_t::iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && isCompatibleType(it->second.second,aValue->getType()) &&
+          it->second.first.modifyCurrentValue(std::move(aValue)));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::modifyCurrentValue(SymbolID_t aSymbol, const Value& aValue)
+{
+  VariablesMap_t::iterator it = m_Data.find(aSymbol);
+
+  return (it != m_Data.end() && isCompatibleType(it->second.second,aValue.getType()) &&
+          it->second.first.modifyCurrentValue(aValue));
 }
 
 
@@ -120,21 +210,62 @@ bool Variables::modifyCurrentValue(const VariableName_t& aName, const Value& aVa
 // =====================================================================
 
 
-/**
-  The existing Variable must be untyped (NONE), otherwise the expecting Value must be
-  either a NullValue or the same type than the existing Variable.
-*/
 bool Variables::appendValue(const VariableName_t& aName, const TimeIndex_t& anIndex, const Value& aValue)
 {
-  if (isVariableExist(aName)
-      && (m_Data[aName].second == openfluid::core::Value::NONE
-          || aValue.getType() == openfluid::core::Value::NULLL
-          || m_Data[aName].second == aValue.getType()))
+  VariablesMap_t::iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && isCompatibleType(it->second.second,aValue.getType()) &&
+          it->second.first.appendValue(anIndex,aValue));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::appendValue(const VariableName_t& aName, const TimeIndex_t& anIndex,
+                            std::unique_ptr<Value>&& aValue)
+{
+  if (!aValue)
+  {
+    return false;
+  }
+
+  VariablesMap_t::iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && isCompatibleType(it->second.second,aValue->getType()) &&
+          it->second.first.appendValue(anIndex,std::move(aValue)));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::appendValue(SymbolID_t aSymbol, const TimeIndex_t& anIndex, const Value& aValue)
+{
+  VariablesMap_t::iterator it = m_Data.find(aSymbol);
+
+  return (it != m_Data.end() && isCompatibleType(it->second.second,aValue.getType()) &&
+          it->second.first.appendValue(anIndex,aValue));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::appendValue(SymbolID_t aSymbol, const TimeIndex_t& anIndex, std::unique_ptr<Value>&& aValue)
+{
+  if (!aValue)
   {
-    return m_Data[aName].first.appendValue(anIndex,aValue);
+    return false;
   }
 
-  return false;
+  VariablesMap_t::iterator it = m_Data.find(aSymbol);
+
+  return (it != m_Data.end() && isCompatibleType(it->second.second,aValue->getType()) &&
+          it->second.first.appendValue(anIndex,std::move(aValue)));
 }
 
 
@@ -145,7 +276,7 @@ bool Variables::appendValue(const VariableName_t& aName, const TimeIndex_t& anIn
 bool Variables::getValue(const VariableName_t& aName, const TimeIndex_t& anIndex,
     Value* aValue) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
 
   return (it != m_Data.end() && it->second.first.getValue(anIndex, aValue));
 }
@@ -157,7 +288,24 @@ bool Variables::getValue(const VariableName_t& aName, const TimeIndex_t& anIndex
 
 const Value* Variables::value(const VariableName_t& aName, const TimeIndex_t& anIndex) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  if (it != m_Data.end())
+  {
+    return it->second.first.value(anIndex);
+  }
+
+  return nullptr;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const Value* Variables::value(SymbolID_t aSymbol, const TimeIndex_t& anIndex) const
+{
+  VariablesMap_t::const_iterator it = m_Data.find(aSymbol);
 
   if (it != m_Data.end())
   {
@@ -174,7 +322,24 @@ const Value* Variables::value(const VariableName_t& aName, const TimeIndex_t& an
 
 const Value* Variables::currentValue(const VariableName_t& aName) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  if (it != m_Data.end())
+  {
+    return it->second.first.currentValue();
+  }
+
+  return nullptr;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const Value* Variables::currentValue(SymbolID_t aSymbol) const
+{
+  VariablesMap_t::const_iterator it = m_Data.find(aSymbol);
 
   if (it != m_Data.end())
   {
@@ -191,7 +356,7 @@ const Value* Variables::currentValue(const VariableName_t& aName) const
 
 bool Variables::getCurrentValue(const VariableName_t& aName, Value* aValue) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
 
   return (it != m_Data.end() && it->second.first.getCurrentValue(aValue));
 }
@@ -203,7 +368,7 @@ bool Variables::getCurrentValue(const VariableName_t& aName, Value* aValue) cons
 
 bool Variables::getLatestIndexedValue(const VariableName_t& aName, IndexedValue& IndValue) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
 
   return (it != m_Data.end() && it->second.first.getLatestIndexedValue(IndValue));
 }
@@ -216,7 +381,7 @@ bool Variables::getLatestIndexedValue(const VariableName_t& aName, IndexedValue&
 bool Variables::getLatestIndexedValues(const VariableName_t& aName, const TimeIndex_t& anIndex,
                                        IndexedValueList& IndValueList) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
 
   return (it != m_Data.end() && it->second.first.getLatestIndexedValues(anIndex,IndValueList));
 }
@@ -230,7 +395,7 @@ bool Variables::getIndexedValues(const VariableName_t& aName,
                                  const TimeIndex_t& aBeginIndex, const TimeIndex_t& anEndIndex,
                                  IndexedValueList& IndValueList) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
 
   return (it != m_Data.end() && it->second.first.getIndexedValues(aBeginIndex,anEndIndex,IndValueList));
 
@@ -241,9 +406,87 @@ bool Variables::getIndexedValues(const VariableName_t& aName,
 // =====================================================================
 
 
+const IndexedValue* Variables::latestIndexedValue(const VariableName_t& aName) const
+{
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  if (it != m_Data.end())
+  {
+    return it->second.first.latestIndexedValue();
+  }
+
+  return nullptr;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const IndexedValue* Variables::latestIndexedValue(SymbolID_t aSymbol) const
+{
+  VariablesMap_t::const_iterator it = m_Data.find(aSymbol);
+
+  if (it != m_Data.end())
+  {
+    return it->second.first.latestIndexedValue();
+  }
+
+  return nullptr;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::getLatestIndexedValuesView(const VariableName_t& aName, const TimeIndex_t& anIndex,
+                                           IndexedValuesView& View) const
+{
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && it->second.first.getLatestIndexedValuesView(anIndex,View));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::getIndexedValuesView(const VariableName_t& aName,
+                                     const TimeIndex_t& aBeginIndex, const TimeIndex_t& anEndIndex,
+                                     IndexedValuesView& View) const
+{
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && it->second.first.getIndexedValuesView(aBeginIndex,anEndIndex,View));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 Value* Variables::currentValueIfIndex(const VariableName_t& aName, const TimeIndex_t& Index) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  if (it != m_Data.end() && it->second.first.getCurrentIndex() == Index)
+  {
+    return it->second.first.currentValue();
+  }
+
+  return nullptr;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+Value* Variables::currentValueIfIndex(SymbolID_t aSymbol, const TimeIndex_t& Index) const
+{
+  VariablesMap_t::const_iterator it = m_Data.find(aSymbol);
 
   if (it != m_Data.end() && it->second.first.getCurrentIndex() == Index)
   {
@@ -260,7 +503,7 @@ Value* Variables::currentValueIfIndex(const VariableName_t& aName, const TimeInd
 
 bool Variables::getCurrentValueIfIndex(const VariableName_t& aName, const TimeIndex_t& Index, Value* aValue) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
 
   return (it != m_Data.end() &&
           it->second.first.getCurrentIndex() == Index && it->second.first.getCurrentValue(aValue));
@@ -273,7 +516,17 @@ bool Variables::getCurrentValueIfIndex(const VariableName_t& aName, const TimeIn
 
 bool Variables::isVariableExist(const VariableName_t& aName) const
 {
-  return m_Data.find(aName) != m_Data.end();
+  return findVariable(aName) != m_Data.end();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::isVariableExist(SymbolID_t aSymbol) const
+{
+  return m_Data.find(aSymbol) != m_Data.end();
 }
 
 
@@ -284,7 +537,19 @@ bool Variables::isVariableExist(const VariableName_t& aName) const
 bool Variables::isVariableExist(const VariableName_t& aName,
                                 const TimeIndex_t& anIndex) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && it->second.first.isValueExist(anIndex));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::isVariableExist(SymbolID_t aSymbol, const TimeIndex_t& anIndex) const
+{
+  VariablesMap_t::const_iterator it = m_Data.find(aSymbol);
 
   return (it != m_Data.end() && it->second.first.isValueExist(anIndex));
 }
@@ -297,7 +562,7 @@ bool Variables::isVariableExist(const VariableName_t& aName,
 bool Variables::isVariableExist(const VariableName_t& aName, const TimeIndex_t& anIndex,
     Value::Type ValueType) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
 
   return (it != m_Data.end() &&
           it->second.first.isValueExist(anIndex) && it->second.first.value(anIndex)->getType() == ValueType);
@@ -310,7 +575,19 @@ bool Variables::isVariableExist(const VariableName_t& aName, const TimeIndex_t&
 
 bool Variables::isTypedVariableExist(const VariableName_t& aName, const Value::Type& VarType) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && it->second.second == VarType);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::isTypedVariableExist(SymbolID_t aSymbol, const Value::Type& VarType) const
+{
+  VariablesMap_t::const_iterator it = m_Data.find(aSymbol);
 
   return (it != m_Data.end() && it->second.second == VarType);
 }
@@ -323,7 +600,7 @@ bool Variables::isTypedVariableExist(const VariableName_t& aName, const Value::T
 bool Variables::isTypedVariableExist(const VariableName_t& aName,
                                      const TimeIndex_t& anIndex, const Value::Type& VarType) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
 
   return (it != m_Data.end() && it->second.first.isValueExist(anIndex) && it->second.second == VarType);
 }
@@ -336,12 +613,16 @@ bool Variables::isTypedVariableExist(const VariableName_t& aName,
 std::vector<VariableName_t> Variables::getVariablesNames() const
 {
   std::vector<VariableName_t> TheNames;
+  TheNames.reserve(m_Data.size());
 
   for (VariablesMap_t::const_iterator it = m_Data.begin(); it != m_Data.end(); ++it)
   {
-    TheNames.push_back(it->first);
+    TheNames.push_back(SymbolsTable::name(it->first));
   }
 
+  // variables are stored by symbol, names are sorted to keep the alphabetical order
+  std::sort(TheNames.begin(),TheNames.end());
+
   return TheNames;
 }
 
@@ -350,10 +631,84 @@ std::vector<VariableName_t> Variables::getVariablesNames() const
 // =====================================================================
 
 
+bool Variables::shareVariable(const VariableName_t& aName, const ValuesBuffer& Source)
+{
+  VariablesMap_t::iterator it = findVariable(aName);
+
+  if (it == m_Data.end())
+  {
+    return false;
+  }
+
+  it->second.first.shareStorage(Source);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::isSharedVariable(const VariableName_t& aName) const
+{
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && it->second.first.isSharedStorage());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::setVariableStoragePrecision(const VariableName_t& aName,
+                                            ValuesBuffer::StoragePrecision Precision, double Scale)
+{
+  VariablesMap_t::iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && it->second.first.setStoragePrecision(Precision,Scale));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::setVariableStoragePrecision(SymbolID_t aSymbol,
+                                            ValuesBuffer::StoragePrecision Precision, double Scale)
+{
+  VariablesMap_t::iterator it = m_Data.find(aSymbol);
+
+  return (it != m_Data.end() && it->second.first.setStoragePrecision(Precision,Scale));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+double Variables::getVariableStorageMaxError(const VariableName_t& aName) const
+{
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  if (it == m_Data.end())
+  {
+    return 0.0;
+  }
+
+  return it->second.first.getStorageMaxError();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 int Variables::getVariableValuesCount(const VariableName_t& aName) const
 {
 
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
 
   if (it == m_Data.end())
   {
@@ -368,13 +723,42 @@ int Variables::getVariableValuesCount(const VariableName_t& aName) const
 // =====================================================================
 
 
+Value::Type Variables::getVariableType(const VariableName_t& aName) const
+{
+  VariablesMap_t::const_iterator it = findVariable(aName);
+
+  if (it == m_Data.end())
+  {
+    return Value::NONE;
+  }
+
+  return it->second.second;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::clearVariableValues(const VariableName_t& aName)
+{
+  VariablesMap_t::iterator it = findVariable(aName);
+
+  return (it != m_Data.end() && it->second.first.clearValues());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 bool Variables::checkAllVariablesCount(unsigned int Count, VariableName_t& ErrorVarName) const
 {
   for (VariablesMap_t::const_iterator it = m_Data.begin(); it != m_Data.end(); ++it)
   {
     if (it->second.first.getValuesCount() != Count)
     {
-      ErrorVarName = it->first;
+      ErrorVarName = SymbolsTable::name(it->first);
       return false;
     }
   }
@@ -399,7 +783,7 @@ void Variables::clear()
 
 void Variables::displayContent(const VariableName_t& aName, std::ostream& OStream) const
 {
-  VariablesMap_t::const_iterator it = m_Data.find(aName);
+  VariablesMap_t::const_iterator it = findVariable(aName);
 
   if (it != m_Data.end())
   {
@@ -44,6 +44,7 @@
 #include <openfluid/dllexport.hpp>
 #include <openfluid/core/TypeDefs.hpp>
 #include <openfluid/core/ValuesBuffer.hpp>
+#include <openfluid/core/SymbolsTable.hpp>
 
 
 namespace openfluid { namespace core {
@@ -53,10 +54,14 @@ class OPENFLUID_API Variables
 {
   private:
 
-    typedef std::map<VariableName_t, std::pair<ValuesBuffer,Value::Type> > VariablesMap_t;
+    typedef std::map<SymbolID_t, std::pair<ValuesBuffer,Value::Type> > VariablesMap_t;
 
     VariablesMap_t m_Data;
 
+    VariablesMap_t::iterator findVariable(const VariableName_t& aName);
+
+    VariablesMap_t::const_iterator findVariable(const VariableName_t& aName) const;
+
 
   public:
 
@@ -64,18 +69,82 @@ class OPENFLUID_API Variables
 
     bool createVariable(const VariableName_t& aName, const Value::Type& aType);
 
+    /**
+      Creates the variable given by its interned name, avoiding the name lookup
+      @see openfluid::core::SymbolsTable
+    */
+    bool createVariable(SymbolID_t aSymbol, const Value::Type& aType);
+
     bool modifyValue(const VariableName_t& aName, const TimeIndex_t& anIndex, const Value& aValue);
 
+    bool modifyValue(const VariableName_t& aName, const TimeIndex_t& anIndex, std::unique_ptr<Value>&& aValue);
+
     bool modifyCurrentValue(const VariableName_t& aName, const Value& aValue);
 
+    bool modifyCurrentValue(const VariableName_t& aName, std::unique_ptr<Value>&& aValue);
+
     bool appendValue(const VariableName_t& aName, const TimeIndex_t& anIndex, const Value& aValue);
 
+    bool appendValue(const VariableName_t& aName, const TimeIndex_t& anIndex, std::unique_ptr<Value>&& aValue);
+
+    /**
+      Appends a value to the variable given by its interned name, avoiding the name lookup
+      @see openfluid::core::SymbolsTable
+    */
+    bool appendValue(SymbolID_t aSymbol, const TimeIndex_t& anIndex, const Value& aValue);
+
+    bool appendValue(SymbolID_t aSymbol, const TimeIndex_t& anIndex, std::unique_ptr<Value>&& aValue);
+
+    bool modifyCurrentValue(SymbolID_t aSymbol, const Value& aValue);
+
+    /**
+      Makes the given existing variable a read-only view on the values stored in the source buffer,
+      so that a single storage can serve the same values to several variables
+      @param[in] aName the name of the variable
+      @param[in] Source the buffer providing the values
+      @return false if the variable does not exist
+    */
+    bool shareVariable(const VariableName_t& aName, const ValuesBuffer& Source);
+
+    /**
+      Returns true if the given variable is a read-only view on values shared with other variables
+    */
+    bool isSharedVariable(const VariableName_t& aName) const;
+
+    /**
+      Sets the storage precision of the double values of the given existing variable
+      @param[in] aName the name of the variable
+      @param[in] Precision the storage precision
+      @param[in] Scale the scale of the stored values, used only for the FIXED precision
+      @return false if the variable does not exist or if the precision cannot be set
+      @see openfluid::core::ValuesBuffer::setStoragePrecision
+    */
+    bool setVariableStoragePrecision(const VariableName_t& aName,
+                                     ValuesBuffer::StoragePrecision Precision, double Scale = 1.0);
+
+    bool setVariableStoragePrecision(SymbolID_t aSymbol,
+                                     ValuesBuffer::StoragePrecision Precision, double Scale = 1.0);
+
+    /**
+      Returns the maximum absolute difference between the double values appended to the given variable
+      and their stored representation, 0 if the variable does not exist
+    */
+    double getVariableStorageMaxError(const VariableName_t& aName) const;
+
     bool getValue(const VariableName_t& aName, const TimeIndex_t& anIndex,Value* aValue) const;
 
     const Value* value(const VariableName_t& aName, const TimeIndex_t& anIndex) const;
 
     const Value* currentValue(const VariableName_t& aName) const;
 
+    /**
+      Returns the value of the variable given by its interned name at the given index
+      @see openfluid::core::SymbolsTable
+    */
+    const Value* value(SymbolID_t aSymbol, const TimeIndex_t& anIndex) const;
+
+    const Value* currentValue(SymbolID_t aSymbol) const;
+
     bool getCurrentValue(const VariableName_t& aName, Value* aValue) const;
 
     bool getLatestIndexedValue(const VariableName_t& aName, IndexedValue& IndValue) const;
@@ -87,10 +156,23 @@ class OPENFLUID_API Variables
                           const TimeIndex_t& aBeginIndex, const TimeIndex_t& anEndIndex,
                           IndexedValueList& IndValueList) const;
 
+    const IndexedValue* latestIndexedValue(const VariableName_t& aName) const;
+
+    const IndexedValue* latestIndexedValue(SymbolID_t aSymbol) const;
+
+    bool getLatestIndexedValuesView(const VariableName_t& aName, const TimeIndex_t& anIndex,
+                                    IndexedValuesView& View) const;
+
+    bool getIndexedValuesView(const VariableName_t& aName,
+                              const TimeIndex_t& aBeginIndex, const TimeIndex_t& anEndIndex,
+                              IndexedValuesView& View) const;
+
     bool getCurrentValueIfIndex(const VariableName_t& aName, const TimeIndex_t& Index, Value* aValue) const;
 
     Value* currentValueIfIndex(const VariableName_t& aName, const TimeIndex_t& Index) const;
 
+    Value* currentValueIfIndex(SymbolID_t aSymbol, const TimeIndex_t& Index) const;
+
     bool isVariableExist(const VariableName_t& aName) const;
 
     bool isVariableExist(const VariableName_t& aName, const TimeIndex_t& anIndex) const;
@@ -103,10 +185,32 @@ class OPENFLUID_API Variables
     bool isTypedVariableExist(const VariableName_t& aName,
                               const TimeIndex_t& anIndex, const Value::Type& VarType) const;
 
+    bool isVariableExist(SymbolID_t aSymbol) const;
+
+    bool isVariableExist(SymbolID_t aSymbol, const TimeIndex_t& anIndex) const;
+
+    bool isTypedVariableExist(SymbolID_t aSymbol, const Value::Type& VarType) const;
+
     std::vector<VariableName_t> getVariablesNames() const;
 
+    inline std::size_t getVariablesCount() const
+    {
+      return m_Data.size();
+    }
+
     int getVariableValuesCount(const VariableName_t& aName) const;
 
+    /**
+      Returns the type of the given variable, openfluid::core::Value::NONE if the variable does not exist
+    */
+    Value::Type getVariableType(const VariableName_t& aName) const;
+
+    /**
+      Removes all values of the given variable, keeping the variable
+      @return false if the variable does not exist or if it is a read-only view on shared values
+    */
+    bool clearVariableValues(const VariableName_t& aName);
+
     bool checkAllVariablesCount(unsigned int Count, VariableName_t& ErrorVarName) const;
 
     void clear();
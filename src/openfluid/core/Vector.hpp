@@ -46,6 +46,7 @@
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/core/ArrayKernels.hpp>
 
 
 namespace openfluid { namespace core {
@@ -89,6 +90,11 @@ class OPENFLUID_API Vector
     */
     Vector(const Vector& Other);
 
+    /**
+      Move constructor, takes the data of the other vector which is left empty
+    */
+    Vector(Vector&& Other) noexcept;
+
     /**
       Constructor, creates a vector containing Size elements
     */
@@ -110,9 +116,9 @@ class OPENFLUID_API Vector
     Vector<T>& operator=(const Vector& Other);
 
     /**
-      Move assignment operator
+      Move assignment operator, takes the data of the other vector which is left empty
     */
-    Vector<T>& operator=(Vector&& Other);
+    Vector<T>& operator=(Vector&& Other) noexcept;
 
     /**
       Destructor
@@ -203,6 +209,51 @@ class OPENFLUID_API Vector
     */
     void clear();
 
+    /**
+      Adds element-wise the elements of another vector of the same size
+    */
+    Vector<T>& operator+=(const Vector& Other);
+
+    /**
+      Subtracts element-wise the elements of another vector of the same size
+    */
+    Vector<T>& operator-=(const Vector& Other);
+
+    /**
+      Multiplies all elements by the given factor
+    */
+    Vector<T>& operator*=(const T& Factor);
+
+    /**
+      Adds to this vector the vector X of the same size multiplied by Alpha (this = Alpha * X + this)
+    */
+    void axpy(const T& Alpha, const Vector& X);
+
+    /**
+      Clamps all elements between Low and High values
+    */
+    void clamp(const T& Low, const T& High);
+
+    /**
+      Returns the sum of the elements
+    */
+    T sum() const;
+
+    /**
+      Returns the dot product with another vector of the same size
+    */
+    T dot(const Vector& Other) const;
+
+    /**
+      Returns the minimum element of the vector, which must not be empty
+    */
+    T minElement() const;
+
+    /**
+      Returns the maximum element of the vector, which must not be empty
+    */
+    T maxElement() const;
+
     /**
       Returns an iterator referring to the first element in the vector
       @return an iterator to the first element in the vector
@@ -275,6 +326,18 @@ Vector<T>::Vector(const Vector& Other)
 // =====================================================================
 
 
+template <class T>
+Vector<T>::Vector(Vector&& Other) noexcept :
+  m_Data(std::move(Other.m_Data)), m_Size(Other.m_Size)
+{
+  Other.m_Size = 0;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 template <class T>
 Vector<T>::Vector(unsigned long Size)
 {
@@ -336,8 +399,11 @@ Vector<T>& Vector<T>::operator=(const Vector& Other)
 {
   if (this != &Other) // in case somebody tries assign array to itself
   {
-    clear();
-    allocate(Other.m_Size);
+    if (m_Size != Other.m_Size || !m_Data) // existing storage is reused when sizes match
+    {
+      clear();
+      allocate(Other.m_Size);
+    }
     std::copy(Other.m_Data.get(), Other.m_Data.get() + Other.m_Size, m_Data.get());
   }
 
@@ -350,18 +416,16 @@ Vector<T>& Vector<T>::operator=(const Vector& Other)
 
 
 template <class T>
-Vector<T>& Vector<T>::operator=(Vector&& Other)
+Vector<T>& Vector<T>::operator=(Vector&& Other) noexcept
 {
   if (this != &Other) // in case somebody tries assign array to itself
   {
-    clear();
-
     m_Size = Other.m_Size;
     m_Data = std::move(Other.m_Data);
 
-    Other.clear();
+    Other.m_Size = 0;
   }
- 
+
   return *this;
 }
 
@@ -496,6 +560,141 @@ void Vector<T>::clear()
 // =====================================================================
 
 
+template <class T>
+Vector<T>& Vector<T>::operator+=(const Vector& Other)
+{
+  if (m_Size != Other.m_Size)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"vectors sizes mismatch");
+  }
+
+  kernels::add(m_Data.get(),Other.m_Data.get(),m_Data.get(),m_Size);
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+Vector<T>& Vector<T>::operator-=(const Vector& Other)
+{
+  if (m_Size != Other.m_Size)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"vectors sizes mismatch");
+  }
+
+  kernels::subtract(m_Data.get(),Other.m_Data.get(),m_Data.get(),m_Size);
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+Vector<T>& Vector<T>::operator*=(const T& Factor)
+{
+  kernels::scale(m_Data.get(),Factor,m_Data.get(),m_Size);
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Vector<T>::axpy(const T& Alpha, const Vector& X)
+{
+  if (m_Size != X.m_Size)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"vectors sizes mismatch");
+  }
+
+  kernels::axpy(Alpha,X.m_Data.get(),m_Data.get(),m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Vector<T>::clamp(const T& Low, const T& High)
+{
+  kernels::clamp(m_Data.get(),Low,High,m_Data.get(),m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Vector<T>::sum() const
+{
+  return kernels::sum(m_Data.get(),m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Vector<T>::dot(const Vector& Other) const
+{
+  if (m_Size != Other.m_Size)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"vectors sizes mismatch");
+  }
+
+  return kernels::dot(m_Data.get(),Other.m_Data.get(),m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Vector<T>::minElement() const
+{
+  if (!m_Size)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"vector is empty");
+  }
+
+  return kernels::minElement(m_Data.get(),m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Vector<T>::maxElement() const
+{
+  if (!m_Size)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"vector is empty");
+  }
+
+  return kernels::maxElement(m_Data.get(),m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 template <class T>
 void Vector<T>::copy(const Vector& Source, Vector& Dest)
 {
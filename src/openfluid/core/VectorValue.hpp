@@ -103,9 +103,9 @@ class OPENFLUID_API VectorValue : public CompoundValue, public Vector<double>
     /**
       Move constructor
     */
-    VectorValue(VectorValue&& Val) :
+    VectorValue(VectorValue&& Val) noexcept :
       CompoundValue(),
-      Vector<double>(std::move(static_cast<const Vector<double>&>(Val)))
+      Vector<double>(static_cast<Vector<double>&&>(Val))
     { }
 
     /**
@@ -0,0 +1,441 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file ArrayKernels_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_arraykernels
+
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/tools/floating_point_comparison.hpp>
+
+#include <openfluid/core/ArrayKernels.hpp>
+#include <openfluid/core/VectorValue.hpp>
+#include <openfluid/core/MatrixValue.hpp>
+
+
+// sizes chosen to exercise both the packed parts and the scalar tails of the kernels
+const std::vector<unsigned long> Sizes = {0,1,2,3,7,8,9,16,31,200,1001};
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_elementwise)
+{
+  std::cout << "Instruction set: " << openfluid::core::kernels::getInstructionSet() << std::endl;
+
+  for (auto Size : Sizes)
+  {
+    std::vector<double> A(Size),B(Size),R(Size);
+
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      A[i] = i*0.5;
+      B[i] = 1.0+i;
+    }
+
+    openfluid::core::kernels::add(A.data(),B.data(),R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]+B[i]);
+    }
+
+    openfluid::core::kernels::subtract(A.data(),B.data(),R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]-B[i]);
+    }
+
+    openfluid::core::kernels::multiply(A.data(),B.data(),R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]*B[i]);
+    }
+
+    openfluid::core::kernels::divide(A.data(),B.data(),R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]/B[i]);
+    }
+
+    openfluid::core::kernels::addScalar(A.data(),2.5,R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]+2.5);
+    }
+
+    openfluid::core::kernels::scale(A.data(),-3.0,R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]*-3.0);
+    }
+
+    R = B;
+    openfluid::core::kernels::axpy(2.0,A.data(),R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],2.0*A[i]+B[i]);
+    }
+
+    openfluid::core::kernels::clamp(A.data(),10.0,50.0,R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],std::min(std::max(A[i],10.0),50.0));
+    }
+
+    // in place
+    R = A;
+    openfluid::core::kernels::add(R.data(),B.data(),R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]+B[i]);
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_reductions)
+{
+  for (auto Size : Sizes)
+  {
+    std::vector<double> A(Size),B(Size);
+    double Sum = 0.0, Dot = 0.0;
+
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      A[i] = ((i*7)%13)-6.0;
+      B[i] = 0.5*i;
+      Sum += A[i];
+      Dot += A[i]*B[i];
+    }
+
+    BOOST_REQUIRE_CLOSE(openfluid::core::kernels::sum(A.data(),Size)+1.0,Sum+1.0,0.000001);
+    BOOST_REQUIRE_CLOSE(openfluid::core::kernels::dot(A.data(),B.data(),Size)+1.0,Dot+1.0,0.000001);
+
+    if (Size)
+    {
+      BOOST_REQUIRE_EQUAL(openfluid::core::kernels::minElement(A.data(),Size),*std::min_element(A.begin(),A.end()));
+      BOOST_REQUIRE_EQUAL(openfluid::core::kernels::maxElement(A.data(),Size),*std::max_element(A.begin(),A.end()));
+    }
+  }
+
+  // non packed types
+  std::vector<long> L = {3,-8,12,5,0};
+  BOOST_REQUIRE_EQUAL(openfluid::core::kernels::sum(L.data(),L.size()),12);
+  BOOST_REQUIRE_EQUAL(openfluid::core::kernels::minElement(L.data(),L.size()),-8);
+  BOOST_REQUIRE_EQUAL(openfluid::core::kernels::maxElement(L.data(),L.size()),12);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_nan)
+{
+  const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  // NaN positions at the beginning, inside and at the end of the packed part, and in the scalar tail
+  const unsigned long Size = 37;
+  const std::vector<unsigned long> Positions = {0,5,31,32,35,36};
+
+  for (auto Pos : Positions)
+  {
+    std::vector<double> A(Size),R(Size);
+
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      A[i] = i-10.0;
+    }
+    A[Pos] = NaN;
+
+    openfluid::core::kernels::clamp(A.data(),-5.0,5.0,R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      if (i == Pos)
+      {
+        BOOST_REQUIRE(std::isnan(R[i]));
+      }
+      else
+      {
+        BOOST_REQUIRE_EQUAL(R[i],std::min(std::max(A[i],-5.0),5.0));
+      }
+    }
+
+    BOOST_REQUIRE(std::isnan(openfluid::core::kernels::minElement(A.data(),Size)));
+    BOOST_REQUIRE(std::isnan(openfluid::core::kernels::maxElement(A.data(),Size)));
+    BOOST_REQUIRE(std::isnan(openfluid::core::kernels::sum(A.data(),Size)));
+
+    // non packed types behave the same
+    std::vector<float> F(A.begin(),A.end());
+    BOOST_REQUIRE(std::isnan(openfluid::core::kernels::minElement(F.data(),Size)));
+    BOOST_REQUIRE(std::isnan(openfluid::core::kernels::maxElement(F.data(),Size)));
+  }
+
+  // small arrays processed by the scalar part only
+  std::vector<double> Small = {1.0,NaN};
+  BOOST_REQUIRE(std::isnan(openfluid::core::kernels::minElement(Small.data(),Small.size())));
+  BOOST_REQUIRE(std::isnan(openfluid::core::kernels::maxElement(Small.data(),Small.size())));
+  BOOST_REQUIRE_EQUAL(openfluid::core::kernels::minElement(Small.data(),1),1.0);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_supported_instruction_sets)
+{
+  const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  const auto& Supported = openfluid::core::kernels::detail::getSupportedDoubleKernels();
+  BOOST_REQUIRE(!Supported.empty());
+  BOOST_REQUIRE_EQUAL(std::string(Supported.front().ISA),
+                      std::string(openfluid::core::kernels::getInstructionSet()));
+
+  const unsigned long Size = 37;
+  std::vector<double> A(Size),B(Size);
+
+  for (unsigned long i = 0; i < Size; i++)
+  {
+    A[i] = i*0.5-7.0;
+    B[i] = i+1.0;
+  }
+
+  for (const auto& K : Supported)
+  {
+    std::cout << "Checking instruction set: " << K.ISA << std::endl;
+
+    std::vector<double> R(Size),Y(B);
+
+    K.Add(A.data(),B.data(),R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]+B[i]);
+    }
+
+    K.Subtract(A.data(),B.data(),R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]-B[i]);
+    }
+
+    K.Multiply(A.data(),B.data(),R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]*B[i]);
+    }
+
+    K.Divide(A.data(),B.data(),R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]/B[i]);
+    }
+
+    K.AddScalar(A.data(),3.0,R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]+3.0);
+    }
+
+    K.Scale(A.data(),2.5,R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],A[i]*2.5);
+    }
+
+    K.Axpy(2.0,A.data(),Y.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(Y[i],2.0*A[i]+B[i]);
+    }
+
+    K.Clamp(A.data(),-2.0,3.0,R.data(),Size);
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      BOOST_REQUIRE_EQUAL(R[i],std::min(std::max(A[i],-2.0),3.0));
+    }
+
+    double Sum = 0.0, Dot = 0.0;
+    for (unsigned long i = 0; i < Size; i++)
+    {
+      Sum += A[i];
+      Dot += A[i]*B[i];
+    }
+    BOOST_REQUIRE_CLOSE(K.Sum(A.data(),Size),Sum,0.000001);
+    BOOST_REQUIRE_CLOSE(K.Dot(A.data(),B.data(),Size),Dot,0.000001);
+    BOOST_REQUIRE_EQUAL(K.MinElement(A.data(),Size),*std::min_element(A.begin(),A.end()));
+    BOOST_REQUIRE_EQUAL(K.MaxElement(A.data(),Size),*std::max_element(A.begin(),A.end()));
+
+    // 3 columns of 11 rows, columns are longer than any pack
+    const unsigned long ColsNbr = 3, RowsNbr = 11;
+    std::vector<double> X(A.begin(),A.begin()+ColsNbr),G(RowsNbr);
+    K.Gemv(B.data(),ColsNbr,RowsNbr,X.data(),G.data());
+    for (unsigned long r = 0; r < RowsNbr; r++)
+    {
+      double Expected = 0.0;
+      for (unsigned long c = 0; c < ColsNbr; c++)
+      {
+        Expected += B[c*RowsNbr+r]*X[c];
+      }
+      BOOST_REQUIRE_CLOSE(G[r],Expected,0.000001);
+    }
+
+    // NaN in the packed part and in the scalar tail
+    for (auto Pos : {3ul,Size-1})
+    {
+      std::vector<double> N(A);
+      N[Pos] = NaN;
+
+      BOOST_REQUIRE(std::isnan(K.MinElement(N.data(),Size)));
+      BOOST_REQUIRE(std::isnan(K.MaxElement(N.data(),Size)));
+      BOOST_REQUIRE(std::isnan(K.Sum(N.data(),Size)));
+
+      K.Clamp(N.data(),-2.0,3.0,R.data(),Size);
+      BOOST_REQUIRE(std::isnan(R[Pos]));
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_vector_members)
+{
+  openfluid::core::VectorValue V1(203,2.0), V2(203,0.5);
+
+  V1 += V2;
+  BOOST_REQUIRE_EQUAL(V1.at(202),2.5);
+  V1 -= V2;
+  BOOST_REQUIRE_EQUAL(V1.at(0),2.0);
+  V1 *= 3.0;
+  BOOST_REQUIRE_EQUAL(V1.at(101),6.0);
+  V1.axpy(2.0,V2);
+  BOOST_REQUIRE_EQUAL(V1.at(7),7.0);
+
+  BOOST_REQUIRE_CLOSE(V1.sum(),7.0*203,0.000001);
+  BOOST_REQUIRE_CLOSE(V1.dot(V2),3.5*203,0.000001);
+
+  V1.set(50,-1.0);
+  V1.set(150,20.0);
+  BOOST_REQUIRE_EQUAL(V1.minElement(),-1.0);
+  BOOST_REQUIRE_EQUAL(V1.maxElement(),20.0);
+
+  V1.clamp(0.0,10.0);
+  BOOST_REQUIRE_EQUAL(V1.minElement(),0.0);
+  BOOST_REQUIRE_EQUAL(V1.maxElement(),10.0);
+
+  openfluid::core::VectorValue V3(10);
+  BOOST_REQUIRE_THROW(V1 += V3,openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(V1.dot(V3),openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(openfluid::core::VectorValue().minElement(),openfluid::base::FrameworkException);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_matrix_members)
+{
+  const unsigned long ColsNbr = 5;
+  const unsigned long RowsNbr = 7;
+
+  openfluid::core::MatrixValue M(ColsNbr,RowsNbr);
+  openfluid::core::VectorValue X(ColsNbr), Y;
+
+  for (unsigned long c = 0; c < ColsNbr; c++)
+  {
+    X.set(c,c+1.0);
+
+    for (unsigned long r = 0; r < RowsNbr; r++)
+    {
+      M.set(c,r,c*10.0+r);
+    }
+  }
+
+  M.multiply(X,Y);
+  BOOST_REQUIRE_EQUAL(Y.size(),RowsNbr);
+
+  for (unsigned long r = 0; r < RowsNbr; r++)
+  {
+    double Expected = 0.0;
+
+    for (unsigned long c = 0; c < ColsNbr; c++)
+    {
+      Expected += M.get(c,r)*X.get(c);
+    }
+
+    BOOST_REQUIRE_CLOSE(Y.get(r),Expected,0.000001);
+  }
+
+  BOOST_REQUIRE_THROW(M.multiply(Y,X),openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(M.multiply(X,X),openfluid::base::FrameworkException);
+
+  openfluid::core::MatrixValue M2(ColsNbr,RowsNbr,1.0);
+  M += M2;
+  BOOST_REQUIRE_EQUAL(M.get(4,6),47.0);
+  M *= 2.0;
+  BOOST_REQUIRE_EQUAL(M.get(4,6),94.0);
+  M -= M2;
+  BOOST_REQUIRE_EQUAL(M.get(0,0),1.0);
+  BOOST_REQUIRE_EQUAL(M.minElement(),1.0);
+  BOOST_REQUIRE_EQUAL(M.maxElement(),93.0);
+
+  M.clamp(10.0,20.0);
+  BOOST_REQUIRE_EQUAL(M.minElement(),10.0);
+  BOOST_REQUIRE_EQUAL(M.maxElement(),20.0);
+
+  BOOST_REQUIRE_THROW(M += openfluid::core::MatrixValue(2,2),openfluid::base::FrameworkException);
+}
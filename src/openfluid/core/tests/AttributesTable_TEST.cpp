@@ -0,0 +1,284 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file AttributesTable_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_attributestable
+
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/tools/floating_point_comparison.hpp>
+
+#include <thread>
+#include <atomic>
+
+#include <openfluid/core/AttributesTable.hpp>
+#include <openfluid/core/SymbolsTable.hpp>
+#include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/core/StringValue.hpp>
+#include <openfluid/core/VectorValue.hpp>
+#include <openfluid/core/NullValue.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_operations)
+{
+  openfluid::core::AttributesTable Table;
+
+  const openfluid::core::SymbolID_t DblSym = openfluid::core::SymbolsTable::intern("dbl");
+  const openfluid::core::SymbolID_t StrSym = openfluid::core::SymbolsTable::intern("str");
+
+  std::size_t Row0 = Table.addRow();
+  std::size_t Row1 = Table.addRow();
+  std::size_t Row2 = Table.addRow();
+
+  BOOST_REQUIRE_EQUAL(Table.getRowsCount(),3);
+  BOOST_REQUIRE_EQUAL(Table.getColumnsCount(),0);
+  BOOST_REQUIRE(Table.value(DblSym,Row0) == nullptr);
+
+  Table.setValue(DblSym,Row0,openfluid::core::DoubleValue(1.5));
+  Table.setValue(DblSym,Row1,openfluid::core::IntegerValue(2));
+  Table.setValue(StrSym,Row1,openfluid::core::StringValue("foo"));
+
+  BOOST_REQUIRE_EQUAL(Table.getColumnsCount(),2);
+  BOOST_REQUIRE(Table.isValueExist(DblSym,Row0));
+  BOOST_REQUIRE(Table.isValueExist(DblSym,Row1));
+  BOOST_REQUIRE(!Table.isValueExist(DblSym,Row2));
+  BOOST_REQUIRE(!Table.isValueExist(StrSym,Row0));
+
+  // values keep their own type, even in a column of another type
+  BOOST_REQUIRE(Table.value(DblSym,Row0)->isDoubleValue());
+  BOOST_REQUIRE(Table.value(DblSym,Row1)->isIntegerValue());
+  BOOST_REQUIRE_EQUAL(Table.value(DblSym,Row1)->asIntegerValue().get(),2);
+  BOOST_REQUIRE_EQUAL(Table.value(StrSym,Row1)->asStringValue().get(),"foo");
+
+  Table.setValue(DblSym,Row2,openfluid::core::DoubleValue(3.5));
+  std::vector<double> Values;
+  BOOST_REQUIRE(Table.getColumnValues(DblSym,{Row2,Row1,Row0},Values));
+  BOOST_REQUIRE_EQUAL(Values.size(),3);
+  BOOST_REQUIRE_CLOSE(Values[0],3.5,0.0001);
+  BOOST_REQUIRE_CLOSE(Values[1],2.0,0.0001);
+  BOOST_REQUIRE_CLOSE(Values[2],1.5,0.0001);
+  BOOST_REQUIRE(!Table.getColumnValues(StrSym,{Row1},Values));
+  BOOST_REQUIRE(Values.empty());
+
+  Table.setValue(DblSym,Row1,openfluid::core::DoubleValue(2.5));
+  BOOST_REQUIRE(Table.value(DblSym,Row1)->isDoubleValue());
+
+  BOOST_REQUIRE(Table.unsetValue(DblSym,Row1));
+  BOOST_REQUIRE(!Table.unsetValue(DblSym,Row1));
+  BOOST_REQUIRE(!Table.getColumnValues(DblSym,{Row0,Row1},Values));
+
+  std::vector<openfluid::core::SymbolID_t> Symbols = Table.getSymbols(Row1);
+  BOOST_REQUIRE_EQUAL(Symbols.size(),1);
+  BOOST_REQUIRE_EQUAL(Symbols.front(),StrSym);
+
+  // removed rows are cleared and reused
+  Table.removeRow(Row1);
+  BOOST_REQUIRE(!Table.isValueExist(StrSym,Row1));
+  BOOST_REQUIRE_EQUAL(Table.addRow(),Row1);
+  BOOST_REQUIRE_EQUAL(Table.getRowsCount(),3);
+
+  openfluid::core::AttributesTable OtherTable;
+  std::size_t OtherRow = OtherTable.addRow();
+  Table.copyRow(Row0,OtherTable,OtherRow);
+  BOOST_REQUIRE_CLOSE(OtherTable.value(DblSym,OtherRow)->asDoubleValue().get(),1.5,0.0001);
+  BOOST_REQUIRE(!OtherTable.isValueExist(StrSym,OtherRow));
+
+  Table.clearRow(Row0);
+  BOOST_REQUIRE(Table.getSymbols(Row0).empty());
+  BOOST_REQUIRE(OtherTable.isValueExist(DblSym,OtherRow));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_spatialgraph)
+{
+  openfluid::core::SpatialGraph Graph;
+
+  openfluid::core::SpatialUnit Standalone("TU",100,1);
+  Standalone.attributes()->setValue("area",openfluid::core::DoubleValue(100.0));
+  Standalone.attributes()->setValue("name",openfluid::core::StringValue("standalone"));
+
+  for (unsigned int i=1; i<=10; i++)
+  {
+    openfluid::core::SpatialUnit* Unit = Graph.addUnit(openfluid::core::SpatialUnit("TU",i,11-i));
+    Unit->attributes()->setValue("area",openfluid::core::DoubleValue(i*10.0));
+    Unit->attributes()->setValueFromRawString("code",std::to_string(i));
+  }
+  Graph.addUnit(Standalone);
+  Graph.sortUnitsByProcessOrder();
+
+  const openfluid::core::UnitsCollection* Units = Graph.spatialUnits("TU");
+
+  BOOST_REQUIRE(Units->attributesTable() != nullptr);
+  BOOST_REQUIRE_EQUAL(Units->attributesTable()->getRowsCount(),11);
+
+  // the standalone unit is not bound to the class table
+  BOOST_REQUIRE_EQUAL(Standalone.attributes()->getAttributesNames().size(),2);
+  BOOST_REQUIRE_EQUAL(Graph.spatialUnit("TU",100)->attributes()->value("name")->asStringValue().get(),"standalone");
+  BOOST_REQUIRE(Graph.spatialUnit("TU",100)->attributes()->value("name") !=
+                Standalone.attributes()->value("name"));
+
+  std::vector<double> Values;
+  BOOST_REQUIRE(Units->getAttributeColumn("area",Values));
+  BOOST_REQUIRE_EQUAL(Values.size(),11);
+
+  auto ValIt = Values.begin();
+  for (const auto& Unit : *(Units->list()))
+  {
+    BOOST_REQUIRE_CLOSE(*ValIt,Unit.attributes()->value("area")->asDoubleValue().get(),0.0001);
+    ++ValIt;
+  }
+
+  BOOST_REQUIRE(!Units->getAttributeColumn("code",Values));
+  BOOST_REQUIRE(!Units->getAttributeColumn("wrong",Values));
+
+  Graph.spatialUnit("TU",100)->attributes()->setValue("code",openfluid::core::IntegerValue(100));
+  BOOST_REQUIRE(Units->getAttributeColumn("code",Values));
+  BOOST_REQUIRE_CLOSE(Values.front(),
+                      Units->list()->front().attributes()->value("code")->asIntegerValue().get(),0.0001);
+
+  // copied collections use their own table
+  openfluid::core::UnitsCollection CopiedUnits(*Units);
+  BOOST_REQUIRE(CopiedUnits.attributesTable() != Units->attributesTable());
+  CopiedUnits.spatialUnit(5)->attributes()->replaceValue("name",std::string("copied"));
+  BOOST_REQUIRE(!Graph.spatialUnit("TU",5)->attributes()->isAttributeExist("name"));
+  BOOST_REQUIRE(CopiedUnits.spatialUnit(100)->attributes()->replaceValue("name",std::string("copied")));
+  BOOST_REQUIRE_EQUAL(Graph.spatialUnit("TU",100)->attributes()->value("name")->asStringValue().get(),"standalone");
+  BOOST_REQUIRE_EQUAL(CopiedUnits.spatialUnit(100)->attributes()->value("name")->asStringValue().get(),"copied");
+
+  BOOST_REQUIRE(Graph.deleteUnit(Graph.spatialUnit("TU",3)));
+  Graph.addUnit(openfluid::core::SpatialUnit("TU",200,1));
+  BOOST_REQUIRE_EQUAL(Units->attributesTable()->getRowsCount(),11);
+  BOOST_REQUIRE(Graph.spatialUnit("TU",200)->attributes()->getAttributesNames().empty());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_concurrent_units)
+{
+  openfluid::core::SpatialGraph Graph;
+
+  const unsigned int UnitsCount = 400;
+  const unsigned int ThreadsCount = 4;
+
+  for (unsigned int i=1; i<=UnitsCount; i++)
+  {
+    Graph.addUnit(openfluid::core::SpatialUnit("TU",i,1));
+    Graph.spatialUnit("TU",i)->attributes()->setValue("area",openfluid::core::DoubleValue(i));
+  }
+
+  std::atomic<unsigned int> ErrorsCount(0);
+  std::vector<std::thread> Threads;
+
+  // each thread reads and sets attributes of its own units of the same class,
+  // new attributes and values of other types are created concurrently
+  for (unsigned int t=0; t<ThreadsCount; t++)
+  {
+    Threads.emplace_back([&Graph,&ErrorsCount,t,UnitsCount,ThreadsCount]()
+    {
+      for (unsigned int Loop=0; Loop<20; Loop++)
+      {
+        for (unsigned int i=1+t; i<=UnitsCount; i+=ThreadsCount)
+        {
+          openfluid::core::Attributes* Attrs = Graph.spatialUnit("TU",i)->attributes();
+
+          const std::string LoopName = "loop"+std::to_string(Loop%5);
+
+          Attrs->removeAttribute("area");
+          Attrs->setValue("area",openfluid::core::DoubleValue(i+Loop));
+          Attrs->removeAttribute(LoopName);
+          Attrs->setValue(LoopName,openfluid::core::IntegerValue(Loop));
+
+          if (Loop%2)
+          {
+            Attrs->removeAttribute("name");
+          }
+          else
+          {
+            Attrs->setValue("name",openfluid::core::StringValue(std::to_string(i)));
+          }
+
+          const openfluid::core::Value* Val = Attrs->value("area");
+          if (!Val || Val->asDoubleValue().get() != double(i+Loop))
+          {
+            ErrorsCount++;
+          }
+
+          Val = Attrs->value(LoopName);
+          if (!Val || Val->asIntegerValue().get() != long(Loop))
+          {
+            ErrorsCount++;
+          }
+
+          if ((Attrs->value("name") != nullptr) == bool(Loop%2))
+          {
+            ErrorsCount++;
+          }
+        }
+      }
+    });
+  }
+
+  for (auto& Th : Threads)
+  {
+    Th.join();
+  }
+
+  BOOST_REQUIRE_EQUAL(ErrorsCount,0);
+
+  for (unsigned int i=1; i<=UnitsCount; i++)
+  {
+    const openfluid::core::Attributes* Attrs = Graph.spatialUnit("TU",i)->attributes();
+
+    BOOST_REQUIRE_EQUAL(Attrs->value("area")->asDoubleValue().get(),double(i+19));
+    BOOST_REQUIRE_EQUAL(Attrs->value("loop4")->asIntegerValue().get(),19);
+    BOOST_REQUIRE(!Attrs->isAttributeExist("name"));
+  }
+}
@@ -0,0 +1,189 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file DateTimeFormat_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_datetimeformat
+
+
+#include <ctime>
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/core/DateTime.hpp>
+#include <openfluid/core/DateTimeFormat.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_construction)
+{
+  openfluid::core::DateTimeFormat Empty;
+  BOOST_REQUIRE(Empty.getFormatString().empty());
+  BOOST_REQUIRE(Empty.isCompiled());
+
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat::isoFormat().isCompiled());
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat::isoFormat().isFixedLayout());
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat::iso8601Format().isFixedLayout());
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat::compactFormat().isFixedLayout());
+  BOOST_REQUIRE_EQUAL(openfluid::core::DateTimeFormat::compactFormat().getFormatString(),"%Y%m%dT%H%M%S");
+
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat("%d/%m/%Y %Hh%Mm%Ss").isCompiled());
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat("%d/%m/%Y %Hh%Mm%Ss").isFixedLayout());
+  BOOST_REQUIRE(!openfluid::core::DateTimeFormat("%e/%m/%Y").isFixedLayout());
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat("%FT%T").isFixedLayout());
+  BOOST_REQUIRE(!openfluid::core::DateTimeFormat("%d %b %Y").isCompiled());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_parse)
+{
+  openfluid::core::DateTime DT;
+
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat::compactFormat().parse("20130806T173753",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2013,8,6,17,37,53));
+
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat::iso8601Format().parse("2013-08-06T17:37:53",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2013,8,6,17,37,53));
+
+  // fixed layout with trailing characters
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat::isoFormat().parse("2009-09-09 16:36:25 extra",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2009,9,9,16,36,25));
+
+  // fixed layout falling back to variable width fields
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat::isoFormat().parse("2009-9-9 6:36:5",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2009,9,9,6,36,5));
+
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat("%d/%m/%Y %Hh%Mm%Ss").parse("25/06/2012   12h35m06s",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2012,6,25,12,35,6));
+
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat("%Y#%m#%d%%%H#%M#%S").parse("2022#08#25%11#12#13",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2022,8,25,11,12,13));
+
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat("%D %R").parse("12/31/99 23:59",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(1999,12,31,23,59,0));
+
+  // missing fields
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat("%Y-%m").parse("2013-06",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2013,6,1,0,0,0));
+
+  // generic processing
+  BOOST_REQUIRE(openfluid::core::DateTimeFormat("%d %b %Y").parse("25 Jun 2012",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2012,6,25,0,0,0));
+
+  // errors, date-time is left unchanged
+  BOOST_REQUIRE(!openfluid::core::DateTimeFormat::compactFormat().parse("2013-08-06T17:37:53",DT));
+  BOOST_REQUIRE(!openfluid::core::DateTimeFormat::isoFormat().parse("2013-02-30 00:00:00",DT));
+  BOOST_REQUIRE(!openfluid::core::DateTimeFormat::isoFormat().parse("",DT));
+  BOOST_REQUIRE(!openfluid::core::DateTimeFormat("%d %Hh%Mm%Ss").parse("2013-06-25",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2012,6,25,0,0,0));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_format)
+{
+  const std::vector<std::string> Formats = {
+    "%Y-%m-%d %H:%M:%S","%Y-%m-%dT%H:%M:%S","%Y%m%dT%H%M%S","%Y%m%d-%H%M%S","%Y-%m-%dT%H:%M:%SZ",
+    "%d/%m/%y %Hh%Mm%Ss","%F %T","%D %R","%e|%%|%n|%t","%A %d %B %Y %j"
+  };
+
+  openfluid::core::DateTime DT(1987,3,4,5,6,7);
+  std::string Str;
+
+  for (unsigned int i = 0; i < 400; i++)
+  {
+    for (const auto& F : Formats)
+    {
+      const openfluid::core::DateTimeFormat Format(F);
+
+      std::tm TM = {};
+      TM.tm_year = DT.getYear()-1900;
+      TM.tm_mon = DT.getMonth()-1;
+      TM.tm_mday = DT.getDay();
+      TM.tm_hour = DT.getHour();
+      TM.tm_min = DT.getMinute();
+      TM.tm_sec = DT.getSecond();
+      std::mktime(&TM);
+
+      char Expected[256];
+      strftime(Expected,sizeof(Expected),F.c_str(),&TM);
+
+      if (Format.isCompiled())
+      {
+        Format.format(DT,Str);
+        BOOST_REQUIRE_EQUAL(Str,std::string(Expected));
+      }
+
+      BOOST_REQUIRE_EQUAL(DT.getAsString(F),Format.format(DT));
+    }
+
+    DT.addSeconds(86400*37+3671);
+  }
+
+  // round trip
+  for (const auto& F : {"%Y-%m-%d %H:%M:%S","%Y%m%dT%H%M%S","%d/%m/%Y %Hh%Mm%Ss"})
+  {
+    const openfluid::core::DateTimeFormat Format(F);
+    openfluid::core::DateTime ParsedDT;
+
+    BOOST_REQUIRE(Format.parse(Format.format(DT),ParsedDT));
+    BOOST_REQUIRE(ParsedDT == DT);
+  }
+
+  // buffer too small
+  char SmallBuffer[8];
+  BOOST_REQUIRE_EQUAL(openfluid::core::DateTimeFormat::isoFormat().format(DT,SmallBuffer,sizeof(SmallBuffer)),0);
+  char Buffer[32];
+  BOOST_REQUIRE_EQUAL(openfluid::core::DateTimeFormat::compactFormat().format(DT,Buffer,sizeof(Buffer)),15);
+  BOOST_REQUIRE_EQUAL(std::string(Buffer),DT.getAsString("%Y%m%dT%H%M%S"));
+
+  // years out of the 4 digits range
+  BOOST_REQUIRE_EQUAL(openfluid::core::DateTime(999,1,2,3,4,5).getAsISOString(),"999-01-02 03:04:05");
+}
@@ -150,3 +150,207 @@ BOOST_AUTO_TEST_CASE(check_operations)
   delete SGraph;
 }
 
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_bulk_operations)
+{
+  openfluid::core::SpatialGraph SGraph;
+  openfluid::core::SpatialUnit* U;
+
+
+  // *** explicit matrix
+  BOOST_REQUIRE(SGraph.buildUnitsMatrix("MU",5,7));
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnits("MU")->size(),35);
+  BOOST_REQUIRE_EQUAL(SGraph.allSpatialUnits()->size(),35);
+  BOOST_REQUIRE(!SGraph.buildUnitsMatrix("MU",2,2));
+
+  U = SGraph.spatialUnit("MU",1);
+  BOOST_REQUIRE_EQUAL(U->toSpatialUnits("MU")->size(),2);
+  BOOST_REQUIRE_EQUAL(U->fromSpatialUnits("MU")->size(),2);
+  BOOST_REQUIRE_EQUAL(U->toSpatialUnits("MU")->front()->getID(),2);
+  BOOST_REQUIRE_EQUAL(U->toSpatialUnits("MU")->back()->getID(),6);
+
+  U = SGraph.spatialUnit("MU",13);
+  BOOST_REQUIRE_EQUAL(U->toSpatialUnits("MU")->size(),4);
+  BOOST_REQUIRE_EQUAL(U->fromSpatialUnits("MU")->size(),4);
+
+  const openfluid::core::UnitsMatrixTopology* Topology = SGraph.unitsMatrixTopology("MU");
+  BOOST_REQUIRE(Topology != nullptr);
+  BOOST_REQUIRE_EQUAL(Topology->getColsNbr(),5);
+  BOOST_REQUIRE_EQUAL(Topology->getRowsNbr(),7);
+  BOOST_REQUIRE_EQUAL(Topology->getUnitID(2,2),13);
+
+  std::vector<openfluid::core::UnitID_t> ExpectedIDs = {12,14,8,18};
+  BOOST_REQUIRE(Topology->getNeighboursIDs(13) == ExpectedIDs);
+  ExpectedIDs = {34,30};
+  BOOST_REQUIRE(Topology->getNeighboursIDs(35) == ExpectedIDs);
+  BOOST_REQUIRE(Topology->getNeighboursIDs(36).empty());
+
+  unsigned int Col, Row;
+  BOOST_REQUIRE(Topology->getPosition(13,Col,Row));
+  BOOST_REQUIRE_EQUAL(Col,2);
+  BOOST_REQUIRE_EQUAL(Row,2);
+  BOOST_REQUIRE(!Topology->getPosition(0,Col,Row));
+
+
+  // *** implicit matrix
+  BOOST_REQUIRE(SGraph.buildUnitsMatrix("IU",300,200,3,false));
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnits("IU")->size(),60000);
+  BOOST_REQUIRE_EQUAL(SGraph.allSpatialUnits()->size(),60035);
+  U = SGraph.spatialUnit("IU",30150);
+  BOOST_REQUIRE(U != nullptr);
+  BOOST_REQUIRE_EQUAL(U->getProcessOrder(),3);
+  BOOST_REQUIRE(U->toSpatialUnits("IU") == nullptr);
+  BOOST_REQUIRE_EQUAL(SGraph.unitsMatrixTopology("IU")->getNeighboursIDs(30150).size(),4);
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("WrongClass") == nullptr);
+
+
+  // *** units with edge list
+  BOOST_REQUIRE(SGraph.addUnitsWithConnections("EU",{{1,2},{2,1},{3,3}},{{1,2},{2,3}}));
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnits("EU")->size(),3);
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnits("EU")->list()->front().getID(),2);
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnit("EU",2)->fromSpatialUnits("EU")->front()->getID(),1);
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnit("EU",2)->toSpatialUnits("EU")->front()->getID(),3);
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("EU") == nullptr);
+
+  BOOST_REQUIRE(!SGraph.addUnitsWithConnections("EU",{{3,1}},{}));
+  BOOST_REQUIRE(!SGraph.addUnitsWithConnections("EU",{{4,1}},{{4,5}}));
+
+
+  // *** deletion keeps the units index consistent and discards the matrix topology
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("MU") != nullptr);
+  BOOST_REQUIRE(SGraph.deleteUnit(SGraph.spatialUnit("MU",13)));
+  BOOST_REQUIRE(SGraph.spatialUnit("MU",13) == nullptr);
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnits("MU")->size(),34);
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnit("MU",12)->toSpatialUnits("MU")->size(),3);
+  BOOST_REQUIRE(SGraph.spatialUnit("MU",14) != nullptr);
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("MU") == nullptr);
+
+
+  // *** matrix topologies are discarded when the units or connections of their class change
+  BOOST_REQUIRE(SGraph.buildUnitsMatrix("AU",3,3));
+  BOOST_REQUIRE(SGraph.buildUnitsMatrix("BU",3,3));
+  BOOST_REQUIRE(SGraph.buildUnitsMatrix("CU",3,3));
+  BOOST_REQUIRE(SGraph.buildUnitsMatrix("DU",3,3));
+
+  BOOST_REQUIRE(SGraph.addUnit(openfluid::core::SpatialUnit("AU",10,1)) != nullptr);
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("AU") == nullptr);
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("BU") != nullptr);
+
+  BOOST_REQUIRE(SGraph.insertUnit(openfluid::core::SpatialUnit("BU",10,1)) != nullptr);
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("BU") == nullptr);
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("CU") != nullptr);
+
+  BOOST_REQUIRE(SGraph.addFromToConnection(SGraph.spatialUnit("IU",1),SGraph.spatialUnit("CU",1)));
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("CU") == nullptr);
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("IU") == nullptr);
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("DU") != nullptr);
+
+  BOOST_REQUIRE(SGraph.removeFromToConnection(SGraph.spatialUnit("DU",1),SGraph.spatialUnit("DU",2)));
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("DU") == nullptr);
+
+  SGraph.clearUnits();
+  BOOST_REQUIRE(SGraph.unitsMatrixTopology("MU") == nullptr);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_incremental_operations)
+{
+  openfluid::core::SpatialGraph SGraph;
+
+  auto checkOrder = [](const openfluid::core::SpatialGraph& Graph, const openfluid::core::UnitsClass_t& Class)
+  {
+    openfluid::core::PcsOrd_t PrevOrder = 0;
+    for (const auto& Unit : *(Graph.spatialUnits(Class)->list()))
+    {
+      BOOST_REQUIRE_GE(Unit.getProcessOrder(),PrevOrder);
+      PrevOrder = Unit.getProcessOrder();
+    }
+
+    PrevOrder = 0;
+    for (const auto* Unit : *(Graph.allSpatialUnits()))
+    {
+      BOOST_REQUIRE_GE(Unit->getProcessOrder(),PrevOrder);
+      PrevOrder = Unit->getProcessOrder();
+    }
+  };
+
+
+  // *** incremental insertion
+  for (unsigned int i=1;i<=1000;i++)
+  {
+    BOOST_REQUIRE(SGraph.insertUnit(openfluid::core::SpatialUnit("UA",i,(i%13)+1)) != nullptr);
+  }
+  BOOST_REQUIRE(SGraph.insertUnit(openfluid::core::SpatialUnit("UA",10,1)) == nullptr);
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnits("UA")->size(),1000);
+  BOOST_REQUIRE_EQUAL(SGraph.allSpatialUnits()->size(),1000);
+  checkOrder(SGraph,"UA");
+
+  // units of the same process order are kept in insertion order
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnits("UA")->list()->front().getID(),13);
+  BOOST_REQUIRE_EQUAL(SGraph.allSpatialUnits()->back()->getID(),12+(13*76));
+
+  // insertion after unsorted additions
+  SGraph.addUnit(openfluid::core::SpatialUnit("UB",1,50));
+  SGraph.addUnit(openfluid::core::SpatialUnit("UB",2,5));
+  SGraph.insertUnit(openfluid::core::SpatialUnit("UB",3,20));
+  checkOrder(SGraph,"UB");
+  BOOST_REQUIRE_EQUAL(SGraph.allSpatialUnits()->back()->getID(),1);
+
+
+  // *** deletion
+  for (unsigned int i=1;i<1000;i++)
+  {
+    SGraph.spatialUnit("UA",i)->addToUnit(SGraph.spatialUnit("UA",i+1));
+    SGraph.spatialUnit("UA",i+1)->addFromUnit(SGraph.spatialUnit("UA",i));
+  }
+  SGraph.spatialUnit("UB",1)->addParentUnit(SGraph.spatialUnit("UA",500));
+  SGraph.spatialUnit("UA",500)->addChildUnit(SGraph.spatialUnit("UB",1));
+
+  BOOST_REQUIRE(SGraph.deleteUnit(SGraph.spatialUnit("UA",500)));
+  BOOST_REQUIRE(SGraph.spatialUnit("UA",500) == nullptr);
+  BOOST_REQUIRE(SGraph.spatialUnit("UA",499)->toSpatialUnits("UA")->empty());
+  BOOST_REQUIRE(SGraph.spatialUnit("UA",501)->fromSpatialUnits("UA")->empty());
+  BOOST_REQUIRE(SGraph.spatialUnit("UB",1)->parentSpatialUnits("UA")->empty());
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnits("UA")->size(),999);
+  BOOST_REQUIRE_EQUAL(SGraph.allSpatialUnits()->size(),1002);
+  checkOrder(SGraph,"UA");
+
+  for (unsigned int i=1;i<=1000;i+=2)
+  {
+    if (i != 500)
+    {
+      BOOST_REQUIRE(SGraph.deleteUnit(SGraph.spatialUnit("UA",i)));
+    }
+  }
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnits("UA")->size(),499);
+  BOOST_REQUIRE(SGraph.insertUnit(openfluid::core::SpatialUnit("UA",1,1)) != nullptr);
+  checkOrder(SGraph,"UA");
+
+
+  // *** batch
+  BOOST_REQUIRE(!SGraph.isInBatch());
+  BOOST_REQUIRE(!SGraph.endBatch());
+  BOOST_REQUIRE(SGraph.beginBatch());
+  BOOST_REQUIRE(!SGraph.beginBatch());
+  for (unsigned int i=2000;i>1000;i--)
+  {
+    BOOST_REQUIRE(SGraph.insertUnit(openfluid::core::SpatialUnit("UA",i,(i%7)+1)) != nullptr);
+  }
+  BOOST_REQUIRE(SGraph.isInBatch());
+  BOOST_REQUIRE(SGraph.endBatch());
+  BOOST_REQUIRE(!SGraph.isInBatch());
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnits("UA")->size(),1500);
+  checkOrder(SGraph,"UA");
+
+  SGraph.clearUnits();
+  BOOST_REQUIRE_EQUAL(SGraph.allSpatialUnits()->size(),0);
+}
@@ -0,0 +1,238 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SymbolsTable_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_symbolstable
+
+
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/tools/floating_point_comparison.hpp>
+
+#include <openfluid/core/SymbolsTable.hpp>
+#include <openfluid/core/ValuesBufferProperties.hpp>
+#include <openfluid/core/SpatialUnit.hpp>
+#include <openfluid/core/DoubleValue.hpp>
+#include <openfluid/core/IntegerValue.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_operations)
+{
+  const std::size_t InitSize = openfluid::core::SymbolsTable::size();
+
+  BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::find("sym.foo"),openfluid::core::SymbolsTable::InvalidSymbol);
+  BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::size(),InitSize);
+
+  openfluid::core::SymbolID_t FooID = openfluid::core::SymbolsTable::intern("sym.foo");
+  openfluid::core::SymbolID_t BarID = openfluid::core::SymbolsTable::intern("sym.bar");
+
+  BOOST_REQUIRE_NE(FooID,BarID);
+  BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::size(),InitSize+2);
+  BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::intern("sym.foo"),FooID);
+  BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::find("sym.foo"),FooID);
+  BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::find("sym.bar"),BarID);
+  BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::size(),InitSize+2);
+
+  const std::string& FooName = openfluid::core::SymbolsTable::name(FooID);
+
+  // the name reference must remain valid while other names are interned
+  for (unsigned int i=0; i<10000; i++)
+  {
+    openfluid::core::SymbolsTable::intern("sym.many."+std::to_string(i));
+  }
+
+  BOOST_REQUIRE_EQUAL(FooName,"sym.foo");
+  BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::name(BarID),"sym.bar");
+  BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::find("sym.many.9999"),
+                      openfluid::core::SymbolsTable::intern("sym.many.9999"));
+
+  BOOST_REQUIRE_THROW(openfluid::core::SymbolsTable::name(openfluid::core::SymbolsTable::InvalidSymbol),
+                      openfluid::base::FrameworkException);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_concurrency)
+{
+  const unsigned int ThreadsCount = 4;
+  const unsigned int NamesCount = 2000;
+
+  std::vector<std::vector<openfluid::core::SymbolID_t>> IDs(ThreadsCount);
+  std::vector<std::thread> Threads;
+
+  for (unsigned int t=0; t<ThreadsCount; t++)
+  {
+    Threads.emplace_back([&IDs,t]()
+    {
+      for (unsigned int i=0; i<NamesCount; i++)
+      {
+        IDs[t].push_back(openfluid::core::SymbolsTable::intern("sym.thread."+std::to_string(i)));
+      }
+    });
+  }
+
+  for (auto& T : Threads)
+  {
+    T.join();
+  }
+
+  for (unsigned int i=0; i<NamesCount; i++)
+  {
+    for (unsigned int t=1; t<ThreadsCount; t++)
+    {
+      BOOST_REQUIRE_EQUAL(IDs[t][i],IDs[0][i]);
+    }
+    BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::name(IDs[0][i]),"sym.thread."+std::to_string(i));
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_concurrent_lookups)
+{
+  const unsigned int ReadersCount = 3;
+  const unsigned int KnownCount = 100;
+  const unsigned int NewCount = 20000;
+
+  std::vector<openfluid::core::SymbolID_t> KnownIDs;
+  for (unsigned int i=0; i<KnownCount; i++)
+  {
+    KnownIDs.push_back(openfluid::core::SymbolsTable::intern("sym.known."+std::to_string(i)));
+  }
+
+  std::atomic<bool> Interning(true);
+  std::atomic<unsigned int> ErrorsCount(0);
+  std::vector<std::thread> Threads;
+
+  // known symbols are looked up while new symbols are interned, growing the storage and the index
+  for (unsigned int t=0; t<ReadersCount; t++)
+  {
+    Threads.emplace_back([&KnownIDs,&Interning,&ErrorsCount]()
+    {
+      while (Interning)
+      {
+        for (unsigned int i=0; i<KnownCount; i++)
+        {
+          const std::string Name = "sym.known."+std::to_string(i);
+
+          if (openfluid::core::SymbolsTable::find(Name) != KnownIDs[i] ||
+              openfluid::core::SymbolsTable::name(KnownIDs[i]) != Name)
+          {
+            ErrorsCount++;
+          }
+        }
+      }
+    });
+  }
+
+  std::vector<openfluid::core::SymbolID_t> NewIDs;
+  for (unsigned int i=0; i<NewCount; i++)
+  {
+    NewIDs.push_back(openfluid::core::SymbolsTable::intern("sym.new."+std::to_string(i)));
+  }
+  Interning = false;
+
+  for (auto& T : Threads)
+  {
+    T.join();
+  }
+
+  BOOST_REQUIRE_EQUAL(ErrorsCount,0);
+
+  for (unsigned int i=0; i<NewCount; i++)
+  {
+    BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::find("sym.new."+std::to_string(i)),NewIDs[i]);
+    BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::name(NewIDs[i]),"sym.new."+std::to_string(i));
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_spatialunit)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+
+  openfluid::core::SpatialUnit UnitA("sym.classA",1,1);
+  openfluid::core::SpatialUnit UnitB("sym.classA",2,1);
+  openfluid::core::SpatialUnit UnitC("sym.classC",1,1);
+
+  BOOST_REQUIRE_EQUAL(UnitA.getClassSymbol(),UnitB.getClassSymbol());
+  BOOST_REQUIRE_NE(UnitA.getClassSymbol(),UnitC.getClassSymbol());
+  BOOST_REQUIRE_EQUAL(openfluid::core::SymbolsTable::name(UnitC.getClassSymbol()),UnitC.getClass());
+
+  UnitA.variables()->createVariable("sym.var",openfluid::core::Value::DOUBLE);
+  UnitA.attributes()->setValue("sym.attr",openfluid::core::DoubleValue(2.5));
+
+  const openfluid::core::SymbolID_t VarID = openfluid::core::SymbolsTable::find("sym.var");
+  const openfluid::core::SymbolID_t AttrID = openfluid::core::SymbolsTable::find("sym.attr");
+
+  BOOST_REQUIRE(UnitA.variables()->isVariableExist(VarID));
+  BOOST_REQUIRE(!UnitB.variables()->isVariableExist(VarID));
+  BOOST_REQUIRE(UnitA.attributes()->isAttributeExist(AttrID));
+  BOOST_REQUIRE(!UnitA.attributes()->isAttributeExist(VarID));
+  BOOST_REQUIRE_CLOSE(UnitA.attributes()->value(AttrID)->asDoubleValue().get(),2.5,0.0001);
+
+  BOOST_REQUIRE(UnitA.variables()->appendValue(VarID,0,openfluid::core::DoubleValue(1.5)));
+  BOOST_REQUIRE(!UnitA.variables()->appendValue(VarID,1,openfluid::core::IntegerValue(1)));
+  BOOST_REQUIRE(UnitA.variables()->modifyCurrentValue(VarID,openfluid::core::DoubleValue(3.5)));
+  BOOST_REQUIRE(UnitA.variables()->isVariableExist(VarID,0));
+  BOOST_REQUIRE(UnitA.variables()->isTypedVariableExist(VarID,openfluid::core::Value::DOUBLE));
+  BOOST_REQUIRE_CLOSE(UnitA.variables()->currentValue(VarID)->asDoubleValue().get(),3.5,0.0001);
+  BOOST_REQUIRE_EQUAL(UnitA.variables()->value(VarID,0),UnitA.variables()->currentValue("sym.var"));
+  BOOST_REQUIRE_EQUAL(UnitA.variables()->latestIndexedValue(VarID)->getIndex(),0);
+  BOOST_REQUIRE(UnitA.variables()->currentValueIfIndex(VarID,1) == nullptr);
+}
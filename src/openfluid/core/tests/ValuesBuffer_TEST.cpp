@@ -43,6 +43,12 @@
 #define BOOST_TEST_MODULE unittest_sserievalues
 
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include <boost/test/unit_test.hpp>
 #include <boost/test/tools/floating_point_comparison.hpp>
 
@@ -53,6 +59,7 @@
 #include <openfluid/core/StringValue.hpp>
 #include <openfluid/core/IntegerValue.hpp>
 #include <openfluid/core/VectorValue.hpp>
+#include <openfluid/core/MatrixValue.hpp>
 
 
 // =====================================================================
@@ -338,3 +345,299 @@ BOOST_AUTO_TEST_CASE(check_type_operations)
 
 }
 
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_views)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+  openfluid::core::ValuesBuffer VBuffer;
+  openfluid::core::IndexedValuesView View;
+  openfluid::core::IndexedValueList IValueList;
+
+  BOOST_REQUIRE(VBuffer.latestIndexedValue() == nullptr);
+  BOOST_REQUIRE(!VBuffer.getLatestIndexedValuesView(0,View));
+  BOOST_REQUIRE(View.empty());
+  BOOST_REQUIRE(!VBuffer.getIndexedValuesView(0,10,View));
+
+  // sparse time indexes, with buffer overwriting the oldest values
+  for (unsigned int i = 0; i < 8; i++)
+  {
+    BOOST_REQUIRE(VBuffer.appendValue(i*10,openfluid::core::DoubleValue(i*1.1)));
+  }
+
+  BOOST_REQUIRE_EQUAL(VBuffer.getValuesCount(),5);
+  BOOST_REQUIRE_EQUAL(VBuffer.latestIndexedValue()->getIndex(),70);
+  BOOST_REQUIRE(VBuffer.latestIndexedValue()->value() == VBuffer.currentValue());
+  BOOST_REQUIRE_EQUAL(VBuffer.indexedValueAt(0).getIndex(),30);
+
+
+  BOOST_REQUIRE(VBuffer.getLatestIndexedValuesView(45,View));
+  BOOST_REQUIRE_EQUAL(View.size(),3);
+  BOOST_REQUIRE_EQUAL(View.front().getIndex(),50);
+  BOOST_REQUIRE_EQUAL(View.back().getIndex(),70);
+  BOOST_REQUIRE_CLOSE(View[1].value()->asDoubleValue().get(),6.6,0.001);
+
+  // views and copied lists give the same values
+  for (openfluid::core::TimeIndex_t Begin : {0,30,40,65,70,80})
+  {
+    BOOST_REQUIRE(VBuffer.getLatestIndexedValuesView(Begin,View));
+    BOOST_REQUIRE(VBuffer.getLatestIndexedValues(Begin,IValueList));
+    BOOST_REQUIRE_EQUAL(View.size(),IValueList.size());
+
+    auto ListIt = IValueList.begin();
+    for (const auto& IValue : View)
+    {
+      BOOST_REQUIRE_EQUAL(IValue.getIndex(),(*ListIt).getIndex());
+      BOOST_REQUIRE_EQUAL(IValue.value()->asDoubleValue().get(),(*ListIt).value()->asDoubleValue().get());
+      ++ListIt;
+    }
+
+    for (openfluid::core::TimeIndex_t End : {0,35,50,69,70,100})
+    {
+      const bool IsOK = VBuffer.getIndexedValuesView(Begin,End,View);
+      BOOST_REQUIRE_EQUAL(IsOK,VBuffer.getIndexedValues(Begin,End,IValueList));
+
+      if (IsOK)
+      {
+        openfluid::core::IndexedValueList CopiedList;
+        View.copyTo(CopiedList);
+
+        BOOST_REQUIRE_EQUAL(CopiedList.size(),IValueList.size());
+        BOOST_REQUIRE(std::equal(CopiedList.begin(),CopiedList.end(),IValueList.begin(),
+                                 [](const openfluid::core::IndexedValue& V1, const openfluid::core::IndexedValue& V2)
+                                 {
+                                   return V1.getIndex() == V2.getIndex();
+                                 }));
+      }
+    }
+  }
+
+  // reverse iteration
+  BOOST_REQUIRE(VBuffer.getIndexedValuesView(40,60,View));
+  auto It = View.end();
+  --It;
+  BOOST_REQUIRE_EQUAL(It->getIndex(),60);
+  --It;
+  BOOST_REQUIRE_EQUAL((*It).getIndex(),50);
+  --It;
+  BOOST_REQUIRE(It == View.begin());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_move_and_recycle)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(3);
+  openfluid::core::ValuesBuffer VBuffer;
+
+  // moved values are stored without copy
+  auto Vect = std::make_unique<openfluid::core::VectorValue>(200,1.0);
+  const double* VectData = Vect->data();
+
+  BOOST_REQUIRE(VBuffer.appendValue(0,std::move(Vect)));
+  BOOST_REQUIRE(!Vect);
+  BOOST_REQUIRE(VBuffer.currentValue()->asVectorValue().data() == VectData);
+
+  BOOST_REQUIRE(!VBuffer.appendValue(0,std::make_unique<openfluid::core::VectorValue>(200,2.0)));
+  BOOST_REQUIRE(!VBuffer.appendValue(1,std::unique_ptr<openfluid::core::Value>()));
+
+  openfluid::core::VectorValue Other(200,2.0);
+  BOOST_REQUIRE(VBuffer.appendValue(1,Other));
+  BOOST_REQUIRE(VBuffer.appendValue(2,Other));
+  BOOST_REQUIRE_EQUAL(VBuffer.getValuesCount(),3);
+
+  // the buffer is full, the storage of the oldest value is recycled
+  const openfluid::core::Value* OldestValue = VBuffer.value(0);
+  BOOST_REQUIRE(VBuffer.appendValue(3,openfluid::core::VectorValue(200,3.0)));
+  BOOST_REQUIRE_EQUAL(VBuffer.getValuesCount(),3);
+  BOOST_REQUIRE(!VBuffer.isValueExist(0));
+  BOOST_REQUIRE(VBuffer.currentValue() == OldestValue);
+  BOOST_REQUIRE(VBuffer.currentValue()->asVectorValue().data() == VectData);
+  BOOST_REQUIRE_CLOSE(VBuffer.currentValue()->asVectorValue().get(199),3.0,0.001);
+
+  // storage is not recycled for values of different types
+  OldestValue = VBuffer.value(1);
+  BOOST_REQUIRE(VBuffer.appendValue(4,openfluid::core::DoubleValue(4.0)));
+  BOOST_REQUIRE(VBuffer.currentValue() != OldestValue);
+  BOOST_REQUIRE_CLOSE(VBuffer.currentValue()->asDoubleValue().get(),4.0,0.001);
+
+  // in-place modifications
+  OldestValue = VBuffer.value(3);
+  BOOST_REQUIRE(VBuffer.modifyValue(3,openfluid::core::VectorValue(200,5.0)));
+  BOOST_REQUIRE(VBuffer.value(3) == OldestValue);
+  BOOST_REQUIRE(VBuffer.value(3)->asVectorValue().data() == VectData);
+  BOOST_REQUIRE_CLOSE(VBuffer.value(3)->asVectorValue().get(0),5.0,0.001);
+
+  VBuffer.currentValue()->asDoubleValue().set(6.0);
+  BOOST_REQUIRE_CLOSE(VBuffer.currentValue()->asDoubleValue().get(),6.0,0.001);
+
+  BOOST_REQUIRE(VBuffer.modifyCurrentValue(std::make_unique<openfluid::core::StringValue>("moved")));
+  BOOST_REQUIRE_EQUAL(VBuffer.currentValue()->asStringValue().get(),"moved");
+
+  auto Matrix = std::make_unique<openfluid::core::MatrixValue>(10,20,1.0);
+  const double* MatrixData = Matrix->data();
+  BOOST_REQUIRE(VBuffer.modifyValue(3,std::move(Matrix)));
+  BOOST_REQUIRE(VBuffer.value(3)->asMatrixValue().data() == MatrixData);
+  BOOST_REQUIRE(!VBuffer.modifyValue(10,std::make_unique<openfluid::core::DoubleValue>(1.0)));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_shared_storage)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+  openfluid::core::ValuesBuffer Source;
+  openfluid::core::ValuesBuffer Shared1, Shared2;
+
+  BOOST_REQUIRE(Shared1.appendValue(0,openfluid::core::DoubleValue(1.0)));
+
+  Shared1.shareStorage(Source);
+  Shared2.shareStorage(Source);
+  BOOST_REQUIRE(!Source.isSharedStorage());
+  BOOST_REQUIRE(Shared1.isSharedStorage());
+  BOOST_REQUIRE_EQUAL(Shared1.getValuesCount(),0);
+
+  BOOST_REQUIRE(Source.appendValue(0,openfluid::core::DoubleValue(2.0)));
+  BOOST_REQUIRE(Source.appendValue(1,openfluid::core::DoubleValue(3.0)));
+
+  // shared buffers serve the values of the source, without copy
+  BOOST_REQUIRE_EQUAL(Shared1.getValuesCount(),2);
+  BOOST_REQUIRE_EQUAL(Shared2.getCurrentIndex(),1);
+  BOOST_REQUIRE(Shared1.currentValue() == Source.currentValue());
+  BOOST_REQUIRE(Shared2.value(0) == Source.value(0));
+  BOOST_REQUIRE_CLOSE(Shared2.value(0)->asDoubleValue().get(),2.0,0.001);
+
+  // shared buffers are read-only
+  BOOST_REQUIRE(!Shared1.appendValue(2,openfluid::core::DoubleValue(4.0)));
+  BOOST_REQUIRE(!Shared1.appendValue(2,std::make_unique<openfluid::core::DoubleValue>(4.0)));
+  BOOST_REQUIRE(!Shared1.modifyValue(0,openfluid::core::DoubleValue(4.0)));
+  BOOST_REQUIRE(!Shared1.modifyCurrentValue(openfluid::core::DoubleValue(4.0)));
+  BOOST_REQUIRE_EQUAL(Source.getValuesCount(),2);
+  BOOST_REQUIRE_CLOSE(Source.currentValue()->asDoubleValue().get(),3.0,0.001);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_storage_precision)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+
+  openfluid::core::ValuesBuffer FloatBuffer;
+  BOOST_REQUIRE(FloatBuffer.getStoragePrecision() == openfluid::core::ValuesBuffer::StoragePrecision::FULL);
+  BOOST_REQUIRE(FloatBuffer.setStoragePrecision(openfluid::core::ValuesBuffer::StoragePrecision::FLOAT32));
+
+  for (unsigned int i=0; i<8; i++)
+  {
+    BOOST_REQUIRE(FloatBuffer.appendValue(i,openfluid::core::DoubleValue(i+0.1)));
+  }
+
+  // precision cannot be changed once values are stored
+  BOOST_REQUIRE(!FloatBuffer.setStoragePrecision(openfluid::core::ValuesBuffer::StoragePrecision::FULL));
+
+  BOOST_REQUIRE_EQUAL(FloatBuffer.getValuesCount(),5);
+  BOOST_REQUIRE_EQUAL(FloatBuffer.getCurrentIndex(),7);
+  BOOST_REQUIRE(!FloatBuffer.isValueExist(2));
+  BOOST_REQUIRE_CLOSE(FloatBuffer.value(3)->asDoubleValue().get(),3.1,0.0001);
+  BOOST_REQUIRE_EQUAL(FloatBuffer.currentValue()->asDoubleValue().get(),static_cast<double>(7.1f));
+  BOOST_REQUIRE(FloatBuffer.getStorageMaxError() > 0.0);
+  BOOST_REQUIRE(FloatBuffer.getStorageMaxError() < 1e-6);
+
+  openfluid::core::IndexedValueList IndValueList;
+  BOOST_REQUIRE(FloatBuffer.getLatestIndexedValues(5,IndValueList));
+  BOOST_REQUIRE_EQUAL(IndValueList.size(),3);
+  BOOST_REQUIRE_CLOSE(IndValueList.front().value()->asDoubleValue().get(),5.1,0.0001);
+
+  openfluid::core::IndexedValuesView View;
+  BOOST_REQUIRE(FloatBuffer.getIndexedValuesView(4,6,View));
+  BOOST_REQUIRE_EQUAL(View.size(),3);
+  BOOST_REQUIRE_CLOSE(View.back().value()->asDoubleValue().get(),6.1,0.0001);
+
+  // modifications through pointers are kept when values are stored back at next append
+  FloatBuffer.currentValue()->asDoubleValue().set(100.5);
+  BOOST_REQUIRE(FloatBuffer.modifyValue(6,openfluid::core::DoubleValue(-2.25)));
+  BOOST_REQUIRE(FloatBuffer.appendValue(8,std::make_unique<openfluid::core::DoubleValue>(8.5)));
+  BOOST_REQUIRE_EQUAL(FloatBuffer.value(7)->asDoubleValue().get(),100.5);
+  BOOST_REQUIRE_EQUAL(FloatBuffer.value(6)->asDoubleValue().get(),-2.25);
+  BOOST_REQUIRE_EQUAL(FloatBuffer.currentValue()->asDoubleValue().get(),8.5);
+
+  // other values types are stored unchanged
+  BOOST_REQUIRE(FloatBuffer.appendValue(9,openfluid::core::StringValue("text")));
+  BOOST_REQUIRE(FloatBuffer.appendValue(10,openfluid::core::DoubleValue(1e300)));
+  BOOST_REQUIRE_EQUAL(FloatBuffer.value(9)->asStringValue().get(),"text");
+  BOOST_REQUIRE_EQUAL(FloatBuffer.currentValue()->asDoubleValue().get(),1e300);
+
+  openfluid::core::DoubleValue DblValue;
+  BOOST_REQUIRE(FloatBuffer.getValue(8,&DblValue));
+  BOOST_REQUIRE_EQUAL(DblValue.get(),8.5);
+
+
+  openfluid::core::ValuesBuffer FixedBuffer;
+  BOOST_REQUIRE(!FixedBuffer.setStoragePrecision(openfluid::core::ValuesBuffer::StoragePrecision::FIXED,0.0));
+  BOOST_REQUIRE(FixedBuffer.setStoragePrecision(openfluid::core::ValuesBuffer::StoragePrecision::FIXED,0.01));
+  BOOST_REQUIRE_EQUAL(FixedBuffer.getStorageScale(),0.01);
+
+  BOOST_REQUIRE(FixedBuffer.appendValue(0,openfluid::core::DoubleValue(12.3456)));
+  BOOST_REQUIRE(FixedBuffer.appendValue(1,openfluid::core::DoubleValue(-0.004)));
+  BOOST_REQUIRE_CLOSE(FixedBuffer.value(0)->asDoubleValue().get(),12.35,0.0001);
+  BOOST_REQUIRE_SMALL(FixedBuffer.currentValue()->asDoubleValue().get(),1e-12);
+  BOOST_REQUIRE_CLOSE(FixedBuffer.getStorageMaxError(),0.0044,0.01);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_storage_precision_concurrent_reads)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(100);
+
+  openfluid::core::ValuesBuffer Buffer;
+  BOOST_REQUIRE(Buffer.setStoragePrecision(openfluid::core::ValuesBuffer::StoragePrecision::FIXED,0.5));
+
+  for (unsigned int Step = 0; Step < 20; Step++)
+  {
+    BOOST_REQUIRE(Buffer.appendValue(Step,openfluid::core::DoubleValue(Step*2.0)));
+
+    // values are rebuilt concurrently by the readers, then stored back by the next append
+    std::atomic<bool> Wrong(false);
+    std::vector<std::thread> Readers;
+
+    for (unsigned int t = 0; t < 4; t++)
+    {
+      Readers.push_back(std::thread([&Buffer,&Wrong,Step]()
+      {
+        for (unsigned int i = 0; i <= Step; i++)
+        {
+          if (Buffer.value(i)->asDoubleValue().get() != i*2.0)
+          {
+            Wrong = true;
+          }
+        }
+      }));
+    }
+
+    for (auto& Reader : Readers)
+    {
+      Reader.join();
+    }
+
+    BOOST_REQUIRE(!Wrong);
+  }
+
+  BOOST_REQUIRE_EQUAL(Buffer.getValuesCount(),20);
+  BOOST_REQUIRE_EQUAL(Buffer.getStorageMaxError(),0.0);
+}
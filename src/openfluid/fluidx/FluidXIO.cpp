@@ -39,8 +39,12 @@
 
 
 #include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
 
 #include <openfluid/core/Dimensions.hpp>
 #include <openfluid/fluidx/FluidXIO.hpp>
@@ -411,6 +415,43 @@ class FluidXReaderImplementation
                 "missing size attribute for valuesbuffer tag (" + m_CurrentFile + ")");
           }
         }
+        else if (TagName == "storage")
+        {
+          std::string UnitsClass = openfluid::thirdparty::getXMLAttribute(Elt,"unitsclass");
+          std::string VarName = openfluid::thirdparty::getXMLAttribute(Elt,"variable");
+          std::string Precision = openfluid::thirdparty::getXMLAttribute(Elt,"precision");
+          std::string Scale = openfluid::thirdparty::getXMLAttribute(Elt,"scale");
+
+          if (UnitsClass.empty() || VarName.empty() || Precision.empty())
+          {
+            throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                "missing unitsclass, variable and/or precision attributes for storage tag (" + m_CurrentFile + ")");
+          }
+
+          RunConfigurationDescriptor::VariableStorage Storage;
+
+          if (Precision == "float32")
+          {
+            Storage.Precision = openfluid::core::ValuesBuffer::StoragePrecision::FLOAT32;
+          }
+          else if (Precision == "fixed")
+          {
+            Storage.Precision = openfluid::core::ValuesBuffer::StoragePrecision::FIXED;
+
+            if (!openfluid::tools::toNumeric(Scale,Storage.Scale) || !(Storage.Scale > 0.0))
+            {
+              throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                  "missing or wrong scale attribute for fixed precision storage tag (" + m_CurrentFile + ")");
+            }
+          }
+          else if (Precision != "full")
+          {
+            throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                "wrong value for precision attribute for storage tag (" + m_CurrentFile + ")");
+          }
+
+          m_Descriptor.m_RunDescriptor.setVariableStorage(UnitsClass,VarName,Storage);
+        }
         else
         {
           m_Report[m_CurrentFile].UnknownTags.push_back(TagName);
@@ -912,6 +953,55 @@ class FluidXReaderImplementation
 // =====================================================================
 
 
+/**
+  XML printer writing directly into a file, without building a document in memory.
+  The produced output is the same as a tinyxml2 document saved into a file
+*/
+class FluidXStreamPrinter : public openfluid::thirdparty::xml::XMLPrinter
+{
+  public:
+
+    FluidXStreamPrinter(FILE* File) : openfluid::thirdparty::xml::XMLPrinter(File)
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void openCData()
+    {
+      // an empty text seals the current element before the CDATA section written as is
+      PushText("",false);
+      Write("<![CDATA[");
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void pushCData(const std::string& Data)
+    {
+      Write(Data.data(),Data.size());
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void closeCData()
+    {
+      Write("]]>");
+    }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
 class FluidXWriterImplementation
 {
   private:
@@ -920,6 +1010,11 @@ class FluidXWriterImplementation
 
     openfluid::base::IOListener* mp_Listener;
 
+    unsigned int m_ThreadsCount;
+
+    // number of units formatted at once in attributes blocks
+    static constexpr unsigned int AttributesBlockSize = 1024;
+
 
     // =====================================================================
     // =====================================================================
@@ -953,14 +1048,14 @@ class FluidXWriterImplementation
     // =====================================================================
 
 
-    void insertWareParams(const openfluid::ware::WareParams_t& Params, 
-                          openfluid::thirdparty::xml::XMLElement* BaseElt) const
+    void writeWareParams(const openfluid::ware::WareParams_t& Params, FluidXStreamPrinter& Printer) const
     {
       for (const auto& P : Params)
       {
-        auto ParamElt = BaseElt->InsertNewChildElement("param");
-        ParamElt->SetAttribute("name",P.first.c_str());
-        ParamElt->SetAttribute("value",P.second.get().c_str());
+        Printer.OpenElement("param");
+        Printer.PushAttribute("name",P.first.c_str());
+        Printer.PushAttribute("value",P.second.get().c_str());
+        Printer.CloseElement();
       }
     }
 
@@ -969,15 +1064,16 @@ class FluidXWriterImplementation
     // =====================================================================
 
 
-    void insertModel(openfluid::thirdparty::xml::XMLElement* BaseElt) const
+    void writeModel(FluidXStreamPrinter& Printer) const
     {
-      auto ModelElt = BaseElt->InsertNewChildElement("model");
+      Printer.OpenElement("model");
 
       const auto& GParams = m_Descriptor.m_ModelDescriptor.getGlobalParameters();
       if (GParams.size() > 0)
       {
-        auto GParamsElt = ModelElt->InsertNewChildElement("gparams");
-        insertWareParams(GParams,GParamsElt);
+        Printer.OpenElement("gparams");
+        writeWareParams(GParams,Printer);
+        Printer.CloseElement();
       }
 
       const auto ModelItems = m_Descriptor.m_ModelDescriptor.items();
@@ -988,43 +1084,47 @@ class FluidXWriterImplementation
           openfluid::fluidx::SimulatorDescriptor* SimDesc =
               dynamic_cast<openfluid::fluidx::SimulatorDescriptor*>(Item);
 
-          auto SimElt = ModelElt->InsertNewChildElement("simulator");
-          SimElt->SetAttribute("ID",SimDesc->getID().c_str());
-          SimElt->SetAttribute("enabled",SimDesc->isEnabled());
-          insertWareParams(SimDesc->getParameters(),SimElt);
+          Printer.OpenElement("simulator");
+          Printer.PushAttribute("ID",SimDesc->getID().c_str());
+          Printer.PushAttribute("enabled",SimDesc->isEnabled());
+          writeWareParams(SimDesc->getParameters(),Printer);
+          Printer.CloseElement();
         }
         else if (Item->isType(openfluid::ware::WareType::GENERATOR))
         {
           openfluid::fluidx::GeneratorDescriptor* GenDesc =
               dynamic_cast<openfluid::fluidx::GeneratorDescriptor*>(Item);
 
-          auto GenElt = ModelElt->InsertNewChildElement("generator");
+          Printer.OpenElement("generator");
           if (GenDesc->getGeneratorMethod() == openfluid::fluidx::GeneratorDescriptor::GeneratorMethod::INJECTMULTICOL)
           {
-            GenElt->SetAttribute("variables", serializeVarTriplets(GenDesc->getVariableTriplets()).c_str());
+            Printer.PushAttribute("variables", serializeVarTriplets(GenDesc->getVariableTriplets()).c_str());
           }
           else
           {
-            GenElt->SetAttribute("varname",GenDesc->getVariableName().c_str());
+            Printer.PushAttribute("varname",GenDesc->getVariableName().c_str());
 
             if (!GenDesc->getVariableDimensions().isScalar())
             {
-              GenElt->SetAttribute("varsize",GenDesc->getVariableDimensions().getSerializedVariableSize().c_str());
+              Printer.PushAttribute("varsize",GenDesc->getVariableDimensions().getSerializedVariableSize().c_str());
             }
             openfluid::core::Value::Type VarType = GenDesc->getVariableType();
             
             //FIXME disambiguate difference between implicit DOUBLE type and NONE type
             if (VarType != openfluid::core::Value::DOUBLE && VarType != openfluid::core::Value::NONE)
             {
-              GenElt->SetAttribute("vartype",openfluid::core::Value::getStringFromValueType(VarType).c_str());
+              Printer.PushAttribute("vartype",openfluid::core::Value::getStringFromValueType(VarType).c_str());
             }
-            GenElt->SetAttribute("unitsclass",GenDesc->getUnitsClass().c_str());
+            Printer.PushAttribute("unitsclass",GenDesc->getUnitsClass().c_str());
           }
-          GenElt->SetAttribute("method",getGeneratorMethodAsStr(GenDesc->getGeneratorMethod()).c_str());
-          GenElt->SetAttribute("enabled",GenDesc->isEnabled());
-          insertWareParams(GenDesc->getParameters(),GenElt);
+          Printer.PushAttribute("method",getGeneratorMethodAsStr(GenDesc->getGeneratorMethod()).c_str());
+          Printer.PushAttribute("enabled",GenDesc->isEnabled());
+          writeWareParams(GenDesc->getParameters(),Printer);
+          Printer.CloseElement();
         }
       }
+
+      Printer.CloseElement();
     }
 
 
@@ -1061,13 +1161,15 @@ class FluidXWriterImplementation
     // =====================================================================
 
 
-    void insertDomain(openfluid::thirdparty::xml::XMLElement* BaseElt) const
+    void writeDomain(FluidXStreamPrinter& Printer) const
     {
-      auto DomainElt = BaseElt->InsertNewChildElement("domain");
+      Printer.OpenElement("domain");
 
-      insertDomainDefinition(DomainElt);
-      insertDomainAttributes(DomainElt);
-      insertDomainCalendar(DomainElt);
+      writeDomainDefinition(Printer);
+      writeDomainAttributes(Printer);
+      writeDomainCalendar(Printer);
+
+      Printer.CloseElement();
     }
 
 
@@ -1075,37 +1177,43 @@ class FluidXWriterImplementation
     // =====================================================================
 
 
-    void insertDomainDefinition(openfluid::thirdparty::xml::XMLElement* BaseElt) const
+    void writeDomainDefinition(FluidXStreamPrinter& Printer) const
     {
       const auto& Units = m_Descriptor.m_DomainDescriptor.spatialUnits();
 
-      auto DefElt = BaseElt->InsertNewChildElement("definition");
+      Printer.OpenElement("definition");
 
       for (const auto& UnitsClass : Units)
       {
         for (const auto& Unit : UnitsClass.second)
         {
-          auto UnitElt = DefElt->InsertNewChildElement("unit");
+          Printer.OpenElement("unit");
 
-          UnitElt->SetAttribute("class",UnitsClass.first.c_str());
-          UnitElt->SetAttribute("ID",Unit.second.getID());
-          UnitElt->SetAttribute("pcsorder",Unit.second.getProcessOrder());
+          Printer.PushAttribute("class",UnitsClass.first.c_str());
+          Printer.PushAttribute("ID",Unit.second.getID());
+          Printer.PushAttribute("pcsorder",Unit.second.getProcessOrder());
 
           for (const auto& LinkedUnit : Unit.second.toSpatialUnits())
           {
-            auto ToElt = UnitElt->InsertNewChildElement("to");
-            ToElt->SetAttribute("class",LinkedUnit.first.c_str());
-            ToElt->SetAttribute("ID",LinkedUnit.second);
+            Printer.OpenElement("to");
+            Printer.PushAttribute("class",LinkedUnit.first.c_str());
+            Printer.PushAttribute("ID",LinkedUnit.second);
+            Printer.CloseElement();
           }
 
           for (const auto& LinkedUnit : Unit.second.parentSpatialUnits())
           {
-            auto ChildElt = UnitElt->InsertNewChildElement("childof");
-            ChildElt->SetAttribute("class",LinkedUnit.first.c_str());
-            ChildElt->SetAttribute("ID",LinkedUnit.second);
+            Printer.OpenElement("childof");
+            Printer.PushAttribute("class",LinkedUnit.first.c_str());
+            Printer.PushAttribute("ID",LinkedUnit.second);
+            Printer.CloseElement();
           }
+
+          Printer.CloseElement();
         }
       }
+
+      Printer.CloseElement();
     }
 
 
@@ -1113,7 +1221,40 @@ class FluidXWriterImplementation
     // =====================================================================
 
 
-    void insertDomainAttributes(openfluid::thirdparty::xml::XMLElement* BaseElt) const
+    /**
+      Formats the attributes of a range of units as text lines
+    */
+    template<class IteratorT>
+    static void formatAttributesBlock(IteratorT Begin, IteratorT End, std::string& Block)
+    {
+      Block.clear();
+
+      for (auto It = Begin; It != End; ++It)
+      {
+        Block += std::to_string(It->second.getID());
+        Block += '\t';
+
+        bool isFirstItem = true;
+        for (const auto& Attr : It->second.attributes())
+        {
+          if (!isFirstItem)
+          {
+            Block += '\t';
+          }
+          isFirstItem = false;
+          Block += Attr.second;
+        }
+
+        Block += '\n';
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void writeDomainAttributes(FluidXStreamPrinter& Printer) const
     {
       const auto& DomainDesc = m_Descriptor.m_DomainDescriptor;
       
@@ -1123,26 +1264,62 @@ class FluidXWriterImplementation
 
         if (!AttrsNames.empty())
         {
-          auto AttrsElt = BaseElt->InsertNewChildElement("attributes");
-          AttrsElt->SetAttribute("unitsclass",UnitsClass.first.c_str());
-          AttrsElt->SetAttribute("colorder",getSeparatedStrFromList(AttrsNames,";").c_str());
+          Printer.OpenElement("attributes");
+          Printer.PushAttribute("unitsclass",UnitsClass.first.c_str());
+          Printer.PushAttribute("colorder",getSeparatedStrFromList(AttrsNames,";").c_str());
 
-          std::ostringstream AttrsData;
-          AttrsData << "\n";
-          for (const auto& Unit : UnitsClass.second)
+          // attributes text is written as CDATA, by blocks of units formatted in parallel if enabled
+          Printer.openCData();
+          Printer.pushCData("\n");
+
+          const auto& Units = UnitsClass.second;
+          std::vector<std::string> Blocks(m_ThreadsCount);
+          auto UnitIt = Units.begin();
+
+          while (UnitIt != Units.end())
           {
-            std::vector<std::string> Values;
-            const auto& Attributes = Unit.second.attributes();
-            transform(Attributes.begin(),Attributes.end(), back_inserter(Values),
-                      [](const std::map<openfluid::core::AttributeName_t,std::string>::value_type& Val)
-                      {
-                        return Val.second;
-                      });
-            AttrsData << Unit.second.getID() << "\t" << getSeparatedStrFromList(Values,"\t") << "\n";
+            using UnitIterator_t = std::decay_t<decltype(UnitIt)>;
+            std::vector<std::pair<UnitIterator_t,UnitIterator_t>> Ranges;
+
+            while (UnitIt != Units.end() && Ranges.size() < m_ThreadsCount)
+            {
+              auto RangeBegin = UnitIt;
+              for (unsigned int i=0; i<AttributesBlockSize && UnitIt != Units.end(); i++)
+              {
+                ++UnitIt;
+              }
+              Ranges.push_back({RangeBegin,UnitIt});
+            }
+
+            if (Ranges.size() == 1)
+            {
+              formatAttributesBlock(Ranges[0].first,Ranges[0].second,Blocks[0]);
+            }
+            else
+            {
+              std::vector<std::thread> Threads;
+
+              for (unsigned int i=0; i<Ranges.size(); i++)
+              {
+                Threads.push_back(std::thread(formatAttributesBlock<UnitIterator_t>,
+                                              Ranges[i].first,Ranges[i].second,std::ref(Blocks[i])));
+              }
+
+              for (auto& Thread : Threads)
+              {
+                Thread.join();
+              }
+            }
+
+            // blocks are written in units order
+            for (unsigned int i=0; i<Ranges.size(); i++)
+            {
+              Printer.pushCData(Blocks[i]);
+            }
           }
-          
-          auto Text = AttrsElt->InsertNewText(AttrsData.str().c_str());
-          Text->SetCData(true);  // enable CDATA mode for attributes text
+
+          Printer.closeCData();
+          Printer.CloseElement();
         }
       }
     }
@@ -1152,9 +1329,9 @@ class FluidXWriterImplementation
     // =====================================================================
 
 
-    void insertDomainCalendar(openfluid::thirdparty::xml::XMLElement* BaseElt) const
+    void writeDomainCalendar(FluidXStreamPrinter& Printer) const
     {
-      auto CalElt = BaseElt->InsertNewChildElement("calendar");
+      Printer.OpenElement("calendar");
 
       for (const auto& UnitsClass : m_Descriptor.m_DomainDescriptor.spatialUnits())
       {
@@ -1164,23 +1341,27 @@ class FluidXWriterImplementation
 
           for (const auto& EvDesc : Events)
           {
-            auto EvElt = CalElt->InsertNewChildElement("event");
+            Printer.OpenElement("event");
 
-            EvElt->SetAttribute("unitsclass",UnitsClass.first.c_str());
-            EvElt->SetAttribute("unitID",Unit.second.getID());
-            EvElt->SetAttribute("date",EvDesc.event().getDateTime().getAsISOString().c_str());
+            Printer.PushAttribute("unitsclass",UnitsClass.first.c_str());
+            Printer.PushAttribute("unitID",Unit.second.getID());
+            Printer.PushAttribute("date",EvDesc.event().getDateTime().getAsISOString().c_str());
 
             const auto& Infos = EvDesc.event().getInfos();
             for (const auto& Inf : Infos)
             {
-              auto InfElt = EvElt->InsertNewChildElement("info");
-              InfElt->SetAttribute("key",Inf.first.c_str());
-              InfElt->SetAttribute("value",Inf.second.get().c_str());
+              Printer.OpenElement("info");
+              Printer.PushAttribute("key",Inf.first.c_str());
+              Printer.PushAttribute("value",Inf.second.get().c_str());
+              Printer.CloseElement();
             }
 
+            Printer.CloseElement();
           }
         }
       }
+
+      Printer.CloseElement();
     }
 
 
@@ -1188,11 +1369,11 @@ class FluidXWriterImplementation
     // =====================================================================
 
 
-    void insertRunConfiguration(openfluid::thirdparty::xml::XMLElement* BaseElt) const
+    void writeRunConfiguration(FluidXStreamPrinter& Printer) const
     {
       const auto& RunConfig = m_Descriptor.m_RunDescriptor;
 
-      auto RunElt = BaseElt->InsertNewChildElement("run");
+      Printer.OpenElement("run");
 
 
       if (RunConfig.isFilled())
@@ -1211,20 +1392,48 @@ class FluidXWriterImplementation
           ConstraintStr = "dt-checked";
         }
 
-        auto SchedElt = RunElt->InsertNewChildElement("scheduling");
-        SchedElt->SetAttribute("deltat",RunConfig.getDeltaT());
-        SchedElt->SetAttribute("constraint",ConstraintStr.c_str());
+        Printer.OpenElement("scheduling");
+        Printer.PushAttribute("deltat",RunConfig.getDeltaT());
+        Printer.PushAttribute("constraint",ConstraintStr.c_str());
+        Printer.CloseElement();
 
-        auto PeriodElt = RunElt->InsertNewChildElement("period");
-        PeriodElt->SetAttribute("begin",RunConfig.getBeginDate().getAsISOString().c_str());
-        PeriodElt->SetAttribute("end",RunConfig.getEndDate().getAsISOString().c_str());
+        Printer.OpenElement("period");
+        Printer.PushAttribute("begin",RunConfig.getBeginDate().getAsISOString().c_str());
+        Printer.PushAttribute("end",RunConfig.getEndDate().getAsISOString().c_str());
+        Printer.CloseElement();
 
         if (RunConfig.isUserValuesBufferSize())
         {
-          auto BuffElt = RunElt->InsertNewChildElement("valuesbuffer");
-          BuffElt->SetAttribute("size",RunConfig.getValuesBufferSize());
+          Printer.OpenElement("valuesbuffer");
+          Printer.PushAttribute("size",RunConfig.getValuesBufferSize());
+          Printer.CloseElement();
+        }
+
+        for (const auto& VarStorage : RunConfig.getVariablesStorage())
+        {
+          std::string PrecisionStr = "full";
+          if (VarStorage.second.Precision == openfluid::core::ValuesBuffer::StoragePrecision::FLOAT32)
+          {
+            PrecisionStr = "float32";
+          }
+          else if (VarStorage.second.Precision == openfluid::core::ValuesBuffer::StoragePrecision::FIXED)
+          {
+            PrecisionStr = "fixed";
+          }
+
+          Printer.OpenElement("storage");
+          Printer.PushAttribute("unitsclass",VarStorage.first.first.c_str());
+          Printer.PushAttribute("variable",VarStorage.first.second.c_str());
+          Printer.PushAttribute("precision",PrecisionStr.c_str());
+          if (VarStorage.second.Precision == openfluid::core::ValuesBuffer::StoragePrecision::FIXED)
+          {
+            Printer.PushAttribute("scale",VarStorage.second.Scale);
+          }
+          Printer.CloseElement();
         }
       }
+
+      Printer.CloseElement();
     }
 
 
@@ -1232,28 +1441,32 @@ class FluidXWriterImplementation
     // =====================================================================
 
 
-    void insertDatastore(openfluid::thirdparty::xml::XMLElement* BaseElt) const
+    void writeDatastore(FluidXStreamPrinter& Printer) const
     {
       const auto& StoreItems = m_Descriptor.m_DatastoreDescriptor.items();
 
-      auto StoreElt = BaseElt->InsertNewChildElement("datastore");
+      Printer.OpenElement("datastore");
 
       for (const auto& Item: StoreItems)
       {
-        auto ItemElt = StoreElt->InsertNewChildElement("dataitem");
+        Printer.OpenElement("dataitem");
 
-        ItemElt->SetAttribute("id",Item->getID().c_str());
-        ItemElt->SetAttribute("type",
+        Printer.PushAttribute("id",Item->getID().c_str());
+        Printer.PushAttribute("type",
                               openfluid::core::UnstructuredValue::getStringFromValueType(Item->getType()).c_str());
-        ItemElt->SetAttribute("source",Item->getRelativePath().c_str());
+        Printer.PushAttribute("source",Item->getRelativePath().c_str());
 
         auto UClass = Item->getUnitsClass();
 
         if (!UClass.empty())
         {
-          ItemElt->SetAttribute("unitsclass",UClass.c_str());
+          Printer.PushAttribute("unitsclass",UClass.c_str());
         }
+
+        Printer.CloseElement();
       }
+
+      Printer.CloseElement();
     }
 
 
@@ -1261,19 +1474,22 @@ class FluidXWriterImplementation
     // =====================================================================
 
 
-    void insertMonitoring(openfluid::thirdparty::xml::XMLElement* BaseElt) const
+    void writeMonitoring(FluidXStreamPrinter& Printer) const
     {
       const auto& MonItems = m_Descriptor.m_MonitoringDescriptor.items();
 
-      auto MonElt = BaseElt->InsertNewChildElement("monitoring");
+      Printer.OpenElement("monitoring");
 
       for (const auto Item : MonItems)
       {
-        auto ObsElt = MonElt->InsertNewChildElement("observer");
-        ObsElt->SetAttribute("ID",Item->getID().c_str());
-        ObsElt->SetAttribute("enabled",Item->isEnabled());
-        insertWareParams(Item->getParameters(),ObsElt);
+        Printer.OpenElement("observer");
+        Printer.PushAttribute("ID",Item->getID().c_str());
+        Printer.PushAttribute("enabled",Item->isEnabled());
+        writeWareParams(Item->getParameters(),Printer);
+        Printer.CloseElement();
       }
+
+      Printer.CloseElement();
     }
 
 
@@ -1302,11 +1518,54 @@ class FluidXWriterImplementation
     // =====================================================================
 
 
+    using WriteMethod_t = void (FluidXWriterImplementation::*)(FluidXStreamPrinter&) const;
+
+
+    /**
+      Writes a fluidx file, streaming the contents produced by the given methods
+    */
+    void writeFile(const std::string& FilePath, const std::vector<WriteMethod_t>& Methods) const
+    {
+      mp_Listener->onFileWrite(FilePath);
+
+      // the file is closed even if a write method throws
+      std::unique_ptr<FILE,int(*)(FILE*)> File(std::fopen(FilePath.c_str(),"w"),&std::fclose);
+
+      if (!File)
+      {
+        mp_Listener->onFileWritten(openfluid::base::Listener::Status::ERROR_STATUS);
+        throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Error opening file for writing: "+
+                                                                           FilePath);
+      }
+
+      {
+        FluidXStreamPrinter Printer(File.get());
+        openfluid::thirdparty::openOpenFLUIDXMLStream(Printer,FluidXIO::FormatVersion);
+
+        for (const auto& Method : Methods)
+        {
+          (this->*Method)(Printer);
+        }
+
+        Printer.CloseElement();
+      }
+
+      File.reset();
+
+      mp_Listener->onFileWritten(openfluid::base::Listener::Status::OK_STATUS);
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
   public:
 
 
-    FluidXWriterImplementation(const FluidXDescriptor& Desc, openfluid::base::IOListener* Listener):
-      m_Descriptor(Desc), mp_Listener(Listener)
+    FluidXWriterImplementation(const FluidXDescriptor& Desc, openfluid::base::IOListener* Listener,
+                               unsigned int ThreadsCount):
+      m_Descriptor(Desc), mp_Listener(Listener), m_ThreadsCount(std::max(1U,ThreadsCount))
     { }
 
 
@@ -1316,34 +1575,19 @@ class FluidXWriterImplementation
 
       prepareFluidXDir(DirPath);
 
-      // TODO use std::function instead
-      using insertMethod = void (FluidXWriterImplementation::*)(openfluid::thirdparty::xml::XMLElement*) const;
-
       // list of fluidx files to write with associated method to call (using pointer to function)
-      std::vector<std::pair<std::string,insertMethod>> FilesFunctions =
+      std::vector<std::pair<std::string,WriteMethod_t>> FilesFunctions =
       { 
-        { std::string("model.fluidx"), &FluidXWriterImplementation::insertModel },
-        { std::string("domain.fluidx"), &FluidXWriterImplementation::insertDomain },
-        { std::string("monitoring.fluidx"), &FluidXWriterImplementation::insertMonitoring },
-        { std::string("datastore.fluidx"), &FluidXWriterImplementation::insertDatastore },
-        { std::string("run.fluidx"), &FluidXWriterImplementation::insertRunConfiguration }
+        { std::string("model.fluidx"), &FluidXWriterImplementation::writeModel },
+        { std::string("domain.fluidx"), &FluidXWriterImplementation::writeDomain },
+        { std::string("monitoring.fluidx"), &FluidXWriterImplementation::writeMonitoring },
+        { std::string("datastore.fluidx"), &FluidXWriterImplementation::writeDatastore },
+        { std::string("run.fluidx"), &FluidXWriterImplementation::writeRunConfiguration }
       };
 
       for (auto FileFunc : FilesFunctions)
       {
-        auto FilePath = openfluid::tools::Filesystem::joinPath({DirPath,FileFunc.first});
-        
-        mp_Listener->onFileWrite(FilePath);
-
-        openfluid::thirdparty::xml::XMLDocument Doc;
-        auto OFElt = openfluid::thirdparty::prepareOpenFLUIDXMLDoc(Doc,FluidXIO::FormatVersion);
-        
-        // calls the associated method
-        (this->*FileFunc.second)(OFElt);
-        
-        Doc.SaveFile(FilePath.c_str());
-        
-        mp_Listener->onFileWritten(openfluid::base::Listener::Status::OK_STATUS);
+        writeFile(openfluid::tools::Filesystem::joinPath({DirPath,FileFunc.first}),{FileFunc.second});
       }
 
       mp_Listener->onWritten(openfluid::base::Listener::Status::OK_STATUS);
@@ -1360,20 +1604,11 @@ class FluidXWriterImplementation
 
       prepareFluidXDir(openfluid::tools::FilesystemPath(FilePath).dirname());
 
-      mp_Listener->onFileWrite(FilePath);
-
-      openfluid::thirdparty::xml::XMLDocument Doc;
-      auto OFElt = openfluid::thirdparty::prepareOpenFLUIDXMLDoc(Doc,FluidXIO::FormatVersion);
-
-      insertModel(OFElt);
-      insertDomain(OFElt);
-      insertDatastore(OFElt);
-      insertMonitoring(OFElt);
-      insertRunConfiguration(OFElt);
-
-      Doc.SaveFile(FilePath.c_str());
-
-      mp_Listener->onFileWritten(openfluid::base::Listener::Status::OK_STATUS);
+      writeFile(FilePath,{&FluidXWriterImplementation::writeModel,
+                          &FluidXWriterImplementation::writeDomain,
+                          &FluidXWriterImplementation::writeDatastore,
+                          &FluidXWriterImplementation::writeMonitoring,
+                          &FluidXWriterImplementation::writeRunConfiguration});
 
       mp_Listener->onWritten(openfluid::base::Listener::Status::OK_STATUS);
     }
@@ -1385,7 +1620,7 @@ class FluidXWriterImplementation
 // =====================================================================
 
 
-FluidXIO::FluidXIO(openfluid::base::IOListener* Listener) : mp_Listener(Listener)
+FluidXIO::FluidXIO(openfluid::base::IOListener* Listener) : mp_Listener(Listener), m_WritingThreadsCount(1)
 {
   if (!mp_Listener)
   {
@@ -1418,7 +1653,7 @@ FluidXDescriptor FluidXIO::loadFromDirectory(const std::string& DirPath)
 
 void FluidXIO::writeToSingleFile(const FluidXDescriptor& Desc, const std::string& FilePath) const
 {
-  FluidXWriterImplementation FXWriter(Desc,mp_Listener);
+  FluidXWriterImplementation FXWriter(Desc,mp_Listener,m_WritingThreadsCount);
 
   FXWriter.runSingleFile(FilePath);
 }
@@ -1430,7 +1665,7 @@ void FluidXIO::writeToSingleFile(const FluidXDescriptor& Desc, const std::string
 
 void FluidXIO::writeToManyFiles(const FluidXDescriptor& Desc, const std::string& DirPath) const
 {
-  FluidXWriterImplementation FXWriter(Desc,mp_Listener);
+  FluidXWriterImplementation FXWriter(Desc,mp_Listener,m_WritingThreadsCount);
 
   FXWriter.runManyFiles(DirPath);
 }
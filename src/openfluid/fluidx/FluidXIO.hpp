@@ -42,6 +42,7 @@
 
 
 #include <string>
+#include <algorithm>
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/fluidx/FluidXDescriptor.hpp>
@@ -137,6 +138,8 @@ class OPENFLUID_API FluidXIO
 
     LoadingReport m_LoadingReport;
 
+    unsigned int m_WritingThreadsCount;
+
 
   public:
 
@@ -151,8 +154,30 @@ class OPENFLUID_API FluidXIO
       return m_LoadingReport;
     }
 
+    /**
+      Sets the number of threads used to format the spatial attributes when writing fluidx files.
+      Default is 1, meaning that attributes are formatted in the writing thread
+      @param[in] Count the number of threads
+    */
+    void setWritingThreadsCount(unsigned int Count)
+    {
+      m_WritingThreadsCount = std::max(1U,Count);
+    }
+
+    /**
+      Writes the given descriptor into fluidx files, one file per section, in the given directory.
+      The files are streamed as they are produced, without building XML documents in memory
+      @param[in] Desc the descriptor to write
+      @param[in] DirPath the path of the output directory
+    */
     void writeToManyFiles(const FluidXDescriptor& Desc, const std::string& DirPath) const;
 
+    /**
+      Writes the given descriptor into a single fluidx file.
+      The file is streamed as it is produced, without building an XML document in memory
+      @param[in] Desc the descriptor to write
+      @param[in] FilePath the path of the output file
+    */
     void writeToSingleFile(const FluidXDescriptor& Desc, const std::string& FilePath) const;
 };
 
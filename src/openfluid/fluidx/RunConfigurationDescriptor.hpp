@@ -41,8 +41,12 @@
 #define __OPENFLUID_FLUIDX_RUNCONFIGURATIONDESCRIPTOR_HPP__
 
 
+#include <map>
+
 #include <openfluid/dllexport.hpp>
 #include <openfluid/core/DateTime.hpp>
+#include <openfluid/core/TypeDefs.hpp>
+#include <openfluid/core/ValuesBuffer.hpp>
 #include <openfluid/base/SimulationStatus.hpp>
 
 
@@ -51,6 +55,28 @@ namespace openfluid { namespace fluidx {
 
 class OPENFLUID_API RunConfigurationDescriptor
 {
+  public:
+
+    /**
+      Storage precision of the values of a variable
+    */
+    struct VariableStorage
+    {
+      openfluid::core::ValuesBuffer::StoragePrecision Precision = openfluid::core::ValuesBuffer::StoragePrecision::FULL;
+
+      /**
+        Scale of the stored values, used only for the FIXED precision
+      */
+      double Scale = 1.0;
+    };
+
+    /**
+      Storage precisions of variables, indexed by units class and variable name
+    */
+    typedef std::map<std::pair<openfluid::core::UnitsClass_t,openfluid::core::VariableName_t>,VariableStorage>
+      VariablesStorage_t;
+
+
   private:
 
     int m_DeltaT;
@@ -63,6 +89,8 @@ class OPENFLUID_API RunConfigurationDescriptor
     bool m_IsUserValuesBufferSize;
     unsigned int m_ValuesBufferSize;
 
+    VariablesStorage_t m_VariablesStorage;
+
     /**
       Indicates if the configuration is set up ("filled") or not
     */
@@ -123,6 +151,29 @@ class OPENFLUID_API RunConfigurationDescriptor
       return m_ValuesBufferSize;
     }
 
+    /**
+      Sets the storage precision of the values of a variable on a units class
+      @param[in] UnitsClass the units class
+      @param[in] VarName the variable name
+      @param[in] Storage the storage precision
+    */
+    inline void setVariableStorage(const openfluid::core::UnitsClass_t& UnitsClass,
+                                   const openfluid::core::VariableName_t& VarName,
+                                   const VariableStorage& Storage)
+    {
+      m_VariablesStorage[{UnitsClass,VarName}] = Storage;
+    }
+
+    inline const VariablesStorage_t& getVariablesStorage() const
+    {
+      return m_VariablesStorage;
+    }
+
+    inline void clearVariablesStorage()
+    {
+      m_VariablesStorage.clear();
+    }
+
     inline openfluid::base::SimulationStatus::SchedulingConstraint getSchedulingConstraint() const
     {
       return m_SchedConstraint;
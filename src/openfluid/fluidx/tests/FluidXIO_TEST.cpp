@@ -62,6 +62,9 @@ typedef boost::onullstream onullstream_type;
 #include <openfluid/fluidx/WareSetDescriptor.hpp>
 #include <openfluid/tools/FilesystemPath.hpp>
 
+#include <fstream>
+#include <sstream>
+
 #include "tests-config.hpp"
 
 
@@ -529,3 +532,154 @@ BOOST_AUTO_TEST_CASE(check_write_read_operations_of_xml_entities)
 
   delete L;
 }
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::string getFileContents(const std::string& FilePath)
+{
+  std::ifstream InFile(FilePath,std::ios::binary);
+  std::ostringstream Contents;
+  Contents << InFile.rdbuf();
+  return Contents.str();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_write_compatibility)
+{
+  // reference files were written by the previous DOM-based writer from the same input datasets
+  const std::string RefDir = CONFIGTESTS_INPUT_DATASETS_DIR+"/OPENFLUID.IN.FluidXWriterReferences";
+  const std::string OutputDir = CONFIGTESTS_OUTPUT_DATA_DIR+"/OPENFLUID.OUT.FluidXWriterReferences";
+
+  const std::vector<std::pair<std::string,std::string>> Datasets = {
+    {"manyfiles1",CONFIGTESTS_INPUT_DATASETS_DIR+"/OPENFLUID.IN.FluidXIO/manyfiles1"},
+    {"singlefile1",CONFIGTESTS_INPUT_DATASETS_DIR+"/OPENFLUID.IN.FluidXIO/singlefile1"},
+    {"FluidXWriter",CONFIGTESTS_INPUT_DATASETS_DIR+"/OPENFLUID.IN.FluidXWriter"}
+  };
+
+  auto OutputDirFSP = openfluid::tools::FilesystemPath(OutputDir);
+  if (OutputDirFSP.isDirectory())
+  {
+    OutputDirFSP.removeDirectory();
+  }
+
+  std::unique_ptr<openfluid::base::IOListener> Listener = std::make_unique<openfluid::base::IOListener>();
+  openfluid::fluidx::FluidXIO FXIO(Listener.get());
+
+  for (const auto& Dataset : Datasets)
+  {
+    const auto FXDesc = FXIO.loadFromDirectory(Dataset.second);
+
+    for (unsigned int ThreadsCount : {1,4})
+    {
+      const std::string DatasetOutputDir = OutputDir+"/"+Dataset.first+"-"+std::to_string(ThreadsCount);
+
+      FXIO.setWritingThreadsCount(ThreadsCount);
+      FXIO.writeToManyFiles(FXDesc,DatasetOutputDir+"/many");
+      FXIO.writeToSingleFile(FXDesc,DatasetOutputDir+"/single/all.fluidx");
+
+      for (const auto& FileName : {"domain.fluidx","model.fluidx","run.fluidx",
+                                   "monitoring.fluidx","datastore.fluidx"})
+      {
+        BOOST_TEST_INFO(Dataset.first+"/"+FileName);
+        BOOST_REQUIRE_EQUAL(getFileContents(DatasetOutputDir+"/many/"+FileName),
+                            getFileContents(RefDir+"/"+Dataset.first+"/many/"+FileName));
+      }
+
+      BOOST_TEST_INFO(Dataset.first+"/all.fluidx");
+      BOOST_REQUIRE_EQUAL(getFileContents(DatasetOutputDir+"/single/all.fluidx"),
+                          getFileContents(RefDir+"/"+Dataset.first+"/single/all.fluidx"));
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_write_large_domain)
+{
+  const std::string OutputDir = CONFIGTESTS_OUTPUT_DATA_DIR+"/OPENFLUID.OUT.FluidXWriterLarge";
+  const unsigned int UnitsCount = 5000;
+
+  auto OutputDirFSP = openfluid::tools::FilesystemPath(OutputDir);
+  if (OutputDirFSP.isDirectory())
+  {
+    OutputDirFSP.removeDirectory();
+  }
+
+  openfluid::fluidx::FluidXDescriptor FXDesc;
+  auto& Domain = FXDesc.spatialDomain();
+
+  for (unsigned int i=1; i<=UnitsCount; i++)
+  {
+    openfluid::fluidx::SpatialUnitDescriptor U;
+    U.setUnitsClass("LU");
+    U.setID(i);
+    U.setProcessOrder(1+(i%3));
+    Domain.addUnit(U,false);
+  }
+
+  Domain.addAttribute("LU","area","0",false);
+  Domain.addAttribute("LU","slope","0",false);
+
+  for (unsigned int i=1; i<=UnitsCount; i++)
+  {
+    Domain.setAttribute("LU",i,"area",std::to_string(i*10));
+    Domain.addFromToRelation({"LU",i},{"LU",(i%UnitsCount)+1});
+  }
+  Domain.addEvent("LU",17,openfluid::core::Event(openfluid::core::DateTime(2000,1,1,12,0,0)));
+
+  FXDesc.runConfiguration().setBeginDate(openfluid::core::DateTime(2000,1,1,0,0,0));
+  FXDesc.runConfiguration().setEndDate(openfluid::core::DateTime(2000,1,2,0,0,0));
+  FXDesc.runConfiguration().setDeltaT(3600);
+  FXDesc.runConfiguration().setVariableStorage("LU","var.float",
+                                               {openfluid::core::ValuesBuffer::StoragePrecision::FLOAT32,1.0});
+  FXDesc.runConfiguration().setVariableStorage("LU","var.fixed",
+                                               {openfluid::core::ValuesBuffer::StoragePrecision::FIXED,0.001});
+  FXDesc.runConfiguration().setFilled(true);
+
+  std::unique_ptr<openfluid::base::IOListener> Listener = std::make_unique<openfluid::base::IOListener>();
+  openfluid::fluidx::FluidXIO FXIO(Listener.get());
+
+  FXIO.writeToManyFiles(FXDesc,OutputDir+"/sequential");
+  FXIO.writeToSingleFile(FXDesc,OutputDir+"/sequential-single/all.fluidx");
+
+  // attributes formatted in parallel give the same files
+  FXIO.setWritingThreadsCount(4);
+  FXIO.writeToManyFiles(FXDesc,OutputDir+"/parallel");
+  FXIO.writeToSingleFile(FXDesc,OutputDir+"/parallel-single/all.fluidx");
+
+  for (const auto& FileName : {"domain.fluidx","model.fluidx","run.fluidx"})
+  {
+    BOOST_REQUIRE_EQUAL(getFileContents(OutputDir+"/sequential/"+FileName),
+                        getFileContents(OutputDir+"/parallel/"+FileName));
+  }
+  BOOST_REQUIRE_EQUAL(getFileContents(OutputDir+"/sequential-single/all.fluidx"),
+                      getFileContents(OutputDir+"/parallel-single/all.fluidx"));
+
+  openfluid::fluidx::FluidXDescriptor LoadedDesc = FXIO.loadFromDirectory(OutputDir+"/parallel");
+  const auto& LoadedDomain = LoadedDesc.spatialDomain();
+
+  BOOST_REQUIRE_EQUAL(LoadedDomain.getUnitsCount(),UnitsCount);
+  BOOST_REQUIRE_EQUAL(LoadedDomain.getAttribute("LU",1,"area"),"10");
+  BOOST_REQUIRE_EQUAL(LoadedDomain.getAttribute("LU",2049,"area"),"20490");
+  BOOST_REQUIRE_EQUAL(LoadedDomain.getAttribute("LU",UnitsCount,"slope"),"0");
+  BOOST_REQUIRE_EQUAL(LoadedDomain.toSpatialUnits({"LU",UnitsCount}).size(),1);
+  BOOST_REQUIRE_EQUAL(LoadedDomain.spatialUnit("LU",17).events().size(),1);
+
+  const auto& LoadedStorage = LoadedDesc.runConfiguration().getVariablesStorage();
+  BOOST_REQUIRE_EQUAL(LoadedStorage.size(),2);
+  BOOST_REQUIRE(LoadedStorage.at({"LU","var.float"}).Precision ==
+                openfluid::core::ValuesBuffer::StoragePrecision::FLOAT32);
+  BOOST_REQUIRE(LoadedStorage.at({"LU","var.fixed"}).Precision ==
+                openfluid::core::ValuesBuffer::StoragePrecision::FIXED);
+  BOOST_REQUIRE_EQUAL(LoadedStorage.at({"LU","var.fixed"}).Scale,0.001);
+}
@@ -97,4 +97,18 @@ BOOST_AUTO_TEST_CASE(check_operations)
 
   BOOST_REQUIRE_EQUAL(RunDesc.isUserValuesBufferSize(),true);
   BOOST_REQUIRE_EQUAL(RunDesc.getValuesBufferSize(),1179);
+
+  BOOST_REQUIRE(RunDesc.getVariablesStorage().empty());
+
+  RunDesc.setVariableStorage("TU","var.a",{openfluid::core::ValuesBuffer::StoragePrecision::FLOAT32,1.0});
+  RunDesc.setVariableStorage("TU","var.b",{openfluid::core::ValuesBuffer::StoragePrecision::FIXED,0.01});
+  RunDesc.setVariableStorage("TU","var.a",{openfluid::core::ValuesBuffer::StoragePrecision::FIXED,0.1});
+
+  BOOST_REQUIRE_EQUAL(RunDesc.getVariablesStorage().size(),2);
+  BOOST_REQUIRE(RunDesc.getVariablesStorage().at({"TU","var.a"}).Precision ==
+                openfluid::core::ValuesBuffer::StoragePrecision::FIXED);
+  BOOST_REQUIRE_EQUAL(RunDesc.getVariablesStorage().at({"TU","var.b"}).Scale,0.01);
+
+  RunDesc.clearVariablesStorage();
+  BOOST_REQUIRE(RunDesc.getVariablesStorage().empty());
 }
@@ -0,0 +1,230 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file DomainDecomposition.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include <openfluid/global.hpp>
+
+#if defined(OPENFLUID_OS_UNIX)
+#include <csignal>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#endif
+
+#if defined(OPENFLUID_OS_LINUX)
+#include <sys/prctl.h>
+#endif
+
+#include <openfluid/machine/DomainDecomposition.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+DomainDecomposition::DomainDecomposition(const DomainPartition& Partition, unsigned int ExchangeCapacity) :
+  m_Partition(Partition), m_ExchangeCapacity(std::max(4u,ExchangeCapacity))
+{
+
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+#if defined(OPENFLUID_OS_UNIX)
+
+unsigned int DomainDecomposition::run(const WorkerFunction_t& Worker)
+{
+  static std::atomic<unsigned int> RunsCount(0);
+
+  const unsigned int PartsCount = m_Partition.getPartsCount();
+  const std::string SegmentsPrefix = "/openfluid-" + std::to_string(getpid()) + "-" + std::to_string(RunsCount++);
+
+
+  // the control area is shared by the workers through the fork
+
+  const std::size_t ControlSize = HaloExchange::getControlSize(PartsCount);
+  void* Control = mmap(nullptr,ControlSize,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_ANONYMOUS,-1,0);
+
+  if (Control == MAP_FAILED)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"unable to create the workers control area");
+  }
+
+  HaloExchange::initializeControl(Control,PartsCount);
+
+  std::cout.flush();
+  std::cerr.flush();
+
+  std::vector<pid_t> Workers(PartsCount,-1);
+  unsigned int FailedCount = 0;
+
+  // workers are gathered in their own process group, led by the first worker,
+  // so that only them are waited for and other children of the process are left to their owners
+  pid_t WorkersGroup = 0;
+  const pid_t ParentPID = getpid();
+
+  for (unsigned int Part = 0; Part < PartsCount; Part++)
+  {
+    const pid_t PID = fork();
+
+    if (PID == 0)
+    {
+      int Status = 1;
+
+      setpgid(0,WorkersGroup);
+
+#if defined(OPENFLUID_OS_LINUX)
+      // workers are not in the foreground process group anymore, they must end with the parent process
+      prctl(PR_SET_PDEATHSIG,SIGKILL);
+      if (getppid() != ParentPID)
+      {
+        _exit(1);
+      }
+#endif
+
+      try
+      {
+        HaloExchange Exchange(m_Partition,Part,Control,SegmentsPrefix,m_ExchangeCapacity);
+        Status = Worker(Exchange);
+      }
+      catch (std::exception& E)
+      {
+        std::cerr << "worker of domain part " << Part << ": " << E.what() << std::endl;
+      }
+      catch (...)
+      {
+        // any exception must end the worker here, never unwind into the stack duplicated from the parent
+        std::cerr << "worker of domain part " << Part << ": unknown error" << std::endl;
+        Status = 1;
+      }
+
+      if (Status != 0)
+      {
+        HaloExchange::setFailed(Control,Part);
+      }
+
+      std::cout.flush();
+      std::cerr.flush();
+      _exit(Status);
+    }
+    else if (PID < 0)
+    {
+      HaloExchange::setFailed(Control,Part);
+      FailedCount++;
+    }
+    else
+    {
+      // the group is set by both processes, whichever runs first
+      setpgid(PID,WorkersGroup);
+
+      if (!WorkersGroup)
+      {
+        WorkersGroup = PID;
+      }
+    }
+
+    Workers[Part] = PID;
+  }
+
+
+  // workers are waited for until all ended, a failed worker is reported to its neighbours
+
+  unsigned int RunningCount = PartsCount-FailedCount;
+
+  while (RunningCount)
+  {
+    int Status = 0;
+    const pid_t PID = waitpid(-WorkersGroup,&Status,0);
+
+    if (PID < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      break;
+    }
+
+    const auto It = std::find(Workers.begin(),Workers.end(),PID);
+
+    if (It != Workers.end())
+    {
+      const unsigned int Part = std::distance(Workers.begin(),It);
+
+      if (!WIFEXITED(Status) || WEXITSTATUS(Status) != 0)
+      {
+        HaloExchange::setFailed(Control,Part);
+        FailedCount++;
+      }
+
+      *It = -1;
+      RunningCount--;
+    }
+  }
+
+  for (unsigned int Part = 0; Part < PartsCount; Part++)
+  {
+    shm_unlink(HaloExchange::getSegmentName(SegmentsPrefix,Part).c_str());
+  }
+
+  munmap(Control,ControlSize);
+
+  return FailedCount;
+}
+
+#else
+
+unsigned int DomainDecomposition::run(const WorkerFunction_t& /*Worker*/)
+{
+  throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                            "domain decomposition is not available on this system");
+}
+
+#endif
+
+
+} }  // namespaces
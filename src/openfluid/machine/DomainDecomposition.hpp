@@ -0,0 +1,110 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file DomainDecomposition.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_MACHINE_DOMAINDECOMPOSITION_HPP__
+#define __OPENFLUID_MACHINE_DOMAINDECOMPOSITION_HPP__
+
+
+#include <functional>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/machine/DomainPartitioner.hpp>
+#include <openfluid/machine/HaloExchange.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+/**
+  Runner of a simulation on a partitioned spatial domain, using one local worker process per part of the domain.
+  Workers exchange the values of the units at the boundaries of their parts through shared memory.
+  Workers are run in their own process group and only them are waited for,
+  other child processes of the host application are left untouched.
+  Only available on Unix systems.
+*/
+class OPENFLUID_API DomainDecomposition
+{
+  public:
+
+    /**
+      Function run by each worker process, returning 0 on success
+    */
+    typedef std::function<int(HaloExchange&)> WorkerFunction_t;
+
+
+  private:
+
+    const DomainPartition& m_Partition;
+
+    unsigned int m_ExchangeCapacity;
+
+
+  public:
+
+    static constexpr unsigned int DefaultExchangeCapacity = 32;
+
+    DomainDecomposition() = delete;
+
+    /**
+      @param[in] Partition the partition of the spatial domain, one worker being run for each part
+      @param[in] ExchangeCapacity the maximum count of time points a worker can be ahead of its neighbours
+    */
+    DomainDecomposition(const DomainPartition& Partition,
+                        unsigned int ExchangeCapacity = DefaultExchangeCapacity);
+
+    const DomainPartition& partition() const
+    {
+      return m_Partition;
+    }
+
+    /**
+      Runs the given function in a separate worker process for each part of the domain,
+      then waits for the end of all workers. A worker failing makes its neighbours fail
+      instead of waiting for its values.
+      @param[in] Worker the function run by each worker, with the halo exchange of its part
+      @return the count of failed workers
+      @throw openfluid::base::FrameworkException if the workers could not be started
+    */
+    unsigned int run(const WorkerFunction_t& Worker);
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_DOMAINDECOMPOSITION_HPP__ */
@@ -0,0 +1,508 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file DomainPartitioner.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#include <openfluid/machine/DomainPartitioner.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/tools/IDHelpers.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+namespace {
+
+
+std::size_t findGroup(std::vector<std::size_t>& Groups, std::size_t Node)
+{
+  while (Groups[Node] != Node)
+  {
+    Groups[Node] = Groups[Groups[Node]];
+    Node = Groups[Node];
+  }
+  return Node;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes the strongly connected components of the given directed graph (iterative Tarjan algorithm)
+  @return the count of components
+*/
+std::size_t computeComponents(const std::vector<std::vector<std::size_t>>& Out, std::vector<std::size_t>& Components)
+{
+  const std::size_t NodesCount = Out.size();
+  const std::size_t Unset = NodesCount;
+
+  std::vector<std::size_t> Index(NodesCount,Unset);
+  std::vector<std::size_t> LowLink(NodesCount,0);
+  std::vector<bool> OnStack(NodesCount,false);
+  std::vector<std::size_t> Stack;
+  std::vector<std::pair<std::size_t,std::size_t>> CallStack;
+
+  std::size_t CurrentIndex = 0;
+  std::size_t ComponentsCount = 0;
+
+  Components.assign(NodesCount,Unset);
+
+  for (std::size_t Root = 0; Root < NodesCount; Root++)
+  {
+    if (Index[Root] != Unset)
+    {
+      continue;
+    }
+
+    CallStack.emplace_back(Root,0);
+
+    while (!CallStack.empty())
+    {
+      const std::size_t Node = CallStack.back().first;
+      std::size_t& NextEdge = CallStack.back().second;
+
+      if (NextEdge == 0 && Index[Node] == Unset)
+      {
+        Index[Node] = CurrentIndex;
+        LowLink[Node] = CurrentIndex;
+        CurrentIndex++;
+        Stack.push_back(Node);
+        OnStack[Node] = true;
+      }
+
+      if (NextEdge < Out[Node].size())
+      {
+        const std::size_t Next = Out[Node][NextEdge];
+        NextEdge++;
+
+        if (Index[Next] == Unset)
+        {
+          CallStack.emplace_back(Next,0);
+        }
+        else if (OnStack[Next])
+        {
+          LowLink[Node] = std::min(LowLink[Node],Index[Next]);
+        }
+      }
+      else
+      {
+        if (LowLink[Node] == Index[Node])
+        {
+          std::size_t Member;
+          do
+          {
+            Member = Stack.back();
+            Stack.pop_back();
+            OnStack[Member] = false;
+            Components[Member] = ComponentsCount;
+          }
+          while (Member != Node);
+
+          ComponentsCount++;
+        }
+
+        CallStack.pop_back();
+
+        if (!CallStack.empty())
+        {
+          const std::size_t Caller = CallStack.back().first;
+          LowLink[Caller] = std::min(LowLink[Caller],LowLink[Node]);
+        }
+      }
+    }
+  }
+
+  return ComponentsCount;
+}
+
+
+}  // namespace
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int DomainPartition::getPart(const openfluid::core::UnitClassID_t& Unit) const
+{
+  auto it = m_UnitsParts.find(Unit);
+
+  if (it == m_UnitsParts.end())
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "unit " + openfluid::tools::classIDToString(Unit.first,Unit.second) +
+                                              " is not in the partitioned domain");
+  }
+
+  return it->second;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::fluidx::SpatialDomainDescriptor
+DomainPartition::extractSubdomain(const openfluid::fluidx::SpatialDomainDescriptor& Domain, unsigned int Part) const
+{
+  openfluid::fluidx::SpatialDomainDescriptor Subdomain;
+
+  for (const auto& Unit : m_Units.at(Part))
+  {
+    openfluid::fluidx::SpatialUnitDescriptor UnitDesc = Domain.spatialUnit(Unit.first,Unit.second);
+
+    auto isOutside = [this,Part](const openfluid::core::UnitClassID_t& Linked)
+    {
+      auto it = m_UnitsParts.find(Linked);
+      return (it == m_UnitsParts.end() || it->second != Part);
+    };
+
+    UnitDesc.toSpatialUnits().remove_if(isOutside);
+    UnitDesc.parentSpatialUnits().remove_if(isOutside);
+
+    Subdomain.spatialUnits()[Unit.first].emplace(Unit.second,std::move(UnitDesc));
+  }
+
+  return Subdomain;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+DomainPartition DomainPartitioner::partition(const openfluid::fluidx::SpatialDomainDescriptor& Domain,
+                                             unsigned int PartsCount, double Tolerance)
+{
+  if (PartsCount == 0)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"wrong number of parts for partitioning");
+  }
+
+
+  // indexing of units
+
+  std::vector<const openfluid::fluidx::SpatialUnitDescriptor*> Units;
+  std::map<openfluid::core::UnitClassID_t,std::size_t> UnitsIndex;
+
+  for (const auto& UnitsClass : Domain.spatialUnits())
+  {
+    for (const auto& Unit : UnitsClass.second)
+    {
+      UnitsIndex[{UnitsClass.first,Unit.first}] = Units.size();
+      Units.push_back(&Unit.second);
+    }
+  }
+
+  const std::size_t UnitsCount = Units.size();
+
+  std::vector<std::vector<std::size_t>> UnitsTo(UnitsCount);
+
+  for (std::size_t i = 0; i < UnitsCount; i++)
+  {
+    for (const auto& ToUnit : Units[i]->toSpatialUnits())
+    {
+      auto it = UnitsIndex.find(ToUnit);
+      if (it != UnitsIndex.end())
+      {
+        UnitsTo[i].push_back(it->second);
+      }
+    }
+  }
+
+
+  // units linked by Parent-Child relations are grouped
+
+  std::vector<std::size_t> Groups(UnitsCount);
+  std::iota(Groups.begin(),Groups.end(),0);
+
+  for (std::size_t i = 0; i < UnitsCount; i++)
+  {
+    for (const auto& ParentUnit : Units[i]->parentSpatialUnits())
+    {
+      auto it = UnitsIndex.find(ParentUnit);
+      if (it != UnitsIndex.end())
+      {
+        Groups[findGroup(Groups,i)] = findGroup(Groups,it->second);
+      }
+    }
+  }
+
+  std::vector<std::size_t> UnitsGroups(UnitsCount);
+  std::map<std::size_t,std::size_t> GroupsIndex;
+
+  for (std::size_t i = 0; i < UnitsCount; i++)
+  {
+    UnitsGroups[i] = GroupsIndex.emplace(findGroup(Groups,i),GroupsIndex.size()).first->second;
+  }
+
+  std::vector<std::vector<std::size_t>> GroupsOut(GroupsIndex.size());
+
+  for (std::size_t i = 0; i < UnitsCount; i++)
+  {
+    for (auto j : UnitsTo[i])
+    {
+      if (UnitsGroups[i] != UnitsGroups[j])
+      {
+        GroupsOut[UnitsGroups[i]].push_back(UnitsGroups[j]);
+      }
+    }
+  }
+
+
+  // groups involved in cycles of From-To relations are merged, giving a directed acyclic graph of nodes
+
+  std::vector<std::size_t> GroupsNodes;
+  const std::size_t NodesCount = computeComponents(GroupsOut,GroupsNodes);
+
+  std::vector<std::size_t> UnitsNodes(UnitsCount);
+  std::vector<std::size_t> NodesWeights(NodesCount,0);
+  std::vector<std::pair<openfluid::core::PcsOrd_t,std::size_t>> NodesKeys(NodesCount,{0,UnitsCount});
+  std::vector<std::vector<std::size_t>> NodesOut(NodesCount), NodesIn(NodesCount);
+
+  for (std::size_t i = 0; i < UnitsCount; i++)
+  {
+    const std::size_t Node = GroupsNodes[UnitsGroups[i]];
+    const std::pair<openfluid::core::PcsOrd_t,std::size_t> Key(Units[i]->getProcessOrder(),i);
+
+    UnitsNodes[i] = Node;
+    NodesWeights[Node]++;
+
+    if (NodesKeys[Node].second == UnitsCount || Key < NodesKeys[Node])
+    {
+      NodesKeys[Node] = Key;
+    }
+  }
+
+  for (std::size_t i = 0; i < UnitsCount; i++)
+  {
+    for (auto j : UnitsTo[i])
+    {
+      if (UnitsNodes[i] != UnitsNodes[j])
+      {
+        NodesOut[UnitsNodes[i]].push_back(UnitsNodes[j]);
+        NodesIn[UnitsNodes[j]].push_back(UnitsNodes[i]);
+      }
+    }
+  }
+
+  auto compareKeys = [&NodesKeys](std::size_t A, std::size_t B)
+  {
+    return NodesKeys[A] < NodesKeys[B];
+  };
+
+  for (auto& In : NodesIn)
+  {
+    std::sort(In.begin(),In.end(),compareKeys);
+    In.erase(std::unique(In.begin(),In.end()),In.end());
+  }
+
+
+  // nodes are ordered depth-first from the outlets, each node coming after all its upstream nodes,
+  // so upstream areas are contiguous in the ordering
+
+  std::vector<std::size_t> Outlets;
+  for (std::size_t n = 0; n < NodesCount; n++)
+  {
+    if (NodesOut[n].empty())
+    {
+      Outlets.push_back(n);
+    }
+  }
+  std::sort(Outlets.begin(),Outlets.end(),compareKeys);
+
+  std::vector<std::size_t> Ordering;
+  std::vector<std::size_t> NodesPositions(NodesCount,NodesCount);
+  std::vector<bool> Visited(NodesCount,false);
+  std::vector<std::pair<std::size_t,std::size_t>> VisitStack;
+
+  for (auto Outlet : Outlets)
+  {
+    VisitStack.emplace_back(Outlet,0);
+    Visited[Outlet] = true;
+
+    while (!VisitStack.empty())
+    {
+      const std::size_t Node = VisitStack.back().first;
+      std::size_t& NextIn = VisitStack.back().second;
+
+      if (NextIn < NodesIn[Node].size())
+      {
+        const std::size_t Upstream = NodesIn[Node][NextIn];
+        NextIn++;
+
+        if (!Visited[Upstream])
+        {
+          Visited[Upstream] = true;
+          VisitStack.emplace_back(Upstream,0);
+        }
+      }
+      else
+      {
+        NodesPositions[Node] = Ordering.size();
+        Ordering.push_back(Node);
+        VisitStack.pop_back();
+      }
+    }
+  }
+
+
+  // relations cut at each possible boundary between two consecutive nodes of the ordering
+
+  std::vector<std::size_t> CumulWeights(NodesCount+1,0);
+  for (std::size_t p = 0; p < NodesCount; p++)
+  {
+    CumulWeights[p+1] = CumulWeights[p] + NodesWeights[Ordering[p]];
+  }
+
+  std::vector<long long> CutRelations(NodesCount+1,0);
+  for (std::size_t i = 0; i < UnitsCount; i++)
+  {
+    for (auto j : UnitsTo[i])
+    {
+      if (UnitsNodes[i] != UnitsNodes[j])
+      {
+        CutRelations[NodesPositions[UnitsNodes[i]]+1]++;
+        CutRelations[NodesPositions[UnitsNodes[j]]+1]--;
+      }
+    }
+  }
+  std::partial_sum(CutRelations.begin(),CutRelations.end(),CutRelations.begin());
+
+
+  // boundaries of parts are chosen where the fewest relations are cut, near the balanced positions
+
+  const unsigned int FinalPartsCount = std::max<std::size_t>(1,std::min<std::size_t>(PartsCount,NodesCount));
+  const double PartWeight = double(UnitsCount)/FinalPartsCount;
+  const double Margin = std::max(0.0,Tolerance)*PartWeight;
+
+  std::vector<std::size_t> Boundaries;
+  std::size_t PreviousBoundary = 0;
+
+  for (unsigned int k = 1; k < FinalPartsCount; k++)
+  {
+    const double Target = PartWeight*k;
+    const std::size_t First = PreviousBoundary+1;
+    const std::size_t Last = NodesCount-(FinalPartsCount-k);
+
+    auto Distance = [&CumulWeights,Target](std::size_t Pos)
+    {
+      return std::abs(double(CumulWeights[Pos])-Target);
+    };
+
+    std::size_t Best = First;
+    for (std::size_t Pos = First; Pos <= Last; Pos++)
+    {
+      const bool InMargin = (Distance(Pos) <= Margin);
+      const bool BestInMargin = (Distance(Best) <= Margin);
+
+      if ((InMargin && !BestInMargin) ||
+          (InMargin && (CutRelations[Pos] < CutRelations[Best] ||
+                        (CutRelations[Pos] == CutRelations[Best] && Distance(Pos) < Distance(Best)))) ||
+          (!InMargin && !BestInMargin && Distance(Pos) < Distance(Best)))
+      {
+        Best = Pos;
+      }
+
+      if (double(CumulWeights[Pos]) > Target+Margin)
+      {
+        break;
+      }
+    }
+
+    Boundaries.push_back(Best);
+    PreviousBoundary = Best;
+  }
+
+
+  // building of the partition
+
+  DomainPartition Partition;
+
+  Partition.m_Units.resize(FinalPartsCount);
+  Partition.m_HaloUnits.resize(FinalPartsCount);
+  Partition.m_ExportedUnits.resize(FinalPartsCount);
+  Partition.m_UpstreamParts.resize(FinalPartsCount);
+  Partition.m_DownstreamParts.resize(FinalPartsCount);
+
+  std::vector<unsigned int> UnitsParts(UnitsCount);
+
+  for (std::size_t i = 0; i < UnitsCount; i++)
+  {
+    const std::size_t Pos = NodesPositions[UnitsNodes[i]];
+    const unsigned int Part = std::upper_bound(Boundaries.begin(),Boundaries.end(),Pos)-Boundaries.begin();
+    const openfluid::core::UnitClassID_t Unit(Units[i]->getUnitsClass(),Units[i]->getID());
+
+    UnitsParts[i] = Part;
+    Partition.m_UnitsParts[Unit] = Part;
+    Partition.m_Units[Part].push_back(Unit);
+  }
+
+  for (std::size_t i = 0; i < UnitsCount; i++)
+  {
+    for (auto j : UnitsTo[i])
+    {
+      const unsigned int FromPart = UnitsParts[i];
+      const unsigned int ToPart = UnitsParts[j];
+
+      if (FromPart != ToPart)
+      {
+        const openfluid::core::UnitClassID_t FromUnit(Units[i]->getUnitsClass(),Units[i]->getID());
+        const openfluid::core::UnitClassID_t ToUnit(Units[j]->getUnitsClass(),Units[j]->getID());
+
+        Partition.m_HaloUnits[FromPart].insert(ToUnit);
+        Partition.m_HaloUnits[ToPart].insert(FromUnit);
+        Partition.m_ExportedUnits[FromPart].insert(FromUnit);
+        Partition.m_ExportedUnits[ToPart].insert(ToUnit);
+        Partition.m_DownstreamParts[FromPart].insert(ToPart);
+        Partition.m_UpstreamParts[ToPart].insert(FromPart);
+        Partition.m_EdgeCut++;
+      }
+    }
+  }
+
+  return Partition;
+}
+
+
+} }  // namespaces
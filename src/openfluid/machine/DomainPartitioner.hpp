@@ -0,0 +1,190 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file DomainPartitioner.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_MACHINE_DOMAINPARTITIONER_HPP__
+#define __OPENFLUID_MACHINE_DOMAINPARTITIONER_HPP__
+
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/TypeDefs.hpp>
+#include <openfluid/fluidx/SpatialDomainDescriptor.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+/**
+  Partition of a spatial domain into parts, each part being simulated by a separate worker process.
+  Parts are numbered so that From-To relations between units of different parts always go
+  from a part to a part of greater number.
+*/
+class OPENFLUID_API DomainPartition
+{
+  friend class DomainPartitioner;
+
+  private:
+
+    std::map<openfluid::core::UnitClassID_t,unsigned int> m_UnitsParts;
+
+    std::vector<std::vector<openfluid::core::UnitClassID_t>> m_Units;
+
+    std::vector<std::set<openfluid::core::UnitClassID_t>> m_HaloUnits;
+
+    std::vector<std::set<openfluid::core::UnitClassID_t>> m_ExportedUnits;
+
+    std::vector<std::set<unsigned int>> m_UpstreamParts;
+
+    std::vector<std::set<unsigned int>> m_DownstreamParts;
+
+    unsigned int m_EdgeCut = 0;
+
+
+  public:
+
+    DomainPartition() = default;
+
+    inline unsigned int getPartsCount() const
+    {
+      return m_Units.size();
+    }
+
+    /**
+      Returns the part of the given unit
+      @throw openfluid::base::FrameworkException if the unit is not in the partitioned domain
+    */
+    unsigned int getPart(const openfluid::core::UnitClassID_t& Unit) const;
+
+    /**
+      Returns the units of the given part, in the order of the spatial domain descriptor
+    */
+    inline const std::vector<openfluid::core::UnitClassID_t>& units(unsigned int Part) const
+    {
+      return m_Units.at(Part);
+    }
+
+    /**
+      Returns the units of other parts linked by a From-To relation to units of the given part
+    */
+    inline const std::set<openfluid::core::UnitClassID_t>& haloUnits(unsigned int Part) const
+    {
+      return m_HaloUnits.at(Part);
+    }
+
+    /**
+      Returns the units of the given part which are halo units of other parts
+    */
+    inline const std::set<openfluid::core::UnitClassID_t>& exportedUnits(unsigned int Part) const
+    {
+      return m_ExportedUnits.at(Part);
+    }
+
+    /**
+      Returns the parts having units linked to units of the given part by a "To" relation
+    */
+    inline const std::set<unsigned int>& upstreamParts(unsigned int Part) const
+    {
+      return m_UpstreamParts.at(Part);
+    }
+
+    /**
+      Returns the parts having units linked to units of the given part by a "From" relation
+    */
+    inline const std::set<unsigned int>& downstreamParts(unsigned int Part) const
+    {
+      return m_DownstreamParts.at(Part);
+    }
+
+    /**
+      Returns the number of From-To relations between units of different parts
+    */
+    inline unsigned int getEdgeCut() const
+    {
+      return m_EdgeCut;
+    }
+
+    /**
+      Builds the descriptor of the subdomain made of the units of the given part.
+      Relations with units of other parts are not kept in the subdomain.
+      @param[in] Domain the partitioned spatial domain
+      @param[in] Part the part of the subdomain
+    */
+    openfluid::fluidx::SpatialDomainDescriptor
+    extractSubdomain(const openfluid::fluidx::SpatialDomainDescriptor& Domain, unsigned int Part) const;
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Partitioner of spatial domains, minimizing the number of From-To relations between parts
+  while balancing the number of units of each part.
+  Units linked by Parent-Child relations and units involved in cycles of From-To relations are never
+  separated, so the parts can be simulated as a pipeline following the From-To relations.
+*/
+class OPENFLUID_API DomainPartitioner
+{
+  public:
+
+    DomainPartitioner() = delete;
+
+    /**
+      Partitions the given spatial domain.
+      The domain is ordered depth-first from the outlets following the process orders,
+      so each part gathers whole upstream areas, then the parts boundaries are chosen where
+      the fewest relations are cut, within the given imbalance tolerance.
+      @param[in] Domain the spatial domain to partition
+      @param[in] PartsCount the requested number of parts. The partition may have less parts
+                 if the domain cannot be split enough
+      @param[in] Tolerance the allowed imbalance of parts sizes, as a ratio of the average part size
+      @throw openfluid::base::FrameworkException if the requested number of parts is 0
+    */
+    static DomainPartition partition(const openfluid::fluidx::SpatialDomainDescriptor& Domain,
+                                     unsigned int PartsCount, double Tolerance = 0.1);
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_DOMAINPARTITIONER_HPP__ */
@@ -37,20 +37,28 @@
 */
 
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
+#include <sstream>
 #include <set>
 #include <cmath>
 
 #include <openfluid/config.hpp>
+#include <openfluid/machine/HaloExchange.hpp>
 #include <openfluid/machine/MachineListener.hpp>
 #include <openfluid/machine/ModelInstance.hpp>
 #include <openfluid/machine/ModelItemInstance.hpp>
 #include <openfluid/machine/MonitoringInstance.hpp>
 #include <openfluid/machine/SimulationBlob.hpp>
+#include <openfluid/machine/SimulationCheckpoint.hpp>
 #include <openfluid/tools/Filesystem.hpp>
 #include <openfluid/tools/FilesystemPath.hpp>
 #include <openfluid/tools/MiscHelpers.hpp>
+#include <openfluid/tools/StringHelpers.hpp>
 #include <openfluid/base/RunContextManager.hpp>
 #include <openfluid/machine/Engine.hpp>
 
@@ -63,7 +71,8 @@ Engine::Engine(SimulationBlob& SimBlob,
                openfluid::machine::MachineListener* MachineListener)
   : m_SimulationBlob(SimBlob), mp_MachineListener(MachineListener),
     m_ModelInstance(MInstance), m_MonitoringInstance(OLInstance),
-    mp_SimLogger(nullptr)
+    mp_SimLogger(nullptr), m_LastCheckpointIndex(0), mp_HaloExchange(nullptr),
+    m_DataSchema(SimBlob.spatialGraph(),openfluid::base::RunContextManager::instance()->getWaresMaxNumThreads())
 {
   if (!mp_MachineListener)
   {
@@ -73,6 +82,23 @@ Engine::Engine(SimulationBlob& SimBlob,
 
   mp_SimStatus = &(m_SimulationBlob.simulationStatus());
 
+  m_CheckpointPeriod = openfluid::base::RunContextManager::instance()->getCheckpointPeriod();
+
+  // checkpoint is loaded before preparing the output directory which may contain it
+  const std::string& RestartPath = openfluid::base::RunContextManager::instance()->getRestartCheckpointPath();
+  if (!RestartPath.empty())
+  {
+    std::ifstream RestartFile(RestartPath,std::ios::binary);
+
+    if (!RestartFile)
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "Unable to open checkpoint file " + RestartPath);
+    }
+
+    m_RestartCheckpoint.assign(std::istreambuf_iterator<char>(RestartFile),std::istreambuf_iterator<char>());
+  }
+
   prepareOutputDir();
 
   mp_SimLogger = std::make_unique<openfluid::base::SimulationLogger>(
@@ -96,48 +122,11 @@ Engine::Engine(SimulationBlob& SimBlob,
 // =====================================================================
 
 
-void Engine::checkExistingVariable(const openfluid::core::VariableName_t& VarName,
-                                   const openfluid::core::Value::Type& VarType,
-                                   const openfluid::core::UnitsClass_t& ClassName,
-                                   const std::string& SimulatorID)
+Engine::~Engine()
 {
-  openfluid::core::UnitsList_t::const_iterator UnitIter;
-  openfluid::core::UnitsList_t* UnitList;
-
-  UnitList = nullptr;
-  if (m_SimulationBlob.spatialGraph().isUnitsClassExist(ClassName))
+  if (m_CheckpointWriting.valid())
   {
-    UnitList = m_SimulationBlob.spatialGraph().spatialUnits(ClassName)->list();
-  }
-  else
-  {
-    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
-                                              "Unit class " + ClassName + " does not exist for " +
-                                              VarName + " variable required by " + SimulatorID);
-  }
-
-  bool Status = true;
-
-  UnitIter = UnitList->begin();
-  while (UnitIter != UnitList->end())
-  {
-    if(VarType == openfluid::core::Value::NONE)
-    {
-      Status = (*UnitIter).variables()->isVariableExist(VarName);
-    }
-    else
-    {
-      Status = (*UnitIter).variables()->isTypedVariableExist(VarName,VarType);
-    }
-
-    if (!Status)
-    {
-      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
-                                                VarName + " variable on " + ClassName +
-                                                " required by " + SimulatorID + " does not exist");
-    }
-
-    ++UnitIter;
+    m_CheckpointWriting.wait();
   }
 }
 
@@ -146,104 +135,34 @@ void Engine::checkExistingVariable(const openfluid::core::VariableName_t& VarNam
 // =====================================================================
 
 
-void Engine::createVariable(const openfluid::core::VariableName_t& VarName,
-                            const openfluid::core::Value::Type& VarType,
-                            const openfluid::core::UnitsClass_t& ClassName,
-                            bool UpdateMode,
-                            const std::string& SimulatorID)
+void Engine::reportVariablesStorage()
 {
-  openfluid::core::UnitsList_t* UnitsList = nullptr;
-
-  if (m_SimulationBlob.spatialGraph().isUnitsClassExist(ClassName))
+  for (const auto& VarStorage : m_SimulationBlob.runConfiguration().getVariablesStorage())
   {
-    UnitsList = m_SimulationBlob.spatialGraph().spatialUnits(ClassName)->list();
-  }
-  else
-  {
-    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Unit class " + ClassName +
-                                              " does not exist for " + VarName +
-                                              " variable produced by " + SimulatorID);
-  }
+    const auto& ClassName = VarStorage.first.first;
+    const auto& VarName = VarStorage.first.second;
 
-  // if not update mode, variables must not exist before creation
-  if (!UpdateMode)
-  {
-    for (const auto& Unit : *UnitsList)
+    if (VarStorage.second.Precision == openfluid::core::ValuesBuffer::StoragePrecision::FULL ||
+        !m_SimulationBlob.spatialGraph().isUnitsClassExist(ClassName))
     {
-      if (Unit.variables()->isVariableExist(VarName))
-      {
-        throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
-                                                  VarName + " variable on " + ClassName +
-                                                  " produced by " + SimulatorID +
-                                                  " cannot be created because it is already created");
-      }
+      continue;
     }
-  }
-
-  for(auto& Unit : *UnitsList)
-  {
-    Unit.variables()->createVariable(VarName,VarType);
-  }
-}
-
-
-// =====================================================================
-// =====================================================================
-
 
-void Engine::checkExistingAttribute(const openfluid::core::AttributeName_t AttrName,
-                                    const openfluid::core::UnitsClass_t ClassName,
-                                    const std::string& SimulatorID)
-{
-  openfluid::core::UnitsList_t* UnitsList = nullptr;
+    double MaxError = 0.0;
 
-  if (m_SimulationBlob.spatialGraph().isUnitsClassExist(ClassName))
-  {
-    UnitsList = m_SimulationBlob.spatialGraph().spatialUnits(ClassName)->list();
-  }
-  else
-  {
-    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
-                                              "Unit " + ClassName + " class does not exist for " +
-                                             AttrName + " attribute required by " + SimulatorID);
-  }
-
-  for(auto& Unit : *UnitsList)
-  {
-    if (!Unit.attributes()->isAttributeExist(AttrName))
+    for (const auto& Unit : *(m_SimulationBlob.spatialGraph().spatialUnits(ClassName)->list()))
     {
-      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
-                                                AttrName + " attribute on " + ClassName +
-                                                " required by " + SimulatorID + " is not available");
+      MaxError = std::max(MaxError,Unit.variables()->getVariableStorageMaxError(VarName));
     }
-  }
-}
-
-
-// =====================================================================
-// =====================================================================
 
+    const std::string PrecisionStr =
+      (VarStorage.second.Precision == openfluid::core::ValuesBuffer::StoragePrecision::FLOAT32) ?
+        "float32" : openfluid::tools::format("fixed (scale %g)",VarStorage.second.Scale);
 
-void Engine::createAttribute(openfluid::core::AttributeName_t AttrName,
-                             openfluid::core::UnitsClass_t ClassName,
-                             const std::string& SimulatorID)
-{
-  openfluid::core::UnitsList_t* UnitsList = nullptr;
- 
-  if (m_SimulationBlob.spatialGraph().isUnitsClassExist(ClassName))
-  {
-    UnitsList = m_SimulationBlob.spatialGraph().spatialUnits(ClassName)->list();
-  }
-  else
-  {
-    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
-                                                 "Unit class " + ClassName + " does not exist for " +
-                                                 AttrName + " attribute produced by " + SimulatorID);
-  }
-
-  for(auto& Unit : *UnitsList)
-  {
-    Unit.attributes()->setValue(AttrName,openfluid::core::NullValue());
+    mp_SimLogger->addInfo(openfluid::base::FrameworkException::computeContext().toString(),
+                          openfluid::tools::format("Storage of variable %s on %s as %s, maximum storage error: %g",
+                                                   VarName.c_str(),ClassName.c_str(),
+                                                   PrecisionStr.c_str(),MaxError));
   }
 }
 
@@ -254,24 +173,7 @@ void Engine::createAttribute(openfluid::core::AttributeName_t AttrName,
 
 void Engine::checkSimulationVarsProduction(int ExpectedVarsCount)
 {
-  openfluid::core::VariableName_t ErrorVarName = "";
-
-  for (const auto& UnitsClass : (*m_SimulationBlob.spatialGraph().allSpatialUnitsByClass()))
-  {
-    for (const auto& Unit : (*UnitsClass.second.list()))
-    {
-      if (!(Unit.variables()->checkAllVariablesCount(ExpectedVarsCount,ErrorVarName)))
-      {
-        openfluid::base::ExceptionContext Ctxt;
-        Ctxt.addCodeLocation(OPENFLUID_CODE_LOCATION);
-        std::string UnitStr = Unit.getClass() + "#" + std::to_string(Unit.getID());
-        Ctxt.addSpatialUnit(UnitStr);
-
-        throw openfluid::base::FrameworkException(Ctxt,"Production error for variable " +
-                                                       ErrorVarName + " on " + UnitStr);
-      }
-    }
-  }
+  m_DataSchema.checkVariablesValuesCount(ExpectedVarsCount);
 }
 
 
@@ -362,61 +264,42 @@ void Engine::checkParametersConsistency()
 
 void Engine::checkModelConsistency()
 {
-  std::list<ModelItemInstance*>::const_iterator SimIter;
-  openfluid::ware::SignatureHandledData HData;
-  openfluid::ware::SimulatorSignatureHandledData SHData;
-  ModelItemInstance* CurrentSimulator;
-  unsigned int i;
-
-
   /* Variables processing order is important
-     A) first pass
+     A) first pass, declared in the schema then created in bulk on all units
         1) produced vars
         2) updated vars
      B) second pass
         3) required vars
   */
 
-  SimIter = m_ModelInstance.items().begin();
+  m_DataSchema.clear();
 
-  while (SimIter != m_ModelInstance.items().end())
+  for (const ModelItemInstance* CurrentSimulator : m_ModelInstance.items())
   {
-    CurrentSimulator = (*SimIter);
-    HData = CurrentSimulator->Container.signature()->HandledData;
-    SHData = CurrentSimulator->Container.signature()->SimulatorHandledData;
+    const auto& Signature = CurrentSimulator->Container.signature();
 
-    // checking variables to create (produced)
-    for (i=0;i< SHData.ProducedVars.size();i++)
+    for (const auto& Var : Signature->SimulatorHandledData.ProducedVars)
     {
-      createVariable(SHData.ProducedVars[i].Name,SHData.ProducedVars[i].DataType,SHData.ProducedVars[i].UnitsClass,
-                     false,CurrentSimulator->Container.signature()->ID);
+      m_DataSchema.declareProducedVariable(Var.Name,Var.DataType,Var.UnitsClass,Signature->ID);
     }
 
-    // checking variables to update
-    for (i=0;i<SHData.UpdatedVars.size();i++)
+    for (const auto& Var : Signature->SimulatorHandledData.UpdatedVars)
     {
-      createVariable(SHData.UpdatedVars[i].Name,SHData.UpdatedVars[i].DataType,SHData.UpdatedVars[i].UnitsClass,
-                     true,CurrentSimulator->Container.signature()->ID);
+      m_DataSchema.declareUpdatedVariable(Var.Name,Var.DataType,Var.UnitsClass,Signature->ID);
     }
-    ++SimIter;
   }
 
+  m_DataSchema.applyVariables(m_SimulationBlob.runConfiguration().getVariablesStorage());
 
-  SimIter = m_ModelInstance.items().begin();
 
-  while (SimIter != m_ModelInstance.items().end())
+  for (const ModelItemInstance* CurrentSimulator : m_ModelInstance.items())
   {
-    CurrentSimulator = (*SimIter);
-    HData = CurrentSimulator->Container.signature()->HandledData;
+    const auto& Signature = CurrentSimulator->Container.signature();
 
-    // checking required variables
-    for (i=0;i< HData.RequiredVars.size();i++)
+    for (const auto& Var : Signature->HandledData.RequiredVars)
     {
-      checkExistingVariable(HData.RequiredVars[i].Name,HData.RequiredVars[i].DataType,
-                            HData.RequiredVars[i].UnitsClass,CurrentSimulator->Container.signature()->ID);
+      m_DataSchema.checkRequiredVariable(Var.Name,Var.DataType,Var.UnitsClass,Signature->ID);
     }
-
-    ++SimIter;
   }
 
   // Cheching in observers
@@ -424,11 +307,9 @@ void Engine::checkModelConsistency()
   {
     for (const auto& Var : IInstance->Container.signature()->HandledData.RequiredVars)
     {
-      checkExistingVariable(Var.Name,Var.DataType,
-                            Var.UnitsClass,IInstance->Container.signature()->ID);
+      m_DataSchema.checkRequiredVariable(Var.Name,Var.DataType,Var.UnitsClass,IInstance->Container.signature()->ID);
     }
   }
-
 }
 
 
@@ -438,49 +319,31 @@ void Engine::checkModelConsistency()
 
 void Engine::checkAttributesConsistency()
 {
-  std::list<ModelItemInstance*>::const_iterator SimIter;
-  openfluid::ware::SignatureHandledData HData;
-  openfluid::ware::SimulatorSignatureHandledData SHData;
-  ModelItemInstance* CurrentSimulator;
-  unsigned int i;
-
-
-  SimIter = m_ModelInstance.items().begin();
-
-  while (SimIter != m_ModelInstance.items().end())
+  for (const ModelItemInstance* CurrentSimulator : m_ModelInstance.items())
   {
-    CurrentSimulator = (*SimIter);
-    HData = CurrentSimulator->Container.signature()->HandledData;
+    const auto& Signature = CurrentSimulator->Container.signature();
 
-    // checking required attribute
-    for(i=0; i < HData.RequiredAttribute.size();i++)
+    for (const auto& Attribute : Signature->HandledData.RequiredAttribute)
     {
-      checkExistingAttribute(HData.RequiredAttribute[i].Name,HData.RequiredAttribute[i].UnitsClass,
-                             CurrentSimulator->Container.signature()->ID);
+      m_DataSchema.declareRequiredAttribute(Attribute.Name,Attribute.UnitsClass,Signature->ID);
     }
 
-    // checking produced attribute
-    SHData = CurrentSimulator->Container.signature()->SimulatorHandledData;
-    for(i=0; i < SHData.ProducedAttribute.size();i++)
+    for (const auto& Attribute : Signature->SimulatorHandledData.ProducedAttribute)
     {
-      createAttribute(SHData.ProducedAttribute[i].Name,SHData.ProducedAttribute[i].UnitsClass,
-                      CurrentSimulator->Container.signature()->ID);
+      m_DataSchema.declareProducedAttribute(Attribute.Name,Attribute.UnitsClass,Signature->ID);
     }
-
-    ++SimIter;
   }
-  
 
   // Cheching in observers
   for (ObserverInstance* IInstance : m_MonitoringInstance.observers())
   {
     for (const auto& Attribute : IInstance->Container.signature()->HandledData.RequiredAttribute)
     {
-      checkExistingAttribute(Attribute.Name,Attribute.UnitsClass,
-                             IInstance->Container.signature()->ID);
+      m_DataSchema.declareRequiredAttribute(Attribute.Name,Attribute.UnitsClass,IInstance->Container.signature()->ID);
     }
   }
 
+  m_DataSchema.applyAttributes();
 }
 
 
@@ -713,6 +576,19 @@ void Engine::run()
   // Check for simulation vars production before init
   checkSimulationVarsProduction(0);
 
+  if (mp_HaloExchange)
+  {
+    if (!m_RestartCheckpoint.empty())
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "Restarting from a checkpoint is not available "
+                                                "on a partitioned spatial domain");
+    }
+
+    mp_HaloExchange->open();
+  }
+
+
   // ============= initializeRun() =============
 
 
@@ -723,6 +599,11 @@ void Engine::run()
     mp_SimStatus->setCurrentStage(openfluid::base::SimulationStatus::INITIALIZERUN);
     m_ModelInstance.call_initializeRun();
     m_MonitoringInstance.call_onInitializedRun();
+
+    if (mp_HaloExchange)
+    {
+      mp_HaloExchange->exportValues(mp_SimStatus->getCurrentTimeIndex());
+    }
   }
   catch (openfluid::base::FrameworkException& E)
   {
@@ -752,6 +633,20 @@ void Engine::run()
 
   mp_SimStatus->setCurrentStage(openfluid::base::SimulationStatus::RUNSTEP);
 
+  // restore the state of the simulation when restarting from a checkpoint
+  if (!m_RestartCheckpoint.empty())
+  {
+    std::istringstream RestartStm(m_RestartCheckpoint);
+    SimulationCheckpoint::read(RestartStm,m_SimulationBlob,m_ModelInstance);
+    m_RestartCheckpoint.clear();
+
+    m_LastCheckpointIndex = mp_SimStatus->getCurrentTimeIndex();
+
+    mp_SimLogger->addInfo(openfluid::base::FrameworkException::computeContext().toString(),
+                          "Simulation restarted from checkpoint at time index " +
+                          std::to_string(m_LastCheckpointIndex));
+  }
+
   // run the simulation while there is at least one execution time point to process
   while (m_ModelInstance.hasTimePointToProcess())
   {
@@ -760,11 +655,28 @@ void Engine::run()
 
     try
     {
+      // values of halo units are updated before processing the time point, and exported once it is processed
+      if (mp_HaloExchange)
+      {
+        mp_HaloExchange->importValues(m_ModelInstance.getNextTimePointIndex());
+      }
+
       // process the execution time point
       m_ModelInstance.processNextTimePoint();
+
+      if (mp_HaloExchange)
+      {
+        mp_HaloExchange->exportValues(mp_SimStatus->getCurrentTimeIndex());
+      }
       
       // call the monitoring once the execution time point is processed
       m_MonitoringInstance.call_onStepCompleted(mp_SimStatus->getCurrentTimeIndex());
+
+      if (m_CheckpointPeriod && m_ModelInstance.hasTimePointToProcess() &&
+          mp_SimStatus->getCurrentTimeIndex() >= m_LastCheckpointIndex+m_CheckpointPeriod)
+      {
+        writeCheckpoint();
+      }
     }
     catch (openfluid::base::FrameworkException& E)
     {
@@ -773,6 +685,13 @@ void Engine::run()
     }
   }
 
+  waitForCheckpointWriting();
+
+  if (mp_HaloExchange)
+  {
+    mp_HaloExchange->close();
+  }
+
   mp_MachineListener->onAfterRunSteps();
 
   mp_SimLogger->resetCurrentWarningFlag();
@@ -794,6 +713,8 @@ void Engine::run()
     throw;
   }
 
+  reportVariablesStorage();
+
 
   if (mp_SimLogger->isCurrentWarningFlag())
   {
@@ -814,11 +735,86 @@ void Engine::run()
 // =====================================================================
 
 
+void Engine::writeCheckpoint()
+{
+  std::ostringstream CheckpointStm;
+  SimulationCheckpoint::write(CheckpointStm,m_SimulationBlob,m_ModelInstance);
+
+  waitForCheckpointWriting();
+
+  // the file is replaced only once completely written, so that a valid checkpoint is always available
+  m_CheckpointWriting =
+    std::async(std::launch::async,
+               [Path = openfluid::base::RunContextManager::instance()->getOutputFullPath(
+                         openfluid::config::CHECKPOINT_FILE),
+                Data = CheckpointStm.str()]()
+               {
+                 const std::string TmpPath = Path+".tmp";
+
+                 {
+                   std::ofstream CheckpointFile(TmpPath,std::ios::binary | std::ios::trunc);
+                   CheckpointFile.write(Data.data(),Data.size());
+
+                   if (!CheckpointFile)
+                   {
+                     throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                               "Unable to write checkpoint file " + TmpPath);
+                   }
+                 }
+
+                 if (std::rename(TmpPath.c_str(),Path.c_str()) != 0)
+                 {
+                   throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                             "Unable to write checkpoint file " + Path);
+                 }
+               });
+
+  m_LastCheckpointIndex = mp_SimStatus->getCurrentTimeIndex();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void Engine::waitForCheckpointWriting()
+{
+  if (m_CheckpointWriting.valid())
+  {
+    m_CheckpointWriting.get();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void Engine::finalize()
 {
   m_ModelInstance.finalize();
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+ResultsStore& Engine::resultsStore()
+{
+  return m_MonitoringInstance.resultsStore();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const ResultsStore& Engine::resultsStore() const
+{
+  return m_MonitoringInstance.resultsStore();
+}
+
+
 } } //namespaces
 
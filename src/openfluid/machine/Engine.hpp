@@ -42,11 +42,14 @@
 
 
 #include <memory>
+#include <future>
+#include <string>
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/core/DateTime.hpp>
 #include <openfluid/core/TypeDefs.hpp>
 #include <openfluid/base/SimulationLogger.hpp>
+#include <openfluid/machine/SpatialDataSchema.hpp>
 
 
 namespace openfluid {
@@ -62,9 +65,11 @@ class DateTime;
 
 namespace openfluid { namespace machine {
 
+class HaloExchange;
 class ModelInstance;
 class MonitoringInstance;
 class MachineListener;
+class ResultsStore;
 class SimulationBlob;
 
 
@@ -92,6 +97,24 @@ class OPENFLUID_API Engine
 
      std::unique_ptr<openfluid::base::SimulationLogger> mp_SimLogger;
 
+     /**
+       Contents of the checkpoint to restart the simulation from, empty if the simulation starts from its beginning
+     */
+     std::string m_RestartCheckpoint;
+
+     openfluid::core::Duration_t m_CheckpointPeriod;
+
+     openfluid::core::TimeIndex_t m_LastCheckpointIndex;
+
+     std::future<void> m_CheckpointWriting;
+
+     HaloExchange* mp_HaloExchange;
+
+     /**
+       Schema of the spatial data handled by the wares, used to create and check them on all units
+     */
+     SpatialDataSchema m_DataSchema;
+
 
      void checkSimulationVarsProduction(int ExpectedVarsCount);
 
@@ -103,26 +126,24 @@ class OPENFLUID_API Engine
 
      void checkExtraFilesConsistency();
 
-     void checkExistingVariable(const openfluid::core::VariableName_t& VarName,
-                                const openfluid::core::Value::Type& VarType,
-                                const openfluid::core::UnitsClass_t& ClassName,
-                                const std::string& SimulatorID);
-
-     void createVariable(const openfluid::core::VariableName_t& VarName,
-                         const openfluid::core::Value::Type& VarType,
-                         const openfluid::core::UnitsClass_t& ClassName,
-                         bool UpdateMode,
-                         const std::string& SimulatorID);
+     void prepareOutputDir();
 
-     void checkExistingAttribute(const openfluid::core::AttributeName_t AttrName,
-                                 const openfluid::core::UnitsClass_t ClassName,
-                                 const std::string& SimulatorID);
+     /**
+       Reports in the simulation log the maximum storage error of the variables stored with a reduced precision
+     */
+     void reportVariablesStorage();
 
-     void createAttribute(const openfluid::core::AttributeName_t AttrName,
-                          const openfluid::core::UnitsClass_t ClassName,
-                          const std::string& SimulatorID);
+     /**
+       Writes a checkpoint of the running simulation. The state of the simulation is captured
+       before returning, the checkpoint file is written in background while the simulation goes on
+     */
+     void writeCheckpoint();
 
-     void prepareOutputDir();
+     /**
+       Waits for the end of the background writing of the latest checkpoint
+       @throw openfluid::base::FrameworkException if the checkpoint file could not be written
+     */
+     void waitForCheckpointWriting();
 
 
   public:
@@ -139,8 +160,7 @@ class OPENFLUID_API Engine
     /**
       Destructor
     */
-    ~Engine()
-    { }
+    ~Engine();
 
     static std::size_t computeValuesBuffersDefaultSize(const openfluid::core::Duration_t Duration, 
                                                        const openfluid::core::Duration_t DeltaT)
@@ -198,6 +218,24 @@ class OPENFLUID_API Engine
       return &m_ModelInstance;
     }
 
+    /**
+      Sets the exchange of values with the workers of the other parts of the spatial domain,
+      when the simulation runs on a part of a partitioned domain
+      @param[in] Exchange the halo exchange of the part, nullptr if the domain is not partitioned
+    */
+    void setHaloExchange(HaloExchange* Exchange)
+    {
+      mp_HaloExchange = Exchange;
+    }
+
+    /**
+      Returns the in-memory results store of the simulation, filled during the run with the values
+      of the variables added to the store before the initialization of the engine
+    */
+    ResultsStore& resultsStore();
+
+    const ResultsStore& resultsStore() const;
+
     unsigned int getWarningsCount() const
     {
       return mp_SimLogger->getWarningsCount();
@@ -113,6 +113,15 @@ class OPENFLUID_API ExecutionTimePoint
       return m_ItemsPtrList.front();
     }
 
+    /**
+      Returns the model items remaining to process in the execution time point
+      @return the list of pointers to the model items
+    */
+    inline const std::list<ModelItemInstance*>& items() const
+    {
+      return m_ItemsPtrList;
+    }
+
     /**
       Returns the time index of the execution time point
       @return the time index
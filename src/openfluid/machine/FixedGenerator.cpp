@@ -38,14 +38,20 @@
  */
 
 
+#include <map>
+
 #include <openfluid/machine/FixedGenerator.hpp>
 #include <openfluid/tools/StringHelpers.hpp>
+#include <openfluid/core/DoubleValue.hpp>
+#include <openfluid/core/IntegerValue.hpp>
+#include <openfluid/core/BooleanValue.hpp>
+#include <openfluid/core/StringValue.hpp>
 
 
 namespace openfluid { namespace machine {
 
 template <class T>
-FixedGenerator<T>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
+FixedGenerator<T>::FixedGenerator() : MonoGenerator(), m_DeltaT(0), m_Constant(false)
 {
   m_VarValue = (T)0;
 }
@@ -56,7 +62,7 @@ FixedGenerator<T>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
 
 
 template <>
-FixedGenerator<double>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
+FixedGenerator<double>::FixedGenerator() : MonoGenerator(), m_DeltaT(0), m_Constant(false)
 {
   m_VarValue = 0;
 }
@@ -67,7 +73,7 @@ FixedGenerator<double>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
 
 
 template <>
-FixedGenerator<long int>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
+FixedGenerator<long int>::FixedGenerator() : MonoGenerator(), m_DeltaT(0), m_Constant(false)
 {
   m_VarValue = 0;
 }
@@ -78,7 +84,7 @@ FixedGenerator<long int>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
 
 
 template <>
-FixedGenerator<bool>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
+FixedGenerator<bool>::FixedGenerator() : MonoGenerator(), m_DeltaT(0), m_Constant(false)
 {
   m_VarValue = false;
 }
@@ -89,7 +95,7 @@ FixedGenerator<bool>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
 
 
 template <>
-FixedGenerator<std::string>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
+FixedGenerator<std::string>::FixedGenerator() : MonoGenerator(), m_DeltaT(0), m_Constant(false)
 {
   m_VarValue = "";
 }
@@ -100,7 +106,7 @@ FixedGenerator<std::string>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
 
 
 template <>
-FixedGenerator<openfluid::core::VectorValue>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
+FixedGenerator<openfluid::core::VectorValue>::FixedGenerator() : MonoGenerator(), m_DeltaT(0), m_Constant(false)
 {
   m_VarValue = openfluid::core::VectorValue(1);
 }
@@ -111,7 +117,7 @@ FixedGenerator<openfluid::core::VectorValue>::FixedGenerator() : MonoGenerator()
 
 
 template <>
-FixedGenerator<openfluid::core::MatrixValue>::FixedGenerator() : MonoGenerator(), m_DeltaT(0)
+FixedGenerator<openfluid::core::MatrixValue>::FixedGenerator() : MonoGenerator(), m_DeltaT(0), m_Constant(false)
 {
   m_VarValue = openfluid::core::MatrixValue();
 }
@@ -234,6 +240,99 @@ void FixedGenerator<T>::initParams(const openfluid::ware::WareParams_t& Params)
   {
     throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"wrong value for deltat");
   }
+
+  std::string ConstantStr;
+  if (OPENFLUID_GetWareParameter(Params,"constant",ConstantStr))
+  {
+    if (ConstantStr == "1" || ConstantStr == "true")
+    {
+      m_Constant = true;
+    }
+    else if (ConstantStr == "0" || ConstantStr == "false")
+    {
+      m_Constant = false;
+    }
+    else
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"wrong value for constant");
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <>
+std::unique_ptr<openfluid::core::Value> FixedGenerator<double>::makeValue(bool init) const
+{
+  return std::make_unique<openfluid::core::DoubleValue>(init ? 0.0 : m_VarValue);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <>
+std::unique_ptr<openfluid::core::Value> FixedGenerator<long int>::makeValue(bool init) const
+{
+  return std::make_unique<openfluid::core::IntegerValue>(init ? 0 : m_VarValue);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <>
+std::unique_ptr<openfluid::core::Value> FixedGenerator<bool>::makeValue(bool init) const
+{
+  return std::make_unique<openfluid::core::BooleanValue>(init ? false : m_VarValue);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <>
+std::unique_ptr<openfluid::core::Value> FixedGenerator<std::string>::makeValue(bool init) const
+{
+  return std::make_unique<openfluid::core::StringValue>(init ? std::string() : m_VarValue);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <>
+std::unique_ptr<openfluid::core::Value> FixedGenerator<openfluid::core::VectorValue>::makeValue(bool init) const
+{
+  if (init)
+  {
+    return std::make_unique<openfluid::core::VectorValue>(m_VarDimensions.Rows,0.0);
+  }
+
+  return std::make_unique<openfluid::core::VectorValue>(m_VarValue);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <>
+std::unique_ptr<openfluid::core::Value> FixedGenerator<openfluid::core::MatrixValue>::makeValue(bool init) const
+{
+  if (init)
+  {
+    return std::make_unique<openfluid::core::MatrixValue>(m_VarDimensions.Cols,m_VarDimensions.Rows,0.0);
+  }
+
+  return std::make_unique<openfluid::core::MatrixValue>(m_VarValue);
 }
 
 
@@ -320,9 +419,28 @@ template <class T>
 openfluid::base::SchedulingRequest FixedGenerator<T>::initializeRun()
 {
   openfluid::core::SpatialUnit* LU;
-  OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
+
+  if (m_Constant)
+  {
+    // values are stored once and shared by the variables of all units
+    mp_SharedValues = std::make_unique<openfluid::core::ValuesBuffer>();
+    mp_SharedValues->appendValue(OPENFLUID_GetCurrentTimeIndex(),makeValue(true));
+
+    OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
+    {
+      if (!LU->variables()->shareVariable(m_VarName,*mp_SharedValues))
+      {
+        throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                  "cannot share values of constant variable " + m_VarName);
+      }
+    }
+  }
+  else
   {
-    applyValue(LU, true);
+    OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
+    {
+      applyValue(LU, true);
+    }
   }
 
   if (m_DeltaT > 0)
@@ -343,12 +461,18 @@ openfluid::base::SchedulingRequest FixedGenerator<T>::initializeRun()
 template <class T>
 openfluid::base::SchedulingRequest FixedGenerator<T>::runStep()
 {
-
-  openfluid::core::SpatialUnit* LU;
-
-  OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
+  if (m_Constant)
+  {
+    mp_SharedValues->appendValue(OPENFLUID_GetCurrentTimeIndex(),makeValue(false));
+  }
+  else
   {
-    applyValue(LU);
+    openfluid::core::SpatialUnit* LU;
+
+    OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
+    {
+      applyValue(LU);
+    }
   }
 
   if (m_DeltaT > 0)
@@ -362,5 +486,82 @@ openfluid::base::SchedulingRequest FixedGenerator<T>::runStep()
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void FixedGenerator<T>::saveState(openfluid::core::MapValue& State) const
+{
+  if (m_Constant && mp_SharedValues)
+  {
+    openfluid::core::IndexedValuesView View;
+    mp_SharedValues->getLatestIndexedValuesView(0,View);
+
+    // values are keyed by their time index
+    openfluid::core::MapValue Values;
+    for (const auto& IndValue : View)
+    {
+      Values.set(std::to_string(IndValue.getIndex()),IndValue.value()->clone());
+    }
+
+    State.setMapValue("shared.values",Values);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void FixedGenerator<T>::restoreState(const openfluid::core::MapValue& State)
+{
+  if (!m_Constant || !State.isKeyExist("shared.values"))
+  {
+    return;
+  }
+
+  const openfluid::core::MapValue& Values = State.at("shared.values").asMapValue();
+  std::map<openfluid::core::TimeIndex_t,const openfluid::core::Value*> SortedValues;
+
+  for (const auto& Key : Values.getKeys())
+  {
+    openfluid::core::TimeIndex_t Index;
+
+    if (!openfluid::tools::toNumeric(Key,Index))
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "wrong time index " + Key + " in state of constant variable " +
+                                                m_VarName);
+    }
+
+    SortedValues[Index] = &Values.at(Key);
+  }
+
+  mp_SharedValues = std::make_unique<openfluid::core::ValuesBuffer>();
+  for (const auto& IndexValue : SortedValues)
+  {
+    mp_SharedValues->appendValue(IndexValue.first,*IndexValue.second);
+  }
+
+  openfluid::core::SpatialUnit* LU;
+
+  OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
+  {
+    if (!LU->variables()->isVariableExist(m_VarName))
+    {
+      LU->variables()->createVariable(m_VarName,makeValue(true)->getType());
+    }
+
+    if (!LU->variables()->shareVariable(m_VarName,*mp_SharedValues))
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "cannot share values of constant variable " + m_VarName);
+    }
+  }
+}
+
+
 } } //namespaces
 
@@ -42,8 +42,11 @@
 #define __OPENFLUID_MACHINE_FIXEDGENERATOR_HPP__
 
 
+#include <memory>
+
 #include <openfluid/dllexport.hpp>
 #include <openfluid/machine/Generator.hpp>
+#include <openfluid/core/ValuesBuffer.hpp>
 
 
 namespace openfluid { namespace machine {
@@ -58,8 +61,20 @@ class OPENFLUID_API FixedGenerator : public MonoGenerator
 
     openfluid::core::Duration_t m_DeltaT;
 
+    /**
+      True if the generated variable is constant, its values being stored once and shared by all units
+    */
+    bool m_Constant;
+
+    std::unique_ptr<openfluid::core::ValuesBuffer> mp_SharedValues;
+
     void processVarValue(const openfluid::ware::WareParams_t& Params);
 
+    /**
+      Builds the value to store, either the initial value or the fixed value
+    */
+    std::unique_ptr<openfluid::core::Value> makeValue(bool init) const;
+
     void applyValue(openfluid::core::SpatialUnit* LU, bool init=false)
     {
         if (init)
@@ -91,6 +106,17 @@ class OPENFLUID_API FixedGenerator : public MonoGenerator
     void finalizeRun()
     { }
 
+    /**
+      Saves the shared values of a constant variable, which are not stored by the variables of spatial units
+    */
+    void saveState(openfluid::core::MapValue& State) const;
+
+    /**
+      Restores the shared values of a constant variable and shares them again with all spatial units,
+      including the units added when restoring the spatial domain
+    */
+    void restoreState(const openfluid::core::MapValue& State);
+
 };
 
 
@@ -108,6 +108,10 @@ void GeneratorSignature::setFixedInfo()
 
   HandledData.UsedParams.push_back(
       openfluid::ware::SignatureDataItem("deltat","DeltaT to use instead of the default DeltaT","s"));
+  HandledData.UsedParams.push_back(
+      openfluid::ware::SignatureDataItem("constant",
+                                         "If true, values are stored once and shared by all units (read-only)",
+                                         "-"));
 }
 
 
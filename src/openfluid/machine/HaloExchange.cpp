@@ -0,0 +1,858 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file HaloExchange.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include <openfluid/global.hpp>
+
+#if defined(OPENFLUID_OS_UNIX)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined(OPENFLUID_OS_LINUX)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <openfluid/machine/HaloExchange.hpp>
+#include <openfluid/machine/DomainPartitioner.hpp>
+#include <openfluid/machine/SimulationBlob.hpp>
+#include <openfluid/core/DoubleValue.hpp>
+#include <openfluid/core/IntegerValue.hpp>
+#include <openfluid/core/BooleanValue.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/tools/IDHelpers.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+namespace {
+
+
+enum PartStatus : std::uint32_t { STARTING = 0, OPENED = 1, CLOSED = 2, FAILED = 3 };
+
+
+/**
+  State of a worker in the shared control area
+*/
+struct PartState
+{
+  std::atomic<std::uint32_t> Status;
+
+  /**
+    Count of entries published by the worker since the beginning
+  */
+  std::atomic<std::uint64_t> Published;
+
+  /**
+    Time index the worker is about to process, all previous time points being published
+  */
+  std::atomic<std::uint64_t> NextIndex;
+
+  /**
+    Counter of changes of the state of the worker, including the consumption of the entries of its neighbours,
+    used by the other workers to sleep until the next change
+  */
+  std::atomic<std::uint32_t> Sequence;
+};
+
+
+/**
+  Header of the shared segment of values exported by a worker, followed by the ring of time indexes,
+  the directory of exported variables, the ring of values and the ring of presence flags
+*/
+struct SegmentHeader
+{
+  std::uint32_t Magic;
+
+  std::uint32_t Capacity;
+
+  std::uint64_t SlotsCount;
+
+  std::uint64_t DirectorySize;
+};
+
+
+constexpr std::uint32_t SegmentMagic = 0x4F464858;  // "OFHX"
+
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "lock-free 64 bits atomics are required for inter-process exchanges");
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+              "32 bits atomics must have the layout of 32 bits integers to be used as futexes");
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline std::size_t alignSize(std::size_t Size)
+{
+  return (Size+7) & ~std::size_t(7);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline unsigned int getPartsCount(void* Control)
+{
+  return *static_cast<std::uint32_t*>(Control);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline PartState* partState(void* Control, unsigned int Part)
+{
+  return reinterpret_cast<PartState*>(static_cast<char*>(Control)+alignof(PartState))+Part;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+inline std::atomic<std::uint64_t>* consumedCounter(void* Control, unsigned int Producer, unsigned int Consumer)
+{
+  const unsigned int PartsCount = getPartsCount(Control);
+
+  return reinterpret_cast<std::atomic<std::uint64_t>*>(partState(Control,PartsCount)) +
+         (Producer*PartsCount+Consumer);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void throwFailedPart(unsigned int Part)
+{
+  throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                            "worker of domain part " + std::to_string(Part) + " failed");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Signals a change of the state of a worker to the workers waiting for it
+*/
+void notifyChange(PartState* State)
+{
+  State->Sequence.fetch_add(1);
+
+#if defined(OPENFLUID_OS_LINUX)
+  syscall(SYS_futex,reinterpret_cast<std::uint32_t*>(&State->Sequence),FUTEX_WAKE,INT_MAX,nullptr,nullptr,0);
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Waits while the given condition is false, sleeping until the state of the given worker changes.
+  On systems without futexes, the condition is checked periodically.
+*/
+template<typename Condition>
+void waitUntil(PartState* State, const Condition& Cond)
+{
+  while (true)
+  {
+    // the sequence is read before checking the condition, so a change made in between is not missed
+    const std::uint32_t Sequence = State->Sequence.load();
+
+    if (Cond())
+    {
+      return;
+    }
+
+#if defined(OPENFLUID_OS_LINUX)
+    // returns immediately if the sequence already changed, spurious wake-ups are handled by the loop
+    syscall(SYS_futex,reinterpret_cast<std::uint32_t*>(&State->Sequence),FUTEX_WAIT,Sequence,nullptr,nullptr,0);
+#else
+    (void)Sequence;
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool isExchangedType(openfluid::core::Value::Type VarType)
+{
+  return (VarType == openfluid::core::Value::DOUBLE || VarType == openfluid::core::Value::INTEGER ||
+          VarType == openfluid::core::Value::BOOLEAN || VarType == openfluid::core::Value::NONE);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void* mapSegment(const std::string& Name, std::size_t& Size, bool Create)
+{
+#if defined(OPENFLUID_OS_UNIX)
+  const int FD = Create ? shm_open(Name.c_str(),O_CREAT | O_EXCL | O_RDWR,S_IRUSR | S_IWUSR) :
+                          shm_open(Name.c_str(),O_RDONLY,0);
+
+  if (FD < 0)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "unable to open shared memory segment " + Name);
+  }
+
+  struct stat SegStat;
+  if ((Create && ftruncate(FD,Size) != 0) || (!Create && fstat(FD,&SegStat) != 0))
+  {
+    ::close(FD);
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "unable to size shared memory segment " + Name);
+  }
+
+  if (!Create)
+  {
+    Size = SegStat.st_size;
+  }
+
+  void* Address = mmap(nullptr,Size,Create ? (PROT_READ | PROT_WRITE) : PROT_READ,MAP_SHARED,FD,0);
+  ::close(FD);
+
+  if (Address == MAP_FAILED)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "unable to map shared memory segment " + Name);
+  }
+
+  return Address;
+#else
+  (void)Name;
+  (void)Size;
+  (void)Create;
+
+  throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                            "shared memory exchanges are not available on this system");
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void unmapSegment(void* Address, std::size_t Size)
+{
+#if defined(OPENFLUID_OS_UNIX)
+  munmap(Address,Size);
+#else
+  (void)Address;
+  (void)Size;
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void setHaloValue(openfluid::core::SpatialUnit* Unit, const openfluid::core::VariableName_t& VarName,
+                  openfluid::core::Value::Type VarType, openfluid::core::TimeIndex_t Index, double Val)
+{
+  std::unique_ptr<openfluid::core::Value> HaloVal;
+
+  if (VarType == openfluid::core::Value::INTEGER)
+  {
+    HaloVal = std::make_unique<openfluid::core::IntegerValue>(static_cast<long>(Val));
+  }
+  else if (VarType == openfluid::core::Value::BOOLEAN)
+  {
+    HaloVal = std::make_unique<openfluid::core::BooleanValue>(Val != 0.0);
+  }
+  else
+  {
+    HaloVal = std::make_unique<openfluid::core::DoubleValue>(Val);
+  }
+
+  if (Unit->variables()->isVariableExist(VarName,Index))
+  {
+    Unit->variables()->modifyValue(VarName,Index,std::move(HaloVal));
+  }
+  else
+  {
+    Unit->variables()->appendValue(VarName,Index,std::move(HaloVal));
+  }
+}
+
+
+}  // namespace
+
+
+// =====================================================================
+// =====================================================================
+
+
+HaloExchange::HaloExchange(const DomainPartition& Partition, unsigned int Part, void* Control,
+                           const std::string& SegmentsPrefix, unsigned int Capacity) :
+  m_Partition(Partition), m_Part(Part), mp_Control(Control), m_SegmentsPrefix(SegmentsPrefix),
+  m_Capacity(Capacity)
+{
+  std::set<unsigned int> Neighbours(Partition.upstreamParts(Part));
+  Neighbours.insert(Partition.downstreamParts(Part).begin(),Partition.downstreamParts(Part).end());
+
+  m_Neighbours.assign(Neighbours.begin(),Neighbours.end());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+HaloExchange::~HaloExchange()
+{
+  if (m_IsOpened)
+  {
+    setFailed(mp_Control,m_Part);
+  }
+
+  closeSegments();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::size_t HaloExchange::getControlSize(unsigned int PartsCount)
+{
+  return alignof(PartState) + PartsCount*sizeof(PartState) + PartsCount*PartsCount*sizeof(std::atomic<std::uint64_t>);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::initializeControl(void* Control, unsigned int PartsCount)
+{
+  *static_cast<std::uint32_t*>(Control) = PartsCount;
+
+  for (unsigned int p = 0; p < PartsCount; p++)
+  {
+    PartState* State = new (partState(Control,p)) PartState();
+    State->Status = STARTING;
+    State->Published = 0;
+    State->NextIndex = 0;
+    State->Sequence = 0;
+
+    for (unsigned int c = 0; c < PartsCount; c++)
+    {
+      new (consumedCounter(Control,p,c)) std::atomic<std::uint64_t>(0);
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::setFailed(void* Control, unsigned int Part)
+{
+  partState(Control,Part)->Status.store(FAILED,std::memory_order_release);
+  notifyChange(partState(Control,Part));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::string HaloExchange::getSegmentName(const std::string& SegmentsPrefix, unsigned int Part)
+{
+  return SegmentsPrefix + "-" + std::to_string(Part);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::closeSegments()
+{
+  if (m_ExportSegment.Address)
+  {
+    unmapSegment(m_ExportSegment.Address,m_ExportSegment.Size);
+    m_ExportSegment.Address = nullptr;
+  }
+
+  for (auto& Seg : m_ImportSegments)
+  {
+    unmapSegment(Seg.second.Address,Seg.second.Size);
+  }
+  m_ImportSegments.clear();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::attach(SimulationBlob& SimBlob, const openfluid::fluidx::SpatialDomainDescriptor& Domain)
+{
+  mp_SimBlob = &SimBlob;
+
+  for (const auto& Halo : m_Partition.haloUnits(m_Part))
+  {
+    const auto& UnitDesc = Domain.spatialUnit(Halo.first,Halo.second);
+
+    m_HaloUnits.emplace_back(Halo.first,Halo.second,UnitDesc.getProcessOrder());
+    openfluid::core::SpatialUnit* HaloUnit = &m_HaloUnits.back();
+
+    for (const auto& Attribute : UnitDesc.attributes())
+    {
+      HaloUnit->attributes()->setValueFromRawString(Attribute.first,Attribute.second);
+    }
+
+    m_HaloUnitsByID[Halo] = HaloUnit;
+  }
+
+
+  // halo units are linked to the units of the part only, in both directions
+
+  for (const auto& Unit : m_Partition.units(m_Part))
+  {
+    openfluid::core::SpatialUnit* LocalUnit = SimBlob.spatialGraph().spatialUnit(Unit.first,Unit.second);
+
+    if (!LocalUnit)
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "unit " + openfluid::tools::classIDToString(Unit.first,Unit.second) +
+                                                " of domain part " + std::to_string(m_Part) +
+                                                " does not exist in the simulation blob");
+    }
+
+    for (const auto& ToUnit : Domain.spatialUnit(Unit.first,Unit.second).toSpatialUnits())
+    {
+      openfluid::core::SpatialUnit* HaloUnit = haloUnit(ToUnit.first,ToUnit.second);
+
+      if (HaloUnit)
+      {
+        LocalUnit->addToUnit(HaloUnit);
+        HaloUnit->addFromUnit(LocalUnit);
+      }
+    }
+  }
+
+  for (auto& HaloUnit : m_HaloUnits)
+  {
+    for (const auto& ToUnit : Domain.spatialUnit(HaloUnit.getClass(),HaloUnit.getID()).toSpatialUnits())
+    {
+      if (m_Partition.getPart(ToUnit) == m_Part)
+      {
+        openfluid::core::SpatialUnit* LocalUnit = SimBlob.spatialGraph().spatialUnit(ToUnit.first,ToUnit.second);
+
+        HaloUnit.addToUnit(LocalUnit);
+        LocalUnit->addFromUnit(&HaloUnit);
+      }
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::core::SpatialUnit* HaloExchange::haloUnit(const openfluid::core::UnitsClass_t& UnitsClass,
+                                                     openfluid::core::UnitID_t ID)
+{
+  auto it = m_HaloUnitsByID.find({UnitsClass,ID});
+
+  if (it == m_HaloUnitsByID.end())
+  {
+    return nullptr;
+  }
+
+  return it->second;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::importSegment(unsigned int Part)
+{
+  Segment& Seg = m_ImportSegments[Part];
+
+  Seg.Name = getSegmentName(m_SegmentsPrefix,Part);
+  Seg.Address = mapSegment(Seg.Name,Seg.Size,false);
+
+  const SegmentHeader* Header = static_cast<const SegmentHeader*>(Seg.Address);
+
+  if (Seg.Size < sizeof(SegmentHeader) || Header->Magic != SegmentMagic)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "wrong shared memory segment " + Seg.Name);
+  }
+
+  char* Data = static_cast<char*>(Seg.Address);
+  const std::size_t SlotsCount = Header->SlotsCount;
+
+  Seg.Capacity = Header->Capacity;
+  Seg.Indexes = reinterpret_cast<openfluid::core::TimeIndex_t*>(Data+alignSize(sizeof(SegmentHeader)));
+
+  const char* Directory = reinterpret_cast<char*>(Seg.Indexes+Seg.Capacity);
+  Seg.Values = reinterpret_cast<double*>(const_cast<char*>(Directory)+alignSize(Header->DirectorySize));
+  Seg.Present = reinterpret_cast<unsigned char*>(Seg.Values+SlotsCount*Seg.Capacity);
+
+
+  // the directory gives the unit and the variable of each slot, one per line
+
+  std::istringstream DirStm(std::string(Directory,Header->DirectorySize));
+  std::string Line;
+
+  while (std::getline(DirStm,Line))
+  {
+    std::istringstream LineStm(Line);
+    openfluid::core::UnitsClass_t UnitsClass;
+    openfluid::core::UnitID_t ID;
+    int VarType;
+    Slot S;
+
+    std::getline(LineStm,UnitsClass,'\t');
+    LineStm >> ID >> S.VarName >> VarType;
+
+    S.VarType = static_cast<openfluid::core::Value::Type>(VarType);
+    S.Unit = haloUnit(UnitsClass,ID);
+
+    if (S.Unit && !S.Unit->variables()->isVariableExist(S.VarName))
+    {
+      if (S.VarType == openfluid::core::Value::NONE)
+      {
+        S.Unit->variables()->createVariable(S.VarName);
+      }
+      else
+      {
+        S.Unit->variables()->createVariable(S.VarName,S.VarType);
+      }
+    }
+
+    Seg.Slots.push_back(S);
+  }
+
+  if (Seg.Slots.size() != SlotsCount)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "wrong directory in shared memory segment " + Seg.Name);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::open()
+{
+  if (!mp_SimBlob)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"halo exchange is not attached");
+  }
+
+
+  // slots of the exported variables
+
+  std::ostringstream DirStm;
+
+  for (const auto& Unit : m_Partition.exportedUnits(m_Part))
+  {
+    openfluid::core::SpatialUnit* LocalUnit = mp_SimBlob->spatialGraph().spatialUnit(Unit.first,Unit.second);
+
+    for (const auto& VarName : LocalUnit->variables()->getVariablesNames())
+    {
+      const openfluid::core::Value::Type VarType = LocalUnit->variables()->getVariableType(VarName);
+
+      if (isExchangedType(VarType))
+      {
+        m_ExportSegment.Slots.push_back({LocalUnit,VarName,VarType});
+        DirStm << Unit.first << "\t" << Unit.second << "\t" << VarName << "\t" << int(VarType) << "\n";
+      }
+    }
+  }
+
+  const std::string Directory = DirStm.str();
+  const std::size_t SlotsCount = m_ExportSegment.Slots.size();
+
+  m_ExportSegment.Name = getSegmentName(m_SegmentsPrefix,m_Part);
+  m_ExportSegment.Capacity = m_Capacity;
+  m_ExportSegment.Size = alignSize(sizeof(SegmentHeader)) + m_Capacity*sizeof(openfluid::core::TimeIndex_t) +
+                         alignSize(Directory.size()) + SlotsCount*m_Capacity*(sizeof(double)+1);
+  m_ExportSegment.Address = mapSegment(m_ExportSegment.Name,m_ExportSegment.Size,true);
+
+  char* Data = static_cast<char*>(m_ExportSegment.Address);
+
+  SegmentHeader* Header = reinterpret_cast<SegmentHeader*>(Data);
+  Header->Magic = SegmentMagic;
+  Header->Capacity = m_Capacity;
+  Header->SlotsCount = SlotsCount;
+  Header->DirectorySize = Directory.size();
+
+  m_ExportSegment.Indexes = reinterpret_cast<openfluid::core::TimeIndex_t*>(Data+alignSize(sizeof(SegmentHeader)));
+  char* DirData = reinterpret_cast<char*>(m_ExportSegment.Indexes+m_Capacity);
+  std::memcpy(DirData,Directory.data(),Directory.size());
+  m_ExportSegment.Values = reinterpret_cast<double*>(DirData+alignSize(Directory.size()));
+  m_ExportSegment.Present = reinterpret_cast<unsigned char*>(m_ExportSegment.Values+SlotsCount*m_Capacity);
+
+  partState(mp_Control,m_Part)->Status.store(OPENED,std::memory_order_release);
+  notifyChange(partState(mp_Control,m_Part));
+  m_IsOpened = true;
+
+
+  // variables of halo units are created from the directories of the neighbours
+
+  for (auto Part : m_Neighbours)
+  {
+    PartState* State = partState(mp_Control,Part);
+
+    waitUntil(State,[State]()
+    {
+      return State->Status.load(std::memory_order_acquire) != STARTING;
+    });
+
+    if (State->Status.load(std::memory_order_acquire) == FAILED)
+    {
+      throwFailedPart(Part);
+    }
+
+    importSegment(Part);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::waitFor(unsigned int Part, openfluid::core::TimeIndex_t Index)
+{
+  PartState* State = partState(mp_Control,Part);
+  const Segment& Seg = m_ImportSegments.at(Part);
+  bool Failed = false;
+
+  waitUntil(State,[State,&Seg,Index,&Failed]()
+  {
+    const std::uint32_t Status = State->Status.load(std::memory_order_acquire);
+
+    if (Status == FAILED)
+    {
+      Failed = true;
+      return true;
+    }
+
+    const std::uint64_t Published = State->Published.load(std::memory_order_acquire);
+
+    return (Status == CLOSED ||
+            (Published && Seg.Indexes[(Published-1) % Seg.Capacity] >= Index) ||
+            State->NextIndex.load(std::memory_order_acquire) > Index);
+  });
+
+  if (Failed)
+  {
+    throwFailedPart(Part);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::importValues(openfluid::core::TimeIndex_t Index)
+{
+  partState(mp_Control,m_Part)->NextIndex.store(Index,std::memory_order_release);
+  notifyChange(partState(mp_Control,m_Part));
+
+  const auto& UpstreamParts = m_Partition.upstreamParts(m_Part);
+
+  for (auto Part : m_Neighbours)
+  {
+    // upstream parts must have processed the time index, downstream parts the previous one
+
+    waitFor(Part,UpstreamParts.count(Part) ? Index : m_LastIndex);
+
+    const Segment& Seg = m_ImportSegments.at(Part);
+    std::atomic<std::uint64_t>* Consumed = consumedCounter(mp_Control,Part,m_Part);
+    const std::uint64_t Published = partState(mp_Control,Part)->Published.load(std::memory_order_acquire);
+
+    std::uint64_t Entry = Consumed->load(std::memory_order_relaxed);
+
+    while (Entry < Published && Seg.Indexes[Entry % Seg.Capacity] <= Index)
+    {
+      const std::size_t Pos = Entry % Seg.Capacity;
+      const openfluid::core::TimeIndex_t EntryIndex = Seg.Indexes[Pos];
+
+      for (std::size_t s = 0; s < Seg.Slots.size(); s++)
+      {
+        const std::size_t Offset = s*Seg.Capacity+Pos;
+
+        if (Seg.Slots[s].Unit && Seg.Present[Offset])
+        {
+          setHaloValue(Seg.Slots[s].Unit,Seg.Slots[s].VarName,Seg.Slots[s].VarType,EntryIndex,Seg.Values[Offset]);
+        }
+      }
+
+      Entry++;
+    }
+
+    Consumed->store(Entry,std::memory_order_release);
+
+    // the neighbour may wait for free entries in its ring
+    notifyChange(partState(mp_Control,m_Part));
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::exportValues(openfluid::core::TimeIndex_t Index)
+{
+  PartState* State = partState(mp_Control,m_Part);
+  const std::uint64_t Entry = State->Published.load(std::memory_order_relaxed);
+
+
+  // the oldest entry of the ring must have been consumed by all neighbours
+
+  for (auto Part : m_Neighbours)
+  {
+    PartState* NeighbourState = partState(mp_Control,Part);
+    std::atomic<std::uint64_t>* Consumed = consumedCounter(mp_Control,m_Part,Part);
+    const std::uint64_t Capacity = m_Capacity;
+    bool Failed = false;
+
+    waitUntil(NeighbourState,[NeighbourState,Consumed,Entry,Capacity,&Failed]()
+    {
+      const std::uint32_t Status = NeighbourState->Status.load(std::memory_order_acquire);
+      Failed = (Status == FAILED);
+
+      return (Failed || Status == CLOSED || Consumed->load(std::memory_order_acquire)+Capacity > Entry);
+    });
+
+    if (Failed)
+    {
+      throwFailedPart(Part);
+    }
+  }
+
+  const std::size_t Pos = Entry % m_Capacity;
+  m_ExportSegment.Indexes[Pos] = Index;
+
+  for (std::size_t s = 0; s < m_ExportSegment.Slots.size(); s++)
+  {
+    const Slot& S = m_ExportSegment.Slots[s];
+    const std::size_t Offset = s*m_Capacity+Pos;
+    const openfluid::core::Value* Val = S.Unit->variables()->value(S.VarName,Index);
+
+    m_ExportSegment.Present[Offset] = 1;
+
+    if (Val && Val->isDoubleValue())
+    {
+      m_ExportSegment.Values[Offset] = Val->asDoubleValue().get();
+    }
+    else if (Val && Val->isIntegerValue())
+    {
+      m_ExportSegment.Values[Offset] = Val->asIntegerValue().get();
+    }
+    else if (Val && Val->isBooleanValue())
+    {
+      m_ExportSegment.Values[Offset] = Val->asBooleanValue().get() ? 1.0 : 0.0;
+    }
+    else
+    {
+      m_ExportSegment.Present[Offset] = 0;
+    }
+  }
+
+  State->Published.store(Entry+1,std::memory_order_release);
+  notifyChange(State);
+  m_LastIndex = Index;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::close()
+{
+  if (m_IsOpened)
+  {
+    partState(mp_Control,m_Part)->Status.store(CLOSED,std::memory_order_release);
+    notifyChange(partState(mp_Control,m_Part));
+    m_IsOpened = false;
+  }
+}
+
+
+} }  // namespaces
@@ -0,0 +1,226 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file HaloExchange.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_MACHINE_HALOEXCHANGE_HPP__
+#define __OPENFLUID_MACHINE_HALOEXCHANGE_HPP__
+
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/TypeDefs.hpp>
+#include <openfluid/core/SpatialUnit.hpp>
+#include <openfluid/fluidx/SpatialDomainDescriptor.hpp>
+
+
+namespace openfluid { namespace machine {
+
+class DomainPartition;
+class SimulationBlob;
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Exchange of the variables values of the units at the boundaries of a part of a partitioned spatial domain,
+  between the worker processes of the parts, through shared memory.
+  Units of other parts linked to units of the part (halo units) are added to the simulation blob
+  of the worker as neighbours of the units of the part, but not as units of the spatial graph.
+  Their variables are filled with the values produced by the workers of their parts,
+  so simulators reading variables of neighbour units are not aware of the partitioning.
+
+  Values of upstream halo units are available at the current time point, values of downstream halo units
+  are available up to the previous time point. Only double, integer and boolean values are exchanged.
+*/
+class OPENFLUID_API HaloExchange
+{
+  friend class DomainDecomposition;
+
+  private:
+
+    struct Slot
+    {
+      openfluid::core::SpatialUnit* Unit;
+
+      openfluid::core::VariableName_t VarName;
+
+      openfluid::core::Value::Type VarType;
+    };
+
+    struct Segment
+    {
+      std::string Name;
+
+      void* Address = nullptr;
+
+      std::size_t Size = 0;
+
+      unsigned int Capacity = 0;
+
+      openfluid::core::TimeIndex_t* Indexes = nullptr;
+
+      double* Values = nullptr;
+
+      unsigned char* Present = nullptr;
+
+      std::vector<Slot> Slots;
+    };
+
+    const DomainPartition& m_Partition;
+
+    const unsigned int m_Part;
+
+    void* mp_Control;
+
+    const std::string m_SegmentsPrefix;
+
+    const unsigned int m_Capacity;
+
+    std::vector<unsigned int> m_Neighbours;
+
+    std::list<openfluid::core::SpatialUnit> m_HaloUnits;
+
+    std::map<openfluid::core::UnitClassID_t,openfluid::core::SpatialUnit*> m_HaloUnitsByID;
+
+    SimulationBlob* mp_SimBlob = nullptr;
+
+    Segment m_ExportSegment;
+
+    std::map<unsigned int,Segment> m_ImportSegments;
+
+    openfluid::core::TimeIndex_t m_LastIndex = 0;
+
+    bool m_IsOpened = false;
+
+
+    HaloExchange(const DomainPartition& Partition, unsigned int Part, void* Control,
+                 const std::string& SegmentsPrefix, unsigned int Capacity);
+
+    static std::size_t getControlSize(unsigned int PartsCount);
+
+    static void initializeControl(void* Control, unsigned int PartsCount);
+
+    static void setFailed(void* Control, unsigned int Part);
+
+    static std::string getSegmentName(const std::string& SegmentsPrefix, unsigned int Part);
+
+    void waitFor(unsigned int Part, openfluid::core::TimeIndex_t Index);
+
+    void importSegment(unsigned int Part);
+
+    void closeSegments();
+
+
+  public:
+
+    HaloExchange() = delete;
+
+    HaloExchange(const HaloExchange&) = delete;
+
+    HaloExchange& operator=(const HaloExchange&) = delete;
+
+    /**
+      Destructor. The worker is considered as failed if the exchange was opened but not closed
+    */
+    ~HaloExchange();
+
+    inline unsigned int getPart() const
+    {
+      return m_Part;
+    }
+
+    const DomainPartition& partition() const
+    {
+      return m_Partition;
+    }
+
+    /**
+      Adds the halo units of the part to the given simulation blob, built from the subdomain of the part.
+      Halo units get the attributes given in the spatial domain descriptor.
+      @param[in] SimBlob the simulation blob of the worker
+      @param[in] Domain the whole spatial domain
+    */
+    void attach(SimulationBlob& SimBlob, const openfluid::fluidx::SpatialDomainDescriptor& Domain);
+
+    /**
+      Returns the halo unit of the given class and ID, nullptr if it does not exist
+    */
+    openfluid::core::SpatialUnit* haloUnit(const openfluid::core::UnitsClass_t& UnitsClass,
+                                           openfluid::core::UnitID_t ID);
+
+    inline std::size_t getHaloUnitsCount() const
+    {
+      return m_HaloUnits.size();
+    }
+
+    /**
+      Opens the exchange once the variables of the units are created: publishes the variables of the units exported
+      by the part, then creates the variables of the halo units when the neighbour parts are opened
+      @throw openfluid::base::FrameworkException if a neighbour worker failed
+    */
+    void open();
+
+    /**
+      Updates the variables of the halo units before processing the given time index,
+      waiting for the neighbour workers if needed
+      @throw openfluid::base::FrameworkException if a neighbour worker failed
+    */
+    void importValues(openfluid::core::TimeIndex_t Index);
+
+    /**
+      Publishes the values of the exported units at the given processed time index
+      @throw openfluid::base::FrameworkException if a neighbour worker failed
+    */
+    void exportValues(openfluid::core::TimeIndex_t Index);
+
+    /**
+      Closes the exchange at the end of the run steps, neighbour workers do not wait for this worker anymore
+    */
+    void close();
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_HALOEXCHANGE_HPP__ */
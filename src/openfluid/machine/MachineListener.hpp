@@ -53,8 +53,31 @@ namespace openfluid { namespace machine {
 
 class OPENFLUID_API MachineListener : public openfluid::base::Listener
 {
+  public:
+
+    /**
+      Notification mode of the run steps
+    */
+    enum class RunStepsNotification
+    {
+      /** onRunStep(), onSimulatorRunStep(), onSimulatorRunStepDone() and onRunStepDone()
+          are called for every simulator at every time point */
+      DETAILED,
+      /** onRunStepsProgress() is called at a configured rate with the aggregated status of the processed steps */
+      COALESCED,
+      /** no notification during the run steps */
+      SILENT
+    };
+
+
   private:
 
+    RunStepsNotification m_RunStepsNotification = RunStepsNotification::DETAILED;
+
+    unsigned int m_ProgressStepsInterval = 0;
+
+    unsigned int m_ProgressTimeInterval = 0;
+
 
   public:
 
@@ -63,6 +86,63 @@ class OPENFLUID_API MachineListener : public openfluid::base::Listener
     virtual ~MachineListener()
     { }
 
+    /**
+      Returns the notification mode of the run steps
+    */
+    RunStepsNotification getRunStepsNotification() const
+    {
+      return m_RunStepsNotification;
+    }
+
+    /**
+      Sets the notification mode of the run steps to detailed (default mode)
+    */
+    void setDetailedRunSteps()
+    {
+      m_RunStepsNotification = RunStepsNotification::DETAILED;
+    }
+
+    /**
+      Sets the notification mode of the run steps to silent
+    */
+    void setSilentRunSteps()
+    {
+      m_RunStepsNotification = RunStepsNotification::SILENT;
+    }
+
+    /**
+      Sets the notification mode of the run steps to coalesced: onRunStepsProgress() is called
+      when the given number of steps has been processed or when the given duration has elapsed
+      since the previous call, whichever comes first, and after the last step.
+      An interval set to 0 is not used.
+      If both intervals are 0, onRunStepsProgress() is called after the last step only.
+      @param[in] StepsInterval the number of processed steps between two notifications
+      @param[in] MilliSecondsInterval the minimal duration between two notifications, in milliseconds
+    */
+    void setCoalescedRunSteps(unsigned int StepsInterval, unsigned int MilliSecondsInterval)
+    {
+      m_RunStepsNotification = RunStepsNotification::COALESCED;
+      m_ProgressStepsInterval = StepsInterval;
+      m_ProgressTimeInterval = MilliSecondsInterval;
+    }
+
+    /**
+      Returns the number of processed steps between two progress notifications in coalesced mode, 0 if not used
+    */
+    unsigned int getProgressStepsInterval() const
+    {
+      return m_ProgressStepsInterval;
+    }
+
+    /**
+      Returns the minimal duration between two progress notifications in coalesced mode, in milliseconds,
+      0 if not used
+    */
+    unsigned int getProgressTimeInterval() const
+    {
+      return m_ProgressTimeInterval;
+    }
+
     virtual void onInitParams()
     { }
 
@@ -131,6 +211,17 @@ class OPENFLUID_API MachineListener : public openfluid::base::Listener
                                         const std::string& /*SimulatorID*/)
     { }
 
+    /**
+      Called in coalesced run steps notification mode to report the progress of the simulation
+      @param[in] SimStatus the simulation status at the latest processed step
+      @param[in] StepsCount the number of steps processed since the previous notification
+      @param[in] Status the aggregated status of these steps (warning if at least one simulator raised a warning)
+    */
+    virtual void onRunStepsProgress(const openfluid::base::SimulationStatus* /*SimStatus*/,
+                                    unsigned int /*StepsCount*/,
+                                    const openfluid::base::Listener::Status& /*Status*/)
+    { }
+
     virtual void onAfterRunSteps()
     { }
 
@@ -38,6 +38,8 @@
  */
 
 
+#include <algorithm>
+
 #include <openfluid/base/RunContextManager.hpp>
 #include <openfluid/machine/ModelInstance.hpp>
 #include <openfluid/machine/MachineListener.hpp>
@@ -72,15 +74,18 @@ namespace openfluid { namespace machine {
       if (_M_CurrentSimulator != nullptr) \
       { \
         mp_Listener->onSimulator##listenermethod(_M_CurrentSimulator->Container.signature()->ID); \
-        std::chrono::high_resolution_clock::time_point _M_TimeProfileStart = \
-          std::chrono::high_resolution_clock::now(); \
+        if (mp_SimProfiler != nullptr) \
+        { \
+          mp_SimProfiler->startMeasure(); \
+        } \
         _M_CurrentSimulator->Body->calledmethod; \
-        if (mp_SimProfiler != nullptr)\
+        if (m_SimulationBlob.spatialGraph().isInBatch()) \
+        { \
+          m_SimulationBlob.spatialGraph().endBatch(); \
+        } \
+        if (mp_SimProfiler != nullptr) \
         { \
-          mp_SimProfiler->addDuration(_M_CurrentSimulator->Container.signature()->ID,\
-                                      timeprofilepart, \
-                                      std::chrono::duration_cast<SimulationProfiler::TimeResolution_t>(\
-                                        std::chrono::high_resolution_clock::now() - _M_TimeProfileStart)); \
+          mp_SimProfiler->stopMeasure(_M_CurrentSimulator->Container.signature()->ID,timeprofilepart); \
         } \
         if (mp_SimLogger->isCurrentWarningFlag()) \
           mp_Listener->onSimulator##listenermethod##Done(openfluid::machine::MachineListener::Status::WARNING_STATUS,\
@@ -101,7 +106,8 @@ namespace openfluid { namespace machine {
 ModelInstance::ModelInstance(openfluid::machine::SimulationBlob& SimulationBlob,
                              openfluid::machine::MachineListener* Listener)
              : mp_Listener(Listener), mp_SimLogger(nullptr), mp_SimProfiler(nullptr),
-               m_SimulationBlob(SimulationBlob), m_Initialized(false)
+               m_SimulationBlob(SimulationBlob), m_Initialized(false),
+               m_PendingStepsCount(0), m_PendingStepsWarning(false)
 {
   if (!mp_Listener)
   {
@@ -491,7 +497,8 @@ void ModelInstance::initialize(openfluid::base::SimulationLogger* SimLogger)
 
   if (openfluid::base::RunContextManager::instance()->isProfiling())
   {
-    mp_SimProfiler = new SimulationProfiler(&(m_SimulationBlob.simulationStatus()), SimSequence);
+    mp_SimProfiler = new SimulationProfiler(&(m_SimulationBlob.simulationStatus()), SimSequence,
+                                            openfluid::base::RunContextManager::instance()->isExtendedProfiling());
   }
 
   m_Initialized = true;
@@ -635,17 +642,17 @@ void ModelInstance::call_initializeRun()
     {
       mp_Listener->onSimulatorInitializeRun(CurrentSimulator->Container.signature()->ID);
 
-      std::chrono::high_resolution_clock::time_point TimeProfileStart = std::chrono::high_resolution_clock::now();
+      if (mp_SimProfiler != nullptr)
+      {
+        mp_SimProfiler->startMeasure();
+      }
 
       openfluid::base::SchedulingRequest SchedReq = CurrentSimulator->Body->initializeRun();
 
       if (mp_SimProfiler != nullptr)
       {
-        mp_SimProfiler->addDuration(CurrentSimulator->Container.signature()->ID,
-                                    openfluid::base::SimulationStatus::INITIALIZERUN,
-                                    std::chrono::duration_cast<SimulationProfiler::TimeResolution_t>(
-                                        std::chrono::high_resolution_clock::now()-TimeProfileStart)
-                                    );
+        mp_SimProfiler->stopMeasure(CurrentSimulator->Container.signature()->ID,
+                                    openfluid::base::SimulationStatus::INITIALIZERUN);
       }
 
       if (mp_SimLogger->isCurrentWarningFlag())
@@ -682,6 +689,10 @@ void ModelInstance::call_initializeRun()
 
     ++SimIter;
   }
+
+  m_PendingStepsCount = 0;
+  m_PendingStepsWarning = false;
+  m_LastProgressTime = std::chrono::steady_clock::now();
 }
 
 
@@ -689,56 +700,53 @@ void ModelInstance::call_initializeRun()
 // =====================================================================
 
 
-void ModelInstance::processNextTimePoint()
+/**
+  Processes the items of the front time point.
+  Per simulator listener notifications and warning flags checks are compiled out when not Detailed
+  @return true if at least one simulator raised a warning (Detailed only)
+*/
+template<bool Detailed>
+bool ModelInstance::processTimePointItems()
 {
-
-  if (hasTimePointToProcess())
-  {
-    m_SimulationBlob.simulationStatus().setCurrentTimeIndex(m_TimePointList.front().getTimeIndex());
-  }
-  else
-  {
-    return;
-  }
-
   bool AtLeastOneWarningFlag = false;
 
-  m_TimePointList.front().sortByOriginalPosition();
-
-  mp_Listener->onRunStep(&m_SimulationBlob.simulationStatus());
-
   while (m_TimePointList.front().hasItemsToProcess())
   {
-
     openfluid::machine::ModelItemInstance* NextItem = m_TimePointList.front().nextItem();
 
-    mp_Listener->onSimulatorRunStep(NextItem->Container.signature()->ID);
-    std::chrono::high_resolution_clock::time_point TimeProfileStart = std::chrono::high_resolution_clock::now();
-
-    openfluid::base::SchedulingRequest SchedReq = m_TimePointList.front().processNextItem();
+    if constexpr (Detailed)
+    {
+      mp_Listener->onSimulatorRunStep(NextItem->Container.signature()->ID);
+    }
 
     if (mp_SimProfiler != nullptr)
     {
-      mp_SimProfiler->addDuration(NextItem->Container.signature()->ID,
-                                  openfluid::base::SimulationStatus::RUNSTEP,
-                                  std::chrono::duration_cast<SimulationProfiler::TimeResolution_t>(
-                                      std::chrono::high_resolution_clock::now()-TimeProfileStart)
-                                 );
+      mp_SimProfiler->startMeasure();
     }
 
-    if (mp_SimLogger->isCurrentWarningFlag())
+    openfluid::base::SchedulingRequest SchedReq = m_TimePointList.front().processNextItem();
+
+    if (mp_SimProfiler != nullptr)
     {
-      AtLeastOneWarningFlag = true;
-      mp_Listener->onSimulatorRunStepDone(openfluid::machine::MachineListener::Status::WARNING_STATUS,
-                                          NextItem->Container.signature()->ID);
+      mp_SimProfiler->stopMeasure(NextItem->Container.signature()->ID,openfluid::base::SimulationStatus::RUNSTEP);
     }
-    else
+
+    if constexpr (Detailed)
     {
-      mp_Listener->onSimulatorRunStepDone(openfluid::machine::MachineListener::Status::OK_STATUS,
-                                          NextItem->Container.signature()->ID);
-    }
+      if (mp_SimLogger->isCurrentWarningFlag())
+      {
+        AtLeastOneWarningFlag = true;
+        mp_Listener->onSimulatorRunStepDone(openfluid::machine::MachineListener::Status::WARNING_STATUS,
+                                            NextItem->Container.signature()->ID);
+      }
+      else
+      {
+        mp_Listener->onSimulatorRunStepDone(openfluid::machine::MachineListener::Status::OK_STATUS,
+                                            NextItem->Container.signature()->ID);
+      }
 
-    mp_SimLogger->resetCurrentWarningFlag();
+      mp_SimLogger->resetCurrentWarningFlag();
+    }
 
     checkDeltaTMode(SchedReq,NextItem->Container.signature()->ID);
 
@@ -754,16 +762,93 @@ void ModelInstance::processNextTimePoint()
     }
   }
 
-  if (AtLeastOneWarningFlag)
+  return AtLeastOneWarningFlag;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ModelInstance::notifyRunStepsProgress()
+{
+  bool Notify = !hasTimePointToProcess() ||
+                (mp_Listener->getProgressStepsInterval() &&
+                 m_PendingStepsCount >= mp_Listener->getProgressStepsInterval());
+
+  if (!Notify && mp_Listener->getProgressTimeInterval())
+  {
+    Notify = (std::chrono::steady_clock::now()-m_LastProgressTime) >=
+             std::chrono::milliseconds(mp_Listener->getProgressTimeInterval());
+  }
+
+  if (Notify)
+  {
+    unsigned int StepsCount = m_PendingStepsCount;
+    bool Warning = m_PendingStepsWarning;
+
+    m_PendingStepsCount = 0;
+    m_PendingStepsWarning = false;
+    m_LastProgressTime = std::chrono::steady_clock::now();
+
+    mp_Listener->onRunStepsProgress(&m_SimulationBlob.simulationStatus(),StepsCount,
+                                    Warning ? openfluid::machine::MachineListener::Status::WARNING_STATUS
+                                            : openfluid::machine::MachineListener::Status::OK_STATUS);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ModelInstance::processNextTimePoint()
+{
+
+  if (hasTimePointToProcess())
   {
-    mp_Listener->onRunStepDone(openfluid::machine::MachineListener::Status::WARNING_STATUS);
+    m_SimulationBlob.simulationStatus().setCurrentTimeIndex(m_TimePointList.front().getTimeIndex());
   }
   else
   {
-    mp_Listener->onRunStepDone(openfluid::machine::MachineListener::Status::OK_STATUS);
+    return;
+  }
+
+  m_TimePointList.front().sortByOriginalPosition();
+
+  const MachineListener::RunStepsNotification Notification = mp_Listener->getRunStepsNotification();
+
+  if (Notification == MachineListener::RunStepsNotification::DETAILED)
+  {
+    mp_Listener->onRunStep(&m_SimulationBlob.simulationStatus());
+
+    if (processTimePointItems<true>())
+    {
+      mp_Listener->onRunStepDone(openfluid::machine::MachineListener::Status::WARNING_STATUS);
+    }
+    else
+    {
+      mp_Listener->onRunStepDone(openfluid::machine::MachineListener::Status::OK_STATUS);
+    }
+
+    m_TimePointList.pop_front();
   }
+  else
+  {
+    processTimePointItems<false>();
+
+    // warnings are aggregated for the whole time point
+    m_PendingStepsWarning = m_PendingStepsWarning || mp_SimLogger->isCurrentWarningFlag();
+    mp_SimLogger->resetCurrentWarningFlag();
+    m_PendingStepsCount++;
+
+    m_TimePointList.pop_front();
 
-  m_TimePointList.pop_front();
+    if (Notification == MachineListener::RunStepsNotification::COALESCED)
+    {
+      notifyRunStepsProgress();
+    }
+  }
 }
 
 
@@ -788,5 +873,56 @@ void ModelInstance::call_finalizeRun() const
 // =====================================================================
 
 
+ModelInstance::Schedule_t ModelInstance::getSchedule() const
+{
+  Schedule_t Schedule;
+
+  for (const auto& TimePoint : m_TimePointList)
+  {
+    auto& Positions = Schedule[TimePoint.getTimeIndex()];
+
+    for (const auto* Item : TimePoint.items())
+    {
+      Positions.push_back(std::distance(m_ModelItems.begin(),
+                                        std::find(m_ModelItems.begin(),m_ModelItems.end(),Item)));
+    }
+  }
+
+  return Schedule;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ModelInstance::setSchedule(const Schedule_t& Schedule)
+{
+  const std::vector<ModelItemInstance*> Items(m_ModelItems.begin(),m_ModelItems.end());
+
+  m_TimePointList.clear();
+
+  for (const auto& TimePoint : Schedule)
+  {
+    m_TimePointList.push_back(ExecutionTimePoint(TimePoint.first));
+
+    for (const auto& Position : TimePoint.second)
+    {
+      if (Position >= Items.size())
+      {
+        throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                  "Wrong model item position in schedule");
+      }
+
+      m_TimePointList.back().appendItem(Items[Position]);
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 } } //namespaces
 
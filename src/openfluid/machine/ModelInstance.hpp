@@ -42,6 +42,9 @@
 
 
 #include <list>
+#include <map>
+#include <vector>
+#include <chrono>
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/ware/PluggableWare.hpp>
@@ -64,6 +67,15 @@ class ModelItemInstance;
 
 class OPENFLUID_API ModelInstance
 {
+  public:
+
+    /**
+      Type for the schedule of the model items, associating the time indexes of the execution time points
+      to the positions in the model (starting at 0) of the items to process
+    */
+    typedef std::map<openfluid::core::TimeIndex_t,std::vector<unsigned int>> Schedule_t;
+
+
   private:
 
     std::list<ModelItemInstance*> m_ModelItems;
@@ -82,6 +94,17 @@ class OPENFLUID_API ModelInstance
 
     bool m_Initialized;
 
+    unsigned int m_PendingStepsCount;
+
+    bool m_PendingStepsWarning;
+
+    std::chrono::steady_clock::time_point m_LastProgressTime;
+
+    template<bool Detailed>
+    bool processTimePointItems();
+
+    void notifyRunStepsProgress();
+
     void appendItemToTimePoint(openfluid::core::TimeIndex_t TimeIndex, openfluid::machine::ModelItemInstance* Item);
 
     void checkDeltaTMode(openfluid::base::SchedulingRequest& SReq, const openfluid::ware::WareID_t& ID);
@@ -169,6 +192,19 @@ class OPENFLUID_API ModelInstance
 
     void call_finalizeRun() const;
 
+    /**
+      Returns the execution time points remaining to process, as a schedule of the model items
+      @return the schedule
+    */
+    Schedule_t getSchedule() const;
+
+    /**
+      Replaces the execution time points remaining to process by the given schedule of the model items
+      @param[in] Schedule the schedule
+      @throw openfluid::base::FrameworkException if a position does not match a model item
+    */
+    void setSchedule(const Schedule_t& Schedule);
+
     void resetInitialized()
     {
       m_Initialized = false;
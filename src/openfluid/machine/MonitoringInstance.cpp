@@ -42,6 +42,7 @@
 #include <openfluid/machine/SimulationBlob.hpp>
 #include <openfluid/machine/ObserverPluginsManager.hpp>
 #include <openfluid/machine/ObserverInstance.hpp>
+#include <openfluid/machine/ResultsStoreObserver.hpp>
 
 
 namespace openfluid { namespace machine {
@@ -90,6 +91,13 @@ void MonitoringInstance::appendObserver(ObserverInstance* ObsInstance)
 void MonitoringInstance::initialize(openfluid::base::SimulationLogger* SimLogger)
 {
   openfluid::machine::ObserverPluginsManager* OPlugsMgr = openfluid::machine::ObserverPluginsManager::instance();
+
+  if (!m_ResultsStore.isEmpty() && !mp_ResultsStoreObserver)
+  {
+    mp_ResultsStoreObserver.reset(ResultsStoreObserver::createInstance(m_ResultsStore));
+    m_Observers.push_back(mp_ResultsStoreObserver.get());
+  }
+
   auto ObsIter = m_Observers.begin();
 
   while (ObsIter != m_Observers.end())
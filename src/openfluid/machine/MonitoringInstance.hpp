@@ -42,10 +42,12 @@
 
 
 #include <list>
+#include <memory>
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/ware/PluggableWare.hpp>
 #include <openfluid/machine/ObserverInstance.hpp>
+#include <openfluid/machine/ResultsStore.hpp>
 #include <openfluid/base/SimulationLogger.hpp>
 
 
@@ -65,6 +67,10 @@ class OPENFLUID_API MonitoringInstance
 
     bool m_Initialized;
 
+    ResultsStore m_ResultsStore;
+
+    std::unique_ptr<ObserverInstance> mp_ResultsStoreObserver;
+
 
   public:
 
@@ -76,6 +82,21 @@ class OPENFLUID_API MonitoringInstance
 
     const std::list<ObserverInstance*>& observers() const { return m_Observers; };
 
+    /**
+      Returns the in-memory results store. If variables are added to the store before the initialization
+      of the monitoring, a built-in observer fills the store during the simulation.
+      @see openfluid::machine::ResultsStoreObserver
+    */
+    ResultsStore& resultsStore()
+    {
+      return m_ResultsStore;
+    }
+
+    const ResultsStore& resultsStore() const
+    {
+      return m_ResultsStore;
+    }
+
     void initialize(openfluid::base::SimulationLogger* mp_SimLogger);
 
     void finalize();
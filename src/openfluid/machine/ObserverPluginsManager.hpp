@@ -45,6 +45,7 @@
 #include <openfluid/ware/ObserverSignature.hpp>
 #include <openfluid/machine/ObserverInstance.hpp>
 #include <openfluid/machine/WarePluginsManager.hpp>
+#include <openfluid/waresdev/ObserverSignatureSerializer.hpp>
 #include <openfluid/base/Environment.hpp>
 #include <openfluid/utils/SingletonMacros.hpp>
 
@@ -66,7 +67,9 @@ class OPENFLUID_API ObserverPluginsManager :
     ObserverPluginsManager() : WarePluginsManager<openfluid::ware::ObserverSignature,openfluid::ware::PluggableObserver,
                                                   openfluid::ware::GetPluggableObserverSignatureProc,
                                                   openfluid::ware::GetPluggableObserverBodyProc>()
-    { }
+    {
+      setupSignaturesCache<openfluid::waresdev::ObserverSignatureSerializer>("observers");
+    }
 
 
     ~ObserverPluginsManager()
@@ -0,0 +1,358 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file ProfilingCounters.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <algorithm>
+
+#include <openfluid/global.hpp>
+#include <openfluid/machine/ProfilingCounters.hpp>
+
+#if defined(OPENFLUID_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+#if defined(OPENFLUID_OS_LINUX)
+#include <unistd.h>
+#include <malloc.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <cstring>
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#define OPENFLUID_PROFILING_MALLINFO2
+#endif
+
+
+namespace openfluid { namespace machine {
+
+
+void ProfilingCounters::accumulate(const ProfilingCounters& Start, const ProfilingCounters& End)
+{
+  for (unsigned int i = 0; i < CountersCount; i++)
+  {
+    if (Start.m_Available.test(i) && End.m_Available.test(i))
+    {
+      if (i == static_cast<unsigned int>(Counter::PEAKRSS))
+      {
+        m_Values[i] = std::max(m_Values[i],End.m_Values[i]);
+      }
+      else
+      {
+        m_Values[i] += End.m_Values[i] - Start.m_Values[i];
+      }
+      m_Available.set(i);
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ProfilingCounters::merge(const ProfilingCounters& Other)
+{
+  for (unsigned int i = 0; i < CountersCount; i++)
+  {
+    if (Other.m_Available.test(i))
+    {
+      if (i == static_cast<unsigned int>(Counter::PEAKRSS))
+      {
+        m_Values[i] = std::max(m_Values[i],Other.m_Values[i]);
+      }
+      else
+      {
+        m_Values[i] += Other.m_Values[i];
+      }
+      m_Available.set(i);
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::string ProfilingCounters::getCounterName(Counter C)
+{
+  switch (C)
+  {
+    case Counter::HEAPBYTES:
+      return "HEAPBYTES";
+    case Counter::PEAKRSS:
+      return "PEAKRSS";
+    case Counter::MINORFAULTS:
+      return "MINORFAULTS";
+    case Counter::INSTRUCTIONS:
+      return "INSTRUCTIONS";
+    case Counter::CACHEMISSES:
+      return "CACHEMISSES";
+  }
+
+  return "";
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool SystemProfilingCountersBackend::isAvailable() const
+{
+#if defined(OPENFLUID_OS_UNIX)
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SystemProfilingCountersBackend::read(ProfilingCounters& Counters)
+{
+#if defined(OPENFLUID_OS_UNIX)
+  struct rusage Usage;
+
+  if (getrusage(RUSAGE_SELF,&Usage) == 0)
+  {
+#if defined(OPENFLUID_OS_MAC)
+    // ru_maxrss is given in bytes on macOS
+    Counters.set(ProfilingCounters::Counter::PEAKRSS,Usage.ru_maxrss);
+#else
+    // ru_maxrss is given in kilobytes on Linux
+    Counters.set(ProfilingCounters::Counter::PEAKRSS,static_cast<ProfilingCounters::Value_t>(Usage.ru_maxrss)*1024);
+#endif
+    Counters.set(ProfilingCounters::Counter::MINORFAULTS,Usage.ru_minflt);
+  }
+#endif
+
+#if defined(OPENFLUID_PROFILING_MALLINFO2)
+  struct mallinfo2 Info = mallinfo2();
+  Counters.set(ProfilingCounters::Counter::HEAPBYTES,static_cast<ProfilingCounters::Value_t>(Info.uordblks+Info.hblkhd));
+#endif
+
+  (void)Counters;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+#if defined(OPENFLUID_OS_LINUX)
+
+static int openPerfEvent(unsigned long long Config)
+{
+  struct perf_event_attr Attr;
+
+  std::memset(&Attr,0,sizeof(Attr));
+  Attr.type = PERF_TYPE_HARDWARE;
+  Attr.size = sizeof(Attr);
+  Attr.config = Config;
+  Attr.disabled = 1;
+  Attr.inherit = 1; // counts threads created by threaded spatial loops
+  Attr.exclude_kernel = 1;
+  Attr.exclude_hv = 1;
+
+  int FD = static_cast<int>(syscall(__NR_perf_event_open,&Attr,0,-1,-1,0));
+
+  if (FD >= 0)
+  {
+    ioctl(FD,PERF_EVENT_IOC_RESET,0);
+    ioctl(FD,PERF_EVENT_IOC_ENABLE,0);
+  }
+
+  return FD;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+static bool readPerfEvent(int FD, ProfilingCounters::Value_t& Val)
+{
+  unsigned long long Count = 0;
+
+  if (FD >= 0 && ::read(FD,&Count,sizeof(Count)) == sizeof(Count))
+  {
+    Val = static_cast<ProfilingCounters::Value_t>(Count);
+    return true;
+  }
+
+  return false;
+}
+
+#endif
+
+
+// =====================================================================
+// =====================================================================
+
+
+PerfEventProfilingCountersBackend::PerfEventProfilingCountersBackend() :
+  m_InstructionsFD(-1), m_CacheMissesFD(-1)
+{
+#if defined(OPENFLUID_OS_LINUX)
+  m_InstructionsFD = openPerfEvent(PERF_COUNT_HW_INSTRUCTIONS);
+  m_CacheMissesFD = openPerfEvent(PERF_COUNT_HW_CACHE_MISSES);
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+PerfEventProfilingCountersBackend::~PerfEventProfilingCountersBackend()
+{
+#if defined(OPENFLUID_OS_LINUX)
+  if (m_InstructionsFD >= 0)
+  {
+    close(m_InstructionsFD);
+  }
+
+  if (m_CacheMissesFD >= 0)
+  {
+    close(m_CacheMissesFD);
+  }
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool PerfEventProfilingCountersBackend::isAvailable() const
+{
+  return (m_InstructionsFD >= 0 || m_CacheMissesFD >= 0);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void PerfEventProfilingCountersBackend::read(ProfilingCounters& Counters)
+{
+#if defined(OPENFLUID_OS_LINUX)
+  ProfilingCounters::Value_t Val;
+
+  if (readPerfEvent(m_InstructionsFD,Val))
+  {
+    Counters.set(ProfilingCounters::Counter::INSTRUCTIONS,Val);
+  }
+
+  if (readPerfEvent(m_CacheMissesFD,Val))
+  {
+    Counters.set(ProfilingCounters::Counter::CACHEMISSES,Val);
+  }
+#endif
+
+  (void)Counters;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ProfilingCountersReader::addBackend(std::unique_ptr<ProfilingCountersBackend> Backend)
+{
+  if (Backend && Backend->isAvailable())
+  {
+    m_Backends.push_back(std::move(Backend));
+    return true;
+  }
+
+  return false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ProfilingCountersReader::addDefaultBackends()
+{
+  addBackend(std::make_unique<SystemProfilingCountersBackend>());
+  addBackend(std::make_unique<PerfEventProfilingCountersBackend>());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<std::string> ProfilingCountersReader::getBackendsNames() const
+{
+  std::vector<std::string> Names;
+
+  for (const auto& B : m_Backends)
+  {
+    Names.push_back(B->getName());
+  }
+
+  return Names;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ProfilingCountersReader::read(ProfilingCounters& Counters)
+{
+  Counters.clear();
+
+  for (auto& B : m_Backends)
+  {
+    B->read(Counters);
+  }
+}
+
+
+} } //namespaces
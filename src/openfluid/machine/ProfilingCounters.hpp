@@ -0,0 +1,270 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file ProfilingCounters.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_MACHINE_PROFILINGCOUNTERS_HPP__
+#define __OPENFLUID_MACHINE_PROFILINGCOUNTERS_HPP__
+
+
+#include <array>
+#include <bitset>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <openfluid/dllexport.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+/**
+  Snapshot of resources counters used by the extended profiling mode.
+  Each counter is flagged as available or not, depending on the backends able to read it on the current system.
+*/
+class OPENFLUID_API ProfilingCounters
+{
+  public:
+
+    enum class Counter
+    {
+      HEAPBYTES = 0,     // bytes currently allocated on the heap
+      PEAKRSS = 1,       // peak resident set size of the process, in bytes
+      MINORFAULTS = 2,   // minor page faults
+      INSTRUCTIONS = 3,  // retired instructions (hardware counter)
+      CACHEMISSES = 4    // cache misses (hardware counter)
+    };
+
+    static constexpr unsigned int CountersCount = 5;
+
+    typedef long long Value_t;
+
+
+  private:
+
+    std::array<Value_t,CountersCount> m_Values;
+
+    std::bitset<CountersCount> m_Available;
+
+
+  public:
+
+    ProfilingCounters()
+    {
+      clear();
+    }
+
+    void clear()
+    {
+      m_Values.fill(0);
+      m_Available.reset();
+    }
+
+    void set(Counter C, Value_t Val)
+    {
+      m_Values[static_cast<unsigned int>(C)] = Val;
+      m_Available.set(static_cast<unsigned int>(C));
+    }
+
+    Value_t get(Counter C) const
+    {
+      return m_Values[static_cast<unsigned int>(C)];
+    }
+
+    bool isAvailable(Counter C) const
+    {
+      return m_Available.test(static_cast<unsigned int>(C));
+    }
+
+    bool hasAvailable() const
+    {
+      return m_Available.any();
+    }
+
+    /**
+      Accumulates the difference between the End and Start snapshots into the current counters.
+      The peak RSS counter is not accumulated but kept as the maximum value of the End snapshots.
+      @param[in] Start the snapshot taken before the measured call
+      @param[in] End the snapshot taken after the measured call
+    */
+    void accumulate(const ProfilingCounters& Start, const ProfilingCounters& End);
+
+    /**
+      Merges the given accumulated counters into the current counters.
+      The peak RSS counter is kept as the maximum value of both counters.
+      @param[in] Other the counters to merge
+    */
+    void merge(const ProfilingCounters& Other);
+
+    static std::string getCounterName(Counter C);
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Interface for backends reading resources counters in extended profiling mode
+*/
+class OPENFLUID_API ProfilingCountersBackend
+{
+  public:
+
+    virtual ~ProfilingCountersBackend()
+    { }
+
+    virtual std::string getName() const = 0;
+
+    /**
+      Returns true if the backend is able to read counters on the current system
+    */
+    virtual bool isAvailable() const = 0;
+
+    /**
+      Reads the counters handled by the backend into the given snapshot.
+      Counters that are not handled by the backend must be left untouched.
+      @param[in,out] Counters the snapshot to complete
+    */
+    virtual void read(ProfilingCounters& Counters) = 0;
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Backend reading memory related counters from the operating system (heap usage, peak RSS, page faults).
+  It degrades to the subset of counters supported by the current system and C library.
+*/
+class OPENFLUID_API SystemProfilingCountersBackend : public ProfilingCountersBackend
+{
+  public:
+
+    std::string getName() const
+    {
+      return "system";
+    }
+
+    bool isAvailable() const;
+
+    void read(ProfilingCounters& Counters);
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Backend reading hardware counters (instructions, cache misses) using the Linux perf_event_open interface.
+  It is not available on other systems, or if perf events are not allowed (see /proc/sys/kernel/perf_event_paranoid)
+*/
+class OPENFLUID_API PerfEventProfilingCountersBackend : public ProfilingCountersBackend
+{
+  private:
+
+    int m_InstructionsFD;
+
+    int m_CacheMissesFD;
+
+
+  public:
+
+    PerfEventProfilingCountersBackend();
+
+    ~PerfEventProfilingCountersBackend();
+
+    std::string getName() const
+    {
+      return "perf_event";
+    }
+
+    bool isAvailable() const;
+
+    void read(ProfilingCounters& Counters);
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Set of counters backends, reading snapshots from all available backends
+*/
+class OPENFLUID_API ProfilingCountersReader
+{
+  private:
+
+    std::vector<std::unique_ptr<ProfilingCountersBackend>> m_Backends;
+
+
+  public:
+
+    ProfilingCountersReader() = default;
+
+    /**
+      Adds a backend to the reader. The backend is ignored if it is not available on the current system.
+      @param[in] Backend the backend to add, owned by the reader
+      @return true if the backend has been added, false otherwise
+    */
+    bool addBackend(std::unique_ptr<ProfilingCountersBackend> Backend);
+
+    /**
+      Adds the default backends available on the current system
+    */
+    void addDefaultBackends();
+
+    std::vector<std::string> getBackendsNames() const;
+
+    bool hasBackends() const
+    {
+      return !m_Backends.empty();
+    }
+
+    void read(ProfilingCounters& Counters);
+};
+
+
+} } //namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_PROFILINGCOUNTERS_HPP__ */
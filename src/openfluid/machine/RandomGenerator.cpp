@@ -40,6 +40,7 @@
 
 
 #include <ctime>
+#include <type_traits>
 
 #include <openfluid/machine/RandomGenerator.hpp>
 #include <openfluid/tools/StringHelpers.hpp>
@@ -273,56 +274,60 @@ openfluid::base::SchedulingRequest IntRandomGenerator::initializeRun()
 // =====================================================================
 
 
-openfluid::base::SchedulingRequest DoubleRandomGenerator::runStep()
+template<class V>
+void DoubleRandomGenerator::appendRandomValues(V& Val)
 {
   openfluid::core::SpatialUnit* LU;
 
   OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
   {
-    if (m_VarDimensions.isScalar())  // SCALAR CASE
-    {
-      openfluid::core::DoubleValue Value(Rng.runif<double>(m_Min, m_Max));
-      OPENFLUID_AppendVariable(LU,m_VarName,Value);
-    }
-    else if (m_VarDimensions.isVector())  // VECTOR CASE
+    if constexpr (std::is_same<V,openfluid::core::DoubleValue>::value)
     {
-      if (m_IdenticalCellValues)
-      {
-        openfluid::core::DoubleValue Value(Rng.runif<double>(m_Min, m_Max));
-        openfluid::core::VectorValue VV(m_VarDimensions.Rows,Value);
-        OPENFLUID_AppendVariable(LU,m_VarName,VV);
-      }
-      else
-      {
-        openfluid::core::VectorValue VV(m_VarDimensions.Rows,0.0);
-        for (auto& Val : VV)
-        {
-          Val = openfluid::core::DoubleValue(Rng.runif<double>(m_Min, m_Max));
-        }
-        OPENFLUID_AppendVariable(LU,m_VarName,VV);
-      }
+      Val.set(Rng.runif<double>(m_Min,m_Max));
     }
-    else  // MATRIX CASE
+    else
     {
+      // vector and matrix values are filled in their storage order (columns by columns for matrices)
       if (m_IdenticalCellValues)
       {
-        openfluid::core::DoubleValue Value(Rng.runif<double>(m_Min, m_Max));
-        openfluid::core::MatrixValue MV(m_VarDimensions.Cols,m_VarDimensions.Rows,Value);
-        OPENFLUID_AppendVariable(LU,m_VarName,MV);
+        Val.fill(Rng.runif<double>(m_Min,m_Max));
       }
       else
       {
-        openfluid::core::MatrixValue MV(m_VarDimensions.Cols,m_VarDimensions.Rows,0.0);
-        for (unsigned int c=0;c<m_VarDimensions.Cols;c++)
+        double* Data = Val.data();
+        for (unsigned long i=0;i<Val.size();i++)
         {
-          for (unsigned int r=0;r<m_VarDimensions.Rows;r++)
-          {
-            MV.setElement(c, r, openfluid::core::DoubleValue(Rng.runif<double>(m_Min, m_Max)));
-          }
+          Data[i] = Rng.runif<double>(m_Min,m_Max);
         }
-        OPENFLUID_AppendVariable(LU,m_VarName,MV);
       }
     }
+
+    OPENFLUID_AppendVariable(LU,m_VarName,Val);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::base::SchedulingRequest DoubleRandomGenerator::runStep()
+{
+  // the dimension is checked once per step, the same value being refilled for all units
+  if (m_VarDimensions.isScalar())
+  {
+    openfluid::core::DoubleValue Value(0.0);
+    appendRandomValues(Value);
+  }
+  else if (m_VarDimensions.isVector())
+  {
+    openfluid::core::VectorValue VV(m_VarDimensions.Rows,0.0);
+    appendRandomValues(VV);
+  }
+  else
+  {
+    openfluid::core::MatrixValue MV(m_VarDimensions.Cols,m_VarDimensions.Rows,0.0);
+    appendRandomValues(MV);
   }
 
   return endOfStep();
@@ -335,20 +340,14 @@ openfluid::base::SchedulingRequest DoubleRandomGenerator::runStep()
 
 openfluid::base::SchedulingRequest IntRandomGenerator::runStep()
 {
+  // non-scalar variables are rejected at run initialization
   openfluid::core::SpatialUnit* LU;
+  openfluid::core::IntegerValue Value(0);
 
   OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
   {
-    if (m_VarDimensions.isScalar())
-    {
-      openfluid::core::IntegerValue Value(Rng.irunif(m_Min, m_Max));
-      OPENFLUID_AppendVariable(LU,m_VarName,Value);
-    }
-    else
-    {
-      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
-                                              "int non-scalar var not handled for generator");
-    }
+    Value.set(Rng.irunif(m_Min, m_Max));
+    OPENFLUID_AppendVariable(LU,m_VarName,Value);
   }
 
   return endOfStep();
@@ -385,20 +384,14 @@ openfluid::base::SchedulingRequest BooleanRandomGenerator::initializeRun()
 
 openfluid::base::SchedulingRequest BooleanRandomGenerator::runStep()
 {
+  // non-scalar variables are rejected at run initialization
   openfluid::core::SpatialUnit* LU;
+  openfluid::core::BooleanValue Value(false);
 
   OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
   {
-    if (m_VarDimensions.isScalar())
-    {
-      openfluid::core::BooleanValue Value(Rng.bernoulli(m_Probability));
-      OPENFLUID_AppendVariable(LU,m_VarName,Value);
-    }
-    else
-    {
-      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
-                                              "bool non-scalar var not handled for generator");
-    }
+    Value.set(Rng.bernoulli(m_Probability));
+    OPENFLUID_AppendVariable(LU,m_VarName,Value);
   }
 
   return endOfStep();
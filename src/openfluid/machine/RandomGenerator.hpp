@@ -112,6 +112,16 @@ class NumericalRandomGenerator : public RandomGenerator
 class DoubleRandomGenerator : public NumericalRandomGenerator<openfluid::core::DoubleValue>
 {
 
+  private:
+
+    /**
+      Appends random values to the variable of all units, specialised on the value type
+      (DoubleValue, VectorValue or MatrixValue) so that no dimension check occurs inside the units loop
+    */
+    template<class V>
+    void appendRandomValues(V& Val);
+
+
   public:
 
     DoubleRandomGenerator();
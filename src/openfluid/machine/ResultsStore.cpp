@@ -0,0 +1,349 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file ResultsStore.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+#include <openfluid/machine/ResultsStore.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+ResultsStore::Table::Table(Aggregation Aggr, openfluid::core::Duration_t Window) :
+  m_Aggregation(Aggr), m_Window(Window)
+{
+
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ResultsStore::Table::addValue(openfluid::core::TimeIndex_t Index, openfluid::core::UnitID_t ID, double Value)
+{
+  if (m_Aggregation != Aggregation::NONE)
+  {
+    Index = m_Window ? (Index/m_Window)*m_Window : 0;
+  }
+
+  if (m_Indexes.empty() || m_Indexes.back() != Index)
+  {
+    m_Indexes.push_back(Index);
+
+    for (auto& Column : m_Columns)
+    {
+      Column.push_back(std::numeric_limits<double>::quiet_NaN());
+    }
+    std::fill(m_LastRowCounts.begin(),m_LastRowCounts.end(),0);
+  }
+
+  auto It = m_ColumnsIndex.find(ID);
+
+  if (It == m_ColumnsIndex.end())
+  {
+    It = m_ColumnsIndex.emplace(ID,m_Columns.size()).first;
+    m_UnitsIDs.push_back(ID);
+    m_Columns.emplace_back(m_Indexes.size(),std::numeric_limits<double>::quiet_NaN());
+    m_LastRowCounts.push_back(0);
+  }
+
+  if (std::isnan(Value))
+  {
+    return;
+  }
+
+  double& Cell = m_Columns[It->second].back();
+  unsigned int& Count = m_LastRowCounts[It->second];
+
+  if (!Count || m_Aggregation == Aggregation::NONE)
+  {
+    Cell = Value;
+  }
+  else if (m_Aggregation == Aggregation::MEAN)
+  {
+    Cell += (Value-Cell)/(Count+1);
+  }
+  else if (m_Aggregation == Aggregation::SUM)
+  {
+    Cell += Value;
+  }
+  else if (m_Aggregation == Aggregation::MIN)
+  {
+    Cell = std::min(Cell,Value);
+  }
+  else if (m_Aggregation == Aggregation::MAX)
+  {
+    Cell = std::max(Cell,Value);
+  }
+
+  Count++;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ResultsStore::Table::clear()
+{
+  m_Indexes.clear();
+  m_UnitsIDs.clear();
+  m_ColumnsIndex.clear();
+  m_Columns.clear();
+  m_LastRowCounts.clear();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const std::vector<double>* ResultsStore::Table::column(openfluid::core::UnitID_t ID) const
+{
+  const auto It = m_ColumnsIndex.find(ID);
+
+  if (It == m_ColumnsIndex.end())
+  {
+    return nullptr;
+  }
+
+  return &m_Columns[It->second];
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ResultsStore::addVariable(const openfluid::core::UnitsClass_t& UnitsClass,
+                               const openfluid::core::VariableName_t& VarName,
+                               Aggregation Aggr, openfluid::core::Duration_t Window)
+{
+  return m_Tables.emplace(VariableKey_t(UnitsClass,VarName),Table(Aggr,Window)).second;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ResultsStore::clearVariables()
+{
+  m_Tables.clear();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ResultsStore::clearValues()
+{
+  for (auto& KeyTable : m_Tables)
+  {
+    KeyTable.second.clear();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<ResultsStore::VariableKey_t> ResultsStore::getVariables() const
+{
+  std::vector<VariableKey_t> Keys;
+
+  for (const auto& KeyTable : m_Tables)
+  {
+    Keys.push_back(KeyTable.first);
+  }
+
+  return Keys;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+ResultsStore::Table* ResultsStore::table(const openfluid::core::UnitsClass_t& UnitsClass,
+                                         const openfluid::core::VariableName_t& VarName)
+{
+  auto It = m_Tables.find(VariableKey_t(UnitsClass,VarName));
+
+  if (It == m_Tables.end())
+  {
+    return nullptr;
+  }
+
+  return &It->second;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const ResultsStore::Table* ResultsStore::table(const openfluid::core::UnitsClass_t& UnitsClass,
+                                               const openfluid::core::VariableName_t& VarName) const
+{
+  const auto It = m_Tables.find(VariableKey_t(UnitsClass,VarName));
+
+  if (It == m_Tables.end())
+  {
+    return nullptr;
+  }
+
+  return &It->second;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::size_t ResultsStore::getValuesCount(const openfluid::core::UnitsClass_t& UnitsClass,
+                                         openfluid::core::UnitID_t ID,
+                                         const openfluid::core::VariableName_t& VarName) const
+{
+  const Table* Tbl = table(UnitsClass,VarName);
+
+  if (!Tbl || !Tbl->column(ID))
+  {
+    return 0;
+  }
+
+  return Tbl->getRowsCount();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ResultsStore::getValue(const openfluid::core::UnitsClass_t& UnitsClass, openfluid::core::UnitID_t ID,
+                           const openfluid::core::VariableName_t& VarName, openfluid::core::TimeIndex_t Index,
+                           double& Value) const
+{
+  const Table* Tbl = table(UnitsClass,VarName);
+
+  if (!Tbl || !Tbl->column(ID))
+  {
+    return false;
+  }
+
+  // time indexes are sorted as values are added in simulation order
+  const auto It = std::lower_bound(Tbl->indexes().begin(),Tbl->indexes().end(),Index);
+
+  if (It == Tbl->indexes().end() || *It != Index)
+  {
+    return false;
+  }
+
+  Value = (*Tbl->column(ID))[std::distance(Tbl->indexes().begin(),It)];
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::size_t ResultsStore::copyValues(const openfluid::core::UnitsClass_t& UnitsClass, openfluid::core::UnitID_t ID,
+                                     const openfluid::core::VariableName_t& VarName,
+                                     double* Values, openfluid::core::TimeIndex_t* Indexes, std::size_t Size) const
+{
+  const Table* Tbl = table(UnitsClass,VarName);
+
+  if (!Tbl || !Values)
+  {
+    return 0;
+  }
+
+  const std::vector<double>* Column = Tbl->column(ID);
+
+  if (!Column)
+  {
+    return 0;
+  }
+
+  const std::size_t Count = std::min(Size,Column->size());
+
+  std::copy_n(Column->begin(),Count,Values);
+
+  if (Indexes)
+  {
+    std::copy_n(Tbl->indexes().begin(),Count,Indexes);
+  }
+
+  return Count;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ResultsStore::getAggregationFromString(const std::string& Str, Aggregation& Aggr)
+{
+  static const std::map<std::string,Aggregation> Aggregations = {
+    {"none",Aggregation::NONE},
+    {"mean",Aggregation::MEAN},
+    {"sum",Aggregation::SUM},
+    {"min",Aggregation::MIN},
+    {"max",Aggregation::MAX}
+  };
+
+  const auto It = Aggregations.find(Str);
+
+  if (It == Aggregations.end())
+  {
+    return false;
+  }
+
+  Aggr = It->second;
+  return true;
+}
+
+
+} }  // namespaces
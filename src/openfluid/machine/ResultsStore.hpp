@@ -0,0 +1,229 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file ResultsStore.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_MACHINE_RESULTSSTORE_HPP__
+#define __OPENFLUID_MACHINE_RESULTSSTORE_HPP__
+
+
+#include <map>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/TypeDefs.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+/**
+  In-memory store of simulation results, holding the values of selected variables as double precision series.
+  Values of a variable for a units class are stored as a table made of one column per spatial unit,
+  all columns sharing the same time indexes. Missing values are stored as NaN.
+  Values can be aggregated on the fly over time windows, each row of the table then holds the aggregated values
+  of a window, indexed by the beginning of the window.
+*/
+class OPENFLUID_API ResultsStore
+{
+  public:
+
+    enum class Aggregation { NONE, MEAN, SUM, MIN, MAX };
+
+    /**
+      Values of a variable for a units class, stored by columns
+    */
+    class OPENFLUID_API Table
+    {
+      private:
+
+        Aggregation m_Aggregation;
+
+        openfluid::core::Duration_t m_Window;
+
+        std::vector<openfluid::core::TimeIndex_t> m_Indexes;
+
+        std::vector<openfluid::core::UnitID_t> m_UnitsIDs;
+
+        std::unordered_map<openfluid::core::UnitID_t,std::size_t> m_ColumnsIndex;
+
+        std::vector<std::vector<double>> m_Columns;
+
+        /**
+          Number of values aggregated in the last row, for each column
+        */
+        std::vector<unsigned int> m_LastRowCounts;
+
+
+      public:
+
+        /**
+          @param[in] Aggr the aggregation of values
+          @param[in] Window the duration of aggregation windows, 0 to aggregate over the whole simulation.
+                     Not used if values are not aggregated
+        */
+        Table(Aggregation Aggr = Aggregation::NONE, openfluid::core::Duration_t Window = 0);
+
+        /**
+          Adds the value of the given unit at the given time index, which must not be less than
+          the time index of the previously added value.
+          A row is appended when the time index (or its window if aggregated) is not in the table,
+          a column is added when the unit is not in the table. NaN values are ignored by aggregations.
+        */
+        void addValue(openfluid::core::TimeIndex_t Index, openfluid::core::UnitID_t ID, double Value);
+
+        void clear();
+
+        inline Aggregation getAggregation() const
+        {
+          return m_Aggregation;
+        }
+
+        inline openfluid::core::Duration_t getWindow() const
+        {
+          return m_Window;
+        }
+
+        inline std::size_t getRowsCount() const
+        {
+          return m_Indexes.size();
+        }
+
+        inline const std::vector<openfluid::core::TimeIndex_t>& indexes() const
+        {
+          return m_Indexes;
+        }
+
+        /**
+          Returns the IDs of the units having a column in the table, in order of columns creation
+        */
+        inline const std::vector<openfluid::core::UnitID_t>& unitsIDs() const
+        {
+          return m_UnitsIDs;
+        }
+
+        /**
+          Returns the values of the given unit, aligned with the time indexes, nullptr if the unit has no column
+        */
+        const std::vector<double>* column(openfluid::core::UnitID_t ID) const;
+    };
+
+    typedef std::pair<openfluid::core::UnitsClass_t,openfluid::core::VariableName_t> VariableKey_t;
+
+
+  private:
+
+    std::map<VariableKey_t,Table> m_Tables;
+
+
+  public:
+
+    /**
+      Adds a variable of a units class to store
+      @param[in] UnitsClass the units class
+      @param[in] VarName the variable name
+      @param[in] Aggr the aggregation of values, values are not aggregated by default
+      @param[in] Window the duration of aggregation windows, 0 to aggregate over the whole simulation
+      @return false if the variable is already stored
+    */
+    bool addVariable(const openfluid::core::UnitsClass_t& UnitsClass, const openfluid::core::VariableName_t& VarName,
+                     Aggregation Aggr = Aggregation::NONE, openfluid::core::Duration_t Window = 0);
+
+    /**
+      Removes all the stored variables and their values
+    */
+    void clearVariables();
+
+    /**
+      Removes the stored values, keeping the stored variables
+    */
+    void clearValues();
+
+    std::vector<VariableKey_t> getVariables() const;
+
+    inline bool isEmpty() const
+    {
+      return m_Tables.empty();
+    }
+
+    Table* table(const openfluid::core::UnitsClass_t& UnitsClass, const openfluid::core::VariableName_t& VarName);
+
+    const Table* table(const openfluid::core::UnitsClass_t& UnitsClass,
+                       const openfluid::core::VariableName_t& VarName) const;
+
+    /**
+      Returns the number of stored values for the given variable of the given unit, including missing values
+    */
+    std::size_t getValuesCount(const openfluid::core::UnitsClass_t& UnitsClass, openfluid::core::UnitID_t ID,
+                               const openfluid::core::VariableName_t& VarName) const;
+
+    /**
+      Gets the stored value for the given variable of the given unit at the given time index.
+      For aggregated variables, the time index is the beginning of the window.
+      @return false if no value is stored at this time index
+    */
+    bool getValue(const openfluid::core::UnitsClass_t& UnitsClass, openfluid::core::UnitID_t ID,
+                  const openfluid::core::VariableName_t& VarName, openfluid::core::TimeIndex_t Index,
+                  double& Value) const;
+
+    /**
+      Copies the stored values for the given variable of the given unit into caller-provided buffers
+      @param[in] UnitsClass the units class
+      @param[in] ID the unit ID
+      @param[in] VarName the variable name
+      @param[out] Values the buffer receiving the values, must hold at least Size elements
+      @param[out] Indexes the buffer receiving the time indexes, ignored if nullptr
+      @param[in] Size the size of the buffers
+      @return the number of copied values
+    */
+    std::size_t copyValues(const openfluid::core::UnitsClass_t& UnitsClass, openfluid::core::UnitID_t ID,
+                           const openfluid::core::VariableName_t& VarName,
+                           double* Values, openfluid::core::TimeIndex_t* Indexes, std::size_t Size) const;
+
+    /**
+      Gets the aggregation corresponding to the given name (none, mean, sum, min or max)
+      @return false if the name is not a known aggregation
+    */
+    static bool getAggregationFromString(const std::string& Str, Aggregation& Aggr);
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_RESULTSSTORE_HPP__ */
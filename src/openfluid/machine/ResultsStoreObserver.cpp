@@ -0,0 +1,138 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file ResultsStoreObserver.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <limits>
+
+#include <openfluid/machine/ResultsStoreObserver.hpp>
+#include <openfluid/core/SpatialGraph.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+void ResultsStoreObserver::storeCurrentValues()
+{
+  const openfluid::core::TimeIndex_t CurrentIndex = OPENFLUID_GetCurrentTimeIndex();
+
+  for (const auto& Key : m_Store.getVariables())
+  {
+    const openfluid::core::UnitsCollection* Units = mp_SpatialData->spatialUnits(Key.first);
+
+    if (!Units)
+    {
+      continue;
+    }
+
+    ResultsStore::Table* Tbl = m_Store.table(Key.first,Key.second);
+
+    for (const auto& Unit : *Units->list())
+    {
+      const openfluid::core::Value* Val = Unit.variables()->value(Key.second,CurrentIndex);
+
+      if (!Val)
+      {
+        continue;
+      }
+
+      double StoredVal = std::numeric_limits<double>::quiet_NaN();
+
+      if (Val->isDoubleValue())
+      {
+        StoredVal = Val->asDoubleValue().get();
+      }
+      else if (Val->isIntegerValue())
+      {
+        StoredVal = Val->asIntegerValue().get();
+      }
+      else if (Val->isBooleanValue())
+      {
+        StoredVal = Val->asBooleanValue().get() ? 1.0 : 0.0;
+      }
+
+      Tbl->addValue(CurrentIndex,Unit.getID(),StoredVal);
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ResultsStoreObserver::onInitializedRun()
+{
+  m_Store.clearValues();
+  storeCurrentValues();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ResultsStoreObserver::onStepCompleted()
+{
+  storeCurrentValues();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+ObserverInstance* ResultsStoreObserver::createInstance(ResultsStore& Store)
+{
+  static const WareContainer<openfluid::ware::ObserverSignature> Container = []()
+  {
+    WareContainer<openfluid::ware::ObserverSignature> Cont(openfluid::ware::WareType::OBSERVER);
+    auto Sign = new openfluid::ware::ObserverSignature();
+    Sign->ID = "builtin.results.store";
+    Sign->Name = "In-memory results store";
+    Cont.setSignature(Sign);
+    Cont.validate();
+    return Cont;
+  }();
+
+  ObserverInstance* Instance = new ObserverInstance(Container);
+  Instance->Body = std::make_unique<ResultsStoreObserver>(Store);
+
+  return Instance;
+}
+
+
+} }  // namespaces
@@ -0,0 +1,100 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file ResultsStoreObserver.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_MACHINE_RESULTSSTOREOBSERVER_HPP__
+#define __OPENFLUID_MACHINE_RESULTSSTOREOBSERVER_HPP__
+
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/ware/PluggableObserver.hpp>
+#include <openfluid/machine/ObserverInstance.hpp>
+#include <openfluid/machine/ResultsStore.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+/**
+  Built-in observer storing the values of the variables selected in a results store at each completed time step.
+  Numeric values (double, integer and boolean values) are stored, other values are stored as missing values.
+  The store is cleared when the run is initialized.
+*/
+class OPENFLUID_API ResultsStoreObserver : public openfluid::ware::PluggableObserver
+{
+  private:
+
+    ResultsStore& m_Store;
+
+    void storeCurrentValues();
+
+
+  public:
+
+    ResultsStoreObserver(ResultsStore& Store) : PluggableObserver(), m_Store(Store)
+    { }
+
+    virtual ~ResultsStoreObserver()
+    { }
+
+    void initParams(const openfluid::ware::WareParams_t& /*Params*/)
+    { }
+
+    void onPrepared()
+    { }
+
+    void onInitializedRun();
+
+    void onStepCompleted();
+
+    void onFinalizedRun()
+    { }
+
+    /**
+      Creates an observer instance storing values into the given store,
+      to be appended to a monitoring instance. The store must outlive the created instance.
+      @param[in] Store the results store
+      @return the created observer instance, owned by the caller
+    */
+    static ObserverInstance* createInstance(ResultsStore& Store);
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_RESULTSSTOREOBSERVER_HPP__ */
@@ -0,0 +1,780 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SimulationCheckpoint.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/core/BooleanValue.hpp>
+#include <openfluid/core/IntegerValue.hpp>
+#include <openfluid/core/MatrixValue.hpp>
+#include <openfluid/core/NullValue.hpp>
+#include <openfluid/core/TreeValue.hpp>
+#include <openfluid/machine/SimulationCheckpoint.hpp>
+#include <openfluid/machine/SimulationBlob.hpp>
+#include <openfluid/machine/ModelInstance.hpp>
+#include <openfluid/machine/ModelItemInstance.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+namespace {
+
+
+const std::string CheckpointMagic = "OPENFLUID-CHECKPOINT";
+
+const std::uint32_t CheckpointVersion = 1;
+
+
+// =====================================================================
+// =====================================================================
+
+
+[[noreturn]] void throwCorrupted()
+{
+  throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Wrong or corrupted checkpoint");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template<typename T>
+void writeRaw(std::ostream& OutStm, const T& Val)
+{
+  OutStm.write(reinterpret_cast<const char*>(&Val),sizeof(T));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template<typename T>
+T readRaw(std::istream& InStm)
+{
+  T Val;
+
+  if (!InStm.read(reinterpret_cast<char*>(&Val),sizeof(T)))
+  {
+    throwCorrupted();
+  }
+
+  return Val;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void writeString(std::ostream& OutStm, const std::string& Str)
+{
+  writeRaw<std::uint32_t>(OutStm,Str.size());
+  OutStm.write(Str.data(),Str.size());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::string readString(std::istream& InStm)
+{
+  std::string Str(readRaw<std::uint32_t>(InStm),'\0');
+
+  if (!InStm.read(&Str[0],Str.size()))
+  {
+    throwCorrupted();
+  }
+
+  return Str;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void writeDoubles(std::ostream& OutStm, const double* Data, std::uint64_t Size)
+{
+  OutStm.write(reinterpret_cast<const char*>(Data),Size*sizeof(double));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void readDoubles(std::istream& InStm, double* Data, std::uint64_t Size)
+{
+  if (!InStm.read(reinterpret_cast<char*>(Data),Size*sizeof(double)))
+  {
+    throwCorrupted();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void writeTree(std::ostream& OutStm, const openfluid::core::Tree<std::string,double>& Node)
+{
+  writeRaw<std::uint8_t>(OutStm,Node.hasValue());
+  if (Node.hasValue())
+  {
+    writeRaw<double>(OutStm,Node.getValue());
+  }
+
+  writeRaw<std::uint32_t>(OutStm,Node.children().size());
+  for (const auto& Child : Node.children())
+  {
+    writeString(OutStm,Child.first);
+    writeTree(OutStm,Child.second);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void readTree(std::istream& InStm, openfluid::core::Tree<std::string,double>& Node)
+{
+  if (readRaw<std::uint8_t>(InStm))
+  {
+    Node.setValue(readRaw<double>(InStm));
+  }
+
+  const auto ChildrenCount = readRaw<std::uint32_t>(InStm);
+  for (std::uint32_t i=0; i<ChildrenCount; i++)
+  {
+    const std::string Key = readString(InStm);
+    readTree(InStm,Node.addChild(Key));
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void writeValue(std::ostream& OutStm, const openfluid::core::Value& Val)
+{
+  writeRaw<std::uint8_t>(OutStm,Val.getType());
+
+  switch (Val.getType())
+  {
+    case openfluid::core::Value::BOOLEAN:
+      writeRaw<std::uint8_t>(OutStm,Val.asBooleanValue().get());
+      break;
+
+    case openfluid::core::Value::INTEGER:
+      writeRaw<std::int64_t>(OutStm,Val.asIntegerValue().get());
+      break;
+
+    case openfluid::core::Value::DOUBLE:
+      writeRaw<double>(OutStm,Val.asDoubleValue().get());
+      break;
+
+    case openfluid::core::Value::STRING:
+      writeString(OutStm,Val.asStringValue().get());
+      break;
+
+    case openfluid::core::Value::VECTOR:
+      writeRaw<std::uint64_t>(OutStm,Val.asVectorValue().size());
+      writeDoubles(OutStm,Val.asVectorValue().data(),Val.asVectorValue().size());
+      break;
+
+    case openfluid::core::Value::MATRIX:
+      writeRaw<std::uint64_t>(OutStm,Val.asMatrixValue().getColsNbr());
+      writeRaw<std::uint64_t>(OutStm,Val.asMatrixValue().getRowsNbr());
+      writeDoubles(OutStm,Val.asMatrixValue().data(),Val.asMatrixValue().size());
+      break;
+
+    case openfluid::core::Value::MAP:
+      writeRaw<std::uint32_t>(OutStm,Val.asMapValue().size());
+      for (const auto& Item : Val.asMapValue())
+      {
+        writeString(OutStm,Item.first);
+        writeValue(OutStm,*Item.second);
+      }
+      break;
+
+    case openfluid::core::Value::TREE:
+      writeTree(OutStm,Val.asTreeValue());
+      break;
+
+    case openfluid::core::Value::NULLL:
+      break;
+
+    default:
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "Value type not supported in checkpoints");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::unique_ptr<openfluid::core::Value> readValue(std::istream& InStm)
+{
+  switch (readRaw<std::uint8_t>(InStm))
+  {
+    case openfluid::core::Value::BOOLEAN:
+      return std::make_unique<openfluid::core::BooleanValue>(readRaw<std::uint8_t>(InStm) != 0);
+
+    case openfluid::core::Value::INTEGER:
+      return std::make_unique<openfluid::core::IntegerValue>(readRaw<std::int64_t>(InStm));
+
+    case openfluid::core::Value::DOUBLE:
+      return std::make_unique<openfluid::core::DoubleValue>(readRaw<double>(InStm));
+
+    case openfluid::core::Value::STRING:
+      return std::make_unique<openfluid::core::StringValue>(readString(InStm));
+
+    case openfluid::core::Value::VECTOR:
+    {
+      auto Vect = std::make_unique<openfluid::core::VectorValue>(readRaw<std::uint64_t>(InStm));
+      readDoubles(InStm,Vect->data(),Vect->size());
+      return Vect;
+    }
+
+    case openfluid::core::Value::MATRIX:
+    {
+      const auto ColsNbr = readRaw<std::uint64_t>(InStm);
+      const auto RowsNbr = readRaw<std::uint64_t>(InStm);
+      auto Matrix = std::make_unique<openfluid::core::MatrixValue>(ColsNbr,RowsNbr);
+      readDoubles(InStm,Matrix->data(),Matrix->size());
+      return Matrix;
+    }
+
+    case openfluid::core::Value::MAP:
+    {
+      auto Map = std::make_unique<openfluid::core::MapValue>();
+      const auto ItemsCount = readRaw<std::uint32_t>(InStm);
+      for (std::uint32_t i=0; i<ItemsCount; i++)
+      {
+        const std::string Key = readString(InStm);
+        Map->set(Key,readValue(InStm).release());
+      }
+      return Map;
+    }
+
+    case openfluid::core::Value::TREE:
+    {
+      auto Tree = std::make_unique<openfluid::core::TreeValue>();
+      readTree(InStm,*Tree);
+      return Tree;
+    }
+
+    case openfluid::core::Value::NULLL:
+      return std::make_unique<openfluid::core::NullValue>();
+
+    default:
+      throwCorrupted();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void writeUnitRef(std::ostream& OutStm, const openfluid::core::SpatialUnit* Unit)
+{
+  writeString(OutStm,Unit->getClass());
+  writeRaw<std::uint32_t>(OutStm,Unit->getID());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::core::SpatialUnit* readUnitRef(std::istream& InStm, openfluid::core::SpatialGraph& Graph)
+{
+  const std::string ClassName = readString(InStm);
+  openfluid::core::SpatialUnit* Unit = Graph.spatialUnit(ClassName,readRaw<std::uint32_t>(InStm));
+
+  if (!Unit)
+  {
+    throwCorrupted();
+  }
+
+  return Unit;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Writes the units linked to the given unit through the given accessor, for all units classes
+*/
+template<typename LinkedUnitsFunc>
+void writeLinkedUnits(std::ostream& OutStm, const openfluid::core::SpatialGraph& Graph,
+                      LinkedUnitsFunc LinkedUnits)
+{
+  std::vector<const openfluid::core::SpatialUnit*> Units;
+
+  for (const auto& ClassUnits : *Graph.allSpatialUnitsByClass())
+  {
+    const openfluid::core::UnitsPtrList_t* Linked = LinkedUnits(ClassUnits.first);
+
+    if (Linked)
+    {
+      Units.insert(Units.end(),Linked->begin(),Linked->end());
+    }
+  }
+
+  writeRaw<std::uint32_t>(OutStm,Units.size());
+  for (const auto* Unit : Units)
+  {
+    writeUnitRef(OutStm,Unit);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::set<openfluid::core::SpatialUnit*> getLinkedUnits(
+  openfluid::core::SpatialGraph& Graph,
+  const std::function<openfluid::core::UnitsPtrList_t*(const openfluid::core::UnitsClass_t&)>& LinkedUnits)
+{
+  std::set<openfluid::core::SpatialUnit*> Units;
+
+  for (const auto& ClassUnits : *Graph.allSpatialUnitsByClass())
+  {
+    const openfluid::core::UnitsPtrList_t* Linked = LinkedUnits(ClassUnits.first);
+
+    if (Linked)
+    {
+      Units.insert(Linked->begin(),Linked->end());
+    }
+  }
+
+  return Units;
+}
+
+
+}  // anonymous namespace
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationCheckpoint::write(std::ostream& OutStm, const SimulationBlob& SimBlob, const ModelInstance& MInstance)
+{
+  const auto& Graph = SimBlob.spatialGraph();
+
+  OutStm.write(CheckpointMagic.data(),CheckpointMagic.size());
+  writeRaw<std::uint32_t>(OutStm,CheckpointVersion);
+
+
+  // simulation status and model
+
+  writeRaw<std::uint64_t>(OutStm,SimBlob.simulationStatus().getBeginDate().getRawTime());
+  writeRaw<std::uint64_t>(OutStm,SimBlob.simulationStatus().getCurrentTimeIndex());
+
+  writeRaw<std::uint32_t>(OutStm,MInstance.items().size());
+  for (const auto* Item : MInstance.items())
+  {
+    writeString(OutStm,Item->Container.signature()->ID);
+
+    openfluid::core::MapValue State;
+    Item->Body->saveState(State);
+    writeValue(OutStm,State);
+  }
+
+  const ModelInstance::Schedule_t Schedule = MInstance.getSchedule();
+  writeRaw<std::uint32_t>(OutStm,Schedule.size());
+  for (const auto& TimePoint : Schedule)
+  {
+    writeRaw<std::uint64_t>(OutStm,TimePoint.first);
+    writeRaw<std::uint32_t>(OutStm,TimePoint.second.size());
+    for (const auto& Position : TimePoint.second)
+    {
+      writeRaw<std::uint32_t>(OutStm,Position);
+    }
+  }
+
+
+  // spatial units
+
+  writeRaw<std::uint32_t>(OutStm,Graph.allSpatialUnits()->size());
+  for (const auto* Unit : *Graph.allSpatialUnits())
+  {
+    writeUnitRef(OutStm,Unit);
+    writeRaw<std::int32_t>(OutStm,Unit->getProcessOrder());
+  }
+
+
+  // connections and data of spatial units
+
+  for (const auto* Unit : *Graph.allSpatialUnits())
+  {
+    writeUnitRef(OutStm,Unit);
+
+    writeLinkedUnits(OutStm,Graph,[Unit](const openfluid::core::UnitsClass_t& ClassName)
+                                  {
+                                    return Unit->toSpatialUnits(ClassName);
+                                  });
+    writeLinkedUnits(OutStm,Graph,[Unit](const openfluid::core::UnitsClass_t& ClassName)
+                                  {
+                                    return Unit->parentSpatialUnits(ClassName);
+                                  });
+
+    const auto AttrsNames = Unit->attributes()->getAttributesNames();
+    writeRaw<std::uint32_t>(OutStm,AttrsNames.size());
+    for (const auto& AttrName : AttrsNames)
+    {
+      writeString(OutStm,AttrName);
+      writeValue(OutStm,*Unit->attributes()->value(AttrName));
+    }
+
+    // values of shared variables are owned by the simulator which produced them (e.g. constant generator),
+    // which saves and restores them through its internal state
+    std::vector<openfluid::core::VariableName_t> VarsNames;
+    for (const auto& VarName : Unit->variables()->getVariablesNames())
+    {
+      if (!Unit->variables()->isSharedVariable(VarName))
+      {
+        VarsNames.push_back(VarName);
+      }
+    }
+
+    writeRaw<std::uint32_t>(OutStm,VarsNames.size());
+    for (const auto& VarName : VarsNames)
+    {
+      writeString(OutStm,VarName);
+      writeRaw<std::uint8_t>(OutStm,Unit->variables()->getVariableType(VarName));
+
+      openfluid::core::IndexedValuesView View;
+      Unit->variables()->getLatestIndexedValuesView(VarName,0,View);
+
+      writeRaw<std::uint32_t>(OutStm,View.size());
+      for (const auto& IndValue : View)
+      {
+        writeRaw<std::uint64_t>(OutStm,IndValue.getIndex());
+        writeValue(OutStm,*IndValue.value());
+      }
+    }
+
+    const auto* Events = Unit->events()->eventsList();
+    writeRaw<std::uint32_t>(OutStm,Events->size());
+    for (const auto& Ev : *Events)
+    {
+      writeRaw<std::uint64_t>(OutStm,Ev.getDateTime().getRawTime());
+
+      const auto Infos = Ev.getInfos();
+      writeRaw<std::uint32_t>(OutStm,Infos.size());
+      for (const auto& Info : Infos)
+      {
+        writeString(OutStm,Info.first);
+        writeString(OutStm,Info.second.get());
+      }
+    }
+  }
+
+  if (!OutStm)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Unable to write checkpoint");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationCheckpoint::read(std::istream& InStm, SimulationBlob& SimBlob, ModelInstance& MInstance)
+{
+  auto& Graph = SimBlob.spatialGraph();
+
+  std::string Magic(CheckpointMagic.size(),'\0');
+  if (!InStm.read(&Magic[0],Magic.size()) || Magic != CheckpointMagic ||
+      readRaw<std::uint32_t>(InStm) != CheckpointVersion)
+  {
+    throwCorrupted();
+  }
+
+
+  // simulation status and model
+
+  if (readRaw<std::uint64_t>(InStm) != SimBlob.simulationStatus().getBeginDate().getRawTime())
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Checkpoint does not match the simulation begin date");
+  }
+
+  const auto TimeIndex = readRaw<std::uint64_t>(InStm);
+
+  if (readRaw<std::uint32_t>(InStm) != MInstance.items().size())
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Checkpoint does not match the model");
+  }
+
+  std::vector<std::unique_ptr<openfluid::core::Value>> States;
+  for (const auto* Item : MInstance.items())
+  {
+    if (readString(InStm) != Item->Container.signature()->ID)
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Checkpoint does not match the model");
+    }
+
+    States.push_back(readValue(InStm));
+    if (States.back()->getType() != openfluid::core::Value::MAP)
+    {
+      throwCorrupted();
+    }
+  }
+
+  ModelInstance::Schedule_t Schedule;
+  const auto TimePointsCount = readRaw<std::uint32_t>(InStm);
+  for (std::uint32_t i=0; i<TimePointsCount; i++)
+  {
+    auto& Positions = Schedule[readRaw<std::uint64_t>(InStm)];
+    Positions.resize(readRaw<std::uint32_t>(InStm));
+    for (auto& Position : Positions)
+    {
+      Position = readRaw<std::uint32_t>(InStm);
+    }
+  }
+
+
+  // spatial units, removing units absent from the checkpoint and adding missing units
+
+  std::map<openfluid::core::UnitsClass_t,std::map<openfluid::core::UnitID_t,openfluid::core::PcsOrd_t>> Units;
+  const auto UnitsCount = readRaw<std::uint32_t>(InStm);
+  for (std::uint32_t i=0; i<UnitsCount; i++)
+  {
+    const std::string ClassName = readString(InStm);
+    const auto ID = readRaw<std::uint32_t>(InStm);
+    Units[ClassName][ID] = readRaw<std::int32_t>(InStm);
+  }
+
+  std::vector<openfluid::core::SpatialUnit*> RemovedUnits;
+  for (auto* Unit : *Graph.allSpatialUnits())
+  {
+    const auto ClassIt = Units.find(Unit->getClass());
+
+    if (ClassIt == Units.end() || ClassIt->second.find(Unit->getID()) == ClassIt->second.end())
+    {
+      RemovedUnits.push_back(Unit);
+    }
+  }
+  for (auto* Unit : RemovedUnits)
+  {
+    Graph.deleteUnit(Unit);
+  }
+
+  for (const auto& ClassUnits : Units)
+  {
+    for (const auto& IDPcsOrd : ClassUnits.second)
+    {
+      openfluid::core::SpatialUnit* Unit = Graph.spatialUnit(ClassUnits.first,IDPcsOrd.first);
+
+      if (!Unit)
+      {
+        Graph.addUnit(openfluid::core::SpatialUnit(ClassUnits.first,IDPcsOrd.first,IDPcsOrd.second));
+      }
+      else if (Unit->getProcessOrder() != IDPcsOrd.second)
+      {
+        Unit->setProcessOrder(IDPcsOrd.second);
+      }
+    }
+  }
+
+  Graph.sortUnitsByProcessOrder();
+
+
+  // connections and data of spatial units
+
+  for (std::uint32_t i=0; i<UnitsCount; i++)
+  {
+    openfluid::core::SpatialUnit* Unit = readUnitRef(InStm,Graph);
+
+    std::set<openfluid::core::SpatialUnit*> ToUnits;
+    const auto ToUnitsCount = readRaw<std::uint32_t>(InStm);
+    for (std::uint32_t j=0; j<ToUnitsCount; j++)
+    {
+      ToUnits.insert(readUnitRef(InStm,Graph));
+    }
+
+    for (auto* ToUnit : getLinkedUnits(Graph,[Unit](const openfluid::core::UnitsClass_t& ClassName)
+                                              {
+                                                return Unit->toSpatialUnits(ClassName);
+                                              }))
+    {
+      if (!ToUnits.erase(ToUnit))
+      {
+        Graph.removeFromToConnection(Unit,ToUnit);
+      }
+    }
+    for (auto* ToUnit : ToUnits)
+    {
+      Graph.addFromToConnection(Unit,ToUnit);
+    }
+
+    std::set<openfluid::core::SpatialUnit*> ParentUnits;
+    const auto ParentUnitsCount = readRaw<std::uint32_t>(InStm);
+    for (std::uint32_t j=0; j<ParentUnitsCount; j++)
+    {
+      ParentUnits.insert(readUnitRef(InStm,Graph));
+    }
+
+    for (auto* ParentUnit : getLinkedUnits(Graph,[Unit](const openfluid::core::UnitsClass_t& ClassName)
+                                                  {
+                                                    return Unit->parentSpatialUnits(ClassName);
+                                                  }))
+    {
+      if (!ParentUnits.erase(ParentUnit))
+      {
+        Graph.removeChildParentConnection(Unit,ParentUnit);
+      }
+    }
+    for (auto* ParentUnit : ParentUnits)
+    {
+      Unit->addParentUnit(ParentUnit);
+      ParentUnit->addChildUnit(Unit);
+    }
+
+    std::set<openfluid::core::AttributeName_t> AttrsNames;
+    const auto AttrsCount = readRaw<std::uint32_t>(InStm);
+    for (std::uint32_t j=0; j<AttrsCount; j++)
+    {
+      const std::string AttrName = readString(InStm);
+      const auto AttrValue = readValue(InStm);
+
+      Unit->attributes()->removeAttribute(AttrName);
+      Unit->attributes()->setValue(AttrName,*AttrValue);
+      AttrsNames.insert(AttrName);
+    }
+    for (const auto& AttrName : Unit->attributes()->getAttributesNames())
+    {
+      if (!AttrsNames.count(AttrName))
+      {
+        Unit->attributes()->removeAttribute(AttrName);
+      }
+    }
+
+    const auto VarsCount = readRaw<std::uint32_t>(InStm);
+    for (std::uint32_t j=0; j<VarsCount; j++)
+    {
+      const std::string VarName = readString(InStm);
+      const auto VarType = static_cast<openfluid::core::Value::Type>(readRaw<std::uint8_t>(InStm));
+
+      const std::string VarDesc = "variable "+VarName+" on unit "+
+                                  Unit->getClass()+"#"+std::to_string(Unit->getID());
+
+      if (!Unit->variables()->isVariableExist(VarName))
+      {
+        Unit->variables()->createVariable(VarName,VarType);
+      }
+      else if (Unit->variables()->isSharedVariable(VarName))
+      {
+        // the checkpoint was written by a model which did not share this variable
+        throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                  "Unable to restore checkpoint: values of "+VarDesc+
+                                                  " are shared between units in the current model");
+      }
+      Unit->variables()->clearVariableValues(VarName);
+
+      const auto ValuesCount = readRaw<std::uint32_t>(InStm);
+      for (std::uint32_t k=0; k<ValuesCount; k++)
+      {
+        const auto Index = readRaw<std::uint64_t>(InStm);
+
+        if (!Unit->variables()->appendValue(VarName,Index,readValue(InStm)))
+        {
+          throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                    "Unable to restore checkpoint: cannot append value of "+VarDesc+
+                                                    " at index "+std::to_string(Index)+
+                                                    " (wrong index order or type mismatch)");
+        }
+      }
+    }
+
+    Unit->events()->clear();
+    const auto EventsCount = readRaw<std::uint32_t>(InStm);
+    for (std::uint32_t j=0; j<EventsCount; j++)
+    {
+      openfluid::core::Event Ev(openfluid::core::DateTime(readRaw<std::uint64_t>(InStm)));
+
+      const auto InfosCount = readRaw<std::uint32_t>(InStm);
+      for (std::uint32_t k=0; k<InfosCount; k++)
+      {
+        const std::string Key = readString(InStm);
+        Ev.addInfo(Key,readString(InStm));
+      }
+
+      Unit->events()->addEvent(Ev);
+    }
+  }
+
+
+  // time point, schedule and internal states of simulators
+
+  SimBlob.simulationStatus().setCurrentTimeIndex(TimeIndex);
+  MInstance.setSchedule(Schedule);
+
+  auto StateIt = States.begin();
+  for (auto* Item : MInstance.items())
+  {
+    Item->Body->restoreState((*StateIt)->asMapValue());
+    ++StateIt;
+  }
+}
+
+
+} }  // namespaces
@@ -0,0 +1,91 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SimulationCheckpoint.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_MACHINE_SIMULATIONCHECKPOINT_HPP__
+#define __OPENFLUID_MACHINE_SIMULATIONCHECKPOINT_HPP__
+
+
+#include <iostream>
+
+#include <openfluid/dllexport.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+class SimulationBlob;
+class ModelInstance;
+
+
+/**
+  Binary checkpoint of a running simulation, used to restart the simulation from a given time point.
+  A checkpoint holds the current time index, the execution time points remaining to process,
+  the spatial graph with its connections, the attributes, variables and events of spatial units,
+  and the internal states saved by the simulators.
+  Values of variables shared between units (e.g. produced by a constant generator) are not part of
+  the variables of spatial units, they must be saved and restored by the simulator owning them.
+*/
+class OPENFLUID_API SimulationCheckpoint
+{
+  public:
+
+    /**
+      Writes the state of the running simulation to a binary checkpoint
+      @param[out] OutStm the stream receiving the checkpoint
+      @param[in] SimBlob the simulation blob
+      @param[in] MInstance the model instance
+    */
+    static void write(std::ostream& OutStm, const SimulationBlob& SimBlob, const ModelInstance& MInstance);
+
+    /**
+      Restores the state of the simulation from a binary checkpoint.
+      The simulation must be in the RUNSTEP stage, with the same begin date and the same coupled model
+      than the checkpointed simulation.
+      @param[in] InStm the stream providing the checkpoint
+      @param[in,out] SimBlob the simulation blob
+      @param[in,out] MInstance the model instance
+      @throw openfluid::base::FrameworkException if the checkpoint is corrupted or does not match the simulation
+    */
+    static void read(std::istream& InStm, SimulationBlob& SimBlob, ModelInstance& MInstance);
+};
+
+
+} } // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_SIMULATIONCHECKPOINT_HPP__ */
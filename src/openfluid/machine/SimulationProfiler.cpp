@@ -57,10 +57,37 @@ double SimulationProfiler::getDurationInDecimalSeconds(const TimeResolution_t& D
 // =====================================================================
 
 
+void SimulationProfiler::writeCounters(std::ostream& OutStream, const ProfilingCounters& Counters)
+{
+  for (unsigned int i = 0; i < ProfilingCounters::CountersCount; i++)
+  {
+    const auto C = static_cast<ProfilingCounters::Counter>(i);
+
+    if (Counters.isAvailable(C))
+    {
+      OutStream << ";" << Counters.get(C);
+    }
+    else
+    {
+      OutStream << ";NA";
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 SimulationProfiler::SimulationProfiler(const openfluid::base::SimulationStatus* SimStatus,
-                                       const WareIDSequence_t& OrigModelSequence)
-: mp_SimStatus(SimStatus), m_OriginalModelSequence(OrigModelSequence), m_CurrentTimeIndex(0)
+                                       const WareIDSequence_t& OrigModelSequence, bool WithCounters)
+: mp_SimStatus(SimStatus), m_OriginalModelSequence(OrigModelSequence), m_CurrentTimeIndex(0),
+  m_CountersEnabled(WithCounters)
 {
+  if (m_CountersEnabled)
+  {
+    m_CountersReader.addDefaultBackends();
+  }
 
   m_CurrentSequenceFile.open(openfluid::base::RunContextManager::instance()
     ->getOutputFullPath(openfluid::config::SCHEDULE_PROFILE_FILE).c_str(),std::ios::out);
@@ -89,6 +116,7 @@ SimulationProfiler::SimulationProfiler(const openfluid::base::SimulationStatus*
         TimeResolution_t(0);
     m_CumulativeModelProfile[*It][openfluid::base::SimulationStatus::FINALIZERUN] =
         TimeResolution_t(0);
+    m_RunStepCallsCount[*It] = 0;
 
     m_CurrentProfileFile << ";" << *It;
   }
@@ -116,7 +144,26 @@ SimulationProfiler::~SimulationProfiler()
     ->getOutputFullPath(openfluid::config::CUMULATIVE_PROFILE_FILE).c_str(),std::ios::out);
 
   CumulativeFile << std::fixed << std::setprecision(9);
-  CumulativeFile << "ID;INITPARAMS;PREPAREDATA;CHECKCONSISTENCY;INITIALIZERUN;RUNSTEP;FINALIZERUN\n";
+  CumulativeFile << "ID;INITPARAMS;PREPAREDATA;CHECKCONSISTENCY;INITIALIZERUN;RUNSTEP;FINALIZERUN";
+
+  if (m_CountersEnabled)
+  {
+    // counters for all stages, then for the RUNSTEP stage only
+
+    CumulativeFile << ";RUNSTEPCALLS";
+
+    for (unsigned int i = 0; i < ProfilingCounters::CountersCount; i++)
+    {
+      CumulativeFile << ";" << ProfilingCounters::getCounterName(static_cast<ProfilingCounters::Counter>(i));
+    }
+
+    for (unsigned int i = 0; i < ProfilingCounters::CountersCount; i++)
+    {
+      CumulativeFile << ";RUNSTEP_" << ProfilingCounters::getCounterName(static_cast<ProfilingCounters::Counter>(i));
+    }
+  }
+
+  CumulativeFile << "\n";
 
   for (const auto& ID : m_OriginalModelSequence)
   {
@@ -133,6 +180,25 @@ SimulationProfiler::~SimulationProfiler()
         getDurationInDecimalSeconds(m_CumulativeModelProfile[ID][openfluid::base::SimulationStatus::RUNSTEP]);
     CumulativeFile << ";" <<
         getDurationInDecimalSeconds(m_CumulativeModelProfile[ID][openfluid::base::SimulationStatus::FINALIZERUN]);
+
+    if (m_CountersEnabled)
+    {
+      ProfilingCounters AllStagesCounters;
+      ProfilingCounters EmptyCounters;
+
+      for (const auto& StageCounters : m_CumulativeModelCounters[ID])
+      {
+        AllStagesCounters.merge(StageCounters.second);
+      }
+
+      CumulativeFile << ";" << m_RunStepCallsCount[ID];
+      writeCounters(CumulativeFile,AllStagesCounters);
+
+      auto ItRunStep = m_CumulativeModelCounters[ID].find(openfluid::base::SimulationStatus::RUNSTEP);
+      writeCounters(CumulativeFile,
+                    ItRunStep != m_CumulativeModelCounters[ID].end() ? (*ItRunStep).second : EmptyCounters);
+    }
+
     CumulativeFile << "\n";
   }
 
@@ -205,6 +271,58 @@ void SimulationProfiler::addDuration(const openfluid::ware::WareID_t& SimID,
 
   m_CumulativeModelProfile[SimID][ProfilePart] = m_CumulativeModelProfile[SimID][ProfilePart] + Duration;
 
+  if (ProfilePart == openfluid::base::SimulationStatus::RUNSTEP)
+  {
+    m_RunStepCallsCount[SimID]++;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationProfiler::addCounters(const openfluid::ware::WareID_t& SimID,
+                                     openfluid::base::SimulationStatus::SimulationStage ProfilePart,
+                                     const ProfilingCounters& Start, const ProfilingCounters& End)
+{
+  m_CumulativeModelCounters[SimID][ProfilePart].accumulate(Start,End);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationProfiler::startMeasure()
+{
+  // counters are read before starting the clock to exclude their reading from the measured duration
+  if (m_CountersEnabled)
+  {
+    m_CountersReader.read(m_MeasureStartCounters);
+  }
+
+  m_MeasureStartTime = std::chrono::high_resolution_clock::now();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationProfiler::stopMeasure(const openfluid::ware::WareID_t& SimID,
+                                     openfluid::base::SimulationStatus::SimulationStage ProfilePart)
+{
+  const auto Duration = std::chrono::duration_cast<TimeResolution_t>(
+    std::chrono::high_resolution_clock::now() - m_MeasureStartTime);
+
+  if (m_CountersEnabled)
+  {
+    m_CountersReader.read(m_MeasureEndCounters);
+    addCounters(SimID,ProfilePart,m_MeasureStartCounters,m_MeasureEndCounters);
+  }
+
+  addDuration(SimID,ProfilePart,Duration);
 }
 
 
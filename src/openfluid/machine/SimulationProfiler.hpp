@@ -47,6 +47,7 @@
 
 #include <openfluid/ware/PluggableSimulator.hpp>
 #include <openfluid/base/SimulationStatus.hpp>
+#include <openfluid/machine/ProfilingCounters.hpp>
 #include <openfluid/dllexport.hpp>
 
 
@@ -73,8 +74,17 @@ class OPENFLUID_API SimulationProfiler
 
     typedef WareIDSequence_t CurrentTimeIndexModelSequence_t;
 
+    typedef std::map<openfluid::base::SimulationStatus::SimulationStage,ProfilingCounters>
+      CumulativeSimulatorCounters_t;
+
+    typedef std::map<openfluid::ware::WareID_t,CumulativeSimulatorCounters_t> CumulativeModelCounters_t;
+
     CumulativeModelProfile_t m_CumulativeModelProfile;
 
+    CumulativeModelCounters_t m_CumulativeModelCounters;
+
+    std::map<openfluid::ware::WareID_t,unsigned long long> m_RunStepCallsCount;
+
     CurrentTimeIndexModelProfile_t m_CurrentTimeIndexModelProfile;
     CurrentTimeIndexModelSequence_t m_CurrentTimeIndexModelSequence;
 
@@ -88,14 +98,33 @@ class OPENFLUID_API SimulationProfiler
 
     std::ofstream m_CurrentProfileFile;
 
+    bool m_CountersEnabled;
+
+    ProfilingCountersReader m_CountersReader;
+
+    ProfilingCounters m_MeasureStartCounters;
+
+    ProfilingCounters m_MeasureEndCounters;
+
+    std::chrono::high_resolution_clock::time_point m_MeasureStartTime;
+
     static double getDurationInDecimalSeconds(const TimeResolution_t& Duration);
 
+    static void writeCounters(std::ostream& OutStream, const ProfilingCounters& Counters);
+
     void flushCurrentProfileToFiles();
 
 
   public:
 
-    SimulationProfiler(const openfluid::base::SimulationStatus* SimStatus, const WareIDSequence_t& OrigModelSequence);
+    /**
+      @param[in] SimStatus the simulation status
+      @param[in] OrigModelSequence the original sequence of simulators in the model
+      @param[in] WithCounters enables the extended profiling mode, measuring resources counters
+                              (heap, peak RSS, page faults, hardware counters when available) in addition to durations
+    */
+    SimulationProfiler(const openfluid::base::SimulationStatus* SimStatus, const WareIDSequence_t& OrigModelSequence,
+                       bool WithCounters = false);
 
     ~SimulationProfiler();
 
@@ -103,6 +132,39 @@ class OPENFLUID_API SimulationProfiler
                      openfluid::base::SimulationStatus::SimulationStage ProfilePart,
                      const TimeResolution_t& Duration);
 
+    /**
+      Adds the difference between the Start and End counters snapshots to the cumulative profile
+    */
+    void addCounters(const openfluid::ware::WareID_t& SimID,
+                     openfluid::base::SimulationStatus::SimulationStage ProfilePart,
+                     const ProfilingCounters& Start, const ProfilingCounters& End);
+
+    /**
+      Starts the measure of a simulator call. Must be followed by a call to stopMeasure()
+    */
+    void startMeasure();
+
+    /**
+      Stops the measure of a simulator call started using startMeasure(),
+      and adds the measured duration and counters to the profile
+    */
+    void stopMeasure(const openfluid::ware::WareID_t& SimID,
+                     openfluid::base::SimulationStatus::SimulationStage ProfilePart);
+
+    bool isCountersEnabled() const
+    {
+      return m_CountersEnabled;
+    }
+
+    /**
+      Returns the counters reader, giving access to the counters backends used in extended profiling mode.
+      Additional backends can be plugged using the ProfilingCountersReader::addBackend() method
+    */
+    ProfilingCountersReader& countersReader()
+    {
+      return m_CountersReader;
+    }
+
 };
 
 
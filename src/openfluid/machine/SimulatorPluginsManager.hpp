@@ -46,6 +46,7 @@
 #include <openfluid/ware/PluggableSimulator.hpp>
 #include <openfluid/ware/SimulatorSignature.hpp>
 #include <openfluid/machine/WarePluginsManager.hpp>
+#include <openfluid/waresdev/SimulatorSignatureSerializer.hpp>
 #include <openfluid/base/Environment.hpp>
 #include <openfluid/fluidx/GeneratorDescriptor.hpp>
 #include <openfluid/utils/SingletonMacros.hpp>
@@ -69,7 +70,9 @@ class OPENFLUID_API SimulatorPluginsManager :
                                                    openfluid::ware::PluggableSimulator,
                                                    openfluid::ware::GetPluggableSimulatorSignatureProc,
                                                    openfluid::ware::GetPluggableSimulatorBodyProc>()
-    { }
+    {
+      setupSignaturesCache<openfluid::waresdev::SimulatorSignatureSerializer>("simulators");
+    }
 
 
     ~SimulatorPluginsManager()
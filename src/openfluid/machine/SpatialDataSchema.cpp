@@ -0,0 +1,663 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SpatialDataSchema.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <thread>
+
+#include <openfluid/machine/SpatialDataSchema.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/core/NullValue.hpp>
+#include <openfluid/core/SymbolsTable.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+namespace {
+
+
+struct UnitsRange
+{
+  const openfluid::core::UnitsClass_t* ClassName;
+
+  openfluid::core::UnitsList_t::iterator Begin;
+
+  openfluid::core::UnitsList_t::iterator End;
+};
+
+
+/**
+  Error detected while processing a range of units, ordered by the declaration order of the faulty data
+*/
+struct RangeError
+{
+  unsigned int Order = std::numeric_limits<unsigned int>::max();
+
+  std::string Message;
+
+  std::string UnitStr;
+
+  void set(unsigned int ErrOrder, const std::string& Msg, const openfluid::core::SpatialUnit& Unit)
+  {
+    if (ErrOrder < Order)
+    {
+      Order = ErrOrder;
+      Message = Msg;
+      UnitStr = Unit.getClass() + "#" + std::to_string(Unit.getID());
+    }
+  }
+
+  bool isSet() const
+  {
+    return !Message.empty();
+  }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+void appendUnitsRanges(std::vector<UnitsRange>& Ranges, const openfluid::core::UnitsClass_t& ClassName,
+                       openfluid::core::UnitsList_t* UnitsList, unsigned int ThreadsCount)
+{
+  const std::size_t UnitsCount = UnitsList->size();
+
+  if (!UnitsCount)
+  {
+    return;
+  }
+
+  const std::size_t RangesCount =
+    std::max(std::size_t(1),std::min(std::size_t(ThreadsCount),UnitsCount/SpatialDataSchema::MinUnitsPerRange));
+  const std::size_t RangeSize = UnitsCount/RangesCount;
+
+  auto Begin = UnitsList->begin();
+
+  for (std::size_t i = 0; i < RangesCount; i++)
+  {
+    auto End = (i == RangesCount-1) ? UnitsList->end() : std::next(Begin,RangeSize);
+    Ranges.push_back({&ClassName,Begin,End});
+    Begin = End;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Runs the given function on each range of units, using up to ThreadsCount threads.
+  The function must not throw exceptions.
+*/
+template<typename FuncT>
+void processUnitsRanges(const std::vector<UnitsRange>& Ranges, unsigned int ThreadsCount, const FuncT& Func)
+{
+  const std::size_t WorkersCount = std::min(std::size_t(ThreadsCount),Ranges.size());
+
+  if (WorkersCount < 2)
+  {
+    for (std::size_t i = 0; i < Ranges.size(); i++)
+    {
+      Func(Ranges[i],i);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> NextRange(0);
+
+  const auto Worker = [&]()
+  {
+    for (std::size_t i = NextRange++; i < Ranges.size(); i = NextRange++)
+    {
+      Func(Ranges[i],i);
+    }
+  };
+
+  std::vector<std::thread> Threads;
+  for (std::size_t i = 0; i < WorkersCount; i++)
+  {
+    Threads.push_back(std::thread(Worker));
+  }
+
+  for (auto& T : Threads)
+  {
+    T.join();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the first error of the given list, by declaration order then by range
+*/
+const RangeError* firstError(const std::vector<RangeError>& Errors)
+{
+  const RangeError* First = nullptr;
+
+  for (const auto& Err : Errors)
+  {
+    if (Err.isSet() && (!First || Err.Order < First->Order))
+    {
+      First = &Err;
+    }
+  }
+
+  return First;
+}
+
+
+}  // namespace
+
+
+// =====================================================================
+// =====================================================================
+
+
+SpatialDataSchema::SpatialDataSchema(openfluid::core::SpatialGraph& Graph, unsigned int ThreadsCount) :
+  m_Graph(Graph), m_ThreadsCount(std::max(1U,ThreadsCount)), m_DeclarationsCount(0),
+  m_IsVariablesApplied(false), m_AppliedRevision(0)
+{
+
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialDataSchema::clear()
+{
+  m_Classes.clear();
+  m_DeclarationsCount = 0;
+  m_IsVariablesApplied = false;
+  m_AppliedRevision = 0;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+SpatialDataSchema::ClassSchema& SpatialDataSchema::existingClassSchema(const openfluid::core::UnitsClass_t& ClassName,
+                                                                       const std::string& Details)
+{
+  if (!m_Graph.isUnitsClassExist(ClassName))
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,Details);
+  }
+
+  return m_Classes[ClassName];
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const SpatialDataSchema::VariableItem* SpatialDataSchema::findVariable(const ClassSchema& Schema,
+                                                                       const openfluid::core::VariableName_t& VarName)
+                                                                       const
+{
+  for (const auto& Item : Schema.Variables)
+  {
+    if (Item.Name == VarName)
+    {
+      return &Item;
+    }
+  }
+
+  return nullptr;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool SpatialDataSchema::isDeclaredAttribute(const std::vector<AttributeItem>& Items,
+                                            const openfluid::core::AttributeName_t& AttrName) const
+{
+  return std::any_of(Items.begin(),Items.end(),[&AttrName](const AttributeItem& Item)
+                                               {
+                                                 return Item.Name == AttrName;
+                                               });
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialDataSchema::declareProducedVariable(const openfluid::core::VariableName_t& VarName,
+                                                const openfluid::core::Value::Type& VarType,
+                                                const openfluid::core::UnitsClass_t& ClassName,
+                                                const std::string& WareID)
+{
+  ClassSchema& Schema = existingClassSchema(ClassName,"Unit class " + ClassName + " does not exist for " +
+                                                      VarName + " variable produced by " + WareID);
+
+  if (findVariable(Schema,VarName))
+  {
+    if (!m_Graph.spatialUnits(ClassName)->list()->empty())
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                VarName + " variable on " + ClassName +
+                                                " produced by " + WareID +
+                                                " cannot be created because it is already created");
+    }
+    return;
+  }
+
+  Schema.Variables.push_back({VarName,openfluid::core::SymbolsTable::intern(VarName),VarType,false,WareID,
+                              m_DeclarationsCount++});
+  m_IsVariablesApplied = false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialDataSchema::declareUpdatedVariable(const openfluid::core::VariableName_t& VarName,
+                                               const openfluid::core::Value::Type& VarType,
+                                               const openfluid::core::UnitsClass_t& ClassName,
+                                               const std::string& WareID)
+{
+  ClassSchema& Schema = existingClassSchema(ClassName,"Unit class " + ClassName + " does not exist for " +
+                                                      VarName + " variable produced by " + WareID);
+
+  if (findVariable(Schema,VarName))
+  {
+    return;
+  }
+
+  Schema.Variables.push_back({VarName,openfluid::core::SymbolsTable::intern(VarName),VarType,true,WareID,
+                              m_DeclarationsCount++});
+  m_IsVariablesApplied = false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialDataSchema::applyVariables(
+  const openfluid::fluidx::RunConfigurationDescriptor::VariablesStorage_t& VarsStorage)
+{
+  struct PreparedItem
+  {
+    const VariableItem* Item;
+
+    const openfluid::fluidx::RunConfigurationDescriptor::VariableStorage* Storage;
+  };
+
+  std::map<const openfluid::core::UnitsClass_t*,std::vector<PreparedItem>> PreparedItems;
+  std::vector<UnitsRange> Ranges;
+
+  // units classes without declared variables are also processed to check their uniformity
+  for (const auto& UnitsClass : *(m_Graph.allSpatialUnitsByClass()))
+  {
+    ClassSchema& Schema = m_Classes[UnitsClass.first];
+    auto& Items = PreparedItems[&UnitsClass.first];
+
+    for (const auto& Item : Schema.Variables)
+    {
+      const auto StorageIt = VarsStorage.find({UnitsClass.first,Item.Name});
+      Items.push_back({&Item,(StorageIt != VarsStorage.end()) ? &StorageIt->second : nullptr});
+    }
+
+    Schema.IsUniform = true;
+    appendUnitsRanges(Ranges,UnitsClass.first,m_Graph.spatialUnits(UnitsClass.first)->list(),m_ThreadsCount);
+  }
+
+  std::vector<RangeError> Errors(Ranges.size());
+  std::vector<char> Uniformities(Ranges.size(),1);
+
+  processUnitsRanges(Ranges,m_ThreadsCount,[&](const UnitsRange& Range, std::size_t Index)
+  {
+    const auto& Items = PreparedItems.at(Range.ClassName);
+
+    for (auto UnitIt = Range.Begin; UnitIt != Range.End; ++UnitIt)
+    {
+      openfluid::core::Variables* Vars = UnitIt->variables();
+
+      for (const auto& Prepared : Items)
+      {
+        if (!Vars->createVariable(Prepared.Item->Symbol,Prepared.Item->Type))
+        {
+          // produced variables must not exist before creation,
+          // updated variables may already exist, possibly with another type
+          if (!Prepared.Item->IsUpdated)
+          {
+            Errors[Index].set(Prepared.Item->Order,
+                              Prepared.Item->Name + " variable on " + *Range.ClassName +
+                              " produced by " + Prepared.Item->WareID +
+                              " cannot be created because it is already created",*UnitIt);
+          }
+          Uniformities[Index] = 0;
+        }
+
+        if (Prepared.Storage)
+        {
+          Vars->setVariableStoragePrecision(Prepared.Item->Symbol,Prepared.Storage->Precision,
+                                            Prepared.Storage->Scale);
+        }
+      }
+
+      if (Vars->getVariablesCount() != Items.size())
+      {
+        Uniformities[Index] = 0;
+      }
+    }
+  });
+
+  if (const RangeError* Err = firstError(Errors))
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,Err->Message);
+  }
+
+  for (std::size_t i = 0; i < Ranges.size(); i++)
+  {
+    if (!Uniformities[i])
+    {
+      m_Classes[*Ranges[i].ClassName].IsUniform = false;
+    }
+  }
+
+  m_AppliedRevision = m_Graph.getRevision();
+  m_IsVariablesApplied = true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool SpatialDataSchema::isUniform(const openfluid::core::UnitsClass_t& ClassName) const
+{
+  if (!m_IsVariablesApplied || m_Graph.getRevision() != m_AppliedRevision)
+  {
+    return false;
+  }
+
+  const auto ClassIt = m_Classes.find(ClassName);
+
+  return (ClassIt != m_Classes.end() && ClassIt->second.IsUniform);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialDataSchema::checkRequiredVariable(const openfluid::core::VariableName_t& VarName,
+                                              const openfluid::core::Value::Type& VarType,
+                                              const openfluid::core::UnitsClass_t& ClassName,
+                                              const std::string& WareID) const
+{
+  if (!m_Graph.isUnitsClassExist(ClassName))
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Unit class " + ClassName + " does not exist for " +
+                                              VarName + " variable required by " + WareID);
+  }
+
+  openfluid::core::UnitsList_t* UnitsList = m_Graph.spatialUnits(ClassName)->list();
+
+  if (UnitsList->empty())
+  {
+    return;
+  }
+
+  const std::string ErrorMsg = VarName + " variable on " + ClassName + " required by " + WareID + " does not exist";
+
+  // all units hold exactly the variables of the schema, no need to visit them
+  if (isUniform(ClassName))
+  {
+    const VariableItem* Item = findVariable(m_Classes.at(ClassName),VarName);
+
+    if (!Item || (VarType != openfluid::core::Value::NONE && Item->Type != VarType))
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,ErrorMsg);
+    }
+    return;
+  }
+
+  const openfluid::core::SymbolID_t Symbol = openfluid::core::SymbolsTable::find(VarName);
+
+  if (Symbol == openfluid::core::SymbolsTable::InvalidSymbol)
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,ErrorMsg);
+  }
+
+  std::vector<UnitsRange> Ranges;
+  appendUnitsRanges(Ranges,ClassName,UnitsList,m_ThreadsCount);
+
+  std::vector<char> Failures(Ranges.size(),0);
+
+  processUnitsRanges(Ranges,m_ThreadsCount,[&](const UnitsRange& Range, std::size_t Index)
+  {
+    for (auto UnitIt = Range.Begin; UnitIt != Range.End && !Failures[Index]; ++UnitIt)
+    {
+      const bool Status = (VarType == openfluid::core::Value::NONE) ?
+                            UnitIt->variables()->isVariableExist(Symbol) :
+                            UnitIt->variables()->isTypedVariableExist(Symbol,VarType);
+      Failures[Index] = !Status;
+    }
+  });
+
+  if (std::find(Failures.begin(),Failures.end(),1) != Failures.end())
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,ErrorMsg);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialDataSchema::declareRequiredAttribute(const openfluid::core::AttributeName_t& AttrName,
+                                                 const openfluid::core::UnitsClass_t& ClassName,
+                                                 const std::string& WareID)
+{
+  ClassSchema& Schema = existingClassSchema(ClassName,"Unit " + ClassName + " class does not exist for " +
+                                                      AttrName + " attribute required by " + WareID);
+
+  // attributes produced by a previous ware will be available on all units
+  if (isDeclaredAttribute(Schema.ProducedAttributes,AttrName))
+  {
+    return;
+  }
+
+  Schema.RequiredAttributes.push_back({AttrName,WareID,m_DeclarationsCount++});
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialDataSchema::declareProducedAttribute(const openfluid::core::AttributeName_t& AttrName,
+                                                 const openfluid::core::UnitsClass_t& ClassName,
+                                                 const std::string& WareID)
+{
+  ClassSchema& Schema = existingClassSchema(ClassName,"Unit class " + ClassName + " does not exist for " +
+                                                      AttrName + " attribute produced by " + WareID);
+
+  if (!isDeclaredAttribute(Schema.ProducedAttributes,AttrName))
+  {
+    Schema.ProducedAttributes.push_back({AttrName,WareID,m_DeclarationsCount++});
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialDataSchema::applyAttributes()
+{
+  struct PreparedItem
+  {
+    const AttributeItem* Item;
+
+    openfluid::core::SymbolID_t Symbol;
+  };
+
+  std::map<const openfluid::core::UnitsClass_t*,std::vector<PreparedItem>> PreparedItems;
+  std::vector<UnitsRange> Ranges;
+
+  for (const auto& Schema : m_Classes)
+  {
+    if (Schema.second.RequiredAttributes.empty() || !m_Graph.isUnitsClassExist(Schema.first))
+    {
+      continue;
+    }
+
+    auto& Items = PreparedItems[&Schema.first];
+    for (const auto& Item : Schema.second.RequiredAttributes)
+    {
+      Items.push_back({&Item,openfluid::core::SymbolsTable::find(Item.Name)});
+    }
+
+    appendUnitsRanges(Ranges,Schema.first,m_Graph.spatialUnits(Schema.first)->list(),m_ThreadsCount);
+  }
+
+
+  // required attributes are only read, thus verified concurrently
+
+  std::vector<RangeError> Errors(Ranges.size());
+
+  processUnitsRanges(Ranges,m_ThreadsCount,[&](const UnitsRange& Range, std::size_t Index)
+  {
+    const auto& Items = PreparedItems.at(Range.ClassName);
+
+    for (auto UnitIt = Range.Begin; UnitIt != Range.End; ++UnitIt)
+    {
+      for (const auto& Prepared : Items)
+      {
+        if (Prepared.Item->Order < Errors[Index].Order && !UnitIt->attributes()->isAttributeExist(Prepared.Symbol))
+        {
+          Errors[Index].set(Prepared.Item->Order,
+                            Prepared.Item->Name + " attribute on " + *Range.ClassName +
+                            " required by " + Prepared.Item->WareID + " is not available",*UnitIt);
+        }
+      }
+    }
+  });
+
+  if (const RangeError* Err = firstError(Errors))
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,Err->Message);
+  }
+
+
+  // produced attributes are written in the attributes tables shared by the units of a class,
+  // thus created sequentially
+
+  for (const auto& Schema : m_Classes)
+  {
+    if (Schema.second.ProducedAttributes.empty() || !m_Graph.isUnitsClassExist(Schema.first))
+    {
+      continue;
+    }
+
+    for (auto& Unit : *(m_Graph.spatialUnits(Schema.first)->list()))
+    {
+      for (const auto& Item : Schema.second.ProducedAttributes)
+      {
+        Unit.attributes()->setValue(Item.Name,openfluid::core::NullValue());
+      }
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialDataSchema::checkVariablesValuesCount(unsigned int Count) const
+{
+  std::vector<UnitsRange> Ranges;
+
+  for (const auto& UnitsClass : *(m_Graph.allSpatialUnitsByClass()))
+  {
+    appendUnitsRanges(Ranges,UnitsClass.first,m_Graph.spatialUnits(UnitsClass.first)->list(),m_ThreadsCount);
+  }
+
+  std::vector<RangeError> Errors(Ranges.size());
+
+  processUnitsRanges(Ranges,m_ThreadsCount,[&](const UnitsRange& Range, std::size_t Index)
+  {
+    openfluid::core::VariableName_t ErrorVarName;
+
+    for (auto UnitIt = Range.Begin; UnitIt != Range.End && !Errors[Index].isSet(); ++UnitIt)
+    {
+      if (!UnitIt->variables()->checkAllVariablesCount(Count,ErrorVarName))
+      {
+        Errors[Index].set(0,"Production error for variable " + ErrorVarName,*UnitIt);
+      }
+    }
+  });
+
+  // ranges are ordered as units, the first error found in the ranges order is reported
+  for (const auto& Err : Errors)
+  {
+    if (Err.isSet())
+    {
+      openfluid::base::ExceptionContext Ctxt;
+      Ctxt.addCodeLocation(OPENFLUID_CODE_LOCATION);
+      Ctxt.addSpatialUnit(Err.UnitStr);
+
+      throw openfluid::base::FrameworkException(Ctxt,Err.Message + " on " + Err.UnitStr);
+    }
+  }
+}
+
+
+} }  // namespaces
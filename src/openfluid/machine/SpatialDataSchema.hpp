@@ -0,0 +1,223 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SpatialDataSchema.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_MACHINE_SPATIALDATASCHEMA_HPP__
+#define __OPENFLUID_MACHINE_SPATIALDATASCHEMA_HPP__
+
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/fluidx/RunConfigurationDescriptor.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+/**
+  Schema of the spatial data handled by the wares of a simulation on each units class:
+  variables produced or updated, attributes required or produced.
+  Spatial data are declared once per units class, then applied in bulk to the units of all classes,
+  processing ranges of units concurrently. Once applied, and as long as the spatial graph is not changed,
+  required variables are checked on the schema only without visiting the units again.
+*/
+class OPENFLUID_API SpatialDataSchema
+{
+  private:
+
+    struct VariableItem
+    {
+      openfluid::core::VariableName_t Name;
+
+      openfluid::core::SymbolID_t Symbol;
+
+      openfluid::core::Value::Type Type;
+
+      bool IsUpdated;
+
+      std::string WareID;
+
+      unsigned int Order;
+    };
+
+    struct AttributeItem
+    {
+      openfluid::core::AttributeName_t Name;
+
+      std::string WareID;
+
+      unsigned int Order;
+    };
+
+    struct ClassSchema
+    {
+      std::vector<VariableItem> Variables;
+
+      std::vector<AttributeItem> RequiredAttributes;
+
+      std::vector<AttributeItem> ProducedAttributes;
+
+      /**
+        True if the variables of all units of the class exactly match the schema
+      */
+      bool IsUniform = false;
+    };
+
+    openfluid::core::SpatialGraph& m_Graph;
+
+    unsigned int m_ThreadsCount;
+
+    std::map<openfluid::core::UnitsClass_t,ClassSchema> m_Classes;
+
+    unsigned int m_DeclarationsCount;
+
+    bool m_IsVariablesApplied;
+
+    std::uint64_t m_AppliedRevision;
+
+    ClassSchema& existingClassSchema(const openfluid::core::UnitsClass_t& ClassName, const std::string& Details);
+
+    const VariableItem* findVariable(const ClassSchema& Schema, const openfluid::core::VariableName_t& VarName) const;
+
+    bool isDeclaredAttribute(const std::vector<AttributeItem>& Items,
+                             const openfluid::core::AttributeName_t& AttrName) const;
+
+
+  public:
+
+    /**
+      Minimum number of units in each range of units processed concurrently
+    */
+    static constexpr std::size_t MinUnitsPerRange = 2048;
+
+    SpatialDataSchema() = delete;
+
+    /**
+      @param[in] Graph the spatial graph the schema applies to
+      @param[in] ThreadsCount the maximum number of threads used to process units
+    */
+    SpatialDataSchema(openfluid::core::SpatialGraph& Graph, unsigned int ThreadsCount);
+
+    /**
+      Clears all declarations
+    */
+    void clear();
+
+    /**
+      Declares a variable produced by a ware on a units class
+      @throw openfluid::base::FrameworkException if the class does not exist
+      or if the variable is already declared on a non-empty class
+    */
+    void declareProducedVariable(const openfluid::core::VariableName_t& VarName,
+                                 const openfluid::core::Value::Type& VarType,
+                                 const openfluid::core::UnitsClass_t& ClassName,
+                                 const std::string& WareID);
+
+    /**
+      Declares a variable updated by a ware on a units class, which is created if not already declared
+      @throw openfluid::base::FrameworkException if the class does not exist
+    */
+    void declareUpdatedVariable(const openfluid::core::VariableName_t& VarName,
+                                const openfluid::core::Value::Type& VarType,
+                                const openfluid::core::UnitsClass_t& ClassName,
+                                const std::string& WareID);
+
+    /**
+      Creates the declared variables on all units, setting their storage precision from the given configuration
+      @param[in] VarsStorage the storage precisions of variables
+      @throw openfluid::base::FrameworkException if a produced variable already exists on a unit
+    */
+    void applyVariables(const openfluid::fluidx::RunConfigurationDescriptor::VariablesStorage_t& VarsStorage);
+
+    /**
+      Checks that a variable required by a ware exists on all units of a class, with the given type if not NONE.
+      The check is made on the schema if the variables have been applied and the spatial graph not changed since,
+      on each unit otherwise.
+      @throw openfluid::base::FrameworkException if the variable does not exist
+    */
+    void checkRequiredVariable(const openfluid::core::VariableName_t& VarName,
+                               const openfluid::core::Value::Type& VarType,
+                               const openfluid::core::UnitsClass_t& ClassName,
+                               const std::string& WareID) const;
+
+    /**
+      Declares an attribute required by a ware on a units class.
+      Attributes already declared as produced are not verified on units.
+      @throw openfluid::base::FrameworkException if the class does not exist
+    */
+    void declareRequiredAttribute(const openfluid::core::AttributeName_t& AttrName,
+                                  const openfluid::core::UnitsClass_t& ClassName,
+                                  const std::string& WareID);
+
+    /**
+      Declares an attribute produced by a ware on a units class
+      @throw openfluid::base::FrameworkException if the class does not exist
+    */
+    void declareProducedAttribute(const openfluid::core::AttributeName_t& AttrName,
+                                  const openfluid::core::UnitsClass_t& ClassName,
+                                  const std::string& WareID);
+
+    /**
+      Verifies the required attributes on all units, then creates the produced attributes with null values
+      @throw openfluid::base::FrameworkException if a required attribute is missing on a unit
+    */
+    void applyAttributes();
+
+    /**
+      Checks that all variables of all units contain the given number of values
+      @param[in] Count the expected number of values
+      @throw openfluid::base::FrameworkException if a variable of a unit does not contain the expected count
+    */
+    void checkVariablesValuesCount(unsigned int Count) const;
+
+    /**
+      Returns true if the variables of all units of the given class exactly match the schema,
+      and if the spatial graph has not changed since they were applied
+    */
+    bool isUniform(const openfluid::core::UnitsClass_t& ClassName) const;
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_SPATIALDATASCHEMA_HPP__ */
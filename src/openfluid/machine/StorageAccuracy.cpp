@@ -0,0 +1,162 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+
+
+/**
+  @file StorageAccuracy.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+#include <openfluid/machine/StorageAccuracy.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+void StorageAccuracy::selectVariables(const openfluid::core::SpatialGraph& SGraph, ResultsStore& Store)
+{
+  for (const auto& ClassUnits : *SGraph.allSpatialUnitsByClass())
+  {
+    std::set<openfluid::core::VariableName_t> Selected;
+
+    for (const auto& Unit : *ClassUnits.second.list())
+    {
+      for (const auto& VarName : Unit.variables()->getVariablesNames())
+      {
+        if (Selected.count(VarName))
+        {
+          continue;
+        }
+
+        const openfluid::core::Value::Type VarType = Unit.variables()->getVariableType(VarName);
+
+        if (VarType == openfluid::core::Value::DOUBLE || VarType == openfluid::core::Value::INTEGER ||
+            VarType == openfluid::core::Value::BOOLEAN || VarType == openfluid::core::Value::NONE)
+        {
+          Selected.insert(VarName);
+          Store.addVariable(ClassUnits.first,VarName);
+        }
+      }
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<StorageAccuracy::VariableDifference> StorageAccuracy::compare(
+  const ResultsStore& Stored, const ResultsStore& FullPrecision,
+  const openfluid::fluidx::RunConfigurationDescriptor::VariablesStorage_t& VarsStorage)
+{
+  std::vector<VariableDifference> Differences;
+
+  for (const auto& Key : FullPrecision.getVariables())
+  {
+    const ResultsStore::Table* StoredTable = Stored.table(Key.first,Key.second);
+    const ResultsStore::Table* FullTable = FullPrecision.table(Key.first,Key.second);
+
+    if (!StoredTable)
+    {
+      continue;
+    }
+
+    VariableDifference Diff;
+    Diff.UnitsClass = Key.first;
+    Diff.VarName = Key.second;
+
+    const auto StorageIt = VarsStorage.find(Key);
+    Diff.IsReduced = (StorageIt != VarsStorage.end() &&
+                      StorageIt->second.Precision != openfluid::core::ValuesBuffer::StoragePrecision::FULL);
+
+    const auto& StoredIndexes = StoredTable->indexes();
+    const auto& FullIndexes = FullTable->indexes();
+
+    for (const auto& ID : FullTable->unitsIDs())
+    {
+      const std::vector<double>* StoredColumn = StoredTable->column(ID);
+      const std::vector<double>* FullColumn = FullTable->column(ID);
+
+      if (!StoredColumn)
+      {
+        continue;
+      }
+
+      // rows are sorted by time indexes in both tables
+      std::size_t s = 0;
+      std::size_t f = 0;
+
+      while (s < StoredIndexes.size() && f < FullIndexes.size())
+      {
+        if (StoredIndexes[s] < FullIndexes[f])
+        {
+          s++;
+        }
+        else if (FullIndexes[f] < StoredIndexes[s])
+        {
+          f++;
+        }
+        else
+        {
+          const double StoredVal = (*StoredColumn)[s];
+          const double FullVal = (*FullColumn)[f];
+
+          if (!std::isnan(StoredVal) && !std::isnan(FullVal))
+          {
+            const double AbsDiff = std::fabs(StoredVal-FullVal);
+
+            Diff.MaxAbsDifference = std::max(Diff.MaxAbsDifference,AbsDiff);
+            if (FullVal != 0.0)
+            {
+              Diff.MaxRelDifference = std::max(Diff.MaxRelDifference,AbsDiff/std::fabs(FullVal));
+            }
+            Diff.ComparedCount++;
+          }
+
+          s++;
+          f++;
+        }
+      }
+    }
+
+    Differences.push_back(Diff);
+  }
+
+  return Differences;
+}
+
+
+} }  // namespaces
@@ -0,0 +1,118 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+
+
+/**
+  @file StorageAccuracy.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_MACHINE_STORAGEACCURACY_HPP__
+#define __OPENFLUID_MACHINE_STORAGEACCURACY_HPP__
+
+
+#include <vector>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/fluidx/RunConfigurationDescriptor.hpp>
+#include <openfluid/machine/ResultsStore.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+/**
+  Accuracy check of the reduced storage precisions of variables, comparing the results of a run
+  with the results of the same run replayed at full precision.
+  Both runs store their results in a results store, the variables to store are selected using selectVariables()
+  and the stores are compared using compare().
+*/
+class OPENFLUID_API StorageAccuracy
+{
+  public:
+
+    /**
+      Differences of the values of a variable between a run and its replay at full precision
+    */
+    struct VariableDifference
+    {
+      openfluid::core::UnitsClass_t UnitsClass;
+
+      openfluid::core::VariableName_t VarName;
+
+      /**
+        True if the variable is stored with a reduced precision in the compared run
+      */
+      bool IsReduced = false;
+
+      /**
+        Number of values compared, missing values excluded
+      */
+      std::size_t ComparedCount = 0;
+
+      double MaxAbsDifference = 0.0;
+
+      /**
+        Maximum difference relative to the full precision value, non-zero full precision values only
+      */
+      double MaxRelDifference = 0.0;
+    };
+
+
+    StorageAccuracy() = delete;
+
+    /**
+      Selects in the given results store the numeric variables (double, integer, boolean or untyped)
+      existing on the units of the given spatial graph
+      @param[in] SGraph the spatial graph, with its variables created
+      @param[in,out] Store the results store
+    */
+    static void selectVariables(const openfluid::core::SpatialGraph& SGraph, ResultsStore& Store);
+
+    /**
+      Compares the values stored by a run with the values stored by its replay at full precision.
+      Values are compared for the same units at the same time indexes, missing values are ignored.
+      @param[in] Stored the results of the run
+      @param[in] FullPrecision the results of the replay at full precision
+      @param[in] VarsStorage the storage precisions of variables used by the run
+      @return the differences for each variable stored in both results stores
+    */
+    static std::vector<VariableDifference> compare(
+      const ResultsStore& Stored, const ResultsStore& FullPrecision,
+      const openfluid::fluidx::RunConfigurationDescriptor::VariablesStorage_t& VarsStorage);
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_STORAGEACCURACY_HPP__ */
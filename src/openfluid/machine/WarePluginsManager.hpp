@@ -49,6 +49,7 @@
 
 #include <openfluid/machine/DynamicLib.hpp>
 #include <openfluid/machine/WareContainer.hpp>
+#include <openfluid/machine/WareSignaturesCache.hpp>
 #include <openfluid/base/Environment.hpp>
 #include <openfluid/ware/PluggableWare.hpp>
 #include <openfluid/tools/Filesystem.hpp>
@@ -127,6 +128,14 @@ class OPENFLUID_API WarePluginsManager
       WareContainer<SignatureType> Container = createContainer();
       std::string PluginFullPath = getPluginFullPath(Filename);
 
+      // cached signatures are only used with strict ABI check, as they were verified this way
+      const bool UseCache = (StrictABICheck && m_SignaturesCache);
+
+      if (!PluginFullPath.empty() && UseCache && m_SignaturesCache->fetch(PluginFullPath,Container))
+      {
+        return Container;
+      }
+
       if (!PluginFullPath.empty())
       {
         auto& PlugLib = loadPluginLibrary(PluginFullPath);
@@ -202,6 +211,11 @@ class OPENFLUID_API WarePluginsManager
           }
 
           Container.validate();
+
+          if (UseCache)
+          {
+            m_SignaturesCache->store(Container);
+          }
         }
         else
         {
@@ -255,6 +269,12 @@ class OPENFLUID_API WarePluginsManager
 
     std::map<std::string,std::unique_ptr<DynamicLib>> m_LoadedPluginsLibraries;
 
+    /**
+      Optional persistent cache of signatures, avoiding the loading of plugins only for reading their signatures.
+      It is not used if not set by the inheriting class.
+    */
+    std::unique_ptr<WareSignaturesCache<SignatureType>> m_SignaturesCache;
+
     /**
       Default constructor
     */
@@ -268,6 +288,31 @@ class OPENFLUID_API WarePluginsManager
     // =====================================================================
 
 
+    /**
+      Sets up the persistent signatures cache, stored in the user data directory.
+      The cache is not set up if the user data directory does not exist, to avoid its creation as a side effect.
+      @tparam SerializerType class of the serializer for signatures
+      @param[in] CacheName the name of the cache, used to build the cache file name
+    */
+    template<class SerializerType>
+    void setupSignaturesCache(const std::string& CacheName)
+    {
+      if (openfluid::tools::FilesystemPath(openfluid::base::Environment::getUserDataDir()).isDirectory())
+      {
+        m_SignaturesCache = std::make_unique<WareSignaturesCache<SignatureType>>(
+          openfluid::base::Environment::getUserDataFullPath(
+            openfluid::tools::Filesystem::joinPath({openfluid::config::WARES_CACHE_PATH,
+                                                    CacheName+"-signatures.json"})),
+          std::make_unique<SerializerType>()
+        );
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
   public:
 
     virtual ~WarePluginsManager()
@@ -321,7 +366,9 @@ class OPENFLUID_API WarePluginsManager
     {
       try 
       {
-        return buildWareContainerFromID(ID);
+        auto Container = buildWareContainerFromID(ID);
+        saveSignaturesCache();
+        return Container;
       }
       catch (openfluid::base::FrameworkException&)
       {
@@ -379,6 +426,8 @@ class OPENFLUID_API WarePluginsManager
         }
       }
 
+      saveSignaturesCache();
+
       return Containers;
     }
 
@@ -387,6 +436,69 @@ class OPENFLUID_API WarePluginsManager
     // =====================================================================
 
 
+    /**
+      Returns true if the signatures cache is available and enabled
+    */
+    bool isSignaturesCacheEnabled() const
+    {
+      return (m_SignaturesCache && m_SignaturesCache->isEnabled());
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Enables or disables the signatures cache, if available
+      @param[in] Enabled set to true to enable
+    */
+    void setSignaturesCacheEnabled(bool Enabled)
+    {
+      if (m_SignaturesCache)
+      {
+        m_SignaturesCache->setEnabled(Enabled);
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Writes the signatures cache to disk if it has been modified
+    */
+    void saveSignaturesCache()
+    {
+      if (m_SignaturesCache)
+      {
+        m_SignaturesCache->save();
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Clears the signatures cache, forcing the loading of all plugins at next discovery
+    */
+    void clearSignaturesCache()
+    {
+      if (m_SignaturesCache)
+      {
+        m_SignaturesCache->clear();
+        m_SignaturesCache->save();
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
     /**
       Loads only the body of a ware if the signature is already loaded
       @param[in] Container The ware container which already includes the signature
@@ -0,0 +1,482 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file WareSignaturesCache.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+ */
+
+
+#ifndef __OPENFLUID_MACHINE_WARESIGNATURESCACHE_HPP__
+#define __OPENFLUID_MACHINE_WARESIGNATURESCACHE_HPP__
+
+
+#include <map>
+#include <string>
+#include <memory>
+#include <fstream>
+#include <filesystem>
+
+#include <openfluid/machine/WareContainer.hpp>
+#include <openfluid/waresdev/WareSignatureSerializer.hpp>
+#include <openfluid/tools/Filesystem.hpp>
+#include <openfluid/tools/FilesystemPath.hpp>
+#include <openfluid/thirdparty/JSON.hpp>
+#include <openfluid/dllexport.hpp>
+#include <openfluid/config.hpp>
+#include <openfluid/global.hpp>
+
+#if defined(OPENFLUID_OS_WINDOWS)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+
+namespace openfluid { namespace machine {
+
+
+/**
+  Persistent cache of wares signatures read from plugins, stored as a JSON file.
+  Entries are indexed by plugin path and are valid as long as the size and the modification time
+  of the plugin file are unchanged. The whole cache is invalidated if the OpenFLUID version changes.
+  This avoids loading all plugins libraries for reading their signatures.
+  Only valid signatures are cached, since plugins loading failures may depend on the environment
+  (missing dependencies, libraries search paths, ...) and not only on the plugin file.
+  @tparam SignatureType class defining the signature type for the ware category
+*/
+template<class SignatureType>
+class OPENFLUID_API WareSignaturesCache
+{
+  private:
+
+    struct CacheEntry
+    {
+      unsigned long long Size = 0;
+
+      long long ModTime = 0;
+
+      std::string Message;
+
+      std::string LinkUID;
+
+      openfluid::thirdparty::json Signature;
+    };
+
+    std::string m_FilePath;
+
+    std::unique_ptr<openfluid::waresdev::WareSignatureSerializer<SignatureType>> m_Serializer;
+
+    std::map<std::string,CacheEntry> m_Entries;
+
+    bool m_Enabled = true;
+
+    bool m_Loaded = false;
+
+    bool m_Modified = false;
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    static bool getFileStamp(const std::string& Path, unsigned long long& Size, long long& ModTime)
+    {
+      std::error_code ErrCode;
+
+      Size = std::filesystem::file_size(Path,ErrCode);
+      if (ErrCode)
+      {
+        return false;
+      }
+
+      auto WriteTime = std::filesystem::last_write_time(Path,ErrCode);
+      if (ErrCode)
+      {
+        return false;
+      }
+
+      ModTime = std::chrono::duration_cast<std::chrono::nanoseconds>(WriteTime.time_since_epoch()).count();
+
+      return true;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    static openfluid::thirdparty::json buildInfoToJSON(const openfluid::ware::SignatureBuildInfo& BuildInfo)
+    {
+      openfluid::thirdparty::json Json = openfluid::thirdparty::json::object();
+
+      Json["sdk_version"] = BuildInfo.SDKVersion;
+      Json["build_type"] = BuildInfo.BuildType;
+      Json["compiler_id"] = BuildInfo.CompilerID;
+      Json["compiler_version"] = BuildInfo.CompilerVersion;
+      Json["compilation_flags"] = BuildInfo.CompilationFlags;
+
+      return Json;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    static openfluid::ware::SignatureBuildInfo buildInfoFromJSON(const openfluid::thirdparty::json& Json)
+    {
+      openfluid::ware::SignatureBuildInfo BuildInfo;
+
+      BuildInfo.SDKVersion = Json.value("sdk_version","");
+      BuildInfo.BuildType = Json.value("build_type","");
+      BuildInfo.CompilerID = Json.value("compiler_id","");
+      BuildInfo.CompilerVersion = Json.value("compiler_version","");
+      BuildInfo.CompilationFlags = Json.value("compilation_flags","");
+
+      return BuildInfo;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void load()
+    {
+      m_Loaded = true;
+      m_Entries.clear();
+
+      std::ifstream InFile(m_FilePath,std::ifstream::in);
+
+      if (!InFile.is_open())
+      {
+        return;
+      }
+
+      try
+      {
+        auto Json = openfluid::thirdparty::json::parse(InFile);
+
+        if (Json.value("openfluid_version","") != openfluid::config::VERSION_FULL)
+        {
+          m_Modified = true;
+          return;
+        }
+
+        const auto& WaresObj = Json.at("wares");
+
+        for (auto It = WaresObj.begin(); It != WaresObj.end(); ++It)
+        {
+          CacheEntry Entry;
+          Entry.Size = It.value().at("size").template get<unsigned long long>();
+          Entry.ModTime = It.value().at("mtime").template get<long long>();
+          Entry.Message = It.value().value("message","");
+          Entry.LinkUID = It.value().value("linkuid","");
+          Entry.Signature = It.value().value("signature",openfluid::thirdparty::json());
+          m_Entries[It.key()] = Entry;
+        }
+      }
+      catch (openfluid::thirdparty::json::exception&)
+      {
+        // corrupted cache file, will be rebuilt
+        m_Entries.clear();
+        m_Modified = true;
+      }
+    }
+
+
+  public:
+
+    /**
+      @param[in] FilePath the path of the cache file
+      @param[in] Serializer the serializer used for signatures, owned by the cache
+    */
+    WareSignaturesCache(const std::string& FilePath,
+                        std::unique_ptr<openfluid::waresdev::WareSignatureSerializer<SignatureType>> Serializer) :
+      m_FilePath(FilePath), m_Serializer(std::move(Serializer))
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    ~WareSignaturesCache()
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    std::string getFilePath() const
+    {
+      return m_FilePath;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool isEnabled() const
+    {
+      return m_Enabled;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void setEnabled(bool Enabled)
+    {
+      m_Enabled = Enabled;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Fills the given container from the cache if the plugin file has not changed since it was cached
+      @param[in] PluginPath the full path of the plugin file
+      @param[out] Container the container to fill, which must be empty
+      @return true if the container has been filled from the cache, false otherwise
+    */
+    bool fetch(const std::string& PluginPath, WareContainer<SignatureType>& Container)
+    {
+      if (!m_Enabled)
+      {
+        return false;
+      }
+
+      if (!m_Loaded)
+      {
+        load();
+      }
+
+      auto It = m_Entries.find(PluginPath);
+
+      if (It == m_Entries.end())
+      {
+        return false;
+      }
+
+      unsigned long long Size;
+      long long ModTime;
+
+      // entries without signature may come from cache files written by previous versions
+      if (It->second.Signature.is_null() ||
+          !getFileStamp(PluginPath,Size,ModTime) || Size != It->second.Size || ModTime != It->second.ModTime)
+      {
+        m_Entries.erase(It);
+        m_Modified = true;
+        return false;
+      }
+
+      try
+      {
+        auto Signature = std::make_unique<SignatureType>(m_Serializer->fromJSON(It->second.Signature));
+        Signature->BuildInfo = buildInfoFromJSON(It->second.Signature.value("build_info",
+                                                                            openfluid::thirdparty::json::object()));
+
+        Container.setPath(PluginPath);
+        Container.setMessage(It->second.Message);
+        if (!It->second.LinkUID.empty())
+        {
+          Container.setLinkUID(It->second.LinkUID);
+        }
+        Container.setSignature(Signature.release());
+        Container.validate();
+      }
+      catch (std::exception&)
+      {
+        // unusable entry, the plugin will be loaded
+        m_Entries.erase(It);
+        m_Modified = true;
+        return false;
+      }
+
+      return true;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Stores the given container in the cache.
+      Containers without signature are not stored and their previous entry is removed,
+      so that the plugin is loaded again at next discovery.
+      @param[in] Container the container to store, built from a loaded plugin
+    */
+    void store(const WareContainer<SignatureType>& Container)
+    {
+      if (!m_Enabled || !Container.isValid())
+      {
+        return;
+      }
+
+      if (!m_Loaded)
+      {
+        load();
+      }
+
+      if (!Container.hasSignature())
+      {
+        if (m_Entries.erase(Container.getPath()))
+        {
+          m_Modified = true;
+        }
+        return;
+      }
+
+      CacheEntry Entry;
+
+      if (!getFileStamp(Container.getPath(),Entry.Size,Entry.ModTime))
+      {
+        return;
+      }
+
+      Entry.Message = Container.getMessage();
+      Entry.LinkUID = Container.getLinkUID();
+
+      Entry.Signature = m_Serializer->toJSON(*Container.signature());
+      Entry.Signature["build_info"] = buildInfoToJSON(Container.signature()->BuildInfo);
+
+      m_Entries[Container.getPath()] = Entry;
+      m_Modified = true;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Writes the cache to its file if it has been modified.
+      Failures are silently ignored since the cache is only an optimization.
+    */
+    void save()
+    {
+      if (!m_Enabled || !m_Modified)
+      {
+        return;
+      }
+
+      openfluid::thirdparty::json Json = openfluid::thirdparty::json::object();
+      Json["openfluid_version"] = openfluid::config::VERSION_FULL;
+      Json["wares"] = openfluid::thirdparty::json::object();
+
+      for (const auto& E : m_Entries)
+      {
+        openfluid::thirdparty::json EntryObj = openfluid::thirdparty::json::object();
+        EntryObj["size"] = E.second.Size;
+        EntryObj["mtime"] = E.second.ModTime;
+        EntryObj["message"] = E.second.Message;
+        EntryObj["linkuid"] = E.second.LinkUID;
+        EntryObj["signature"] = E.second.Signature;
+        Json["wares"][E.first] = EntryObj;
+      }
+
+      // written to a temporary file with a unique name (process ID and random part) in the same directory
+      // then renamed, so that concurrent runs never write the same file and the cache file is replaced as a whole
+#if defined(OPENFLUID_OS_WINDOWS)
+      const std::string PID = std::to_string(_getpid());
+#else
+      const std::string PID = std::to_string(getpid());
+#endif
+
+      const openfluid::tools::FilesystemPath CachePath(m_FilePath);
+      const std::string TmpPath =
+        openfluid::tools::Filesystem::makeUniqueFile(CachePath.dirname(),CachePath.filename()+"."+PID+".tmp");
+
+      if (TmpPath.empty())
+      {
+        return;
+      }
+
+      bool Written = false;
+      {
+        std::ofstream OutFile(TmpPath,std::ofstream::out | std::ofstream::trunc);
+        if (OutFile.is_open())
+        {
+          OutFile << Json.dump();
+          OutFile.close();
+          Written = !OutFile.fail();
+        }
+      }
+
+      std::error_code ErrCode;
+
+      if (Written)
+      {
+        std::filesystem::rename(TmpPath,m_FilePath,ErrCode);
+      }
+
+      if (Written && !ErrCode)
+      {
+        m_Modified = false;
+      }
+      else
+      {
+        std::filesystem::remove(TmpPath,ErrCode);
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Clears the cache content. The cache file will be rewritten on next save
+    */
+    void clear()
+    {
+      m_Entries.clear();
+      m_Loaded = true;
+      m_Modified = true;
+    }
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_WARESIGNATURESCACHE_HPP__ */
@@ -0,0 +1,367 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file DomainDecomposition_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_DomainDecomposition
+
+
+#include <csignal>
+#include <map>
+#include <stdexcept>
+
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/machine/DomainDecomposition.hpp>
+#include <openfluid/machine/Factory.hpp>
+#include <openfluid/machine/SimulationBlob.hpp>
+#include <openfluid/core/ValuesBufferProperties.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+/*
+  Tree of units: TU#1,TU#2 -> TU#3 ; TU#4,TU#5 -> TU#6 ; TU#3,TU#6 -> TU#7 -> TU#8 -> TU#9
+*/
+openfluid::fluidx::SpatialDomainDescriptor buildDomain()
+{
+  const std::map<openfluid::core::UnitID_t,std::pair<openfluid::core::PcsOrd_t,openfluid::core::UnitID_t>> Units =
+  {
+    {1,{1,3}}, {2,{1,3}}, {3,{2,7}}, {4,{1,6}}, {5,{1,6}}, {6,{2,7}}, {7,{3,8}}, {8,{4,9}}, {9,{5,0}}
+  };
+
+  openfluid::fluidx::SpatialDomainDescriptor Domain;
+
+  for (const auto& Unit : Units)
+  {
+    openfluid::fluidx::SpatialUnitDescriptor UnitDesc;
+    UnitDesc.setUnitsClass("TU");
+    UnitDesc.setID(Unit.first);
+    UnitDesc.setProcessOrder(Unit.second.first);
+    if (Unit.second.second)
+    {
+      UnitDesc.toSpatialUnits().push_back({"TU",Unit.second.second});
+    }
+    UnitDesc.attributes()["coeff"] = std::to_string(Unit.first*0.5);
+
+    Domain.addUnit(UnitDesc,false);
+  }
+
+  return Domain;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/*
+  Computed value of a unit, using the values of the upstream units at the current time index
+  and of the downstream units at the previous time index
+*/
+double computeValue(const openfluid::core::SpatialUnit* Unit, openfluid::core::TimeIndex_t Index,
+                    openfluid::core::Duration_t DeltaT)
+{
+  double Val = Unit->attributes()->value("coeff")->asDoubleValue().get();
+
+  if (const auto* FromUnits = Unit->fromSpatialUnits("TU"))
+  {
+    for (const auto* FromUnit : *FromUnits)
+    {
+      Val += FromUnit->variables()->value("var.water",Index)->asDoubleValue().get();
+    }
+  }
+
+  if (const auto* ToUnits = Unit->toSpatialUnits("TU"))
+  {
+    for (const auto* ToUnit : *ToUnits)
+    {
+      Val += 0.5*ToUnit->variables()->value("var.water",Index-DeltaT)->asDoubleValue().get();
+    }
+  }
+
+  return Val;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/*
+  Runs a simulation of the given spatial graph, with values exchanged with other parts if a halo exchange is given.
+  The values of the last time index are returned
+*/
+std::map<openfluid::core::UnitID_t,double> runSimulation(openfluid::core::SpatialGraph& Graph,
+                                                         openfluid::machine::HaloExchange* Exchange)
+{
+  const openfluid::core::Duration_t DeltaT = 60;
+  const openfluid::core::TimeIndex_t Duration = 3600;
+
+  for (auto* Unit : *Graph.allSpatialUnits())
+  {
+    Unit->variables()->createVariable("var.water",openfluid::core::Value::DOUBLE);
+    Unit->variables()->createVariable("var.upcount",openfluid::core::Value::INTEGER);
+    Unit->variables()->createVariable("var.vector",openfluid::core::Value::VECTOR);
+  }
+
+  if (Exchange)
+  {
+    Exchange->open();
+  }
+
+  for (auto* Unit : *Graph.allSpatialUnits())
+  {
+    Unit->variables()->appendValue("var.water",0,openfluid::core::DoubleValue(Unit->getID()));
+    Unit->variables()->appendValue("var.upcount",0,openfluid::core::IntegerValue(0));
+  }
+
+  if (Exchange)
+  {
+    Exchange->exportValues(0);
+  }
+
+  for (openfluid::core::TimeIndex_t Index = DeltaT; Index <= Duration; Index += DeltaT)
+  {
+    if (Exchange)
+    {
+      Exchange->importValues(Index);
+    }
+
+    for (auto* Unit : *Graph.allSpatialUnits())
+    {
+      Unit->variables()->appendValue("var.water",Index,openfluid::core::DoubleValue(computeValue(Unit,Index,DeltaT)));
+
+      long UpCount = 0;
+      if (const auto* FromUnits = Unit->fromSpatialUnits("TU"))
+      {
+        for (const auto* FromUnit : *FromUnits)
+        {
+          UpCount += 1+FromUnit->variables()->value("var.upcount",Index-DeltaT)->asIntegerValue().get();
+        }
+      }
+      Unit->variables()->appendValue("var.upcount",Index,openfluid::core::IntegerValue(UpCount));
+    }
+
+    if (Exchange)
+    {
+      Exchange->exportValues(Index);
+    }
+  }
+
+  if (Exchange)
+  {
+    Exchange->close();
+  }
+
+  std::map<openfluid::core::UnitID_t,double> Results;
+
+  for (const auto* Unit : *Graph.allSpatialUnits())
+  {
+    Results[Unit->getID()] = Unit->variables()->value("var.water",Duration)->asDoubleValue().get() +
+                             1000*Unit->variables()->value("var.upcount",Duration)->asIntegerValue().get();
+  }
+
+  return Results;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_run)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+
+  const auto Domain = buildDomain();
+
+  openfluid::machine::SimulationBlob RefBlob;
+  openfluid::machine::Factory::buildDomainFromDescriptor(Domain,RefBlob.spatialGraph());
+  const auto RefResults = runSimulation(RefBlob.spatialGraph(),nullptr);
+
+  for (unsigned int PartsCount : {2,3,4})
+  {
+    const auto Partition = openfluid::machine::DomainPartitioner::partition(Domain,PartsCount);
+    openfluid::machine::DomainDecomposition Decomposition(Partition,4);
+
+    BOOST_REQUIRE_EQUAL(Partition.getPartsCount(),PartsCount);
+
+    auto Worker = [&Domain,&Partition,&RefResults](openfluid::machine::HaloExchange& Exchange)
+    {
+      openfluid::machine::SimulationBlob SimBlob;
+      openfluid::machine::Factory::buildDomainFromDescriptor(Partition.extractSubdomain(Domain,Exchange.getPart()),
+                                                             SimBlob.spatialGraph());
+      Exchange.attach(SimBlob,Domain);
+
+      if (Exchange.getHaloUnitsCount() != Partition.haloUnits(Exchange.getPart()).size())
+      {
+        return 1;
+      }
+
+      const auto Results = runSimulation(SimBlob.spatialGraph(),&Exchange);
+
+      for (const auto& Res : Results)
+      {
+        if (Res.second != RefResults.at(Res.first))
+        {
+          return 1;
+        }
+      }
+
+      return 0;
+    };
+
+    BOOST_REQUIRE_EQUAL(Decomposition.run(Worker),0);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_failure)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+
+  const auto Domain = buildDomain();
+  const auto Partition = openfluid::machine::DomainPartitioner::partition(Domain,3);
+  openfluid::machine::DomainDecomposition Decomposition(Partition);
+
+  // the worker of the middle part fails, its neighbours must fail instead of waiting for it
+
+  auto Worker = [&Domain,&Partition](openfluid::machine::HaloExchange& Exchange)
+  {
+    if (Exchange.getPart() == 1)
+    {
+      return 1;
+    }
+
+    openfluid::machine::SimulationBlob SimBlob;
+    openfluid::machine::Factory::buildDomainFromDescriptor(Partition.extractSubdomain(Domain,Exchange.getPart()),
+                                                           SimBlob.spatialGraph());
+    Exchange.attach(SimBlob,Domain);
+    runSimulation(SimBlob.spatialGraph(),&Exchange);
+
+    return 0;
+  };
+
+  BOOST_REQUIRE_EQUAL(Decomposition.run(Worker),3);
+
+
+  // workers throwing any kind of exception end as failed, without returning into the caller
+
+  auto ThrowingWorker = [](openfluid::machine::HaloExchange& Exchange) -> int
+  {
+    if (Exchange.getPart() == 0)
+    {
+      throw std::runtime_error("worker error");
+    }
+    throw Exchange.getPart();
+  };
+
+  BOOST_REQUIRE_EQUAL(Decomposition.run(ThrowingWorker),3);
+
+
+  // the worker of the middle part is killed, its waiting neighbours must be woken up and fail
+
+  auto KilledWorker = [&Worker](openfluid::machine::HaloExchange& Exchange)
+  {
+    if (Exchange.getPart() == 1)
+    {
+      raise(SIGKILL);
+    }
+
+    return Worker(Exchange);
+  };
+
+  BOOST_REQUIRE_EQUAL(Decomposition.run(KilledWorker),3);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_other_children)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+
+  const auto Domain = buildDomain();
+  const auto Partition = openfluid::machine::DomainPartitioner::partition(Domain,3);
+  openfluid::machine::DomainDecomposition Decomposition(Partition);
+
+  // a child process of the host application, ending while the workers are running
+
+  const pid_t OtherPID = fork();
+  BOOST_REQUIRE(OtherPID >= 0);
+
+  if (OtherPID == 0)
+  {
+    _exit(7);
+  }
+
+  auto Worker = [&Domain,&Partition](openfluid::machine::HaloExchange& Exchange)
+  {
+    // lets the other child end before the workers
+    usleep(100000);
+
+    openfluid::machine::SimulationBlob SimBlob;
+    openfluid::machine::Factory::buildDomainFromDescriptor(Partition.extractSubdomain(Domain,Exchange.getPart()),
+                                                           SimBlob.spatialGraph());
+    Exchange.attach(SimBlob,Domain);
+    runSimulation(SimBlob.spatialGraph(),&Exchange);
+
+    return 0;
+  };
+
+  BOOST_REQUIRE_EQUAL(Decomposition.run(Worker),0);
+
+  // the exit status of the other child is still available to its owner
+  int Status = 0;
+  BOOST_REQUIRE_EQUAL(waitpid(OtherPID,&Status,0),OtherPID);
+  BOOST_REQUIRE(WIFEXITED(Status));
+  BOOST_REQUIRE_EQUAL(WEXITSTATUS(Status),7);
+}
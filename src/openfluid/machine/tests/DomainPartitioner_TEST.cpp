@@ -0,0 +1,241 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file DomainPartitioner_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_DomainPartitioner
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/machine/DomainPartitioner.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+void addUnit(openfluid::fluidx::SpatialDomainDescriptor& Domain,
+             const openfluid::core::UnitsClass_t& UnitsClass, openfluid::core::UnitID_t ID,
+             openfluid::core::PcsOrd_t PcsOrd, const std::list<openfluid::core::UnitClassID_t>& ToUnits,
+             const std::list<openfluid::core::UnitClassID_t>& ParentUnits = {})
+{
+  openfluid::fluidx::SpatialUnitDescriptor UnitDesc;
+  UnitDesc.setUnitsClass(UnitsClass);
+  UnitDesc.setID(ID);
+  UnitDesc.setProcessOrder(PcsOrd);
+  UnitDesc.toSpatialUnits() = ToUnits;
+  UnitDesc.parentSpatialUnits() = ParentUnits;
+  UnitDesc.attributes()["area"] = std::to_string(ID*10);
+
+  Domain.addUnit(UnitDesc,false);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_chain)
+{
+  openfluid::fluidx::SpatialDomainDescriptor Domain;
+
+  for (unsigned int i = 1; i <= 12; i++)
+  {
+    addUnit(Domain,"TU",i,i,i < 12 ? std::list<openfluid::core::UnitClassID_t>({{"TU",i+1}}) :
+                                     std::list<openfluid::core::UnitClassID_t>());
+  }
+
+  auto Partition = openfluid::machine::DomainPartitioner::partition(Domain,3);
+
+  BOOST_REQUIRE_EQUAL(Partition.getPartsCount(),3);
+  BOOST_REQUIRE_EQUAL(Partition.getEdgeCut(),2);
+
+  for (unsigned int p = 0; p < 3; p++)
+  {
+    BOOST_REQUIRE_EQUAL(Partition.units(p).size(),4);
+    BOOST_REQUIRE_EQUAL(Partition.haloUnits(p).size(),p == 1 ? 2 : 1);
+  }
+
+  BOOST_REQUIRE_EQUAL(Partition.getPart({"TU",1}),0);
+  BOOST_REQUIRE_EQUAL(Partition.getPart({"TU",5}),1);
+  BOOST_REQUIRE_EQUAL(Partition.getPart({"TU",12}),2);
+
+  BOOST_REQUIRE(Partition.haloUnits(1).count({"TU",4}));
+  BOOST_REQUIRE(Partition.haloUnits(1).count({"TU",9}));
+  BOOST_REQUIRE(Partition.exportedUnits(1).count({"TU",5}));
+  BOOST_REQUIRE(Partition.exportedUnits(1).count({"TU",8}));
+
+  BOOST_REQUIRE(Partition.upstreamParts(0).empty());
+  BOOST_REQUIRE(Partition.upstreamParts(1) == std::set<unsigned int>({0}));
+  BOOST_REQUIRE(Partition.downstreamParts(1) == std::set<unsigned int>({2}));
+  BOOST_REQUIRE(Partition.downstreamParts(2).empty());
+
+
+  auto Subdomain = Partition.extractSubdomain(Domain,1);
+
+  BOOST_REQUIRE_EQUAL(Subdomain.getUnitsCount(),4);
+  BOOST_REQUIRE(!Subdomain.isSpatialUnitExist("TU",4));
+  BOOST_REQUIRE_EQUAL(Subdomain.spatialUnit("TU",5).toSpatialUnits().size(),1);
+  BOOST_REQUIRE(Subdomain.spatialUnit("TU",8).toSpatialUnits().empty());
+  BOOST_REQUIRE_EQUAL(Subdomain.spatialUnit("TU",8).attributes().at("area"),"80");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_tree)
+{
+  // two branches joining at TU#7, the branches are kept whole when the imbalance is tolerated
+
+  openfluid::fluidx::SpatialDomainDescriptor Domain;
+
+  addUnit(Domain,"TU",1,1,{{"TU",2}});
+  addUnit(Domain,"TU",2,2,{{"TU",3}});
+  addUnit(Domain,"TU",3,3,{{"TU",7}});
+  addUnit(Domain,"TU",4,1,{{"TU",5}});
+  addUnit(Domain,"TU",5,2,{{"TU",6}});
+  addUnit(Domain,"TU",6,3,{{"TU",7}});
+  addUnit(Domain,"TU",7,4,{{"TU",8}});
+  addUnit(Domain,"TU",8,5,{});
+
+  auto Partition = openfluid::machine::DomainPartitioner::partition(Domain,2,0.3);
+
+  BOOST_REQUIRE_EQUAL(Partition.getPartsCount(),2);
+  BOOST_REQUIRE_EQUAL(Partition.getEdgeCut(),1);
+
+  for (openfluid::core::UnitID_t ID : {1,2,3})
+  {
+    BOOST_REQUIRE_EQUAL(Partition.getPart({"TU",ID}),0);
+  }
+  for (openfluid::core::UnitID_t ID : {4,5,6,7,8})
+  {
+    BOOST_REQUIRE_EQUAL(Partition.getPart({"TU",ID}),1);
+  }
+
+
+  // strictly balanced parts
+
+  Partition = openfluid::machine::DomainPartitioner::partition(Domain,2,0.0);
+
+  BOOST_REQUIRE_EQUAL(Partition.units(0).size(),4);
+  BOOST_REQUIRE_EQUAL(Partition.units(1).size(),4);
+  BOOST_REQUIRE_EQUAL(Partition.getEdgeCut(),2);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_relations)
+{
+  // units linked by Parent-Child relations or by cycles are never separated,
+  // relations between units of different parts always go to greater parts
+
+  openfluid::fluidx::SpatialDomainDescriptor Domain;
+
+  addUnit(Domain,"TU",1,1,{{"TU",2}});
+  addUnit(Domain,"TU",2,2,{{"TU",3}});
+  addUnit(Domain,"TU",3,3,{{"TU",4}});
+  addUnit(Domain,"TU",4,4,{{"TU",3},{"RS",1}});
+  addUnit(Domain,"RS",1,1,{{"RS",2}},{{"OU",1}});
+  addUnit(Domain,"RS",2,2,{{"RS",3}});
+  addUnit(Domain,"RS",3,3,{{"RS",4}},{{"OU",1}});
+  addUnit(Domain,"RS",4,4,{});
+  addUnit(Domain,"OU",1,1,{});
+
+  for (unsigned int PartsCount = 1; PartsCount <= 4; PartsCount++)
+  {
+    auto Partition = openfluid::machine::DomainPartitioner::partition(Domain,PartsCount);
+
+    BOOST_REQUIRE_EQUAL(Partition.getPart({"TU",3}),Partition.getPart({"TU",4}));
+    BOOST_REQUIRE_EQUAL(Partition.getPart({"RS",1}),Partition.getPart({"OU",1}));
+    BOOST_REQUIRE_EQUAL(Partition.getPart({"RS",3}),Partition.getPart({"OU",1}));
+
+    unsigned int UnitsCount = 0;
+
+    for (unsigned int p = 0; p < Partition.getPartsCount(); p++)
+    {
+      UnitsCount += Partition.units(p).size();
+      BOOST_REQUIRE(!Partition.units(p).empty());
+
+      for (const auto& Up : Partition.upstreamParts(p))
+      {
+        BOOST_REQUIRE_LT(Up,p);
+      }
+    }
+    BOOST_REQUIRE_EQUAL(UnitsCount,9);
+
+    for (const auto& UnitsClass : Domain.spatialUnits())
+    {
+      for (const auto& Unit : UnitsClass.second)
+      {
+        for (const auto& ToUnit : Unit.second.toSpatialUnits())
+        {
+          BOOST_REQUIRE_LE(Partition.getPart({UnitsClass.first,Unit.first}),Partition.getPart(ToUnit));
+        }
+      }
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_errors)
+{
+  openfluid::fluidx::SpatialDomainDescriptor Domain;
+
+  addUnit(Domain,"TU",1,1,{{"TU",2}});
+  addUnit(Domain,"TU",2,2,{});
+
+  BOOST_REQUIRE_THROW(openfluid::machine::DomainPartitioner::partition(Domain,0),
+                      openfluid::base::FrameworkException);
+
+  auto Partition = openfluid::machine::DomainPartitioner::partition(Domain,5);
+
+  BOOST_REQUIRE_EQUAL(Partition.getPartsCount(),2);
+  BOOST_REQUIRE_THROW(Partition.getPart({"TU",3}),openfluid::base::FrameworkException);
+}
@@ -539,6 +539,62 @@ BOOST_AUTO_TEST_CASE(check_fixed_scalar)
 // =====================================================================
   
   
+BOOST_AUTO_TEST_CASE(check_fixed_constant)
+{
+  {
+    //DOUBLE
+    openfluid::machine::GeneratorSpecs Specs{openfluid::fluidx::GeneratorDescriptor::GeneratorMethod::FIXED,
+                                            {{"SU","a"}}};
+    openfluid::ware::WareParams_t Params = {{"deltat", "0"}, {"fixedvalue", "32"}, {"constant", "true"}};
+
+    TestSimulation TS;
+    TS.defaultSetup();
+    TS.addGenerator(Specs, Params);
+    TS.wholeSimulation();
+    BOOST_REQUIRE_CLOSE(asDouble(TS.getLatestValue("SU", 1, "a")), 32, 0.00001);
+    BOOST_REQUIRE_CLOSE(asDouble(TS.getLatestValue("SU", 2, "a")), 32, 0.00001);
+
+    // values are stored once for all units
+    openfluid::core::Variables* Vars1 = TS.SB.spatialGraph().spatialUnit("SU",1)->variables();
+    openfluid::core::Variables* Vars2 = TS.SB.spatialGraph().spatialUnit("SU",2)->variables();
+    BOOST_REQUIRE(Vars1->isSharedVariable("a"));
+    BOOST_REQUIRE(Vars1->latestIndexedValue("a") == Vars2->latestIndexedValue("a"));
+    BOOST_REQUIRE_EQUAL(Vars1->getVariableValuesCount("a"),Vars2->getVariableValuesCount("a"));
+  }
+  {
+    // VECTOR
+    openfluid::machine::GeneratorSpecs Specs{openfluid::fluidx::GeneratorDescriptor::GeneratorMethod::FIXED,
+                                             {{"SU","v"}},
+                                             openfluid::core::Value::DOUBLE,
+                                             openfluid::core::Dimensions(3)};
+    openfluid::ware::WareParams_t Params = {{"deltat", "0"}, {"fixedvalue", "[1.5,2.5,3.5]"}, {"constant", "1"}};
+
+    TestSimulation TS;
+    TS.defaultSetup();
+    TS.addGenerator(Specs, Params);
+    TS.wholeSimulation();
+    openfluid::core::VectorValue VV = TS.getLatestValue("SU", 2, "v").value()->asVectorValue();
+    BOOST_REQUIRE_EQUAL(VV.size(),3);
+    BOOST_REQUIRE_CLOSE(VV[2], 3.5, 0.00001);
+  }
+  {
+    // WRONG PARAMETER
+    openfluid::machine::GeneratorSpecs Specs{openfluid::fluidx::GeneratorDescriptor::GeneratorMethod::FIXED,
+                                            {{"SU","a"}}};
+    openfluid::ware::WareParams_t Params = {{"deltat", "0"}, {"fixedvalue", "32"}, {"constant", "maybe"}};
+
+    TestSimulation TS;
+    TS.defaultSetup();
+    TS.addGenerator(Specs, Params);
+    BOOST_REQUIRE_THROW(TS.wholeSimulation(),openfluid::base::FrameworkException);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 BOOST_AUTO_TEST_CASE(check_fixed_vector)
 {
   {
@@ -375,3 +375,119 @@ BOOST_AUTO_TEST_CASE(check_mergeParamsWithGlobalParams)
   BOOST_CHECK_EQUAL(OutParams["B1.C1"].get(),"B1.C1local");
   BOOST_CHECK_EQUAL(OutParams["D1.E1.F1"].get(),"D1.E1.F1local");
 }
+
+
+// =====================================================================
+// =====================================================================
+
+
+class CountingListener : public openfluid::machine::MachineListener
+{
+  public:
+
+    unsigned int RunStepsCount = 0;
+
+    unsigned int SimulatorsRunStepsCount = 0;
+
+    unsigned int ProgressCount = 0;
+
+    unsigned int ProgressStepsCount = 0;
+
+    void onRunStep(const openfluid::base::SimulationStatus* /*SimStatus*/)
+    {
+      RunStepsCount++;
+    }
+
+    void onSimulatorRunStep(const std::string& /*SimulatorID*/)
+    {
+      SimulatorsRunStepsCount++;
+    }
+
+    void onRunStepsProgress(const openfluid::base::SimulationStatus* /*SimStatus*/,
+                            unsigned int StepsCount, const openfluid::base::Listener::Status& Status)
+    {
+      BOOST_REQUIRE(Status == openfluid::base::Listener::Status::OK_STATUS);
+      ProgressCount++;
+      ProgressStepsCount += StepsCount;
+    }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+void runCountedModel(CountingListener* Listener)
+{
+  openfluid::machine::SimulationBlob SB;
+
+  SB.simulationStatus() = openfluid::base::SimulationStatus(openfluid::core::DateTime(2012,1,1,0,0,0),
+                                                            openfluid::core::DateTime(2012,1,1,0,3,19),60);
+
+  openfluid::machine::ModelInstance MI(SB,Listener);
+
+  openfluid::machine::WareContainer<openfluid::ware::SimulatorSignature> ContA(openfluid::ware::WareType::SIMULATOR);
+  auto SignA = new openfluid::ware::SimulatorSignature();
+  SignA->ID = "sim.a";
+  ContA.setSignature(SignA);
+  ContA.validate();
+  openfluid::machine::ModelItemInstance* MII = new openfluid::machine::ModelItemInstance(ContA);
+  MII->Body.reset((openfluid::ware::PluggableSimulator*)(new SimA()));
+  MII->OriginalPosition = 1;
+  MI.appendItem(MII);
+
+  openfluid::base::SimulationLogger SimLog(CONFIGTESTS_OUTPUT_DATA_DIR+"/checksimlog3.log");
+
+  MI.initialize(&SimLog);
+
+  SB.simulationStatus().setCurrentStage(openfluid::base::SimulationStatus::INITIALIZERUN);
+  MI.call_initializeRun();
+
+  SB.simulationStatus().setCurrentStage(openfluid::base::SimulationStatus::RUNSTEP);
+  while (MI.hasTimePointToProcess())
+  {
+    MI.processNextTimePoint();
+  }
+
+  MI.finalize();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_run_steps_notification)
+{
+  openfluid::base::RunContextManager::instance()
+    ->setOutputDir(CONFIGTESTS_OUTPUT_DATA_DIR+"/OPENFLUID.OUT.ModelInstance");
+
+  CountingListener Detailed;
+  BOOST_REQUIRE(Detailed.getRunStepsNotification() ==
+                openfluid::machine::MachineListener::RunStepsNotification::DETAILED);
+  runCountedModel(&Detailed);
+  BOOST_REQUIRE_EQUAL(Detailed.RunStepsCount,3);
+  BOOST_REQUIRE_EQUAL(Detailed.SimulatorsRunStepsCount,3);
+  BOOST_REQUIRE_EQUAL(Detailed.ProgressCount,0);
+
+  CountingListener Coalesced;
+  Coalesced.setCoalescedRunSteps(2,0);
+  runCountedModel(&Coalesced);
+  BOOST_REQUIRE_EQUAL(Coalesced.RunStepsCount,0);
+  BOOST_REQUIRE_EQUAL(Coalesced.SimulatorsRunStepsCount,0);
+  BOOST_REQUIRE_EQUAL(Coalesced.ProgressCount,2);
+  BOOST_REQUIRE_EQUAL(Coalesced.ProgressStepsCount,3);
+
+  CountingListener LastOnly;
+  LastOnly.setCoalescedRunSteps(0,0);
+  runCountedModel(&LastOnly);
+  BOOST_REQUIRE_EQUAL(LastOnly.ProgressCount,1);
+  BOOST_REQUIRE_EQUAL(LastOnly.ProgressStepsCount,3);
+
+  CountingListener Silent;
+  Silent.setSilentRunSteps();
+  runCountedModel(&Silent);
+  BOOST_REQUIRE_EQUAL(Silent.RunStepsCount,0);
+  BOOST_REQUIRE_EQUAL(Silent.SimulatorsRunStepsCount,0);
+  BOOST_REQUIRE_EQUAL(Silent.ProgressCount,0);
+}
@@ -0,0 +1,159 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file ProfilingCounters_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_profilingcounters
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/machine/ProfilingCounters.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+class FakeCountersBackend : public openfluid::machine::ProfilingCountersBackend
+{
+  private:
+
+    openfluid::machine::ProfilingCounters::Value_t m_Instructions;
+
+
+  public:
+
+    FakeCountersBackend() : m_Instructions(0)
+    { }
+
+    std::string getName() const
+    {
+      return "fake";
+    }
+
+    bool isAvailable() const
+    {
+      return true;
+    }
+
+    void read(openfluid::machine::ProfilingCounters& Counters)
+    {
+      m_Instructions += 100;
+      Counters.set(openfluid::machine::ProfilingCounters::Counter::INSTRUCTIONS,m_Instructions);
+    }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_accumulate)
+{
+  using Counter = openfluid::machine::ProfilingCounters::Counter;
+
+  openfluid::machine::ProfilingCounters Start, End, Cumul;
+
+  Start.set(Counter::HEAPBYTES,1000);
+  Start.set(Counter::PEAKRSS,5000);
+  Start.set(Counter::INSTRUCTIONS,10);
+
+  End.set(Counter::HEAPBYTES,1500);
+  End.set(Counter::PEAKRSS,6000);
+  End.set(Counter::INSTRUCTIONS,30);
+  End.set(Counter::CACHEMISSES,2);
+
+  BOOST_REQUIRE(!Cumul.hasAvailable());
+
+  Cumul.accumulate(Start,End);
+  Cumul.accumulate(Start,End);
+
+  BOOST_REQUIRE(Cumul.hasAvailable());
+  BOOST_REQUIRE(Cumul.isAvailable(Counter::HEAPBYTES));
+  BOOST_REQUIRE(!Cumul.isAvailable(Counter::CACHEMISSES));
+  BOOST_REQUIRE(!Cumul.isAvailable(Counter::MINORFAULTS));
+
+  BOOST_REQUIRE_EQUAL(Cumul.get(Counter::HEAPBYTES),1000);
+  BOOST_REQUIRE_EQUAL(Cumul.get(Counter::PEAKRSS),6000);
+  BOOST_REQUIRE_EQUAL(Cumul.get(Counter::INSTRUCTIONS),40);
+
+  openfluid::machine::ProfilingCounters Merged;
+  Merged.merge(Cumul);
+  Merged.merge(Cumul);
+
+  BOOST_REQUIRE_EQUAL(Merged.get(Counter::HEAPBYTES),2000);
+  BOOST_REQUIRE_EQUAL(Merged.get(Counter::PEAKRSS),6000);
+  BOOST_REQUIRE_EQUAL(Merged.get(Counter::INSTRUCTIONS),80);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_reader)
+{
+  using Counter = openfluid::machine::ProfilingCounters::Counter;
+
+  openfluid::machine::ProfilingCountersReader Reader;
+  openfluid::machine::ProfilingCounters Start, End, Cumul;
+
+  BOOST_REQUIRE(!Reader.hasBackends());
+  BOOST_REQUIRE(Reader.addBackend(std::make_unique<FakeCountersBackend>()));
+  BOOST_REQUIRE(!Reader.addBackend(nullptr));
+
+  Reader.addDefaultBackends();
+  BOOST_REQUIRE(Reader.hasBackends());
+  BOOST_REQUIRE_EQUAL(Reader.getBackendsNames().front(),"fake");
+
+  for (const auto& Name : Reader.getBackendsNames())
+  {
+    std::cout << "Available counters backend: " << Name << std::endl;
+  }
+
+  Reader.read(Start);
+  Reader.read(End);
+  Cumul.accumulate(Start,End);
+
+  BOOST_REQUIRE(Cumul.isAvailable(Counter::INSTRUCTIONS));
+  BOOST_REQUIRE(Cumul.get(Counter::INSTRUCTIONS) > 0);
+}
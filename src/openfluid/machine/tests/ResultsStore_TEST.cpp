@@ -0,0 +1,170 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file ResultsStore_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_ResultsStore
+
+
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/machine/ResultsStore.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_construction)
+{
+  openfluid::machine::ResultsStore Store;
+
+  BOOST_REQUIRE(Store.isEmpty());
+  BOOST_REQUIRE(Store.table("TU","var") == nullptr);
+  BOOST_REQUIRE_EQUAL(Store.getValuesCount("TU",1,"var"),0);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_operations)
+{
+  openfluid::machine::ResultsStore Store;
+
+  BOOST_REQUIRE(Store.addVariable("TU","var.a"));
+  BOOST_REQUIRE(Store.addVariable("TU","var.b"));
+  BOOST_REQUIRE(!Store.addVariable("TU","var.a"));
+  BOOST_REQUIRE_EQUAL(Store.getVariables().size(),2);
+
+  auto* Tbl = Store.table("TU","var.a");
+  BOOST_REQUIRE(Tbl != nullptr);
+
+  Tbl->addValue(0,1,1.0);
+  Tbl->addValue(0,2,2.0);
+  Tbl->addValue(60,2,2.5);
+  Tbl->addValue(120,3,3.5);
+  Tbl->addValue(120,1,1.5);
+
+  BOOST_REQUIRE_EQUAL(Tbl->getRowsCount(),3);
+  BOOST_REQUIRE_EQUAL(Tbl->unitsIDs().size(),3);
+  BOOST_REQUIRE_EQUAL(Store.getValuesCount("TU",3,"var.a"),3);
+  BOOST_REQUIRE_EQUAL(Store.getValuesCount("TU",4,"var.a"),0);
+  BOOST_REQUIRE_EQUAL(Store.getValuesCount("TU",1,"var.b"),0);
+
+  double Values[3];
+  openfluid::core::TimeIndex_t Indexes[3];
+
+  BOOST_REQUIRE_EQUAL(Store.copyValues("TU",1,"var.a",Values,Indexes,3),3);
+  BOOST_REQUIRE_EQUAL(Values[0],1.0);
+  BOOST_REQUIRE(std::isnan(Values[1]));
+  BOOST_REQUIRE_EQUAL(Values[2],1.5);
+  BOOST_REQUIRE_EQUAL(Indexes[1],60);
+  BOOST_REQUIRE_EQUAL(Indexes[2],120);
+
+  BOOST_REQUIRE_EQUAL(Store.copyValues("TU",3,"var.a",Values,nullptr,2),2);
+  BOOST_REQUIRE(std::isnan(Values[0]));
+  BOOST_REQUIRE(std::isnan(Values[1]));
+
+  double Value = 0.0;
+  BOOST_REQUIRE(Store.getValue("TU",2,"var.a",60,Value));
+  BOOST_REQUIRE_EQUAL(Value,2.5);
+  BOOST_REQUIRE(!Store.getValue("TU",2,"var.a",30,Value));
+  BOOST_REQUIRE(!Store.getValue("TU",4,"var.a",60,Value));
+
+  Store.clearValues();
+  BOOST_REQUIRE_EQUAL(Store.table("TU","var.a")->getRowsCount(),0);
+  BOOST_REQUIRE_EQUAL(Store.getVariables().size(),2);
+
+  Store.clearVariables();
+  BOOST_REQUIRE(Store.isEmpty());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_aggregations)
+{
+  openfluid::machine::ResultsStore Store;
+  openfluid::machine::ResultsStore::Aggregation Aggr;
+
+  BOOST_REQUIRE(openfluid::machine::ResultsStore::getAggregationFromString("mean",Aggr));
+  BOOST_REQUIRE(Aggr == openfluid::machine::ResultsStore::Aggregation::MEAN);
+  BOOST_REQUIRE(!openfluid::machine::ResultsStore::getAggregationFromString("median",Aggr));
+
+  Store.addVariable("TU","var.mean",openfluid::machine::ResultsStore::Aggregation::MEAN,3600);
+  Store.addVariable("TU","var.sum",openfluid::machine::ResultsStore::Aggregation::SUM,3600);
+  Store.addVariable("TU","var.min",openfluid::machine::ResultsStore::Aggregation::MIN,3600);
+  Store.addVariable("TU","var.max",openfluid::machine::ResultsStore::Aggregation::MAX,0);
+
+  for (openfluid::core::TimeIndex_t t=0; t<3*3600; t+=600)
+  {
+    const double Val = (t % 3600)/600.0;
+
+    for (const auto& Key : Store.getVariables())
+    {
+      Store.table(Key.first,Key.second)->addValue(t,1,Val);
+      Store.table(Key.first,Key.second)->addValue(t,2,(t == 3600) ? std::nan("") : 10.0);
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(Store.table("TU","var.mean")->getRowsCount(),3);
+  BOOST_REQUIRE_EQUAL(Store.table("TU","var.max")->getRowsCount(),1);
+
+  double Value = 0.0;
+  BOOST_REQUIRE(Store.getValue("TU",1,"var.mean",3600,Value));
+  BOOST_REQUIRE_CLOSE(Value,2.5,1e-9);
+  BOOST_REQUIRE(Store.getValue("TU",1,"var.sum",7200,Value));
+  BOOST_REQUIRE_CLOSE(Value,15.0,1e-9);
+  BOOST_REQUIRE(Store.getValue("TU",1,"var.min",0,Value));
+  BOOST_REQUIRE_EQUAL(Value,0.0);
+  BOOST_REQUIRE(Store.getValue("TU",1,"var.max",0,Value));
+  BOOST_REQUIRE_EQUAL(Value,5.0);
+
+  // missing values are ignored by aggregations
+  BOOST_REQUIRE(Store.getValue("TU",2,"var.sum",3600,Value));
+  BOOST_REQUIRE_CLOSE(Value,50.0,1e-9);
+  BOOST_REQUIRE(Store.getValue("TU",2,"var.mean",3600,Value));
+  BOOST_REQUIRE_CLOSE(Value,10.0,1e-9);
+}
@@ -0,0 +1,355 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SimulationCheckpoint_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_SimulationCheckpoint
+
+
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/machine/MachineListener.hpp>
+#include <openfluid/machine/ModelInstance.hpp>
+#include <openfluid/machine/SimulationBlob.hpp>
+#include <openfluid/machine/SimulationCheckpoint.hpp>
+#include <openfluid/machine/FixedGenerator.hpp>
+#include <openfluid/machine/ModelItemInstance.hpp>
+#include <openfluid/core/ValuesBufferProperties.hpp>
+#include <openfluid/core/ValuesBuffer.hpp>
+#include <openfluid/core/MapValue.hpp>
+#include <openfluid/core/VectorValue.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+void buildBlob(openfluid::machine::SimulationBlob& SB)
+{
+  SB.simulationStatus() = openfluid::base::SimulationStatus(openfluid::core::DateTime(2012,1,1,0,0,0),
+                                                            openfluid::core::DateTime(2012,1,2,0,0,0),60);
+
+  auto& Graph = SB.spatialGraph();
+
+  for (unsigned int i=1; i<=3; i++)
+  {
+    auto* U = Graph.addUnit(openfluid::core::SpatialUnit("TU",i,i));
+    U->attributes()->setValue("area",openfluid::core::DoubleValue(i*10.0));
+    U->variables()->createVariable("var.double",openfluid::core::Value::DOUBLE);
+    U->variables()->createVariable("var.vector",openfluid::core::Value::VECTOR);
+  }
+  Graph.addUnit(openfluid::core::SpatialUnit("OU",1,1));
+
+  auto* TU1 = Graph.spatialUnit("TU",1);
+  auto* TU2 = Graph.spatialUnit("TU",2);
+  auto* OU1 = Graph.spatialUnit("OU",1);
+  TU1->addToUnit(TU2);
+  TU2->addFromUnit(TU1);
+  OU1->addChildUnit(TU1);
+  TU1->addParentUnit(OU1);
+
+  SB.simulationStatus().setCurrentStage(openfluid::base::SimulationStatus::RUNSTEP);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_write_read)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+
+  std::unique_ptr<openfluid::machine::MachineListener> Listener =
+    std::make_unique<openfluid::machine::MachineListener>();
+
+  openfluid::machine::SimulationBlob SB;
+  buildBlob(SB);
+  openfluid::machine::ModelInstance MI(SB,Listener.get());
+
+  for (openfluid::core::TimeIndex_t t=0; t<=300; t+=60)
+  {
+    SB.simulationStatus().setCurrentTimeIndex(t);
+    for (auto* U : *SB.spatialGraph().allSpatialUnits())
+    {
+      if (U->getClass() == "TU")
+      {
+        U->variables()->appendValue("var.double",t,openfluid::core::DoubleValue(t*0.5+U->getID()));
+        U->variables()->appendValue("var.vector",t,openfluid::core::VectorValue(3,double(t)));
+      }
+    }
+  }
+
+  openfluid::core::Event Ev(openfluid::core::DateTime(2012,1,1,6,0,0));
+  Ev.addInfo("kind","irrigation");
+  SB.spatialGraph().spatialUnit("TU",3)->events()->addEvent(Ev);
+
+  std::stringstream Stm;
+  openfluid::machine::SimulationCheckpoint::write(Stm,SB,MI);
+
+
+  // restoring into a blob with a diverging state
+
+  openfluid::machine::SimulationBlob RestoredSB;
+  buildBlob(RestoredSB);
+  openfluid::machine::ModelInstance RestoredMI(RestoredSB,Listener.get());
+
+  auto& RestoredGraph = RestoredSB.spatialGraph();
+  RestoredGraph.deleteUnit(RestoredGraph.spatialUnit("TU",3));
+  RestoredGraph.addUnit(openfluid::core::SpatialUnit("XU",7,2));
+  RestoredGraph.spatialUnit("TU",1)->attributes()->setValue("area",openfluid::core::DoubleValue(-1.0));
+  RestoredGraph.spatialUnit("TU",2)->attributes()->setValue("slope",openfluid::core::DoubleValue(0.1));
+  RestoredGraph.spatialUnit("TU",2)->variables()->appendValue("var.double",0,openfluid::core::DoubleValue(-5.0));
+
+  openfluid::machine::SimulationCheckpoint::read(Stm,RestoredSB,RestoredMI);
+
+  BOOST_REQUIRE_EQUAL(RestoredSB.simulationStatus().getCurrentTimeIndex(),300);
+  BOOST_REQUIRE_EQUAL(RestoredGraph.allSpatialUnits()->size(),4);
+  BOOST_REQUIRE(RestoredGraph.spatialUnit("XU",7) == nullptr);
+
+  const auto* TU1 = RestoredGraph.spatialUnit("TU",1);
+  const auto* TU2 = RestoredGraph.spatialUnit("TU",2);
+  const auto* TU3 = RestoredGraph.spatialUnit("TU",3);
+  BOOST_REQUIRE(TU3 != nullptr);
+  BOOST_REQUIRE_EQUAL(TU3->getProcessOrder(),3);
+
+  BOOST_REQUIRE_EQUAL(TU1->toSpatialUnits("TU")->size(),1);
+  BOOST_REQUIRE(TU1->toSpatialUnits("TU")->front() == TU2);
+  BOOST_REQUIRE_EQUAL(TU2->fromSpatialUnits("TU")->size(),1);
+  BOOST_REQUIRE_EQUAL(TU1->parentSpatialUnits("OU")->size(),1);
+
+  BOOST_REQUIRE_CLOSE(TU1->attributes()->value("area")->asDoubleValue().get(),10.0,1e-9);
+  BOOST_REQUIRE(!TU2->attributes()->isAttributeExist("slope"));
+  BOOST_REQUIRE_CLOSE(TU3->attributes()->value("area")->asDoubleValue().get(),30.0,1e-9);
+
+  for (const auto* U : {TU1,TU2,TU3})
+  {
+    BOOST_REQUIRE(U->variables()->value("var.double",0) == nullptr);
+    for (openfluid::core::TimeIndex_t t=60; t<=300; t+=60)
+    {
+      BOOST_REQUIRE_CLOSE(U->variables()->value("var.double",t)->asDoubleValue().get(),t*0.5+U->getID(),1e-9);
+      BOOST_REQUIRE_EQUAL(U->variables()->value("var.vector",t)->asVectorValue().size(),3);
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(TU3->events()->getCount(),1);
+  std::string Info;
+  BOOST_REQUIRE(TU3->events()->eventsList()->front().getInfoAsString("kind",Info));
+  BOOST_REQUIRE_EQUAL(Info,"irrigation");
+  BOOST_REQUIRE_EQUAL(TU2->events()->getCount(),0);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_errors)
+{
+  std::unique_ptr<openfluid::machine::MachineListener> Listener =
+    std::make_unique<openfluid::machine::MachineListener>();
+
+  openfluid::machine::SimulationBlob SB;
+  buildBlob(SB);
+  openfluid::machine::ModelInstance MI(SB,Listener.get());
+
+  std::stringstream BadStm("NOT-A-CHECKPOINT");
+  BOOST_REQUIRE_THROW(openfluid::machine::SimulationCheckpoint::read(BadStm,SB,MI),
+                      openfluid::base::FrameworkException);
+
+  std::stringstream Stm;
+  openfluid::machine::SimulationCheckpoint::write(Stm,SB,MI);
+
+  openfluid::machine::SimulationBlob OtherSB;
+  buildBlob(OtherSB);
+  OtherSB.simulationStatus() = openfluid::base::SimulationStatus(openfluid::core::DateTime(2013,1,1,0,0,0),
+                                                                 openfluid::core::DateTime(2013,1,2,0,0,0),60);
+  OtherSB.simulationStatus().setCurrentStage(openfluid::base::SimulationStatus::RUNSTEP);
+  openfluid::machine::ModelInstance OtherMI(OtherSB,Listener.get());
+
+  BOOST_REQUIRE_THROW(openfluid::machine::SimulationCheckpoint::read(Stm,OtherSB,OtherMI),
+                      openfluid::base::FrameworkException);
+
+
+  // values which cannot be restored into existing variables
+
+  SB.spatialGraph().spatialUnit("TU",1)->variables()->createVariable("var.typed",openfluid::core::Value::VECTOR);
+  SB.spatialGraph().spatialUnit("TU",1)->variables()->appendValue("var.typed",0,
+                                                                    openfluid::core::VectorValue(3,1.0));
+  std::stringstream TypedStm;
+  openfluid::machine::SimulationCheckpoint::write(TypedStm,SB,MI);
+
+  openfluid::machine::SimulationBlob TypedSB;
+  buildBlob(TypedSB);
+  TypedSB.spatialGraph().spatialUnit("TU",1)->variables()->createVariable("var.typed",
+                                                                           openfluid::core::Value::INTEGER);
+  openfluid::machine::ModelInstance TypedMI(TypedSB,Listener.get());
+
+  BOOST_REQUIRE_THROW(openfluid::machine::SimulationCheckpoint::read(TypedStm,TypedSB,TypedMI),
+                      openfluid::base::FrameworkException);
+
+
+  // variable shared in the restored model but not in the checkpointed one
+
+  openfluid::core::ValuesBuffer SharedValues;
+  SharedValues.appendValue(0,openfluid::core::DoubleValue(1.0));
+
+  openfluid::machine::SimulationBlob SharedSB;
+  buildBlob(SharedSB);
+  SharedSB.spatialGraph().spatialUnit("TU",2)->variables()->shareVariable("var.double",SharedValues);
+  openfluid::machine::ModelInstance SharedMI(SharedSB,Listener.get());
+
+  std::stringstream NotSharedStm;
+  openfluid::machine::SimulationCheckpoint::write(NotSharedStm,SB,MI);
+  BOOST_REQUIRE_THROW(openfluid::machine::SimulationCheckpoint::read(NotSharedStm,SharedSB,SharedMI),
+                      openfluid::base::FrameworkException);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+typedef openfluid::machine::WareContainer<openfluid::ware::SimulatorSignature> SimContainer_t;
+
+
+openfluid::machine::FixedGenerator<double>* appendConstantGenerator(openfluid::machine::SimulationBlob& SB,
+                                                                    openfluid::machine::ModelInstance& MI,
+                                                                    SimContainer_t& Cont)
+{
+  for (auto& U : *SB.spatialGraph().spatialUnits("TU")->list())
+  {
+    U.variables()->createVariable("var.const",openfluid::core::Value::DOUBLE);
+  }
+
+  auto Sign = new openfluid::ware::SimulatorSignature();
+  Sign->ID = "gen.const";
+  Cont.setSignature(Sign);
+  Cont.validate();
+
+  auto* Gen = new openfluid::machine::FixedGenerator<double>();
+  Gen->linkToSimulation(&SB.simulationStatus());
+  Gen->linkToSpatialGraph(&SB.spatialGraph());
+  Gen->setInfos({{"TU","var.const"}},openfluid::fluidx::GeneratorDescriptor::GeneratorMethod::FIXED);
+  Gen->initParams({{"fixedvalue","2.5"},{"constant","true"}});
+
+  auto* Item = new openfluid::machine::ModelItemInstance(Cont);
+  Item->Body.reset(Gen);
+  MI.appendItem(Item);
+
+  return Gen;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_constant_generator)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(10);
+
+  std::unique_ptr<openfluid::machine::MachineListener> Listener =
+    std::make_unique<openfluid::machine::MachineListener>();
+
+  // containers must outlive the model instances, which only keep references to them
+  SimContainer_t Cont(openfluid::ware::WareType::SIMULATOR);
+  SimContainer_t RestoredCont(openfluid::ware::WareType::SIMULATOR);
+
+  openfluid::machine::SimulationBlob SB;
+  buildBlob(SB);
+  openfluid::machine::ModelInstance MI(SB,Listener.get());
+  auto* Gen = appendConstantGenerator(SB,MI,Cont);
+
+  SB.simulationStatus().setCurrentTimeIndex(0);
+  Gen->initializeRun();
+  for (openfluid::core::TimeIndex_t t=60; t<=300; t+=60)
+  {
+    SB.simulationStatus().setCurrentTimeIndex(t);
+    Gen->runStep();
+  }
+
+  BOOST_REQUIRE(SB.spatialGraph().spatialUnit("TU",1)->variables()->isSharedVariable("var.const"));
+
+  std::stringstream Stm;
+  openfluid::machine::SimulationCheckpoint::write(Stm,SB,MI);
+
+
+  // restoring into a new run, stopped after initialization, where a unit is missing
+
+  openfluid::machine::SimulationBlob RestoredSB;
+  buildBlob(RestoredSB);
+  openfluid::machine::ModelInstance RestoredMI(RestoredSB,Listener.get());
+  auto* RestoredGen = appendConstantGenerator(RestoredSB,RestoredMI,RestoredCont);
+
+  RestoredSB.simulationStatus().setCurrentTimeIndex(0);
+  RestoredGen->initializeRun();
+  RestoredSB.spatialGraph().deleteUnit(RestoredSB.spatialGraph().spatialUnit("TU",3));
+
+  openfluid::machine::SimulationCheckpoint::read(Stm,RestoredSB,RestoredMI);
+
+  BOOST_REQUIRE_EQUAL(RestoredSB.simulationStatus().getCurrentTimeIndex(),300);
+
+  const openfluid::core::Value* SharedValue =
+    RestoredSB.spatialGraph().spatialUnit("TU",1)->variables()->value("var.const",300);
+  BOOST_REQUIRE(SharedValue != nullptr);
+
+  for (const auto& U : *RestoredSB.spatialGraph().spatialUnits("TU")->list())
+  {
+    BOOST_REQUIRE(U.variables()->isSharedVariable("var.const"));
+    BOOST_REQUIRE_CLOSE(U.variables()->value("var.const",0)->asDoubleValue().get(),0.0,1e-9);
+    for (openfluid::core::TimeIndex_t t=60; t<=300; t+=60)
+    {
+      BOOST_REQUIRE_CLOSE(U.variables()->value("var.const",t)->asDoubleValue().get(),2.5,1e-9);
+    }
+    BOOST_REQUIRE(U.variables()->value("var.const",300) == SharedValue);
+  }
+
+
+  // the restored generator keeps appending the shared values
+
+  RestoredSB.simulationStatus().setCurrentTimeIndex(360);
+  RestoredGen->runStep();
+
+  BOOST_REQUIRE_CLOSE(RestoredSB.spatialGraph().spatialUnit("TU",3)->variables()->value("var.const",360)
+                        ->asDoubleValue().get(),2.5,1e-9);
+}
@@ -0,0 +1,223 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file SpatialDataSchema_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_SpatialDataSchema
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/machine/SpatialDataSchema.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/core/ValuesBufferProperties.hpp>
+#include <openfluid/core/DoubleValue.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+void buildGraph(openfluid::core::SpatialGraph& Graph, unsigned int TUCount)
+{
+  for (unsigned int i = 1; i <= TUCount; i++)
+  {
+    Graph.addUnit(openfluid::core::SpatialUnit("TU",i,1));
+  }
+
+  for (unsigned int i = 1; i <= 3; i++)
+  {
+    Graph.addUnit(openfluid::core::SpatialUnit("OU",i,1));
+  }
+
+  Graph.sortUnitsByProcessOrder();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_variables)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+
+  openfluid::core::SpatialGraph Graph;
+  buildGraph(Graph,5000);
+
+  openfluid::machine::SpatialDataSchema Schema(Graph,4);
+
+  BOOST_REQUIRE_THROW(Schema.declareProducedVariable("var.x",openfluid::core::Value::DOUBLE,"XU","sim.a"),
+                      openfluid::base::FrameworkException);
+
+  Schema.declareProducedVariable("var.a",openfluid::core::Value::DOUBLE,"TU","sim.a");
+  Schema.declareProducedVariable("var.b",openfluid::core::Value::NONE,"TU","sim.a");
+  Schema.declareUpdatedVariable("var.a",openfluid::core::Value::DOUBLE,"TU","sim.b");
+  Schema.declareUpdatedVariable("var.c",openfluid::core::Value::INTEGER,"OU","sim.b");
+
+  BOOST_REQUIRE_THROW(Schema.declareProducedVariable("var.b",openfluid::core::Value::NONE,"TU","sim.b"),
+                      openfluid::base::FrameworkException);
+
+  openfluid::fluidx::RunConfigurationDescriptor::VariablesStorage_t Storage;
+  Storage[{"TU","var.a"}].Precision = openfluid::core::ValuesBuffer::StoragePrecision::FLOAT32;
+
+  BOOST_REQUIRE(!Schema.isUniform("TU"));
+  Schema.applyVariables(Storage);
+  BOOST_REQUIRE(Schema.isUniform("TU"));
+  BOOST_REQUIRE(Schema.isUniform("OU"));
+
+  for (const auto& Unit : *(Graph.spatialUnits("TU")->list()))
+  {
+    BOOST_REQUIRE_EQUAL(Unit.variables()->getVariablesCount(),2);
+    BOOST_REQUIRE(Unit.variables()->isTypedVariableExist("var.a",openfluid::core::Value::DOUBLE));
+    BOOST_REQUIRE(Unit.variables()->isVariableExist("var.b"));
+  }
+  BOOST_REQUIRE(Graph.spatialUnit("TU",4321)->variables()->isTypedVariableExist("var.a",
+                                                                                   openfluid::core::Value::DOUBLE));
+  BOOST_REQUIRE(Graph.spatialUnit("OU",2)->variables()->isTypedVariableExist("var.c",
+                                                                                openfluid::core::Value::INTEGER));
+
+  Schema.checkRequiredVariable("var.a",openfluid::core::Value::DOUBLE,"TU","obs.a");
+  Schema.checkRequiredVariable("var.b",openfluid::core::Value::NONE,"TU","obs.a");
+  BOOST_REQUIRE_THROW(Schema.checkRequiredVariable("var.a",openfluid::core::Value::INTEGER,"TU","obs.a"),
+                      openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(Schema.checkRequiredVariable("var.c",openfluid::core::Value::NONE,"TU","obs.a"),
+                      openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(Schema.checkRequiredVariable("var.a",openfluid::core::Value::NONE,"XU","obs.a"),
+                      openfluid::base::FrameworkException);
+
+
+  // values counts
+
+  Schema.checkVariablesValuesCount(0);
+
+  for (auto& Unit : *(Graph.spatialUnits("TU")->list()))
+  {
+    Unit.variables()->appendValue("var.a",0,openfluid::core::DoubleValue(1.0));
+  }
+  BOOST_REQUIRE_THROW(Schema.checkVariablesValuesCount(0),openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(Schema.checkVariablesValuesCount(1),openfluid::base::FrameworkException);
+
+
+  // a unit added after variables creation disables the checks on the schema
+
+  Graph.addUnit(openfluid::core::SpatialUnit("TU",5001,1));
+  BOOST_REQUIRE(!Schema.isUniform("TU"));
+  BOOST_REQUIRE_THROW(Schema.checkRequiredVariable("var.a",openfluid::core::Value::DOUBLE,"TU","obs.a"),
+                      openfluid::base::FrameworkException);
+
+  Graph.spatialUnit("TU",5001)->variables()->createVariable("var.a",openfluid::core::Value::DOUBLE);
+  Schema.checkRequiredVariable("var.a",openfluid::core::Value::DOUBLE,"TU","obs.a");
+  BOOST_REQUIRE_THROW(Schema.checkRequiredVariable("var.b",openfluid::core::Value::NONE,"TU","obs.a"),
+                      openfluid::base::FrameworkException);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_existing_variables)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+
+  openfluid::core::SpatialGraph Graph;
+  buildGraph(Graph,10);
+
+  Graph.spatialUnit("TU",7)->variables()->createVariable("var.a",openfluid::core::Value::DOUBLE);
+  Graph.spatialUnit("OU",1)->variables()->createVariable("var.x",openfluid::core::Value::DOUBLE);
+
+  openfluid::machine::SpatialDataSchema Schema(Graph,4);
+
+  // updated variables may already exist on units
+  Schema.declareUpdatedVariable("var.a",openfluid::core::Value::DOUBLE,"TU","sim.a");
+  Schema.applyVariables({});
+  BOOST_REQUIRE(!Schema.isUniform("TU"));
+  BOOST_REQUIRE(!Schema.isUniform("OU"));
+  Schema.checkRequiredVariable("var.a",openfluid::core::Value::DOUBLE,"TU","obs.a");
+  BOOST_REQUIRE_THROW(Schema.checkRequiredVariable("var.x",openfluid::core::Value::DOUBLE,"OU","obs.a"),
+                      openfluid::base::FrameworkException);
+
+  // produced variables must not
+  Graph.clearAllVariables();
+  Graph.spatialUnit("TU",7)->variables()->createVariable("var.a",openfluid::core::Value::DOUBLE);
+
+  Schema.clear();
+  Schema.declareProducedVariable("var.a",openfluid::core::Value::DOUBLE,"TU","sim.a");
+  BOOST_REQUIRE_THROW(Schema.applyVariables({}),openfluid::base::FrameworkException);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_attributes)
+{
+  openfluid::core::SpatialGraph Graph;
+  buildGraph(Graph,5000);
+
+  for (auto& Unit : *(Graph.spatialUnits("TU")->list()))
+  {
+    Unit.attributes()->setValue("area",openfluid::core::DoubleValue(Unit.getID()));
+  }
+
+  openfluid::machine::SpatialDataSchema Schema(Graph,4);
+
+  BOOST_REQUIRE_THROW(Schema.declareRequiredAttribute("area","XU","sim.a"),openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(Schema.declareProducedAttribute("area","XU","sim.a"),openfluid::base::FrameworkException);
+
+  Schema.declareRequiredAttribute("area","TU","sim.a");
+  Schema.declareProducedAttribute("slope","TU","sim.a");
+  Schema.declareRequiredAttribute("slope","TU","obs.a");
+  Schema.applyAttributes();
+
+  BOOST_REQUIRE(Graph.spatialUnit("TU",4999)->attributes()->isAttributeExist("slope"));
+  BOOST_REQUIRE(Graph.spatialUnit("TU",1)->attributes()->value("slope")->isNullValue());
+  BOOST_REQUIRE_EQUAL(Graph.spatialUnit("TU",25)->attributes()->value("area")->asDoubleValue().get(),25.0);
+
+  Schema.clear();
+  Graph.spatialUnit("TU",3210)->attributes()->removeAttribute("area");
+  Schema.declareRequiredAttribute("area","TU","sim.a");
+  BOOST_REQUIRE_THROW(Schema.applyAttributes(),openfluid::base::FrameworkException);
+
+  Schema.clear();
+  Schema.declareRequiredAttribute("area","OU","sim.a");
+  BOOST_REQUIRE_THROW(Schema.applyAttributes(),openfluid::base::FrameworkException);
+}
@@ -0,0 +1,139 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+
+
+/**
+  @file StorageAccuracy_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_StorageAccuracy
+
+
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/machine/StorageAccuracy.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_select)
+{
+  openfluid::core::SpatialGraph SGraph;
+
+  auto* U1 = SGraph.addUnit(openfluid::core::SpatialUnit("TU",1,1));
+  auto* U2 = SGraph.addUnit(openfluid::core::SpatialUnit("TU",2,1));
+  auto* O1 = SGraph.addUnit(openfluid::core::SpatialUnit("OU",1,1));
+
+  U1->variables()->createVariable("var.double",openfluid::core::Value::DOUBLE);
+  U1->variables()->createVariable("var.string",openfluid::core::Value::STRING);
+  U2->variables()->createVariable("var.double",openfluid::core::Value::DOUBLE);
+  U2->variables()->createVariable("var.untyped");
+  O1->variables()->createVariable("var.int",openfluid::core::Value::INTEGER);
+  O1->variables()->createVariable("var.vector",openfluid::core::Value::VECTOR);
+
+  openfluid::machine::ResultsStore Store;
+  openfluid::machine::StorageAccuracy::selectVariables(SGraph,Store);
+
+  const auto Vars = Store.getVariables();
+  BOOST_REQUIRE_EQUAL(Vars.size(),3);
+  BOOST_REQUIRE(Store.table("TU","var.double") != nullptr);
+  BOOST_REQUIRE(Store.table("TU","var.untyped") != nullptr);
+  BOOST_REQUIRE(Store.table("OU","var.int") != nullptr);
+  BOOST_REQUIRE(Store.table("TU","var.string") == nullptr);
+  BOOST_REQUIRE(Store.table("OU","var.vector") == nullptr);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_compare)
+{
+  openfluid::machine::ResultsStore Stored;
+  openfluid::machine::ResultsStore Full;
+
+  for (auto* Store : {&Stored,&Full})
+  {
+    Store->addVariable("TU","var.reduced");
+    Store->addVariable("TU","var.derived");
+  }
+  Full.addVariable("TU","var.fullonly");
+
+  for (openfluid::core::TimeIndex_t Index = 0; Index <= 300; Index += 60)
+  {
+    Full.table("TU","var.reduced")->addValue(Index,1,Index*0.1);
+    Full.table("TU","var.reduced")->addValue(Index,2,-Index*0.1);
+    Full.table("TU","var.derived")->addValue(Index,1,Index);
+    Full.table("TU","var.fullonly")->addValue(Index,1,1.0);
+
+    // the stored run has no value at index 120
+    if (Index != 120)
+    {
+      Stored.table("TU","var.reduced")->addValue(Index,1,Index*0.1+0.001);
+      Stored.table("TU","var.reduced")->addValue(Index,2,-Index*0.1);
+      Stored.table("TU","var.derived")->addValue(Index,1,Index == 300 ? 330.0 : Index);
+    }
+  }
+
+  // missing values are not compared
+  Stored.table("TU","var.derived")->addValue(360,1,std::numeric_limits<double>::quiet_NaN());
+  Full.table("TU","var.derived")->addValue(360,1,1.0);
+
+  openfluid::fluidx::RunConfigurationDescriptor::VariablesStorage_t VarsStorage;
+  openfluid::fluidx::RunConfigurationDescriptor::VariableStorage Storage;
+  Storage.Precision = openfluid::core::ValuesBuffer::StoragePrecision::FLOAT32;
+  VarsStorage[{"TU","var.reduced"}] = Storage;
+
+  const auto Diffs = openfluid::machine::StorageAccuracy::compare(Stored,Full,VarsStorage);
+  BOOST_REQUIRE_EQUAL(Diffs.size(),2);
+
+  BOOST_REQUIRE_EQUAL(Diffs[0].VarName,"var.derived");
+  BOOST_REQUIRE(!Diffs[0].IsReduced);
+  BOOST_REQUIRE_EQUAL(Diffs[0].ComparedCount,5);
+  BOOST_REQUIRE_CLOSE(Diffs[0].MaxAbsDifference,30.0,1e-9);
+  BOOST_REQUIRE_CLOSE(Diffs[0].MaxRelDifference,0.1,1e-9);
+
+  BOOST_REQUIRE_EQUAL(Diffs[1].UnitsClass,"TU");
+  BOOST_REQUIRE_EQUAL(Diffs[1].VarName,"var.reduced");
+  BOOST_REQUIRE(Diffs[1].IsReduced);
+  BOOST_REQUIRE_EQUAL(Diffs[1].ComparedCount,10);
+  BOOST_REQUIRE_CLOSE(Diffs[1].MaxAbsDifference,0.001,1e-6);
+  BOOST_REQUIRE_CLOSE(Diffs[1].MaxRelDifference,0.001/6.0,1e-6);
+}
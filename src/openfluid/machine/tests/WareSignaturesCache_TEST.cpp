@@ -0,0 +1,254 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file WareSignaturesCache_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_waresignaturescache
+
+
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/machine/WareSignaturesCache.hpp>
+#include <openfluid/waresdev/SimulatorSignatureSerializer.hpp>
+#include <openfluid/tools/Filesystem.hpp>
+
+#include "tests-config.hpp"
+
+
+// =====================================================================
+// =====================================================================
+
+
+using SimCache_t = openfluid::machine::WareSignaturesCache<openfluid::ware::SimulatorSignature>;
+using SimContainer_t = openfluid::machine::WareContainer<openfluid::ware::SimulatorSignature>;
+
+
+std::unique_ptr<SimCache_t> createCache(const std::string& Path)
+{
+  return std::make_unique<SimCache_t>(Path,std::make_unique<openfluid::waresdev::SimulatorSignatureSerializer>());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_operations)
+{
+  const auto WorkDir = openfluid::tools::FilesystemPath({CONFIGTESTS_OUTPUT_DATA_DIR,"WareSignaturesCache"});
+  WorkDir.removeDirectory();
+  WorkDir.makeDirectory();
+
+  const std::string CacheFile = WorkDir.fromThis("cache/simulators-signatures.json").toGeneric();
+  const std::string PluginFile = WorkDir.fromThis("tests.sim_ofware-sim.so").toGeneric();
+  const std::string ErroredPluginFile = WorkDir.fromThis("tests.err_ofware-sim.so").toGeneric();
+
+  openfluid::tools::Filesystem::writeFile("fake plugin content",WorkDir.fromThis("tests.sim_ofware-sim.so"));
+  openfluid::tools::Filesystem::writeFile("errored plugin",WorkDir.fromThis("tests.err_ofware-sim.so"));
+
+
+  // storing and saving
+
+  {
+    auto Cache = createCache(CacheFile);
+
+    SimContainer_t Container(openfluid::ware::WareType::SIMULATOR);
+    BOOST_REQUIRE(!Cache->fetch(PluginFile,Container));
+
+    auto Sign = new openfluid::ware::SimulatorSignature();
+    Sign->ID = "tests.sim";
+    Sign->Name = "Test simulator";
+    Sign->BuildInfo.BuildType = "RELEASE";
+    Sign->SimulatorHandledData.ProducedVars.push_back(
+      openfluid::ware::SignatureSpatialDataItem("var.a[double]","TU","produced variable","m"));
+
+    Container.setPath(PluginFile);
+    Container.setSignature(Sign);
+    Container.setLinkUID("{123456}");
+    Container.validate();
+    Cache->store(Container);
+
+    SimContainer_t ErrContainer(openfluid::ware::WareType::SIMULATOR);
+    ErrContainer.setPath(ErroredPluginFile);
+    ErrContainer.setMessage("plugin ABI version mismatch");
+    ErrContainer.validate();
+    Cache->store(ErrContainer);
+
+    Cache->save();
+    BOOST_REQUIRE(openfluid::tools::FilesystemPath(CacheFile).isFile());
+  }
+
+
+  // fetching from saved cache
+
+  {
+    auto Cache = createCache(CacheFile);
+
+    SimContainer_t Container(openfluid::ware::WareType::SIMULATOR);
+    BOOST_REQUIRE(Cache->fetch(PluginFile,Container));
+    BOOST_REQUIRE(Container.isValid());
+    BOOST_REQUIRE(Container.hasSignature());
+    BOOST_REQUIRE_EQUAL(Container.getPath(),PluginFile);
+    BOOST_REQUIRE_EQUAL(Container.getLinkUID(),"{123456}");
+    BOOST_REQUIRE_EQUAL(Container.signature()->ID,"tests.sim");
+    BOOST_REQUIRE_EQUAL(Container.signature()->Name,"Test simulator");
+    BOOST_REQUIRE_EQUAL(Container.signature()->BuildInfo.BuildType,"RELEASE");
+    BOOST_REQUIRE_EQUAL(Container.signature()->SimulatorHandledData.ProducedVars.size(),1);
+
+    // loading failures are not cached
+    SimContainer_t ErrContainer(openfluid::ware::WareType::SIMULATOR);
+    BOOST_REQUIRE(!Cache->fetch(ErroredPluginFile,ErrContainer));
+    BOOST_REQUIRE(!ErrContainer.isValid());
+  }
+
+
+  // invalidation after plugin change
+
+  openfluid::tools::Filesystem::writeFile("modified fake plugin content",
+                                          WorkDir.fromThis("tests.sim_ofware-sim.so"));
+
+  {
+    auto Cache = createCache(CacheFile);
+
+    SimContainer_t Container(openfluid::ware::WareType::SIMULATOR);
+    BOOST_REQUIRE(!Cache->fetch(PluginFile,Container));
+    BOOST_REQUIRE(!Container.isValid());
+
+    Cache->setEnabled(false);
+    SimContainer_t ErrContainer(openfluid::ware::WareType::SIMULATOR);
+    BOOST_REQUIRE(!Cache->fetch(ErroredPluginFile,ErrContainer));
+  }
+
+
+  // removal of a cached plugin which fails to load (e.g. missing dependency)
+
+  {
+    auto Cache = createCache(CacheFile);
+
+    SimContainer_t Container(openfluid::ware::WareType::SIMULATOR);
+    auto Sign = new openfluid::ware::SimulatorSignature();
+    Sign->ID = "tests.sim";
+    Container.setPath(PluginFile);
+    Container.setSignature(Sign);
+    Container.validate();
+    Cache->store(Container);
+
+    SimContainer_t CachedContainer(openfluid::ware::WareType::SIMULATOR);
+    BOOST_REQUIRE(Cache->fetch(PluginFile,CachedContainer));
+
+    SimContainer_t FailedContainer(openfluid::ware::WareType::SIMULATOR);
+    FailedContainer.setPath(PluginFile);
+    FailedContainer.setMessage("libmissing.so: cannot open shared object file");
+    FailedContainer.validate();
+    Cache->store(FailedContainer);
+
+    SimContainer_t RefetchedContainer(openfluid::ware::WareType::SIMULATOR);
+    BOOST_REQUIRE(!Cache->fetch(PluginFile,RefetchedContainer));
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_concurrent_saves)
+{
+  const auto WorkDir = openfluid::tools::FilesystemPath({CONFIGTESTS_OUTPUT_DATA_DIR,"WareSignaturesCacheConcurrent"});
+  WorkDir.removeDirectory();
+  WorkDir.makeDirectory();
+
+  const std::string CacheFile = WorkDir.fromThis("cache/simulators-signatures.json").toGeneric();
+  const std::string PluginFile = WorkDir.fromThis("tests.sim_ofware-sim.so").toGeneric();
+  openfluid::tools::Filesystem::writeFile("fake plugin content",WorkDir.fromThis("tests.sim_ofware-sim.so"));
+
+  // several processes rewrite the same cache file at the same time
+
+  std::vector<pid_t> PIDs;
+
+  for (unsigned int p = 0; p < 4; p++)
+  {
+    const pid_t PID = fork();
+    BOOST_REQUIRE(PID >= 0);
+
+    if (PID == 0)
+    {
+      for (unsigned int i = 0; i < 25; i++)
+      {
+        auto Cache = createCache(CacheFile);
+        Cache->clear();
+
+        SimContainer_t Container(openfluid::ware::WareType::SIMULATOR);
+        auto Sign = new openfluid::ware::SimulatorSignature();
+        Sign->ID = "tests.sim";
+        Sign->Name = "Simulator saved by process "+std::to_string(p);
+        Container.setPath(PluginFile);
+        Container.setSignature(Sign);
+        Container.validate();
+        Cache->store(Container);
+        Cache->save();
+      }
+      _exit(0);
+    }
+
+    PIDs.push_back(PID);
+  }
+
+  for (const auto& PID : PIDs)
+  {
+    int Status = 0;
+    BOOST_REQUIRE_EQUAL(waitpid(PID,&Status,0),PID);
+    BOOST_REQUIRE(WIFEXITED(Status) && WEXITSTATUS(Status) == 0);
+  }
+
+  // the cache file is complete and no temporary file is left
+  const auto CacheDirFiles = openfluid::tools::Filesystem::findFiles(WorkDir.fromThis("cache").toGeneric());
+  BOOST_REQUIRE_EQUAL(CacheDirFiles.size(),1);
+  BOOST_REQUIRE_EQUAL(CacheDirFiles.front(),"simulators-signatures.json");
+
+  auto Cache = createCache(CacheFile);
+  SimContainer_t Container(openfluid::ware::WareType::SIMULATOR);
+  BOOST_REQUIRE(Cache->fetch(PluginFile,Container));
+  BOOST_REQUIRE_EQUAL(Container.signature()->ID,"tests.sim");
+}
@@ -107,6 +107,23 @@ inline openfluid::thirdparty::xml::XMLElement* prepareOpenFLUIDXMLDoc(xml::XMLDo
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Writes the XML declaration and opens the openfluid root element into an XML printer.
+  The produced output is the same as a document prepared using prepareOpenFLUIDXMLDoc().
+  The root element must be closed by the caller using the CloseElement() method of the printer
+*/
+inline void openOpenFLUIDXMLStream(xml::XMLPrinter& Printer, const std::string& FormatVersion)
+{
+  Printer.PushDeclaration("xml version=\"1.0\" encoding=\"UTF-8\"");
+  Printer.OpenElement("openfluid");
+  Printer.PushAttribute("format",FormatVersion.c_str());
+}
+
+
 } } // namespaces
 
 
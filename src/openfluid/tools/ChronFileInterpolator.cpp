@@ -128,6 +128,7 @@ void ChronFileInterpolator::loadInFile(ChronologicalSerie<double>& Data)
 
   double Value;
   openfluid::core::DateTime ZeDT;
+  const openfluid::core::DateTimeFormat InDateFormat(m_InDateFormat);
 
   Data.clear();
 
@@ -151,7 +152,7 @@ void ChronFileInterpolator::loadInFile(ChronologicalSerie<double>& Data)
     {
       if (FileParser.getStringValue(i,0,&DateStr) &&
           FileParser.getDoubleValue(i,1,&Value) &&
-          ZeDT.setFromString(DateStr,m_InDateFormat))
+          InDateFormat.parse(DateStr,ZeDT))
       {
 
         if (!std::isnan(Value) && !std::isinf(Value))
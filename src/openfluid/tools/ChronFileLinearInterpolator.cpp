@@ -86,6 +86,9 @@ void ChronFileLinearInterpolator::runInterpolation()
   long x,x1;
   double y,y0,y1;
 
+  const openfluid::core::DateTimeFormat OutDateFormat(m_OutDateFormat);
+  std::string DateStr;
+
   std::ofstream OutFile(m_OutFilePath.c_str());
 
   OutFile << std::setprecision(15);
@@ -107,7 +110,8 @@ void ChronFileLinearInterpolator::runInterpolation()
       y = openfluid::scientific::linearInterpolationFromXOrigin(y0,double(x1),y1,double(x));
     }
 
-    OutFile << CurrentDateTime.getAsString(m_OutDateFormat) << m_OutColumnSeparator << y << "\n";
+    OutDateFormat.format(CurrentDateTime,DateStr);
+    OutFile << DateStr << m_OutColumnSeparator << y << "\n";
 
     CurrentDateTime.addSeconds(m_DeltaT);
   }
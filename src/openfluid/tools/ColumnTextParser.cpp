@@ -38,13 +38,24 @@
 */
 
 
+// OpenFLUID:stylecheck:!incs
+// OpenFLUID:stylecheck:!inco
+
+
+#include <openfluid/global.hpp>
+
 #include <iostream>
 #include <fstream>
-
-#include <boost/algorithm/string.hpp>
-#include <boost/tokenizer.hpp>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <charconv>
+#include <cctype>
+#include <cstring>
+#include <thread>
 
 #include <openfluid/tools/ColumnTextParser.hpp>
+#include <openfluid/tools/MappedFile.hpp>
 #include <openfluid/tools/StringHelpers.hpp>
 #include <openfluid/tools/FilesystemPath.hpp>
 
@@ -56,11 +67,125 @@
 namespace openfluid { namespace tools {
 
 
-ColumnTextParser::ColumnTextParser(const std::string& CommentLineSymbol, const std::string& Delimiter):
-  m_Delimiter(Delimiter), m_CommentSymbol(CommentLineSymbol),
-  m_LinesCount(0), m_ColsCount(0)
+/**
+  Read-only text, either memory-mapped from a file or copied from a string
+*/
+class ColumnTextParser::TextBuffer
+{
+  private:
+
+    std::string m_Owned;
+
+    MappedFile m_Mapped;
+
+    const char* mp_Data;
+
+    std::size_t m_Size;
+
+
+  public:
+
+    TextBuffer() :
+      mp_Data(nullptr), m_Size(0)
+    { }
+
+    TextBuffer(const TextBuffer&) = delete;
+
+    TextBuffer& operator=(const TextBuffer&) = delete;
+
+    static std::shared_ptr<TextBuffer> fromString(const std::string& Str)
+    {
+      auto Buffer = std::make_shared<TextBuffer>();
+      Buffer->m_Owned = Str;
+      Buffer->mp_Data = Buffer->m_Owned.data();
+      Buffer->m_Size = Buffer->m_Owned.size();
+      return Buffer;
+    }
+
+    /**
+      Maps the given file in memory, falls back to reading it when it cannot be mapped
+      @return the text buffer, nullptr if the file cannot be read
+    */
+    static std::shared_ptr<TextBuffer> fromFile(const std::string& Filename)
+    {
+      auto Buffer = std::make_shared<TextBuffer>();
+
+      // the file is read once, from the beginning to the end
+      if (Buffer->m_Mapped.open(Filename,MappedFile::Access::SEQUENTIAL))
+      {
+        Buffer->mp_Data = Buffer->m_Mapped.data();
+        Buffer->m_Size = Buffer->m_Mapped.size();
+        return Buffer;
+      }
+
+      // empty or non mappable file
+      std::ifstream FileContent(Filename.c_str(),std::ios::in | std::ios::binary);
+
+      if (!FileContent)
+      {
+        return nullptr;
+      }
+
+      Buffer->m_Owned.assign(std::istreambuf_iterator<char>(FileContent),std::istreambuf_iterator<char>());
+      Buffer->mp_Data = Buffer->m_Owned.data();
+      Buffer->m_Size = Buffer->m_Owned.size();
+
+      return Buffer;
+    }
+
+    inline const char* data() const
+    {
+      return mp_Data;
+    }
+
+    inline std::size_t size() const
+    {
+      return m_Size;
+    }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Index of a range of the text, built independently by each indexing thread
+*/
+struct ColumnTextParser::ChunkIndex
 {
+  std::vector<FieldIndex> Fields;
+
+  std::vector<std::string> DecodedFields;
+
+  unsigned int LinesCount = 0;
+
+  unsigned int ColsCount = 0;
+
+  bool IsValid = true;
+
+  bool Delimiters[256] = {};
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+namespace {
+
+
+// minimal size of text for indexing in parallel
+constexpr std::size_t ParallelIndexingMinSize = 1 << 20;
+
+constexpr char EscapeChar = '\\';
+
+constexpr char QuoteChar = '"';
+
 
+inline bool isSpaceChar(char C)
+{
+  return (C == ' ' || C == '\t' || C == '\n' || C == '\r' || C == '\v' || C == '\f');
 }
 
 
@@ -68,9 +193,43 @@ ColumnTextParser::ColumnTextParser(const std::string& CommentLineSymbol, const s
 // =====================================================================
 
 
-ColumnTextParser::~ColumnTextParser()
+/**
+  Decodes a field containing quotes or escape sequences, following the boost::escaped_list_separator rules
+  @return false if the field contains an invalid escape sequence
+*/
+bool decodeField(const char* Begin, const char* End, const bool* Delimiters, std::string& Decoded)
 {
+  Decoded.clear();
+
+  for (const char* C = Begin; C != End; ++C)
+  {
+    if (*C == EscapeChar)
+    {
+      if (++C == End)
+      {
+        return false;
+      }
+
+      if (*C == 'n')
+      {
+        Decoded += '\n';
+      }
+      else if (*C == QuoteChar || *C == EscapeChar || Delimiters[static_cast<unsigned char>(*C)])
+      {
+        Decoded += *C;
+      }
+      else
+      {
+        return false;
+      }
+    }
+    else if (*C != QuoteChar)
+    {
+      Decoded += *C;
+    }
+  }
 
+  return true;
 }
 
 
@@ -78,22 +237,61 @@ ColumnTextParser::~ColumnTextParser()
 // =====================================================================
 
 
-std::vector<std::string> ColumnTextParser::tokenizeLine(const std::string& Line)
+/**
+  Converts a field to a numeric value, with the same rules as openfluid::tools::toNumeric()
+*/
+template<typename T>
+bool convertField(const char* Begin, const char* End, T& Value)
 {
-  std::vector<std::string> Splitted;
+#if defined(__cpp_lib_to_chars)
+  while (Begin != End && isSpaceChar(*Begin))
+  {
+    ++Begin;
+  }
 
-  boost::tokenizer<boost::escaped_list_separator<char>>
-    Tokenizer(Line, boost::escaped_list_separator<char>("\\",m_Delimiter,"\""));
+  if (Begin != End && *Begin == '+' && (Begin+1) != End && *(Begin+1) != '-')
+  {
+    ++Begin;
+  }
 
-  for (const auto& Token : Tokenizer)
+  if constexpr (std::is_floating_point<T>::value)
   {
-    if (!Token.empty())
+    // infinity and NaN are not accepted by streams
+    const char* First = (Begin != End && *Begin == '-') ? Begin+1 : Begin;
+    if (First == End || !(std::isdigit(static_cast<unsigned char>(*First)) || *First == '.'))
     {
-      Splitted.push_back(Token);
+      return false;
     }
   }
 
-  return Splitted;
+  T Converted;
+  const auto Result = std::from_chars(Begin,End,Converted);
+
+  if (Result.ec != std::errc() || Result.ptr != End)
+  {
+    return false;
+  }
+
+  Value = Converted;
+  return true;
+#else
+  return openfluid::tools::toNumeric(std::string(Begin,End),Value);
+#endif
+}
+
+
+}  // namespace
+
+
+// =====================================================================
+// =====================================================================
+
+
+ColumnTextParser::ColumnTextParser(const std::string& CommentLineSymbol, const std::string& Delimiter):
+  m_Delimiter(Delimiter), m_CommentSymbol(CommentLineSymbol),
+  m_LinesCount(0), m_ColsCount(0)
+{
+
 }
 
 
@@ -101,22 +299,93 @@ std::vector<std::string> ColumnTextParser::tokenizeLine(const std::string& Line)
 // =====================================================================
 
 
-std::vector<std::string> ColumnTextParser::tokenizeString(const std::string& Str)
+ColumnTextParser::~ColumnTextParser()
+{
+
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ColumnTextParser::clearContents()
 {
-  std::vector<std::string> Splitted;
+  mp_Text.reset();
+  m_Fields.clear();
+  m_DecodedFields.clear();
+  m_LinesCount = 0;
+  m_ColsCount = 0;
+}
+
+
+// =====================================================================
+// =====================================================================
+
 
-  boost::tokenizer<boost::escaped_list_separator<char>>
-    Tokenizer(Str, boost::escaped_list_separator<char>("\\",m_Delimiter,"\""));
+void ColumnTextParser::tokenizeRange(const char* Data, std::size_t Begin, std::size_t End, ChunkIndex& Chunk) const
+{
+  std::size_t Pos = Begin;
+  std::string Decoded;
 
-  for (const auto& Token : Tokenizer)
+  while (Pos < End && Chunk.IsValid)
   {
-    if (!Token.empty())
+    const std::size_t TokenBegin = Pos;
+    bool NeedsDecoding = false;
+    bool InQuote = false;
+
+    while (Pos < End)
+    {
+      const char C = Data[Pos];
+
+      if (C == EscapeChar)
+      {
+        NeedsDecoding = true;
+        Pos += 2;
+        continue;
+      }
+      else if (C == QuoteChar)
+      {
+        NeedsDecoding = true;
+        InQuote = !InQuote;
+      }
+      else if (!InQuote && Chunk.Delimiters[static_cast<unsigned char>(C)])
+      {
+        break;
+      }
+      ++Pos;
+    }
+
+    if (Pos > End)
     {
-      Splitted.push_back(Token);
+      // escape character at the end of the range
+      Chunk.IsValid = false;
+      return;
+    }
+
+    if (NeedsDecoding)
+    {
+      if (!decodeField(Data+TokenBegin,Data+Pos,Chunk.Delimiters,Decoded))
+      {
+        Chunk.IsValid = false;
+        return;
+      }
+
+      // empty tokens are ignored
+      if (!Decoded.empty())
+      {
+        Chunk.Fields.push_back({Chunk.DecodedFields.size(),static_cast<std::uint32_t>(Decoded.size()),true});
+        Chunk.DecodedFields.push_back(Decoded);
+      }
+    }
+    else if (Pos > TokenBegin)
+    {
+      Chunk.Fields.push_back({TokenBegin,static_cast<std::uint32_t>(Pos-TokenBegin),false});
     }
-  }
 
-  return Splitted;
+    // skips the delimiter
+    ++Pos;
+  }
 }
 
 
@@ -124,32 +393,50 @@ std::vector<std::string> ColumnTextParser::tokenizeString(const std::string& Str
 // =====================================================================
 
 
-bool ColumnTextParser::checkContents()
+void ColumnTextParser::indexRange(const char* Data, std::size_t Begin, std::size_t End, bool ByLines,
+                                  ChunkIndex& Chunk) const
 {
-  unsigned int LineColCount;
-  unsigned int LineCount = m_Contents.size();
+  for (const char& C : m_Delimiter)
+  {
+    Chunk.Delimiters[static_cast<unsigned char>(C)] = true;
+  }
 
-  if (LineCount == 0)
+  if (!ByLines)
   {
-    return true;
+    tokenizeRange(Data,Begin,End,Chunk);
+    return;
   }
 
-  // checks that all lines have the same size
-  // i.e. same columns number
-  LineColCount = m_Contents.at(0).size();
+  std::size_t LineBegin = Begin;
 
-  for (unsigned int i=1;i<LineCount;i++)
+  while (LineBegin < End && Chunk.IsValid)
   {
-    if (m_Contents.at(i).size() != LineColCount)
+    const char* LineEndPtr = static_cast<const char*>(std::memchr(Data+LineBegin,'\n',End-LineBegin));
+    const std::size_t LineEnd = LineEndPtr ? (LineEndPtr-Data) : End;
+
+    if (!isCommentLineStr(Data+LineBegin,Data+LineEnd) && !isEmptyLineStr(Data+LineBegin,Data+LineEnd))
     {
-      return false;
-    }
-  }
+      const std::size_t PreviousCount = Chunk.Fields.size();
 
-  m_LinesCount = m_Contents.size();
-  m_ColsCount = LineColCount;
+      tokenizeRange(Data,LineBegin,LineEnd,Chunk);
 
-  return true;
+      // checks that all lines have the same size, i.e. same columns number
+      const unsigned int LineColsCount = Chunk.Fields.size()-PreviousCount;
+
+      if (Chunk.LinesCount == 0)
+      {
+        Chunk.ColsCount = LineColsCount;
+      }
+      else if (LineColsCount != Chunk.ColsCount)
+      {
+        Chunk.IsValid = false;
+      }
+
+      Chunk.LinesCount++;
+    }
+
+    LineBegin = LineEnd+1;
+  }
 }
 
 
@@ -157,17 +444,20 @@ bool ColumnTextParser::checkContents()
 // =====================================================================
 
 
-bool ColumnTextParser::isCommentLineStr(const std::string& LineStr)
+bool ColumnTextParser::isCommentLineStr(const char* Begin, const char* End) const
 {
-
   if (m_CommentSymbol.length() > 0)
   {
-    std::string TmpStr = boost::trim_left_copy(LineStr);
-    return boost::starts_with(TmpStr,m_CommentSymbol.c_str());
+    while (Begin != End && isSpaceChar(*Begin))
+    {
+      ++Begin;
+    }
+
+    return (static_cast<std::size_t>(End-Begin) >= m_CommentSymbol.length() &&
+            std::equal(m_CommentSymbol.begin(),m_CommentSymbol.end(),Begin));
   }
 
   return false;
-
 }
 
 
@@ -175,9 +465,9 @@ bool ColumnTextParser::isCommentLineStr(const std::string& LineStr)
 // =====================================================================
 
 
-bool ColumnTextParser::isEmptyLineStr(const std::string& LineStr)
+bool ColumnTextParser::isEmptyLineStr(const char* Begin, const char* End) const
 {
-  return (boost::trim_copy(LineStr).empty());
+  return std::all_of(Begin,End,isSpaceChar);
 }
 
 
@@ -187,41 +477,112 @@ bool ColumnTextParser::isEmptyLineStr(const std::string& LineStr)
 
 bool ColumnTextParser::loadFromFile(const std::string& Filename)
 {
+  clearContents();
 
-  std::string StrLine;
-
-  if (m_Contents.size()> 0 )
+  // check if file exists
+  if (!openfluid::tools::FilesystemPath(Filename).isFile())
   {
-    m_Contents.clear();
+    return false;
   }
 
-  m_LinesCount = 0;
-  m_ColsCount = 0;
+  // check if file is "openable"
+  std::shared_ptr<const TextBuffer> Text = TextBuffer::fromFile(Filename);
 
-  // check if file exists
-  if (!openfluid::tools::FilesystemPath(Filename).isFile())
+  if (!Text)
   {
     return false;
   }
 
-  std::ifstream FileContent(Filename.c_str());
+  const char* Data = Text->data();
+  const std::size_t Size = Text->size();
 
-  // check if file is "openable"
-  if (!FileContent)
+  // splits the text into chunks of whole lines
+  unsigned int ChunksCount = 1;
+  if (Size >= ParallelIndexingMinSize)
   {
-    return false;
+    ChunksCount = std::max(1U,std::min(std::thread::hardware_concurrency(),
+                                       static_cast<unsigned int>(Size/ParallelIndexingMinSize)));
+  }
+
+  std::vector<std::size_t> Bounds = {0};
+  for (unsigned int i=1; i<ChunksCount; i++)
+  {
+    std::size_t Pos = std::max(Bounds.back(),(Size/ChunksCount)*i);
+    const char* LineEndPtr = static_cast<const char*>(std::memchr(Data+Pos,'\n',Size-Pos));
+
+    if (LineEndPtr)
+    {
+      Bounds.push_back(LineEndPtr-Data+1);
+    }
   }
+  Bounds.push_back(Size);
 
-  // parse and loads file contents
-  while(std::getline(FileContent,StrLine))
+  std::vector<ChunkIndex> Chunks(Bounds.size()-1);
+
+  if (Chunks.size() == 1)
+  {
+    indexRange(Data,0,Size,true,Chunks.front());
+  }
+  else
+  {
+    std::vector<std::thread> Threads;
+
+    for (unsigned int i=0; i<Chunks.size(); i++)
+    {
+      Threads.push_back(std::thread(&ColumnTextParser::indexRange,this,Data,Bounds[i],Bounds[i+1],true,
+                                    std::ref(Chunks[i])));
+    }
+
+    for (auto& Thread : Threads)
+    {
+      Thread.join();
+    }
+  }
+
+  // merges the chunks indexes
+  unsigned int LinesCount = 0;
+  unsigned int ColsCount = 0;
+  std::size_t FieldsCount = 0;
+
+  for (const auto& Chunk : Chunks)
+  {
+    if (!Chunk.IsValid || (Chunk.LinesCount && LinesCount && Chunk.ColsCount != ColsCount))
+    {
+      return false;
+    }
+
+    if (Chunk.LinesCount && !LinesCount)
+    {
+      ColsCount = Chunk.ColsCount;
+    }
+
+    LinesCount += Chunk.LinesCount;
+    FieldsCount += Chunk.Fields.size();
+  }
+
+  m_Fields.reserve(FieldsCount);
+
+  for (auto& Chunk : Chunks)
   {
-    if (!isCommentLineStr(StrLine) && !isEmptyLineStr(StrLine))
+    const std::size_t DecodedOffset = m_DecodedFields.size();
+
+    for (auto& Field : Chunk.Fields)
     {
-      m_Contents.push_back(ColumnTextParser::tokenizeLine(StrLine));
+      if (Field.IsDecoded)
+      {
+        Field.Offset += DecodedOffset;
+      }
+      m_Fields.push_back(Field);
     }
+
+    std::move(Chunk.DecodedFields.begin(),Chunk.DecodedFields.end(),std::back_inserter(m_DecodedFields));
   }
 
-  return checkContents();
+  mp_Text = Text;
+  m_LinesCount = LinesCount;
+  m_ColsCount = ColsCount;
+
+  return true;
 }
 
 
@@ -238,52 +599,62 @@ bool ColumnTextParser::setFromString(const std::string& Contents, unsigned int C
 
   */
 
+  clearContents();
+
+  if (ColumnsNbr == 0)
+  {
+    return false;
+  }
+
+  std::shared_ptr<const TextBuffer> Text = TextBuffer::fromString(Contents);
 
-  std::vector<std::string>::iterator it;
+  ChunkIndex Chunk;
+  indexRange(Text->data(),0,Text->size(),false,Chunk);
 
-  bool IsOK = true;
+  // more tokens processed but not a complete line. not good!
+  if (!Chunk.IsValid || Chunk.Fields.size() % ColumnsNbr != 0)
+  {
+    return false;
+  }
 
-  std::vector<std::string> Tokens = ColumnTextParser::tokenizeString(Contents);
+  mp_Text = Text;
+  m_Fields = std::move(Chunk.Fields);
+  m_DecodedFields = std::move(Chunk.DecodedFields);
 
-  if (Tokens.size() % ColumnsNbr == 0)
+  if (!m_Fields.empty())
   {
+    m_LinesCount = m_Fields.size()/ColumnsNbr;
+    m_ColsCount = ColumnsNbr;
+  }
 
-    if (m_Contents.size() > 0)
-    {
-      m_Contents.clear();
-    }
+  return true;
+}
 
-    std::vector<std::string> LineStr;
 
-    it = Tokens.begin();
-    while (it != Tokens.end() && IsOK)
-    {
-      // add to the current line
-      LineStr.push_back(*it);
+// =====================================================================
+// =====================================================================
 
-      if (LineStr.size() == ColumnsNbr)
-      {
-        // if current line has ColumnsNbr columns, it is added to the contents
-        m_Contents.push_back(LineStr);
 
-        LineStr.clear();
-      }
+bool ColumnTextParser::getField(unsigned int Line, unsigned int Column, const char*& Begin, const char*& End) const
+{
+  if (Line >= m_LinesCount || Column >= m_ColsCount)
+  {
+    return false;
+  }
 
-      ++it;
-    }
+  const FieldIndex& Field = m_Fields[static_cast<std::size_t>(Line)*m_ColsCount+Column];
 
-    // more tokens processed but not a complete line. not good!
-    if (LineStr.size() != 0 && LineStr.size() != ColumnsNbr)
-    {
-      IsOK = false;
-    }
+  if (Field.IsDecoded)
+  {
+    Begin = m_DecodedFields[Field.Offset].data();
   }
   else
   {
-    IsOK = false;
+    Begin = mp_Text->data()+Field.Offset;
   }
+  End = Begin+Field.Length;
 
-  return IsOK && checkContents();
+  return true;
 }
 
 
@@ -293,12 +664,19 @@ bool ColumnTextParser::setFromString(const std::string& Contents, unsigned int C
 
 std::vector<std::string> ColumnTextParser::getValues(unsigned int Line) const
 {
-  if (Line < m_Contents.size())
+  std::vector<std::string> Values;
+
+  if (Line < m_LinesCount)
   {
-    return m_Contents.at(Line);
+    Values.reserve(m_ColsCount);
+
+    for (unsigned int i=0; i<m_ColsCount; i++)
+    {
+      Values.push_back(getValue(Line,i));
+    }
   }
 
-  return std::vector<std::string>();
+  return Values;
 }
 
 
@@ -308,11 +686,12 @@ std::vector<std::string> ColumnTextParser::getValues(unsigned int Line) const
 
 std::string ColumnTextParser::getValue(unsigned int Line, unsigned int Column) const
 {
-  std::vector<std::string> LineString = getValues(Line);
+  const char* Begin;
+  const char* End;
 
-  if (!LineString.empty() && Column < LineString.size())
+  if (getField(Line,Column,Begin,End))
   {
-    return LineString.at(Column);
+    return std::string(Begin,End);
   }
 
   return "";
@@ -326,14 +705,15 @@ std::string ColumnTextParser::getValue(unsigned int Line, unsigned int Column) c
 bool ColumnTextParser::getStringValue(unsigned int Line, unsigned int Column,
                                       std::string *Value) const
 {
-  std::string StrValue = getValue(Line,Column);
+  const char* Begin;
+  const char* End;
 
-  if (StrValue.length() == 0)
+  if (!getField(Line,Column,Begin,End))
   {
     return false;
   }
 
-  *Value = StrValue;
+  Value->assign(Begin,End);
 
   return true;
 
@@ -346,11 +726,12 @@ bool ColumnTextParser::getStringValue(unsigned int Line, unsigned int Column,
 
 bool ColumnTextParser::getLongValue(unsigned int Line, unsigned int Column, long* Value) const
 {
-  std::string StrValue = getValue(Line,Column);
+  const char* Begin;
+  const char* End;
 
-  if (StrValue.length() != 0)
+  if (getField(Line,Column,Begin,End))
   {
-    return openfluid::tools::toNumeric(StrValue,(*Value));
+    return convertField(Begin,End,(*Value));
   }
 
   return false;
@@ -363,12 +744,12 @@ bool ColumnTextParser::getLongValue(unsigned int Line, unsigned int Column, long
 
 bool ColumnTextParser::getDoubleValue(unsigned int Line, unsigned int Column, double* Value) const
 {
+  const char* Begin;
+  const char* End;
 
-  std::string StrValue = getValue(Line,Column);
-
-  if (StrValue.length() != 0)
+  if (getField(Line,Column,Begin,End))
   {
-    return openfluid::tools::toNumeric(StrValue,(*Value));
+    return convertField(Begin,End,(*Value));
   }
 
   return false;
@@ -398,4 +779,3 @@ void ColumnTextParser::streamContents(std::ostream& OStream) const
 
 
 } }
-
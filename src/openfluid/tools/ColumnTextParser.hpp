@@ -43,6 +43,8 @@
 
 #include <vector>
 #include <string>
+#include <memory>
+#include <cstdint>
 
 #include <openfluid/dllexport.hpp>
 
@@ -51,7 +53,9 @@ namespace openfluid { namespace tools {
 
 
 /**
-  Class for column file management and handling
+  Class for column file management and handling.
+  Contents are indexed once at loading time, storing only the position of each field in the text,
+  the text itself being memory-mapped when loaded from a file. Fields are converted on demand.
 */
 class OPENFLUID_API ColumnTextParser
 {
@@ -60,6 +64,22 @@ class OPENFLUID_API ColumnTextParser
 
   private:
 
+    class TextBuffer;
+
+    /**
+      Position of a field, either in the text buffer or in the decoded fields for quoted or escaped fields
+    */
+    struct FieldIndex
+    {
+      std::size_t Offset;
+
+      std::uint32_t Length;
+
+      bool IsDecoded;
+    };
+
+    struct ChunkIndex;
+
     std::string m_Delimiter;
 
     std::string m_CommentSymbol;
@@ -68,17 +88,23 @@ class OPENFLUID_API ColumnTextParser
     
     unsigned int m_ColsCount;
 
-    std::vector<std::vector<std::string> > m_Contents;
+    std::shared_ptr<const TextBuffer> mp_Text;
+
+    std::vector<FieldIndex> m_Fields;
+
+    std::vector<std::string> m_DecodedFields;
+
+    void clearContents();
 
-    std::vector<std::string> tokenizeLine(const std::string& Line);
+    void indexRange(const char* Data, std::size_t Begin, std::size_t End, bool ByLines, ChunkIndex& Chunk) const;
 
-    std::vector<std::string> tokenizeString(const std::string& String);
+    void tokenizeRange(const char* Data, std::size_t Begin, std::size_t End, ChunkIndex& Chunk) const;
 
-    bool checkContents();
+    bool isCommentLineStr(const char* Begin, const char* End) const;
 
-    bool isCommentLineStr(const std::string& LineStr);
+    bool isEmptyLineStr(const char* Begin, const char* End) const;
 
-    bool isEmptyLineStr(const std::string& LineStr);
+    bool getField(unsigned int Line, unsigned int Column, const char*& Begin, const char*& End) const;
 
 
   public:
@@ -95,7 +121,8 @@ class OPENFLUID_API ColumnTextParser
 
 
     /**
-      Loads a column text file
+      Loads a column text file.
+      The file is memory-mapped and large files are indexed in parallel
       @param[in] Filename the full path of the file to load
       @return true if everything went fine
     */
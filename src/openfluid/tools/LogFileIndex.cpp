@@ -0,0 +1,616 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file LogFileIndex.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <string_view>
+
+#include <openfluid/tools/LogFileIndex.hpp>
+#include <openfluid/tools/FilesystemPath.hpp>
+
+
+namespace openfluid { namespace tools {
+
+
+namespace {
+
+
+/**
+  Size of the shortest indexable line, "[t][]"
+*/
+constexpr std::size_t MinLineSize = 5;
+
+/**
+  Count of indexed lines between two publications of the indexing progress
+*/
+constexpr std::size_t PublishedLinesStep = 4096;
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Positions of the parts of a log line
+*/
+struct LineParts
+{
+  std::string_view Type;
+
+  std::string_view Context;
+
+  std::string_view Text;
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool splitLine(std::string_view Line, LineParts& Parts)
+{
+  if (Line.size() < MinLineSize || Line[0] != '[')
+  {
+    return false;
+  }
+
+  const std::size_t TypeEnd = Line.find(']',1);
+  if (TypeEnd == std::string_view::npos || TypeEnd+1 >= Line.size() || Line[TypeEnd+1] != '[')
+  {
+    return false;
+  }
+
+  const std::size_t ContextEnd = Line.find(']',TypeEnd+2);
+  if (ContextEnd == std::string_view::npos)
+  {
+    return false;
+  }
+
+  Parts.Type = Line.substr(1,TypeEnd-1);
+  Parts.Context = Line.substr(TypeEnd+2,ContextEnd-TypeEnd-2);
+  Parts.Text = Line.substr(ContextEnd+1);
+
+  if (!Parts.Text.empty() && Parts.Text[0] == ' ')
+  {
+    Parts.Text.remove_prefix(1);
+  }
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Calls the given function for each key=value pair of the context
+*/
+template<typename FuncT>
+void forEachContextPair(std::string_view Context, const FuncT& Func)
+{
+  while (!Context.empty())
+  {
+    const std::size_t PairEnd = std::min(Context.find(','),Context.size());
+    const std::string_view Pair = Context.substr(0,PairEnd);
+    const std::size_t Equal = Pair.find('=');
+
+    if (Equal != std::string_view::npos && Pair.find('=',Equal+1) == std::string_view::npos)
+    {
+      Func(Pair.substr(0,Equal),Pair.substr(Equal+1));
+    }
+
+    Context.remove_prefix(std::min(PairEnd+1,Context.size()));
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::uint16_t findOrAddName(const std::string& Name, std::unordered_map<std::string,std::uint16_t>& Indexes,
+                            std::vector<std::string>& Names, std::mutex& NamesMutex, std::uint16_t Unknown)
+{
+  const auto it = Indexes.find(Name);
+
+  if (it != Indexes.end())
+  {
+    return it->second;
+  }
+
+  if (Names.size() >= Unknown)
+  {
+    return Unknown;
+  }
+
+  std::lock_guard<std::mutex> Lock(NamesMutex);
+  Names.push_back(Name);
+  Indexes[Name] = Names.size()-1;
+
+  return Names.size()-1;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<std::string> sortedCopy(const std::vector<std::string>& Names, std::mutex& NamesMutex)
+{
+  std::lock_guard<std::mutex> Lock(NamesMutex);
+
+  std::vector<std::string> Sorted(Names);
+  std::sort(Sorted.begin(),Sorted.end());
+
+  return Sorted;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<char> allowedNames(const std::vector<std::string>& Names, const std::set<std::string>& Allowed)
+{
+  std::vector<char> Flags(Names.size(),0);
+
+  for (std::size_t i = 0; i < Names.size(); i++)
+  {
+    Flags[i] = Allowed.count(Names[i]);
+  }
+
+  return Flags;
+}
+
+
+}  // namespace
+
+
+// =====================================================================
+// =====================================================================
+
+
+LogFileIndex::LogFileIndex() :
+  m_MessagesCount(0), m_IndexedSize(0), m_IsCompleted(false), m_IsStopRequested(false)
+{
+
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+LogFileIndex::~LogFileIndex()
+{
+  close();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool LogFileIndex::open(const std::string& FilePath)
+{
+  close();
+
+  std::error_code ErrCode;
+  const auto FileSize = std::filesystem::file_size(FilesystemPath(FilePath).stdPath(),ErrCode);
+
+  if (ErrCode)
+  {
+    return false;
+  }
+
+  // empty files cannot be mapped and do not contain any message
+  if (!FileSize)
+  {
+    m_IsCompleted = true;
+    return true;
+  }
+
+  if (!m_File.open(FilePath))
+  {
+    return false;
+  }
+
+  m_Blocks.resize(m_File.size()/MinLineSize/RecordsPerBlock+1);
+
+  m_IndexingThread = std::thread(&LogFileIndex::buildIndex,this);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void LogFileIndex::close()
+{
+  m_IsStopRequested = true;
+
+  if (m_IndexingThread.joinable())
+  {
+    m_IndexingThread.join();
+  }
+
+  m_File.close();
+  m_Blocks.clear();
+
+  m_MessagesCount = 0;
+  m_IndexedSize = 0;
+  m_IsCompleted = false;
+  m_IsStopRequested = false;
+
+  std::lock_guard<std::mutex> Lock(m_NamesMutex);
+  m_Types.clear();
+  m_Simulators.clear();
+  m_Observers.clear();
+  m_SimulatorsIndex.clear();
+  m_ObserversIndex.clear();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void LogFileIndex::waitForCompletion()
+{
+  if (m_IndexingThread.joinable())
+  {
+    m_IndexingThread.join();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool LogFileIndex::indexLine(std::size_t Offset, std::size_t Length, Record& Rec)
+{
+  LineParts Parts;
+
+  if (!splitLine(std::string_view(m_File.data()+Offset,Length),Parts) || Parts.Type.empty())
+  {
+    return false;
+  }
+
+  std::string_view SourceStr, WareTypeStr, WareIDStr;
+
+  forEachContextPair(Parts.Context,[&](std::string_view Key, std::string_view Value)
+  {
+    if (Key == "source")
+    {
+      SourceStr = Value;
+    }
+    else if (Key == "waretype")
+    {
+      WareTypeStr = Value;
+    }
+    else if (Key == "wareid")
+    {
+      WareIDStr = Value;
+    }
+  });
+
+  // messages without source are not displayable
+  if (SourceStr.empty())
+  {
+    return false;
+  }
+
+  const auto TypeIt = std::find(m_Types.begin(),m_Types.end(),Parts.Type);
+  if (TypeIt != m_Types.end())
+  {
+    Rec.TypeIndex = std::distance(m_Types.begin(),TypeIt);
+  }
+  else if (m_Types.size() <= std::numeric_limits<std::uint8_t>::max())
+  {
+    std::lock_guard<std::mutex> Lock(m_NamesMutex);
+    m_Types.emplace_back(Parts.Type);
+    Rec.TypeIndex = m_Types.size()-1;
+  }
+  else
+  {
+    return false;
+  }
+
+  Rec.Offset = Offset;
+  Rec.Length = std::min(Length,std::size_t(std::numeric_limits<std::uint32_t>::max()));
+  Rec.WareIndex = UnknownWare;
+  Rec.Src = Source::UNKNOWN;
+
+  if (SourceStr == "app")
+  {
+    Rec.Src = Source::APP;
+  }
+  else if (SourceStr == "framework")
+  {
+    Rec.Src = Source::FRAMEWORK;
+  }
+  else if (SourceStr == "ware")
+  {
+    Rec.Src = Source::WARE;
+
+    if (!WareIDStr.empty())
+    {
+      if (WareTypeStr == "simulator")
+      {
+        Rec.Src = Source::SIMULATOR;
+        Rec.WareIndex = findOrAddName(std::string(WareIDStr),m_SimulatorsIndex,m_Simulators,m_NamesMutex,
+                                      UnknownWare);
+      }
+      else if (WareTypeStr == "observer")
+      {
+        Rec.Src = Source::OBSERVER;
+        Rec.WareIndex = findOrAddName(std::string(WareIDStr),m_ObserversIndex,m_Observers,m_NamesMutex,
+                                      UnknownWare);
+      }
+    }
+  }
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void LogFileIndex::buildIndex()
+{
+  const char* Data = m_File.data();
+  const std::size_t Size = m_File.size();
+
+  std::size_t Count = 0;
+  std::size_t Offset = 0;
+
+  while (Offset < Size && !m_IsStopRequested)
+  {
+    const char* LineEnd = static_cast<const char*>(std::memchr(Data+Offset,'\n',Size-Offset));
+    const std::size_t NextOffset = LineEnd ? (LineEnd-Data)+1 : Size;
+
+    std::size_t Length = NextOffset-Offset;
+    while (Length && (Data[Offset+Length-1] == '\n' || Data[Offset+Length-1] == '\r'))
+    {
+      Length--;
+    }
+
+    const std::size_t BlockIndex = Count/RecordsPerBlock;
+    if (!m_Blocks[BlockIndex])
+    {
+      m_Blocks[BlockIndex].reset(new Record[RecordsPerBlock]);
+    }
+
+    if (indexLine(Offset,Length,m_Blocks[BlockIndex][Count%RecordsPerBlock]))
+    {
+      Count++;
+
+      if (Count % PublishedLinesStep == 0)
+      {
+        m_MessagesCount = Count;
+        m_IndexedSize = NextOffset;
+      }
+    }
+
+    Offset = NextOffset;
+  }
+
+  m_MessagesCount = Count;
+  m_IndexedSize = Offset;
+  m_IsCompleted = !m_IsStopRequested;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+double LogFileIndex::getProgress() const
+{
+  if (m_IsCompleted || !m_File.size())
+  {
+    return 1.0;
+  }
+
+  return double(m_IndexedSize)/double(m_File.size());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::string LogFileIndex::getType(std::size_t Index) const
+{
+  std::lock_guard<std::mutex> Lock(m_NamesMutex);
+
+  return m_Types[record(Index).TypeIndex];
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::string LogFileIndex::getWareID(std::size_t Index) const
+{
+  const Record& Rec = record(Index);
+
+  if (Rec.WareIndex == UnknownWare)
+  {
+    return std::string();
+  }
+
+  std::lock_guard<std::mutex> Lock(m_NamesMutex);
+
+  if (Rec.Src == Source::SIMULATOR)
+  {
+    return m_Simulators[Rec.WareIndex];
+  }
+  else if (Rec.Src == Source::OBSERVER)
+  {
+    return m_Observers[Rec.WareIndex];
+  }
+
+  return std::string();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+LogFileIndex::Message LogFileIndex::getMessage(std::size_t Index) const
+{
+  const Record& Rec = record(Index);
+
+  LineParts Parts;
+  splitLine(std::string_view(m_File.data()+Rec.Offset,Rec.Length),Parts);
+
+  Message Msg;
+  Msg.Type = std::string(Parts.Type);
+  Msg.Text = std::string(Parts.Text);
+
+  forEachContextPair(Parts.Context,[&Msg](std::string_view Key, std::string_view Value)
+  {
+    Msg.Context[std::string(Key)] = std::string(Value);
+  });
+
+  return Msg;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<std::string> LogFileIndex::getTypes() const
+{
+  return sortedCopy(m_Types,m_NamesMutex);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<std::string> LogFileIndex::getSimulators() const
+{
+  return sortedCopy(m_Simulators,m_NamesMutex);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<std::string> LogFileIndex::getObservers() const
+{
+  return sortedCopy(m_Observers,m_NamesMutex);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<std::size_t> LogFileIndex::filter(const Filter& Filt, std::size_t From, std::size_t To) const
+{
+  To = std::min(To,getMessagesCount());
+
+  std::vector<char> AllowedTypes, AllowedSimulators, AllowedObservers;
+
+  {
+    // names of the messages already indexed are known when the count of messages is read
+    std::lock_guard<std::mutex> Lock(m_NamesMutex);
+
+    AllowedTypes = allowedNames(m_Types,Filt.Types);
+    AllowedSimulators = allowedNames(m_Simulators,Filt.Simulators);
+    AllowedObservers = allowedNames(m_Observers,Filt.Observers);
+  }
+
+  std::vector<std::size_t> Kept;
+
+  for (std::size_t i = From; i < To; i++)
+  {
+    const Record& Rec = record(i);
+
+    if (!AllowedTypes[Rec.TypeIndex])
+    {
+      continue;
+    }
+
+    bool IsKept = true;
+
+    switch (Rec.Src)
+    {
+      case Source::APP:
+        IsKept = Filt.WithApp;
+        break;
+      case Source::FRAMEWORK:
+        IsKept = Filt.WithFramework;
+        break;
+      case Source::SIMULATOR:
+        IsKept = (Rec.WareIndex != UnknownWare && AllowedSimulators[Rec.WareIndex]);
+        break;
+      case Source::OBSERVER:
+        IsKept = (Rec.WareIndex != UnknownWare && AllowedObservers[Rec.WareIndex]);
+        break;
+      default:
+        break;
+    }
+
+    if (IsKept)
+    {
+      Kept.push_back(i);
+    }
+  }
+
+  return Kept;
+}
+
+
+} }  // namespaces
@@ -0,0 +1,264 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file LogFileIndex.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_TOOLS_LOGFILEINDEX_HPP__
+#define __OPENFLUID_TOOLS_LOGFILEINDEX_HPP__
+
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/tools/MappedFile.hpp>
+
+
+namespace openfluid { namespace tools {
+
+
+/**
+  Index of the messages of a log file written by a FileLogger, formatted as "[type][context] message".
+  The log file is memory-mapped and indexed in a background thread, storing only the position, the type
+  and the source of each message. Messages are parsed on demand, and can be accessed while the indexing
+  is still running, up to the count of messages already indexed.
+*/
+class OPENFLUID_API LogFileIndex
+{
+  public:
+
+    enum class Source : std::uint8_t { UNKNOWN, APP, FRAMEWORK, SIMULATOR, OBSERVER, WARE };
+
+    struct Message
+    {
+      std::string Type;
+
+      /**
+        Context of the message, as key=value pairs
+      */
+      std::map<std::string,std::string> Context;
+
+      std::string Text;
+    };
+
+    /**
+      Messages to keep when filtering: messages of the given types, sent by the application and the framework
+      if enabled, sent by the given simulators and observers. Messages sent by other wares are always kept.
+    */
+    struct Filter
+    {
+      std::set<std::string> Types;
+
+      bool WithApp = true;
+
+      bool WithFramework = true;
+
+      std::set<std::string> Simulators;
+
+      std::set<std::string> Observers;
+    };
+
+
+  private:
+
+    struct Record
+    {
+      std::uint64_t Offset;
+
+      std::uint32_t Length;
+
+      /**
+        Index of the ware in the simulators or observers names, depending on the source
+      */
+      std::uint16_t WareIndex;
+
+      std::uint8_t TypeIndex;
+
+      Source Src;
+    };
+
+    static constexpr std::size_t RecordsPerBlock = 65536;
+
+    static constexpr std::uint16_t UnknownWare = 0xFFFF;
+
+    MappedFile m_File;
+
+    /**
+      Blocks of records, the blocks table is sized at opening for the largest possible count of messages
+      and the blocks are allocated while indexing, so that indexed records never move
+    */
+    std::vector<std::unique_ptr<Record[]>> m_Blocks;
+
+    std::atomic<std::size_t> m_MessagesCount;
+
+    std::atomic<std::size_t> m_IndexedSize;
+
+    std::atomic<bool> m_IsCompleted;
+
+    std::atomic<bool> m_IsStopRequested;
+
+    std::thread m_IndexingThread;
+
+    mutable std::mutex m_NamesMutex;
+
+    std::vector<std::string> m_Types;
+
+    std::vector<std::string> m_Simulators;
+
+    std::vector<std::string> m_Observers;
+
+    std::unordered_map<std::string,std::uint16_t> m_SimulatorsIndex;
+
+    std::unordered_map<std::string,std::uint16_t> m_ObserversIndex;
+
+
+    void buildIndex();
+
+    bool indexLine(std::size_t Offset, std::size_t Length, Record& Rec);
+
+    inline const Record& record(std::size_t Index) const
+    {
+      return m_Blocks[Index/RecordsPerBlock][Index%RecordsPerBlock];
+    }
+
+
+  public:
+
+    LogFileIndex();
+
+    ~LogFileIndex();
+
+    LogFileIndex(const LogFileIndex&) = delete;
+
+    LogFileIndex& operator=(const LogFileIndex&) = delete;
+
+    /**
+      Opens the given log file and starts its indexing in background, closing the previously opened file if any
+      @param[in] FilePath the path of the log file
+      @return false if the file does not exist or cannot be read
+    */
+    bool open(const std::string& FilePath);
+
+    /**
+      Stops the indexing if running and closes the log file
+    */
+    void close();
+
+    inline bool isCompleted() const
+    {
+      return m_IsCompleted;
+    }
+
+    /**
+      Waits for the end of the indexing
+    */
+    void waitForCompletion();
+
+    /**
+      Returns the count of messages indexed so far
+    */
+    inline std::size_t getMessagesCount() const
+    {
+      return m_MessagesCount;
+    }
+
+    /**
+      Returns the ratio of the log file already indexed, from 0 to 1
+    */
+    double getProgress() const;
+
+    /**
+      @param[in] Index the index of an indexed message
+    */
+    std::string getType(std::size_t Index) const;
+
+    /**
+      @param[in] Index the index of an indexed message
+    */
+    inline Source getSource(std::size_t Index) const
+    {
+      return record(Index).Src;
+    }
+
+    /**
+      @param[in] Index the index of an indexed message
+      @return the ID of the simulator or observer which sent the message, empty for other sources
+    */
+    std::string getWareID(std::size_t Index) const;
+
+    /**
+      Parses the given message from the log file
+      @param[in] Index the index of an indexed message
+    */
+    Message getMessage(std::size_t Index) const;
+
+    /**
+      Returns the sorted types of the messages indexed so far
+    */
+    std::vector<std::string> getTypes() const;
+
+    /**
+      Returns the sorted IDs of the simulators which sent the messages indexed so far
+    */
+    std::vector<std::string> getSimulators() const;
+
+    /**
+      Returns the sorted IDs of the observers which sent the messages indexed so far
+    */
+    std::vector<std::string> getObservers() const;
+
+    /**
+      Returns the indexes of the messages kept by the given filter, evaluated on the index only
+      @param[in] Filt the filter to apply
+      @param[in] From the index of the first message to filter
+      @param[in] To the index after the last message to filter, bounded by the count of indexed messages
+    */
+    std::vector<std::size_t> filter(const Filter& Filt, std::size_t From, std::size_t To) const;
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_TOOLS_LOGFILEINDEX_HPP__ */
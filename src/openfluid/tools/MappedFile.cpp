@@ -0,0 +1,167 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file MappedFile.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <openfluid/global.hpp>
+
+#if defined(OPENFLUID_OS_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <openfluid/tools/MappedFile.hpp>
+
+
+namespace openfluid { namespace tools {
+
+
+MappedFile::MappedFile() :
+  mp_Data(nullptr), m_Size(0)
+#if defined(OPENFLUID_OS_WINDOWS)
+  , m_MappingHandle(nullptr)
+#endif
+{
+
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool MappedFile::open(const std::string& FilePath, Access Hint)
+{
+  close();
+
+#if defined(OPENFLUID_OS_WINDOWS)
+  (void)Hint;
+
+  HANDLE FileHandle = CreateFileA(FilePath.c_str(),GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,nullptr);
+  if (FileHandle != INVALID_HANDLE_VALUE)
+  {
+    LARGE_INTEGER FileSize;
+    if (GetFileSizeEx(FileHandle,&FileSize) && FileSize.QuadPart > 0)
+    {
+      m_MappingHandle = CreateFileMappingA(FileHandle,nullptr,PAGE_READONLY,0,0,nullptr);
+      if (m_MappingHandle)
+      {
+        void* Mapped = MapViewOfFile(m_MappingHandle,FILE_MAP_READ,0,0,0);
+        if (Mapped)
+        {
+          mp_Data = static_cast<const char*>(Mapped);
+          m_Size = FileSize.QuadPart;
+        }
+        else
+        {
+          CloseHandle(m_MappingHandle);
+          m_MappingHandle = nullptr;
+        }
+      }
+    }
+    CloseHandle(FileHandle);
+  }
+#else
+  int FileDesc = ::open(FilePath.c_str(),O_RDONLY);
+  if (FileDesc >= 0)
+  {
+    struct stat FileStat;
+    if (fstat(FileDesc,&FileStat) == 0 && FileStat.st_size > 0)
+    {
+      void* Mapped = mmap(nullptr,FileStat.st_size,PROT_READ,MAP_PRIVATE,FileDesc,0);
+      if (Mapped != MAP_FAILED)
+      {
+        if (Hint == Access::SEQUENTIAL)
+        {
+          madvise(Mapped,FileStat.st_size,MADV_SEQUENTIAL);
+        }
+        else if (Hint == Access::RANDOM)
+        {
+          madvise(Mapped,FileStat.st_size,MADV_RANDOM);
+        }
+
+        mp_Data = static_cast<const char*>(Mapped);
+        m_Size = FileStat.st_size;
+      }
+    }
+    ::close(FileDesc);
+  }
+#endif
+
+  return isOpen();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void MappedFile::close()
+{
+  if (!mp_Data)
+  {
+    return;
+  }
+
+#if defined(OPENFLUID_OS_WINDOWS)
+  UnmapViewOfFile(mp_Data);
+  CloseHandle(m_MappingHandle);
+  m_MappingHandle = nullptr;
+#else
+  munmap(const_cast<char*>(mp_Data),m_Size);
+#endif
+
+  mp_Data = nullptr;
+  m_Size = 0;
+}
+
+
+} }  // namespaces
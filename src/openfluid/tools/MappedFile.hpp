@@ -0,0 +1,119 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file MappedFile.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_TOOLS_MAPPEDFILE_HPP__
+#define __OPENFLUID_TOOLS_MAPPEDFILE_HPP__
+
+
+#include <string>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/global.hpp>
+
+
+namespace openfluid { namespace tools {
+
+
+/**
+  Read-only memory mapping of a whole file
+*/
+class OPENFLUID_API MappedFile
+{
+  public:
+
+    /**
+      Expected access to the mapped contents, given as a hint to the system when supported
+    */
+    enum class Access { NORMAL, SEQUENTIAL, RANDOM };
+
+
+  private:
+
+    const char* mp_Data;
+
+    std::size_t m_Size;
+
+#if defined(OPENFLUID_OS_WINDOWS)
+    void* m_MappingHandle;
+#endif
+
+
+  public:
+
+    MappedFile();
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+      Maps the given file in memory, unmapping the previously mapped file if any
+      @param[in] FilePath the path of the file to map
+      @param[in] Hint the expected access to the contents
+      @return true if the file is mapped, false if it does not exist, cannot be read or is empty
+    */
+    bool open(const std::string& FilePath, Access Hint = Access::NORMAL);
+
+    /**
+      Unmaps the currently mapped file
+    */
+    void close();
+
+    inline bool isOpen() const
+    {
+      return mp_Data != nullptr;
+    }
+
+    inline const char* data() const
+    {
+      return mp_Data;
+    }
+
+    inline std::size_t size() const
+    {
+      return m_Size;
+    }
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_TOOLS_MAPPEDFILE_HPP__ */
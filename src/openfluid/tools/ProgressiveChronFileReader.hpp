@@ -45,6 +45,7 @@
 #include <openfluid/tools/ProgressiveColumnFileReader.hpp>
 #include <openfluid/tools/ChronologicalSerie.hpp>
 #include <openfluid/tools/StringHelpers.hpp>
+#include <openfluid/core/DateTimeFormat.hpp>
 #include <openfluid/dllexport.hpp>
 
 
@@ -56,7 +57,7 @@ class ProgressiveChronFileReader : public ProgressiveColumnFileReader
 {
   private:
 
-    std::string m_DateFormat;
+    openfluid::core::DateTimeFormat m_DateFormat;
 
 
   public:
@@ -93,7 +94,7 @@ inline bool OPENFLUID_API ProgressiveChronFileReader<double>::getNextValue(Chron
   {
     if (Values.size() == 2)
     {
-      if (DT.setFromString(Values.front(),m_DateFormat) &&
+      if (m_DateFormat.parse(Values.front(),DT) &&
           openfluid::tools::toNumeric(Values.back(),Val))
       {
         Value.first = DT;
@@ -127,7 +128,7 @@ inline bool OPENFLUID_API ProgressiveChronFileReader<std::vector<std::string>>::
   {
     if (Values.size() >= 2)
     {
-      if (DT.setFromString(Values.front(),m_DateFormat) )
+      if (m_DateFormat.parse(Values.front(),DT) )
       {
         Value.first = DT;
         Value.second.clear();
@@ -43,9 +43,12 @@
 #define BOOST_TEST_MODULE unittest_coltextparser
 
 
+#include <fstream>
+
 #include <boost/test/unit_test.hpp>
 
 #include <openfluid/tools/ColumnTextParser.hpp>
+#include <openfluid/tools/FilesystemPath.hpp>
 #include <openfluid/core/StringValue.hpp>
 #include <openfluid/core/DoubleValue.hpp>
 #include <openfluid/core/MapValue.hpp>
@@ -117,3 +120,102 @@ BOOST_AUTO_TEST_CASE(check_from_file)
 
   checkParsing(Parser);
 }
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_conversions)
+{
+  openfluid::tools::ColumnTextParser Parser;
+
+  BOOST_REQUIRE(Parser.setFromString("1 -2.5 +3 1e3 abc 12.5 inf \"4\"",8));
+  BOOST_REQUIRE_EQUAL(Parser.getLinesCount(),1);
+  BOOST_REQUIRE_EQUAL(Parser.getColsCount(),8);
+
+  long LongVal = 0;
+  double DblVal = 0.0;
+  std::string StrVal;
+
+  BOOST_REQUIRE(Parser.getLongValue(0,0,&LongVal));
+  BOOST_REQUIRE_EQUAL(LongVal,1);
+  BOOST_REQUIRE(Parser.getDoubleValue(0,1,&DblVal));
+  BOOST_REQUIRE_CLOSE(DblVal,-2.5,0.00001);
+  BOOST_REQUIRE(Parser.getLongValue(0,2,&LongVal));
+  BOOST_REQUIRE_EQUAL(LongVal,3);
+  BOOST_REQUIRE(Parser.getDoubleValue(0,3,&DblVal));
+  BOOST_REQUIRE_CLOSE(DblVal,1000.0,0.00001);
+  BOOST_REQUIRE(!Parser.getDoubleValue(0,4,&DblVal));
+  BOOST_REQUIRE(!Parser.getLongValue(0,5,&LongVal));
+  BOOST_REQUIRE(!Parser.getDoubleValue(0,6,&DblVal));
+  BOOST_REQUIRE(Parser.getLongValue(0,7,&LongVal));
+  BOOST_REQUIRE_EQUAL(LongVal,4);
+
+  BOOST_REQUIRE(Parser.getStringValue(0,4,&StrVal));
+  BOOST_REQUIRE_EQUAL(StrVal,"abc");
+  BOOST_REQUIRE(!Parser.getStringValue(1,0,&StrVal));
+  BOOST_REQUIRE(!Parser.getStringValue(0,8,&StrVal));
+  BOOST_REQUIRE_EQUAL(Parser.getValue(0,8),"");
+  BOOST_REQUIRE_EQUAL(Parser.getValues(0).size(),8);
+
+  BOOST_REQUIRE(!Parser.setFromString("1 2 3",2));
+  BOOST_REQUIRE_EQUAL(Parser.getLinesCount(),0);
+  BOOST_REQUIRE(!Parser.setFromString("1 2 \\q",3));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_large_file)
+{
+  const std::string OutputDir = CONFIGTESTS_OUTPUT_DATA_DIR+"/ColumnTextParser";
+  const std::string FilePath = OutputDir+"/large.txt";
+  const unsigned int LinesCount = 200000;
+
+  openfluid::tools::FilesystemPath(OutputDir).makeDirectory();
+
+  {
+    std::ofstream OutFile(FilePath);
+    OutFile << "# large file\n";
+    for (unsigned int i=0; i<LinesCount; i++)
+    {
+      OutFile << i << " " << (i*0.5) << "\t\"value " << i << "\" last\n";
+      if (i % 1000 == 0)
+      {
+        OutFile << "\n  # comment\n";
+      }
+    }
+  }
+
+  openfluid::tools::ColumnTextParser Parser("#");
+
+  BOOST_REQUIRE(Parser.loadFromFile(FilePath));
+  BOOST_REQUIRE_EQUAL(Parser.getLinesCount(),LinesCount);
+  BOOST_REQUIRE_EQUAL(Parser.getColsCount(),4);
+
+  for (unsigned int i : {0U,1U,999U,1000U,1001U,123457U,LinesCount-1})
+  {
+    long LongVal;
+    double DblVal;
+
+    BOOST_REQUIRE(Parser.getLongValue(i,0,&LongVal));
+    BOOST_REQUIRE_EQUAL(LongVal,i);
+    BOOST_REQUIRE(Parser.getDoubleValue(i,1,&DblVal));
+    BOOST_REQUIRE_CLOSE(DblVal,i*0.5,0.00001);
+    BOOST_REQUIRE_EQUAL(Parser.getValue(i,2),"value "+std::to_string(i));
+    BOOST_REQUIRE_EQUAL(Parser.getValue(i,3),"last");
+  }
+
+  // inconsistent columns number
+  {
+    std::ofstream OutFile(FilePath,std::ios::app);
+    OutFile << "1 2 3\n";
+  }
+
+  BOOST_REQUIRE(!Parser.loadFromFile(FilePath));
+  BOOST_REQUIRE_EQUAL(Parser.getLinesCount(),0);
+  BOOST_REQUIRE(!Parser.loadFromFile(OutputDir+"/doesnotexist.txt"));
+}
@@ -0,0 +1,200 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file LogFileIndex_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_logfileindex
+
+
+#include <fstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/tools/LogFileIndex.hpp>
+#include <openfluid/tools/FileLogger.hpp>
+#include <openfluid/tools/FilesystemPath.hpp>
+
+#include "tests-config.hpp"
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_small)
+{
+  const std::string LogPath = CONFIGTESTS_OUTPUT_DATA_DIR+"/LogFileIndex/small.log";
+
+  openfluid::tools::FilesystemPath(CONFIGTESTS_OUTPUT_DATA_DIR+"/LogFileIndex").makeDirectory();
+
+  {
+    openfluid::tools::FileLogger Log;
+    Log.init(LogPath);
+
+    Log.add(openfluid::tools::FileLogger::LogType::INFO_MSG,"source=app","starting");
+    Log.add(openfluid::tools::FileLogger::LogType::WARNING_MSG,
+            "source=ware,waretype=simulator,wareid=sim.b,stage=run,timeindex=60","warning from [sim.b]");
+    Log.add(openfluid::tools::FileLogger::LogType::DEBUG_MSG,"","no source");
+    Log.add(openfluid::tools::FileLogger::LogType::WARNING_MSG,
+            "source=ware,waretype=observer,wareid=obs.a,stage=init","warning from obs.a");
+    Log.add(openfluid::tools::FileLogger::LogType::ERROR_MSG,"source=framework","error");
+    Log.add(openfluid::tools::FileLogger::LogType::INFO_MSG,
+            "source=ware,waretype=simulator,wareid=sim.a,stage=run,timeindex=120","info from sim.a");
+    Log.add(openfluid::tools::FileLogger::LogType::INFO_MSG,"source=ware,waretype=generator","info from generator");
+    Log.close();
+
+    std::ofstream LogFile(LogPath,std::ios::app);
+    LogFile << "not a message\n" << "[warning]\n";
+  }
+
+  openfluid::tools::LogFileIndex Index;
+
+  BOOST_REQUIRE(!Index.open(CONFIGTESTS_OUTPUT_DATA_DIR+"/LogFileIndex/does_not_exist.log"));
+
+  BOOST_REQUIRE(Index.open(LogPath));
+  Index.waitForCompletion();
+
+  BOOST_REQUIRE(Index.isCompleted());
+  BOOST_REQUIRE_EQUAL(Index.getProgress(),1.0);
+  BOOST_REQUIRE_EQUAL(Index.getMessagesCount(),6);
+
+  BOOST_REQUIRE(Index.getTypes() == std::vector<std::string>({"Error","Info","Warning"}));
+  BOOST_REQUIRE(Index.getSimulators() == std::vector<std::string>({"sim.a","sim.b"}));
+  BOOST_REQUIRE(Index.getObservers() == std::vector<std::string>({"obs.a"}));
+
+  BOOST_REQUIRE(Index.getSource(0) == openfluid::tools::LogFileIndex::Source::APP);
+  BOOST_REQUIRE(Index.getSource(1) == openfluid::tools::LogFileIndex::Source::SIMULATOR);
+  BOOST_REQUIRE(Index.getSource(2) == openfluid::tools::LogFileIndex::Source::OBSERVER);
+  BOOST_REQUIRE(Index.getSource(3) == openfluid::tools::LogFileIndex::Source::FRAMEWORK);
+  BOOST_REQUIRE(Index.getSource(5) == openfluid::tools::LogFileIndex::Source::WARE);
+  BOOST_REQUIRE_EQUAL(Index.getType(1),"Warning");
+  BOOST_REQUIRE_EQUAL(Index.getWareID(1),"sim.b");
+  BOOST_REQUIRE_EQUAL(Index.getWareID(2),"obs.a");
+  BOOST_REQUIRE_EQUAL(Index.getWareID(3),"");
+
+  auto Msg = Index.getMessage(1);
+  BOOST_REQUIRE_EQUAL(Msg.Type,"Warning");
+  BOOST_REQUIRE_EQUAL(Msg.Text,"warning from [sim.b]");
+  BOOST_REQUIRE_EQUAL(Msg.Context.size(),5);
+  BOOST_REQUIRE_EQUAL(Msg.Context.at("stage"),"run");
+  BOOST_REQUIRE_EQUAL(Msg.Context.at("timeindex"),"60");
+
+
+  openfluid::tools::LogFileIndex::Filter Filt;
+  Filt.Types = {"Error","Info","Warning"};
+  Filt.Simulators = {"sim.a","sim.b"};
+  Filt.Observers = {"obs.a"};
+
+  BOOST_REQUIRE_EQUAL(Index.filter(Filt,0,1000).size(),6);
+
+  Filt.Types = {"Warning","Info"};
+  Filt.Simulators = {"sim.b"};
+  BOOST_REQUIRE(Index.filter(Filt,0,1000) == std::vector<std::size_t>({0,1,2,5}));
+
+  Filt.WithApp = false;
+  Filt.Observers.clear();
+  BOOST_REQUIRE(Index.filter(Filt,0,1000) == std::vector<std::size_t>({1,5}));
+  BOOST_REQUIRE(Index.filter(Filt,2,1000) == std::vector<std::size_t>({5}));
+
+
+  Index.close();
+  BOOST_REQUIRE_EQUAL(Index.getMessagesCount(),0);
+  BOOST_REQUIRE(Index.getTypes().empty());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_large)
+{
+  const std::string LogPath = CONFIGTESTS_OUTPUT_DATA_DIR+"/LogFileIndex/large.log";
+  const std::size_t MsgCount = 200000;
+
+  openfluid::tools::FilesystemPath(CONFIGTESTS_OUTPUT_DATA_DIR+"/LogFileIndex").makeDirectory();
+
+  {
+    openfluid::tools::FileLogger Log;
+    Log.init(LogPath);
+
+    for (std::size_t i = 0; i < MsgCount; i++)
+    {
+      Log.add(i % 10 ? openfluid::tools::FileLogger::LogType::WARNING_MSG :
+                       openfluid::tools::FileLogger::LogType::INFO_MSG,
+              "source=ware,waretype=simulator,wareid=sim."+std::to_string(i%3)+",timeindex="+std::to_string(i),
+              "message "+std::to_string(i));
+    }
+  }
+
+  openfluid::tools::LogFileIndex Index;
+
+  BOOST_REQUIRE(Index.open(LogPath));
+
+  // indexed messages are available while indexing
+  std::size_t Count = Index.getMessagesCount();
+  if (Count)
+  {
+    BOOST_REQUIRE_EQUAL(Index.getMessage(Count-1).Text,"message "+std::to_string(Count-1));
+  }
+
+  Index.waitForCompletion();
+
+  BOOST_REQUIRE_EQUAL(Index.getMessagesCount(),MsgCount);
+  BOOST_REQUIRE_EQUAL(Index.getMessage(123456).Text,"message 123456");
+  BOOST_REQUIRE_EQUAL(Index.getMessage(123456).Context.at("wareid"),"sim.0");
+  BOOST_REQUIRE_EQUAL(Index.getWareID(MsgCount-1),"sim.1");
+
+  openfluid::tools::LogFileIndex::Filter Filt;
+  Filt.Types = {"Info"};
+  Filt.Simulators = {"sim.0","sim.1","sim.2"};
+  BOOST_REQUIRE_EQUAL(Index.filter(Filt,0,MsgCount).size(),MsgCount/10);
+
+  Filt.Types = {"Info","Warning"};
+  Filt.Simulators = {"sim.1"};
+  const auto Kept = Index.filter(Filt,0,MsgCount);
+  BOOST_REQUIRE_EQUAL(Kept.size(),MsgCount/3+1);
+  BOOST_REQUIRE_EQUAL(Kept.front(),1);
+  BOOST_REQUIRE_EQUAL(Kept.back(),MsgCount-1);
+
+  // closing while indexing
+  BOOST_REQUIRE(Index.open(LogPath));
+  Index.close();
+  BOOST_REQUIRE(!Index.isCompleted());
+}
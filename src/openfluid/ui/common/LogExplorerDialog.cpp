@@ -37,10 +37,10 @@
 */
 
 
-#include <QFile>
 #include <QFileDialog>
 
 #include <openfluid/ui/common/LogExplorerDialog.hpp>
+#include <openfluid/ui/common/LogExplorerModel.hpp>
 #include <openfluid/tools/Filesystem.hpp>
 #include <openfluid/config.hpp>
 
@@ -51,17 +51,24 @@ namespace openfluid { namespace ui { namespace common {
 
 
 LogExplorerDialog::LogExplorerDialog(QString LogDir, QWidget* Parent):
-  QDialog(Parent), ui(new Ui::LogExplorerDialog), m_CurrentDir(LogDir), m_CurrentCount(0)
+  QDialog(Parent), ui(new Ui::LogExplorerDialog), mp_Model(new LogExplorerModel(this)), m_CurrentDir(LogDir)
 {
   ui->setupUi(this);
 
+  ui->LogTableView->setModel(mp_Model);
+  // rows are not resized to their contents, which would require to parse all messages
+  ui->LogTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+
   ui->HorizontalSplitter->setStretchFactor(1,3);
   ui->VerticalSplitter->setStretchFactor(2,2);
 
   connect(ui->ChangeDirButton,SIGNAL(clicked()),this,SLOT(changeCurrentDirectory()));
   connect(ui->ButtonBox,SIGNAL(rejected()),this,SLOT(reject()));
 
-  connect(ui->LogTableWidget,SIGNAL(cellClicked(int,int)),this,SLOT(updateDetails(int)));
+  connect(ui->LogTableView,SIGNAL(clicked(const QModelIndex&)),this,SLOT(updateDetails(const QModelIndex&)));
+
+  connect(mp_Model,SIGNAL(indexingProgressed(int)),this,SLOT(updateMessagesCount()));
+  connect(mp_Model,SIGNAL(indexingCompleted()),this,SLOT(handleIndexingCompleted()));
 
   connect(ui->AppFilterCheckBox,SIGNAL(stateChanged(int)),this,SLOT(enableFilterApply()));
   connect(ui->FrameworkFilterCheckBox,SIGNAL(stateChanged(int)),this,SLOT(enableFilterApply()));
@@ -117,33 +124,21 @@ void LogExplorerDialog::setDirectoryVisible(bool Visible)
 
 void LogExplorerDialog::reloadFromFiles()
 {
-  QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-
-  m_LogInfos.clear();
-  m_CurrentCount = 0;
-
   ui->DirectoryLabel->setText(QDir::toNativeSeparators(m_CurrentDir));
 
-  std::string MsgFilePath = 
-    openfluid::tools::Filesystem::joinPath({m_CurrentDir.toStdString(),openfluid::config::MESSAGES_LOG_FILE});
-  QFile MsgFile(QString::fromStdString(MsgFilePath));
-  if (MsgFile.open(QIODevice::ReadOnly | QIODevice::Text))
-  {
-    while (!MsgFile.atEnd())
-    {
-      QByteArray LineBytes = MsgFile.readLine();
-      appendLogItem(processLogLine(QString(LineBytes)));
-    }
-
-    MsgFile.close();
-  }
-
+  // filters are available once the whole log file is indexed
+  ui->FilteringWidget->setEnabled(false);
+  ui->TypeFilterListWidget->clear();
+  ui->SimulatorFilterListWidget->clear();
+  ui->ObserverFilterListWidget->clear();
 
-  rebuildFilters();
+  updateDetails(QModelIndex());
 
-  updateTable();
+  std::string MsgFilePath =
+    openfluid::tools::Filesystem::joinPath({m_CurrentDir.toStdString(),openfluid::config::MESSAGES_LOG_FILE});
+  mp_Model->load(QString::fromStdString(MsgFilePath));
 
-  QApplication::restoreOverrideCursor();
+  updateMessagesCount();
 }
 
 
@@ -151,56 +146,15 @@ void LogExplorerDialog::reloadFromFiles()
 // =====================================================================
 
 
-LogExplorerDialog::LogItemInfos LogExplorerDialog::processLogLine(const QString& Line)
+void LogExplorerDialog::handleIndexingCompleted()
 {
-  LogItemInfos Item;
-
-  QStringList SplittedLine = Line.split(']');
-
-  if (SplittedLine.size() > 2)
-  {
-    m_CurrentCount++;
-
-    Item["order"] = QString("%1").arg(m_CurrentCount);
-
-    // Type
-    QString TypeStr = SplittedLine[0];
-    TypeStr.remove(0,TypeStr.indexOf('[')+1);
-    Item["type"] = TypeStr;
-
-    SplittedLine.removeFirst();
-
-    // Context
-    QString ContextStr = SplittedLine[0];
-    ContextStr.remove(0,ContextStr.indexOf('[')+1);
-    QStringList SplittedContext = ContextStr.split(',');
-
-    for (const QString& KeyValStr : SplittedContext)
-    {
-      QStringList SplittedKeyVal = KeyValStr.split('=');
-      if (SplittedKeyVal.size() == 2)
-      {
-        Item["context."+SplittedKeyVal[0]] = SplittedKeyVal[1];
-      }
-    }
-
-    SplittedLine.removeFirst();
-
-    // Message
-    Item["msg"] = SplittedLine.join("]");
-  }
-
-  return Item;
-}
-
-
-// =====================================================================
-// =====================================================================
+  rebuildFilters();
+  ui->FilteringWidget->setEnabled(true);
 
+  // only the visible rows are used to compute the columns widths
+  ui->LogTableView->resizeColumnsToContents();
 
-void LogExplorerDialog::appendLogItem(const LogItemInfos& Item)
-{
-  m_LogInfos.append(Item);
+  updateMessagesCount();
 }
 
 
@@ -208,182 +162,23 @@ void LogExplorerDialog::appendLogItem(const LogItemInfos& Item)
 // =====================================================================
 
 
-void LogExplorerDialog::updateTable(bool WithFiltering)
+void LogExplorerDialog::updateMessagesCount()
 {
+  const int Count = mp_Model->rowCount();
 
-  while (ui->LogTableWidget->rowCount() > 0)
-  {
-    ui->LogTableWidget->removeRow(0);
-  }  
-
-  ui->LogTableWidget->setRowCount(0);
-  updateDetails(-1);
-
-
-  QStringList FilteredTypes;
-  QStringList FilteredSimulators;
-  QStringList FilteredObservers;
-
-  if (WithFiltering)
-  {
-    for (int i=0;i<ui->TypeFilterListWidget->count();i++)
-    {
-      if (ui->TypeFilterListWidget->item(i)->checkState() == Qt::Checked)
-      {
-        FilteredTypes.append(ui->TypeFilterListWidget->item(i)->text());
-      }
-    }
-  
-    for (int i=0;i<ui->SimulatorFilterListWidget->count();i++)
-    {
-      if (ui->SimulatorFilterListWidget->item(i)->checkState() == Qt::Checked)
-      {
-        FilteredSimulators.append(ui->SimulatorFilterListWidget->item(i)->text());
-      }
-    }
-
-    for (int i=0;i<ui->ObserverFilterListWidget->count();i++)
-    {
-      if (ui->ObserverFilterListWidget->item(i)->checkState() == Qt::Checked)
-      {
-        FilteredObservers.append(ui->ObserverFilterListWidget->item(i)->text());
-      }
-    }
-  }
-
-
-  int RowCount = 0;
-
-  for (int i=0; i< m_LogInfos.count(); i++)
+  if (mp_Model->logIndex().getProgress() < 1.0)
   {
-    LogItemInfos Item = m_LogInfos[i];
-
-    QString TypeStr = Item["type"];
-    QString ContextSrcStr = Item["context.source"];
-
-    if (!(TypeStr.isEmpty() || ContextSrcStr.isEmpty()))
-    {
-
-      bool OKToDisplay = true;
-
-      if (WithFiltering)
-      {
-        if (!FilteredTypes.contains(TypeStr))
-        {
-          OKToDisplay = false;
-        }
-        else if (Item.contains("context.source"))
-        {
-          if (ContextSrcStr == "app" && ui->AppFilterCheckBox->checkState() == Qt::Unchecked)
-          {
-            OKToDisplay = false;
-          }
-          else if (ContextSrcStr == "framework" && ui->FrameworkFilterCheckBox->checkState() == Qt::Unchecked)
-          {
-            OKToDisplay = false;
-          }  
-          else if (ContextSrcStr == "ware")
-          {
-            QString WareTypeStr = Item["context.waretype"];
-            QString WareIDStr = Item["context.wareid"];
-
-            if (WareTypeStr == "simulator" && (FilteredSimulators.empty() || !FilteredSimulators.contains(WareIDStr)))
-            {
-              OKToDisplay = false;
-            }
-            else if (WareTypeStr == "observer" && (FilteredObservers.empty() || !FilteredObservers.contains(WareIDStr)))
-            {
-              OKToDisplay = false;
-            }  
-          }
-        }
-      }
-
-
-      if (OKToDisplay)
-      {
-        RowCount++;
-        ui->LogTableWidget->setRowCount(RowCount);
-
-        QTableWidgetItem *TableItem = new QTableWidgetItem(TypeStr);
-        TableItem->setTextAlignment(Qt::AlignCenter);
-        TableItem->setData(Qt::UserRole,i);
-
-        if (TypeStr.toLower() == "warning")
-        {
-          TableItem->setBackground(QBrush(QColor("#FFCF5A")));
-        }
-        else if (TypeStr.toLower() == "info")
-        {
-          TableItem->setBackground(QBrush(QColor("#6CC2FF")));
-        }  
-        else if (TypeStr.toLower() == "debug")
-        {
-          TableItem->setBackground(QBrush(QColor("#D0D0D0")));
-        }
-        else if (TypeStr.toLower() == "error")
-        {
-          TableItem->setBackground(QBrush(QColor("#FF625A")));
-        }  
-
-        ui->LogTableWidget->setItem(RowCount-1, 0, TableItem);
-
-
-        TableItem = new QTableWidgetItem(Item["order"]);
-        TableItem->setTextAlignment(Qt::AlignCenter);
-        ui->LogTableWidget->setItem(RowCount-1, 1, TableItem);
-
-        if (ContextSrcStr == "ware" && Item.contains("context.waretype") && Item.contains("context.wareid"))
-        {
-          TableItem = new QTableWidgetItem(Item["context.waretype"]+": "+Item["context.wareid"]);
-          TableItem->setTextAlignment(Qt::AlignCenter);
-          ui->LogTableWidget->setItem(RowCount-1, 2, TableItem);
-        }
-        else if (ContextSrcStr == "framework")
-        {
-          TableItem = new QTableWidgetItem("framework");
-          TableItem->setTextAlignment(Qt::AlignCenter);
-          ui->LogTableWidget->setItem(RowCount-1, 2, TableItem);
-        }
-        else if (ContextSrcStr == "app")
-        {
-          TableItem = new QTableWidgetItem("application");
-          TableItem->setTextAlignment(Qt::AlignCenter);
-          ui->LogTableWidget->setItem(RowCount-1, 2, TableItem);
-        }
-
-
-        if (Item.contains("context.stage"))
-        {
-          TableItem = new QTableWidgetItem(Item["context.stage"]);
-          TableItem->setTextAlignment(Qt::AlignCenter);
-          ui->LogTableWidget->setItem(RowCount-1, 3, TableItem);
-        }
-
-        if (Item.contains("context.timeindex"))
-        {
-          TableItem = new QTableWidgetItem(Item["context.timeindex"]);
-          TableItem->setTextAlignment(Qt::AlignCenter);
-          ui->LogTableWidget->setItem(RowCount-1, 4, TableItem);
-        }
-
-        TableItem = new QTableWidgetItem(Item["msg"]);
-        ui->LogTableWidget->setItem(RowCount-1, 5, TableItem);
-      }
-    }
+    ui->MessagesCountLabel->setText(tr("%1 message(s), loading (%2%)...").arg(Count)
+                                    .arg(int(mp_Model->logIndex().getProgress()*100)));
   }
-
-  ui->LogTableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-
-  if (ui->LogTableWidget->rowCount())
+  else if (Count)
   {
-    ui->MessagesCountLabel->setText(tr("%1 message(s)").arg(ui->LogTableWidget->rowCount()));
+    ui->MessagesCountLabel->setText(tr("%1 message(s)").arg(Count));
   }
   else
   {
     ui->MessagesCountLabel->setText(tr("no message"));
   }
-
 }
 
 
@@ -403,36 +198,20 @@ void LogExplorerDialog::rebuildFilters()
   ui->ObserverFilterListWidget->clear();
 
 
-  for (int i=0; i< m_LogInfos.count(); i++)
+  for (const auto& Type : mp_Model->logIndex().getTypes())
   {
-    LogItemInfos Item = m_LogInfos[i];
-
-    QString TypeStr = m_LogInfos[i]["type"];
-    if (!(TypeStr.isEmpty() || Types.contains(TypeStr)))
-    {
-      Types.append(TypeStr);
-    }
+    Types.append(QString::fromStdString(Type));
+  }
 
-    if (m_LogInfos[i].contains("context.source") && m_LogInfos[i]["context.source"] == "ware" &&
-        m_LogInfos[i].contains("context.waretype") && m_LogInfos[i].contains("context.wareid"))
-    {
-      QString WareTypeStr = m_LogInfos[i]["context.waretype"];
-      QString WareIDStr = m_LogInfos[i]["context.wareid"];
-
-      if (WareTypeStr.toLower() == "simulator" && !Simulators.contains(WareIDStr))
-      {
-        Simulators.append(WareIDStr);
-      }
-      else if (WareTypeStr.toLower() == "observer" && !Observers.contains(WareIDStr))
-      {
-        Observers.append(WareIDStr);
-      }  
-    }
+  for (const auto& ID : mp_Model->logIndex().getSimulators())
+  {
+    Simulators.append(QString::fromStdString(ID));
   }
 
-  Types.sort();
-  Simulators.sort();
-  Observers.sort();
+  for (const auto& ID : mp_Model->logIndex().getObservers())
+  {
+    Observers.append(QString::fromStdString(ID));
+  }
 
   for (int i=0; i< Types.count(); i++)
   {
@@ -469,25 +248,19 @@ void LogExplorerDialog::rebuildFilters()
 // =====================================================================
 
 
-void LogExplorerDialog::updateDetails(int Row)
+void LogExplorerDialog::updateDetails(const QModelIndex& Index)
 {
-  if (Row >=0)
+  if (Index.isValid())
   {
-    LogItemInfos Infos = m_LogInfos[ui->LogTableWidget->item(Row,0)->data(Qt::UserRole).toInt()];
-    ui->MessageDetailLabel->setText(Infos["msg"]);
-    ui->TypeDetailLabel->setText(Infos["type"]);
+    const auto Msg = mp_Model->getMessage(Index.row());
+    ui->MessageDetailLabel->setText(QString::fromStdString(Msg.Text));
+    ui->TypeDetailLabel->setText(QString::fromStdString(Msg.Type));
 
     QStringList Context;
 
-    QMapIterator<QString, QString> it(Infos);
-    while (it.hasNext())
+    for (const auto& KeyValue : Msg.Context)
     {
-      it.next();
-
-      if (it.key().startsWith("context."))
-      {
-        Context.append(QString(it.key()).remove(0,8)+"="+it.value());
-      }
+      Context.append(QString::fromStdString(KeyValue.first+"="+KeyValue.second));
     }
 
     ui->ContextDetailLabel->setText(Context.join("\n"));
@@ -524,11 +297,42 @@ void LogExplorerDialog::applyFilters()
 
   ui->ApplyFilteringButton->setEnabled(false);
 
-  updateTable(true);
+  openfluid::tools::LogFileIndex::Filter Filt;
+
+  for (int i=0;i<ui->TypeFilterListWidget->count();i++)
+  {
+    if (ui->TypeFilterListWidget->item(i)->checkState() == Qt::Checked)
+    {
+      Filt.Types.insert(ui->TypeFilterListWidget->item(i)->text().toStdString());
+    }
+  }
+
+  for (int i=0;i<ui->SimulatorFilterListWidget->count();i++)
+  {
+    if (ui->SimulatorFilterListWidget->item(i)->checkState() == Qt::Checked)
+    {
+      Filt.Simulators.insert(ui->SimulatorFilterListWidget->item(i)->text().toStdString());
+    }
+  }
+
+  for (int i=0;i<ui->ObserverFilterListWidget->count();i++)
+  {
+    if (ui->ObserverFilterListWidget->item(i)->checkState() == Qt::Checked)
+    {
+      Filt.Observers.insert(ui->ObserverFilterListWidget->item(i)->text().toStdString());
+    }
+  }
+
+  Filt.WithApp = (ui->AppFilterCheckBox->checkState() == Qt::Checked);
+  Filt.WithFramework = (ui->FrameworkFilterCheckBox->checkState() == Qt::Checked);
+
+  mp_Model->setFilter(Filt);
+
+  updateDetails(QModelIndex());
+  updateMessagesCount();
 
   QApplication::restoreOverrideCursor();
 }
 
 
 } } }  // namespaces
-
@@ -41,7 +41,7 @@
 
 
 #include <QDialog>
-#include <QMap>
+#include <QModelIndex>
 
 #include <openfluid/dllexport.hpp>
 
@@ -55,6 +55,9 @@ namespace Ui
 namespace openfluid { namespace ui { namespace common {
 
 
+class LogExplorerModel;
+
+
 // =====================================================================
 // =====================================================================
 
@@ -67,35 +70,28 @@ class OPENFLUID_API LogExplorerDialog : public QDialog
 
     void changeCurrentDirectory();
 
-    void updateDetails(int Row);
+    void updateDetails(const QModelIndex& Index);
 
     void enableFilterApply();
 
     void applyFilters();
 
+    void updateMessagesCount();
 
-  private:
+    void handleIndexingCompleted();
 
-    typedef  QMap<QString,QString> LogItemInfos;
 
+  private:
 
     Ui::LogExplorerDialog* ui;
 
-    QList<LogItemInfos> m_LogInfos;
+    LogExplorerModel* mp_Model;
 
     QString m_CurrentDir;
 
-    int m_CurrentCount;
-
 
     void reloadFromFiles();
 
-    LogItemInfos processLogLine(const QString& Line);
-
-    void appendLogItem(const LogItemInfos& Item);
-
-    void updateTable(bool WithFiltering = false);
-
     void rebuildFilters();
 
 
@@ -0,0 +1,389 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+
+/**
+  @file LogExplorerModel.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <algorithm>
+#include <limits>
+
+#include <QBrush>
+#include <QColor>
+
+#include <openfluid/ui/common/LogExplorerModel.hpp>
+
+
+namespace openfluid { namespace ui { namespace common {
+
+
+/**
+  Period of the update of the model from the running indexing, in milliseconds
+*/
+constexpr int UpdatePeriod = 250;
+
+/**
+  Maximum count of parsed messages kept in memory
+*/
+constexpr int CachedMessagesCount = 2048;
+
+
+// =====================================================================
+// =====================================================================
+
+
+LogExplorerModel::LogExplorerModel(QObject* Parent):
+  QAbstractTableModel(Parent), m_IsFiltered(false), m_ProcessedCount(0), m_MessagesCache(CachedMessagesCount)
+{
+  m_UpdateTimer.setInterval(UpdatePeriod);
+
+  connect(&m_UpdateTimer,SIGNAL(timeout()),this,SLOT(updateFromIndex()));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+LogExplorerModel::~LogExplorerModel()
+{
+  m_UpdateTimer.stop();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool LogExplorerModel::load(const QString& FilePath)
+{
+  m_UpdateTimer.stop();
+
+  beginResetModel();
+
+  m_IsFiltered = false;
+  m_FilteredRows.clear();
+  m_ProcessedCount = 0;
+  m_MessagesCache.clear();
+
+  const bool IsOpen = m_Index.open(FilePath.toStdString());
+
+  endResetModel();
+
+  if (IsOpen)
+  {
+    m_UpdateTimer.start();
+    updateFromIndex();
+  }
+
+  return IsOpen;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void LogExplorerModel::updateFromIndex()
+{
+  // completion is checked first, the count of messages is then the final one
+  const bool IsCompleted = m_Index.isCompleted();
+  const std::size_t Count = m_Index.getMessagesCount();
+
+  if (Count > m_ProcessedCount)
+  {
+    if (m_IsFiltered)
+    {
+      const std::vector<std::size_t> Kept = m_Index.filter(m_Filter,m_ProcessedCount,Count);
+
+      if (!Kept.empty())
+      {
+        beginInsertRows(QModelIndex(),int(m_FilteredRows.size()),int(m_FilteredRows.size()+Kept.size()-1));
+        m_FilteredRows.insert(m_FilteredRows.end(),Kept.begin(),Kept.end());
+        endInsertRows();
+      }
+    }
+    else
+    {
+      beginInsertRows(QModelIndex(),int(m_ProcessedCount),int(Count-1));
+      endInsertRows();
+    }
+
+    m_ProcessedCount = Count;
+  }
+
+  emit indexingProgressed(int(m_Index.getProgress()*100));
+
+  if (IsCompleted)
+  {
+    m_UpdateTimer.stop();
+    emit indexingCompleted();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void LogExplorerModel::setFilter(const openfluid::tools::LogFileIndex::Filter& Filt)
+{
+  beginResetModel();
+
+  m_Filter = Filt;
+  m_IsFiltered = true;
+  m_FilteredRows = m_Index.filter(m_Filter,0,m_ProcessedCount);
+
+  endResetModel();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void LogExplorerModel::clearFilter()
+{
+  beginResetModel();
+
+  m_IsFiltered = false;
+  m_FilteredRows.clear();
+
+  endResetModel();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::size_t LogExplorerModel::getMessageIndex(int Row) const
+{
+  return m_IsFiltered ? m_FilteredRows[Row] : Row;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const openfluid::tools::LogFileIndex::Message& LogExplorerModel::cachedMessage(std::size_t MsgIndex) const
+{
+  openfluid::tools::LogFileIndex::Message* Msg = m_MessagesCache.object(MsgIndex);
+
+  if (!Msg)
+  {
+    Msg = new openfluid::tools::LogFileIndex::Message(m_Index.getMessage(MsgIndex));
+    m_MessagesCache.insert(MsgIndex,Msg);
+  }
+
+  return *Msg;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::tools::LogFileIndex::Message LogExplorerModel::getMessage(int Row) const
+{
+  return cachedMessage(getMessageIndex(Row));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+int LogExplorerModel::rowCount(const QModelIndex& Parent) const
+{
+  if (Parent.isValid())
+  {
+    return 0;
+  }
+
+  const std::size_t Count = m_IsFiltered ? m_FilteredRows.size() : m_ProcessedCount;
+
+  return int(std::min(Count,std::size_t(std::numeric_limits<int>::max())));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+int LogExplorerModel::columnCount(const QModelIndex& Parent) const
+{
+  if (Parent.isValid())
+  {
+    return 0;
+  }
+
+  return COLUMNS_COUNT;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+QVariant LogExplorerModel::data(const QModelIndex& Index, int Role) const
+{
+  if (!Index.isValid() || Index.row() >= rowCount())
+  {
+    return QVariant();
+  }
+
+  const std::size_t MsgIndex = getMessageIndex(Index.row());
+
+  if (Role == Qt::DisplayRole)
+  {
+    switch (Index.column())
+    {
+      case TYPE:
+        return QString::fromStdString(m_Index.getType(MsgIndex));
+
+      case ORDER:
+        return QString::number(MsgIndex+1);
+
+      case SOURCE:
+      {
+        switch (m_Index.getSource(MsgIndex))
+        {
+          case openfluid::tools::LogFileIndex::Source::APP:
+            return QString("application");
+          case openfluid::tools::LogFileIndex::Source::FRAMEWORK:
+            return QString("framework");
+          case openfluid::tools::LogFileIndex::Source::SIMULATOR:
+            return "simulator: "+QString::fromStdString(m_Index.getWareID(MsgIndex));
+          case openfluid::tools::LogFileIndex::Source::OBSERVER:
+            return "observer: "+QString::fromStdString(m_Index.getWareID(MsgIndex));
+          case openfluid::tools::LogFileIndex::Source::WARE:
+          {
+            const auto& Context = cachedMessage(MsgIndex).Context;
+            const auto WareTypeIt = Context.find("waretype");
+            const auto WareIDIt = Context.find("wareid");
+
+            if (WareTypeIt != Context.end() && WareIDIt != Context.end())
+            {
+              return QString::fromStdString(WareTypeIt->second+": "+WareIDIt->second);
+            }
+            return QVariant();
+          }
+          default:
+            return QVariant();
+        }
+      }
+
+      case STAGE:
+      case TIMEINDEX:
+      {
+        const auto& Context = cachedMessage(MsgIndex).Context;
+        const auto it = Context.find(Index.column() == STAGE ? "stage" : "timeindex");
+
+        return (it != Context.end()) ? QString::fromStdString(it->second) : QVariant();
+      }
+
+      case MESSAGE:
+        return QString::fromStdString(cachedMessage(MsgIndex).Text);
+
+      default:
+        return QVariant();
+    }
+  }
+  else if (Role == Qt::TextAlignmentRole)
+  {
+    if (Index.column() != MESSAGE)
+    {
+      return int(Qt::AlignCenter);
+    }
+  }
+  else if (Role == Qt::BackgroundRole && Index.column() == TYPE)
+  {
+    const QString TypeStr = QString::fromStdString(m_Index.getType(MsgIndex)).toLower();
+
+    if (TypeStr == "warning")
+    {
+      return QBrush(QColor("#FFCF5A"));
+    }
+    else if (TypeStr == "info")
+    {
+      return QBrush(QColor("#6CC2FF"));
+    }
+    else if (TypeStr == "debug")
+    {
+      return QBrush(QColor("#D0D0D0"));
+    }
+    else if (TypeStr == "error")
+    {
+      return QBrush(QColor("#FF625A"));
+    }
+  }
+
+  return QVariant();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+QVariant LogExplorerModel::headerData(int Section, Qt::Orientation Orientation, int Role) const
+{
+  if (Role != Qt::DisplayRole || Orientation != Qt::Horizontal)
+  {
+    return QVariant();
+  }
+
+  switch (Section)
+  {
+    case TYPE:
+      return tr("Type");
+    case ORDER:
+      return tr("Order");
+    case SOURCE:
+      return tr("Source");
+    case STAGE:
+      return tr("Stage");
+    case TIMEINDEX:
+      return tr("TimeIndex");
+    case MESSAGE:
+      return tr("Message");
+    default:
+      return QVariant();
+  }
+}
+
+
+} } }  // namespaces
@@ -0,0 +1,153 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+*/
+
+/**
+  @file LogExplorerModel.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_UICOMMON_LOGEXPLORERMODEL_HPP__
+#define __OPENFLUID_UICOMMON_LOGEXPLORERMODEL_HPP__
+
+
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QCache>
+#include <QTimer>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/tools/LogFileIndex.hpp>
+
+
+namespace openfluid { namespace ui { namespace common {
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Table model of the messages of a log file, backed by an index built in background.
+  Rows are appended as the messages are indexed, and only the messages of the displayed rows are parsed.
+*/
+class OPENFLUID_API LogExplorerModel : public QAbstractTableModel
+{
+  Q_OBJECT;
+
+  signals:
+
+    void indexingProgressed(int Percent);
+
+    void indexingCompleted();
+
+
+  private slots:
+
+    void updateFromIndex();
+
+
+  private:
+
+    openfluid::tools::LogFileIndex m_Index;
+
+    QTimer m_UpdateTimer;
+
+    bool m_IsFiltered;
+
+    openfluid::tools::LogFileIndex::Filter m_Filter;
+
+    /**
+      Indexes of the messages kept by the filter, used as rows when filtered
+    */
+    std::vector<std::size_t> m_FilteredRows;
+
+    /**
+      Count of indexed messages already taken into account in the rows
+    */
+    std::size_t m_ProcessedCount;
+
+    mutable QCache<quint64,openfluid::tools::LogFileIndex::Message> m_MessagesCache;
+
+    const openfluid::tools::LogFileIndex::Message& cachedMessage(std::size_t MsgIndex) const;
+
+
+  public:
+
+    enum Column { TYPE, ORDER, SOURCE, STAGE, TIMEINDEX, MESSAGE, COLUMNS_COUNT };
+
+    explicit LogExplorerModel(QObject* Parent = nullptr);
+
+    virtual ~LogExplorerModel();
+
+    /**
+      Loads the given log file, the messages are added to the model while the file is indexed
+      @return false if the file cannot be read
+    */
+    bool load(const QString& FilePath);
+
+    /**
+      Keeps only the messages matching the given filter, including the messages indexed afterwards
+    */
+    void setFilter(const openfluid::tools::LogFileIndex::Filter& Filt);
+
+    void clearFilter();
+
+    const openfluid::tools::LogFileIndex& logIndex() const
+    {
+      return m_Index;
+    }
+
+    /**
+      Returns the index in the log file of the message displayed at the given row
+    */
+    std::size_t getMessageIndex(int Row) const;
+
+    /**
+      Returns the parsed message displayed at the given row
+    */
+    openfluid::tools::LogFileIndex::Message getMessage(int Row) const;
+
+    int rowCount(const QModelIndex& Parent = QModelIndex()) const;
+
+    int columnCount(const QModelIndex& Parent = QModelIndex()) const;
+
+    QVariant data(const QModelIndex& Index, int Role = Qt::DisplayRole) const;
+
+    QVariant headerData(int Section, Qt::Orientation Orientation, int Role = Qt::DisplayRole) const;
+};
+
+
+} } }  // namespaces
+
+
+#endif /* __OPENFLUID_UICOMMON_LOGEXPLORERMODEL_HPP__ */
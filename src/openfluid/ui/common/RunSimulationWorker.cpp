@@ -116,7 +116,8 @@ RunSimulationListener::RunSimulationListener()
     m_PausedByUser(false), m_ConfirmedPauseByUser(false),
     m_AbortedByUser(false)
 {
-
+  // progress is reported at most every 100ms to avoid flooding the GUI event loop
+  setCoalescedRunSteps(0,100);
 }
 
 
@@ -238,6 +239,18 @@ void RunSimulationListener::onRunStep(const openfluid::base::SimulationStatus* S
 // =====================================================================
 
 
+void RunSimulationListener::onRunStepsProgress(const openfluid::base::SimulationStatus* SimStatus,
+                                               unsigned int /*StepsCount*/,
+                                               const openfluid::base::Listener::Status& /*Status*/)
+{
+  onRunStep(SimStatus);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void RunSimulationListener::onFinalizeRun()
 {
   HANDLE_USER_PAUSE_ABORT;
@@ -129,6 +129,9 @@ class OPENFLUID_API RunSimulationListener : public QObject, public openfluid::ma
 
     void onRunStep(const openfluid::base::SimulationStatus* SimStatus);
 
+    void onRunStepsProgress(const openfluid::base::SimulationStatus* SimStatus,
+                            unsigned int /*StepsCount*/, const openfluid::base::Listener::Status& /*Status*/);
+
     void onFinalizeRun();
 
     void onFinalizeRunDone(const openfluid::base::Listener::Status& /*Status*/);
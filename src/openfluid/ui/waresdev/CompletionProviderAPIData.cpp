@@ -67,6 +67,19 @@ addRule(
   )
 );
 
+// extracted from core/DateTimeFormat.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::ANYWARE,
+    {
+      CompletionProvider::tr("Types"),
+      CompletionProvider::tr("Time")
+    },
+    CompletionProvider::tr("Date and time format"),
+    "openfluid::core::DateTimeFormat %%SEL_START%%DTFormat%%SEL_END%%(\"%Y-%m-%d %H:%M:%S\")"
+  )
+);
+
 // extracted from core/DoubleValue.hpp
 addRule(
   Rule(
@@ -210,6 +223,19 @@ addRule(
   )
 );
 
+// extracted from core/UnitsMatrixTopology.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::ANYWARE,
+    {
+      CompletionProvider::tr("Types"),
+      CompletionProvider::tr("Spatial domain")
+    },
+    CompletionProvider::tr("Topology of a matrix of spatial units"),
+    "openfluid::core::UnitsMatrixTopology %%SEL_START%%Topology%%SEL_END%%"
+  )
+);
+
 // extracted from core/SpatialUnit.hpp
 addRule(
   Rule(
@@ -431,6 +457,19 @@ addRule(
   )
 );
 
+// extracted from core/ValuesBuffer.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::ANYWARE,
+    {
+      CompletionProvider::tr("Types"),
+      CompletionProvider::tr("Values")
+    },
+    CompletionProvider::tr("View on IndexedValue"),
+    "openfluid::core::IndexedValuesView %%SEL_START%%IndexedValView%%SEL_END%%"
+  )
+);
+
 // extracted from core/VectorValue.hpp
 addRule(
   Rule(
@@ -899,6 +938,18 @@ addRule(
   )
 );
 
+// extracted from ware/PluggableSimulator.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR,
+    {
+      CompletionProvider::tr("Threading")
+    },
+    CompletionProvider::tr("Threaded loop on spatial units of a class following upstream connections"),
+    "OPENFLUID_GraphOrderedParallelLoop(%%SEL_START%%UnitsClass%%SEL_END%%,Func)"
+  )
+);
+
 // extracted from ware/PluggableSimulator.hpp
 addRule(
   Rule(
@@ -1068,6 +1119,18 @@ addRule(
   )
 );
 
+// extracted from ware/SimulationContributorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR,
+    {
+      CompletionProvider::tr("Variables")
+    },
+    CompletionProvider::tr("Append vector value to a variable without copy"),
+    "OPENFLUID_AppendVariable(%%SEL_START%%UnitPtr%%SEL_END%%,\"varname\",std::move(Val))"
+  )
+);
+
 // extracted from ware/SimulationContributorWare.hpp
 addRule(
   Rule(
@@ -1080,6 +1143,18 @@ addRule(
   )
 );
 
+// extracted from ware/SimulationContributorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR,
+    {
+      CompletionProvider::tr("Variables")
+    },
+    CompletionProvider::tr("Get a mutable reference to the current value of a variable"),
+    "OPENFLUID_GetCurrentVariableRef(%%SEL_START%%UnitPtr%%SEL_END%%,\"varname\")"
+  )
+);
+
 // extracted from ware/SimulationContributorWare.hpp
 addRule(
   Rule(
@@ -1116,6 +1191,30 @@ addRule(
   )
 );
 
+// extracted from ware/SimulationContributorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR,
+    {
+      CompletionProvider::tr("Spatial structure")
+    },
+    CompletionProvider::tr("Begin a batch of changes on the spatial graph"),
+    "OPENFLUID_BeginSpatialGraphBatch()"
+  )
+);
+
+// extracted from ware/SimulationContributorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR,
+    {
+      CompletionProvider::tr("Spatial structure")
+    },
+    CompletionProvider::tr("End a batch of changes on the spatial graph"),
+    "OPENFLUID_EndSpatialGraphBatch()"
+  )
+);
+
 // extracted from ware/SimulationContributorWare.hpp
 addRule(
   Rule(
@@ -1224,6 +1323,30 @@ addRule(
   )
 );
 
+// extracted from ware/SimulationContributorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR,
+    {
+      CompletionProvider::tr("Spatial structure")
+    },
+    CompletionProvider::tr("Build a matrix of spatial units with implicit topology"),
+    "OPENFLUID_BuildImplicitUnitsMatrix(%%SEL_START%%ClassName%%SEL_END%%,ColsNbr,RowsNbr)"
+  )
+);
+
+// extracted from ware/SimulationContributorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR,
+    {
+      CompletionProvider::tr("Spatial structure")
+    },
+    CompletionProvider::tr("Add a set of spatial units with their connections"),
+    "OPENFLUID_AddUnitsWithConnections(%%SEL_START%%ClassName%%SEL_END%%,UnitsIDsOrders,FromToIDs)"
+  )
+);
+
 // extracted from ware/SimulationDrivenWare.hpp
 addRule(
   Rule(
@@ -1536,6 +1659,18 @@ addRule(
   )
 );
 
+// extracted from ware/SimulationInspectorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR | ContextFlags::OBSERVER,
+    {
+      CompletionProvider::tr("Attributes")
+    },
+    CompletionProvider::tr("Get attribute values for all units of a class"),
+    "OPENFLUID_GetAttributeForClass(%%SEL_START%%\"unitsclass\"%%SEL_END%%,\"attrname\",Values)"
+  )
+);
+
 // extracted from ware/SimulationInspectorWare.hpp
 addRule(
   Rule(
@@ -1716,6 +1851,54 @@ addRule(
   )
 );
 
+// extracted from ware/SimulationInspectorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR | ContextFlags::OBSERVER,
+    {
+      CompletionProvider::tr("Variables")
+    },
+    CompletionProvider::tr("Get latest available variable value (read-only reference)"),
+    "OPENFLUID_GetLatestVariableView(%%SEL_START%%UnitPtr%%SEL_END%%,\"varname\")"
+  )
+);
+
+// extracted from ware/SimulationInspectorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR | ContextFlags::OBSERVER,
+    {
+      CompletionProvider::tr("Variables")
+    },
+    CompletionProvider::tr("Get latest available variable values since a time index (read-only view)"),
+    "OPENFLUID_GetLatestVariablesView(%%SEL_START%%UnitPtr%%SEL_END%%,\"varname\",TimeIndex)"
+  )
+);
+
+// extracted from ware/SimulationInspectorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR | ContextFlags::OBSERVER,
+    {
+      CompletionProvider::tr("Variables")
+    },
+    CompletionProvider::tr("Get variable values on given period (read-only view)"),
+    "OPENFLUID_GetVariablesView(%%SEL_START%%UnitPtr%%SEL_END%%,\"varname\",BeginIndex,EndIndex)"
+  )
+);
+
+// extracted from ware/SimulationInspectorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR | ContextFlags::OBSERVER,
+    {
+      CompletionProvider::tr("Variables")
+    },
+    CompletionProvider::tr("Get latest available variable values for all units of a class"),
+    "OPENFLUID_GetLatestVariableForClass(%%SEL_START%%\"unitsclass\"%%SEL_END%%,\"varname\",Values)"
+  )
+);
+
 // extracted from ware/SimulationInspectorWare.hpp
 addRule(
   Rule(
@@ -1836,6 +2019,18 @@ addRule(
   )
 );
 
+// extracted from ware/SimulationInspectorWare.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR | ContextFlags::OBSERVER,
+    {
+      CompletionProvider::tr("Spatial structure")
+    },
+    CompletionProvider::tr("Get the topology of a units class built as a matrix"),
+    "OPENFLUID_GetUnitsMatrixTopology(%%SEL_START%%ClassName%%SEL_END%%)"
+  )
+);
+
 // extracted from ware/SimulationInspectorWare.hpp
 addRule(
   Rule(
@@ -1920,3 +2115,15 @@ addRule(
   )
 );
 
+// extracted from ware/ThreadedLoopMacros.hpp
+addRule(
+  Rule(
+    "cpp",Origin::OPENFLUID,ContextFlags::SIMULATOR,
+    {
+      CompletionProvider::tr("Loops")
+    },
+    CompletionProvider::tr("Threaded loop on spatial units of a class following upstream connections"),
+    "APPLY_UNITS_GRAPH_ORDERED_LOOP_THREADED(\"%%SEL_START%%UnitsClass%%SEL_END%%\",FuncPtr)"
+  )
+);
+
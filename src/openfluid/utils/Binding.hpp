@@ -41,6 +41,10 @@
 
 
 #include <clocale>
+#include <cctype>
+#include <charconv>
+#include <limits>
+#include <sstream>
 
 #include <openfluid/config.hpp>
 #include <openfluid/base/Init.hpp>
@@ -67,6 +71,8 @@
 #include <openfluid/fluidx/SimulatorDescriptor.hpp>
 #include <openfluid/fluidx/GeneratorDescriptor.hpp>
 #include <openfluid/machine/MonitoringInstance.hpp>
+#include <openfluid/machine/ResultsStore.hpp>
+#include <openfluid/tools/StringHelpers.hpp>
 #include <openfluid/ware/PluggableWare.hpp>
 
 
@@ -140,6 +146,8 @@ class Binding
 
     bool m_IsSimulationRun = false;
 
+    openfluid::machine::ResultsStore m_ResultsStore;
+
 
     // =====================================================================
     // =====================================================================
@@ -191,6 +199,149 @@ class Binding
     // =====================================================================
 
 
+    /**
+      Returns the units of the given class if the given attribute exists for this class, nullptr otherwise
+    */
+    openfluid::fluidx::SpatialDomainDescriptor::SpatialUnitsByID_t* unitsWithAttribute(const char* UnitsClass,
+                                                                                        const char* AttrName)
+    {
+      auto& SpatialDomain = m_FluidXDesc.spatialDomain();
+
+      if (!SpatialDomain.isClassNameExists(UnitsClass) ||
+          !SpatialDomain.getAttributesNames(UnitsClass).count(AttrName))
+      {
+        return nullptr;
+      }
+
+      return &SpatialDomain.spatialUnits().at(UnitsClass);
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    template<typename T>
+    static std::string numberToString(T Value)
+    {
+#if defined(__cpp_lib_to_chars)
+      char Buffer[32];
+      const auto Result = std::to_chars(Buffer,Buffer+sizeof(Buffer),Value);
+      return std::string(Buffer,Result.ptr);
+#else
+      std::ostringstream Stm;
+      Stm.precision(std::numeric_limits<T>::max_digits10);
+      Stm << Value;
+      return Stm.str();
+#endif
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    template<typename T>
+    static bool stringToNumber(const std::string& Str, T& Value)
+    {
+#if defined(__cpp_lib_to_chars)
+      const char* Begin = Str.data();
+      const char* End = Begin+Str.size();
+
+      while (Begin != End && std::isspace(static_cast<unsigned char>(*Begin)))
+      {
+        ++Begin;
+      }
+      while (Begin != End && std::isspace(static_cast<unsigned char>(*(End-1))))
+      {
+        --End;
+      }
+
+      const auto Result = std::from_chars(Begin,End,Value);
+      return (Result.ec == std::errc() && Result.ptr == End && Begin != End);
+#else
+      return openfluid::tools::toNumeric(Str,Value);
+#endif
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    template<typename T>
+    unsigned int setAttributeValues(const char* UnitsClass, const char* AttrName,
+                                    const int* UnitsIDs, const T* Values, unsigned int Count)
+    {
+      auto* Units = unitsWithAttribute(UnitsClass,AttrName);
+
+      if (!Units)
+      {
+        return 0;
+      }
+
+      const std::string AttrNameStr(AttrName);
+      unsigned int SetCount = 0;
+
+      for (unsigned int i=0; i<Count; i++)
+      {
+        auto It = Units->find(UnitsIDs[i]);
+
+        if (It != Units->end())
+        {
+          It->second.attributes()[AttrNameStr] = numberToString(Values[i]);
+          SetCount++;
+        }
+      }
+
+      return SetCount;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    template<typename T>
+    unsigned int getAttributeValues(const char* UnitsClass, const char* AttrName,
+                                    const int* UnitsIDs, T* Values, unsigned int Count, T DefaultValue)
+    {
+      auto* Units = unitsWithAttribute(UnitsClass,AttrName);
+      const std::string AttrNameStr(AttrName);
+      unsigned int GotCount = 0;
+
+      for (unsigned int i=0; i<Count; i++)
+      {
+        Values[i] = DefaultValue;
+
+        if (Units)
+        {
+          const auto It = Units->find(UnitsIDs[i]);
+
+          if (It != Units->end())
+          {
+            const auto AttrIt = It->second.attributes().find(AttrNameStr);
+
+            if (AttrIt != It->second.attributes().end() && stringToNumber(AttrIt->second,Values[i]))
+            {
+              GotCount++;
+            }
+            else
+            {
+              Values[i] = DefaultValue;
+            }
+          }
+        }
+      }
+
+      return GotCount;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
   public:
 
     /**
@@ -705,6 +856,7 @@ class Binding
         else
         {
           Listener = std::make_unique<openfluid::machine::MachineListener>();
+          Listener->setSilentRunSteps();
         }
 
 
@@ -754,6 +906,8 @@ class Binding
         openfluid::machine::Factory::buildMonitoringInstanceFromDescriptor(m_FluidXDesc.monitoring(),
                                                                            Monitoring);
 
+        Monitoring.resultsStore() = m_ResultsStore;
+
         if (IsVerbose)
         {
           static_cast<BindingVerboseMachineListener*>(Listener.get())->
@@ -776,6 +930,8 @@ class Binding
 
         Engine->finalize();
 
+        m_ResultsStore = std::move(Engine->resultsStore());
+
         delete Engine;
 
         m_IsSimulationRun = true;
@@ -1778,6 +1934,88 @@ class Binding
     // =====================================================================
 
 
+    /**
+      Sets the values of an attribute for a set of spatial units of a given class, from an array of doubles.
+      @param[in] UnitsClass The spatial units class
+      @param[in] AttrName The name of the attribute, which must exist for the units class
+      @param[in] UnitsIDs The array of spatial units IDs
+      @param[in] Values The array of values, in the same order as the spatial units IDs
+      @param[in] Count The size of the arrays
+      @return The number of set values, units which do not exist are ignored
+    */
+    unsigned int setAttributeValuesAsDouble(const char* UnitsClass, const char* AttrName,
+                                            const int* UnitsIDs, const double* Values, unsigned int Count)
+    {
+      return setAttributeValues(UnitsClass,AttrName,UnitsIDs,Values,Count);
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Sets the values of an attribute for a set of spatial units of a given class, from an array of integers.
+      @param[in] UnitsClass The spatial units class
+      @param[in] AttrName The name of the attribute, which must exist for the units class
+      @param[in] UnitsIDs The array of spatial units IDs
+      @param[in] Values The array of values, in the same order as the spatial units IDs
+      @param[in] Count The size of the arrays
+      @return The number of set values, units which do not exist are ignored
+    */
+    unsigned int setAttributeValuesAsLong(const char* UnitsClass, const char* AttrName,
+                                          const int* UnitsIDs, const long* Values, unsigned int Count)
+    {
+      return setAttributeValues(UnitsClass,AttrName,UnitsIDs,Values,Count);
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Gets the values of an attribute for a set of spatial units of a given class, into an array of doubles.
+      Values of units which do not exist or which cannot be converted are set to NaN.
+      @param[in] UnitsClass The spatial units class
+      @param[in] AttrName The name of the attribute
+      @param[in] UnitsIDs The array of spatial units IDs
+      @param[out] Values The array receiving the values, in the same order as the spatial units IDs
+      @param[in] Count The size of the arrays
+      @return The number of successfully converted values
+    */
+    unsigned int getAttributeValuesAsDouble(const char* UnitsClass, const char* AttrName,
+                                            const int* UnitsIDs, double* Values, unsigned int Count)
+    {
+      return getAttributeValues(UnitsClass,AttrName,UnitsIDs,Values,Count,std::numeric_limits<double>::quiet_NaN());
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Gets the values of an attribute for a set of spatial units of a given class, into an array of integers.
+      Values of units which do not exist or which cannot be converted are set to 0.
+      @param[in] UnitsClass The spatial units class
+      @param[in] AttrName The name of the attribute
+      @param[in] UnitsIDs The array of spatial units IDs
+      @param[out] Values The array receiving the values, in the same order as the spatial units IDs
+      @param[in] Count The size of the arrays
+      @return The number of successfully converted values
+    */
+    unsigned int getAttributeValuesAsLong(const char* UnitsClass, const char* AttrName,
+                                          const int* UnitsIDs, long* Values, unsigned int Count)
+    {
+      return getAttributeValues(UnitsClass,AttrName,UnitsIDs,Values,Count,0L);
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
     /**
       Adds simulation variable to be automatically exported using CSV format.
       @param[in] BindingName The name used as an identifier in output files names
@@ -1829,6 +2067,105 @@ class Binding
                            openfluid::core::StringValue(BindingNameStr));
     }
 
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Adds a simulation variable to be stored in memory during the simulation.
+      Stored values are available using the getVariableValues() method after the simulation run,
+      numeric values (double, integer and boolean values) are stored as double precision values.
+      @param[in] UnitsClass The name of the spatial units class
+      @param[in] VarName The name of the variable
+    */
+    void addVariablesExportInMemory(const char* UnitsClass, const char* VarName)
+    {
+      m_ResultsStore.addVariable(UnitsClass,VarName);
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Adds a simulation variable to be stored in memory during the simulation, with values aggregated
+      on the fly over time windows. Each stored value is the aggregation of the values of a window,
+      indexed by the beginning of the window.
+      @param[in] UnitsClass The name of the spatial units class
+      @param[in] VarName The name of the variable
+      @param[in] Aggregation The aggregation of values: "mean", "sum", "min" or "max"
+      @param[in] Window The duration of aggregation windows in seconds, 0 to aggregate over the whole simulation
+      @return 1 if the variable is added, 0 if the aggregation is unknown
+    */
+    unsigned short int addVariablesAggregationInMemory(const char* UnitsClass, const char* VarName,
+                                                       const char* Aggregation, unsigned int Window)
+    {
+      openfluid::machine::ResultsStore::Aggregation Aggr;
+
+      if (!openfluid::machine::ResultsStore::getAggregationFromString(Aggregation,Aggr))
+      {
+        m_LastErrorMsg = "OpenFLUID ERROR: unknown aggregation " + std::string(Aggregation) + "\n";
+        return 0;
+      }
+
+      m_ResultsStore.addVariable(UnitsClass,VarName,Aggr,Window);
+      return 1;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Removes all the simulation variables to be stored in memory, and their stored values.
+    */
+    void clearVariablesExportInMemory()
+    {
+      m_ResultsStore.clearVariables();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Returns the number of values stored in memory for a variable of a spatial unit during the last simulation run.
+      @param[in] UnitsClass The name of the spatial units class
+      @param[in] UnitID The spatial unit ID
+      @param[in] VarName The name of the variable
+      @return The number of stored values
+    */
+    unsigned int getVariableValuesCount(const char* UnitsClass, int UnitID, const char* VarName)
+    {
+      return m_ResultsStore.getValuesCount(UnitsClass,UnitID,VarName);
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Copies the values stored in memory for a variable of a spatial unit during the last simulation run
+      into caller-provided arrays. Missing values are set to NaN.
+      @param[in] UnitsClass The name of the spatial units class
+      @param[in] UnitID The spatial unit ID
+      @param[in] VarName The name of the variable
+      @param[out] Values The array receiving the values
+      @param[out] TimeIndexes The array receiving the time indexes of the values, ignored if NULL
+      @param[in] Count The size of the arrays
+      @return The number of copied values
+    */
+    unsigned int getVariableValues(const char* UnitsClass, int UnitID, const char* VarName,
+                                   double* Values, openfluid::core::TimeIndex_t* TimeIndexes, unsigned int Count)
+    {
+      return m_ResultsStore.copyValues(UnitsClass,UnitID,VarName,Values,TimeIndexes,Count);
+    }
+
 };
 
 
@@ -65,6 +65,12 @@ const GDALDriversFilesExts_t getOGRFilesDriversForOpenFLUID()
     Drivers["GeoJSON"].FilesExts.push_back("geojson");
   }
 
+  if (OGRGetDriverByName("GPKG"))
+  {
+    Drivers["GPKG"].Label = "GeoPackage";
+    Drivers["GPKG"].FilesExts.push_back("gpkg");
+  }
+
   if (OGRGetDriverByName("GML"))
   {
     Drivers["GML"].Label = "GML";
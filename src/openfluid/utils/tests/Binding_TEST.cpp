@@ -43,6 +43,8 @@
 #define BOOST_TEST_MODULE unittest_binding
 
 
+#include <cmath>
+
 #include <boost/test/unit_test.hpp>
 #include <boost/test/tools/floating_point_comparison.hpp>
 
@@ -390,6 +392,30 @@ BOOST_AUTO_TEST_CASE(check_attributes)
   BOOST_REQUIRE(std::string(TB->getAttributesNames("TestUnits")).find("bindStr") == std::string::npos);
   BOOST_REQUIRE_EQUAL(TB->getAttribute("TestUnits",8,"bindStr"),"");
 
+  const int IDs[] = {1,2,3,99};
+  const double DoubleVals[] = {0.1,2.5e-12,-3.0,4.0};
+  double GotDoubleVals[4];
+  BOOST_REQUIRE_EQUAL(TB->setAttributeValuesAsDouble("TestUnits","indataDouble",IDs,DoubleVals,4),3);
+  BOOST_REQUIRE_EQUAL(TB->getAttributeValuesAsDouble("TestUnits","indataDouble",IDs,GotDoubleVals,4),3);
+  for (unsigned int i=0; i<3; i++)
+  {
+    BOOST_REQUIRE_EQUAL(GotDoubleVals[i],DoubleVals[i]);
+  }
+  BOOST_REQUIRE(std::isnan(GotDoubleVals[3]));
+  BOOST_REQUIRE_EQUAL(TB->getAttribute("TestUnits",1,"indataDouble"),"0.1");
+
+  const long LongVals[] = {10,-20,30,40};
+  long GotLongVals[4];
+  BOOST_REQUIRE_EQUAL(TB->setAttributeValuesAsLong("TestUnits","indataLong",IDs,LongVals,4),3);
+  BOOST_REQUIRE_EQUAL(TB->getAttributeValuesAsLong("TestUnits","indataLong",IDs,GotLongVals,4),3);
+  BOOST_REQUIRE_EQUAL(GotLongVals[1],-20);
+  BOOST_REQUIRE_EQUAL(GotLongVals[3],0);
+  BOOST_REQUIRE_EQUAL(TB->getAttribute("TestUnits",2,"indataLong"),"-20");
+
+  BOOST_REQUIRE_EQUAL(TB->getAttributeValuesAsLong("TestUnits","indataString",IDs,GotLongVals,4),0);
+  BOOST_REQUIRE_EQUAL(TB->setAttributeValuesAsDouble("TestUnits","indataWrong",IDs,DoubleVals,4),0);
+  BOOST_REQUIRE_EQUAL(TB->setAttributeValuesAsDouble("WrongUnits","indataDouble",IDs,DoubleVals,4),0);
+
   openfluid::utils::Binding::destroy(TB);
 }
 
@@ -411,10 +437,22 @@ BOOST_AUTO_TEST_CASE(check_simulations)
   TB = openfluid::utils::Binding::openDataset(DSPath.c_str());
 
   TB->addVariablesExportAsCSV("binding","TestUnits","*","*",10);
+  TB->addVariablesExportInMemory("TestUnits","tests.double");
+  BOOST_REQUIRE_EQUAL(TB->addVariablesAggregationInMemory("TestUnits","tests.integer","sum",0),1);
+  BOOST_REQUIRE_EQUAL(TB->addVariablesAggregationInMemory("TestUnits","tests.integer","median",0),0);
 
   BOOST_CHECK_EQUAL(TB->runSimulation(),1);
   std::cout << TB->getLastError() << std::endl;
 
+  const unsigned int ValuesCount = TB->getVariableValuesCount("TestUnits",1,"tests.double");
+  BOOST_CHECK(ValuesCount > 0);
+  std::vector<double> Values(ValuesCount);
+  std::vector<openfluid::core::TimeIndex_t> Indexes(ValuesCount);
+  BOOST_CHECK_EQUAL(TB->getVariableValues("TestUnits",1,"tests.double",Values.data(),Indexes.data(),ValuesCount),
+                    ValuesCount);
+  BOOST_CHECK_EQUAL(TB->getVariableValuesCount("TestUnits",1,"tests.wrong"),0);
+  BOOST_CHECK_EQUAL(TB->getVariableValuesCount("TestUnits",1,"tests.integer"),1);
+
   BOOST_CHECK_EQUAL(TB->runSimulation(true),1);
   std::cout << TB->getLastError() << std::endl;
 
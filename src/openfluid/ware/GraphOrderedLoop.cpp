@@ -0,0 +1,411 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file GraphOrderedLoop.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#include <algorithm>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+#include <openfluid/ware/GraphOrderedLoop.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+namespace openfluid { namespace ware {
+
+
+GraphOrderedLoop::GraphOrderedLoop(openfluid::core::UnitsCollection* Units)
+{
+  setUnits(Units);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+GraphOrderedLoop::~GraphOrderedLoop()
+{
+  stopThreads();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void GraphOrderedLoop::setUnits(openfluid::core::UnitsCollection* Units)
+{
+  m_Units.clear();
+  m_UpstreamCounts.clear();
+  m_DownstreamStarts.clear();
+  m_Downstream.clear();
+  m_Pending.reset();
+
+  if (Units == nullptr || Units->size() == 0)
+  {
+    m_DownstreamStarts.push_back(0);
+    return;
+  }
+
+  const openfluid::core::UnitsClass_t UnitsClass = Units->list()->front().getClass();
+
+  m_Units.reserve(Units->size());
+  std::unordered_map<const openfluid::core::SpatialUnit*,std::size_t> Indexes;
+  Indexes.reserve(Units->size());
+
+  for (auto& Unit : *(Units->list()))
+  {
+    Indexes[&Unit] = m_Units.size();
+    m_Units.push_back(&Unit);
+  }
+
+  m_UpstreamCounts.assign(m_Units.size(),0);
+  m_DownstreamStarts.reserve(m_Units.size()+1);
+
+  for (auto* Unit : m_Units)
+  {
+    m_DownstreamStarts.push_back(m_Downstream.size());
+
+    const openfluid::core::UnitsPtrList_t* ToUnits = Unit->toSpatialUnits(UnitsClass);
+
+    if (ToUnits != nullptr)
+    {
+      for (auto* ToUnit : *ToUnits)
+      {
+        auto it = Indexes.find(ToUnit);
+
+        if (it != Indexes.end())
+        {
+          m_Downstream.push_back(it->second);
+          m_UpstreamCounts[it->second]++;
+        }
+      }
+    }
+  }
+
+  m_DownstreamStarts.push_back(m_Downstream.size());
+  m_Pending.reset(new std::atomic<unsigned int>[m_Units.size()]);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void GraphOrderedLoop::runSequential(const UnitFunction_t& Func) const
+{
+  std::vector<unsigned int> Pending(m_UpstreamCounts);
+  std::deque<std::size_t> Ready;
+
+  for (std::size_t i = 0; i < m_Units.size(); i++)
+  {
+    if (Pending[i] == 0)
+    {
+      Ready.push_back(i);
+    }
+  }
+
+  std::size_t ProcessedCount = 0;
+
+  while (!Ready.empty())
+  {
+    const std::size_t Current = Ready.front();
+    Ready.pop_front();
+
+    Func(m_Units[Current]);
+    ProcessedCount++;
+
+    for (std::size_t d = m_DownstreamStarts[Current]; d < m_DownstreamStarts[Current+1]; d++)
+    {
+      if (--Pending[m_Downstream[d]] == 0)
+      {
+        Ready.push_back(m_Downstream[d]);
+      }
+    }
+  }
+
+  if (ProcessedCount != m_Units.size())
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Graph ordered loop cannot be applied on connections containing cycles");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void GraphOrderedLoop::processReadyUnit(std::unique_lock<std::mutex>& Lock)
+{
+  const std::size_t Current = m_Ready.front();
+  m_Ready.pop_front();
+  m_ActiveCount++;
+
+  Lock.unlock();
+
+  std::exception_ptr Error;
+  std::vector<std::size_t> Released;
+
+  try
+  {
+    (*mp_Func)(m_Units[Current]);
+  }
+  catch (...)
+  {
+    Error = std::current_exception();
+  }
+
+  if (!Error)
+  {
+    for (std::size_t d = m_DownstreamStarts[Current]; d < m_DownstreamStarts[Current+1]; d++)
+    {
+      if (m_Pending[m_Downstream[d]].fetch_sub(1) == 1)
+      {
+        Released.push_back(m_Downstream[d]);
+      }
+    }
+  }
+
+  Lock.lock();
+
+  m_ActiveCount--;
+  m_ProcessedCount++;
+
+  if (Error)
+  {
+    if (!m_FirstError)
+    {
+      m_FirstError = Error;
+    }
+    m_Stopped = true;
+  }
+
+  m_Ready.insert(m_Ready.end(),Released.begin(),Released.end());
+
+  if (m_ActiveCount == 0 && (m_Stopped || m_Ready.empty()))
+  {
+    // end of the run, wakes up the calling thread
+    m_Condition.notify_all();
+  }
+  else if (!m_Stopped && Released.size() > 1)
+  {
+    // the current thread takes one of the released units, other threads are woken up for the remaining ones
+    for (std::size_t i = 1; i < Released.size(); i++)
+    {
+      m_Condition.notify_one();
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void GraphOrderedLoop::startThreads(unsigned int ThreadsNbr)
+{
+  if (m_Threads.size() == ThreadsNbr)
+  {
+    return;
+  }
+
+  stopThreads();
+
+  try
+  {
+    for (unsigned int t = 0; t < ThreadsNbr; t++)
+    {
+      m_Threads.push_back(std::thread([this]()
+      {
+        std::unique_lock<std::mutex> Lock(m_Mutex);
+
+        while (true)
+        {
+          m_Condition.wait(Lock,[this](){ return m_Exiting || (m_Running && !m_Stopped && !m_Ready.empty()); });
+
+          if (m_Exiting)
+          {
+            return;
+          }
+
+          processReadyUnit(Lock);
+        }
+      }));
+    }
+  }
+  catch (std::system_error& E)
+  {
+    stopThreads();
+
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Error in graph ordered loop (" + std::string(E.what()) +")");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void GraphOrderedLoop::stopThreads()
+{
+  {
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+    m_Exiting = true;
+  }
+  m_Condition.notify_all();
+
+  for (auto& Thread : m_Threads)
+  {
+    Thread.join();
+  }
+
+  m_Threads.clear();
+  m_Exiting = false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void GraphOrderedLoop::runParallel(const UnitFunction_t& Func, unsigned int ThreadsNbr)
+{
+  // the calling thread is one of the threads processing the units
+  startThreads(ThreadsNbr-1);
+
+  std::unique_lock<std::mutex> Lock(m_Mutex);
+
+  m_Ready.clear();
+  for (std::size_t i = 0; i < m_Units.size(); i++)
+  {
+    m_Pending[i].store(m_UpstreamCounts[i]);
+
+    if (m_UpstreamCounts[i] == 0)
+    {
+      m_Ready.push_back(i);
+    }
+  }
+
+  mp_Func = &Func;
+  m_ProcessedCount = 0;
+  m_ActiveCount = 0;
+  m_Stopped = false;
+  m_FirstError = nullptr;
+  m_Running = true;
+
+  for (std::size_t i = 1; i < std::min<std::size_t>(m_Ready.size(),ThreadsNbr); i++)
+  {
+    m_Condition.notify_one();
+  }
+
+  while (true)
+  {
+    m_Condition.wait(Lock,[this](){ return (!m_Stopped && !m_Ready.empty()) || m_ActiveCount == 0; });
+
+    if (!m_Stopped && !m_Ready.empty())
+    {
+      processReadyUnit(Lock);
+    }
+    else
+    {
+      // no more runnable units and no running unit that could release some
+      break;
+    }
+  }
+
+  m_Running = false;
+  mp_Func = nullptr;
+  m_Ready.clear();
+
+  const std::exception_ptr FirstError = m_FirstError;
+  const std::size_t ProcessedCount = m_ProcessedCount;
+  m_FirstError = nullptr;
+
+  Lock.unlock();
+
+  if (FirstError)
+  {
+    std::rethrow_exception(FirstError);
+  }
+
+  if (ProcessedCount != m_Units.size())
+  {
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Graph ordered loop cannot be applied on connections containing cycles");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void GraphOrderedLoop::run(const UnitFunction_t& Func, unsigned int MaxThreads)
+{
+  if (m_Units.empty())
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+
+    if (m_Running)
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "Graph ordered loops on the same units cannot be nested");
+    }
+  }
+
+  const unsigned int ThreadsNbr = std::min<std::size_t>(MaxThreads,m_Units.size());
+
+  if (ThreadsNbr < 2)
+  {
+    runSequential(Func);
+  }
+  else
+  {
+    runParallel(Func,ThreadsNbr);
+  }
+}
+
+
+} }  // namespaces
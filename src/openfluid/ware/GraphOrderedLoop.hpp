@@ -0,0 +1,189 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file GraphOrderedLoop.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+*/
+
+
+#ifndef __OPENFLUID_WARE_GRAPHORDEREDLOOP_HPP__
+#define __OPENFLUID_WARE_GRAPHORDEREDLOOP_HPP__
+
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <openfluid/core/SpatialUnit.hpp>
+#include <openfluid/dllexport.hpp>
+
+
+namespace openfluid { namespace ware {
+
+
+/**
+  Dependency-driven loop over the units of a class, following the From/To connections between units of this class.
+  A unit is processed as soon as all its upstream units ("from" units of the same class) have been processed.
+  Independent units are processed concurrently on a pool of threads, without any barrier between process orders.
+  Connections with units of other classes are ignored.
+  The dependencies and the threads pool are kept between runs, so a loop object is meant to be reused
+  at each time step and rebuilt using setUnits() only when the spatial graph changes.
+*/
+class OPENFLUID_API GraphOrderedLoop
+{
+  public:
+
+    using UnitFunction_t = std::function<void(openfluid::core::SpatialUnit*)>;
+
+
+  private:
+
+    std::vector<openfluid::core::SpatialUnit*> m_Units;
+
+    std::vector<unsigned int> m_UpstreamCounts;
+
+    /**
+      Downstream units indexes of each unit, stored contiguously: downstream units of unit i
+      are m_Downstream[m_DownstreamStarts[i]] to m_Downstream[m_DownstreamStarts[i+1]-1]
+    */
+    std::vector<std::size_t> m_DownstreamStarts;
+
+    std::vector<std::size_t> m_Downstream;
+
+    /**
+      Remaining upstream units of each unit during a parallel run
+    */
+    std::unique_ptr<std::atomic<unsigned int>[]> m_Pending;
+
+    std::vector<std::thread> m_Threads;
+
+    std::mutex m_Mutex;
+
+    std::condition_variable m_Condition;
+
+    // state of the current parallel run, guarded by m_Mutex
+
+    const UnitFunction_t* mp_Func = nullptr;
+
+    std::deque<std::size_t> m_Ready;
+
+    std::size_t m_ProcessedCount = 0;
+
+    unsigned int m_ActiveCount = 0;
+
+    bool m_Running = false;
+
+    bool m_Stopped = false;
+
+    bool m_Exiting = false;
+
+    std::exception_ptr m_FirstError;
+
+    void runSequential(const UnitFunction_t& Func) const;
+
+    void runParallel(const UnitFunction_t& Func, unsigned int ThreadsNbr);
+
+    void processReadyUnit(std::unique_lock<std::mutex>& Lock);
+
+    void startThreads(unsigned int ThreadsNbr);
+
+    void stopThreads();
+
+
+  public:
+
+    GraphOrderedLoop() = delete;
+
+    GraphOrderedLoop(const GraphOrderedLoop&) = delete;
+
+    GraphOrderedLoop& operator=(const GraphOrderedLoop&) = delete;
+
+    /**
+      Builds the dependencies between the units of the given collection
+      @param[in] Units the units collection, may be nullptr
+    */
+    GraphOrderedLoop(openfluid::core::UnitsCollection* Units);
+
+    /**
+      Stops and joins the threads of the pool
+    */
+    ~GraphOrderedLoop();
+
+    /**
+      Rebuilds the dependencies between the units of the given collection, keeping the threads pool.
+      Must not be called during a run.
+      @param[in] Units the units collection, may be nullptr
+    */
+    void setUnits(openfluid::core::UnitsCollection* Units);
+
+    /**
+      Returns the number of units in the loop
+    */
+    std::size_t getUnitsCount() const
+    {
+      return m_Units.size();
+    }
+
+    /**
+      Returns the number of threads currently kept in the pool, the calling thread excluded
+    */
+    std::size_t getPoolSize() const
+    {
+      return m_Threads.size();
+    }
+
+    /**
+      Applies the given function to each unit, following the upstream/downstream dependencies.
+      The calling thread takes part in the processing, along with MaxThreads-1 threads of the pool
+      which are started at the first run and kept for the next ones.
+      @param[in] Func the function applied to each unit
+      @param[in] MaxThreads the maximum number of threads, the function is run in the calling thread if lower than 2
+      @throw openfluid::base::FrameworkException if the connections contain a cycle or if runs are nested.
+      Exceptions thrown by the function are rethrown once the running units are done
+    */
+    void run(const UnitFunction_t& Func, unsigned int MaxThreads);
+
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_WARE_GRAPHORDEREDLOOP_HPP__ */
@@ -41,6 +41,7 @@
 #include <openfluid/base/FrameworkException.hpp>
 #include <openfluid/tools/StringHelpers.hpp>
 #include <openfluid/ware/PluggableSimulator.hpp>
+#include <openfluid/ware/GraphOrderedLoop.hpp>
 
 
 // =====================================================================
@@ -276,4 +277,30 @@ void PluggableSimulator::OPENFLUID_SetSimulatorMaxThreads(const int& MaxNumThrea
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+void PluggableSimulator::OPENFLUID_GraphOrderedParallelLoop(
+  const openfluid::core::UnitsClass_t& UnitsClass,
+  const std::function<void(openfluid::core::SpatialUnit*)>& Func)
+{
+  // dependencies are rebuilt only when the spatial graph changed since the previous loop on this class,
+  // the threads pool of the loop is kept between calls
+  auto& CachedLoop = m_GraphOrderedLoops[UnitsClass];
+
+  if (!CachedLoop.second)
+  {
+    CachedLoop.second = std::make_unique<GraphOrderedLoop>(mp_SpatialData->spatialUnits(UnitsClass));
+  }
+  else if (CachedLoop.first != mp_SpatialData->getRevision())
+  {
+    CachedLoop.second->setUnits(mp_SpatialData->spatialUnits(UnitsClass));
+  }
+  CachedLoop.first = mp_SpatialData->getRevision();
+
+  CachedLoop.second->run(Func,m_MaxThreads);
+}
+
+
 } } // namespaces
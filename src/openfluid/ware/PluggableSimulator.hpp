@@ -42,10 +42,14 @@
 
 
 #include <string>
+#include <functional>
+#include <map>
+#include <memory>
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/ware/SimulatorSignature.hpp>
 #include <openfluid/core/TypeDefs.hpp>
+#include <openfluid/core/MapValue.hpp>
 #include <openfluid/base/SchedulingRequest.hpp>
 #include <openfluid/ware/LoopMacros.hpp>
 #include <openfluid/core/DateTime.hpp>
@@ -92,6 +96,9 @@
 namespace openfluid { namespace ware {
 
 
+class GraphOrderedLoop;
+
+
 /**
   @brief Abstract class for simulator plugin
 
@@ -115,6 +122,12 @@ class OPENFLUID_API PluggableSimulator : public SimulationContributorWare
 
     int m_MaxThreads;
 
+    /**
+      Graph ordered loops by units class, with the spatial graph revision they were built for
+    */
+    std::map<openfluid::core::UnitsClass_t,
+             std::pair<std::uint64_t,std::unique_ptr<GraphOrderedLoop>>> m_GraphOrderedLoops;
+
 
   protected:
 
@@ -314,6 +327,26 @@ class OPENFLUID_API PluggableSimulator : public SimulationContributorWare
     */
     void OPENFLUID_SetSimulatorMaxThreads(const int& MaxNumThreads);
 
+    /**
+      Applies a function to each unit of a class, following the From/To connections between units of this class.
+      A unit is processed as soon as all its upstream units of the same class have been processed,
+      independent units are processed concurrently using at most OPENFLUID_GetSimulatorMaxThreads() threads.
+      Connections must not contain cycles.
+      @param[in] UnitsClass the name of the units class
+      @param[in] Func the function applied to each unit, which must only modify data of the given unit
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR"],
+        "menupath" : ["Threading"],
+        "title" : "Threaded loop on spatial units of a class following upstream connections",
+        "text" : "OPENFLUID_GraphOrderedParallelLoop(%%SEL_START%%UnitsClass%%SEL_END%%,Func)"
+      }
+      @endcond
+    */
+    void OPENFLUID_GraphOrderedParallelLoop(const openfluid::core::UnitsClass_t& UnitsClass,
+                                            const std::function<void(openfluid::core::SpatialUnit*)>& Func);
+
     /**
       Returns a scheduling request to a single scheduling at the end
       Return the corresponding scheduling request
@@ -455,6 +488,23 @@ class OPENFLUID_API PluggableSimulator : public SimulationContributorWare
     */
     virtual void finalizeRun() = 0;
 
+    /**
+      Saves the internal state of the simulator when a checkpoint of the running simulation is written.
+      Simulators keeping data between time steps outside of variables and attributes should override this method.
+      Internally called by the framework.
+      @param[out] State the map receiving the internal state
+    */
+    virtual void saveState(openfluid::core::MapValue& /*State*/) const
+    { }
+
+    /**
+      Restores the internal state of the simulator when the simulation restarts from a checkpoint,
+      after the initializeRun() method. Internally called by the framework.
+      @param[in] State the map containing the internal state saved by the saveState() method
+    */
+    virtual void restoreState(const openfluid::core::MapValue& /*State*/)
+    { }
+
 };
 
 
@@ -424,6 +424,64 @@ void SimulationContributorWare::OPENFLUID_AppendVariable(openfluid::core::Spatia
 // =====================================================================
 
 
+void SimulationContributorWare::OPENFLUID_AppendVariable(openfluid::core::SpatialUnit *UnitPtr,
+                                                         const openfluid::core::VariableName_t& VarName,
+                                                         openfluid::core::VectorValue&& Val)
+{
+  REQUIRE_SIMULATION_STAGE(openfluid::base::SimulationStatus::RUNSTEP,
+                           "Variables values cannot be added outside RUNSTEP stage")
+
+  if (UnitPtr != nullptr)
+  {
+    if (!UnitPtr->variables()->appendValue(VarName,OPENFLUID_GetCurrentTimeIndex(),
+                                          std::make_unique<openfluid::core::VectorValue>(std::move(Val))))
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+          .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Error appending vector value for variable "+ VarName);
+    }
+  }
+  else
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationContributorWare::OPENFLUID_AppendVariable(openfluid::core::SpatialUnit *UnitPtr,
+                                                         const openfluid::core::VariableName_t& VarName,
+                                                         openfluid::core::MatrixValue&& Val)
+{
+  REQUIRE_SIMULATION_STAGE(openfluid::base::SimulationStatus::RUNSTEP,
+                           "Variables values cannot be added outside RUNSTEP stage")
+
+  if (UnitPtr != nullptr)
+  {
+    if (!UnitPtr->variables()->appendValue(VarName,OPENFLUID_GetCurrentTimeIndex(),
+                                          std::make_unique<openfluid::core::MatrixValue>(std::move(Val))))
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+          .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Error appending matrix value for variable "+ VarName);
+    }
+  }
+  else
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void SimulationContributorWare::OPENFLUID_SetVariable(openfluid::core::SpatialUnit *UnitPtr,
                                                       const openfluid::core::VariableName_t& VarName,
                                                       const openfluid::core::Value& Val)
@@ -567,6 +625,106 @@ void SimulationContributorWare::OPENFLUID_SetVariable(openfluid::core::SpatialUn
 // =====================================================================
 
 
+void SimulationContributorWare::OPENFLUID_SetVariable(openfluid::core::SpatialUnit *UnitPtr,
+                                                      const openfluid::core::VariableName_t& VarName,
+                                                      openfluid::core::VectorValue&& Val)
+{
+  REQUIRE_SIMULATION_STAGE(openfluid::base::SimulationStatus::RUNSTEP,
+                           "Variables can be modified during RUNSTEP stage only")
+
+  if (UnitPtr != nullptr)
+  {
+    if (!UnitPtr->variables()->modifyValue(VarName,OPENFLUID_GetCurrentTimeIndex(),
+                                          std::make_unique<openfluid::core::VectorValue>(std::move(Val))))
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+          .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Error setting vector value for variable "+ VarName);
+    }
+  }
+  else
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationContributorWare::OPENFLUID_SetVariable(openfluid::core::SpatialUnit *UnitPtr,
+                                                      const openfluid::core::VariableName_t& VarName,
+                                                      openfluid::core::MatrixValue&& Val)
+{
+  REQUIRE_SIMULATION_STAGE(openfluid::base::SimulationStatus::RUNSTEP,
+                           "Variables can be modified during RUNSTEP stage only")
+
+  if (UnitPtr != nullptr)
+  {
+    if (!UnitPtr->variables()->modifyValue(VarName,OPENFLUID_GetCurrentTimeIndex(),
+                                          std::make_unique<openfluid::core::MatrixValue>(std::move(Val))))
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+          .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Error setting matrix value for variable "+ VarName);
+    }
+  }
+  else
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::core::Value& SimulationContributorWare::OPENFLUID_GetCurrentVariableRef(
+  openfluid::core::SpatialUnit *UnitPtr, const openfluid::core::VariableName_t& VarName)
+{
+  REQUIRE_SIMULATION_STAGE(openfluid::base::SimulationStatus::RUNSTEP,
+                           "Variables can be modified during RUNSTEP stage only")
+
+  if (UnitPtr != nullptr)
+  {
+    openfluid::core::Value* ValPtr =
+      UnitPtr->variables()->currentValueIfIndex(VarName,OPENFLUID_GetCurrentTimeIndex());
+
+    if (!ValPtr)
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+          .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Value for variable "+ VarName +
+                                                " does not exist at current time index");
+    }
+
+    if (UnitPtr->variables()->isSharedVariable(VarName))
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+          .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Value for variable "+ VarName +
+                                                " is shared and cannot be modified");
+    }
+
+    return *ValPtr;
+  }
+  else
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void SimulationContributorWare::OPENFLUID_AppendEvent(openfluid::core::SpatialUnit *UnitPtr,
                                                       openfluid::core::Event& Ev)
 {
@@ -597,14 +755,12 @@ void SimulationContributorWare::OPENFLUID_AddUnit(const openfluid::core::UnitsCl
   REQUIRE_SIMULATION_STAGE_LE(openfluid::base::SimulationStatus::CHECKCONSISTENCY,
                               "Spatial graph can be modified during PREPAREDATA and CHECKCONSISTENCY stages only")
 
-  if (!mp_SpatialData->addUnit(openfluid::core::SpatialUnit(ClassName,ID,PcsOrder)))
+  if (!mp_SpatialData->insertUnit(openfluid::core::SpatialUnit(ClassName,ID,PcsOrder)))
   {
     openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
         .addSpatialUnit(openfluid::tools::classIDToString(ClassName,ID));
     throw openfluid::base::FrameworkException(Context,"Error adding unit");
   }
-
-  mp_SpatialData->sortUnitsByProcessOrder();
 }
 
 
@@ -631,8 +787,44 @@ void SimulationContributorWare::OPENFLUID_DeleteUnit(const openfluid::core::Unit
   }
 
   mp_SpatialData->deleteUnit(TheUnit);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationContributorWare::OPENFLUID_BeginSpatialGraphBatch()
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::PREPAREDATA,
+                              "Spatial graph can be modified during PREPAREDATA and CHECKCONSISTENCY stages only")
+  REQUIRE_SIMULATION_STAGE_LE(openfluid::base::SimulationStatus::CHECKCONSISTENCY,
+                              "Spatial graph can be modified during PREPAREDATA and CHECKCONSISTENCY stages only")
 
-  mp_SpatialData->sortUnitsByProcessOrder();
+  if (!mp_SpatialData->beginBatch())
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),
+                                              "A batch of spatial graph changes is already in progress");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationContributorWare::OPENFLUID_EndSpatialGraphBatch()
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::PREPAREDATA,
+                              "Spatial graph can be modified during PREPAREDATA and CHECKCONSISTENCY stages only")
+  REQUIRE_SIMULATION_STAGE_LE(openfluid::base::SimulationStatus::CHECKCONSISTENCY,
+                              "Spatial graph can be modified during PREPAREDATA and CHECKCONSISTENCY stages only")
+
+  if (!mp_SpatialData->endBatch())
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),
+                                              "No batch of spatial graph changes in progress");
+  }
 }
 
 
@@ -676,7 +868,7 @@ bool SimulationContributorWare::OPENFLUID_AddFromToConnection(openfluid::core::S
 
   if (FromUnit != nullptr || ToUnit != nullptr)
   {
-    return (FromUnit->addToUnit(ToUnit) && ToUnit->addFromUnit(FromUnit));
+    return mp_SpatialData->addFromToConnection(FromUnit,ToUnit);
   }
   else
   {
@@ -850,160 +1042,53 @@ void SimulationContributorWare::OPENFLUID_BuildUnitsMatrix(const openfluid::core
   REQUIRE_SIMULATION_STAGE_LE(openfluid::base::SimulationStatus::CHECKCONSISTENCY,
                               "Spatial graph can be modified during PREPAREDATA and CHECKCONSISTENCY stages only")
 
-  openfluid::core::UnitID_t CurrID = 0;
-  openfluid::core::UnitID_t ToID = 0;
+  if (!mp_SpatialData->buildUnitsMatrix(UnitsClass,ColsNbr,RowsNbr,1,true))
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),
+                                              "Error building units matrix for class "+UnitsClass);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
 
-  for (unsigned int i=0; i<RowsNbr;i++)
+
+void SimulationContributorWare::OPENFLUID_BuildImplicitUnitsMatrix(const openfluid::core::UnitsClass_t& UnitsClass,
+                                                                   const unsigned int& ColsNbr,
+                                                                   const unsigned int& RowsNbr)
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::PREPAREDATA,
+                              "Spatial graph can be modified during PREPAREDATA and CHECKCONSISTENCY stages only")
+  REQUIRE_SIMULATION_STAGE_LE(openfluid::base::SimulationStatus::CHECKCONSISTENCY,
+                              "Spatial graph can be modified during PREPAREDATA and CHECKCONSISTENCY stages only")
+
+  if (!mp_SpatialData->buildUnitsMatrix(UnitsClass,ColsNbr,RowsNbr,1,false))
   {
-    for (unsigned int j=0; j<ColsNbr;j++)
-    {
-      CurrID = 1+((ColsNbr*i)+j);
-      OPENFLUID_AddUnit(UnitsClass,CurrID,1);
-    }
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),
+                                              "Error building units matrix for class "+UnitsClass);
   }
+}
+
 
-  for (unsigned int i=0; i<RowsNbr;i++)
+// =====================================================================
+// =====================================================================
+
+
+void SimulationContributorWare::OPENFLUID_AddUnitsWithConnections(
+  const openfluid::core::UnitsClass_t& UnitsClass,
+  const std::vector<std::pair<openfluid::core::UnitID_t,openfluid::core::PcsOrd_t>>& Units,
+  const std::vector<std::pair<openfluid::core::UnitID_t,openfluid::core::UnitID_t>>& FromToConnections)
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::PREPAREDATA,
+                              "Spatial graph can be modified during PREPAREDATA and CHECKCONSISTENCY stages only")
+  REQUIRE_SIMULATION_STAGE_LE(openfluid::base::SimulationStatus::CHECKCONSISTENCY,
+                              "Spatial graph can be modified during PREPAREDATA and CHECKCONSISTENCY stages only")
+
+  if (!mp_SpatialData->addUnitsWithConnections(UnitsClass,Units,FromToConnections))
   {
-    for (unsigned int j=0; j<ColsNbr;j++)
-    {
-      CurrID = 1+((ColsNbr*i)+j);
-
-      if (i == 0)
-      {
-        // top
-
-        if (j == 0)
-        {
-          // top-left
-          ToID = CurrID+1;
-          OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-          ToID = CurrID+ColsNbr;
-          OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-        }
-        else
-        {
-          if (j == ColsNbr-1)
-          {
-            // top-right
-            ToID = CurrID-1;
-            OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-            ToID = CurrID+ColsNbr;
-            OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-          }
-          else
-          {
-            // top-center
-            ToID = CurrID-1;
-            OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-            ToID = CurrID+1;
-            OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-            ToID = CurrID+ColsNbr;
-            OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-          }
-        }
-
-      }
-      else
-      {
-        if (i == RowsNbr-1)
-        {
-          // bottom
-
-          if (j == 0)
-          {
-            // bottom-left
-            ToID = CurrID+1;
-            OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-            ToID = CurrID-ColsNbr;
-            OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-          }
-          else
-          {
-            if (j == ColsNbr-1)
-            {
-              // bottom-right
-              ToID = CurrID-1;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-              ToID = CurrID-ColsNbr;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-            }
-            else
-            {
-              // bottom-center
-              ToID = CurrID-1;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-              ToID = CurrID+1;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-              ToID = CurrID-ColsNbr;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-            }
-          }
-
-        }
-        else
-        {
-          // middle
-
-          if (j == 0)
-          {
-            // middle-left
-            ToID = CurrID+1;
-            OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-            ToID = CurrID-ColsNbr;
-            OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-            ToID = CurrID+ColsNbr;
-            OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-          }
-          else
-          {
-            if (j == ColsNbr-1)
-            {
-              // middle-right
-              ToID = CurrID-1;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-              ToID = CurrID-ColsNbr;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-              ToID = CurrID+ColsNbr;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-            }
-            else
-            {
-              // middle-center
-              ToID = CurrID-1;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-              ToID = CurrID+1;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-              ToID = CurrID-ColsNbr;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-              ToID = CurrID+ColsNbr;
-              OPENFLUID_AddFromToConnection(UnitsClass,CurrID,UnitsClass,ToID);
-
-            }
-          }
-        }
-      }
-    }
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),
+                                              "Error adding units with connections for class "+UnitsClass);
   }
 }
 
@@ -262,6 +262,39 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                   const openfluid::core::VariableName_t& VarName,
                                   const std::string& Val);
 
+    /**
+      Appends a distributed vector variable value for a unit at the end
+      of the previously added values for this variable.
+      The vector is moved into the variable storage without copy, and is left empty
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the variable
+      @param[in] Val the added value of the variable (vector), moved
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR"],
+        "menupath" : ["Variables"],
+        "title" : "Append vector value to a variable without copy",
+        "text" : "OPENFLUID_AppendVariable(%%SEL_START%%UnitPtr%%SEL_END%%,\"varname\",std::move(Val))"
+      }
+      @endcond
+    */
+    void OPENFLUID_AppendVariable(openfluid::core::SpatialUnit *UnitPtr,
+                                  const openfluid::core::VariableName_t& VarName,
+                                  openfluid::core::VectorValue&& Val);
+
+    /**
+      Appends a distributed matrix variable value for a unit at the end
+      of the previously added values for this variable.
+      The matrix is moved into the variable storage without copy, and is left empty
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the variable
+      @param[in] Val the added value of the variable (matrix), moved
+    */
+    void OPENFLUID_AppendVariable(openfluid::core::SpatialUnit *UnitPtr,
+                                  const openfluid::core::VariableName_t& VarName,
+                                  openfluid::core::MatrixValue&& Val);
+
 
     /**
       Sets a distributed variable value for a unit at the current time index
@@ -322,6 +355,49 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                const openfluid::core::VariableName_t& VarName,
                                const std::string& Val);
 
+    /**
+      Sets a distributed vector variable value for a unit at the current time index.
+      The vector is moved into the variable storage without copy, and is left empty
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the variable
+      @param[in] Val the value of the variable (vector), moved
+    */
+    void OPENFLUID_SetVariable(openfluid::core::SpatialUnit *UnitPtr,
+                               const openfluid::core::VariableName_t& VarName,
+                               openfluid::core::VectorValue&& Val);
+
+    /**
+      Sets a distributed matrix variable value for a unit at the current time index.
+      The matrix is moved into the variable storage without copy, and is left empty
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the variable
+      @param[in] Val the value of the variable (matrix), moved
+    */
+    void OPENFLUID_SetVariable(openfluid::core::SpatialUnit *UnitPtr,
+                               const openfluid::core::VariableName_t& VarName,
+                               openfluid::core::MatrixValue&& Val);
+
+    /**
+      Returns a mutable reference to the value of a distributed variable for a unit at the current time index,
+      allowing in-place updates of the value without copy.
+      The value must have been previously appended at the current time index.
+      The reference is valid until the next value is appended to this variable
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the variable
+      @return a reference to the stored value
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR"],
+        "menupath" : ["Variables"],
+        "title" : "Get a mutable reference to the current value of a variable",
+        "text" : "OPENFLUID_GetCurrentVariableRef(%%SEL_START%%UnitPtr%%SEL_END%%,\"varname\")"
+      }
+      @endcond
+    */
+    openfluid::core::Value& OPENFLUID_GetCurrentVariableRef(openfluid::core::SpatialUnit *UnitPtr,
+                                                            const openfluid::core::VariableName_t& VarName);
+
     /**
       Appends an event on a unit
       @param[in] UnitPtr a Unit
@@ -376,6 +452,37 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
     void OPENFLUID_DeleteUnit(const openfluid::core::UnitsClass_t& ClassName,
                               openfluid::core::UnitID_t ID);
 
+    /**
+      Begins a batch of changes on the spatial graph. Until the batch is ended,
+      added units are not placed at their process order position, the spatial graph is sorted once
+      when OPENFLUID_EndSpatialGraphBatch() is called.
+      A batch still in progress is ended automatically at the end of the current simulator stage.
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR"],
+        "menupath" : ["Spatial structure"],
+        "title" : "Begin a batch of changes on the spatial graph",
+        "text" : "OPENFLUID_BeginSpatialGraphBatch()"
+      }
+      @endcond
+    */
+    void OPENFLUID_BeginSpatialGraphBatch();
+
+    /**
+      Ends a batch of changes on the spatial graph and sorts the spatial graph by process order
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR"],
+        "menupath" : ["Spatial structure"],
+        "title" : "End a batch of changes on the spatial graph",
+        "text" : "OPENFLUID_EndSpatialGraphBatch()"
+      }
+      @endcond
+    */
+    void OPENFLUID_EndSpatialGraphBatch();
+
 
     /**
       Adds a from-to connection between two units
@@ -543,7 +650,9 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                                openfluid::core::SpatialUnit* ParentUnit);
 
     /**
-      Builds a ColsNbr x RowsNbr unix matrix with bi-directionnal connections
+      Builds a ColsNbr x RowsNbr units matrix with bi-directionnal connections.
+      Units are numbered row by row starting at 1, with a process order of 1.
+      The topology of the matrix is available using OPENFLUID_GetUnitsMatrixTopology()
       @param[in] UnitsClass the name of units class
       @param[in] ColsNbr the number of units on the X axis
       @param[in] RowsNbr the number of units on the Y axis
@@ -561,6 +670,48 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                     const unsigned int& ColsNbr,
                                     const unsigned int& RowsNbr);
 
+    /**
+      Builds a ColsNbr x RowsNbr units matrix without stored connections.
+      Units are numbered row by row starting at 1, with a process order of 1.
+      Neighbours of units must be computed using the topology of the matrix
+      given by OPENFLUID_GetUnitsMatrixTopology(), which greatly reduces memory use for large matrices
+      @param[in] UnitsClass the name of units class
+      @param[in] ColsNbr the number of units on the X axis
+      @param[in] RowsNbr the number of units on the Y axis
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR"],
+        "menupath" : ["Spatial structure"],
+        "title" : "Build a matrix of spatial units with implicit topology",
+        "text" : "OPENFLUID_BuildImplicitUnitsMatrix(%%SEL_START%%ClassName%%SEL_END%%,ColsNbr,RowsNbr)"
+      }
+      @endcond
+    */
+    void OPENFLUID_BuildImplicitUnitsMatrix(const openfluid::core::UnitsClass_t& UnitsClass,
+                                            const unsigned int& ColsNbr,
+                                            const unsigned int& RowsNbr);
+
+    /**
+      Adds a set of units of the same class and the from-to connections between them in a single operation
+      @param[in] UnitsClass the name of units class
+      @param[in] Units the IDs and process orders of the units to add
+      @param[in] FromToConnections the from-to connections as pairs of (from ID, to ID)
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR"],
+        "menupath" : ["Spatial structure"],
+        "title" : "Add a set of spatial units with their connections",
+        "text" : "OPENFLUID_AddUnitsWithConnections(%%SEL_START%%ClassName%%SEL_END%%,UnitsIDsOrders,FromToIDs)"
+      }
+      @endcond
+    */
+    void OPENFLUID_AddUnitsWithConnections(
+      const openfluid::core::UnitsClass_t& UnitsClass,
+      const std::vector<std::pair<openfluid::core::UnitID_t,openfluid::core::PcsOrd_t>>& Units,
+      const std::vector<std::pair<openfluid::core::UnitID_t,openfluid::core::UnitID_t>>& FromToConnections);
+
     SimulationContributorWare(WareType WType) : SimulationInspectorWare(WType)
     { }
 
@@ -37,6 +37,8 @@
  */
 
 
+#include <limits>
+
 #include <openfluid/ware/SimulationInspectorWare.hpp>
 #include <openfluid/tools/IDHelpers.hpp>
 
@@ -199,6 +201,34 @@ const openfluid::core::Value* SimulationInspectorWare::OPENFLUID_GetAttribute(
 // =====================================================================
 
 
+void SimulationInspectorWare::OPENFLUID_GetAttributeForClass(const openfluid::core::UnitsClass_t& ClassName,
+                                                             const openfluid::core::AttributeName_t& AttrName,
+                                                             std::vector<double>& Values) const
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::PREPAREDATA,
+                              "Attributes cannot be accessed during INITPARAMS stage");
+
+  const openfluid::core::UnitsCollection* Units = mp_SpatialData->spatialUnits(ClassName);
+
+  if (Units == nullptr)
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),
+                                              "Units class "+ClassName+" does not exist");
+  }
+
+  if (!Units->getAttributeColumn(AttrName,Values))
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),
+                                              "Numeric values for attribute "+AttrName+
+                                              " are not available on all units of class "+ClassName);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 bool SimulationInspectorWare::OPENFLUID_IsAttributeExist(const openfluid::core::SpatialUnit *UnitPtr,
                                                          const openfluid::core::AttributeName_t& AttrName) const
 {
@@ -210,9 +240,7 @@ bool SimulationInspectorWare::OPENFLUID_IsAttributeExist(const openfluid::core::
     return UnitPtr->attributes()->isAttributeExist(AttrName);
   }
 
-  openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
-                  .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
-  throw openfluid::base::FrameworkException(Context,"Unit is NULL");
+  throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
 
   return false;
 }
@@ -645,6 +673,185 @@ openfluid::core::IndexedValueList SimulationInspectorWare::OPENFLUID_GetVariable
 // =====================================================================
 
 
+const openfluid::core::IndexedValue& SimulationInspectorWare::OPENFLUID_GetLatestVariableView(
+                                                           const openfluid::core::SpatialUnit* UnitPtr,
+                                                           const openfluid::core::VariableName_t& VarName) const
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::INITIALIZERUN,
+                              "Variables can be accessed only during INITIALIZERUN, RUNSTEP and FINALIZERUN stages")
+
+  if (UnitPtr != nullptr)
+  {
+    const openfluid::core::IndexedValue* IndVal = UnitPtr->variables()->latestIndexedValue(VarName);
+
+    if (!IndVal)
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+          .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Indexed value for variable "+ VarName +" does not exist or is empty");
+    }
+    return *IndVal;
+  }
+  else
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::core::IndexedValuesView SimulationInspectorWare::OPENFLUID_GetLatestVariablesView(
+                                                           const openfluid::core::SpatialUnit* UnitPtr,
+                                                           const openfluid::core::VariableName_t& VarName,
+                                                           const openfluid::core::TimeIndex_t BeginIndex) const
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::INITIALIZERUN,
+                              "Variables lists can be accessed only during RUNSTEP and FINALIZERUN stages")
+
+  if (UnitPtr != nullptr)
+  {
+    openfluid::core::IndexedValuesView View;
+    if (!UnitPtr->variables()->getLatestIndexedValuesView(VarName,BeginIndex,View))
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+              .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Indexed values for variable "+ VarName +" does not exist or is empty");
+    }
+    return View;
+  }
+  else
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::core::IndexedValuesView SimulationInspectorWare::OPENFLUID_GetVariablesView(
+                                                           const openfluid::core::SpatialUnit* UnitPtr,
+                                                           const openfluid::core::VariableName_t& VarName,
+                                                           const openfluid::core::TimeIndex_t BeginIndex,
+                                                           const openfluid::core::TimeIndex_t EndIndex) const
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::RUNSTEP,
+                              "Variables lists can be accessed only during RUNSTEP and FINALIZERUN stages")
+
+  if (UnitPtr != nullptr)
+  {
+    openfluid::core::IndexedValuesView View;
+    if (!UnitPtr->variables()->getIndexedValuesView(VarName,BeginIndex,EndIndex,View))
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+                      .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Indexed values for variable "+ VarName +
+                                                " does not exist or is empty");
+    }
+    return View;
+  }
+  else
+  {
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationInspectorWare::OPENFLUID_GetLatestVariableForClass(const openfluid::core::UnitsClass_t& ClassName,
+                                                                  const openfluid::core::VariableName_t& VarName,
+                                                                  std::vector<const openfluid::core::Value*>& Values)
+                                                                  const
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::INITIALIZERUN,
+                              "Variables can be accessed only during INITIALIZERUN, RUNSTEP and FINALIZERUN stages")
+
+  Values.clear();
+
+  const openfluid::core::UnitsCollection* Units = mp_SpatialData->spatialUnits(ClassName);
+
+  if (Units == nullptr)
+  {
+    return;
+  }
+
+  Values.reserve(Units->size());
+
+  for (const auto& Unit : *(Units->list()))
+  {
+    const openfluid::core::IndexedValue* IndVal = Unit.variables()->latestIndexedValue(VarName);
+    Values.push_back(IndVal ? IndVal->value() : nullptr);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int SimulationInspectorWare::OPENFLUID_GetLatestVariableForClass(
+                                                           const openfluid::core::UnitsClass_t& ClassName,
+                                                           const openfluid::core::VariableName_t& VarName,
+                                                           std::vector<double>& Values) const
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::INITIALIZERUN,
+                              "Variables can be accessed only during INITIALIZERUN, RUNSTEP and FINALIZERUN stages")
+
+  Values.clear();
+
+  const openfluid::core::UnitsCollection* Units = mp_SpatialData->spatialUnits(ClassName);
+
+  if (Units == nullptr)
+  {
+    return 0;
+  }
+
+  unsigned int FoundCount = 0;
+  openfluid::core::DoubleValue ConvertedValue;
+
+  Values.resize(Units->size(),std::numeric_limits<double>::quiet_NaN());
+
+  auto ValIt = Values.begin();
+
+  for (const auto& Unit : *(Units->list()))
+  {
+    const openfluid::core::IndexedValue* IndVal = Unit.variables()->latestIndexedValue(VarName);
+
+    if (IndVal)
+    {
+      if (IndVal->value()->isDoubleValue())
+      {
+        *ValIt = IndVal->value()->asDoubleValue().get();
+        FoundCount++;
+      }
+      else if (IndVal->value()->convert(ConvertedValue))
+      {
+        *ValIt = ConvertedValue.get();
+        FoundCount++;
+      }
+    }
+
+    ++ValIt;
+  }
+
+  return FoundCount;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 bool SimulationInspectorWare::OPENFLUID_IsVariableExist(const openfluid::core::SpatialUnit *UnitPtr,
                                                         const openfluid::core::VariableName_t& VarName) const
 {
@@ -919,6 +1126,17 @@ openfluid::core::UnitsPtrList_t SimulationInspectorWare::OPENFLUID_GetUnits(
 // =====================================================================
 
 
+const openfluid::core::UnitsMatrixTopology* SimulationInspectorWare::OPENFLUID_GetUnitsMatrixTopology(
+    const openfluid::core::UnitsClass_t& ClassName) const
+{
+  return mp_SpatialData->unitsMatrixTopology(ClassName);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 bool SimulationInspectorWare::OPENFLUID_IsUnitConnectedTo(openfluid::core::SpatialUnit* aUnit,
                                                           const openfluid::core::UnitsClass_t& ClassNameTo,
                                                           const openfluid::core::UnitID_t& IDTo) const
@@ -162,6 +162,28 @@ class OPENFLUID_API SimulationInspectorWare : public SimulationDrivenWare
     const openfluid::core::Value* OPENFLUID_GetAttribute(const openfluid::core::SpatialUnit *UnitPtr,
                                                          const openfluid::core::AttributeName_t& AttrName) const;
 
+    /**
+      Gets the values of an attribute for all units of a class, as a contiguous array of doubles
+      gathered from the columnar storage of the class attributes.
+      Values are given in the process order of the units, as returned by OPENFLUID_GetUnits().
+      Integer values are converted to doubles.
+      @param[in] ClassName the name of the units class
+      @param[in] AttrName the name of the requested attribute
+      @param[out] Values the values of the attribute, one per unit of the class
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR", "OBSERVER"],
+        "menupath" : ["Attributes"],
+        "title" : "Get attribute values for all units of a class",
+        "text" : "OPENFLUID_GetAttributeForClass(%%SEL_START%%\"unitsclass\"%%SEL_END%%,\"attrname\",Values)"
+      }
+      @endcond
+    */
+    void OPENFLUID_GetAttributeForClass(const openfluid::core::UnitsClass_t& ClassName,
+                                        const openfluid::core::AttributeName_t& AttrName,
+                                        std::vector<double>& Values) const;
+
     /**
        Returns true if a distributed variable exists, false otherwise
        @param[in] UnitPtr a Unit
@@ -557,6 +579,111 @@ class OPENFLUID_API SimulationInspectorWare : public SimulationDrivenWare
                                                              const openfluid::core::TimeIndex_t BeginIndex,
                                                              const openfluid::core::TimeIndex_t EndIndex) const;
 
+    /**
+      Returns a read-only reference to the latest available variable for a unit, without copy of the value.
+      The reference remains valid until the variable is modified, which means during the current time step
+      for observers
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the requested variable
+      @return the value and timeindex of the requested variable
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR", "OBSERVER"],
+        "menupath" : ["Variables"],
+        "title" : "Get latest available variable value (read-only reference)",
+        "text" : "OPENFLUID_GetLatestVariableView(%%SEL_START%%UnitPtr%%SEL_END%%,\"varname\")"
+      }
+      @endcond
+    */
+    const openfluid::core::IndexedValue& OPENFLUID_GetLatestVariableView(const openfluid::core::SpatialUnit* UnitPtr,
+                                                                         const openfluid::core::VariableName_t& VarName)
+                                                                         const;
+
+    /**
+      Returns a read-only view on the latest available variables for a unit since the given time index,
+      without copy of the values. The view remains valid until the variable is modified,
+      which means during the current time step for observers
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the requested variable
+      @param[in] BeginIndex The beginning time index of the search period
+      @return the view on the time-indexed values of the requested variable
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR", "OBSERVER"],
+        "menupath" : ["Variables"],
+        "title" : "Get latest available variable values since a time index (read-only view)",
+        "text" : "OPENFLUID_GetLatestVariablesView(%%SEL_START%%UnitPtr%%SEL_END%%,\"varname\",TimeIndex)"
+      }
+      @endcond
+    */
+    openfluid::core::IndexedValuesView OPENFLUID_GetLatestVariablesView(const openfluid::core::SpatialUnit* UnitPtr,
+                                                                        const openfluid::core::VariableName_t& VarName,
+                                                                        const openfluid::core::TimeIndex_t BeginIndex)
+                                                                        const;
+
+    /**
+      Returns a read-only view on the available variables for a unit during a given period
+      (between two time indexes), without copy of the values. The view remains valid until the variable
+      is modified, which means during the current time step for observers
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the requested variable
+      @param[in] BeginIndex the time index for the beginning of the period
+      @param[in] EndIndex the time index for the end of the period
+      @return the view on the time-indexed values of the requested variable
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR", "OBSERVER"],
+        "menupath" : ["Variables"],
+        "title" : "Get variable values on given period (read-only view)",
+        "text" : "OPENFLUID_GetVariablesView(%%SEL_START%%UnitPtr%%SEL_END%%,\"varname\",BeginIndex,EndIndex)"
+      }
+      @endcond
+    */
+    openfluid::core::IndexedValuesView OPENFLUID_GetVariablesView(const openfluid::core::SpatialUnit* UnitPtr,
+                                                                  const openfluid::core::VariableName_t& VarName,
+                                                                  const openfluid::core::TimeIndex_t BeginIndex,
+                                                                  const openfluid::core::TimeIndex_t EndIndex) const;
+
+    /**
+      Gets the latest available values of a variable for all units of a class, without copy of the values.
+      Values are given in the process order of the units, as returned by OPENFLUID_GetUnits().
+      A value is nullptr if the variable does not exist or has no value for the corresponding unit.
+      The values remain valid until the variables are modified, which means during the current time step
+      for observers
+      @param[in] ClassName the name of the units class
+      @param[in] VarName the name of the requested variable
+      @param[out] Values the latest values, one per unit of the class
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR", "OBSERVER"],
+        "menupath" : ["Variables"],
+        "title" : "Get latest available variable values for all units of a class",
+        "text" : "OPENFLUID_GetLatestVariableForClass(%%SEL_START%%\"unitsclass\"%%SEL_END%%,\"varname\",Values)"
+      }
+      @endcond
+    */
+    void OPENFLUID_GetLatestVariableForClass(const openfluid::core::UnitsClass_t& ClassName,
+                                             const openfluid::core::VariableName_t& VarName,
+                                             std::vector<const openfluid::core::Value*>& Values) const;
+
+    /**
+      Gets the latest available values of a variable for all units of a class, as a contiguous array of doubles.
+      Values are given in the process order of the units, as returned by OPENFLUID_GetUnits().
+      A value is NaN if the variable does not exist, has no value,
+      or has a value which is not convertible to double for the corresponding unit.
+      @param[in] ClassName the name of the units class
+      @param[in] VarName the name of the requested variable
+      @param[out] Values the latest values, one per unit of the class
+      @return the number of units for which a value has been found
+    */
+    unsigned int OPENFLUID_GetLatestVariableForClass(const openfluid::core::UnitsClass_t& ClassName,
+                                                     const openfluid::core::VariableName_t& VarName,
+                                                     std::vector<double>& Values) const;
+
     /**
       Gets discrete events happening on a unit during a time period
       @param[in] UnitPtr a Unit
@@ -742,6 +869,23 @@ class OPENFLUID_API SimulationInspectorWare : public SimulationDrivenWare
     */
     openfluid::core::UnitsPtrList_t OPENFLUID_GetUnits(const openfluid::core::UnitsClass_t& ClassName);
 
+    /**
+      Returns the topology of a units class built as a matrix of units
+      @param[in] ClassName the requested class
+      @return a pointer to the topology, nullptr if the units class was not built as a matrix
+
+      @cond OpenFLUID:completion
+      {
+        "contexts" : ["SIMULATOR", "OBSERVER"],
+        "menupath" : ["Spatial structure"],
+        "title" : "Get the topology of a units class built as a matrix",
+        "text" : "OPENFLUID_GetUnitsMatrixTopology(%%SEL_START%%ClassName%%SEL_END%%)"
+      }
+      @endcond
+    */
+    const openfluid::core::UnitsMatrixTopology* OPENFLUID_GetUnitsMatrixTopology(
+      const openfluid::core::UnitsClass_t& ClassName) const;
+
     /**
       Returns true if a given unit is connected "to" another unit
       @param[in] aUnit the given unit
@@ -197,4 +197,28 @@
 // =====================================================================
 
 
+/**
+  Macro for applying a threaded simulator to each unit of a class, following the From/To connections
+  between units of this class: a unit is processed as soon as all its upstream units are processed
+  @param[in] unitsclass name of the units class
+  @param[in] funcptr member simulator name
+  @param[in] ... extra parameters to pass to the member simulator
+
+  @cond OpenFLUID:completion
+  {
+    "contexts" : ["SIMULATOR"],
+    "menupath" : ["Loops"],
+    "title" : "Threaded loop on spatial units of a class following upstream connections",
+    "text" : "APPLY_UNITS_GRAPH_ORDERED_LOOP_THREADED(\"%%SEL_START%%UnitsClass%%SEL_END%%\",FuncPtr)"
+  }
+  @endcond
+*/
+#define APPLY_UNITS_GRAPH_ORDERED_LOOP_THREADED(unitsclass,funcptr,...) \
+    OPENFLUID_GraphOrderedParallelLoop(unitsclass,std::bind(&funcptr,this,std::placeholders::_1,## __VA_ARGS__))
+
+
+// =====================================================================
+// =====================================================================
+
+
 #endif /* __OPENFLUID_WARE_THREADEDLOOPMACROS_HPP__ */
@@ -0,0 +1,335 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file GraphOrderedLoop_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_graphorderedloop
+
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/ware/GraphOrderedLoop.hpp>
+#include <openfluid/ware/PluggableSimulator.hpp>
+#include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Builds a binary tree of units where each unit flows to its parent, the root being unit 1
+*/
+void buildTree(openfluid::core::SpatialGraph& SGraph, unsigned int UnitsNbr)
+{
+  std::vector<std::pair<openfluid::core::UnitID_t,openfluid::core::PcsOrd_t>> Units;
+  std::vector<std::pair<openfluid::core::UnitID_t,openfluid::core::UnitID_t>> Connections;
+
+  for (unsigned int i = 1; i <= UnitsNbr; i++)
+  {
+    Units.emplace_back(i,1);
+    if (i > 1)
+    {
+      Connections.emplace_back(i,i/2);
+    }
+  }
+
+  SGraph.addUnitsWithConnections("TU",Units,Connections);
+  SGraph.addUnit(openfluid::core::SpatialUnit("OU",1,1));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void checkAccumulation(unsigned int MaxThreads)
+{
+  const unsigned int UnitsNbr = 2047;
+
+  openfluid::core::SpatialGraph SGraph;
+  buildTree(SGraph,UnitsNbr);
+
+  openfluid::ware::GraphOrderedLoop Loop(SGraph.spatialUnits("TU"));
+  BOOST_REQUIRE_EQUAL(Loop.getUnitsCount(),UnitsNbr);
+
+  std::map<openfluid::core::UnitID_t,unsigned int> Accumulated;
+  for (unsigned int i = 1; i <= UnitsNbr; i++)
+  {
+    Accumulated[i] = 0;
+  }
+  std::atomic<unsigned int> CallsCount(0);
+  std::atomic<bool> OrderViolated(false);
+
+  Loop.run([&](openfluid::core::SpatialUnit* U)
+  {
+    unsigned int Sum = 1;
+    const openfluid::core::UnitsPtrList_t* FromUnits = U->fromSpatialUnits("TU");
+
+    if (FromUnits != nullptr)
+    {
+      for (auto* FromUnit : *FromUnits)
+      {
+        // upstream units must have been processed
+        if (Accumulated.at(FromUnit->getID()) == 0)
+        {
+          OrderViolated = true;
+        }
+        Sum += Accumulated.at(FromUnit->getID());
+      }
+    }
+
+    Accumulated.at(U->getID()) = Sum;
+    CallsCount++;
+  },MaxThreads);
+
+  BOOST_REQUIRE(!OrderViolated);
+  BOOST_REQUIRE_EQUAL(CallsCount.load(),UnitsNbr);
+  BOOST_REQUIRE_EQUAL(Accumulated[1],UnitsNbr);
+  BOOST_REQUIRE_EQUAL(Accumulated[2],(UnitsNbr-1)/2);
+  BOOST_REQUIRE_EQUAL(Accumulated[UnitsNbr],1);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_sequential)
+{
+  checkAccumulation(1);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_parallel)
+{
+  checkAccumulation(2);
+  checkAccumulation(8);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_empty)
+{
+  openfluid::core::SpatialGraph SGraph;
+
+  openfluid::ware::GraphOrderedLoop Loop(SGraph.spatialUnits("TU"));
+  BOOST_REQUIRE_EQUAL(Loop.getUnitsCount(),0);
+  unsigned int CallsCount = 0;
+  Loop.run([&CallsCount](openfluid::core::SpatialUnit*){ CallsCount++; },4);
+  BOOST_REQUIRE_EQUAL(CallsCount,0);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_reuse)
+{
+  openfluid::core::SpatialGraph SGraph;
+  buildTree(SGraph,255);
+
+  openfluid::ware::GraphOrderedLoop Loop(SGraph.spatialUnits("TU"));
+  std::atomic<unsigned int> CallsCount(0);
+
+  for (unsigned int i = 0; i < 50; i++)
+  {
+    Loop.run([&CallsCount](openfluid::core::SpatialUnit*){ CallsCount++; },4);
+
+    // the pool is started at the first run and kept for the next ones
+    BOOST_REQUIRE_EQUAL(Loop.getPoolSize(),3);
+  }
+  BOOST_REQUIRE_EQUAL(CallsCount.load(),50*255);
+
+
+  // connections changes are detected through the spatial graph revision
+
+  const std::uint64_t Revision = SGraph.getRevision();
+  auto* NewUnit = SGraph.addUnit(openfluid::core::SpatialUnit("TU",256,1));
+  BOOST_REQUIRE_NE(SGraph.getRevision(),Revision);
+
+  const std::uint64_t AddedRevision = SGraph.getRevision();
+  SGraph.addFromToConnection(NewUnit,SGraph.spatialUnit("TU",128));
+  BOOST_REQUIRE_NE(SGraph.getRevision(),AddedRevision);
+
+  Loop.setUnits(SGraph.spatialUnits("TU"));
+  BOOST_REQUIRE_EQUAL(Loop.getUnitsCount(),256);
+  BOOST_REQUIRE_EQUAL(Loop.getPoolSize(),3);
+
+  std::atomic<bool> OrderViolated(false);
+  std::atomic<bool> NewUnitDone(false);
+
+  Loop.run([&](openfluid::core::SpatialUnit* U)
+  {
+    if (U->getID() == 256)
+    {
+      NewUnitDone = true;
+    }
+    else if (U->getID() == 128 && !NewUnitDone)
+    {
+      OrderViolated = true;
+    }
+  },4);
+  BOOST_REQUIRE(NewUnitDone);
+  BOOST_REQUIRE(!OrderViolated);
+
+
+  // changing the number of threads restarts the pool
+
+  Loop.run([](openfluid::core::SpatialUnit*){},2);
+  BOOST_REQUIRE_EQUAL(Loop.getPoolSize(),1);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+class GraphLoopSimulator : public openfluid::ware::PluggableSimulator
+{
+  public:
+
+    void initParams(const openfluid::ware::WareParams_t& /*Params*/)
+    {
+      OPENFLUID_SetSimulatorMaxThreads(4);
+    }
+
+    void prepareData()
+    { }
+
+    void checkConsistency()
+    { }
+
+    openfluid::base::SchedulingRequest initializeRun()
+    {
+      return DefaultDeltaT();
+    }
+
+    openfluid::base::SchedulingRequest runStep()
+    {
+      return DefaultDeltaT();
+    }
+
+    void finalizeRun()
+    { }
+
+    unsigned int countUnits(const openfluid::core::UnitsClass_t& UnitsClass)
+    {
+      std::atomic<unsigned int> Count(0);
+      OPENFLUID_GraphOrderedParallelLoop(UnitsClass,[&Count](openfluid::core::SpatialUnit*){ Count++; });
+      return Count;
+    }
+};
+
+
+BOOST_AUTO_TEST_CASE(check_simulator_loop)
+{
+  openfluid::core::SpatialGraph SGraph;
+  buildTree(SGraph,127);
+
+  GraphLoopSimulator Sim;
+  Sim.linkToSpatialGraph(&SGraph);
+  Sim.initParams(openfluid::ware::WareParams_t());
+
+  BOOST_REQUIRE_EQUAL(Sim.countUnits("TU"),127);
+  BOOST_REQUIRE_EQUAL(Sim.countUnits("TU"),127);
+  BOOST_REQUIRE_EQUAL(Sim.countUnits("OU"),1);
+  BOOST_REQUIRE_EQUAL(Sim.countUnits("XU"),0);
+
+  // the cached loop of the class is rebuilt when the spatial graph changes
+  SGraph.addUnit(openfluid::core::SpatialUnit("TU",128,1));
+  BOOST_REQUIRE_EQUAL(Sim.countUnits("TU"),128);
+
+  SGraph.deleteUnit(SGraph.spatialUnit("TU",2));
+  BOOST_REQUIRE_EQUAL(Sim.countUnits("TU"),127);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_errors)
+{
+  openfluid::core::SpatialGraph SGraph;
+
+  // cycle between units 2 and 3
+  SGraph.addUnitsWithConnections("CU",{{1,1},{2,1},{3,1}},{{1,2},{2,3},{3,2}});
+
+  openfluid::ware::GraphOrderedLoop CycleLoop(SGraph.spatialUnits("CU"));
+  BOOST_REQUIRE_THROW(CycleLoop.run([](openfluid::core::SpatialUnit*){},1),openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(CycleLoop.run([](openfluid::core::SpatialUnit*){},4),openfluid::base::FrameworkException);
+
+
+  // exception thrown by the applied function
+  buildTree(SGraph,255);
+  openfluid::ware::GraphOrderedLoop TreeLoop(SGraph.spatialUnits("TU"));
+
+  for (unsigned int Threads : {1,4})
+  {
+    std::atomic<unsigned int> CallsCount(0);
+
+    BOOST_REQUIRE_THROW(TreeLoop.run([&CallsCount](openfluid::core::SpatialUnit* U)
+                        {
+                          CallsCount++;
+                          if (U->getID() == 2)
+                          {
+                            throw std::runtime_error("error");
+                          }
+                        },Threads),
+                        std::runtime_error);
+
+    // unit 1 is downstream of unit 2 and must not be processed
+    BOOST_REQUIRE_LT(CallsCount.load(),255);
+  }
+}
@@ -0,0 +1,187 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+
+
+/**
+  @file SimulationContributorWare_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@inrae.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_simulationcontributorware
+
+
+#include <type_traits>
+
+#include <boost/test/unit_test.hpp>
+
+#include <openfluid/ware/PluggableSimulator.hpp>
+#include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/core/VectorValue.hpp>
+#include <openfluid/core/MatrixValue.hpp>
+#include <openfluid/core/ValuesBufferProperties.hpp>
+
+
+class MovingSimulator : public openfluid::ware::PluggableSimulator
+{
+  public:
+
+    void initParams(const openfluid::ware::WareParams_t& /*Params*/)
+    { }
+
+    void prepareData()
+    { }
+
+    void checkConsistency()
+    { }
+
+    openfluid::base::SchedulingRequest initializeRun()
+    {
+      return DefaultDeltaT();
+    }
+
+    openfluid::base::SchedulingRequest runStep()
+    {
+      return DefaultDeltaT();
+    }
+
+    void finalizeRun()
+    { }
+
+    void appendVector(openfluid::core::SpatialUnit* U, openfluid::core::VectorValue&& Val)
+    {
+      OPENFLUID_AppendVariable(U,"var.vector",std::move(Val));
+    }
+
+    void setVector(openfluid::core::SpatialUnit* U, openfluid::core::VectorValue&& Val)
+    {
+      OPENFLUID_SetVariable(U,"var.vector",std::move(Val));
+    }
+
+    void appendMatrix(openfluid::core::SpatialUnit* U, openfluid::core::MatrixValue&& Val)
+    {
+      OPENFLUID_AppendVariable(U,"var.matrix",std::move(Val));
+    }
+
+    void setMatrix(openfluid::core::SpatialUnit* U, openfluid::core::MatrixValue&& Val)
+    {
+      OPENFLUID_SetVariable(U,"var.matrix",std::move(Val));
+    }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_moved_values)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(3);
+
+  openfluid::base::SimulationStatus SimStatus(openfluid::core::DateTime(2012,1,1,0,0,0),
+                                              openfluid::core::DateTime(2012,1,2,0,0,0),60);
+  SimStatus.setCurrentStage(openfluid::base::SimulationStatus::RUNSTEP);
+
+  openfluid::core::SpatialGraph SGraph;
+  auto* U = SGraph.addUnit(openfluid::core::SpatialUnit("TU",1,1));
+  U->variables()->createVariable("var.vector",openfluid::core::Value::VECTOR);
+  U->variables()->createVariable("var.matrix",openfluid::core::Value::MATRIX);
+
+  MovingSimulator Sim;
+  Sim.linkToSimulation(&SimStatus);
+  Sim.linkToSpatialGraph(&SGraph);
+
+
+  // the storage of moved values is taken as is by the variables, without copy
+
+  openfluid::core::VectorValue Vect(1000,1.0);
+  const double* VectData = Vect.data();
+  Sim.appendVector(U,std::move(Vect));
+  BOOST_REQUIRE(Vect.data() == nullptr);
+  BOOST_REQUIRE_EQUAL(Vect.size(),0);
+  BOOST_REQUIRE(U->variables()->currentValue("var.vector")->asVectorValue().data() == VectData);
+  BOOST_REQUIRE_EQUAL(U->variables()->currentValue("var.vector")->asVectorValue().size(),1000);
+
+  openfluid::core::VectorValue OtherVect(1000,2.0);
+  const double* OtherVectData = OtherVect.data();
+  Sim.setVector(U,std::move(OtherVect));
+  BOOST_REQUIRE(U->variables()->currentValue("var.vector")->asVectorValue().data() == OtherVectData);
+  BOOST_REQUIRE_EQUAL(U->variables()->currentValue("var.vector")->asVectorValue().at(999),2.0);
+
+  openfluid::core::MatrixValue Matrix(20,50,1.0);
+  const double* MatrixData = Matrix.data();
+  Sim.appendMatrix(U,std::move(Matrix));
+  BOOST_REQUIRE(Matrix.data() == nullptr);
+  BOOST_REQUIRE_EQUAL(Matrix.getColsNbr(),0);
+  BOOST_REQUIRE(U->variables()->currentValue("var.matrix")->asMatrixValue().data() == MatrixData);
+
+  openfluid::core::MatrixValue OtherMatrix(20,50,2.0);
+  const double* OtherMatrixData = OtherMatrix.data();
+  Sim.setMatrix(U,std::move(OtherMatrix));
+  BOOST_REQUIRE(U->variables()->currentValue("var.matrix")->asMatrixValue().data() == OtherMatrixData);
+  BOOST_REQUIRE_EQUAL(U->variables()->currentValue("var.matrix")->asMatrixValue().at(19,49),2.0);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_moves)
+{
+  openfluid::core::Vector<double> Vect(10,3.0);
+  const double* VectData = Vect.data();
+
+  openfluid::core::Vector<double> MovedVect(std::move(Vect));
+  BOOST_REQUIRE(MovedVect.data() == VectData);
+  BOOST_REQUIRE(Vect.data() == nullptr);
+  BOOST_REQUIRE_EQUAL(Vect.size(),0);
+
+  openfluid::core::Vector<double> AssignedVect(5,1.0);
+  AssignedVect = std::move(MovedVect);
+  BOOST_REQUIRE(AssignedVect.data() == VectData);
+  BOOST_REQUIRE_EQUAL(AssignedVect.size(),10);
+  BOOST_REQUIRE(MovedVect.data() == nullptr);
+
+  openfluid::core::Matrix<double> Matrix(4,3,2.0);
+  const double* MatrixData = Matrix.data();
+
+  openfluid::core::Matrix<double> MovedMatrix(std::move(Matrix));
+  BOOST_REQUIRE(MovedMatrix.data() == MatrixData);
+  BOOST_REQUIRE_EQUAL(MovedMatrix.getRowsNbr(),3);
+  BOOST_REQUIRE(Matrix.data() == nullptr);
+  BOOST_REQUIRE_EQUAL(Matrix.getRowsNbr(),0);
+
+  BOOST_REQUIRE(std::is_nothrow_move_constructible<openfluid::core::VectorValue>::value);
+  BOOST_REQUIRE(std::is_nothrow_move_constructible<openfluid::core::MatrixValue>::value);
+}
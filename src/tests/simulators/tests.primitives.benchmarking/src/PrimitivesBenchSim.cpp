@@ -221,6 +221,73 @@ class PrimitivesBenchmarkingSimulator : public openfluid::ware::PluggableSimulat
       std::cout << "latest variable by reference: " << T.elapsed() << "ms" << std::endl;
 
 
+
+      // -----------------------------
+
+
+      const unsigned long VectSize = 200;
+      openfluid::core::VectorValue VectA(VectSize,1.5), VectB(VectSize,0.5);
+      openfluid::core::MatrixValue Mat(VectSize,VectSize,0.01);
+      openfluid::core::VectorValue VectY(VectSize);
+      double Acc = 0.0;
+
+      T.restart();
+      for (int i = 0;i<Repeats;i++)
+      {
+        for (unsigned long j = 0; j < VectSize; j++)
+        {
+          VectA.setElement(j,VectA.getElement(j)+0.001*VectB.getElement(j));
+          Acc += VectA.getElement(j)*VectB.getElement(j);
+        }
+      }
+      T.stop();
+
+      std::cout << "vector axpy+dot by naive loop: " << T.elapsed() << "ms" << std::endl;
+
+
+      T.restart();
+      for (int i = 0;i<Repeats;i++)
+      {
+        VectA.axpy(0.001,VectB);
+        Acc += VectA.dot(VectB);
+      }
+      T.stop();
+
+      std::cout << "vector axpy+dot by kernels (" << openfluid::core::kernels::getInstructionSet() << "): "
+                << T.elapsed() << "ms" << std::endl;
+
+
+      T.restart();
+      for (int i = 0;i<Repeats/100;i++)
+      {
+        for (unsigned long r = 0; r < VectSize; r++)
+        {
+          double RowSum = 0.0;
+          for (unsigned long c = 0; c < VectSize; c++)
+          {
+            RowSum += Mat.getElement(c,r)*VectB.getElement(c);
+          }
+          VectY.setElement(r,RowSum);
+        }
+      }
+      T.stop();
+
+      std::cout << "matrix-vector product by naive loop: " << T.elapsed() << "ms" << std::endl;
+
+
+      T.restart();
+      for (int i = 0;i<Repeats/100;i++)
+      {
+        Mat.multiply(VectB,VectY);
+      }
+      T.stop();
+
+      std::cout << "matrix-vector product by kernels (" << openfluid::core::kernels::getInstructionSet() << "): "
+                << T.elapsed() << "ms" << std::endl;
+
+      XVal = Acc+VectY.sum();
+
+
       return DefaultDeltaT();
     }
 